@@ -1,4 +1,4 @@
-#!/usr/bin/python
+#!/usr/bin/env python3
 # Benchmark Outcome against other stuff
 # (C) 2017 Niall Douglas http://www.nedproductions.biz/
 # Created: Mar 2017
@@ -8,6 +8,7 @@ import sys, os, subprocess, shlex, time
 
 class ErrorHandlingSystem(object):
     "Base class for an error handling system"
+    needs_coroutines = False
 
     def __init__(self):
         pass
@@ -24,9 +25,22 @@ class ErrorHandlingSystem(object):
         "Function implementation for final function zero"
         return r'''{ return par ? -1 : 0; }'''
 
+    def function_body(self, callee):
+        "Function implementation for each frame calling callee"
+        return r'''
+{
+  RAII raii;
+  return ''' + callee + r'''(par + 1);
+}
+'''
+
+    def entry_point(self, name):
+        "Defines FUNCTION, which the runner calls"
+        return "#define FUNCTION %s\n" % name
+
     def generate_sources(self, no):
         "Generate no source files calling into one another"
-        for n in xrange(0, no):
+        for n in range(0, no):
             with open("source%04d.cpp" % n, 'wt') as oh:
                 oh.write(self.preamble(n))
                 oh.write(r'''extern volatile int counter;
@@ -36,17 +50,13 @@ struct RAII { RAII() { ++counter; } ~RAII() { --counter; } };
                     oh.write(self.function_cont("funct%04d" % (n-1)) + ';\n')
                 oh.write(self.function_cont("funct%04d" % n))
                 if n:
-                    oh.write(r'''
-{
-  RAII raii;
-  return ''' + ("funct%04d" % (n-1)) + r'''(par + 1);
-}
-''')
+                    oh.write(self.function_body("funct%04d" % (n-1)))
                 else:
                     oh.write(self.function_final())
         with open("function.h", 'wt') as oh:
+            oh.write(self.preamble(no))
             oh.write(self.function_cont("funct%04d" % (no-1)) + ';\n')
-            oh.write("#define FUNCTION funct%04d\n" % (no-1))
+            oh.write(self.entry_point("funct%04d" % (no-1)))
             oh.write("#define NESTING %d\n" % (no))
 
 class ExceptionThrow(ErrorHandlingSystem):
@@ -79,6 +89,226 @@ class ResultExceptionError(ResultExceptionValue):
     def function_final(self):
         return r'''{ return std::make_exception_ptr(std::exception()); }'''
         
+class ResultPayloadValue(ResultErrorValue):
+    "Propagates a non-trivial error type through OUTCOME_TRY in every frame"
+    def preamble(self, idx):
+        return r'''#include "../include/outcome/result.hpp"
+#include "../include/outcome/try.hpp"
+#include <string>
+struct payload
+{
+  std::error_code ec;
+  std::string message;
+  payload() = default;
+  payload(std::error_code _ec, std::string _message) : ec(_ec), message(std::move(_message)) {}
+};
+'''
+    def function_cont(self, name):
+        return 'extern OUTCOME_V2_NAMESPACE::result<int, payload> %s(int par)' % name
+    def function_body(self, callee):
+        return r'''
+{
+  RAII raii;
+  OUTCOME_TRY(v, ''' + callee + r'''(par + 1));
+  return v;
+}
+'''
+
+class ResultPayloadError(ResultPayloadValue):
+    def function_final(self):
+        return r'''{ return OUTCOME_V2_NAMESPACE::result<int, payload>(OUTCOME_V2_NAMESPACE::in_place_type<payload>, std::error_code(5, std::generic_category()), "a message long enough to defeat the small string optimisation"); }'''
+
+class ResultTryValue(ResultErrorValue):
+    "Propagates through OUTCOME_TRY in every frame"
+    def preamble(self, idx):
+        return '#include "../include/outcome/result.hpp"\n#include "../include/outcome/try.hpp"\n'
+    def function_body(self, callee):
+        return r'''
+{
+  RAII raii;
+  OUTCOME_TRY(v, ''' + callee + r'''(par + 1));
+  return v;
+}
+'''
+
+class ResultTryError(ResultTryValue):
+    def function_final(self):
+        return r'''{ return std::error_code(5, std::generic_category()); }'''
+
+class ResultCoAwaitValue(ResultTryValue):
+    "Propagates through co_await in every frame of a chain of lazy tasks, needs C++ 20"
+    needs_coroutines = True
+    def preamble(self, idx):
+        return '#include "../include/outcome/coroutine_support.hpp"\n'
+    def function_cont(self, name):
+        return 'extern OUTCOME_V2_NAMESPACE::awaitables::lazy<OUTCOME_V2_NAMESPACE::result<int>> %s(int par)' % name
+    def function_final(self):
+        return r'''{ co_return par; }'''
+    def function_body(self, callee):
+        return r'''
+{
+  RAII raii;
+  co_return co_await co_await ''' + callee + r'''(par + 1);
+}
+'''
+    def entry_point(self, name):
+        return "inline OUTCOME_V2_NAMESPACE::result<int> function_entry(int par) { return %s(par).get(); }\n#define FUNCTION function_entry\n" % name
+
+class ResultCoAwaitError(ResultCoAwaitValue):
+    def function_final(self):
+        return r'''{ co_return std::error_code(5, std::generic_category()); }'''
+
+class ResultCoAwaitPooled(ResultCoAwaitError):
+    "As ResultCoAwaitError, with the frames coming from a frame_pool"
+    def entry_point(self, name):
+        return r'''inline OUTCOME_V2_NAMESPACE::result<int> function_entry(int par)
+{
+  static thread_local OUTCOME_V2_NAMESPACE::awaitables::frame_pool pool;
+  OUTCOME_V2_NAMESPACE::awaitables::frame_allocator_scope scope(pool);
+  return %s(par).get();
+}
+#define FUNCTION function_entry
+''' % name
+
+class ResultCoAwaitElided(ResultCoAwaitError):
+    "As ResultCoAwaitError, with all frames inline in one translation unit so the compiler may elide their allocation"
+    def generate_sources(self, no):
+        for n in range(0, no):
+            with open("source%04d.cpp" % n, 'wt') as oh:
+                oh.write('\n')
+        with open("function.h", 'wt') as oh:
+            oh.write(self.preamble(0))
+            oh.write(r'''extern volatile int counter;
+struct RAII { RAII() { ++counter; } ~RAII() { --counter; } };
+''')
+            for n in range(0, no):
+                oh.write(self.function_cont("funct%04d" % n).replace('extern ', 'static inline ', 1))
+                oh.write(self.function_body("funct%04d" % (n-1)) if n else self.function_final())
+                oh.write('\n')
+            oh.write(self.entry_point("funct%04d" % (no-1)))
+            oh.write("#define NESTING %d\n" % (no))
+
+class ResultFromExceptionTable(ResultErrorValue):
+    "Converts a captured STL exception into the error returned, through the table where the ABI allows"
+    def preamble(self, idx):
+        return '#include "../include/outcome/result.hpp"\n#include "../include/outcome/utils.hpp"\n#include <stdexcept>\n'
+    def function_final(self):
+        return r'''{
+  static const std::exception_ptr ep = std::make_exception_ptr(std::invalid_argument("invalid"));
+  return OUTCOME_V2_NAMESPACE::error_from_exception(std::exception_ptr(ep));
+}'''
+
+class ResultFromExceptionRethrow(ResultFromExceptionTable):
+    "As ResultFromExceptionTable, always rethrowing the exception to match it"
+    def function_final(self):
+        return r'''{
+  static const std::exception_ptr ep = std::make_exception_ptr(std::invalid_argument("invalid"));
+  std::exception_ptr copy(ep);
+  return OUTCOME_V2_NAMESPACE::detail::error_from_rethrown_exception(copy, std::error_code());
+}'''
+
+class ResultSerialiseText(ResultErrorValue):
+    "Round trips the value returned through a stream in the text format, which cannot read error codes"
+    def preamble(self, idx):
+        return '#include "../include/outcome/iostream_support.hpp"\n'
+    def function_final(self):
+        return r'''{
+  static thread_local std::stringstream ss;
+  OUTCOME_V2_NAMESPACE::result<int, long> in(OUTCOME_V2_NAMESPACE::success(par)), out(OUTCOME_V2_NAMESPACE::success(0));
+  ss.clear();
+  ss.seekp(0);
+  ss.seekg(0);
+  ss << in;
+  ss >> out;
+  return out.value();
+}'''
+
+class ResultSerialiseBinary(ResultSerialiseText):
+    "As ResultSerialiseText, in the binary format"
+    def preamble(self, idx):
+        return '#include "../include/outcome/binary_serialisation.hpp"\n#include <sstream>\n'
+    def function_final(self):
+        return r'''{
+  static thread_local std::stringstream ss;
+  OUTCOME_V2_NAMESPACE::result<int, long> in(OUTCOME_V2_NAMESPACE::success(par)), out(OUTCOME_V2_NAMESPACE::success(0));
+  ss.clear();
+  ss.seekp(0);
+  ss.seekg(0);
+  ss << OUTCOME_V2_NAMESPACE::binary::as_binary(in);
+  ss >> OUTCOME_V2_NAMESPACE::binary::as_binary(out);
+  return out.value();
+}'''
+
+class ResultSerialiseBuffer(ResultSerialiseText):
+    "As ResultSerialiseBinary, into a buffer on the stack rather than a stream"
+    def preamble(self, idx):
+        return '#include "../include/outcome/binary_serialisation.hpp"\n'
+    def function_final(self):
+        return r'''{
+  unsigned char buffer[16];
+  OUTCOME_V2_NAMESPACE::result<int, long> in(OUTCOME_V2_NAMESPACE::success(par));
+  auto written = OUTCOME_V2_NAMESPACE::binary::encode(in, buffer, sizeof(buffer));
+  return OUTCOME_V2_NAMESPACE::binary::decode<OUTCOME_V2_NAMESPACE::result<int, long>>(buffer, written.value()).value().value();
+}'''
+
+class ResultCAbiStructValue(ErrorHandlingSystem):
+    "Returns CXX_RESULT_EC(int) through extern C functions, a 24 byte struct returned through memory"
+    def preamble(self, idx):
+        return '#include "../include/outcome/c_result.hpp"\nCXX_DECLARE_RESULT_EC(int, int);\n'
+    def function_cont(self, name):
+        return 'extern "C" CXX_RESULT_EC(int) %s(int par)' % name
+    def function_final(self):
+        return r'''{
+  OUTCOME_V2_NAMESPACE::c_result<int, std::error_code> r = OUTCOME_V2_NAMESPACE::to_c_result(OUTCOME_V2_NAMESPACE::result<int>(par));
+  CXX_RESULT_EC(int) ret;
+  memcpy(&ret, &r, sizeof(ret));
+  return ret;
+}'''
+    def entry_point(self, name):
+        return r'''inline OUTCOME_V2_NAMESPACE::result<int> function_entry(int par)
+{
+  CXX_RESULT_EC(int) r = %s(par);
+  OUTCOME_V2_NAMESPACE::c_result<int, std::error_code> c;
+  memcpy(&c, &r, sizeof(c));
+  return OUTCOME_V2_NAMESPACE::from_c_result(c);
+}
+#define FUNCTION function_entry
+''' % name
+
+class ResultCAbiStructError(ResultCAbiStructValue):
+    def function_final(self):
+        return ResultCAbiStructValue.function_final(self).replace('result<int>(par)', 'result<int>(std::error_code(5, std::generic_category()))')
+
+class ResultCAbiCompactValue(ResultCAbiStructValue):
+    "As ResultCAbiStructValue, returning the 16 byte CXX_RESULT_EC32(int) in registers"
+    def preamble(self, idx):
+        return '#include "../include/outcome/c_result.hpp"\nCXX_DECLARE_RESULT_EC32(int, int);\n'
+    def function_cont(self, name):
+        return 'extern "C" CXX_RESULT_EC32(int) %s(int par)' % name
+    def function_final(self):
+        return r'''{
+  OUTCOME_V2_NAMESPACE::c_result_ec32<int> r = OUTCOME_V2_NAMESPACE::to_c_result32(OUTCOME_V2_NAMESPACE::result<int>(par));
+  CXX_RESULT_EC32(int) ret;
+  memcpy(&ret, &r, sizeof(ret));
+  return ret;
+}'''
+    def entry_point(self, name):
+        return r'''inline OUTCOME_V2_NAMESPACE::result<int> function_entry(int par)
+{
+  CXX_RESULT_EC32(int) r = %s(par);
+  OUTCOME_V2_NAMESPACE::c_result_ec32<int> c;
+  memcpy(&c, &r, sizeof(c));
+  OUTCOME_V2_NAMESPACE::result<int> ret(0);
+  OUTCOME_V2_NAMESPACE::from_c_result32(ret, c);
+  return ret;
+}
+#define FUNCTION function_entry
+''' % name
+
+class ResultCAbiCompactError(ResultCAbiCompactValue):
+    def function_final(self):
+        return ResultCAbiCompactValue.function_final(self).replace('result<int>(par)', 'result<int>(std::error_code(5, std::generic_category()))')
+
 matrix = [
     ('integer-returns', ErrorHandlingSystem),
     ('exception-throw', ExceptionThrow),
@@ -86,6 +316,187 @@ matrix = [
     ('result-error-error', ResultErrorError),
     ('result-excpt-value', ResultExceptionValue),
     ('result-excpt-error', ResultExceptionError),
+    ('result-payld-value', ResultPayloadValue),
+    ('result-payld-error', ResultPayloadError),
+    ('result-try-value', ResultTryValue),
+    ('result-try-error', ResultTryError),
+    ('result-coawait-value', ResultCoAwaitValue),
+    ('result-coawait-error', ResultCoAwaitError),
+    ('result-coawait-pooled', ResultCoAwaitPooled),
+    ('result-coawait-elided', ResultCoAwaitElided),
+    ('result-fromexcpt-table', ResultFromExceptionTable),
+    ('result-fromexcpt-rethrow', ResultFromExceptionRethrow),
+    ('result-serialise-text', ResultSerialiseText),
+    ('result-serialise-binary', ResultSerialiseBinary),
+    ('result-serialise-buffer', ResultSerialiseBuffer),
+    ('result-cabi-struct-value', ResultCAbiStructValue),
+    ('result-cabi-struct-error', ResultCAbiStructError),
+    ('result-cabi-compact-value', ResultCAbiCompactValue),
+    ('result-cabi-compact-error', ResultCAbiCompactError),
+]
+
+class SweepErrorCode(ErrorHandlingSystem):
+    "Returns a plain integer error code, failing failure_ppm calls in a million, for the sweep"
+    def preamble(self, idx):
+        return r'''#ifndef FAILS
+extern volatile unsigned failure_ppm;
+// Hashes par so that which calls fail is not predictable
+#define FAILS(par) (((unsigned) (par) * 2654435761U) % 1000000U < failure_ppm)
+#endif
+'''
+    def function_final(self):
+        return r'''{ return FAILS(par) ? 5 : 0; }'''
+    def function_body(self, callee):
+        return r'''
+{
+  RAII raii;
+  int ec = ''' + callee + r'''(par + 1);
+  if(ec)
+    return ec;
+  return 0;
+}
+'''
+
+class SweepExceptionThrow(SweepErrorCode):
+    def preamble(self, idx):
+        return SweepErrorCode.preamble(self, idx) + '#include <exception>\n'
+    def function_final(self):
+        return r'''{ if(FAILS(par)) throw std::exception(); return 0; }'''
+    def function_body(self, callee):
+        return ErrorHandlingSystem.function_body(self, callee)
+
+class SweepResult(SweepErrorCode):
+    def preamble(self, idx):
+        return SweepErrorCode.preamble(self, idx) + '#include "../include/outcome/result.hpp"\n#include "../include/outcome/try.hpp"\n'
+    def function_cont(self, name):
+        return 'extern OUTCOME_V2_NAMESPACE::result<int> %s(int par)' % name
+    def function_final(self):
+        return r'''{ if(FAILS(par)) return std::error_code(5, std::generic_category()); return par; }'''
+    def function_body(self, callee):
+        return ResultTryValue.function_body(self, callee)
+
+class SweepOutcome(SweepResult):
+    def preamble(self, idx):
+        return SweepErrorCode.preamble(self, idx) + '#include "../include/outcome/outcome.hpp"\n#include "../include/outcome/try.hpp"\n'
+    def function_cont(self, name):
+        return 'extern OUTCOME_V2_NAMESPACE::outcome<int> %s(int par)' % name
+
+# The failure rate sweep, run with `benchmark.py sweep`
+sweep_matrix = [
+    ('error-code', SweepErrorCode),
+    ('exception-throw', SweepExceptionThrow),
+    ('result', SweepResult),
+    ('outcome', SweepOutcome),
+]
+sweep_depths = [1, 2, 4, 8, 16, 32]
+sweep_failure_ppm = [0, 100, 1000, 10000, 50000, 200000]
+
+class CompareOutcome(ErrorHandlingSystem):
+    "result<T> of Outcome, propagated with OUTCOME_TRY, for the comparison against other result types"
+    T = 'int'
+    def preamble(self, idx):
+        return '#include "../include/outcome/result.hpp"\n#include "../include/outcome/try.hpp"\n#include <string>\n'
+    def result_type(self):
+        return 'OUTCOME_V2_NAMESPACE::result<%s>' % self.T
+    def success(self):
+        return 'par'
+    def failure(self):
+        return 'std::error_code(5, std::generic_category())'
+    def function_cont(self, name):
+        return 'extern %s %s(int par)' % (self.result_type(), name)
+    def function_final(self):
+        return '{ return %s; }' % self.success()
+    def function_body(self, callee):
+        return r'''
+{
+  RAII raii;
+  OUTCOME_TRY(v, ''' + callee + r'''(par + 1));
+  return std::move(v);
+}
+'''
+
+class CompareStdExpected(CompareOutcome):
+    "std::expected<T, std::error_code> of C++ 23, where the standard library has it"
+    def preamble(self, idx):
+        return r'''#if __has_include(<version>)
+#include <version>
+#endif
+#ifndef __cpp_lib_expected
+#error This standard library has no std::expected
+#endif
+#include <expected>
+#include <string>
+#include <system_error>
+'''
+    def result_type(self):
+        return 'std::expected<%s, std::error_code>' % self.T
+    def failure(self):
+        return 'std::unexpected(std::error_code(5, std::generic_category()))'
+    def function_body(self, callee):
+        return r'''
+{
+  RAII raii;
+  auto r = ''' + callee + r'''(par + 1);
+  if(!r)
+    return std::unexpected(std::move(r).error());
+  return std::move(*r);
+}
+'''
+
+class CompareTlExpected(CompareStdExpected):
+    "tl::expected<T, std::error_code>, where its header is installed"
+    def preamble(self, idx):
+        return '#include <tl/expected.hpp>\n#include <string>\n#include <system_error>\n'
+    def result_type(self):
+        return 'tl::expected<%s, std::error_code>' % self.T
+    def failure(self):
+        return 'tl::make_unexpected(std::error_code(5, std::generic_category()))'
+    def function_body(self, callee):
+        return CompareStdExpected.function_body(self, callee).replace('std::unexpected', 'tl::make_unexpected')
+
+# What is measured of each result type in the comparison, each a function of the class of the
+# result type returning the class of the benchmark, and the nesting depth, None being SOURCES
+def compare_construct_value(impl):
+    return impl
+def compare_construct_error(impl):
+    class CompareConstructError(impl):
+        def success(self):
+            return self.failure()
+    return CompareConstructError
+def compare_payload(impl):
+    "A std::string too long for the small string optimisation, moved out of each frame"
+    class ComparePayload(impl):
+        T = 'std::string'
+        def success(self):
+            return 'std::string("a value long enough to defeat the small string optimisation")'
+    return ComparePayload
+def compare_payload_copy(impl):
+    "As compare_payload, with each frame copying the result it got"
+    class ComparePayloadCopy(compare_payload(impl)):
+        def function_body(self, callee):
+            return r'''
+{
+  RAII raii;
+  auto r = ''' + callee + r'''(par + 1);
+  ''' + self.result_type() + r''' copy(r);
+  return copy;
+}
+'''
+    return ComparePayloadCopy
+
+# The comparison against other result types, run with `benchmark.py compare`
+compare_impls = [
+    ('outcome-result', CompareOutcome),
+    ('std-expected', CompareStdExpected),
+    ('tl-expected', CompareTlExpected),
+]
+compare_operations = [
+    ('construct-value', compare_construct_value, 1),
+    ('construct-error', compare_construct_error, 1),
+    ('propagate-value', compare_construct_value, None),
+    ('propagate-error', compare_construct_error, None),
+    ('payload-move', compare_payload, None),
+    ('payload-copy', compare_payload_copy, None),
 ]
 
 if sys.platform == 'win32':
@@ -94,24 +505,228 @@ if sys.platform == 'win32':
         ('msvc1912', r'cl /nologo /std:c++latest /O2 /Gy /MD /EHsc /Fe%s /I..\\..'),
         ('msvc1912-ltcg', r'cl /nologo /std:c++latest /O2 /Gy /GL /MD /EHsc /Fe%s /I..\\..'),
     ]
+    compare_compilers = [
+        ('msvc1937', r'cl /nologo /std:c++latest /O2 /Gy /MD /EHsc /Fe%s /I..\\..'),
+    ]
 elif sys.platform == 'darwin':
     compilers = [
         ('xcode82', r'clang++ -std=c++14 -O3 -g -o %s'),
     ]
+    compare_compilers = [
+        ('xcode15', r'clang++ -std=c++2b -O3 -g -o %s'),
+    ]
 else:
     compilers = [
         ('gcc72-noexcept', r'g++-7 -std=c++17 -fno-exceptions -O3 -g -o %s -I../..'),
         ('gcc72', r'g++-7 -std=c++17 -O3 -g -o %s -I../..'),
         ('gcc72-lto', r'g++-7 -std=c++17 -O3 -g -flto -o %s -I../..'),
         ('clang50', r'clang++-5.0 -std=c++17 -O3 -g -o %s -I../..'),
+        ('gcc12-cxx20', r'g++-12 -std=c++20 -O3 -g -o %s -I../..'),
 #        ('clang40-lto', r'clang++-4.0 -std=c++14 -O3 -g -flto -o %s'),  not working yet
     ]
+    compare_compilers = [
+        ('gcc12-cxx23', r'g++-12 -std=c++23 -O3 -g -o %s -I../..'),
+        ('clang16-cxx23-libcxx', r'clang++-16 -std=c++23 -stdlib=libc++ -O3 -g -o %s -I../..'),
+    ]
+
+def build(instance, exename, compiler, sources):
+    "Generates sources for instance nested sources deep and compiles them, returning the path of the executable"
+    try:
+        print("\nGenerating sources for", exename, "...")
+        instance.generate_sources(sources)
+        args = shlex.split(compiler[1] % exename)
+        args.append("runner.cpp")
+        for n in range(0, sources):
+            args.append("source%04d.cpp" % n)
+        if sys.platform == 'win32':
+            args.append("/link")
+            args.append("/OPT:REF,ICF")
+        #print(' '.join(args))
+        try:
+            print("Compiling", exename, "...")
+            compile_begin = time.perf_counter()
+            print(subprocess.check_output(args, universal_newlines=True))
+            compile_end = time.perf_counter()
+            print("Compile took", compile_end-compile_begin, "secs. Running executable ...")
+        except subprocess.CalledProcessError as e:
+            print(e.output)
+            raise
+    finally:
+        for n in range(0, sources):
+            if os.path.exists("source%04d.cpp" % n):
+                os.remove("source%04d.cpp" % n)
+            if os.path.exists("source%04d.obj" % n):
+                os.remove("source%04d.obj" % n)
+        os.remove("function.h")
+        #if os.path.exists(exename):
+        #    os.remove(exename)
+        #if os.path.exists(exename+'.exe'):
+        #    os.remove(exename+'.exe')
+        if os.path.exists("runner.obj"):
+            os.remove("runner.obj")
+    if sys.platform != 'win32':
+        exename = './' + exename
+    return exename
+
+if len(sys.argv)>1 and sys.argv[1] == 'sweep':
+    # Cycles per call of each system at each nesting depth and failure rate, the executable
+    # for each depth being run once per failure rate
+    with open('results-'+sys.platform+'-sweep.csv', 'wt') as resultsh:
+        resultsh.write('"Compiler","System","Depth","Failure %","Median","P99"\n')
+        for compiler in compilers:
+            for m in sweep_matrix:
+                if 'noexcept' in compiler[0] and m[0] == 'exception-throw':
+                    continue
+                for depth in sweep_depths:
+                    exename = build(m[1](), 'sweep-%s-%d_%s' % (m[0], depth, compiler[0]), compiler, depth)
+                    for ppm in sweep_failure_ppm:
+                        result = subprocess.check_output([exename, '--csv', '--failure-ppm=%d' % ppm], universal_newlines=True).rstrip().split(',')
+                        resultsh.write('"%s","%s",%d,%g,%s,%s\n' % (compiler[0], m[0], depth, ppm / 10000.0, result[0], result[1]))
+                        resultsh.flush()
+    sys.exit(0)
+
+if len(sys.argv)>1 and sys.argv[1] == 'compare':
+    # Cycles per call of each operation of each result type, and the sizeof and alignof of each,
+    # result types not available with a compiler being left empty
+    SOURCES = int(sys.argv[2]) if len(sys.argv)>2 else 10
+    with open('results-'+sys.platform+'-compare.csv', 'wt') as resultsh, open('results-'+sys.platform+'-compare-layout.csv', 'wt') as layouth:
+        resultsh.write('"Compiler","Result type","Operation","Depth","Median","P99"\n')
+        layouth.write('"Compiler","Result type","Value type","Sizeof","Alignof"\n')
+        for compiler in compare_compilers:
+            try:
+                args = shlex.split(compiler[1] % 'compare-layout')
+                args.append("compare-layout.cpp")
+                subprocess.check_output(args, universal_newlines=True)
+                layout = subprocess.check_output(['compare-layout.exe' if sys.platform == 'win32' else './compare-layout'], universal_newlines=True)
+                for line in layout.splitlines():
+                    layouth.write('"%s",%s\n' % (compiler[0], line))
+                layouth.flush()
+            except (subprocess.CalledProcessError, OSError) as e:
+                print("Compiler", compiler[0], "is not usable:", e)
+                continue
+            for impl in compare_impls:
+                for op in compare_operations:
+                    depth = op[2] or SOURCES
+                    try:
+                        exename = build(op[1](impl[1])(), 'compare-%s-%s_%s' % (impl[0], op[0], compiler[0]), compiler, depth)
+                    except (subprocess.CalledProcessError, OSError):
+                        print(impl[0], "is not available with", compiler[0])
+                        result = ['', '']
+                    else:
+                        result = subprocess.check_output([exename, '--csv'], universal_newlines=True).rstrip().split(',')
+                    resultsh.write('"%s","%s","%s",%d,%s,%s\n' % (compiler[0], impl[0], op[0], depth, result[0], result[1]))
+                    resultsh.flush()
+    # Charted next to results_*.png, if matplotlib is installed
+    try:
+        import csv
+        import matplotlib
+        matplotlib.use('Agg')
+        import matplotlib.pyplot as plt
+    except ImportError:
+        print("matplotlib is not installed, so results_compare.png was not drawn")
+        sys.exit(0)
+    with open('results-'+sys.platform+'-compare.csv', 'rt') as resultsh:
+        rows = [row for row in csv.DictReader(resultsh) if row['Median']]
+    series = sorted(set((row['Compiler'], row['Result type']) for row in rows))
+    operations = [op[0] for op in compare_operations]
+    fig, ax = plt.subplots(figsize=(12, 6))
+    width = 0.8 / max(1, len(series))
+    for n, (comp, impl) in enumerate(series):
+        medians = {row['Operation']: float(row['Median']) for row in rows if row['Compiler'] == comp and row['Result type'] == impl}
+        ax.bar([x + n * width for x in range(len(operations))], [medians.get(op, 0) for op in operations], width, label='%s %s' % (impl, comp))
+    ax.set_xticks([x + 0.4 - width / 2 for x in range(len(operations))])
+    ax.set_xticklabels(operations)
+    ax.set_ylabel('CPU cycles per call (median)')
+    ax.set_title('Outcome result against other result types, %d frames deep where propagated' % SOURCES)
+    ax.legend()
+    fig.tight_layout()
+    fig.savefig('results_compare.png')
+    sys.exit(0)
+
+if len(sys.argv)>1 and sys.argv[1] == 'layouts':
+    # Nanoseconds and last level cache misses per element of each storage layout over arrays of
+    # 10^3 to 10^8 results, layouts.cpp being built once as it is and once with the compact status
+    with open('results-'+sys.platform+'-layouts.csv', 'wt') as resultsh:
+        resultsh.write('"Compiler","Layout","Value bytes","Error bytes","Element bytes","Elements","Operation","ns per element","LLC misses per element"\n')
+        for compiler in compare_compilers:
+            for variant, flags in [('', []), ('-compact', ['-DOUTCOME_ENABLE_COMPACT_STATUS'])]:
+                exename = 'layouts-%s%s' % (compiler[0], variant)
+                args = shlex.split(compiler[1] % exename) + flags
+                args.append("layouts.cpp")
+                try:
+                    print("Compiling", exename, "...")
+                    subprocess.check_output(args, universal_newlines=True)
+                except (subprocess.CalledProcessError, OSError) as e:
+                    print("Compiler", compiler[0], "is not usable:", e)
+                    continue
+                output = subprocess.check_output([exename if sys.platform == 'win32' else './' + exename] + sys.argv[2:], universal_newlines=True)
+                for line in output.splitlines()[1:]:
+                    resultsh.write('"%s",%s\n' % (compiler[0], line))
+                resultsh.flush()
+    # Charted next to results_*.png, if matplotlib is installed
+    try:
+        import csv
+        import matplotlib
+        matplotlib.use('Agg')
+        import matplotlib.pyplot as plt
+    except ImportError:
+        print("matplotlib is not installed, so results_layouts.png was not drawn")
+        sys.exit(0)
+    with open('results-'+sys.platform+'-layouts.csv', 'rt') as resultsh:
+        rows = list(csv.DictReader(resultsh))
+    operations = ['scan', 'filter', 'transform']
+    series = sorted(set((row['Compiler'], row['Layout'], int(row['Value bytes']), int(row['Error bytes'])) for row in rows))
+    # A row of charts of the time per element, and another of the misses if they were counted
+    metrics = [('ns per element', 'Nanoseconds per element')]
+    if any(row['LLC misses per element'] for row in rows):
+        metrics.append(('LLC misses per element', 'Last level cache misses per element'))
+    fig, axes = plt.subplots(len(metrics), len(operations), figsize=(18, 6 * len(metrics)), squeeze=False)
+    for m, (column, label) in enumerate(metrics):
+        for o, op in enumerate(operations):
+            ax = axes[m][o]
+            for comp, layout, value_bytes, error_bytes in series:
+                points = sorted((int(row['Elements']), float(row[column])) for row in rows if row['Operation'] == op and row[column] and (row['Compiler'], row['Layout'], int(row['Value bytes']), int(row['Error bytes'])) == (comp, layout, value_bytes, error_bytes))
+                if points:
+                    ax.plot([p[0] for p in points], [p[1] for p in points], marker='.', label='%s T=%d E=%d %s' % (layout, value_bytes, error_bytes, comp))
+            ax.set_xscale('log')
+            ax.set_xlabel('Elements')
+            ax.set_ylabel(label)
+            ax.set_title(op)
+    axes[0][len(operations) - 1].legend(fontsize='xx-small', ncol=2)
+    fig.tight_layout()
+    fig.savefig('results_layouts.png')
+    sys.exit(0)
+
+if len(sys.argv)>1 and sys.argv[1] == 'prefetch':
+    # Nanoseconds per element of each prefetching iteration of result_vector at each prefetch
+    # distance, over batches of 10^6 to 10^8 results, far larger than the last level cache
+    with open('results-'+sys.platform+'-prefetch.csv', 'wt') as resultsh:
+        resultsh.write('"Compiler","Value bytes","Error bytes","Elements","Operation","Prefetch distance","ns per element"\n')
+        for compiler in compare_compilers:
+            exename = 'prefetch-%s' % compiler[0]
+            args = shlex.split(compiler[1] % exename)
+            args.append("prefetch.cpp")
+            try:
+                print("Compiling", exename, "...")
+                subprocess.check_output(args, universal_newlines=True)
+            except (subprocess.CalledProcessError, OSError) as e:
+                print("Compiler", compiler[0], "is not usable:", e)
+                continue
+            output = subprocess.check_output([exename if sys.platform == 'win32' else './' + exename] + sys.argv[2:], universal_newlines=True)
+            for line in output.splitlines()[1:]:
+                resultsh.write('"%s",%s\n' % (compiler[0], line))
+            resultsh.flush()
+    sys.exit(0)
 
 SOURCES=10
 if len(sys.argv)>1:
     SOURCES = int(sys.argv[1])
 
-with open('results-'+sys.platform+'.csv', 'wt') as resultsh:
+# results-<platform>.csv has the median cycles per call, as it always has. results-<platform>-detail.csv
+# also has the 99th percentile, the Linux performance counters per call if they could be read,
+# and the calibrated TSC ticks per nanosecond.
+with open('results-'+sys.platform+'.csv', 'wt') as resultsh, open('results-'+sys.platform+'-detail.csv', 'wt') as detailh:
+    detailh.write('"Compiler","Benchmark","Median","P99","Instructions","Branches","Branch misses","Ticks per ns"\n')
     resultsh.write('"Compiler"')
     for m in matrix:
         resultsh.write(',"'+m[0]+'"')
@@ -119,47 +734,13 @@ with open('results-'+sys.platform+'.csv', 'wt') as resultsh:
     for compiler in compilers:
         resultsh.write('"'+compiler[0]+'"')
         for m in matrix:
-            if 'noexcept' in compiler[0] and m[0] == 'exception-throw':
+            if ('noexcept' in compiler[0] and (m[0] == 'exception-throw' or 'fromexcpt' in m[0])) or (m[1].needs_coroutines and 'cxx20' not in compiler[0]):
                 resultsh.write(',')
                 continue
-            instance = m[1]()
-            try:
-                exename = m[0]+'_'+compiler[0]
-                print("\nGenerating sources for", exename, "...")
-                instance.generate_sources(SOURCES)
-                args = shlex.split(compiler[1] % exename)
-                args.append("runner.cpp")
-                for n in xrange(0, SOURCES):
-                    args.append("source%04d.cpp" % n)
-                if sys.platform == 'win32':
-                    args.append("/link")
-                    args.append("/OPT:REF,ICF")
-                #print(' '.join(args))
-                try:
-                    print("Compiling", exename, "...")
-                    compile_begin = time.clock()
-                    print(subprocess.check_output(args))
-                    compile_end = time.clock()
-                    print("Compile took", compile_end-compile_begin, "secs. Running executable ...")
-                except subprocess.CalledProcessError as e:
-                    print(e.output)
-                    raise
-            finally:
-                for n in xrange(0, SOURCES):
-                    if os.path.exists("source%04d.cpp" % n):
-                        os.remove("source%04d.cpp" % n)
-                    if os.path.exists("source%04d.obj" % n):
-                        os.remove("source%04d.obj" % n)
-                os.remove("function.h")
-                #if os.path.exists(exename):
-                #    os.remove(exename)
-                #if os.path.exists(exename+'.exe'):
-                #    os.remove(exename+'.exe')
-                if os.path.exists("runner.obj"):
-                    os.remove("runner.obj")
-            if sys.platform != 'win32':
-                exename = './' + exename
-            result = subprocess.check_output([exename])
-            resultsh.write(',' + result.rstrip())
+            exename = build(m[1](), m[0]+'_'+compiler[0], compiler, SOURCES)
+            result = subprocess.check_output([exename, '--csv'], universal_newlines=True).rstrip()
+            resultsh.write(',' + result.split(',')[0])
             resultsh.flush()
+            detailh.write('"%s","%s",%s\n' % (compiler[0], m[0], result))
+            detailh.flush()
         resultsh.write('\n')
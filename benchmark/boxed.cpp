@@ -0,0 +1,132 @@
+/* Benchmark of result<T> against boxed_result<T> across the size of T
+Compiled with, for example:
+  g++ -std=c++17 -O3 -o boxed boxed.cpp -I../..
+Run as `boxed [--iterations=N] [--depth=N] [--failure-ppm=N]`. Each iteration returns a value
+of each size up through --depth frames, failing N in a million of them at the bottom, with each
+frame inspecting the value and returning it, or returning a new failure. Prints a CSV of the size
+of the value and of each result, and the nanoseconds per iteration of each. A plain result copies
+its value, or the unused space for it, in every frame, whereas a boxed result copies a pointer but
+pops and pushes a free list for every success. The crossover sets `detail::boxed_value_threshold`.
+*/
+
+#include "../include/outcome/boxed_result.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+using namespace OUTCOME_V2_NAMESPACE;
+
+static unsigned long long iterations = 1000000;
+static unsigned depth = 8, failure_ppm = 10000;
+
+template <size_t Bytes> struct payload
+{
+  unsigned long long v[Bytes / sizeof(unsigned long long)];
+};
+
+// Opts every payload into boxing, so the sweep measures both layouts at every size
+namespace OUTCOME_V2_NAMESPACE
+{
+  namespace trait
+  {
+    template <size_t Bytes> struct is_boxed_value<payload<Bytes>>
+    {
+      static constexpr bool value = true;
+    };
+  }  // namespace trait
+}  // namespace OUTCOME_V2_NAMESPACE
+
+// Whether iteration n fails, spread evenly through the iterations
+static inline bool fails(unsigned long long n)
+{
+  return failure_ppm != 0 && (n * failure_ppm) % 1000000 < failure_ppm;
+}
+
+template <class Result, size_t Bytes> static __attribute__((noinline)) Result leaf(unsigned long long n)
+{
+  if(fails(n))
+  {
+    return std::make_error_code(std::errc::invalid_argument);
+  }
+  payload<Bytes> ret;
+  for(auto &i : ret.v)
+  {
+    i = n;
+  }
+  return ret;
+}
+
+template <class Result, size_t Bytes> static __attribute__((noinline)) Result frame(unsigned long long n, unsigned remaining)
+{
+  if(remaining == 0)
+  {
+    return leaf<Result, Bytes>(n);
+  }
+  Result r = frame<Result, Bytes>(n, remaining - 1);
+  if(!r)
+  {
+    return r.as_failure();
+  }
+  if(r.assume_value().v[0] == remaining)
+  {
+    return std::make_error_code(std::errc::result_out_of_range);
+  }
+  return r;
+}
+
+template <class Result, size_t Bytes> static double run()
+{
+  unsigned long long sum = 0;
+  const auto begin = std::chrono::high_resolution_clock::now();
+  for(unsigned long long n = 1; n <= iterations; n++)
+  {
+    Result r = frame<Result, Bytes>(n, depth);
+    sum += r ? r.assume_value().v[0] : 1;
+  }
+  const auto end = std::chrono::high_resolution_clock::now();
+  if(sum == 0)
+  {
+    fprintf(stderr, "sum was zero\n");
+  }
+  return (double) std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count() / (double) iterations;
+}
+
+template <size_t Bytes> static void sweep()
+{
+  using plain = result<payload<Bytes>>;
+  using boxed = boxed_result<payload<Bytes>>;
+  const double boxed_ns = run<boxed, Bytes>(), plain_ns = run<plain, Bytes>();
+  printf("%u,%u,%.2f,%u,%u,%.2f,%.2f\n", (unsigned) Bytes, depth, failure_ppm / 10000.0, (unsigned) sizeof(plain), (unsigned) sizeof(boxed), plain_ns, boxed_ns);
+}
+
+int main(int argc, char *argv[])
+{
+  for(int n = 1; n < argc; n++)
+  {
+    if(strncmp(argv[n], "--iterations=", 13) == 0)
+    {
+      iterations = strtoull(argv[n] + 13, nullptr, 10);
+    }
+    else if(strncmp(argv[n], "--depth=", 8) == 0)
+    {
+      depth = (unsigned) strtoul(argv[n] + 8, nullptr, 10);
+    }
+    else if(strncmp(argv[n], "--failure-ppm=", 14) == 0)
+    {
+      failure_ppm = (unsigned) strtoul(argv[n] + 14, nullptr, 10);
+    }
+  }
+  printf("\"Value bytes\",\"Depth\",\"Failure %%\",\"sizeof(result)\",\"sizeof(boxed_result)\",\"result ns\",\"boxed_result ns\"\n");
+  sweep<8>();
+  sweep<16>();
+  sweep<32>();
+  sweep<64>();
+  sweep<128>();
+  sweep<256>();
+  sweep<512>();
+  sweep<1024>();
+  sweep<4096>();
+  return 0;
+}
@@ -0,0 +1,60 @@
+/* Prints the sizeof and alignof of Outcome's result and of the other result types it is compared
+against by `benchmark.py compare`, those not available with the compiler being skipped.
+Compiled with, for example:
+  g++ -std=c++23 -O3 -o compare-layout compare-layout.cpp -I../..
+*/
+
+#include "../include/outcome/result.hpp"
+
+#include <stdio.h>
+#include <string>
+#include <system_error>
+
+#if __has_include(<version>)
+#include <version>
+#endif
+#ifdef __cpp_lib_expected
+#include <expected>
+#endif
+#if __has_include(<tl/expected.hpp>)
+#include <tl/expected.hpp>
+#define HAVE_TL_EXPECTED 1
+#endif
+
+// A payload larger than the error code
+struct payload64
+{
+  char bytes[64];
+};
+
+template <class T> static void print(const char *impl, const char *value)
+{
+  printf("\"%s\",\"%s\",%u,%u\n", impl, value, (unsigned) sizeof(T), (unsigned) alignof(T));
+}
+
+#define PRINT_ALL(impl, tmpl)                                                                                                                                                                                                                                                                                                  \
+  print<tmpl<char>>(impl, "char");                                                                                                                                                                                                                                                                                             \
+  print<tmpl<int>>(impl, "int");                                                                                                                                                                                                                                                                                               \
+  print<tmpl<void *>>(impl, "void *");                                                                                                                                                                                                                                                                                         \
+  print<tmpl<std::string>>(impl, "std::string");                                                                                                                                                                                                                                                                               \
+  print<tmpl<payload64>>(impl, "payload64")
+
+template <class T> using outcome_result = OUTCOME_V2_NAMESPACE::result<T>;
+#ifdef __cpp_lib_expected
+template <class T> using std_expected = std::expected<T, std::error_code>;
+#endif
+#ifdef HAVE_TL_EXPECTED
+template <class T> using tl_expected = tl::expected<T, std::error_code>;
+#endif
+
+int main()
+{
+  PRINT_ALL("outcome-result", outcome_result);
+#ifdef __cpp_lib_expected
+  PRINT_ALL("std-expected", std_expected);
+#endif
+#ifdef HAVE_TL_EXPECTED
+  PRINT_ALL("tl-expected", tl_expected);
+#endif
+  return 0;
+}
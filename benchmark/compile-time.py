@@ -0,0 +1,296 @@
+#!/usr/bin/env python3
+# Benchmark how long the compiler takes to instantiate many distinct result and outcome types
+# Created: Oct 2026
+#
+# Run as `compile-time.py [N ...]`. For each number of types N (100, 500 and 1000 by default),
+# generates a translation unit with N distinct value types, half trivially copyable and half not,
+# and a function returning each as a result, or as an outcome, constructing it from a value and from
+# an error. Writes the compile time and, where the OS reports it, the peak memory of the compiler
+# to compile-time-<platform>.csv.
+#
+# Run as `compile-time.py common [TUs]` to measure the outcome_common library instead. Builds a
+# program of TUs translation units (20 by default), each using result<void>, result<int>,
+# result<std::string> and outcome<void>, once as is and once including common_instantiations.hpp
+# and linking src/common_instantiations.cpp. Writes the total compile and link times, and the
+# total object and program sizes, to compile-time-<platform>-common.csv.
+#
+# Run as `compile-time.py module [TUs]` to compare including the headers against importing the
+# outcome C++ module. Compiles TUs translation units (20 by default) each way with GCC and clang
+# at C++ 20, and writes the time to build the module and the total and per TU compile times to
+# compile-time-<platform>-module.csv.
+#
+# Run as `compile-time.py concepts [N ...]` to compare the C++ 20 requires clause constraints against
+# the enable_if constraints used before C++ 20. Compiles the same translation units as above at
+# C++ 20, once as is and once with OUTCOME_DISABLE_CXX20_CONCEPTS defined, and writes the compile
+# times and peak memory to compile-time-<platform>-concepts.csv.
+
+from __future__ import print_function
+import sys, os, subprocess, shlex, shutil, time
+
+if sys.platform == 'win32':
+    compilers = [
+        ('msvc', r'cl /nologo /std:c++17 /EHsc /c /Fo%s /I..\\..'),
+    ]
+else:
+    compilers = [
+        ('gcc', r'g++ -std=c++17 -c -o %s -I../..'),
+        ('clang', r'clang++ -std=c++17 -c -o %s -I../..'),
+    ]
+
+if sys.platform == 'win32':
+    linkers = {'msvc': r'cl /nologo /Fe%s'}
+else:
+    linkers = {'gcc': r'g++ -o %s', 'clang': r'clang++ -o %s'}
+
+kinds = [
+    ('result', '#include "../include/outcome/result.hpp"\n', 'OUTCOME_V2_NAMESPACE::result'),
+    ('outcome', '#include "../include/outcome/outcome.hpp"\n', 'OUTCOME_V2_NAMESPACE::outcome'),
+]
+
+def generate(path, kind, no):
+    "Writes a translation unit instantiating no distinct kind types"
+    with open(path, 'wt') as oh:
+        oh.write(kind[1])
+        oh.write('#include <string>\n')
+        for n in range(0, no):
+            if n % 2:
+                oh.write('struct value%d { std::string v; value%d(int) {} };\n' % (n, n))
+            else:
+                oh.write('struct value%d { int v; value%d(int x) : v(x) {} };\n' % (n, n))
+            oh.write(r'''%s<value%d> function%d(int x)
+{
+  if(x)
+    return value%d(x);
+  return std::make_error_code(std::errc::invalid_argument);
+}
+''' % (kind[2], n, n, n))
+
+def generate_common(path, idx, extern):
+    "Writes a translation unit using each of the default common specialisations"
+    with open(path, 'wt') as oh:
+        oh.write('#include "../include/outcome/outcome.hpp"\n')
+        if extern:
+            oh.write('#include "../include/outcome/common_instantiations.hpp"\n')
+        oh.write(r'''#include <string>
+namespace outcome = OUTCOME_V2_NAMESPACE;
+outcome::result<void> void%(idx)d(int x)
+{
+  if(x)
+    return outcome::success();
+  return std::make_error_code(std::errc::invalid_argument);
+}
+outcome::result<int> int%(idx)d(int x)
+{
+  if(x)
+    return x;
+  return std::make_error_code(std::errc::invalid_argument);
+}
+outcome::result<std::string> string%(idx)d(int x)
+{
+  if(x)
+    return std::string(x, 'a');
+  return std::make_error_code(std::errc::invalid_argument);
+}
+outcome::outcome<void> outcome%(idx)d(int x)
+{
+  if(x)
+    return outcome::success();
+  return std::make_error_code(std::errc::invalid_argument);
+}
+int tu%(idx)d(int x)
+{
+  outcome::result<int> r(int%(idx)d(x)), s(r);
+  outcome::result<std::string> t(string%(idx)d(x)), u(std::move(t));
+  return static_cast<int>(void%(idx)d(x).has_value() + s.has_value() + u.has_value() + outcome%(idx)d(x).has_value());
+}
+''' % {'idx': idx})
+
+# The commands to build the module interface unit, and the extra arguments to import it
+module_compilers = [
+    ('gcc', r'g++ -std=c++20 -fmodules-ts -x c++ -c -o %s -I../..', r'g++ -std=c++20 -fmodules-ts -c -o %s -I../..', []),
+    ('clang', r'clang++ -std=c++20 -x c++-module --precompile -o %s -I../..', r'clang++ -std=c++20 -c -o %s -I../..', ['-fmodule-file=outcome=compile-time-module.pcm']),
+]
+
+def generate_module(path, idx, imported):
+    "Writes a translation unit using result, outcome, TRY and printing, from the headers or the module"
+    with open(path, 'wt') as oh:
+        if imported:
+            oh.write('#include <string>\n#include <system_error>\nimport outcome;\n#include "../include/outcome/try_macros.hpp"\n')
+        else:
+            oh.write('#include "../include/outcome/iostream_support.hpp"\n#include "../include/outcome/try.hpp"\n#include <string>\nnamespace outcome = OUTCOME_V2_NAMESPACE;\n')
+        oh.write(r'''outcome::result<int> parse%(idx)d(int x)
+{
+  if(x)
+    return x;
+  return std::make_error_code(std::errc::invalid_argument);
+}
+outcome::outcome<std::string> name%(idx)d(int x)
+{
+  OUTCOME_TRY(v, parse%(idx)d(x));
+  return std::string(v, 'a');
+}
+std::string tu%(idx)d(int x)
+{
+  return outcome::print(name%(idx)d(x));
+}
+''' % {'idx': idx})
+
+def compile_once(args):
+    "Returns the seconds and the peak kilobytes of memory the compile took, the latter None if unknown"
+    begin = time.perf_counter()
+    if sys.platform == 'win32':
+        subprocess.check_call(args)
+        return time.perf_counter() - begin, None
+    proc = subprocess.Popen(args)
+    _, status, usage = os.wait4(proc.pid, 0)
+    status = os.WEXITSTATUS(status) if os.WIFEXITED(status) else -os.WTERMSIG(status)
+    proc.returncode = status
+    if status != 0:
+        raise subprocess.CalledProcessError(status, args)
+    # ru_maxrss is in bytes on Mac OS, and in kilobytes elsewhere
+    maxrss = usage.ru_maxrss // 1024 if sys.platform == 'darwin' else usage.ru_maxrss
+    return time.perf_counter() - begin, maxrss
+
+if len(sys.argv)>1 and sys.argv[1] == 'concepts':
+    counts = [int(x) for x in sys.argv[2:]] or [100, 500, 1000]
+    with open('compile-time-'+sys.platform+'-concepts.csv', 'wt') as resultsh:
+        resultsh.write('"Compiler","Kind","Concepts","Types","Seconds","Peak KB"\n')
+        for compiler in compilers:
+            for kind in kinds:
+                for concepts in (False, True):
+                    for no in counts:
+                        source = 'compile-time-%s-%d.cpp' % (kind[0], no)
+                        objname = 'compile-time-%s-%d.o' % (kind[0], no)
+                        generate(source, kind, no)
+                        try:
+                            args = shlex.split(compiler[1].replace('c++17', 'c++20') % objname)
+                            if not concepts:
+                                args.append(('/D' if compiler[0] == 'msvc' else '-D') + 'OUTCOME_DISABLE_CXX20_CONCEPTS')
+                            args.append(source)
+                            print("Compiling", no, kind[0], "types", "with" if concepts else "without", "concepts with", compiler[0], "...")
+                            runs = [compile_once(args) for n in range(0, 3)]
+                        except (subprocess.CalledProcessError, OSError) as e:
+                            print("Compiler", compiler[0], "failed:", e)
+                            break
+                        finally:
+                            os.remove(source)
+                            if os.path.exists(objname):
+                                os.remove(objname)
+                        seconds = min(run[0] for run in runs)
+                        maxrss = min(run[1] for run in runs) if runs[0][1] is not None else None
+                        resultsh.write('"%s","%s","%s",%d,%f,%s\n' % (compiler[0], kind[0], 'yes' if concepts else 'no', no, seconds, '' if maxrss is None else maxrss))
+                        resultsh.flush()
+    sys.exit(0)
+
+if len(sys.argv)>1 and sys.argv[1] == 'module':
+    TUS = int(sys.argv[2]) if len(sys.argv)>2 else 20
+    with open('compile-time-'+sys.platform+'-module.csv', 'wt') as resultsh:
+        resultsh.write('"Compiler","Imported","TUs","Module seconds","Compile seconds","Seconds per TU"\n')
+        for compiler in module_compilers:
+            for imported in (False, True):
+                sources = ['compile-time-module-%d.cpp' % idx for idx in range(0, TUS)]
+                objnames = ['compile-time-module-%d.o' % idx for idx in range(0, TUS)]
+                bminame = 'compile-time-module.pcm' if compiler[0] == 'clang' else 'compile-time-module.o'
+                for idx, source in enumerate(sources):
+                    generate_module(source, idx, imported)
+                try:
+                    print("Compiling", TUS, "TUs", "importing" if imported else "including", "outcome with", compiler[0], "...")
+                    module_seconds = 0
+                    if imported:
+                        args = shlex.split(compiler[1] % bminame)
+                        args.append('../include/outcome/outcome.cppm')
+                        module_seconds = compile_once(args)[0]
+                    compile_seconds = 0
+                    for source, objname in zip(sources, objnames):
+                        args = shlex.split(compiler[2] % objname)
+                        if imported:
+                            args += compiler[3]
+                        args.append(source)
+                        compile_seconds += compile_once(args)[0]
+                except (subprocess.CalledProcessError, OSError) as e:
+                    print("Compiler", compiler[0], "failed:", e)
+                    break
+                finally:
+                    for name in sources + objnames + [bminame]:
+                        if os.path.exists(name):
+                            os.remove(name)
+                    # Where GCC puts the compiled module interface
+                    shutil.rmtree('gcm.cache', ignore_errors=True)
+                resultsh.write('"%s","%s",%d,%f,%f,%f\n' % (compiler[0], 'yes' if imported else 'no', TUS, module_seconds, compile_seconds, compile_seconds / TUS))
+                resultsh.flush()
+    sys.exit(0)
+
+if len(sys.argv)>1 and sys.argv[1] == 'common':
+    TUS = int(sys.argv[2]) if len(sys.argv)>2 else 20
+    with open('compile-time-'+sys.platform+'-common.csv', 'wt') as resultsh:
+        resultsh.write('"Compiler","Extern templates","TUs","Compile seconds","Link seconds","Object bytes","Program bytes"\n')
+        for compiler in compilers:
+            for extern in (False, True):
+                sources = []
+                for idx in range(0, TUS):
+                    sources.append('compile-time-common-%d.cpp' % idx)
+                    generate_common(sources[-1], idx, extern)
+                with open('compile-time-common-main.cpp', 'wt') as oh:
+                    for idx in range(0, TUS):
+                        oh.write('int tu%d(int x);\n' % idx)
+                    oh.write('int main(int argc, char *argv[])\n{\n  (void) argv;\n  return 0')
+                    for idx in range(0, TUS):
+                        oh.write(' + tu%d(argc)' % idx)
+                    oh.write(';\n}\n')
+                sources.append('compile-time-common-main.cpp')
+                if extern:
+                    sources.append('../src/common_instantiations.cpp')
+                objnames = ['compile-time-common-%d.o' % idx for idx in range(0, len(sources))]
+                exename = 'compile-time-common.exe' if sys.platform == 'win32' else './compile-time-common'
+                try:
+                    print("Compiling", TUS, "TUs", "with" if extern else "without", "extern templates with", compiler[0], "...")
+                    compile_seconds = 0
+                    for source, objname in zip(sources, objnames):
+                        args = shlex.split(compiler[1] % objname)
+                        args.append(source)
+                        compile_seconds += compile_once(args)[0]
+                    args = shlex.split(linkers[compiler[0]] % exename)
+                    args += objnames
+                    link_seconds = compile_once(args)[0]
+                    object_bytes = sum(os.path.getsize(objname) for objname in objnames)
+                    program_bytes = os.path.getsize(exename)
+                except (subprocess.CalledProcessError, OSError) as e:
+                    print("Compiler", compiler[0], "failed:", e)
+                    break
+                finally:
+                    for source in sources:
+                        if source.startswith('compile-time-common-'):
+                            os.remove(source)
+                    for objname in objnames + [exename]:
+                        if os.path.exists(objname):
+                            os.remove(objname)
+                resultsh.write('"%s","%s",%d,%f,%f,%d,%d\n' % (compiler[0], 'yes' if extern else 'no', TUS, compile_seconds, link_seconds, object_bytes, program_bytes))
+                resultsh.flush()
+    sys.exit(0)
+
+counts = [int(x) for x in sys.argv[1:]] or [100, 500, 1000]
+with open('compile-time-'+sys.platform+'.csv', 'wt') as resultsh:
+    resultsh.write('"Compiler","Kind","Types","Seconds","Peak KB","Seconds per type"\n')
+    for compiler in compilers:
+        for kind in kinds:
+            for no in counts:
+                source = 'compile-time-%s-%d.cpp' % (kind[0], no)
+                objname = 'compile-time-%s-%d.o' % (kind[0], no)
+                generate(source, kind, no)
+                try:
+                    args = shlex.split(compiler[1] % objname)
+                    args.append(source)
+                    print("Compiling", no, kind[0], "types with", compiler[0], "...")
+                    # The best of three, to discount noise from the rest of the system
+                    runs = [compile_once(args) for n in range(0, 3)]
+                except (subprocess.CalledProcessError, OSError) as e:
+                    print("Compiler", compiler[0], "failed:", e)
+                    break
+                finally:
+                    os.remove(source)
+                    if os.path.exists(objname):
+                        os.remove(objname)
+                seconds = min(run[0] for run in runs)
+                maxrss = min(run[1] for run in runs) if runs[0][1] is not None else None
+                resultsh.write('"%s","%s",%d,%f,%s,%f\n' % (compiler[0], kind[0], no, seconds, '' if maxrss is None else maxrss, seconds / no))
+                resultsh.flush()
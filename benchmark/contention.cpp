@@ -0,0 +1,260 @@
+/* Benchmark of result construction from many threads, with each of the telemetry hooks installed
+Compiled with, for example:
+  g++ -std=c++17 -O3 -o contention contention.cpp -I../.. -lpthread
+Run as `contention [--failure-ppm=N] [--calls=N] [--max-threads=N]`. For each set of hooks and
+each power of two number of threads up to --max-threads (64 by default), every thread constructs
+--calls results, failing N in a million of them. Prints a CSV of the throughput, its scaling
+against one thread, and, where the Linux performance counters can be read, the cache misses per
+construction. Scaling well below the number of threads, with cache misses growing with it, is
+the mark of false sharing or atomic contention in the hooks.
+*/
+
+#include "../include/outcome/error_counters.hpp"
+#include "../include/outcome/error_info_ring.hpp"
+#include "../include/outcome/flight_recorder.hpp"
+#include "../include/outcome/hook_sampler.hpp"
+#include "../include/outcome/outcome.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace OUTCOME_V2_NAMESPACE;
+
+// Each set of hooks is found by ADL through the error code type of its namespace
+#define HOOK_SET(hooks_name)                                                                                                                                                                                                                                                                                                   \
+  struct error_code : public std::error_code                                                                                                                                                                                                                                                                                   \
+  {                                                                                                                                                                                                                                                                                                                            \
+    using std::error_code::error_code;                                                                                                                                                                                                                                                                                         \
+    error_code() = default;                                                                                                                                                                                                                                                                                                    \
+    error_code(std::error_code ec)                                                                                                                                                                                                                                                                                             \
+        : std::error_code(ec)                                                                                                                                                                                                                                                                                                  \
+    {                                                                                                                                                                                                                                                                                                                          \
+    }                                                                                                                                                                                                                                                                                                                          \
+  };                                                                                                                                                                                                                                                                                                                           \
+  using result_type = OUTCOME_V2_NAMESPACE::result<int, error_code>;                                                                                                                                                                                                                                                           \
+  struct hook_set                                                                                                                                                                                                                                                                                                              \
+  {                                                                                                                                                                                                                                                                                                                            \
+    using result_type = OUTCOME_V2_NAMESPACE::result<int, error_code>;                                                                                                                                                                                                                                                         \
+    static constexpr const char *name = hooks_name;                                                                                                                                                                                                                                                                            \
+  }
+
+namespace no_hooks
+{
+  HOOK_SET("none");
+}
+namespace counters
+{
+  HOOK_SET("error_counters");
+  template <class U> inline void hook_result_construction(result_type *res, U && /*unused*/) noexcept { error_counters::count_failure(res); }
+}  // namespace counters
+namespace info_ring
+{
+  HOOK_SET("error_info_ring");
+  struct info
+  {
+    int code{0};
+  };
+  template <class U> inline void hook_result_construction(result_type *res, U && /*unused*/) noexcept
+  {
+    if(res->has_error())
+    {
+      error_info_ring<info>::capture(res).code = res->assume_error().value();
+    }
+  }
+}  // namespace info_ring
+namespace sampler
+{
+  HOOK_SET("hook_sampler");
+  static std::atomic<unsigned> sampled;
+  template <class U> inline void hook_result_construction(result_type *res, U && /*unused*/) noexcept
+  {
+    hook_sampler<>::sample_construction(res, [](result_type * /*unused*/) { sampled.fetch_add(1, std::memory_order_relaxed); });
+  }
+}  // namespace sampler
+#ifdef OUTCOME_HAVE_FLIGHT_RECORDER
+namespace recorder
+{
+  HOOK_SET("flight_recorder");
+  template <class U> inline void hook_result_construction(result_type *res, U && /*unused*/) noexcept { flight_recorder::record_failure(res); }
+}  // namespace recorder
+#endif
+// The anti-pattern the others avoid, for comparison
+namespace shared_counter
+{
+  HOOK_SET("shared atomic counter");
+  static std::atomic<unsigned long long> failures;
+  template <class U> inline void hook_result_construction(result_type *res, U && /*unused*/) noexcept
+  {
+    if(res->has_error())
+    {
+      failures.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+}  // namespace shared_counter
+
+static unsigned failure_ppm = 1000, max_threads = 64;
+static unsigned long long calls = 1000000;
+
+// Hashes n so that which calls fail is not predictable
+template <class Result> QUICKCPPLIB_NOINLINE Result make(unsigned n)
+{
+  if(((n * 2654435761U) % 1000000U) < failure_ppm)
+  {
+    return std::error_code(5, std::generic_category());
+  }
+  return (int) n;
+}
+
+// Cache misses of this process and every thread it creates after opening
+struct cache_miss_counter
+{
+  int fd{-1};
+  cache_miss_counter()
+  {
+#ifdef __linux__
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd = (int) syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+  }
+  ~cache_miss_counter()
+  {
+#ifdef __linux__
+    if(fd != -1)
+    {
+      close(fd);
+    }
+#endif
+  }
+  void start()
+  {
+#ifdef __linux__
+    ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+  }
+  // Inherited counts are only summed into the read once the threads have exited
+  unsigned long long stop()
+  {
+    unsigned long long ret = 0;
+#ifdef __linux__
+    ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    if(read(fd, &ret, sizeof(ret)) != (ssize_t) sizeof(ret))
+    {
+      ret = 0;
+    }
+#endif
+    return ret;
+  }
+};
+
+template <class HookSet> static void run()
+{
+  using result_type = typename HookSet::result_type;
+  double single = 0;
+  for(unsigned threads = 1; threads <= max_threads; threads *= 2)
+  {
+    cache_miss_counter misses;
+    std::atomic<unsigned> ready{0};
+    std::atomic<bool> go{false};
+    std::vector<std::thread> workers;
+    std::atomic<long long> sink{0};
+    for(unsigned t = 0; t < threads; t++)
+    {
+      workers.emplace_back([&, t] {
+        ready.fetch_add(1);
+        while(!go.load(std::memory_order_acquire))
+          ;
+        long long sum = 0;
+        for(unsigned long long n = 0; n < calls; n++)
+        {
+          result_type r(make<result_type>((unsigned) (n + t * calls)));
+          sum += r.has_value() ? r.assume_value() : -1;
+        }
+        sink.fetch_add(sum);
+      });
+    }
+    while(ready.load() != threads)
+      ;
+    if(misses.fd != -1)
+    {
+      misses.start();
+    }
+    const auto begin = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for(auto &w : workers)
+    {
+      w.join();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const double ops = (double) threads * calls;
+    const double mops = ops / std::chrono::duration<double, std::micro>(end - begin).count();
+    if(threads == 1)
+    {
+      single = mops;
+    }
+    printf("\"%s\",%u,%g,%f,%f,", HookSet::name, threads, failure_ppm / 10000.0, mops, mops / single);
+    if(misses.fd != -1)
+    {
+      printf("%f\n", (double) misses.stop() / ops);
+    }
+    else
+    {
+      printf("\n");
+    }
+    fflush(stdout);
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  for(int n = 1; n < argc; n++)
+  {
+    if(strncmp(argv[n], "--failure-ppm=", 14) == 0)
+    {
+      failure_ppm = (unsigned) strtoul(argv[n] + 14, nullptr, 10);
+    }
+    else if(strncmp(argv[n], "--calls=", 8) == 0)
+    {
+      calls = strtoull(argv[n] + 8, nullptr, 10);
+    }
+    else if(strncmp(argv[n], "--max-threads=", 14) == 0)
+    {
+      max_threads = (unsigned) strtoul(argv[n] + 14, nullptr, 10);
+    }
+  }
+  printf("\"Hooks\",\"Threads\",\"Failure %%\",\"Mops/s\",\"Scaling\",\"Cache misses per op\"\n");
+  run<no_hooks::hook_set>();
+  run<counters::hook_set>();
+  run<info_ring::hook_set>();
+  run<sampler::hook_set>();
+#ifdef OUTCOME_HAVE_FLIGHT_RECORDER
+  if(flight_recorder::open("contention.flight", max_threads, 1024))
+  {
+    run<recorder::hook_set>();
+    flight_recorder::close();
+    remove("contention.flight");
+  }
+#endif
+  run<shared_counter::hook_set>();
+  return 0;
+}
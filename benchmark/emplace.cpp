@@ -0,0 +1,128 @@
+/* Benchmark of reusing a result<std::vector<int>> from one iteration of a hot loop to the next
+Compiled with, for example:
+  g++ -std=c++17 -O3 -o emplace emplace.cpp -I../..
+Run as `emplace [--iterations=N] [--items=N] [--failure-ppm=N]`. Each iteration fills the value of
+one result with --items integers, failing N in a million of them, either by assigning a freshly
+built result or by refilling the value returned by `value_mut_or_emplace()`. Prints a CSV of the
+allocations and the nanoseconds per iteration. Assignment allocates every iteration, whereas
+emplacing only allocates after a failure has destroyed the value.
+*/
+
+#include "../include/outcome/result.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <new>
+#include <vector>
+
+using namespace OUTCOME_V2_NAMESPACE;
+
+static unsigned long long allocations;
+void *operator new(size_t bytes)
+{
+  ++allocations;
+  if(void *ret = malloc(bytes))
+  {
+    return ret;
+  }
+  throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept
+{
+  free(p);
+}
+void operator delete(void *p, size_t /*unused*/) noexcept
+{
+  free(p);
+}
+
+static unsigned long long iterations = 1000000;
+static unsigned items = 64, failure_ppm = 0;
+
+// Whether iteration n fails, spread evenly through the iterations
+static inline bool fails(unsigned long long n)
+{
+  return failure_ppm != 0 && (n * failure_ppm) % 1000000 < failure_ppm;
+}
+
+// Both methods fill the vector the same way, so only the reuse of its storage differs
+static void fill(std::vector<int> &v, unsigned long long n)
+{
+  v.resize(items);
+  int *p = v.data();
+  for(unsigned i = 0; i < items; i++)
+  {
+    p[i] = (int) (n + i);
+  }
+}
+
+static result<std::vector<int>> build(unsigned long long n)
+{
+  if(fails(n))
+  {
+    return std::make_error_code(std::errc::invalid_argument);
+  }
+  std::vector<int> ret;
+  fill(ret, n);
+  return ret;
+}
+
+static void refill(result<std::vector<int>> &r, unsigned long long n)
+{
+  if(fails(n))
+  {
+    r.emplace_error(std::make_error_code(std::errc::invalid_argument));
+    return;
+  }
+  std::vector<int> &v = r.value_mut_or_emplace();
+  v.clear();
+  fill(v, n);
+}
+
+template <class F> static void run(const char *method, F &&f)
+{
+  result<std::vector<int>> r(std::make_error_code(std::errc::invalid_argument));
+  unsigned long long sum = 0;
+  // Warm up, so the steady state is measured
+  f(r, 0);
+  const unsigned long long before = allocations;
+  const auto begin = std::chrono::high_resolution_clock::now();
+  for(unsigned long long n = 1; n <= iterations; n++)
+  {
+    f(r, n);
+    sum += r ? (unsigned long long) r.assume_value().back() : 0;
+  }
+  const auto end = std::chrono::high_resolution_clock::now();
+  const unsigned long long allocated = allocations - before;
+  const double ns = (double) std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count() / (double) iterations;
+  printf("\"%s\",%u,%.2f,%llu,%.3f,%.2f\n", method, items, failure_ppm / 10000.0, allocated, (double) allocated / (double) iterations, ns);
+  if(sum == 0)
+  {
+    fprintf(stderr, "sum was zero\n");
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  for(int n = 1; n < argc; n++)
+  {
+    if(strncmp(argv[n], "--iterations=", 13) == 0)
+    {
+      iterations = strtoull(argv[n] + 13, nullptr, 10);
+    }
+    else if(strncmp(argv[n], "--items=", 8) == 0)
+    {
+      items = (unsigned) strtoul(argv[n] + 8, nullptr, 10);
+    }
+    else if(strncmp(argv[n], "--failure-ppm=", 14) == 0)
+    {
+      failure_ppm = (unsigned) strtoul(argv[n] + 14, nullptr, 10);
+    }
+  }
+  printf("\"Method\",\"Items\",\"Failure %%\",\"Allocations\",\"Allocations per iteration\",\"ns per iteration\"\n");
+  run("assign", [](result<std::vector<int>> &r, unsigned long long n) { r = build(n); });
+  run("value_mut_or_emplace", [](result<std::vector<int>> &r, unsigned long long n) { refill(r, n); });
+  return 0;
+}
@@ -0,0 +1,101 @@
+/* Benchmark of comparing adjacent result<uint64_t, uint32_t>, as a dedup stage would
+Compiled with, for example:
+  g++ -std=c++17 -O3 -o equality equality.cpp -I../..
+Run as `equality [--items=N] [--repeats=N] [--failure-ppm=N] [--duplicate-ppm=N]`. Counts the
+items equal to the one before, failing N in a million of them and repeating the one before M in
+a million, either by `operator==`, which compares the bytes of such results without branching,
+or member by member as `operator==` does for other types. Prints a CSV of the nanoseconds per
+comparison.
+*/
+
+#include "../include/outcome/result.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <random>
+#include <vector>
+
+using namespace OUTCOME_V2_NAMESPACE;
+using result_type = result<uint64_t, uint32_t>;
+
+static size_t items = 1000000;
+static unsigned repeats = 20, failure_ppm = 10000, duplicate_ppm = 500000;
+
+// As operator== compares results whose types are not bytewise comparable
+static inline bool memberwise_equal(const result_type &a, const result_type &b)
+{
+  if(a.has_value() != b.has_value())
+  {
+    return false;
+  }
+  if(a.has_value())
+  {
+    return a.assume_value() == b.assume_value() && a.assume_error() == b.assume_error();
+  }
+  return a.assume_error() == b.assume_error();
+}
+
+template <class F> static void run(const char *method, const std::vector<result_type> &v, F &&f)
+{
+  size_t duplicates = 0;
+  const auto begin = std::chrono::high_resolution_clock::now();
+  for(unsigned r = 0; r < repeats; r++)
+  {
+    for(size_t n = 1; n < v.size(); n++)
+    {
+      duplicates += f(v[n - 1], v[n]) ? 1 : 0;
+    }
+  }
+  const auto end = std::chrono::high_resolution_clock::now();
+  const double ns = (double) std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count() / (double) (repeats * (v.size() - 1));
+  printf("\"%s\",%zu,%.2f,%.2f,%zu,%.3f\n", method, items, failure_ppm / 10000.0, duplicate_ppm / 10000.0, duplicates / repeats, ns);
+}
+
+int main(int argc, char *argv[])
+{
+  for(int n = 1; n < argc; n++)
+  {
+    if(strncmp(argv[n], "--items=", 8) == 0)
+    {
+      items = (size_t) strtoull(argv[n] + 8, nullptr, 10);
+    }
+    else if(strncmp(argv[n], "--repeats=", 10) == 0)
+    {
+      repeats = (unsigned) strtoul(argv[n] + 10, nullptr, 10);
+    }
+    else if(strncmp(argv[n], "--failure-ppm=", 14) == 0)
+    {
+      failure_ppm = (unsigned) strtoul(argv[n] + 14, nullptr, 10);
+    }
+    else if(strncmp(argv[n], "--duplicate-ppm=", 16) == 0)
+    {
+      duplicate_ppm = (unsigned) strtoul(argv[n] + 16, nullptr, 10);
+    }
+  }
+  // Random, so the branches of the member by member comparison are unpredictable
+  std::mt19937_64 rand(78);
+  std::uniform_int_distribution<unsigned> ppm(0, 999999);
+  std::vector<result_type> v;
+  v.reserve(items);
+  for(size_t n = 0; n < items; n++)
+  {
+    if(n > 0 && ppm(rand) < duplicate_ppm)
+    {
+      v.push_back(v.back());
+    }
+    else if(ppm(rand) < failure_ppm)
+    {
+      v.push_back(result_type(in_place_type<uint32_t>, (uint32_t) (rand() % 4)));
+    }
+    else
+    {
+      v.push_back(result_type(in_place_type<uint64_t>, rand() % 4));
+    }
+  }
+  printf("\"Method\",\"Items\",\"Failure %%\",\"Duplicate %%\",\"Duplicates\",\"ns per comparison\"\n");
+  run("operator==", v, [](const result_type &a, const result_type &b) { return a == b; });
+  run("member by member", v, [](const result_type &a, const result_type &b) { return memberwise_equal(a, b); });
+  return 0;
+}
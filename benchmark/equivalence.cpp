@@ -0,0 +1,97 @@
+/* Benchmark of routing failed results by the error condition their error is equivalent to
+Compiled with, for example:
+  g++ -std=c++17 -O3 -o equivalence equivalence.cpp -I../..
+Run as `equivalence [--items=N] [--repeats=N] [--codes=N]`. Finds for each of N failed results,
+whose errors are drawn from --codes error codes of a user category comparing names by string, the
+first of eight error conditions it is equivalent to, either by `==`, which asks the categories
+every time, or by `cached_equivalent()`. Prints a CSV of the nanoseconds per result.
+*/
+
+#include "../include/outcome/error_equivalence.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace OUTCOME_V2_NAMESPACE;
+
+static size_t items = 100000;
+static unsigned repeats = 20, codes = 32;
+
+// As many user categories do, maps its codes onto generic conditions by comparing strings
+class user_category : public std::error_category
+{
+public:
+  const char *name() const noexcept override { return "user"; }
+  std::string message(int c) const override { return "user " + std::to_string(c); }
+  bool equivalent(int code, const std::error_condition &cond) const noexcept override
+  {
+    if(cond.category() != std::generic_category())
+    {
+      return false;
+    }
+    static const char *const names[] = {"timed out", "refused", "denied", "invalid", "busy", "reset", "full", "gone"};
+    return strcmp(names[code % 8], names[cond.value() % 8]) == 0;
+  }
+};
+static const user_category category;
+
+static const std::errc conditions[8] = {std::errc::timed_out, std::errc::connection_refused, std::errc::permission_denied, std::errc::invalid_argument,
+                                        std::errc::device_or_resource_busy, std::errc::connection_reset, std::errc::no_space_on_device, std::errc::no_such_file_or_directory};
+
+template <class F> static void run(const char *method, const std::vector<result<int>> &v, F &&equivalent)
+{
+  size_t routed = 0;
+  const auto begin = std::chrono::high_resolution_clock::now();
+  for(unsigned r = 0; r < repeats; r++)
+  {
+    for(const auto &i : v)
+    {
+      for(size_t c = 0; c < 8; c++)
+      {
+        if(equivalent(i.error(), conditions[c]))
+        {
+          routed += c;
+          break;
+        }
+      }
+    }
+  }
+  const auto end = std::chrono::high_resolution_clock::now();
+  const double ns = (double) std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count() / (double) (repeats * v.size());
+  printf("\"%s\",%zu,%u,%zu,%.3f\n", method, items, codes, routed / repeats, ns);
+}
+
+int main(int argc, char *argv[])
+{
+  for(int n = 1; n < argc; n++)
+  {
+    if(strncmp(argv[n], "--items=", 8) == 0)
+    {
+      items = (size_t) strtoull(argv[n] + 8, nullptr, 10);
+    }
+    else if(strncmp(argv[n], "--repeats=", 10) == 0)
+    {
+      repeats = (unsigned) strtoul(argv[n] + 10, nullptr, 10);
+    }
+    else if(strncmp(argv[n], "--codes=", 8) == 0)
+    {
+      codes = (unsigned) strtoul(argv[n] + 8, nullptr, 10);
+    }
+  }
+  std::mt19937 rand(78);
+  std::vector<result<int>> v;
+  v.reserve(items);
+  for(size_t n = 0; n < items; n++)
+  {
+    v.push_back(std::error_code((int) (rand() % codes), category));
+  }
+  printf("\"Method\",\"Items\",\"Codes\",\"Routed\",\"ns per result\"\n");
+  run("==", v, [](const std::error_code &ec, std::errc c) { return ec == c; });
+  run("cached_equivalent()", v, [](const std::error_code &ec, std::errc c) { return cached_equivalent(ec, c); });
+  return 0;
+}
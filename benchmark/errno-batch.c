@@ -0,0 +1,71 @@
+/* Benchmark of converting arrays of C results into errno values
+Compiled with, for example:
+  gcc -std=c11 -O3 -o errno-batch errno-batch.c
+Prints the nanoseconds per result of calling CXX_RESULT_SET_ERRNO() on each in turn, and of the
+batch cxx_results_int_errorcode_to_errno(), for arrays of which a varying fraction are errored.
+*/
+
+#include "timing.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../include/outcome/result.h"
+
+CXX_DECLARE_RESULT_EC(int, int);
+CXX_DECLARE_RESULT_EC_TO_ERRNO(int, int)
+
+#define ITEMS 4096
+#define ITERATIONS 10000
+
+static CXX_RESULT_EC(int) results[ITEMS];
+static int out[ITEMS];
+volatile int sink;
+
+static void one_at_a_time(void)
+{
+  size_t n;
+  for(n = 0; n < ITEMS; n++)
+  {
+    CXX_RESULT_SET_ERRNO(results[n]);
+    out[n] = errno;
+  }
+}
+
+static void batch(void) { sink += (int) cxx_results_int_errorcode_to_errno(results, ITEMS, out); }
+
+static double time_per_item(void (*f)(void))
+{
+  usCount start;
+  int n;
+  f();
+  start = GetUsCount();
+  for(n = 0; n < ITERATIONS; n++)
+  {
+    f();
+    sink += out[n % ITEMS];
+  }
+  /* GetUsCount() counts picoseconds */
+  return (double) (GetUsCount() - start) / 1000.0 / ITERATIONS / ITEMS;
+}
+
+int main(void)
+{
+  static const int percents[] = {0, 1, 10, 50};
+  size_t p, n;
+  srand(78);
+  printf("\"Errored %%\",\"one-at-a-time ns\",\"batch ns\"\n");
+  for(p = 0; p < sizeof(percents) / sizeof(percents[0]); p++)
+  {
+    for(n = 0; n < ITEMS; n++)
+    {
+      const int errored = (rand() % 100) < percents[p];
+      results[n].value = (int) n;
+      results[n].flags = errored ? (2U | ((n & 1) ? (1U << 4U) : 0)) : 1U;
+      results[n].error.code = errored ? ENOENT : 0;
+      results[n].error.category = 0;
+    }
+    printf("%d,%f,%f\n", percents[p], time_per_item(one_at_a_time), time_per_item(batch));
+  }
+  return 0;
+}
@@ -0,0 +1,382 @@
+/* Benchmark of how each storage layout of result behaves in the cache over large arrays
+Compiled with, for example:
+  g++ -std=c++17 -O3 -DNDEBUG -o layouts layouts.cpp -I../..
+and again with -DOUTCOME_ENABLE_COMPACT_STATUS for the eight bit status, as `benchmark.py layouts`
+does. Run as `layouts [--min-elements=N] [--max-elements=N] [--max-bytes=N] [--failure-ppm=N]`.
+
+Arrays of 10^3 to 10^8 results, failing N in a million of them, are scanned for failures, filtered
+for the values of those which succeeded, and transformed into a second array, for values of 4, 8
+and 64 bytes and errors of 4 and 16 bytes, in each of the layouts:
+- overlapping: the default `result<T, E>`, with the value, the error and a status word side by side
+- disjoint: `trait::disjoint_storage`, with the value and the error sharing a union
+- niche: `trait::niche`, with the status in the unused NaNs of a `double` value
+- soa: `result_vector<T, E>`, a structure of arrays with a failure bitmap
+Configurations whose arrays would need more than --max-bytes, by default 4 GiB, are skipped.
+
+Prints a CSV of the layout, the sizes, the operation, the nanoseconds per element and, if the Linux
+performance counters could be opened, the last level cache misses per element.
+*/
+
+#include "../include/outcome/result_vector.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace OUTCOME_V2_NAMESPACE;
+
+static unsigned long long min_elements = 1000, max_elements = 100000000, max_bytes = 4ULL << 30U;
+static unsigned failure_ppm = 10000;
+static volatile unsigned long long sink;
+
+#ifdef OUTCOME_ENABLE_COMPACT_STATUS
+static const char *const status_suffix = "+compact-status";
+#else
+static const char *const status_suffix = "";
+#endif
+
+struct disjoint_tag
+{
+};
+template <size_t Bytes, class Tag = void> struct payload
+{
+  uint32_t v[Bytes / sizeof(uint32_t)];
+};
+enum class small_error : uint32_t
+{
+  none,
+  failed
+};
+
+namespace OUTCOME_V2_NAMESPACE
+{
+  namespace trait
+  {
+    template <size_t Bytes, class E> struct disjoint_storage<payload<Bytes, disjoint_tag>, E>
+    {
+      static constexpr bool value = true;
+    };
+    template <> struct niche<double> : niche_nan<double>
+    {
+    };
+  }  // namespace trait
+}  // namespace OUTCOME_V2_NAMESPACE
+
+template <size_t Bytes, class Tag> static inline payload<Bytes, Tag> make_value(unsigned long long n)
+{
+  payload<Bytes, Tag> ret;
+  for(auto &i : ret.v)
+  {
+    i = (uint32_t) n;
+  }
+  return ret;
+}
+template <size_t Bytes, class Tag> static inline uint32_t first_word(const payload<Bytes, Tag> &v)
+{
+  return v.v[0];
+}
+template <size_t Bytes, class Tag> static inline payload<Bytes, Tag> bump(payload<Bytes, Tag> v)
+{
+  v.v[0] += 1;
+  return v;
+}
+static inline double make_double(unsigned long long n)
+{
+  return (double) n;
+}
+static inline uint32_t first_word(double v)
+{
+  return (uint32_t) v;
+}
+static inline double bump(double v)
+{
+  return v + 1;
+}
+static inline std::error_code make_error(std::error_code * /*unused*/)
+{
+  return std::make_error_code(std::errc::invalid_argument);
+}
+static inline small_error make_error(small_error * /*unused*/)
+{
+  return small_error::failed;
+}
+
+// Whether element n fails, hashed so that which do is not predictable
+static inline bool fails(unsigned long long n)
+{
+  return ((unsigned) n * 2654435761U) % 1000000U < failure_ppm;
+}
+
+// The last level cache read misses of this thread, else the generic cache misses
+struct llc_counter
+{
+  int fd{-1};
+  llc_counter()
+  {
+#ifdef __linux__
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8U) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16U);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd = (int) syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+    if(fd == -1)
+    {
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = PERF_COUNT_HW_CACHE_MISSES;
+      fd = (int) syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+#endif
+  }
+  ~llc_counter()
+  {
+#ifdef __linux__
+    if(fd != -1)
+    {
+      close(fd);
+    }
+#endif
+  }
+  void start()
+  {
+#ifdef __linux__
+    if(fd != -1)
+    {
+      ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+  }
+  // The misses since start(), or -1 if they could not be counted
+  long long stop()
+  {
+#ifdef __linux__
+    unsigned long long ret;
+    if(fd != -1)
+    {
+      ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+      if(read(fd, &ret, sizeof(ret)) == (ssize_t) sizeof(ret))
+      {
+        return (long long) ret;
+      }
+    }
+#endif
+    return -1;
+  }
+};
+
+// An array of results one after another
+template <class T, class E> struct aos
+{
+  using result_type = result<T, E>;
+  using array = std::vector<result_type>;
+  static constexpr size_t element_bytes = sizeof(result_type);
+
+  static void fill(array &a, unsigned long long n, T (*make)(unsigned long long))
+  {
+    a.clear();
+    a.reserve(n);
+    for(unsigned long long i = 0; i < n; i++)
+    {
+      if(fails(i))
+      {
+        a.push_back(result_type(in_place_type<E>, make_error((E *) nullptr)));
+      }
+      else
+      {
+        a.push_back(result_type(in_place_type<T>, make(i)));
+      }
+    }
+  }
+  static unsigned long long scan(const array &a)
+  {
+    unsigned long long ret = 0;
+    for(const auto &r : a)
+    {
+      ret += !r.has_value();
+    }
+    return ret;
+  }
+  static unsigned long long filter(const array &a)
+  {
+    unsigned long long ret = 0;
+    for(const auto &r : a)
+    {
+      if(r.has_value())
+      {
+        ret += first_word(r.assume_value());
+      }
+    }
+    return ret;
+  }
+  static unsigned long long transform(const array &a, array &out)
+  {
+    for(size_t i = 0; i < a.size(); i++)
+    {
+      if(a[i].has_value())
+      {
+        out[i] = result_type(in_place_type<T>, bump(a[i].assume_value()));
+      }
+      else
+      {
+        out[i] = result_type(in_place_type<E>, a[i].assume_error());
+      }
+    }
+    return out.size();
+  }
+};
+
+// A structure of arrays, the values, the errors and a failure bitmap
+template <class T, class E> struct soa
+{
+  using result_type = result<T, E>;
+  using array = result_vector<T, E>;
+  static constexpr size_t element_bytes = sizeof(T) + sizeof(E);
+
+  static void fill(array &a, unsigned long long n, T (*make)(unsigned long long))
+  {
+    a.clear();
+    a.reserve(n);
+    for(unsigned long long i = 0; i < n; i++)
+    {
+      if(fails(i))
+      {
+        a.push_back(result_type(in_place_type<E>, make_error((E *) nullptr)));
+      }
+      else
+      {
+        a.push_back(result_type(in_place_type<T>, make(i)));
+      }
+    }
+  }
+  static unsigned long long scan(const array &a) { return a.count_failures(); }
+  static unsigned long long filter(const array &a)
+  {
+    unsigned long long ret = 0;
+    for(size_t i = 0; i < a.size(); i++)
+    {
+      const auto r = a[i];
+      if(r.has_value())
+      {
+        ret += first_word(r.assume_value());
+      }
+    }
+    return ret;
+  }
+  static unsigned long long transform(const array &a, array &out)
+  {
+    for(size_t i = 0; i < a.size(); i++)
+    {
+      const auto r = a[i];
+      if(r.has_value())
+      {
+        out[i] = result_type(in_place_type<T>, bump(r.assume_value()));
+      }
+      else
+      {
+        out[i] = result_type(in_place_type<E>, r.assume_error());
+      }
+    }
+    return out.size();
+  }
+};
+
+template <class F> static void measure(const char *layout, size_t value_bytes, size_t error_bytes, size_t element_bytes, unsigned long long n, const char *operation, F &&f)
+{
+  // Enough passes for at least 10^8 elements, so that small arrays are timed warm in the cache
+  const unsigned long long passes = std::max<unsigned long long>(1, 100000000ULL / n);
+  llc_counter llc;
+  f();
+  llc.start();
+  const auto begin = std::chrono::steady_clock::now();
+  for(unsigned long long pass = 0; pass < passes; pass++)
+  {
+    sink = sink + f();
+  }
+  const auto end = std::chrono::steady_clock::now();
+  const long long misses = llc.stop();
+  const double elements = (double) passes * (double) n;
+  printf("\"%s%s\",%u,%u,%u,%llu,\"%s\",%.3f,", layout, status_suffix, (unsigned) value_bytes, (unsigned) error_bytes, (unsigned) element_bytes, n, operation, (double) std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count() / elements);
+  if(misses >= 0)
+  {
+    printf("%.4f\n", (double) misses / elements);
+  }
+  else
+  {
+    printf("\n");
+  }
+  fflush(stdout);
+}
+
+template <class Layout, class T> static void sweep(const char *layout, T (*make)(unsigned long long))
+{
+  using E = typename Layout::result_type::error_type;
+  for(unsigned long long n = min_elements; n <= max_elements; n *= 10)
+  {
+    // The transform writes a second array
+    if(2 * n * Layout::element_bytes > max_bytes)
+    {
+      break;
+    }
+    typename Layout::array in, out;
+    Layout::fill(in, n, make);
+    Layout::fill(out, n, make);
+    measure(layout, sizeof(T), sizeof(E), Layout::element_bytes, n, "scan", [&] { return Layout::scan(in); });
+    measure(layout, sizeof(T), sizeof(E), Layout::element_bytes, n, "filter", [&] { return Layout::filter(in); });
+    measure(layout, sizeof(T), sizeof(E), Layout::element_bytes, n, "transform", [&] { return Layout::transform(in, out); });
+  }
+}
+
+template <class E> static void sweep_errors()
+{
+  sweep<aos<payload<4>, E>>("overlapping", make_value<4, void>);
+  sweep<aos<payload<8>, E>>("overlapping", make_value<8, void>);
+  sweep<aos<payload<64>, E>>("overlapping", make_value<64, void>);
+  sweep<aos<payload<4, disjoint_tag>, E>>("disjoint", make_value<4, disjoint_tag>);
+  sweep<aos<payload<8, disjoint_tag>, E>>("disjoint", make_value<8, disjoint_tag>);
+  sweep<aos<payload<64, disjoint_tag>, E>>("disjoint", make_value<64, disjoint_tag>);
+  sweep<aos<double, E>>("niche", make_double);
+  sweep<soa<payload<4>, E>>("soa", make_value<4, void>);
+  sweep<soa<payload<8>, E>>("soa", make_value<8, void>);
+  sweep<soa<payload<64>, E>>("soa", make_value<64, void>);
+}
+
+int main(int argc, char *argv[])
+{
+  for(int n = 1; n < argc; n++)
+  {
+    if(strncmp(argv[n], "--min-elements=", 15) == 0)
+    {
+      min_elements = strtoull(argv[n] + 15, nullptr, 10);
+    }
+    else if(strncmp(argv[n], "--max-elements=", 15) == 0)
+    {
+      max_elements = strtoull(argv[n] + 15, nullptr, 10);
+    }
+    else if(strncmp(argv[n], "--max-bytes=", 12) == 0)
+    {
+      max_bytes = strtoull(argv[n] + 12, nullptr, 10);
+    }
+    else if(strncmp(argv[n], "--failure-ppm=", 14) == 0)
+    {
+      failure_ppm = (unsigned) strtoul(argv[n] + 14, nullptr, 10);
+    }
+  }
+  printf("\"Layout\",\"Value bytes\",\"Error bytes\",\"Element bytes\",\"Elements\",\"Operation\",\"ns per element\",\"LLC misses per element\"\n");
+  sweep_errors<std::error_code>();
+  sweep_errors<small_error>();
+  return 0;
+}
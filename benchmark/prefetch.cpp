@@ -0,0 +1,142 @@
+/* Benchmark of the prefetching iteration of result_vector over batches far larger than the cache
+Compiled with, for example:
+  g++ -std=c++17 -O3 -DNDEBUG -o prefetch prefetch.cpp -I../..
+as `benchmark.py prefetch` does. Run as `prefetch [--min-elements=N] [--max-elements=N] [--max-bytes=N] [--failure-ppm=N]`.
+
+Batches of 10^6 to 10^8 results, failing N in a million of them, by default a hundred thousand, are
+visited with `for_each_value()` and `for_each_error()`, and a batch without failures is extracted
+with `unwrap_all()`, for values of 8 and 64 bytes, at prefetch distances from none to 8192 items.
+A batch of 10^8 results of eight byte values is over a gigabyte, so far beyond any last level cache.
+Configurations whose arrays would need more than --max-bytes, by default 4 GiB, are skipped.
+
+Prints a CSV of the sizes, the operation, the prefetch distance and the nanoseconds per element.
+*/
+
+#include "../include/outcome/result_vector.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+using namespace OUTCOME_V2_NAMESPACE;
+
+static unsigned long long min_elements = 1000000, max_elements = 100000000, max_bytes = 4ULL << 30U;
+static unsigned failure_ppm = 100000;
+static volatile unsigned long long sink;
+static const size_t distances[] = {0, 64, 128, 256, 512, 1024, 2048, 4096, 8192};
+
+template <size_t Bytes> struct payload
+{
+  uint32_t v[Bytes / sizeof(uint32_t)];
+};
+enum class small_error : uint32_t
+{
+  none,
+  failed
+};
+
+// Whether element n fails, hashed so that which do is not predictable
+static inline bool fails(unsigned long long n)
+{
+  return ((unsigned) n * 2654435761U) % 1000000U < failure_ppm;
+}
+
+template <size_t Bytes> static void fill(result_vector<payload<Bytes>, small_error> &a, unsigned long long n, bool failures)
+{
+  using result_type = typename result_vector<payload<Bytes>, small_error>::result_type;
+  a.clear();
+  a.reserve(n);
+  for(unsigned long long i = 0; i < n; i++)
+  {
+    if(failures && fails(i))
+    {
+      a.push_back(result_type(in_place_type<small_error>, small_error::failed));
+    }
+    else
+    {
+      payload<Bytes> v;
+      for(auto &w : v.v)
+      {
+        w = (uint32_t) i;
+      }
+      a.push_back(result_type(in_place_type<payload<Bytes>>, v));
+    }
+  }
+}
+
+template <class F> static void measure(size_t value_bytes, unsigned long long n, const char *operation, size_t distance, F &&f)
+{
+  // Enough passes for at least 10^8 elements
+  const unsigned long long passes = std::max<unsigned long long>(1, 100000000ULL / n);
+  f();
+  const auto begin = std::chrono::steady_clock::now();
+  for(unsigned long long pass = 0; pass < passes; pass++)
+  {
+    sink = sink + f();
+  }
+  const auto end = std::chrono::steady_clock::now();
+  const double elements = (double) passes * (double) n;
+  printf("%u,%u,%llu,\"%s\",%u,%.3f\n", (unsigned) value_bytes, (unsigned) sizeof(small_error), n, operation, (unsigned) distance, (double) std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count() / elements);
+  fflush(stdout);
+}
+
+template <size_t Bytes> static void sweep()
+{
+  using array = result_vector<payload<Bytes>, small_error>;
+  for(unsigned long long n = min_elements; n <= max_elements; n *= 10)
+  {
+    // The failing batch, the batch without failures and the output of unwrap_all()
+    if(n * (3 * Bytes + 2 * sizeof(small_error)) > max_bytes)
+    {
+      break;
+    }
+    array in, valued;
+    fill(in, n, true);
+    fill(valued, n, false);
+    std::vector<payload<Bytes>> out(n);
+    for(size_t distance : distances)
+    {
+      measure(Bytes, n, "for_each_value", distance, [&] {
+        unsigned long long ret = 0;
+        in.for_each_value([&](size_t /*unused*/, const payload<Bytes> &v) { ret += v.v[0]; }, distance);
+        return ret;
+      });
+      measure(Bytes, n, "for_each_error", distance, [&] {
+        unsigned long long ret = 0;
+        in.for_each_error([&](size_t idx, small_error e) { ret += idx + (unsigned) e; }, distance);
+        return ret;
+      });
+      measure(Bytes, n, "unwrap_all", distance, [&] { return valued.unwrap_all(out.data(), distance).value() + out[n / 2].v[0]; });
+    }
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  for(int n = 1; n < argc; n++)
+  {
+    if(strncmp(argv[n], "--min-elements=", 15) == 0)
+    {
+      min_elements = strtoull(argv[n] + 15, nullptr, 10);
+    }
+    else if(strncmp(argv[n], "--max-elements=", 15) == 0)
+    {
+      max_elements = strtoull(argv[n] + 15, nullptr, 10);
+    }
+    else if(strncmp(argv[n], "--max-bytes=", 12) == 0)
+    {
+      max_bytes = strtoull(argv[n] + 12, nullptr, 10);
+    }
+    else if(strncmp(argv[n], "--failure-ppm=", 14) == 0)
+    {
+      failure_ppm = (unsigned) strtoul(argv[n] + 14, nullptr, 10);
+    }
+  }
+  printf("\"Value bytes\",\"Error bytes\",\"Elements\",\"Operation\",\"Prefetch distance\",\"ns per element\"\n");
+  sweep<8>();
+  sweep<64>();
+  return 0;
+}
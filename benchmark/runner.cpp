@@ -1,37 +1,203 @@
-#include "timing.h"
 #include "../include/outcome/result.hpp"
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
 #include <exception>
+#include <vector>
 #include "function.h"
 
-#define ITERATIONS 100000
-#define CPU_US_PER_CLOCK (1000000000000.0/(3292.0*1000000.0))
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define HAVE_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_TSC 1
+#endif
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Calls of FUNCTION per trial, and trials, of which the first WARMUP are discarded
+#define CALLS_PER_TRIAL 1000
+#define TRIALS 200
+#define WARMUP 10
 
 extern volatile int counter;
 volatile int counter, forcereturn;
+// Failures per million calls, for the benchmarks of the failure rate sweep
+extern volatile unsigned failure_ppm;
+volatile unsigned failure_ppm;
 
-int main(void)
+// Ticks of the TSC where there is one, else nanoseconds
+static inline unsigned long long ticks()
 {
-  usCount start=GetUsCount();
-  while(GetUsCount()-start<1*1000000000000LL);
-  start=GetUsCount();
-  for(int n=0; n<ITERATIONS; n++)
+#ifdef HAVE_TSC
+  return __rdtsc();
+#else
+  return (unsigned long long) std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// TSC ticks per nanosecond, measured against the steady clock over 50 ms
+static double calibrate_ticks_per_ns()
+{
+#ifdef HAVE_TSC
+  auto begin = std::chrono::steady_clock::now();
+  unsigned long long tsc_begin = ticks();
+  while(std::chrono::steady_clock::now() - begin < std::chrono::milliseconds(50))
+    ;
+  auto end = std::chrono::steady_clock::now();
+  unsigned long long tsc_end = ticks();
+  return (double) (tsc_end - tsc_begin) / (double) std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+#else
+  return 1.0;
+#endif
+}
+
+// Optional Linux performance counters of instructions, branches and branch misses
+struct perf_counters
+{
+  int fds[3]{-1, -1, -1};
+  bool open()
   {
+#ifdef __linux__
+    static const unsigned long long configs[3] = {PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_MISSES};
+    for(int n = 0; n < 3; n++)
+    {
+      struct perf_event_attr attr;
+      memset(&attr, 0, sizeof(attr));
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.size = sizeof(attr);
+      attr.config = configs[n];
+      attr.disabled = (n == 0);
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      fds[n] = (int) syscall(__NR_perf_event_open, &attr, 0, -1, n ? fds[0] : -1, 0);
+      if(fds[n] == -1)
+      {
+        return false;
+      }
+    }
+    return true;
+#else
+    return false;
+#endif
+  }
+  void start()
+  {
+#ifdef __linux__
+    ioctl(fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+  }
+  void stop(unsigned long long *values)
+  {
+#ifdef __linux__
+    ioctl(fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    for(int n = 0; n < 3; n++)
+    {
+      if(read(fds[n], &values[n], sizeof(values[n])) != (ssize_t) sizeof(values[n]))
+      {
+        values[n] = 0;
+      }
+    }
+#else
+    (void) values;
+#endif
+  }
+};
+
+static inline void call(int n)
+{
 #if !defined(_CPPUNWIND) && !defined(__EXCEPTIONS)
-    forcereturn += !FUNCTION(n);
+  forcereturn += !FUNCTION(n);
 #else
-    try
+  try
+  {
+    forcereturn += !FUNCTION(n);
+  }
+  catch(const std::exception &)
+  {
+  }
+#endif
+}
+
+/* Prints the median cycles per call of FUNCTION, which is one field of the results CSV.
+With --csv, prints instead the median and 99th percentile cycles per call, and if the Linux
+performance counters could be opened, the instructions, branches and branch misses per call.
+With --failure-ppm=N, the benchmarks of the failure rate sweep fail N calls in a million.
+*/
+int main(int argc, char *argv[])
+{
+  bool csv = false;
+  for(int n = 1; n < argc; n++)
+  {
+    if(strcmp(argv[n], "--csv") == 0)
     {
-      forcereturn += !FUNCTION(n);
+      csv = true;
     }
-    catch(const std::exception &)
+    else if(strncmp(argv[n], "--failure-ppm=", 14) == 0)
     {
+      failure_ppm = (unsigned) strtoul(argv[n] + 14, nullptr, 10);
     }
-#endif
   }
-  double time=GetUsCount()-start;
-  time/=ITERATIONS;
-  double ticks=time/CPU_US_PER_CLOCK/*/NESTING*/;
-  printf("%f\n", ticks);
+  const double ticks_per_ns = calibrate_ticks_per_ns();
+  perf_counters perf;
+  const bool have_perf = csv && perf.open();
+  unsigned long long events[3] = {0, 0, 0};
+  std::vector<double> cycles;
+  cycles.reserve(TRIALS);
+  for(int trial = 0; trial < WARMUP + TRIALS; trial++)
+  {
+    unsigned long long trial_events[3] = {0, 0, 0};
+    if(have_perf)
+    {
+      perf.start();
+    }
+    const unsigned long long begin = ticks();
+    for(int n = 0; n < CALLS_PER_TRIAL; n++)
+    {
+      call(n);
+    }
+    const unsigned long long end = ticks();
+    if(have_perf)
+    {
+      perf.stop(trial_events);
+    }
+    if(trial >= WARMUP)
+    {
+      // TSC ticks are cycles at the nominal frequency, not at whatever the core is clocked at
+      cycles.push_back((double) (end - begin) / CALLS_PER_TRIAL);
+      for(int n = 0; n < 3; n++)
+      {
+        events[n] += trial_events[n];
+      }
+    }
+  }
+  std::sort(cycles.begin(), cycles.end());
+  const double median = cycles[cycles.size() / 2];
+  const double p99 = cycles[(cycles.size() * 99) / 100];
+  if(!csv)
+  {
+    printf("%f\n", median);
+    return 0;
+  }
+  printf("%f,%f", median, p99);
+  if(have_perf)
+  {
+    const double calls = (double) TRIALS * CALLS_PER_TRIAL;
+    printf(",%f,%f,%f", events[0] / calls, events[1] / calls, events[2] / calls);
+  }
+  else
+  {
+    printf(",,,");
+  }
+  printf(",%f\n", ticks_per_ns);
   return 0;
 }
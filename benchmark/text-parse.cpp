@@ -0,0 +1,108 @@
+/* Benchmark of reloading a text dump of results, by the stream extraction and by from_chars()
+Compiled with, for example:
+  g++ -std=c++17 -O3 -DNDEBUG -o text-parse text-parse.cpp -I../..
+Run as `text-parse [--items=N] [--repeats=N] [--failure-ppm=N]`. Writes N result<int, long>, by
+default a million, failing M in a million of them, one per line with `operator<<`, then reads
+them all back with `operator>>` from a `std::istringstream` and with `from_chars()`, checking each
+against what was written. Prints a CSV of the size of the dump, the milliseconds of the quickest
+of the repeats and the nanoseconds per result.
+*/
+
+#include "../include/outcome/iostream_support.hpp"
+#include "../include/outcome/text_parse.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace OUTCOME_V2_NAMESPACE;
+using result_type = result<int, long>;
+
+static size_t items = 1000000;
+static unsigned repeats = 5, failure_ppm = 100000;
+
+template <class F> static void run(const char *method, const std::string &dump, const std::vector<result_type> &v, F &&f)
+{
+  double best = 1e300;
+  for(unsigned r = 0; r < repeats; r++)
+  {
+    std::vector<result_type> out;
+    out.reserve(v.size());
+    const auto begin = std::chrono::high_resolution_clock::now();
+    f(dump, out);
+    const auto end = std::chrono::high_resolution_clock::now();
+    if(out != v)
+    {
+      fprintf(stderr, "FATAL: %s read back %zu results which differ from the %zu written\n", method, out.size(), v.size());
+      exit(1);
+    }
+    best = std::min(best, (double) std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+  }
+  printf("\"%s\",%zu,%.2f,%zu,%.2f,%.2f\n", method, items, failure_ppm / 10000.0, dump.size(), best / 1000000.0, best / (double) items);
+}
+
+int main(int argc, char *argv[])
+{
+  for(int n = 1; n < argc; n++)
+  {
+    if(strncmp(argv[n], "--items=", 8) == 0)
+    {
+      items = (size_t) strtoull(argv[n] + 8, nullptr, 10);
+    }
+    else if(strncmp(argv[n], "--repeats=", 10) == 0)
+    {
+      repeats = (unsigned) strtoul(argv[n] + 10, nullptr, 10);
+    }
+    else if(strncmp(argv[n], "--failure-ppm=", 14) == 0)
+    {
+      failure_ppm = (unsigned) strtoul(argv[n] + 14, nullptr, 10);
+    }
+  }
+  std::mt19937 rand(78);
+  std::uniform_int_distribution<unsigned> ppm(0, 999999);
+  std::vector<result_type> v;
+  v.reserve(items);
+  std::ostringstream s;
+  for(size_t n = 0; n < items; n++)
+  {
+    if(ppm(rand) < failure_ppm)
+    {
+      v.push_back(result_type(in_place_type<long>, (long) (rand() % 200)));
+    }
+    else
+    {
+      v.push_back(result_type(in_place_type<int>, (int) rand()));
+    }
+    s << v.back() << "\n";
+  }
+  const std::string dump = s.str();
+  printf("\"Method\",\"Items\",\"Failure %%\",\"Bytes\",\"ms\",\"ns per result\"\n");
+  run("istream", dump, v, [](const std::string &dump, std::vector<result_type> &out) {
+    std::istringstream in(dump);
+    for(;;)
+    {
+      // Extraction leaves the error of a result it reads a value into, which operator== compares
+      result_type r(in_place_type<int>, 0);
+      if(!(in >> r))
+      {
+        break;
+      }
+      out.push_back(r);
+    }
+  });
+  run("from_chars", dump, v, [](const std::string &dump, std::vector<result_type> &out) {
+    const char *p = dump.data(), *end = dump.data() + dump.size();
+    result_type r(in_place_type<int>, 0);
+    for(std::from_chars_result f; (f = from_chars(p, end, r)).ec == std::errc(); p = f.ptr)
+    {
+      out.push_back(r);
+    }
+  });
+  return 0;
+}
@@ -143,6 +143,11 @@ exported Boost.Outcome v2 namespace.
 #define BOOST_OUTCOME_THROW_EXCEPTION(expr) BOOST_THROW_EXCEPTION(expr)
 #endif
 
+// Boost users mostly use boost::system::error_code, so handle it natively unless told otherwise
+#if !defined(BOOST_OUTCOME_ENABLE_BOOST_SYSTEM) && !defined(BOOST_OUTCOME_DISABLE_BOOST_SYSTEM)
+#define BOOST_OUTCOME_ENABLE_BOOST_SYSTEM
+#endif
+
 #ifndef BOOST_OUTCOME_AUTO_TEST_CASE
 #define BOOST_OUTCOME_AUTO_TEST_CASE(a, b) BOOST_AUTO_TEST_CASE(a)
 #endif
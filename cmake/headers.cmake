@@ -2,9 +2,27 @@
 set(outcome_HEADERS
   "include/outcome/result.h"
   "include/outcome.hpp"
+  "include/outcome/any_error.hpp"
+  "include/outcome/atomic_result.hpp"
+  "include/outcome/backtrace.hpp"
   "include/outcome/bad_access.hpp"
+  "include/outcome/bad_access_log.hpp"
+  "include/outcome/binary_serialisation.hpp"
+  "include/outcome/boxed_result.hpp"
+  "include/outcome/bulk.hpp"
+  "include/outcome/c_result.hpp"
+  "include/outcome/catch_to_result.hpp"
+  "include/outcome/category_registry.hpp"
+  "include/outcome/collect.hpp"
+  "include/outcome/common_instantiations.hpp"
+  "include/outcome/compact_error_code.hpp"
+  "include/outcome/compact_outcome.hpp"
   "include/outcome/config.hpp"
   "include/outcome/convert.hpp"
+  "include/outcome/copy_accounting.hpp"
+  "include/outcome/coroutine_support.hpp"
+  "include/outcome/cow_error.hpp"
+  "include/outcome/detail/monadic.hpp"
   "include/outcome/detail/outcome_exception_observers.hpp"
   "include/outcome/detail/outcome_exception_observers_impl.hpp"
   "include/outcome/detail/outcome_failure_observers.hpp"
@@ -13,10 +31,38 @@ set(outcome_HEADERS
   "include/outcome/detail/result_storage.hpp"
   "include/outcome/detail/result_value_observers.hpp"
   "include/outcome/detail/value_storage.hpp"
+  "include/outcome/device_result.hpp"
+  "include/outcome/error_chain.hpp"
+  "include/outcome/error_counters.hpp"
+  "include/outcome/error_equivalence.hpp"
+  "include/outcome/error_info_ring.hpp"
+  "include/outcome/error_site.hpp"
+  "include/outcome/errors.hpp"
+  "include/outcome/exception_box.hpp"
+  "include/outcome/executor.hpp"
+  "include/outcome/file_batch.hpp"
+  "include/outcome/flight_recorder.hpp"
+  "include/outcome/format.hpp"
+  "include/outcome/future.hpp"
+  "include/outcome/hash.hpp"
+  "include/outcome/hook_sampler.hpp"
+  "include/outcome/interned_message.hpp"
   "include/outcome/iostream_support.hpp"
+  "include/outcome/lazy_result.hpp"
+  "include/outcome/mapped_file.hpp"
+  "include/outcome/match.hpp"
+  "include/outcome/mmap_result_array.hpp"
+  "include/outcome/monadic.hpp"
+  "include/outcome/openmetrics.hpp"
   "include/outcome/outcome.hpp"
+  "include/outcome/parallel.hpp"
+  "include/outcome/payload_error.hpp"
+  "include/outcome/percpu_counters.hpp"
   "include/outcome/policy/all_narrow.hpp"
+  "include/outcome/policy/debug_checked.hpp"
   "include/outcome/policy/detail/common.hpp"
+  "include/outcome/policy/hooks.hpp"
+  "include/outcome/policy/log_and_default.hpp"
   "include/outcome/policy/outcome_error_code_throw_as_system_error.hpp"
   "include/outcome/policy/outcome_exception_ptr_rethrow.hpp"
   "include/outcome/policy/result_error_code_throw_as_system_error.hpp"
@@ -24,9 +70,23 @@ set(outcome_HEADERS
   "include/outcome/policy/terminate.hpp"
   "include/outcome/policy/throw_bad_result_access.hpp"
   "include/outcome/result.hpp"
+  "include/outcome/result_cache.hpp"
+  "include/outcome/result_lite.hpp"
+  "include/outcome/result_queue.hpp"
+  "include/outcome/result_vector.hpp"
+  "include/outcome/retry.hpp"
+  "include/outcome/runtime_hooks.hpp"
   "include/outcome/revision.hpp"
+  "include/outcome/simd_result.hpp"
+  "include/outcome/status_code.hpp"
+  "include/outcome/stop_token.hpp"
   "include/outcome/success_failure.hpp"
+  "include/outcome/text_parse.hpp"
+  "include/outcome/tracepoints.hpp"
   "include/outcome/try.hpp"
+  "include/outcome/try_counters.hpp"
+  "include/outcome/try_macros.hpp"
+  "include/outcome/try_timing.hpp"
   "include/outcome/utils.hpp"
   "include/outcome/version.hpp"
   "include/outcome/outcome.natvis"
@@ -2,14 +2,56 @@
 set(outcome_TESTS
   "test/expected-pass.cpp"
   "test/single-header-test.cpp"
+  "test/tests/allocator-aware.cpp"
+  "test/tests/any-error.cpp"
+  "test/tests/atomic-result.cpp"
+  "test/tests/backtrace.cpp"
+  "test/tests/binary-serialisation.cpp"
+  "test/tests/boost-system.cpp"
+  "test/tests/boxed-result.cpp"
+  "test/tests/bulk.cpp"
+  "test/tests/bytewise-comparison.cpp"
+  "test/tests/c-result-ec32.cpp"
+  "test/tests/c-results-to-errno.c"
+  "test/tests/catch-to-result.cpp"
+  "test/tests/category-registry.cpp"
+  "test/tests/collect.cpp"
+  "test/tests/compact-error-code.cpp"
+  "test/tests/compact-outcome.cpp"
+  "test/tests/compact-status.cpp"
   "test/tests/comparison.cpp"
   "test/tests/constexpr.cpp"
   "test/tests/containers.cpp"
+  "test/tests/copy-accounting.cpp"
   "test/tests/core-outcome.cpp"
   "test/tests/core-result.cpp"
+  "test/tests/coroutine-support.cpp"
+  "test/tests/cow-error.cpp"
+  "test/tests/debug-checked.cpp"
   "test/tests/default-construction.cpp"
+  "test/tests/device-result.cpp"
+  "test/tests/disjoint-storage.cpp"
+  "test/tests/emplace.cpp"
+  "test/tests/errno-detection.cpp"
+  "test/tests/error-chain.cpp"
+  "test/tests/error-counters.cpp"
+  "test/tests/error-equivalence.cpp"
+  "test/tests/error-from-exception.cpp"
+  "test/tests/error-info-ring.cpp"
+  "test/tests/error-site.cpp"
+  "test/tests/errors.cpp"
+  "test/tests/exception-box.cpp"
+  "test/tests/executor.cpp"
+  "test/tests/file-batch.cpp"
   "test/tests/fileopen.cpp"
+  "test/tests/flight-recorder.cpp"
+  "test/tests/format.cpp"
+  "test/tests/future.cpp"
+  "test/tests/hash.cpp"
+  "test/tests/hook-policy.cpp"
+  "test/tests/hook-sampler.cpp"
   "test/tests/hooks.cpp"
+  "test/tests/interned-message.cpp"
   "test/tests/issue0007.cpp"
   "test/tests/issue0009.cpp"
   "test/tests/issue0010.cpp"
@@ -21,13 +63,46 @@ set(outcome_TESTS
   "test/tests/issue0065.cpp"
   "test/tests/issue0071.cpp"
   "test/tests/issue0095.cpp"
+  "test/tests/lazy-failure.cpp"
+  "test/tests/lazy-result.cpp"
+  "test/tests/log-and-default.cpp"
+  "test/tests/mapped-file.cpp"
+  "test/tests/match.cpp"
+  "test/tests/mmap-result-array.cpp"
+  "test/tests/monadic.cpp"
+  "test/tests/move-bitcopying.cpp"
+  "test/tests/niche-storage.cpp"
   "test/tests/noexcept-propagation.cpp"
+  "test/tests/openmetrics.cpp"
+  "test/tests/parallel.cpp"
+  "test/tests/payload-error.cpp"
+  "test/tests/percpu-counters.cpp"
   "test/tests/propagate.cpp"
+  "test/tests/rebind-policy.cpp"
+  "test/tests/reference-value.cpp"
+  "test/tests/result-cache.cpp"
+  "test/tests/result-lite.cpp"
+  "test/tests/result-queue.cpp"
+  "test/tests/result-vector.cpp"
+  "test/tests/retry.cpp"
+  "test/tests/runtime-hooks.cpp"
   "test/tests/serialisation.cpp"
+  "test/tests/simd-result.cpp"
+  "test/tests/status-code.cpp"
+  "test/tests/stop-token.cpp"
   "test/tests/success-failure.cpp"
   "test/tests/swap.cpp"
+  "test/tests/text-parse.cpp"
+  "test/tests/tracepoints.cpp"
+  "test/tests/trivial-storage.cpp"
+  "test/tests/try-all.cpp"
+  "test/tests/try-counters.cpp"
+  "test/tests/try-timing.cpp"
   "test/tests/udts.cpp"
+  "test/tests/value-or.cpp"
   "test/tests/value-or-error.cpp"
+  "test/tests/void-storage.cpp"
+  "test/tests/zero-allocation.cpp"
 )
 # DO NOT EDIT, GENERATED BY SCRIPT
 set(outcome_COMPILE_TESTS
@@ -38,4 +113,5 @@ set(outcome_COMPILE_FAIL_TESTS
   "test/compile-fail/outcome-int-int-1.cpp"
   "test/compile-fail/result-int-int-1.cpp"
   "test/compile-fail/result-int-int-2.cpp"
+  "test/compile-fail/result-ref-temporary.cpp"
 )
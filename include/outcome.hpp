@@ -1,3 +1,50 @@
+#include "outcome/any_error.hpp"
+#include "outcome/backtrace.hpp"
+#include "outcome/bad_access_log.hpp"
+#include "outcome/boxed_result.hpp"
+#include "outcome/bulk.hpp"
+#include "outcome/c_result.hpp"
+#include "outcome/catch_to_result.hpp"
+#include "outcome/category_registry.hpp"
+#include "outcome/collect.hpp"
+#include "outcome/compact_error_code.hpp"
+#include "outcome/compact_outcome.hpp"
+#include "outcome/copy_accounting.hpp"
+#include "outcome/coroutine_support.hpp"
+#include "outcome/cow_error.hpp"
+#include "outcome/device_result.hpp"
+#include "outcome/error_chain.hpp"
+#include "outcome/error_counters.hpp"
+#include "outcome/error_equivalence.hpp"
+#include "outcome/error_info_ring.hpp"
+#include "outcome/error_site.hpp"
+#include "outcome/errors.hpp"
+#include "outcome/exception_box.hpp"
+#include "outcome/file_batch.hpp"
+#include "outcome/flight_recorder.hpp"
+#include "outcome/format.hpp"
+#include "outcome/hash.hpp"
+#include "outcome/hook_sampler.hpp"
+#include "outcome/interned_message.hpp"
 #include "outcome/iostream_support.hpp"
+#include "outcome/lazy_result.hpp"
+#include "outcome/mapped_file.hpp"
+#include "outcome/match.hpp"
+#include "outcome/mmap_result_array.hpp"
+#include "outcome/monadic.hpp"
+#include "outcome/openmetrics.hpp"
+#include "outcome/parallel.hpp"
+#include "outcome/payload_error.hpp"
+#include "outcome/percpu_counters.hpp"
+#include "outcome/result_cache.hpp"
+#include "outcome/result_vector.hpp"
+#include "outcome/retry.hpp"
+#include "outcome/runtime_hooks.hpp"
+#include "outcome/simd_result.hpp"
+#include "outcome/status_code.hpp"
+#include "outcome/text_parse.hpp"
+#include "outcome/tracepoints.hpp"
 #include "outcome/try.hpp"
+#include "outcome/try_counters.hpp"
+#include "outcome/try_timing.hpp"
 #include "outcome/utils.hpp"
@@ -0,0 +1,301 @@
+/* A type erased error with inline storage for small errors
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_ANY_ERROR_HPP
+#define OUTCOME_ANY_ERROR_HPP
+
+#include "outcome.hpp"
+
+#include <cstddef>
+#include <exception>
+#include <new>
+#include <string>
+#include <system_error>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  //! The largest error kept in an `any_error` itself, rather than allocated separately.
+  static constexpr size_t any_error_inline_size = 48;
+
+  // What an any_error needs to know about the type of error it holds
+  struct any_error_ops
+  {
+    const void *type;
+    void (*move)(void *to, void *from) noexcept;  // also destroys from
+    void (*copy)(void *to, const void *from);     // null if not copy constructible
+    void (*destroy)(void *p) noexcept;
+    const void *(*get)(const void *p) noexcept;
+    std::string (*message)(const void *p);
+    std::error_code (*to_error_code)(const void *p) noexcept;
+    std::exception_ptr (*to_exception_ptr)(const void *p) noexcept;
+    void (*rethrow)(const void *p);
+  };
+  // The address of its id identifies a type without RTTI
+  template <class E> struct any_error_type
+  {
+    static constexpr char id = 0;
+  };
+  template <class E> constexpr char any_error_type<E>::id;
+
+  template <class E, class = void> struct any_error_has_message : std::false_type
+  {
+  };
+  template <class E> struct any_error_has_message<E, std::enable_if_t<std::is_convertible<decltype(std::declval<const E &>().message()), std::string>::value>> : std::true_type
+  {
+  };
+
+  // An error's code is what make_error_code() returns for it, else the code of a std::system_error
+  template <class E> inline std::error_code any_error_code(const E &e, std::integral_constant<int, 2> /*unused*/) noexcept { return policy::error_code(e); }
+  template <class E> inline std::error_code any_error_code(const E &e, std::integral_constant<int, 1> /*unused*/) noexcept { return e.code(); }
+  template <class E> inline std::error_code any_error_code(const E & /*unused*/, std::integral_constant<int, 0> /*unused*/) noexcept { return std::make_error_code(std::errc::resource_unavailable_try_again); }
+  template <class E> using any_error_code_kind = std::integral_constant<int, trait::has_error_code_v<E> ? 2 : (std::is_base_of<std::system_error, E>::value ? 1 : 0)>;
+
+  // An error's message is its message(), else the what() of an exception, else the message of its code
+  template <class E> inline std::string any_error_message(const E &e, std::integral_constant<int, 2> /*unused*/) { return e.message(); }
+  template <class E> inline std::string any_error_message(const E &e, std::integral_constant<int, 1> /*unused*/) { return e.what(); }
+  template <class E> inline std::string any_error_message(const E &e, std::integral_constant<int, 0> /*unused*/) { return any_error_code(e, any_error_code_kind<E>()).message(); }
+  template <class E> using any_error_message_kind = std::integral_constant<int, any_error_has_message<E>::value ? 2 : (std::is_base_of<std::exception, E>::value ? 1 : 0)>;
+
+  // An exception is thrown as itself, anything else as a std::system_error of its code and message
+  template <class E> QUICKCPPLIB_NORETURN inline void any_error_rethrow(const E &e, std::true_type /*unused*/) { OUTCOME_THROW_EXCEPTION(e); }
+  template <class E> QUICKCPPLIB_NORETURN inline void any_error_rethrow(const E &e, std::false_type /*unused*/) { OUTCOME_THROW_EXCEPTION(std::system_error(any_error_code(e, any_error_code_kind<E>()), any_error_message(e, any_error_message_kind<E>()))); }
+  template <class E> inline std::exception_ptr any_error_exception_ptr(const E &e, std::true_type /*unused*/) noexcept { return std::make_exception_ptr(e); }
+  template <class E> inline std::exception_ptr any_error_exception_ptr(const E &e, std::false_type /*unused*/) noexcept
+  {
+#ifdef __cpp_exceptions
+    try
+    {
+      return std::make_exception_ptr(std::system_error(any_error_code(e, any_error_code_kind<E>()), any_error_message(e, any_error_message_kind<E>())));
+    }
+    catch(...)
+    {
+      return std::current_exception();
+    }
+#else
+    return std::make_exception_ptr(std::system_error(any_error_code(e, any_error_code_kind<E>())));
+#endif
+  }
+
+  // The operations on an E kept inline, or on a pointer to an E kept inline if not
+  template <class E, bool Inline> struct any_error_ops_for;
+  template <class E> struct any_error_ops_for<E, true>
+  {
+    static const E &ref(const void *p) noexcept { return *static_cast<const E *>(p); }
+    static void move(void *to, void *from) noexcept
+    {
+      new(to) E(std::move(*static_cast<E *>(from)));
+      static_cast<E *>(from)->~E();
+    }
+    static void copy(void *to, const void *from) { new(to) E(ref(from)); }
+    static void destroy(void *p) noexcept { static_cast<E *>(p)->~E(); }
+  };
+  template <class E> struct any_error_ops_for<E, false>
+  {
+    static const E &ref(const void *p) noexcept { return **static_cast<E *const *>(p); }
+    static void move(void *to, void *from) noexcept { new(to) E *(*static_cast<E **>(from)); }
+    static void copy(void *to, const void *from) { new(to) E *(new E(ref(from))); }
+    static void destroy(void *p) noexcept { delete *static_cast<E **>(p); }
+  };
+  template <class E, bool Inline> struct any_error_vtable : any_error_ops_for<E, Inline>
+  {
+    using base = any_error_ops_for<E, Inline>;
+    static const void *get(const void *p) noexcept { return &base::ref(p); }
+    static std::string message(const void *p) { return any_error_message(base::ref(p), any_error_message_kind<E>()); }
+    static std::error_code to_error_code(const void *p) noexcept { return any_error_code(base::ref(p), any_error_code_kind<E>()); }
+    static std::exception_ptr to_exception_ptr(const void *p) noexcept { return any_error_exception_ptr(base::ref(p), std::is_base_of<std::exception, E>()); }
+    QUICKCPPLIB_NORETURN static void rethrow(const void *p) { any_error_rethrow(base::ref(p), std::is_base_of<std::exception, E>()); }
+    using copy_type = void (*)(void *, const void *);
+    static constexpr copy_type copy_if(std::true_type /*unused*/) { return &base::copy; }
+    static constexpr copy_type copy_if(std::false_type /*unused*/) { return nullptr; }
+    static const any_error_ops *ops() noexcept
+    {
+      static constexpr any_error_ops v{&any_error_type<E>::id, base::move, copy_if(std::is_copy_constructible<E>()), base::destroy, get, message, to_error_code, to_exception_ptr, rethrow};
+      return &v;
+    }
+  };
+}  // namespace detail
+
+/*! A move only holder of an error of any type, for rich errors as the error type `S` of `result<T, S>`
+or as the exception type `P` of `outcome<R, S, P>`, in place of a `std::exception_ptr` with its
+allocation and atomic reference count.
+
+Errors up to `detail::any_error_inline_size` bytes which can be moved without throwing are kept in
+the `any_error` itself, which is 64 bytes, so holding one never allocates. Larger errors are
+allocated separately. A table of functions for its type moves, copies, destroys, describes and
+throws the error held:
+
+- `message()` is the error's `message()` if it has one, else the `what()` of an exception, else
+the message of its code.
+- `to_error_code()` is what an ADL discovered `make_error_code()` returns for it, else the `code()`
+of a `std::system_error`, else `errc::resource_unavailable_try_again`.
+- `rethrow()` throws an exception as itself, and anything else as a `std::system_error` of its
+code and message.
+
+Both `trait::has_error_code_v` and `trait::has_exception_ptr_v` are true for it, and the default
+policies of `result` and `outcome` throw it with `rethrow()`.
+*/
+class any_error
+{
+  alignas(std::max_align_t) unsigned char _storage[detail::any_error_inline_size];
+  const detail::any_error_ops *_ops{nullptr};
+
+  template <class E> struct _inline
+  {
+    static constexpr bool value = sizeof(E) <= detail::any_error_inline_size && std::is_nothrow_move_constructible<E>::value;
+  };
+  template <class E, class... Args> void _construct(std::true_type /*unused*/, Args &&... args) { new(_storage) E(std::forward<Args>(args)...); }
+  template <class E, class... Args> void _construct(std::false_type /*unused*/, Args &&... args) { new(_storage) E *(new E(std::forward<Args>(args)...)); }
+  void _release() noexcept
+  {
+    if(_ops != nullptr)
+    {
+      _ops->destroy(_storage);
+      _ops = nullptr;
+    }
+  }
+
+public:
+  //! Default constructs an empty `any_error`.
+  constexpr any_error() noexcept
+      : _storage{}
+  {
+  }
+  //! Holds the error `e`.
+  OUTCOME_TEMPLATE(class E)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(!std::is_same<std::decay_t<E>, any_error>::value && !detail::is_in_place_type_t<std::decay_t<E>>::value))
+  explicit any_error(E &&e)
+      : any_error(make<std::decay_t<E>>(std::forward<E>(e)))
+  {
+  }
+  any_error(const any_error &) = delete;
+  //! Move constructor.
+  any_error(any_error &&o) noexcept
+      : _ops(o._ops)
+  {
+    if(_ops != nullptr)
+    {
+      _ops->move(_storage, o._storage);
+      o._ops = nullptr;
+    }
+  }
+  any_error &operator=(const any_error &) = delete;
+  //! Move assignment.
+  any_error &operator=(any_error &&o) noexcept
+  {
+    if(this != &o)
+    {
+      _release();
+      if(o._ops != nullptr)
+      {
+        o._ops->move(_storage, o._storage);
+        _ops = o._ops;
+        o._ops = nullptr;
+      }
+    }
+    return *this;
+  }
+  ~any_error() { _release(); }
+
+  //! Holds an error of type `E` constructed from `args`.
+  template <class E, class... Args> static any_error make(Args &&... args)
+  {
+    static_assert(alignof(E) <= alignof(std::max_align_t), "Over aligned errors cannot be held");
+    static_assert(!std::is_reference<E>::value && !std::is_const<E>::value, "any_error holds errors by value");
+    using inline_ = std::integral_constant<bool, _inline<E>::value>;
+    any_error ret;
+    ret._construct<E>(inline_(), std::forward<Args>(args)...);
+    ret._ops = detail::any_error_vtable<E, inline_::value>::ops();
+    return ret;
+  }
+  /*! A copy of the error held, which must be of a copy constructible type if an error is held,
+  else `std::terminate()` is called.
+  */
+  any_error clone() const
+  {
+    any_error ret;
+    if(_ops != nullptr)
+    {
+      if(_ops->copy == nullptr)
+      {
+        std::terminate();
+      }
+      _ops->copy(ret._storage, _storage);
+      ret._ops = _ops;
+    }
+    return ret;
+  }
+
+  //! True if an error is held.
+  explicit operator bool() const noexcept { return _ops != nullptr; }
+  //! True if an error is held and its type is `E`.
+  template <class E> bool holds() const noexcept { return _ops != nullptr && _ops->type == &detail::any_error_type<E>::id; }
+  //! The error held if its type is `E`, else null.
+  template <class E> const E *get_if() const noexcept { return holds<E>() ? static_cast<const E *>(_ops->get(_storage)) : nullptr; }
+  //! True if the error held is kept inline, or if none is held.
+  bool is_inline() const noexcept { return _ops == nullptr || _ops->get(_storage) == static_cast<const void *>(_storage); }
+  //! The message of the error held, or empty if none is held.
+  std::string message() const { return (_ops != nullptr) ? _ops->message(_storage) : std::string(); }
+  //! The code of the error held, or a default constructed code if none is held.
+  std::error_code to_error_code() const noexcept { return (_ops != nullptr) ? _ops->to_error_code(_storage) : std::error_code(); }
+  //! A `std::exception_ptr` to what `rethrow()` would throw, or null if none is held. Allocates.
+  std::exception_ptr to_exception_ptr() const noexcept { return (_ops != nullptr) ? _ops->to_exception_ptr(_storage) : std::exception_ptr(); }
+  /*! Throws the error held as itself if an exception, else as a `std::system_error` of its code and message.
+  \requires An error to be held, else `std::terminate()` is called.
+  */
+  QUICKCPPLIB_NORETURN void rethrow() const
+  {
+    if(_ops == nullptr)
+    {
+      std::terminate();
+    }
+    _ops->rethrow(_storage);
+    std::terminate();  // unreachable
+  }
+  //! Swaps with another `any_error`.
+  void swap(any_error &o) noexcept
+  {
+    any_error temp(std::move(o));
+    o = std::move(*this);
+    *this = std::move(temp);
+  }
+
+  //! Found by ADL for `policy::error_code()` and `trait::has_error_code_v`.
+  friend inline std::error_code make_error_code(const any_error &v) noexcept { return v.to_error_code(); }
+  //! Found by ADL for `policy::exception_ptr()` and `trait::has_exception_ptr_v`.
+  friend inline std::exception_ptr make_exception_ptr(const any_error &v) noexcept { return v.to_exception_ptr(); }
+  //! Throws the error held with `rethrow()`, for `result`'s default policy.
+  friend inline void throw_as_system_error_with_payload(const any_error &v) { v.rethrow(); }
+};
+
+//! Holds an error of type `E` constructed from `args`.
+template <class E, class... Args> inline any_error make_any_error(Args &&... args)
+{
+  return any_error::make<E>(std::forward<Args>(args)...);
+}
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,162 @@
+/* A single assignment cell publishing a result from one thread to many
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_ATOMIC_RESULT_HPP
+#define OUTCOME_ATOMIC_RESULT_HPP
+
+#include "result.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+/*! A cell into which one thread publishes a `result<T, E>` exactly once, and from which any number
+of threads read it, without a lock or a shared state allocation.
+
+A single atomic state word is both the ready flag and a copy of whether the result is valued.
+Publication constructs the result in place inside the cell, then makes it visible with one release
+store. Readers test the word with one acquire load, and `wait()` spins briefly before blocking on
+the word, which is a futex wait on C++ 20 and a yielding loop before.
+
+Once published, the result is immutable until the cell is destroyed, so readers may hold references
+into it for the lifetime of the cell.
+*/
+template <class T, class E = std::error_code> class atomic_result
+{
+public:
+  //! The type of result published.
+  using result_type = result<T, E>;
+  //! The value type of the result.
+  using value_type = typename result_type::value_type;
+  //! The error type of the result.
+  using error_type = typename result_type::error_type;
+
+private:
+  static constexpr uint32_t _state_empty = 0;
+  static constexpr uint32_t _state_constructing = 1U << 0U;
+  static constexpr uint32_t _state_ready = 1U << 1U;
+  static constexpr uint32_t _state_have_value = 1U << 2U;
+  // How many times wait() polls the state before blocking on it
+  static constexpr unsigned _spin_count = 64;
+
+  std::atomic<uint32_t> _state{_state_empty};
+  union {
+    detail::empty_type _empty;
+    result_type _value;
+  };
+
+public:
+  //! Constructs an empty cell.
+  atomic_result() noexcept
+      : _empty{}
+  {
+  }
+  atomic_result(const atomic_result &) = delete;
+  atomic_result(atomic_result &&) = delete;
+  atomic_result &operator=(const atomic_result &) = delete;
+  atomic_result &operator=(atomic_result &&) = delete;
+  //! Destroys any published result. No thread may be reading or waiting on the cell.
+  ~atomic_result()
+  {
+    if((_state.load(std::memory_order_acquire) & _state_ready) != 0)
+    {
+      _value.~result_type();
+    }
+  }
+
+  /*! Constructs the result in place from `args`, then publishes it to all readers.
+  \returns False, without constructing anything, if a result was already or is being published.
+  \throws Any exception the construction of the result throws, in which case the cell stays empty
+  and publication may be tried again.
+  */
+  template <class... Args> bool emplace(Args &&... args) noexcept(std::is_nothrow_constructible<result_type, Args...>::value)
+  {
+    uint32_t expected = _state_empty;
+    if(!_state.compare_exchange_strong(expected, _state_constructing, std::memory_order_relaxed, std::memory_order_relaxed))
+    {
+      return false;
+    }
+    // If construction throws, the cell is left empty for another publication
+    struct guard_t
+    {
+      std::atomic<uint32_t> &state;
+      bool armed;
+      ~guard_t()
+      {
+        if(armed)
+        {
+          state.store(_state_empty, std::memory_order_relaxed);
+        }
+      }
+    } g{_state, true};
+    new(&_value) result_type(std::forward<Args>(args)...);  // NOLINT
+    g.armed = false;
+    _state.store(_state_ready | (_value.has_value() ? _state_have_value : 0U), std::memory_order_release);
+#if defined(__cpp_lib_atomic_wait) && __cpp_lib_atomic_wait >= 201907L
+    _state.notify_all();
+#endif
+    return true;
+  }
+  /*! Publishes `r` to all readers.
+  \returns False, leaving `r` untouched, if a result was already or is being published.
+  */
+  bool publish(result_type &&r) noexcept(std::is_nothrow_move_constructible<result_type>::value) { return emplace(static_cast<result_type &&>(r)); }
+  //! \group publish
+  bool publish(const result_type &r) noexcept(std::is_nothrow_copy_constructible<result_type>::value) { return emplace(r); }
+
+  //! True if a result has been published.
+  bool is_ready() const noexcept { return (_state.load(std::memory_order_acquire) & _state_ready) != 0; }
+  //! True if a result has been published, and it is valued.
+  bool has_value() const noexcept { return (_state.load(std::memory_order_acquire) & _state_have_value) != 0; }
+  //! Returns the published result, or null if none has been published yet.
+  const result_type *try_get() const noexcept { return is_ready() ? &_value : nullptr; }
+
+  //! Blocks until a result has been published, then returns it.
+  const result_type &wait() const noexcept
+  {
+    for(unsigned n = 0;; n++)
+    {
+      const uint32_t state = _state.load(std::memory_order_acquire);
+      if((state & _state_ready) != 0)
+      {
+        return _value;
+      }
+      if(n < _spin_count)
+      {
+        continue;
+      }
+#if defined(__cpp_lib_atomic_wait) && __cpp_lib_atomic_wait >= 201907L
+      _state.wait(state, std::memory_order_acquire);
+#else
+      std::this_thread::yield();
+#endif
+    }
+  }
+};
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,228 @@
+/* Cheap capture of stack backtraces for extended error information
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_BACKTRACE_HPP
+#define OUTCOME_BACKTRACE_HPP
+
+#include "error_info_ring.hpp"
+
+#include <cstdlib>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__GNUC__) && !defined(_WIN32)
+#include <unwind.h>
+#define OUTCOME_HAVE_BACKTRACE 1
+#define OUTCOME_BACKTRACE_NOINLINE __attribute__((noinline))
+#if defined(__has_include)
+#if __has_include(<execinfo.h>)
+#include <execinfo.h>
+#define OUTCOME_HAVE_BACKTRACE_SYMBOLS 1
+#endif
+#endif
+#else
+#define OUTCOME_BACKTRACE_NOINLINE
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  struct backtrace_walk
+  {
+    void **frames;
+    size_t items, max, skip;
+  };
+#ifdef OUTCOME_HAVE_BACKTRACE
+  inline _Unwind_Reason_Code backtrace_frame(struct _Unwind_Context *ctx, void *arg) noexcept
+  {
+    auto *walk = static_cast<backtrace_walk *>(arg);
+    const auto ip = _Unwind_GetIP(ctx);
+    if(ip == 0 || walk->items == walk->max)
+    {
+      return _URC_END_OF_STACK;
+    }
+    if(walk->skip > 0)
+    {
+      --walk->skip;
+    }
+    else
+    {
+      walk->frames[walk->items++] = reinterpret_cast<void *>(ip);  // NOLINT
+    }
+    return _URC_NO_REASON;
+  }
+#endif
+}  // namespace detail
+
+/*! The raw return addresses of up to `Depth` stack frames. Capturing only walks the stack, which costs
+far less than turning the addresses into names, and so symbolisation is left until the backtrace is
+printed by `symbols()` or `operator<<`.
+
+Capture is available on GCC and clang for targets other than Windows, where `OUTCOME_HAVE_BACKTRACE` is
+defined. Elsewhere captured backtraces are empty. Symbolisation uses `backtrace_symbols()` where the C
+library has it, elsewhere the addresses are printed in hexadecimal. Names of functions not exported
+from their binary generally need linking with `-rdynamic` to appear.
+*/
+template <size_t Depth = 16> class basic_stack_backtrace
+{
+  static_assert(Depth > 0 && Depth <= 256, "Depth must be between 1 and 256");
+
+  void *_frames[Depth];
+  uint16_t _items{0};
+
+public:
+  //! The maximum number of frames kept.
+  static constexpr size_t depth = Depth;
+  //! The const iterator type.
+  using const_iterator = void *const *;
+
+  //! Default constructs an empty backtrace.
+  basic_stack_backtrace() noexcept {}  // NOLINT
+
+  /*! Replaces the frames with those of the calling thread, starting from the caller of `capture()`.
+  \param skip The number of further frames to leave out, such as those of a hook.
+  */
+  OUTCOME_BACKTRACE_NOINLINE void capture(size_t skip = 0) noexcept
+  {
+    _items = 0;
+#ifdef OUTCOME_HAVE_BACKTRACE
+    // The first frame is that of capture() itself
+    detail::backtrace_walk walk{_frames, 0, Depth, skip + 1};
+    _Unwind_Backtrace(detail::backtrace_frame, &walk);
+    _items = static_cast<uint16_t>(walk.items);
+#else
+    (void) skip;
+#endif
+  }
+  //! Removes all frames.
+  void clear() noexcept { _items = 0; }
+
+  //! The number of frames.
+  size_t size() const noexcept { return _items; }
+  //! True if there are no frames.
+  bool empty() const noexcept { return _items == 0; }
+  //! The return address of frame `idx`, zero being the innermost.
+  void *operator[](size_t idx) const noexcept { return _frames[idx]; }
+  //! \group begin
+  const_iterator begin() const noexcept { return _frames; }
+  //! \group end
+  const_iterator end() const noexcept { return _frames + _items; }
+
+  //! Symbolises each frame, innermost first. This is the expensive part, and allocates memory.
+  std::vector<std::string> symbols() const
+  {
+    std::vector<std::string> ret;
+    ret.reserve(_items);
+#ifdef OUTCOME_HAVE_BACKTRACE_SYMBOLS
+    std::unique_ptr<char *, void (*)(void *)> names(::backtrace_symbols(_frames, static_cast<int>(_items)), ::free);
+    if(names)
+    {
+      for(size_t n = 0; n < _items; n++)
+      {
+        ret.emplace_back(names.get()[n]);
+      }
+      return ret;
+    }
+#endif
+    for(size_t n = 0; n < _items; n++)
+    {
+      std::ostringstream s;
+      s << _frames[n];
+      ret.push_back(s.str());
+    }
+    return ret;
+  }
+
+  //! Writes the symbolised frames as `[frame; frame; ...]`.
+  friend std::ostream &operator<<(std::ostream &s, const basic_stack_backtrace &v)
+  {
+    s << "[";
+    bool first = true;
+    for(const std::string &frame : v.symbols())
+    {
+      if(!first)
+      {
+        s << "; ";
+      }
+      s << frame;
+      first = false;
+    }
+    return s << "]";
+  }
+};
+//! A backtrace of up to sixteen frames.
+using stack_backtrace = basic_stack_backtrace<>;
+//! The per thread ring of backtraces used by `capture_backtrace()`.
+using backtrace_ring = error_info_ring<stack_backtrace>;
+
+/*! Captures a backtrace of the current thread into a slot of `backtrace_ring`, and records the slot
+in the spare storage of `r`. Meant to be called from a `hook_result_construction()` overload when
+`r` is errored:
+
+```c++
+template <class T, class U> inline void hook_result_construction(result<T> *res, U &&) noexcept
+{
+  if(res->has_error())
+  {
+    OUTCOME_V2_NAMESPACE::capture_backtrace(res);
+  }
+}
+```
+\param skip The number of frames to leave out beyond the caller. Frames which were inlined are not counted.
+*/
+template <class R, class S, class P> OUTCOME_BACKTRACE_NOINLINE void capture_backtrace(detail::result_final<R, S, P> *r, size_t skip = 0) noexcept
+{
+  backtrace_ring::capture(r).capture(skip + 1);
+}
+//! The backtrace captured for `r` on the calling thread by `capture_backtrace()`, or null if none or stale.
+template <class R, class S, class P> inline const stack_backtrace *find_backtrace(const detail::result_final<R, S, P> &r) noexcept
+{
+  return backtrace_ring::lookup(r);
+}
+/*! Writes `" "` followed by the symbolised backtrace captured for `r`, if it has one. Meant to be
+called from a `hook_result_print()` overload, so that `print()` shows where an error came from:
+
+```c++
+template <class T, class P> inline void hook_result_print(std::ostream &s, const OUTCOME_V2_NAMESPACE::detail::result_final<T, error_code, P> *res)
+{
+  OUTCOME_V2_NAMESPACE::print_backtrace(s, *res);
+}
+```
+*/
+template <class R, class S, class P> inline void print_backtrace(std::ostream &s, const detail::result_final<R, S, P> &r)
+{
+  if(const stack_backtrace *bt = find_backtrace(r))
+  {
+    s << " " << *bt;
+  }
+}
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,281 @@
+/* A lock free log of wide accesses to absent state
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_BAD_ACCESS_LOG_HPP
+#define OUTCOME_BAD_ACCESS_LOG_HPP
+
+#include "config.hpp"
+#include "interned_message.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <system_error>
+#include <thread>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+//! A wide access to absent state, as pushed to a `bad_access_log`.
+struct bad_access_record
+{
+  //! Which state was wanted, e.g. "no value".
+  const char *what{nullptr};
+  //! A compiler specific signature naming the type accessed.
+  const char *type{nullptr};
+  //! The category of the error held, or null if none or if not a `std::error_code`.
+  const std::error_category *category{nullptr};
+  //! The value of the error held, if `category` is not null.
+  int code{0};
+  //! When, in nanoseconds since the system clock's epoch.
+  uint64_t timestamp{0};
+};
+
+/*! A bounded lock free queue of `bad_access_record`, which any number of threads push to and which
+is drained by one thread at a time, usually a `bad_access_drainer`.
+
+Pushing never allocates, locks nor waits. If the queue is full the record is dropped and counted
+instead, so a storm of faults costs each faulting thread no more than a few atomic operations.
+The log is constant initialised, so it may be pushed to from any point in the program's lifetime.
+*/
+class bad_access_log
+{
+public:
+  //! The most records held before pushes are dropped.
+  static constexpr size_t slots = 1024;
+
+private:
+  /* Each slot's sequence is relative to its lap, so that all-zeros is the initial state: it is
+  zero less the lap's start when awaiting a push, one more when full, and `slots` more when
+  awaiting the next lap's push.
+  */
+  struct _slot
+  {
+    std::atomic<size_t> sequence{0};
+    bad_access_record record{};
+  };
+  alignas(64) std::atomic<size_t> _head{0};
+  alignas(64) std::atomic<size_t> _tail{0};
+  std::atomic<uint64_t> _dropped{0};
+  _slot _slots[slots];
+
+public:
+  //! Constructs an empty log.
+  constexpr bad_access_log() noexcept = default;
+  bad_access_log(const bad_access_log &) = delete;
+  bad_access_log &operator=(const bad_access_log &) = delete;
+
+  //! The log which `policy::log_and_default` pushes to.
+  static inline bad_access_log &global() noexcept;
+
+  /*! Pushes a record.
+  \returns False if the log was full, in which case the record was dropped and counted.
+  */
+  bool push(const bad_access_record &r) noexcept
+  {
+    size_t pos = _head.load(std::memory_order_relaxed);
+    for(;;)
+    {
+      _slot &s = _slots[pos % slots];
+      const size_t lap = pos - pos % slots;
+      const auto diff = static_cast<ptrdiff_t>(s.sequence.load(std::memory_order_acquire) - lap);
+      if(diff == 0)
+      {
+        if(_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        {
+          s.record = r;
+          s.sequence.store(lap + 1, std::memory_order_release);
+          return true;
+        }
+      }
+      else if(diff < 0)
+      {
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+      else
+      {
+        pos = _head.load(std::memory_order_relaxed);
+      }
+    }
+  }
+  /*! Pops the oldest record into `r`.
+  \returns False if the log was empty.
+  */
+  bool pop(bad_access_record &r) noexcept
+  {
+    size_t pos = _tail.load(std::memory_order_relaxed);
+    for(;;)
+    {
+      _slot &s = _slots[pos % slots];
+      const size_t lap = pos - pos % slots;
+      const auto diff = static_cast<ptrdiff_t>(s.sequence.load(std::memory_order_acquire) - (lap + 1));
+      if(diff == 0)
+      {
+        if(_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        {
+          r = s.record;
+          s.sequence.store(lap + slots, std::memory_order_release);
+          return true;
+        }
+      }
+      else if(diff < 0)
+      {
+        return false;
+      }
+      else
+      {
+        pos = _tail.load(std::memory_order_relaxed);
+      }
+    }
+  }
+  //! Calls `f(const bad_access_record &)` for each record popped until the log is empty, returning how many.
+  template <class F> std::enable_if_t<!std::is_base_of<std::ostream, std::decay_t<F>>::value, size_t> drain(F &&f)
+  {
+    size_t count = 0;
+    bad_access_record r;
+    while(pop(r))
+    {
+      f(static_cast<const bad_access_record &>(r));
+      ++count;
+    }
+    return count;
+  }
+  //! Writes each record popped to `out` as one line, until the log is empty, returning how many.
+  size_t drain(std::ostream &out)
+  {
+    return drain([&out](const bad_access_record &r) { write(out, r); });
+  }
+  //! The number of records dropped because the log was full.
+  uint64_t dropped() const noexcept { return _dropped.load(std::memory_order_relaxed); }
+
+  //! Writes `r` to `out` as one line.
+  static void write(std::ostream &out, const bad_access_record &r)
+  {
+    out << "outcome: bad access, " << ((r.what != nullptr) ? r.what : "?") << " in " << ((r.type != nullptr) ? r.type : "?");
+    if(r.category != nullptr)
+    {
+      out << " holding " << r.category->name() << ':' << r.code << " (" << interned_message(*r.category, r.code) << ")";
+    }
+    out << " at " << r.timestamp << "\n";
+  }
+};
+
+namespace detail
+{
+  // A template's static member, so the global log is constant initialised without a guard
+  template <class T = void> struct bad_access_log_instance
+  {
+    static bad_access_log value;
+  };
+  template <class T> bad_access_log bad_access_log_instance<T>::value;
+
+  template <class T> inline const char *bad_access_type_name() noexcept
+  {
+#ifdef _MSC_VER
+    return __FUNCSIG__;
+#else
+    return __PRETTY_FUNCTION__;
+#endif
+  }
+  template <class E> inline void bad_access_record_error(bad_access_record & /*unused*/, const E & /*unused*/) noexcept {}
+  inline void bad_access_record_error(bad_access_record &r, const std::error_code &ec) noexcept
+  {
+    r.category = &ec.category();
+    r.code = ec.value();
+  }
+  template <class T> inline bad_access_record make_bad_access_record(const char *what) noexcept
+  {
+    bad_access_record r;
+    r.what = what;
+    r.type = bad_access_type_name<T>();
+    r.timestamp = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+    return r;
+  }
+}  // namespace detail
+
+inline bad_access_log &bad_access_log::global() noexcept
+{
+  return detail::bad_access_log_instance<>::value;
+}
+
+/*! Drains a `bad_access_log` from a background thread every `interval` until destroyed, when it
+drains whatever remains. Formatting happens here, so that it costs the faulting threads nothing.
+*/
+class bad_access_drainer
+{
+  bad_access_log &_log;
+  std::function<void(const bad_access_record &)> _sink;
+  std::chrono::milliseconds _interval;
+  std::mutex _lock;
+  std::condition_variable _changed;
+  bool _stop{false};
+  std::thread _thread;
+
+  void _run()
+  {
+    std::unique_lock<std::mutex> g(_lock);
+    while(!_stop)
+    {
+      _changed.wait_for(g, _interval);
+      g.unlock();
+      _log.drain(_sink);
+      g.lock();
+    }
+  }
+
+public:
+  //! Calls `sink` on the background thread for each record drained from `log`.
+  explicit bad_access_drainer(std::function<void(const bad_access_record &)> sink, std::chrono::milliseconds interval = std::chrono::milliseconds(100), bad_access_log &log = bad_access_log::global())
+      : _log(log)
+      , _sink(std::move(sink))
+      , _interval(interval)
+      , _thread([this] { _run(); })
+  {
+  }
+  //! Writes each record drained from `log` to `out` on the background thread.
+  explicit bad_access_drainer(std::ostream &out, std::chrono::milliseconds interval = std::chrono::milliseconds(100), bad_access_log &log = bad_access_log::global())
+      : bad_access_drainer([&out](const bad_access_record &r) { bad_access_log::write(out, r); }, interval, log)
+  {
+  }
+  bad_access_drainer(const bad_access_drainer &) = delete;
+  bad_access_drainer &operator=(const bad_access_drainer &) = delete;
+  //! Stops the background thread and drains whatever remains.
+  ~bad_access_drainer()
+  {
+    {
+      std::lock_guard<std::mutex> g(_lock);
+      _stop = true;
+    }
+    _changed.notify_all();
+    _thread.join();
+    _log.drain(_sink);
+  }
+};
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
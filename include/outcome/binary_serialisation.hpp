@@ -0,0 +1,817 @@
+/* A compact binary serialisation of result and outcome
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_BINARY_SERIALISATION_HPP
+#define OUTCOME_BINARY_SERIALISATION_HPP
+
+#include "category_registry.hpp"
+#include "outcome.hpp"
+#include "result_vector.hpp"
+#include "utils.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <new>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#if defined(__has_include)
+#if __has_include(<version>)
+#include <version>
+#endif
+#endif
+#ifdef __cpp_lib_bit_cast
+#include <array>
+#include <bit>
+#endif
+#ifdef __cpp_lib_span
+#include <cstddef>
+#include <span>
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+/*! Namespace for the compact binary serialisation of `result` and `outcome`.
+
+The format of each is a status byte, then if its top bit is set the sixteen bits of spare storage,
+then the value, the error and the exception present, each written by their `codec`:
+
+| Byte(s) | Meaning |
+| ------- | ------- |
+| 1 | `status_value` `|` `status_error` `|` `status_exception` `|` `status_spare` |
+| 2, if `status_spare` | The spare storage, little endian |
+| ... | The value, the error and the exception present, in that order |
+
+Integers in the framing, and in the codecs for `std::error_code` and `std::string`, are little
+endian. A `std::error_code` is its value as four bytes and the `category_id()` of its category as
+four bytes, so that categories survive between processes. Other trivially copyable types are
+written as their bytes in the host representation, so reader and writer must share an ABI unless
+a `codec` is specialised for the type.
+
+Sinks have a member function `write(const unsigned char *data, size_t bytes)`, and sources a member
+function `bool read(unsigned char *data, size_t bytes)` which returns false if there are not enough
+bytes. These are template parameters throughout, so there are no virtual calls per field.
+
+To encode into and decode from memory the caller owns, such as a network buffer, use the overloads
+of `encode()` and `decode()` taking a pointer and size, or a `std::span` where available. These
+allocate nothing themselves, and are `constexpr` under C++ 20 when every type present is trivially
+copyable.
+
+Many results at once are more compactly written by `encode_batch()`, which replaces the status
+byte of each with one bit.
+*/
+namespace binary
+{
+  //! The status byte flag set when a value follows.
+  static constexpr uint8_t status_value = 1U << 0U;
+  //! The status byte flag set when an error follows.
+  static constexpr uint8_t status_error = 1U << 1U;
+  //! The status byte flag set when an exception follows.
+  static constexpr uint8_t status_exception = 1U << 2U;
+  //! The status byte flag set when the spare storage follows the status byte.
+  static constexpr uint8_t status_spare = 1U << 7U;
+
+  namespace detail
+  {
+    // Copies bytes between buffers of byte-like types, in a way usable in constant expressions
+    template <class To, class From> constexpr inline void copy_bytes(To *dest, const From *src, size_t bytes) noexcept
+    {
+#ifdef __cpp_lib_is_constant_evaluated
+      if(std::is_constant_evaluated())
+      {
+        for(size_t n = 0; n < bytes; n++)
+        {
+          dest[n] = static_cast<To>(src[n]);
+        }
+        return;
+      }
+#endif
+      if(bytes != 0)
+      {
+        memcpy(dest, src, bytes);
+      }
+    }
+
+    template <class Sink> constexpr inline void write_le(Sink &sink, uint32_t v, size_t bytes)
+    {
+      unsigned char buffer[4]{};
+      for(size_t n = 0; n < bytes; n++)
+      {
+        buffer[n] = static_cast<unsigned char>(v >> (8 * n));
+      }
+      sink.write(buffer, bytes);
+    }
+    template <class Source> constexpr inline bool read_le(Source &source, uint32_t &v, size_t bytes)
+    {
+      unsigned char buffer[4]{};
+      if(!source.read(buffer, bytes))
+      {
+        return false;
+      }
+      v = 0;
+      for(size_t n = 0; n < bytes; n++)
+      {
+        v |= static_cast<uint32_t>(buffer[n]) << (8 * n);
+      }
+      return true;
+    }
+  }  // namespace detail
+
+  //! The stable identifier written for `cat`, see `error_category_id()`.
+  inline uint32_t category_id(const std::error_category &cat) { return error_category_id(cat); }
+  /*! Registers a category so that error codes of it can be decoded, see `register_error_category()`.
+  The generic, system, iostream and future categories are registered already.
+  \returns False if the registry is full, or if a category of a different name has the same identifier.
+  */
+  inline bool register_category(const std::error_category &cat) { return register_error_category(cat); }
+  //! The registered category whose `category_id()` is `id`, or null if none.
+  inline const std::error_category *find_category(uint32_t id) noexcept { return find_error_category(id); }
+
+  /*! How a `T` is written to a sink and read from a source. Specialise it for your own types, with:
+
+  ```c++
+  template <class Sink> static void encode(Sink &sink, const T &v);
+  template <class Source> static bool decode(Source &source, T &v);
+  ```
+
+  `decode()` returns false if the bytes are malformed or too few. It is given a default constructed `T`.
+  By default trivially copyable types are copied as bytes. Make both `constexpr` if the type should
+  be usable in constant expressions.
+  */
+  template <class T, class = void> struct codec;
+  //! Trivially copyable types are copied as bytes, in constant expressions too if `std::bit_cast` is available.
+  template <class T> struct codec<T, std::enable_if_t<std::is_trivially_copyable<T>::value>>
+  {
+    template <class Sink> static constexpr void encode(Sink &sink, const T &v)
+    {
+#if defined(__cpp_lib_bit_cast) && defined(__cpp_lib_is_constant_evaluated)
+      if(std::is_constant_evaluated())
+      {
+        const auto bytes = std::bit_cast<std::array<unsigned char, sizeof(T)>>(v);
+        sink.write(bytes.data(), sizeof(T));
+        return;
+      }
+#endif
+      sink.write(reinterpret_cast<const unsigned char *>(&v), sizeof(T));  // NOLINT
+    }
+    template <class Source> static constexpr bool decode(Source &source, T &v)
+    {
+#if defined(__cpp_lib_bit_cast) && defined(__cpp_lib_is_constant_evaluated)
+      if(std::is_constant_evaluated())
+      {
+        std::array<unsigned char, sizeof(T)> bytes{};
+        if(!source.read(bytes.data(), sizeof(T)))
+        {
+          return false;
+        }
+        v = std::bit_cast<T>(bytes);
+        return true;
+      }
+#endif
+      return source.read(reinterpret_cast<unsigned char *>(&v), sizeof(T));  // NOLINT
+    }
+  };
+  //! Error codes are their value and the `category_id()` of their category.
+  template <> struct codec<std::error_code>
+  {
+    template <class Sink> static void encode(Sink &sink, const std::error_code &v)
+    {
+      detail::write_le(sink, static_cast<uint32_t>(v.value()), 4);
+      detail::write_le(sink, category_id(v.category()), 4);
+    }
+    template <class Source> static bool decode(Source &source, std::error_code &v)
+    {
+      uint32_t value = 0, id = 0;
+      if(!detail::read_le(source, value, 4) || !detail::read_le(source, id, 4))
+      {
+        return false;
+      }
+      const std::error_category *cat = find_category(id);
+      if(cat == nullptr)
+      {
+        return false;
+      }
+      v = std::error_code(static_cast<int>(value), *cat);
+      return true;
+    }
+  };
+  //! Strings are their length as four bytes, then their characters.
+  template <> struct codec<std::string>
+  {
+    template <class Sink> static void encode(Sink &sink, const std::string &v)
+    {
+      detail::write_le(sink, static_cast<uint32_t>(v.size()), 4);
+      sink.write(reinterpret_cast<const unsigned char *>(v.data()), v.size());  // NOLINT
+    }
+    template <class Source> static bool decode(Source &source, std::string &v)
+    {
+      uint32_t size = 0;
+      if(!detail::read_le(source, size, 4))
+      {
+        return false;
+      }
+      // Read in chunks, so a corrupt size cannot make us allocate more than the source holds
+      v.clear();
+      while(v.size() < size)
+      {
+        const size_t offset = v.size(), chunk = std::min<size_t>(size - offset, 4096);
+        v.resize(offset + chunk);
+        if(!source.read(reinterpret_cast<unsigned char *>(&v[offset]), chunk))  // NOLINT
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+  };
+  /*! Exception pointers are the error code which `error_from_exception()` finds for them, and read back
+  as a `std::system_error` of that code, so only what the code says survives.
+  */
+  template <> struct codec<std::exception_ptr>
+  {
+    template <class Sink> static void encode(Sink &sink, const std::exception_ptr &v)
+    {
+#ifdef __cpp_exceptions
+      codec<std::error_code>::encode(sink, error_from_exception(std::exception_ptr(v)));
+#else
+      (void) v;
+      codec<std::error_code>::encode(sink, std::error_code());
+#endif
+    }
+    template <class Source> static bool decode(Source &source, std::exception_ptr &v)
+    {
+      std::error_code ec;
+      if(!codec<std::error_code>::decode(source, ec))
+      {
+        return false;
+      }
+      v = std::make_exception_ptr(std::system_error(ec));
+      return true;
+    }
+  };
+
+  namespace detail
+  {
+    template <class Result> constexpr inline uint8_t status_of(const Result &v) noexcept
+    {
+      auto status = static_cast<uint8_t>((v.has_value() ? status_value : 0) | (v.has_error() ? status_error : 0));
+#ifndef OUTCOME_ENABLE_COMPACT_STATUS
+      if(hooks::spare_storage(&v) != 0)
+      {
+        status |= status_spare;
+      }
+#endif
+      return status;
+    }
+    template <class Sink, class Result> constexpr inline void encode_header(Sink &sink, const Result &v, uint8_t status)
+    {
+      sink.write(&status, 1);
+#ifndef OUTCOME_ENABLE_COMPACT_STATUS
+      if((status & status_spare) != 0)
+      {
+        write_le(sink, hooks::spare_storage(&v), 2);
+      }
+#else
+      (void) v;
+#endif
+    }
+    template <class Source> constexpr inline bool decode_header(Source &source, uint8_t &status, uint16_t &spare)
+    {
+      if(!source.read(&status, 1))
+      {
+        return false;
+      }
+      spare = 0;
+      if((status & status_spare) != 0)
+      {
+#ifndef OUTCOME_ENABLE_COMPACT_STATUS
+        uint32_t v = 0;
+        if(!read_le(source, v, 2))
+        {
+          return false;
+        }
+        spare = static_cast<uint16_t>(v);
+#else
+        return false;
+#endif
+      }
+      return true;
+    }
+    template <class Result> constexpr inline void set_spare(Result &v, uint16_t spare) noexcept
+    {
+#ifndef OUTCOME_ENABLE_COMPACT_STATUS
+      if(spare != 0)
+      {
+        hooks::set_spare_storage(&v, spare);
+      }
+#else
+      (void) v;
+      (void) spare;
+#endif
+    }
+
+    template <class T> using devoid = OUTCOME_V2_NAMESPACE::detail::devoid<T>;
+    template <class T, class Source> constexpr inline bool decode_item(Source &source, T &v, std::false_type /*is void*/) { return codec<T>::decode(source, v); }
+    template <class T, class Source> constexpr inline bool decode_item(Source & /*unused*/, T & /*unused*/, std::true_type /*is void*/) { return true; }
+
+    // Only the members which are not void are encoded
+    template <class Sink, class T> constexpr inline void encode_value(Sink &sink, const T &v, std::false_type /*is void*/) { codec<typename T::value_type>::encode(sink, v.assume_value()); }
+    template <class Sink, class T> constexpr inline void encode_value(Sink & /*unused*/, const T & /*unused*/, std::true_type /*is void*/) {}
+    template <class Sink, class T> constexpr inline void encode_exception(Sink &sink, const T &v, std::false_type /*is void*/) { codec<typename T::exception_type>::encode(sink, v.assume_exception()); }
+    template <class Sink, class T> constexpr inline void encode_exception(Sink & /*unused*/, const T & /*unused*/, std::true_type /*is void*/) {}
+
+    // Makes a success from a decoded value, which is void_type if the type is void
+    template <class T> constexpr inline success_type<T> make_success(devoid<T> &&v, std::false_type /*is void*/) { return success_type<T>(std::move(v)); }
+    template <class T> constexpr inline success_type<void> make_success(devoid<T> && /*unused*/, std::true_type /*is void*/) { return success(); }
+    /* Makes v errored with a decoded error. A trivially copyable result is constructed in place outside
+    constant evaluation, as its value is not initialised when errored, and GCC warns that it may be used
+    uninitialised if an errored temporary is copied over v. Such a result is also trivially destructible,
+    so v needs no destruction.
+    */
+    template <class R, class S, class P> constexpr inline void assign_error(result<R, S, P> &v, S &&error, std::true_type /*trivially copyable*/)
+    {
+#ifdef __cpp_lib_is_constant_evaluated
+      if(std::is_constant_evaluated())
+      {
+        v = failure_type<S>(std::move(error));
+        return;
+      }
+#endif
+      new(&v) result<R, S, P>(in_place_type<S>, std::move(error));
+    }
+    template <class R, class S, class P> constexpr inline void assign_error(result<R, S, P> &v, S &&error, std::false_type /*trivially copyable*/) { v = failure_type<S>(std::move(error)); }
+    template <class T, class S, class P> constexpr inline void assign_failure(T &v, S &&error, P && /*unused*/, uint8_t status, std::true_type /*exception is void*/)
+    {
+      (void) status;
+      v = failure_type<std::decay_t<S>>(std::move(error));
+    }
+    template <class T, class S, class P> constexpr inline void assign_failure(T &v, S &&error, P &&exception, uint8_t status, std::false_type /*exception is void*/)
+    {
+      if((status & status_exception) == 0)
+      {
+        v = failure_type<std::decay_t<S>>(std::move(error));
+      }
+      else if((status & status_error) == 0)
+      {
+        v = failure_type<void, std::decay_t<P>>(std::move(exception));
+      }
+      else
+      {
+        v = failure_type<std::decay_t<S>, std::decay_t<P>>(std::move(error), std::move(exception));
+      }
+    }
+  }  // namespace detail
+
+  /*! Encodes `v` into `sink`.
+  \requires There to be a `codec` for `R` unless it is void, and for `S`.
+  */
+  template <class Sink, class R, class S, class P> constexpr inline void encode(Sink &sink, const result<R, S, P> &v)
+  {
+    static_assert(!std::is_void<S>::value, "Results with a void error type cannot be serialised");
+    detail::encode_header(sink, v, detail::status_of(v));
+    if(v.has_value())
+    {
+      detail::encode_value(sink, v, std::is_void<R>());
+    }
+    else if(v.has_error())
+    {
+      codec<S>::encode(sink, v.assume_error());
+    }
+  }
+  /*! Decodes from `source` into `v`, which is assigned only if all went well.
+  \returns False if the bytes were malformed or too few, or the result encoded was neither valued nor errored.
+  */
+  template <class Source, class R, class S, class P> constexpr inline bool decode(Source &source, result<R, S, P> &v)
+  {
+    uint8_t status = 0;
+    uint16_t spare = 0;
+    if(!detail::decode_header(source, status, spare))
+    {
+      return false;
+    }
+    if((status & status_value) != 0)
+    {
+      detail::devoid<R> value{};
+      if(!detail::decode_item(source, value, std::is_void<R>()))
+      {
+        return false;
+      }
+      v = detail::make_success<R>(std::move(value), std::is_void<R>());
+    }
+    else if((status & status_error) != 0)
+    {
+      S error{};
+      if(!codec<S>::decode(source, error))
+      {
+        return false;
+      }
+      detail::assign_error(v, std::move(error), std::is_trivially_copyable<result<R, S, P>>());
+    }
+    else
+    {
+      return false;
+    }
+    detail::set_spare(v, spare);
+    return true;
+  }
+
+  /*! Encodes `v` into `sink`.
+  \requires There to be a `codec` for each of `R` and `P` unless void, and for `S`.
+  */
+  template <class Sink, class R, class S, class P, class N> constexpr inline void encode(Sink &sink, const outcome<R, S, P, N> &v)
+  {
+    static_assert(!std::is_void<S>::value, "Outcomes with a void error type cannot be serialised");
+    detail::encode_header(sink, v, static_cast<uint8_t>(detail::status_of(v) | (v.has_exception() ? status_exception : 0)));
+    if(v.has_value())
+    {
+      detail::encode_value(sink, v, std::is_void<R>());
+      return;
+    }
+    if(v.has_error())
+    {
+      codec<S>::encode(sink, v.assume_error());
+    }
+    if(v.has_exception())
+    {
+      detail::encode_exception(sink, v, std::is_void<P>());
+    }
+  }
+  /*! Decodes from `source` into `v`, which is assigned only if all went well.
+  \returns False if the bytes were malformed or too few, or the outcome encoded was empty.
+  */
+  template <class Source, class R, class S, class P, class N> constexpr inline bool decode(Source &source, outcome<R, S, P, N> &v)
+  {
+    uint8_t status = 0;
+    uint16_t spare = 0;
+    if(!detail::decode_header(source, status, spare))
+    {
+      return false;
+    }
+    if((status & status_value) != 0)
+    {
+      detail::devoid<R> value{};
+      if(!detail::decode_item(source, value, std::is_void<R>()))
+      {
+        return false;
+      }
+      v = detail::make_success<R>(std::move(value), std::is_void<R>());
+    }
+    else
+    {
+      S error{};
+      detail::devoid<P> exception{};
+      if((status & (status_error | status_exception)) == 0                                                           //
+         || ((status & status_exception) != 0 && std::is_void<P>::value)                                          //
+         || ((status & status_error) != 0 && !codec<S>::decode(source, error))                                    //
+         || ((status & status_exception) != 0 && !detail::decode_item(source, exception, std::is_void<P>())))  //
+      {
+        return false;
+      }
+      detail::assign_failure(v, std::move(error), std::move(exception), status, std::is_void<P>());
+    }
+    detail::set_spare(v, spare);
+    return true;
+  }
+
+  namespace detail
+  {
+    template <class Container> struct batch_traits;
+    template <class R, class S, class P, class A> struct batch_traits<std::vector<result<R, S, P>, A>>
+    {
+      using result_type = result<R, S, P>;
+    };
+    template <class T, class E, class P> struct batch_traits<result_vector<T, E, P>>
+    {
+      using result_type = typename result_vector<T, E, P>::result_type;
+    };
+
+    template <class Source, class Container> inline bool decode_batch_into(Source &source, Container &out)
+    {
+      using result_type = typename batch_traits<Container>::result_type;
+      using value_type = typename result_type::value_type;
+      using error_type = typename result_type::error_type;
+      uint32_t count = 0;
+      if(!read_le(source, count, 4))
+      {
+        return false;
+      }
+      // Read in chunks, so a corrupt count cannot make us allocate more than the source holds
+      std::vector<unsigned char> failed;
+      for(size_t bytes = (static_cast<size_t>(count) + 7) / 8; failed.size() < bytes;)
+      {
+        const size_t offset = failed.size(), chunk = std::min<size_t>(bytes - offset, 4096);
+        failed.resize(offset + chunk);
+        if(!source.read(failed.data() + offset, chunk))
+        {
+          return false;
+        }
+      }
+      Container ret;
+      ret.reserve(count);
+      for(size_t n = 0; n < count; n++)
+      {
+        if(((failed[n / 8] >> (n % 8)) & 1U) == 0)
+        {
+          value_type v{};
+          if(!codec<value_type>::decode(source, v))
+          {
+            return false;
+          }
+          ret.push_back(result_type(in_place_type<value_type>, std::move(v)));
+        }
+        else
+        {
+          ret.push_back(result_type(in_place_type<error_type>));
+        }
+      }
+      for(size_t n = 0; n < count; n++)
+      {
+        if(((failed[n / 8] >> (n % 8)) & 1U) != 0)
+        {
+          error_type e{};
+          if(!codec<error_type>::decode(source, e))
+          {
+            return false;
+          }
+          ret[n] = result_type(in_place_type<error_type>, std::move(e));
+        }
+      }
+      out = std::move(ret);
+      return true;
+    }
+  }  // namespace detail
+
+  /*! Encodes a contiguous batch of results, a `std::vector` of `result` or a `result_vector`, into `sink`.
+
+  The format is the number of items as four bytes, then a bitmap of which items are errored, one
+  bit per item with bit `n % 8` of byte `n / 8` for item `n`, then the values of the valued items
+  in order, then the errors of the errored items in order. A batch which mostly succeeded
+  therefore costs about one bit per item on top of its values. Spare storage is not kept.
+  \requires The results to have a non-void value type, to be valued or errored, and to number fewer than 2^32.
+  */
+  template <class Sink, class Container, class = typename detail::batch_traits<Container>::result_type> inline void encode_batch(Sink &sink, const Container &items)
+  {
+    using result_type = typename detail::batch_traits<Container>::result_type;
+    const size_t count = items.size();
+    detail::write_le(sink, static_cast<uint32_t>(count), 4);
+    unsigned char failed = 0;
+    for(size_t n = 0; n < count; n++)
+    {
+      if(!items[n].has_value())
+      {
+        failed |= static_cast<unsigned char>(1U << (n % 8));
+      }
+      if(n % 8 == 7 || n + 1 == count)
+      {
+        sink.write(&failed, 1);
+        failed = 0;
+      }
+    }
+    for(size_t n = 0; n < count; n++)
+    {
+      if(items[n].has_value())
+      {
+        codec<typename result_type::value_type>::encode(sink, items[n].assume_value());
+      }
+    }
+    for(size_t n = 0; n < count; n++)
+    {
+      if(!items[n].has_value())
+      {
+        codec<typename result_type::error_type>::encode(sink, items[n].assume_error());
+      }
+    }
+  }
+  /*! Decodes a batch written by `encode_batch()` from `source` into `items`, which is replaced only if
+  all went well. The source is read once from start to end.
+  \returns False if the bytes were malformed or too few.
+  */
+  template <class Source, class Container, class = typename detail::batch_traits<Container>::result_type> inline bool decode_batch(Source &source, Container &items) { return detail::decode_batch_into(source, items); }
+
+  //! Why decoding from, or encoding into, a buffer failed.
+  enum class decode_error
+  {
+    truncated = 1,    //!< The buffer ended before the encoded object did.
+    malformed,        //!< The bytes do not encode an object of the type requested.
+    buffer_too_small  //!< The buffer is too small to encode the object into.
+  };
+
+  //! A sink writing into a buffer the caller owns, which never allocates.
+  template <class Byte = unsigned char> class buffer_sink
+  {
+    static_assert(sizeof(Byte) == 1, "Byte must be a byte-like type");
+    Byte *_data;
+    size_t _size, _written{0};
+    bool _good{true};
+
+  public:
+    //! Constructs a sink writing into the `size` bytes at `data`.
+    constexpr buffer_sink(Byte *data, size_t size) noexcept
+        : _data(data)
+        , _size(size)
+    {
+    }
+    //! Writes `bytes` bytes from `data`, or nothing from now on if they would not fit.
+    constexpr void write(const unsigned char *data, size_t bytes) noexcept
+    {
+      if(!_good || bytes > _size - _written)
+      {
+        _good = false;
+        return;
+      }
+      detail::copy_bytes(_data + _written, data, bytes);
+      _written += bytes;
+    }
+    //! False if any write would not fit.
+    constexpr bool good() const noexcept { return _good; }
+    //! The number of bytes written.
+    constexpr size_t written() const noexcept { return _written; }
+  };
+  //! A source reading from a buffer the caller owns, which never allocates.
+  template <class Byte = unsigned char> class buffer_source
+  {
+    static_assert(sizeof(Byte) == 1, "Byte must be a byte-like type");
+    const Byte *_data;
+    size_t _size, _read{0};
+    bool _truncated{false};
+
+  public:
+    //! Constructs a source reading from the `size` bytes at `data`.
+    constexpr buffer_source(const Byte *data, size_t size) noexcept
+        : _data(data)
+        , _size(size)
+    {
+    }
+    //! Reads `bytes` bytes into `data`, returning false if there were too few.
+    constexpr bool read(unsigned char *data, size_t bytes) noexcept
+    {
+      if(bytes > _size - _read)
+      {
+        _truncated = true;
+        return false;
+      }
+      detail::copy_bytes(data, _data + _read, bytes);
+      _read += bytes;
+      return true;
+    }
+    //! True if a read was short.
+    constexpr bool truncated() const noexcept { return _truncated; }
+    //! The number of bytes read.
+    constexpr size_t consumed() const noexcept { return _read; }
+  };
+
+  namespace detail
+  {
+    template <class T> struct is_serialisable : std::false_type
+    {
+    };
+    template <class R, class S, class P> struct is_serialisable<result<R, S, P>> : std::true_type
+    {
+    };
+    template <class R, class S, class P, class N> struct is_serialisable<outcome<R, S, P, N>> : std::true_type
+    {
+    };
+  }  // namespace detail
+
+  /*! Encodes `v` into the `size` bytes at `data`, which the caller owns.
+  \returns The number of bytes written, or `decode_error::buffer_too_small` if they would not fit,
+  in which case the contents of the buffer are unspecified.
+  */
+  template <class T, class Byte, typename = std::enable_if_t<detail::is_serialisable<T>::value>>  //
+  constexpr inline result<size_t, decode_error> encode(const T &v, Byte *data, size_t size)
+  {
+    buffer_sink<Byte> sink(data, size);
+    encode(sink, v);
+    if(!sink.good())
+    {
+      return failure(decode_error::buffer_too_small);
+    }
+    return success(sink.written());
+  }
+  /*! Decodes a `T`, a `result` or `outcome`, from the `size` bytes at `data`. Trailing bytes
+  are ignored. Only the codecs of the types in `T` may allocate, which those of trivially copyable
+  types never do.
+  \returns The object decoded, or why it could not be.
+  */
+  template <class T, class Byte, typename = std::enable_if_t<detail::is_serialisable<T>::value>>  //
+  constexpr inline result<T, decode_error> decode(const Byte *data, size_t size)
+  {
+    buffer_source<Byte> source(data, size);
+    T v{in_place_type<typename T::error_type>};
+    if(!decode(source, v))
+    {
+      return failure(source.truncated() ? decode_error::truncated : decode_error::malformed);
+    }
+    return result<T, decode_error>{in_place_type<T>, std::move(v)};
+  }
+#ifdef __cpp_lib_span
+  //! Encodes `v` into `buffer`, as for the overload taking a pointer and size.
+  template <class T, typename = std::enable_if_t<detail::is_serialisable<T>::value>> constexpr inline result<size_t, decode_error> encode(const T &v, std::span<std::byte> buffer) { return encode(v, buffer.data(), buffer.size()); }
+  //! Decodes a `T` from `buffer`, as for the overload taking a pointer and size.
+  template <class T, typename = std::enable_if_t<detail::is_serialisable<T>::value>> constexpr inline result<T, decode_error> decode(std::span<const std::byte> buffer) { return decode<T>(buffer.data(), buffer.size()); }
+#endif
+
+  //! A sink writing to a stream buffer directly, bypassing formatting and locales.
+  class streambuf_sink
+  {
+    std::streambuf *_buf;
+    bool _good{true};
+
+  public:
+    //! Constructs a sink writing to `buf`.
+    explicit streambuf_sink(std::streambuf *buf) noexcept
+        : _buf(buf)
+    {
+    }
+    //! Writes `bytes` bytes from `data`.
+    void write(const unsigned char *data, size_t bytes)
+    {
+      _good = _good && _buf->sputn(reinterpret_cast<const char *>(data), static_cast<std::streamsize>(bytes)) == static_cast<std::streamsize>(bytes);  // NOLINT
+    }
+    //! False if any write was short.
+    bool good() const noexcept { return _good; }
+  };
+  //! A source reading from a stream buffer directly, bypassing formatting and locales.
+  class streambuf_source
+  {
+    std::streambuf *_buf;
+
+  public:
+    //! Constructs a source reading from `buf`.
+    explicit streambuf_source(std::streambuf *buf) noexcept
+        : _buf(buf)
+    {
+    }
+    //! Reads `bytes` bytes into `data`, returning false if there were too few.
+    bool read(unsigned char *data, size_t bytes) { return _buf->sgetn(reinterpret_cast<char *>(data), static_cast<std::streamsize>(bytes)) == static_cast<std::streamsize>(bytes); }  // NOLINT
+  };
+
+  //! Refers to a `result` or `outcome` to be streamed in binary, as returned by `as_binary()`.
+  template <class T> struct binary_ref
+  {
+    //! The object streamed.
+    T *object;
+
+    //! Encodes the object into `s`, setting `badbit` if the stream buffer would not take it all.
+    friend inline std::ostream &operator<<(std::ostream &s, binary_ref v)
+    {
+      std::ostream::sentry ok(s);
+      if(ok)
+      {
+        streambuf_sink sink(s.rdbuf());
+        encode(sink, *v.object);
+        if(!sink.good())
+        {
+          s.setstate(std::ios_base::badbit);
+        }
+      }
+      return s;
+    }
+    //! Decodes the object from `s`, setting `failbit` if the bytes were malformed or too few.
+    friend inline std::istream &operator>>(std::istream &s, binary_ref v)
+    {
+      std::istream::sentry ok(s, true);
+      if(ok)
+      {
+        streambuf_source source(s.rdbuf());
+        if(!decode(source, *v.object))
+        {
+          s.setstate(std::ios_base::failbit);
+        }
+      }
+      return s;
+    }
+  };
+  /*! Wraps a `result` or `outcome` so that `<<` and `>>` stream it in the binary format, e.g.
+  `s << binary::as_binary(r)`. The stream buffer is used directly, so this is unaffected by
+  the stream's formatting flags and locale.
+  */
+  template <class T> inline binary_ref<T> as_binary(T &v) noexcept { return {&v}; }
+}  // namespace binary
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
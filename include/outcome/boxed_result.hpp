@@ -0,0 +1,287 @@
+/* A result keeping a large value out of line
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_BOXED_RESULT_HPP
+#define OUTCOME_BOXED_RESULT_HPP
+
+#include "exception_box.hpp"
+#include "result.hpp"
+
+#include <new>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  //! The size above which `boxed_result` keeps its value out of line by default. `benchmark/boxed.cpp` crosses over between 128 and 256 bytes.
+  static constexpr size_t boxed_value_threshold = 128;
+}  // namespace detail
+
+namespace trait
+{
+  /*! Customisation point choosing whether `boxed_result<T>` keeps its `T` out of line. Defaults to
+  true for types larger than `detail::boxed_value_threshold` bytes which are not over aligned.
+  */
+  template <class T> struct is_boxed_value
+  {
+    static constexpr bool value = sizeof(T) > OUTCOME_V2_NAMESPACE::detail::boxed_value_threshold && alignof(T) <= alignof(std::max_align_t);
+  };
+}  // namespace trait
+
+/*! An owning pointer to a `T` allocated from the same per thread free lists as `exception_box`,
+so boxing a value rarely calls the allocator once a thread is warm. Copying a box copies the `T`
+into a new box, moving one moves the pointer. A moved from box is empty, and may only be assigned
+to or destroyed.
+*/
+template <class T> class value_box
+{
+  static_assert(alignof(T) <= alignof(std::max_align_t), "value_box cannot hold over aligned types");
+  // Sizes are rounded up so that similarly sized types share a free list
+  using _pool = detail::exception_box_pool<(sizeof(T) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t)>;
+  T *_p{nullptr};
+
+  template <class... Args> static T *_make(Args &&... args)
+  {
+    void *mem = _pool::allocate();
+#ifdef __cpp_exceptions
+    try
+    {
+      return new(mem) T(std::forward<Args>(args)...);
+    }
+    catch(...)
+    {
+      _pool::deallocate(mem);
+      throw;
+    }
+#else
+    return new(mem) T(std::forward<Args>(args)...);
+#endif
+  }
+  void _release() noexcept
+  {
+    if(_p != nullptr)
+    {
+      _p->~T();
+      _pool::deallocate(_p);
+      _p = nullptr;
+    }
+  }
+
+public:
+  //! The type boxed.
+  using element_type = T;
+
+  //! Boxes a copy of `v`.
+  value_box(const T &v)  // NOLINT
+      : _p(_make(v))
+  {
+  }
+  //! Boxes `v`, moving from it.
+  value_box(T &&v)  // NOLINT
+      : _p(_make(std::move(v)))
+  {
+  }
+  //! Boxes a `T` constructed in place from `args`.
+  template <class... Args>
+  explicit value_box(in_place_type_t<T> /*unused*/, Args &&... args)
+      : _p(_make(std::forward<Args>(args)...))
+  {
+  }
+  //! Boxes a copy of the `T` boxed by `o`.
+  value_box(const value_box &o)
+      : _p((o._p != nullptr) ? _make(*o._p) : nullptr)
+  {
+  }
+  //! Takes the box of `o`, leaving it empty.
+  value_box(value_box &&o) noexcept : _p(o._p) { o._p = nullptr; }
+  //! Copy assigns the `T` boxed, boxing a copy if this box is empty.
+  value_box &operator=(const value_box &o)
+  {
+    if(this != &o)
+    {
+      if(o._p == nullptr)
+      {
+        _release();
+      }
+      else if(_p != nullptr)
+      {
+        *_p = *o._p;
+      }
+      else
+      {
+        _p = _make(*o._p);
+      }
+    }
+    return *this;
+  }
+  //! Takes the box of `o`, leaving it empty.
+  value_box &operator=(value_box &&o) noexcept
+  {
+    if(this != &o)
+    {
+      _release();
+      _p = o._p;
+      o._p = nullptr;
+    }
+    return *this;
+  }
+  ~value_box() { _release(); }
+
+  //! Swaps boxes.
+  friend void swap(value_box &a, value_box &b) noexcept
+  {
+    T *p = a._p;
+    a._p = b._p;
+    b._p = p;
+  }
+
+  //! The `T` boxed. \requires The box to not be empty.
+  T &operator*() noexcept { return *_p; }
+  //! The `T` boxed. \requires The box to not be empty.
+  const T &operator*() const noexcept { return *_p; }
+  //! The `T` boxed. \requires The box to not be empty.
+  T *operator->() noexcept { return _p; }
+  //! The `T` boxed. \requires The box to not be empty.
+  const T *operator->() const noexcept { return _p; }
+  //! The `T` boxed, or null if the box is empty.
+  T *get() noexcept { return _p; }
+  //! The `T` boxed, or null if the box is empty.
+  const T *get() const noexcept { return _p; }
+
+  //! True if the `T` boxed compare equal, or both boxes are empty.
+  friend bool operator==(const value_box &a, const value_box &b) { return (a._p == nullptr || b._p == nullptr) ? a._p == b._p : *a._p == *b._p; }
+  //! True if not equal.
+  friend bool operator!=(const value_box &a, const value_box &b) { return !(a == b); }
+};
+
+namespace trait
+{
+  //! A box is a pointer to its `T`.
+  template <class T> struct is_move_bitcopying<value_box<T>>
+  {
+    static constexpr bool value = true;
+  };
+}  // namespace trait
+
+namespace detail
+{
+  template <class T> using boxed_value_t = std::conditional_t<trait::is_boxed_value<T>::value, value_box<T>, T>;
+  template <class T> constexpr T &unbox(T &v) noexcept { return v; }
+  template <class T> constexpr const T &unbox(const T &v) noexcept { return v; }
+  template <class T> constexpr T &unbox(value_box<T> &v) noexcept { return *v; }
+  template <class T> constexpr const T &unbox(const value_box<T> &v) noexcept { return *v; }
+}  // namespace detail
+
+/*! A `result<T, E>` which keeps a `T` for which `trait::is_boxed_value<T>` is true in a `value_box<T>`.
+The result then stays the size of `result<void *, E>`, so every frame an error propagates through
+copies a pointer sized slot rather than a large unused value, at the cost of a free list pop and
+push for each successful result. `benchmark/boxed.cpp` measures the crossover.
+
+The value observers `assume_value()`, `value()` and `value_or()` see the `T`. Everything else,
+including the monadic operations and `emplace()`, sees `value_box<T>`.
+*/
+template <class T, class E = std::error_code, class NoValuePolicy = policy::default_policy<T, E, void>> class boxed_result : public result<detail::boxed_value_t<T>, E, NoValuePolicy>
+{
+  using base = result<detail::boxed_value_t<T>, E, NoValuePolicy>;
+
+public:
+  //! The success type.
+  using value_type = T;
+  //! The type kept in the result, either `T` or `value_box<T>`.
+  using storage_type = detail::boxed_value_t<T>;
+  //! True if the value is kept out of line.
+  static constexpr bool is_boxed = trait::is_boxed_value<T>::value;
+
+  using base::base;
+  boxed_result() = delete;
+  boxed_result(const boxed_result &) = default;
+  boxed_result(boxed_result &&) = default;  // NOLINT
+  boxed_result &operator=(const boxed_result &) = default;
+  boxed_result &operator=(boxed_result &&) = default;  // NOLINT
+  ~boxed_result() = default;
+  //! Constructs from the underlying `result`.
+  boxed_result(const base &o)  // NOLINT
+      : base(o)
+  {
+  }
+  //! Constructs from the underlying `result`, moving from it.
+  boxed_result(base &&o)  // NOLINT
+      : base(std::move(o))
+  {
+  }
+  //! Constructs the value in place from `args`.
+  template <class... Args>
+  explicit boxed_result(in_place_type_t<T> _, Args &&... args)
+      : boxed_result(std::integral_constant<bool, is_boxed>(), _, std::forward<Args>(args)...)
+  {
+  }
+
+  /*! Access the value without runtime checks.
+  \group assume_value
+  */
+  constexpr T &assume_value() & noexcept { return detail::unbox(base::assume_value()); }
+  /// \group assume_value
+  constexpr const T &assume_value() const &noexcept { return detail::unbox(base::assume_value()); }
+  /// \group assume_value
+  constexpr T &&assume_value() && noexcept { return std::move(detail::unbox(base::assume_value())); }
+  /// \group assume_value
+  constexpr const T &&assume_value() const &&noexcept { return std::move(detail::unbox(base::assume_value())); }
+  /*! Access the value, with the wide check of `NoValuePolicy`.
+  \group value
+  */
+  constexpr T &value() & { return detail::unbox(base::value()); }
+  /// \group value
+  constexpr const T &value() const & { return detail::unbox(base::value()); }
+  /// \group value
+  constexpr T &&value() && { return std::move(detail::unbox(base::value())); }
+  /// \group value
+  constexpr const T &&value() const && { return std::move(detail::unbox(base::value())); }
+  //! A copy of the value if there is one, else `fallback`.
+  template <class U> constexpr T value_or(U &&fallback) const & { return this->has_value() ? assume_value() : static_cast<T>(std::forward<U>(fallback)); }
+  //! The value moved out if there is one, else `fallback`.
+  template <class U> constexpr T value_or(U &&fallback) && { return this->has_value() ? std::move(*this).assume_value() : static_cast<T>(std::forward<U>(fallback)); }
+
+private:
+  template <class... Args>
+  boxed_result(std::true_type /*unused*/, in_place_type_t<T> _, Args &&... args)
+      : base(in_place_type<storage_type>, _, std::forward<Args>(args)...)
+  {
+  }
+  template <class... Args>
+  boxed_result(std::false_type /*unused*/, in_place_type_t<T> _, Args &&... args)
+      : base(_, std::forward<Args>(args)...)
+  {
+  }
+};
+
+namespace trait
+{
+  template <class T, class E, class P> struct is_move_bitcopying<boxed_result<T, E, P>> : is_move_bitcopying<result<OUTCOME_V2_NAMESPACE::detail::boxed_value_t<T>, E, P>>
+  {
+  };
+}  // namespace trait
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,206 @@
+/* Bulk status scanning over contiguous spans of results
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_BULK_HPP
+#define OUTCOME_BULK_HPP
+
+#include "result_vector.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+#if defined(__has_include)
+#if __has_include(<version>)
+#include <version>
+#endif
+#endif
+#ifdef __cpp_lib_span
+#include <span>
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+/*! Namespace for kernels which test the status of many results at once, or extract their values.
+
+Each kernel works on blocks of sixty-four results. It first gathers their status words into a
+sixty-four bit mask with a branchless loop, which the compiler vectorises with whatever gather or
+shuffle instructions the target supports. Then it works on the mask a word at a time. An item has
+failed if it is not valued. The kernels work for `result` and for `outcome`.
+*/
+namespace bulk
+{
+  namespace detail
+  {
+    static constexpr size_t block_size = 64;
+    // Bit n is set if r[n] is not valued, n must not exceed block_size
+    template <class Result> inline uint64_t failure_mask(const Result *r, size_t n) noexcept
+    {
+      uint64_t mask = 0;
+      for(size_t i = 0; i < n; i++)
+      {
+        mask |= static_cast<uint64_t>((static_cast<uint8_t>(r[i].status()) & static_cast<uint8_t>(result_status::value)) == 0) << i;
+      }
+      return mask;
+    }
+
+    struct unwrap_copy
+    {
+      template <class Result> static decltype(auto) value(const Result &r) noexcept { return r.assume_value(); }
+    };
+    struct unwrap_move
+    {
+      template <class Result> static decltype(auto) value(Result &r) noexcept { return std::move(r).assume_value(); }
+    };
+    // Writes the values of `n` results known to be valued. A loop over a pointer has no loop carried
+    // dependency through the output, so gathering trivially copyable values vectorises.
+    template <class Op, class Result, class OutputIt> inline OutputIt unwrap_values(Result *r, size_t n, OutputIt out)
+    {
+      for(size_t i = 0; i < n; i++)
+      {
+        *out++ = Op::value(r[i]);
+      }
+      return out;
+    }
+    template <class Op, class Result, class T> inline T *unwrap_values(Result *r, size_t n, T *out)
+    {
+      for(size_t i = 0; i < n; i++)
+      {
+        out[i] = Op::value(r[i]);
+      }
+      return out + n;
+    }
+    template <class Op, class Result, class OutputIt> inline result<size_t, typename std::remove_const<Result>::type::error_type> unwrap_all(Result *first, size_t n, OutputIt out)
+    {
+      using error_type = typename std::remove_const<Result>::type::error_type;
+      for(size_t base = 0; base < n; base += block_size)
+      {
+        const size_t count = std::min(block_size, n - base);
+        const uint64_t mask = failure_mask(first + base, count);
+        // Every value of the block is written unchecked, or those before its first failure
+        const size_t valued = (mask == 0) ? count : OUTCOME_V2_NAMESPACE::detail::result_vector_lowest_bit(mask);
+        out = unwrap_values<Op>(first + base, valued, out);
+        if(mask != 0)
+        {
+          return result<size_t, error_type>(in_place_type<error_type>, first[base + valued].assume_error());
+        }
+      }
+      return result<size_t, error_type>(in_place_type<size_t>, n);
+    }
+  }  // namespace detail
+
+  //! True if any of the `n` results starting at `first` is not valued.
+  template <class Result> inline bool any_failed(const Result *first, size_t n) noexcept
+  {
+    for(size_t base = 0; base < n; base += detail::block_size)
+    {
+      if(detail::failure_mask(first + base, std::min(detail::block_size, n - base)) != 0)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  //! The index of the first of the `n` results starting at `first` which is not valued, or `n` if all are valued.
+  template <class Result> inline size_t find_first_failure(const Result *first, size_t n) noexcept
+  {
+    for(size_t base = 0; base < n; base += detail::block_size)
+    {
+      const uint64_t mask = detail::failure_mask(first + base, std::min(detail::block_size, n - base));
+      if(mask != 0)
+      {
+        return base + OUTCOME_V2_NAMESPACE::detail::result_vector_lowest_bit(mask);
+      }
+    }
+    return n;
+  }
+
+  //! The number of the `n` results starting at `first` which are not valued.
+  template <class Result> inline size_t count_failures(const Result *first, size_t n) noexcept
+  {
+    size_t ret = 0;
+    for(size_t base = 0; base < n; base += detail::block_size)
+    {
+      ret += OUTCOME_V2_NAMESPACE::detail::result_vector_popcount(detail::failure_mask(first + base, std::min(detail::block_size, n - base)));
+    }
+    return ret;
+  }
+
+  /*! Reorders the `n` results starting at `first` so the valued ones come first, keeping the relative order within each group.
+  \returns The number of valued results.
+  */
+  template <class Result> inline size_t partition_by_status(Result *first, size_t n)
+  {
+    // Leading valued results stay where they are
+    const size_t begin = find_first_failure(first, n);
+    if(begin == n)
+    {
+      return n;
+    }
+    Result *mid = std::stable_partition(first + begin, first + n, [](const Result &r) { return r.has_value(); });
+    return static_cast<size_t>(mid - first);
+  }
+
+  /*! Copies the values of the valued results among the `n` starting at `first` to `out`, in order.
+  \returns The output iterator one past the last value written.
+  */
+  template <class Result, class OutputIt> inline OutputIt compress_values(const Result *first, size_t n, OutputIt out)
+  {
+    for(size_t base = 0; base < n; base += detail::block_size)
+    {
+      const size_t count = std::min(detail::block_size, n - base);
+      uint64_t valued = ~detail::failure_mask(first + base, count);
+      if(count < detail::block_size)
+      {
+        valued &= (uint64_t(1) << count) - 1;
+      }
+      for(; valued != 0; valued &= valued - 1)
+      {
+        *out++ = first[base + OUTCOME_V2_NAMESPACE::detail::result_vector_lowest_bit(valued)].assume_value();
+      }
+    }
+    return out;
+  }
+
+  /*! Copies the values of the `n` results starting at `first` to `out`, in order, stopping at the
+  first which is not valued. Each block of results is checked at once, after which its values are
+  copied without any further check, so this costs much less than calling `value()` on each.
+  \returns `n`, or the error of the first result not valued, in which case the values of the
+  results before it have been written.
+  \requires `Result` to be a `result`, or an `outcome` whose failures always have an error.
+  */
+  template <class Result, class OutputIt> inline auto unwrap_all(const Result *first, size_t n, OutputIt out) { return detail::unwrap_all<detail::unwrap_copy>(first, n, out); }
+  //! As `unwrap_all()`, but moves the values out of the results rather than copying them.
+  template <class Result, class OutputIt> inline auto unwrap_all_move(Result *first, size_t n, OutputIt out) { return detail::unwrap_all<detail::unwrap_move>(first, n, out); }
+#ifdef __cpp_lib_span
+  //! \group unwrap_all
+  template <class Result, size_t Extent, class OutputIt> inline auto unwrap_all(std::span<Result, Extent> results, OutputIt out) { return unwrap_all(static_cast<const Result *>(results.data()), results.size(), out); }
+  //! \group unwrap_all_move
+  template <class Result, size_t Extent, class OutputIt> inline auto unwrap_all_move(std::span<Result, Extent> results, OutputIt out) { return unwrap_all_move(results.data(), results.size(), out); }
+#endif
+}  // namespace bulk
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
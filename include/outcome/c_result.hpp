@@ -0,0 +1,229 @@
+/* Layout compatibility of results with their C representation
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_C_RESULT_HPP
+#define OUTCOME_C_RESULT_HPP
+
+#include "category_registry.hpp"
+#include "result.h"
+#include "result.hpp"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+/*! The C++ equivalent of the struct declared by `CXX_DECLARE_RESULT(R, RD, S, SD)` in `result.h`, for
+reading and writing results shared with C, or with other processes.
+*/
+template <class R, class S> struct c_result
+{
+  //! The value, valid if `CXX_RESULT_HAS_VALUE()`.
+  R value;
+  //! The status flags.
+  CXX_RESULT_FLAGS_TYPE flags;
+  //! The error, valid if `CXX_RESULT_HAS_ERROR()`.
+  S error;
+};
+
+namespace trait
+{
+  namespace detail
+  {
+    template <class R, class S, bool = std::is_standard_layout<R>::value &&std::is_standard_layout<S>::value &&std::is_trivially_copyable<R>::value &&std::is_trivially_copyable<S>::value && !std::is_same<R, S>::value>
+    struct c_layout_compatible : std::false_type
+    {
+    };
+    template <class R, class S> struct c_layout_compatible<R, S, true>
+    {
+      using result_type = result<R, S>;
+      using c_type = c_result<R, S>;
+      using state_type = OUTCOME_V2_NAMESPACE::detail::value_storage_trivial<R>;
+      static constexpr bool value = std::is_same<std::decay_t<decltype(std::declval<const result_type &>().__state())>, state_type>::value  //
+                                    && std::is_standard_layout<result_type>::value                                                   //
+                                    && sizeof(result_type) == sizeof(c_type) && alignof(result_type) == alignof(c_type)              //
+                                    && sizeof(OUTCOME_V2_NAMESPACE::detail::status_bitfield_type) == sizeof(CXX_RESULT_FLAGS_TYPE)   //
+                                    && offsetof(state_type, _status) == offsetof(c_type, flags)                                      //
+                                    && result_type::__error_offset() == offsetof(c_type, error);
+    };
+  }  // namespace detail
+
+  /*! True if `result<R, S>` has the same layout as the `c_result<R, S>`, and so the struct declared by
+  `CXX_DECLARE_RESULT()`, with `value`, then `flags`, then `error`. This holds when `R` and `S` are
+  distinct, trivially copyable and standard layout, and `result<R, S>` stores neither its status in
+  a niche of `R` nor its value and error in one union (see `trait::niche` and `trait::disjoint_storage`).
+  Unless `OUTCOME_ENABLE_COMPACT_STATUS` is defined, the error also follows any tail padding after
+  the status, so results whose value is more aligned than their error, such as `result<double, int>`,
+  are larger than their C struct and not compatible.
+  */
+  template <class R, class S> struct is_c_layout_compatible : std::integral_constant<bool, detail::c_layout_compatible<R, S>::value>
+  {
+  };
+  //! True if `result<R, S>` has the same layout as `c_result<R, S>`.
+  template <class R, class S> static constexpr bool is_c_layout_compatible_v = is_c_layout_compatible<R, S>::value;
+}  // namespace trait
+
+static_assert(trait::is_c_layout_compatible_v<int, std::error_code>, "result<int> is not layout compatible with CXX_RESULT_EC(int)");
+static_assert(trait::is_c_layout_compatible_v<uint64_t, std::error_code>, "result<uint64_t> is not layout compatible with CXX_RESULT_EC(uint64_t)");
+static_assert(trait::is_c_layout_compatible_v<double, std::error_code>, "result<double> is not layout compatible with CXX_RESULT_EC(double)");
+static_assert(trait::is_c_layout_compatible_v<char, cxx_portable_error_code>, "result<char, cxx_portable_error_code> is not layout compatible with its C struct");
+
+/*! The C representation of `v`.
+\requires `trait::is_c_layout_compatible_v<R, S>`.
+*/
+template <class R, class S, class P> inline c_result<R, S> to_c_result(const result<R, S, P> &v) noexcept
+{
+  static_assert(trait::is_c_layout_compatible_v<R, S>, "result<R, S> is not layout compatible with c_result<R, S>");
+  using result_type = result<R, S, P>;
+  using c_type = c_result<R, S>;
+  static_assert(std::is_trivially_copyable<result_type>::value && std::is_trivially_copyable<c_type>::value, "result<R, S> and c_result<R, S> must be trivially copyable");
+  static_assert(sizeof(result_type) == sizeof(c_type) && result_type::__error_offset() == offsetof(c_type, error), "result<R, S> and c_result<R, S> differ in size or layout");
+  c_type ret;
+  // Copied as bytes, as a c_result whose error has a default constructor is not trivial
+  memcpy(reinterpret_cast<unsigned char *>(&ret), reinterpret_cast<const unsigned char *>(&v), sizeof(ret));
+  return ret;
+}
+/*! The result represented by `v`, which must be valued or errored.
+\requires `trait::is_c_layout_compatible_v<R, S>`.
+*/
+template <class R, class S, class P = policy::default_policy<R, S, void>> inline result<R, S, P> from_c_result(const c_result<R, S> &v) noexcept
+{
+  static_assert(trait::is_c_layout_compatible_v<R, S>, "result<R, S> is not layout compatible with c_result<R, S>");
+  using result_type = result<R, S, P>;
+  using c_type = c_result<R, S>;
+  static_assert(std::is_trivially_copyable<result_type>::value && std::is_trivially_copyable<c_type>::value, "result<R, S> and c_result<R, S> must be trivially copyable");
+  static_assert(sizeof(result_type) == sizeof(c_type) && result_type::__error_offset() == offsetof(c_type, error), "result<R, S> and c_result<R, S> differ in size or layout");
+  result_type ret(in_place_type<S>);
+  memcpy(reinterpret_cast<unsigned char *>(&ret), reinterpret_cast<const unsigned char *>(&v), sizeof(ret));
+  return ret;
+}
+
+/*! The C++ equivalent of the compact struct declared by `CXX_DECLARE_RESULT_EC32(R, RD)` in `result.h`,
+which is returned in two registers when `R` is no larger than eight bytes.
+*/
+template <class R> struct c_result_ec32
+{
+  //! The value, valid if `CXX_RESULT_HAS_VALUE()`.
+  R value;
+  //! The stable identifier of the category of the error, valid if `CXX_RESULT_HAS_ERROR()`.
+  uint32_t category;
+  //! The status flags in the bottom eight bits, and the error code in the top 24 bits.
+  uint32_t flags;
+};
+static_assert(sizeof(c_result_ec32<uint64_t>) == 16, "c_result_ec32<uint64_t> does not fit in two registers");
+
+/*! The compact C representation of `v`, with the category of any error registered if it was not already,
+and its code truncated to 24 bits if it does not fit.
+\requires `R` to be trivially copyable.
+*/
+template <class R, class P> inline c_result_ec32<R> to_c_result32(const result<R, std::error_code, P> &v)
+{
+  static_assert(std::is_trivially_copyable<R>::value, "R must be trivially copyable to be sent to C");
+  c_result_ec32<R> ret{};
+  ret.flags = static_cast<uint32_t>(v.__state().status() & 0x7fU);
+  if(v.has_value())
+  {
+    ret.value = v.assume_value();
+  }
+  else
+  {
+    const int code = v.assume_error().value();
+    ret.category = error_category_id(v.assume_error().category());
+    ret.flags |= static_cast<uint32_t>(code) << 8U;
+    if(code < -0x800000 || code > 0x7fffff)
+    {
+      ret.flags |= CXX_RESULT_EC32_CODE_TRUNCATED;
+    }
+  }
+  return ret;
+}
+/*! Converts the compact C representation `v`, which must be valued or errored, into `out`.
+\returns False, leaving `out` alone, if `v` is errored with a category which is not registered.
+*/
+template <class R, class P> inline bool from_c_result32(result<R, std::error_code, P> &out, const c_result_ec32<R> &v) noexcept
+{
+  if(CXX_RESULT_HAS_VALUE(v))
+  {
+    out = result<R, std::error_code, P>(in_place_type<R>, v.value);
+    return true;
+  }
+  const std::error_category *category = find_error_category(v.category);
+  if(category == nullptr)
+  {
+    return false;
+  }
+  out = result<R, std::error_code, P>(in_place_type<std::error_code>, CXX_RESULT_EC32_ERROR(v), *category);
+  return true;
+}
+
+namespace detail
+{
+  inline int c_error_code(const std::error_code &ec) noexcept { return ec.value(); }
+  inline int c_error_code(const cxx_error_code &ec) noexcept { return ec.code; }
+  inline int c_error_code(const cxx_portable_error_code &ec) noexcept { return ec.code; }
+  template <class R> inline int c_error_code(const c_result_ec32<R> &v) noexcept { return CXX_RESULT_EC32_ERROR(v); }
+  template <class R, class S> inline int c_error_code(const c_result<R, S> &v) noexcept { return c_error_code(v.error); }
+
+  template <class C> inline size_t c_results_to_errno(const C *results, size_t count, int *out) noexcept
+  {
+    size_t errored = 0;
+    for(size_t n = 0; n < count; n++)
+    {
+      const int is_error = -static_cast<int>((results[n].flags >> 1U) & 1U), is_errno = -static_cast<int>((results[n].flags >> 4U) & 1U);
+      out[n] = is_error & ((is_errno & c_error_code(results[n])) | (~is_errno & EAGAIN));
+      errored += static_cast<size_t>(is_error & 1);
+    }
+    return errored;
+  }
+  template <class C, class R> inline size_t c_results_to_values_and_errno(const C *results, size_t count, R *values, int *out) noexcept
+  {
+    for(size_t n = 0; n < count; n++)
+    {
+      values[n] = CXX_RESULT_HAS_VALUE(results[n]) ? results[n].value : R{};
+    }
+    return c_results_to_errno(results, count, out);
+  }
+}  // namespace detail
+
+/*! The batch version of `CXX_RESULT_SET_ERRNO()`, as `cxx_results_##R##_errorcode_to_errno()` in `result.h`.
+Writes into `out[n]` zero if `results[n]` is valued, its error if that is `errno` compatible, and `EAGAIN`
+if not, without branching on the status of each result, so compilers vectorise it.
+\returns The number of results which were errored.
+\requires `S` to be `std::error_code`, `cxx_error_code` or `cxx_portable_error_code`.
+*/
+template <class R, class S> inline size_t results_to_errno(const c_result<R, S> *results, size_t count, int *out) noexcept { return detail::c_results_to_errno(results, count, out); }
+//! \group results_to_errno
+template <class R> inline size_t results_to_errno(const c_result_ec32<R> *results, size_t count, int *out) noexcept { return detail::c_results_to_errno(results, count, out); }
+/*! As `results_to_errno()`, also writing into `values[n]` the value of `results[n]`, or a value initialised
+`R` if it was errored.
+*/
+template <class R, class S> inline size_t results_to_values_and_errno(const c_result<R, S> *results, size_t count, R *values, int *out) noexcept { return detail::c_results_to_values_and_errno(results, count, values, out); }
+//! \group results_to_values_and_errno
+template <class R> inline size_t results_to_values_and_errno(const c_result_ec32<R> *results, size_t count, R *values, int *out) noexcept { return detail::c_results_to_values_and_errno(results, count, values, out); }
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,98 @@
+/* Calls turning thrown exceptions into results
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_CATCH_TO_RESULT_HPP
+#define OUTCOME_CATCH_TO_RESULT_HPP
+
+#include "result.hpp"
+#include "utils.hpp"
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  template <class R> struct catch_to_result_type
+  {
+    using type = result<R>;
+  };
+  template <class T, class E, class P> struct catch_to_result_type<result<T, E, P>>
+  {
+    using type = result<T, E, P>;
+  };
+  // What the callable returned is returned as it is if a result, else is the value of one
+  template <class Ret, class F, class... Args> inline Ret catch_to_result_call(std::integral_constant<int, 0> /*unused*/, F &&f, Args &&... args) { return std::forward<F>(f)(std::forward<Args>(args)...); }
+  template <class Ret, class F, class... Args> inline Ret catch_to_result_call(std::integral_constant<int, 1> /*unused*/, F &&f, Args &&... args) { return Ret(in_place_type<typename Ret::value_type>, std::forward<F>(f)(std::forward<Args>(args)...)); }
+  template <class Ret, class F, class... Args> inline Ret catch_to_result_call(std::integral_constant<int, 2> /*unused*/, F &&f, Args &&... args)
+  {
+    std::forward<F>(f)(std::forward<Args>(args)...);
+    return Ret(in_place_type<void>);
+  }
+#ifdef __cpp_exceptions
+  /* The handler of every catch_to_result(), shared and kept cold and out of line so that each catch
+  site costs no more than a call to it and the construction of the failure.
+  */
+  OUTCOME_COLD inline std::error_code catch_to_error_code() noexcept { return error_from_exception(std::current_exception()); }
+#endif
+}  // namespace detail
+
+/*! Calls `f(args...)`, returning what it returns as a `result`, or the error code which
+`error_from_exception()` matches to the exception it throws. This is the boundary from code which
+throws into code which returns results, in place of a hand written `try` and `catch(...)`.
+
+If `f` returns a `result<T, E, P>`, that is returned, and `E` must be constructible from
+`std::error_code`. Otherwise a `result<R>` of the decayed return type `R` of `f` is returned.
+Exceptions are matched by the registered and STL types of `error_from_exception()`, including the
+exact type lookup where `OUTCOME_HAVE_EXCEPTION_PTR_TYPE` is defined, and those not matched become
+`errc::resource_unavailable_try_again`. The matching is done in a single out of line function shared
+by every call site, so the catch handlers stay small.
+
+Without C++ exceptions, simply calls `f(args...)`.
+*/
+template <class F, class... Args, class R = decltype(std::declval<F>()(std::declval<Args>()...)), class Ret = typename detail::catch_to_result_type<std::decay_t<R>>::type>
+inline Ret catch_to_result(F &&f, Args &&... args) noexcept
+{
+  static_assert(std::is_nothrow_constructible<typename Ret::error_type, std::error_code>::value, "catch_to_result() needs an error type nothrow constructible from std::error_code");
+  using kind = std::integral_constant<int, is_result<R>::value ? 0 : (std::is_void<R>::value ? 2 : 1)>;
+#ifdef __cpp_exceptions
+  try
+  {
+    return detail::catch_to_result_call<Ret>(kind(), std::forward<F>(f), std::forward<Args>(args)...);
+  }
+  catch(...)
+  {
+    return Ret(in_place_type<typename Ret::error_type>, detail::catch_to_error_code());
+  }
+#else
+  return detail::catch_to_result_call<Ret>(kind(), std::forward<F>(f), std::forward<Args>(args)...);
+#endif
+}
+
+OUTCOME_V2_NAMESPACE_END
+
+/*! Evaluates the expression ..., returning its value as a `result`, or the error code which
+`error_from_exception()` matches to the exception it throws. See `catch_to_result()`.
+*/
+#define OUTCOME_CATCH_TO_RESULT(...) OUTCOME_V2_NAMESPACE::catch_to_result([&]() { return __VA_ARGS__; })
+
+#endif
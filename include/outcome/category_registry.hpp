@@ -0,0 +1,235 @@
+/* A registry of stable numeric identifiers for error categories
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_CATEGORY_REGISTRY_HPP
+#define OUTCOME_CATEGORY_REGISTRY_HPP
+
+#include "config.hpp"
+#include "result.h"
+#include "tracepoints.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <future>
+#include <ios>
+#include <mutex>
+#include <system_error>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+/*! The identifier `error_category_id()` gives a category named `name` which was not registered with
+an identifier of its own, a 32 bit FNV-1a hash of the name. It is never zero.
+*/
+constexpr inline uint32_t error_category_name_id(const char *name) noexcept
+{
+  uint32_t h = 2166136261U;
+  for(; *name != 0; ++name)
+  {
+    h = (h ^ static_cast<unsigned char>(*name)) * 16777619U;
+  }
+  return (h != 0) ? h : 1;
+}
+
+namespace detail
+{
+  /* Two open addressed tables, one from identifier to category and one from category to identifier.
+  Slots are filled under a lock and published with a release store of their key, so lookups take
+  no lock. Slots are never emptied, at most half of them are used.
+  */
+  class category_registry
+  {
+  public:
+    static constexpr size_t max_categories = 256;
+
+  private:
+    static constexpr size_t _slots = 2 * max_categories;
+    struct by_id_slot
+    {
+      std::atomic<uint32_t> id{0};
+      std::atomic<const std::error_category *> category{nullptr};
+    };
+    struct by_category_slot
+    {
+      std::atomic<const std::error_category *> category{nullptr};
+      std::atomic<uint32_t> id{0};
+    };
+    std::mutex _lock;
+    size_t _ids{0}, _categories{0};
+    by_id_slot _by_id[_slots];
+    by_category_slot _by_category[_slots];
+
+    static size_t _hash(uint32_t id) noexcept { return static_cast<size_t>(id * 2654435761U); }
+    static size_t _hash(const std::error_category *category) noexcept { return static_cast<size_t>((reinterpret_cast<uintptr_t>(category) >> 4U) * 2654435761U); }  // NOLINT
+
+    category_registry()
+    {
+      add(std::generic_category(), error_category_name_id(std::generic_category().name()));
+      add(std::system_category(), error_category_name_id(std::system_category().name()));
+      add(std::iostream_category(), error_category_name_id(std::iostream_category().name()));
+      add(std::future_category(), error_category_name_id(std::future_category().name()));
+    }
+
+  public:
+    static category_registry &get()
+    {
+      static category_registry v;
+      return v;
+    }
+
+    const std::error_category *find(uint32_t id) const noexcept
+    {
+      for(size_t n = _hash(id), probes = 0; id != 0 && probes < _slots; n++, probes++)
+      {
+        const by_id_slot &slot = _by_id[n % _slots];
+        const uint32_t current = slot.id.load(std::memory_order_acquire);
+        if(current == 0)
+        {
+          break;
+        }
+        if(current == id)
+        {
+          return slot.category.load(std::memory_order_relaxed);
+        }
+      }
+      return nullptr;
+    }
+    uint32_t find(const std::error_category &category) const noexcept
+    {
+      for(size_t n = _hash(&category), probes = 0; probes < _slots; n++, probes++)
+      {
+        const by_category_slot &slot = _by_category[n % _slots];
+        const std::error_category *current = slot.category.load(std::memory_order_acquire);
+        if(current == nullptr)
+        {
+          break;
+        }
+        if(current == &category)
+        {
+          return slot.id.load(std::memory_order_relaxed);
+        }
+      }
+      return 0;
+    }
+
+    /* Maps `category` and `id` to one another. Another instance of a category of the same name, such
+    as one per shared library, may share an identifier, which then finds the first registered.
+    */
+    bool add(const std::error_category &category, uint32_t id)
+    {
+      if(id == 0)
+      {
+        return false;
+      }
+      std::lock_guard<std::mutex> g(_lock);
+      const std::error_category *existing = find(id);
+      const uint32_t current = find(category);
+      if((existing != nullptr && existing != &category && strcmp(existing->name(), category.name()) != 0) || (current != 0 && current != id))
+      {
+        return false;
+      }
+      if((existing == nullptr && _ids == max_categories) || (current == 0 && _categories == max_categories))
+      {
+        return false;
+      }
+      if(existing == nullptr)
+      {
+        size_t n = _hash(id);
+        while(_by_id[n % _slots].id.load(std::memory_order_relaxed) != 0)
+        {
+          n++;
+        }
+        _by_id[n % _slots].category.store(&category, std::memory_order_relaxed);
+        _by_id[n % _slots].id.store(id, std::memory_order_release);
+        ++_ids;
+      }
+      if(current == 0)
+      {
+        size_t n = _hash(&category);
+        while(_by_category[n % _slots].category.load(std::memory_order_relaxed) != nullptr)
+        {
+          n++;
+        }
+        _by_category[n % _slots].id.store(id, std::memory_order_relaxed);
+        _by_category[n % _slots].category.store(&category, std::memory_order_release);
+        ++_categories;
+        OUTCOME_TRACEPOINT(category, &category, id, category.name());
+      }
+      return true;
+    }
+  };
+}  // namespace detail
+
+/*! Registers `category` with the stable identifier `id`, so that `error_category_id()` returns `id`
+for it and `find_error_category(id)` returns it. Register explicit identifiers before the category
+is first used with `error_category_id()`, which would otherwise register it with the hash of its name.
+At most `detail::category_registry::max_categories` categories can be registered. The generic, system,
+iostream and future categories are registered already, with the hashes of their names.
+\returns False if `id` is zero, if `id` is already taken by a category of a different name, if
+`category` already has a different identifier, or if the registry is full.
+*/
+inline bool register_error_category(const std::error_category &category, uint32_t id) { return detail::category_registry::get().add(category, id); }
+//! Registers `category` with the identifier `error_category_name_id(category.name())`.
+inline bool register_error_category(const std::error_category &category) { return register_error_category(category, error_category_name_id(category.name())); }
+
+/*! The stable identifier of `category`, the same in every process which registers it with the same
+identifier, or by default which names it the same. The first call for a category which was not
+registered registers it with the hash of its name, later calls take constant time and no lock.
+\returns The identifier, or zero if `category` could not be registered.
+*/
+inline uint32_t error_category_id(const std::error_category &category)
+{
+  detail::category_registry &registry = detail::category_registry::get();
+  const uint32_t id = registry.find(category);
+  if(OUTCOME_LIKELY(id != 0))
+  {
+    return id;
+  }
+  registry.add(category, error_category_name_id(category.name()));
+  return registry.find(category);
+}
+//! The category registered with the identifier `id`, or null if none. Takes constant time and no lock.
+inline const std::error_category *find_error_category(uint32_t id) noexcept { return detail::category_registry::get().find(id); }
+
+/*! Converts `ec` into the C representation which can be sent between processes.
+The category is zero if it could not be registered.
+*/
+inline cxx_portable_error_code to_portable_error_code(const std::error_code &ec) { return {ec.value(), error_category_id(ec.category())}; }
+/*! Converts the C representation `v` into `ec`.
+\returns False, leaving `ec` alone, if the category of `v` is not registered.
+*/
+inline bool from_portable_error_code(std::error_code &ec, const cxx_portable_error_code &v) noexcept
+{
+  const std::error_category *category = find_error_category(v.category);
+  if(category == nullptr)
+  {
+    return false;
+  }
+  ec = std::error_code(v.code, *category);
+  return true;
+}
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
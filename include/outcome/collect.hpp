@@ -0,0 +1,289 @@
+/* Aggregation of many results into one
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_COLLECT_HPP
+#define OUTCOME_COLLECT_HPP
+
+#include "result.hpp"
+
+#include <iterator>
+#include <new>
+#include <vector>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+/*! A list of errors which stores the first `N` in place, so that it allocates memory only once it
+holds more than `N`. The errors are contiguous.
+*/
+template <class E, size_t N = 4> class error_list
+{
+  static_assert(N > 0, "error_list must have some inline storage");
+
+  union _inline_storage {
+    E _items[N];
+    _inline_storage() noexcept {}  // NOLINT
+    ~_inline_storage() {}          // NOLINT
+  } _inline;
+  E *_data{_inline._items};
+  size_t _size{0}, _capacity{N};
+
+  bool _is_inline() const noexcept { return _data == _inline._items; }
+  void _grow()
+  {
+    const size_t capacity = _capacity * 2;
+    auto *data = static_cast<E *>(::operator new(capacity * sizeof(E)));
+    for(size_t n = 0; n < _size; n++)
+    {
+      new(data + n) E(std::move(_data[n]));
+      _data[n].~E();
+    }
+    _release();
+    _data = data;
+    _capacity = capacity;
+  }
+  void _release() noexcept
+  {
+    if(!_is_inline())
+    {
+      ::operator delete(_data);
+    }
+  }
+
+public:
+  //! The error type.
+  using value_type = E;
+  //! The size type.
+  using size_type = size_t;
+  //! The iterator type.
+  using iterator = E *;
+  //! The const iterator type.
+  using const_iterator = const E *;
+
+  //! Default constructs an empty list.
+  error_list() noexcept = default;
+  //! Copy constructor.
+  error_list(const error_list &o)
+      : error_list()
+  {
+    for(const E &e : o)
+    {
+      push_back(e);
+    }
+  }
+  //! Move constructor, which steals the heap storage of `o` if it has any.
+  error_list(error_list &&o) noexcept(std::is_nothrow_move_constructible<E>::value)
+      : error_list()
+  {
+    if(!o._is_inline())
+    {
+      _data = o._data;
+      _size = o._size;
+      _capacity = o._capacity;
+      o._data = o._inline._items;
+      o._size = 0;
+      o._capacity = N;
+      return;
+    }
+    for(E &e : o)
+    {
+      new(_data + _size++) E(std::move(e));
+    }
+    o.clear();
+  }
+  //! Copy assignment.
+  error_list &operator=(const error_list &o)
+  {
+    if(this != &o)
+    {
+      error_list temp(o);
+      *this = std::move(temp);
+    }
+    return *this;
+  }
+  //! Move assignment.
+  error_list &operator=(error_list &&o) noexcept(std::is_nothrow_move_constructible<E>::value)
+  {
+    if(this != &o)
+    {
+      this->~error_list();
+      new(this) error_list(std::move(o));
+    }
+    return *this;
+  }
+  ~error_list()
+  {
+    clear();
+    _release();
+  }
+
+  //! Appends an error.
+  void push_back(const E &e)
+  {
+    if(_size == _capacity)
+    {
+      _grow();
+    }
+    new(_data + _size) E(e);
+    ++_size;
+  }
+  //! \group push_back
+  void push_back(E &&e)
+  {
+    if(_size == _capacity)
+    {
+      _grow();
+    }
+    new(_data + _size) E(std::move(e));
+    ++_size;
+  }
+  //! Removes all errors, keeping any heap storage.
+  void clear() noexcept
+  {
+    for(size_t n = 0; n < _size; n++)
+    {
+      _data[n].~E();
+    }
+    _size = 0;
+  }
+
+  //! The number of errors.
+  size_type size() const noexcept { return _size; }
+  //! True if there are no errors.
+  bool empty() const noexcept { return _size == 0; }
+  //! True if the errors are stored in place, and no memory has been allocated.
+  bool is_inline() const noexcept { return _is_inline(); }
+  //! \group index
+  E &operator[](size_type idx) noexcept { return _data[idx]; }
+  //! \group index
+  const E &operator[](size_type idx) const noexcept { return _data[idx]; }
+  //! \group data
+  E *data() noexcept { return _data; }
+  //! \group data
+  const E *data() const noexcept { return _data; }
+  //! \group begin
+  iterator begin() noexcept { return _data; }
+  //! \group begin
+  const_iterator begin() const noexcept { return _data; }
+  //! \group end
+  iterator end() noexcept { return _data + _size; }
+  //! \group end
+  const_iterator end() const noexcept { return _data + _size; }
+
+  //! True if both lists hold equal errors in the same order.
+  friend bool operator==(const error_list &a, const error_list &b) noexcept
+  {
+    if(a.size() != b.size())
+    {
+      return false;
+    }
+    for(size_t n = 0; n < a.size(); n++)
+    {
+      if(!(a[n] == b[n]))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+  //! True if the lists differ.
+  friend bool operator!=(const error_list &a, const error_list &b) noexcept { return !(a == b); }
+};
+
+//! All the values and all the errors of a range of results, as returned by `collect_all()`.
+template <class T, class E> struct collected
+{
+  //! The values of the results which were valued, in order.
+  std::vector<T> values;
+  //! The errors of the results which were errored, in order.
+  error_list<E> errors;
+};
+
+namespace detail
+{
+  template <class Range> using collect_result_t = std::decay_t<decltype(*std::begin(std::declval<Range &>()))>;
+
+  // Moves out of the range if it was passed as an rvalue
+  template <class Range, class Item> inline decltype(auto) collect_forward(Item &item) noexcept
+  {
+    return static_cast<std::conditional_t<std::is_lvalue_reference<Range>::value, Item &, Item &&>>(item);
+  }
+
+  // If all_or_errors, values stop being kept once there is an error
+  template <class Range, class T, class E> inline void collect_into(Range &&range, std::vector<T> &values, error_list<E> &errors, bool all_or_errors)
+  {
+    bool keep_values = true;
+    values.reserve(static_cast<size_t>(std::distance(std::begin(range), std::end(range))));
+    for(auto &r : range)
+    {
+      if(r.has_value())
+      {
+        if(keep_values)
+        {
+          values.push_back(collect_forward<Range>(r).assume_value());
+        }
+      }
+      else
+      {
+        errors.push_back(collect_forward<Range>(r).assume_error());
+        keep_values = !all_or_errors;
+      }
+    }
+  }
+}  // namespace detail
+
+/*! Gathers the values of a range of `result<T, E>`, or if any are errored, all their errors. The results
+are moved from if `range` is an rvalue, else copied.
+\returns A `result<std::vector<T>, error_list<E>>` holding every value in order if all were valued,
+else every error in order.
+\requires `range` to be a forward range of `result` which are each valued or errored.
+*/
+template <class Range, class R = detail::collect_result_t<Range>>  //
+inline result<std::vector<typename R::value_type>, error_list<typename R::error_type>> collect(Range &&range)
+{
+  std::vector<typename R::value_type> values;
+  error_list<typename R::error_type> errors;
+  detail::collect_into(std::forward<Range>(range), values, errors, true);
+  if(!errors.empty())
+  {
+    return failure(std::move(errors));
+  }
+  return {std::move(values)};
+}
+
+/*! Gathers both the values and the errors of a range of `result<T, E>`. The results are moved from if
+`range` is an rvalue, else copied.
+\returns A `collected<T, E>` holding every value and every error, each in order.
+\requires `range` to be a forward range of `result` which are each valued or errored.
+*/
+template <class Range, class R = detail::collect_result_t<Range>>  //
+inline collected<typename R::value_type, typename R::error_type> collect_all(Range &&range)
+{
+  collected<typename R::value_type, typename R::error_type> ret;
+  detail::collect_into(std::forward<Range>(range), ret.values, ret.errors, false);
+  return ret;
+}
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
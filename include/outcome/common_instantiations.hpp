@@ -0,0 +1,59 @@
+/* Explicit instantiations of the common result and outcome specialisations
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_COMMON_INSTANTIATIONS_HPP
+#define OUTCOME_COMMON_INSTANTIATIONS_HPP
+
+#include "outcome.hpp"
+
+#include <string>
+
+/*! \def OUTCOME_COMMON_INSTANTIATIONS(X)
+The specialisations compiled once into the `outcome_common` library, as `X(type)` for each,
+defaulting to `result<void>`, `result<int>`, `result<std::string>` and `outcome<void>`. Types
+are looked up inside the outcome namespace. The CMake `OUTCOME_COMMON_INSTANTIATIONS` list sets
+this for the library and everything linking it, via `OUTCOME_COMMON_INSTANTIATIONS_CONFIG`.
+*/
+#ifdef OUTCOME_COMMON_INSTANTIATIONS_CONFIG
+#include OUTCOME_COMMON_INSTANTIATIONS_CONFIG
+#endif
+#ifndef OUTCOME_COMMON_INSTANTIATIONS
+#define OUTCOME_COMMON_INSTANTIATIONS(X) X(result<void>) X(result<int>) X(result<std::string>) X(outcome<void>)
+#endif
+
+//! \brief Declares one of `OUTCOME_COMMON_INSTANTIATIONS` as explicitly instantiated elsewhere.
+#define OUTCOME_COMMON_EXTERN_TEMPLATE(...) extern template class __VA_ARGS__;
+
+OUTCOME_V2_NAMESPACE_BEGIN
+
+/* Including this header stops each translation unit instantiating the member functions of these
+specialisations itself, they are instead linked from outcome_common. Only the members of the
+specialisation proper are covered, the observers inherited from its bases are still instantiated
+where used, as are all member templates.
+*/
+OUTCOME_COMMON_INSTANTIATIONS(OUTCOME_COMMON_EXTERN_TEMPLATE)
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
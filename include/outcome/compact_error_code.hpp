@@ -0,0 +1,223 @@
+/* A four byte trivially copyable error code
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_COMPACT_ERROR_CODE_HPP
+#define OUTCOME_COMPACT_ERROR_CODE_HPP
+
+#include "result.hpp"
+
+#include <atomic>
+#include <string>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  // Index zero is always the system category, index one always the generic category
+  static constexpr uint32_t compact_error_code_categories = 256;
+  inline std::atomic<const std::error_category *> *compact_error_code_registry() noexcept
+  {
+    static std::atomic<const std::error_category *> registry[compact_error_code_categories];
+    return registry;
+  }
+  // Returns compact_error_code_categories if the registry is full
+  inline uint32_t compact_error_code_category_index(const std::error_category &category) noexcept
+  {
+    if(category == std::system_category())
+    {
+      return 0;
+    }
+    if(category == std::generic_category())
+    {
+      return 1;
+    }
+    auto *registry = compact_error_code_registry();
+    for(uint32_t n = 2; n < compact_error_code_categories; n++)
+    {
+      const std::error_category *current = registry[n].load(std::memory_order_acquire);
+      if(current == nullptr && registry[n].compare_exchange_strong(current, &category, std::memory_order_acq_rel, std::memory_order_acquire))
+      {
+        return n;
+      }
+      // current is never null here, a failed exchange loads the winner
+      if(*current == category)
+      {
+        return n;
+      }
+    }
+    return compact_error_code_categories;
+  }
+  inline const std::error_category &compact_error_code_category(uint32_t index) noexcept
+  {
+    if(index == 0)
+    {
+      return std::system_category();
+    }
+    if(index == 1)
+    {
+      return std::generic_category();
+    }
+    return *compact_error_code_registry()[index].load(std::memory_order_acquire);
+  }
+}  // namespace detail
+
+/*! A four byte trivially copyable edition of `std::error_code`, which keeps a twenty-four bit
+signed value and an eight bit index into a process wide registry of error categories. Categories
+are registered on first use, the system and generic categories are always present.
+
+Converts implicitly to and from `std::error_code`. A code whose value does not fit into twenty-four
+bits, or whose category cannot be registered because 254 others already have been, is converted into
+`std::errc::value_too_large`.
+
+`result<R, compact_error_code>` uses the disjoint storage layout for trivially copyable `R`, so
+`result<int, compact_error_code>` fits into eight bytes.
+*/
+class compact_error_code
+{
+  // Bits 0-7 are the category index, bits 8-31 the value
+  uint32_t _bits{0};
+
+  static constexpr int32_t _value_max = (1 << 23) - 1;
+  static constexpr int32_t _value_min = -(1 << 23);
+
+public:
+  //! Default constructs to the equivalent of `std::error_code()`.
+  constexpr compact_error_code() noexcept = default;
+  //! Implicit construction from a `std::error_code`.
+  compact_error_code(const std::error_code &ec) noexcept  // NOLINT
+  {
+    const uint32_t index = detail::compact_error_code_category_index(ec.category());
+    if(index >= detail::compact_error_code_categories || ec.value() > _value_max || ec.value() < _value_min)
+    {
+      _bits = (static_cast<uint32_t>(static_cast<int>(std::errc::value_too_large)) << 8U) | 1U;
+      return;
+    }
+    _bits = (static_cast<uint32_t>(ec.value()) << 8U) | index;
+  }
+  //! Implicit construction from any error code enum.
+  OUTCOME_TEMPLATE(class ErrorCodeEnum)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_error_code_enum<ErrorCodeEnum>::value))
+  compact_error_code(ErrorCodeEnum e) noexcept  // NOLINT
+      : compact_error_code(std::error_code(e))
+  {
+  }
+
+  //! The error code value.
+  constexpr int value() const noexcept { return static_cast<int32_t>(_bits) >> 8; }
+  //! The error category.
+  const std::error_category &category() const noexcept { return detail::compact_error_code_category(_bits & 0xffU); }
+  //! The explanatory message for this error code.
+  std::string message() const { return category().message(value()); }
+  //! True if the value is not zero.
+  constexpr explicit operator bool() const noexcept { return value() != 0; }
+  //! Resets to the equivalent of `std::error_code()`.
+  constexpr void clear() noexcept { _bits = 0; }
+  //! True if the category is the system or the generic category, unlike `std::error_code` this needs no virtual call.
+  constexpr bool is_errno() const noexcept
+  {
+#ifdef _WIN32
+    return (_bits & 0xffU) == 1;
+#else
+    return (_bits & 0xffU) <= 1;
+#endif
+  }
+
+  //! Converts to the equivalent `std::error_code`.
+  std::error_code to_error_code() const noexcept { return {value(), category()}; }
+  //! \group compact_error_code_conversion
+  operator std::error_code() const noexcept { return to_error_code(); }  // NOLINT
+
+  //! True if both the value and the category are equal.
+  friend constexpr bool operator==(compact_error_code a, compact_error_code b) noexcept { return a._bits == b._bits; }
+  //! True if either the value or the category differ.
+  friend constexpr bool operator!=(compact_error_code a, compact_error_code b) noexcept { return a._bits != b._bits; }
+  //! \group compact_error_code_compare
+  friend bool operator==(compact_error_code a, const std::error_code &b) noexcept { return a.to_error_code() == b; }
+  //! \group compact_error_code_compare
+  friend bool operator==(const std::error_code &a, compact_error_code b) noexcept { return a == b.to_error_code(); }
+  //! \group compact_error_code_compare
+  friend bool operator!=(compact_error_code a, const std::error_code &b) noexcept { return a.to_error_code() != b; }
+  //! \group compact_error_code_compare
+  friend bool operator!=(const std::error_code &a, compact_error_code b) noexcept { return a != b.to_error_code(); }
+  //! True if equivalent to the error condition, with the same semantics as `std::error_code`.
+  friend bool operator==(compact_error_code a, const std::error_condition &b) noexcept { return a.to_error_code() == b; }
+  //! \group compact_error_code_compare
+  friend bool operator==(const std::error_condition &a, compact_error_code b) noexcept { return a == b.to_error_code(); }
+  //! \group compact_error_code_compare
+  friend bool operator!=(compact_error_code a, const std::error_condition &b) noexcept { return a.to_error_code() != b; }
+  //! \group compact_error_code_compare
+  friend bool operator!=(const std::error_condition &a, compact_error_code b) noexcept { return a != b.to_error_code(); }
+  //! True if equal to the error code enum, or equivalent to the error condition enum, with the same semantics as `std::error_code`.
+  OUTCOME_TEMPLATE(class Enum)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_error_code_enum<Enum>::value || std::is_error_condition_enum<Enum>::value))
+  friend bool operator==(compact_error_code a, Enum b) noexcept { return a.to_error_code() == _comparand(b, std::is_error_code_enum<Enum>()); }
+  //! \group compact_error_code_compare
+  OUTCOME_TEMPLATE(class Enum)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_error_code_enum<Enum>::value || std::is_error_condition_enum<Enum>::value))
+  friend bool operator==(Enum a, compact_error_code b) noexcept { return b.to_error_code() == _comparand(a, std::is_error_code_enum<Enum>()); }
+  //! \group compact_error_code_compare
+  OUTCOME_TEMPLATE(class Enum)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_error_code_enum<Enum>::value || std::is_error_condition_enum<Enum>::value))
+  friend bool operator!=(compact_error_code a, Enum b) noexcept { return a.to_error_code() != _comparand(b, std::is_error_code_enum<Enum>()); }
+  //! \group compact_error_code_compare
+  OUTCOME_TEMPLATE(class Enum)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_error_code_enum<Enum>::value || std::is_error_condition_enum<Enum>::value))
+  friend bool operator!=(Enum a, compact_error_code b) noexcept { return b.to_error_code() != _comparand(a, std::is_error_code_enum<Enum>()); }
+
+private:
+  template <class Enum> static std::error_code _comparand(Enum e, std::true_type /*unused*/) noexcept { return std::error_code(e); }
+  template <class Enum> static std::error_condition _comparand(Enum e, std::false_type /*unused*/) noexcept { return std::error_condition(e); }
+};
+static_assert(sizeof(compact_error_code) == 4, "compact_error_code is not four bytes!");
+static_assert(std::is_trivially_copyable<compact_error_code>::value, "compact_error_code is not trivially copyable!");
+
+//! Makes `trait::has_error_code_v<compact_error_code>` true, and lets the policies throw it as a `std::system_error`.
+inline std::error_code make_error_code(compact_error_code ec) noexcept
+{
+  return ec.to_error_code();
+}
+
+namespace detail
+{
+  template <class State> constexpr inline void _set_error_is_errno(State &state, const compact_error_code &error)
+  {
+    if(error.is_errno())
+    {
+      state.set_status(state.status() | status_error_is_errno);
+    }
+  }
+}  // namespace detail
+
+namespace trait
+{
+  //! `compact_error_code` shares storage with any trivially copyable value type.
+  template <class R> struct disjoint_storage<R, compact_error_code>
+  {
+    static constexpr bool value = true;
+  };
+}  // namespace trait
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
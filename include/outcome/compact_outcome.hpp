@@ -0,0 +1,504 @@
+/* An outcome keeping its value, error and exception in one union
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_COMPACT_OUTCOME_HPP
+#define OUTCOME_COMPACT_OUTCOME_HPP
+
+#include "outcome.hpp"
+
+#include <cstdint>
+#include <new>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+/*! An `outcome<R, S, P>` which never holds an error and an exception at once, and so keeps its value,
+its error and its exception in one union next to a one byte status. `compact_outcome<int>` is 24 bytes
+where `outcome<int>` is 32 on common 64 bit ABIs, which adds up in queues holding millions of them.
+
+It is a storage format rather than a replacement for `outcome`: it has the same state observers,
+its wide observers throw what those of `outcome<R, S, P>` with the default policy would, and it converts
+explicitly to and from `outcome<R, S, P>`. Converting an `outcome` holding both an error and an exception
+keeps only the exception, which is what that outcome's `.value()` would have thrown.
+
+Copy and move assignment destroy the current state and construct the new one. They only provide
+the basic guarantee if copying or moving the new state throws, after which the compact outcome
+is empty and all of its wide observers throw `bad_outcome_access`.
+*/
+template <class R, class S = std::error_code, class P = std::exception_ptr> class compact_outcome
+{
+  static_assert(!std::is_void<S>::value && !std::is_void<P>::value, "compact_outcome needs an error type and an exception type, use result otherwise");
+  static_assert(!std::is_reference<R>::value && !std::is_reference<S>::value && !std::is_reference<P>::value, "compact_outcome cannot hold references");
+
+  template <class T, class U, class V> friend class compact_outcome;
+
+  using _value_type = detail::devoid<R>;
+  using _predicate = detail::outcome_predicates<R, S, P>;
+  using _lref = std::conditional_t<std::is_void<R>::value, void, _value_type &>;
+  using _clref = std::conditional_t<std::is_void<R>::value, void, const _value_type &>;
+  using _rref = std::conditional_t<std::is_void<R>::value, void, _value_type &&>;
+
+  static constexpr bool _nothrow_move = std::is_nothrow_move_constructible<_value_type>::value && std::is_nothrow_move_constructible<S>::value && std::is_nothrow_move_constructible<P>::value;
+  static constexpr bool _nothrow_copy = std::is_nothrow_copy_constructible<_value_type>::value && std::is_nothrow_copy_constructible<S>::value && std::is_nothrow_copy_constructible<P>::value;
+
+  static constexpr uint8_t _have_value = static_cast<uint8_t>(detail::status_have_value);
+  static constexpr uint8_t _have_error = static_cast<uint8_t>(detail::status_have_error);
+  static constexpr uint8_t _have_exception = static_cast<uint8_t>(detail::status_have_exception);
+
+  union {
+    detail::empty_type _empty;
+    _value_type _value;
+    S _error;
+    P _ptr;
+  };
+  uint8_t _status{0};
+
+  template <class T, class... Args> void _construct(T *p, uint8_t status, Args &&... args)
+  {
+    new(p) T(std::forward<Args>(args)...);
+    _status = status;
+  }
+  void _destroy() noexcept
+  {
+    switch(_status)
+    {
+    case _have_value:
+      _value.~_value_type();
+      break;
+    case _have_error:
+      _error.~S();
+      break;
+    case _have_exception:
+      _ptr.~P();
+      break;
+    default:
+      break;
+    }
+    _status = 0;
+  }
+  template <class Other> void _construct_from(Other &&o)
+  {
+    switch(o._status)
+    {
+    case _have_value:
+      _construct(&_value, _have_value, static_cast<Other &&>(o)._value);
+      break;
+    case _have_error:
+      _construct(&_error, _have_error, static_cast<Other &&>(o)._error);
+      break;
+    case _have_exception:
+      _construct(&_ptr, _have_exception, static_cast<Other &&>(o)._ptr);
+      break;
+    default:
+      break;
+    }
+  }
+  // An outcome holding both an error and an exception keeps the exception, which its .value() would throw
+  template <class Outcome> void _construct_from_outcome(Outcome &&o)
+  {
+    if(o.has_value())
+    {
+      _construct_value_from(std::is_void<R>(), static_cast<Outcome &&>(o));
+    }
+    else if(o.has_exception())
+    {
+      _construct(&_ptr, _have_exception, static_cast<Outcome &&>(o).assume_exception());
+    }
+    else if(o.has_error())
+    {
+      _construct(&_error, _have_error, static_cast<Outcome &&>(o).assume_error());
+    }
+  }
+  template <class Outcome> void _construct_value_from(std::true_type /*unused*/, Outcome && /*unused*/) { _construct(&_value, _have_value); }
+  template <class Outcome> void _construct_value_from(std::false_type /*unused*/, Outcome &&o) { _construct(&_value, _have_value, static_cast<Outcome &&>(o).assume_value()); }
+
+  // The failure as an outcome, whose policy then decides what a wide value observer throws
+  outcome<R, S, P> _failure_as_outcome() const
+  {
+    using outcome_type = outcome<R, S, P>;
+    if((_status & _have_exception) != 0)
+    {
+      return outcome_type(in_place_type<typename outcome_type::exception_type_if_enabled>, _ptr);
+    }
+    return outcome_type(in_place_type<typename outcome_type::error_type_if_enabled>, _error);
+  }
+  OUTCOME_COLD void _throw_no_value() const
+  {
+    if((_status & (_have_error | _have_exception)) != 0)
+    {
+      _failure_as_outcome().value();
+    }
+    policy::detail::throw_bad_outcome_access("no value");
+  }
+  outcome<R, S, P> _as_outcome(std::true_type /*unused*/) const { return outcome<R, S, P>(success()); }
+  outcome<R, S, P> _as_outcome(std::false_type /*unused*/) const &{ return outcome<R, S, P>(in_place_type<typename outcome<R, S, P>::value_type_if_enabled>, _value); }
+  outcome<R, S, P> _as_outcome(std::false_type /*unused*/) && { return outcome<R, S, P>(in_place_type<typename outcome<R, S, P>::value_type_if_enabled>, std::move(_value)); }
+
+  struct value_converting_constructor_tag
+  {
+  };
+  struct error_converting_constructor_tag
+  {
+  };
+  struct error_condition_converting_constructor_tag
+  {
+  };
+  struct exception_converting_constructor_tag
+  {
+  };
+  struct disable_in_place_value_type
+  {
+  };
+  struct disable_in_place_error_type
+  {
+  };
+  struct disable_in_place_exception_type
+  {
+  };
+
+public:
+  //! The success type.
+  using value_type = R;
+  //! The failure type.
+  using error_type = S;
+  //! The exception type.
+  using exception_type = P;
+
+  //! Used to disable in place type construction when `value_type` is ambiguous with `error_type` or `exception_type`.
+  using value_type_if_enabled = std::conditional_t<std::is_same<R, S>::value || std::is_same<R, P>::value, disable_in_place_value_type, R>;
+  //! Used to disable in place type construction when `error_type` is ambiguous with `value_type` or `exception_type`.
+  using error_type_if_enabled = std::conditional_t<std::is_same<S, R>::value || std::is_same<S, P>::value, disable_in_place_error_type, S>;
+  //! Used to disable in place type construction when `exception_type` is ambiguous with `value_type` or `error_type`.
+  using exception_type_if_enabled = std::conditional_t<std::is_same<P, R>::value || std::is_same<P, S>::value, disable_in_place_exception_type, P>;
+
+  //! Like `outcome`, a compact outcome is not default constructible.
+  compact_outcome() = delete;
+  //! Implicitly constructs a successful compact outcome from a `T` convertible only to `value_type`.
+  OUTCOME_TEMPLATE(class T)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(!std::is_same<std::decay_t<T>, compact_outcome>::value && _predicate::template enable_value_converting_constructor<T>))
+  compact_outcome(T &&t, value_converting_constructor_tag /*unused*/ = value_converting_constructor_tag()) noexcept(std::is_nothrow_constructible<_value_type, T>::value)  // NOLINT
+  {
+    _construct(&_value, _have_value, std::forward<T>(t));
+  }
+  //! Implicitly constructs an errored compact outcome from a `T` convertible only to `error_type`.
+  OUTCOME_TEMPLATE(class T)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(!std::is_same<std::decay_t<T>, compact_outcome>::value && _predicate::template enable_error_converting_constructor<T>))
+  compact_outcome(T &&t, error_converting_constructor_tag /*unused*/ = error_converting_constructor_tag()) noexcept(std::is_nothrow_constructible<S, T>::value)  // NOLINT
+  {
+    _construct(&_error, _have_error, std::forward<T>(t));
+  }
+  //! Implicitly constructs an errored compact outcome from an error condition enumeration, via `make_error_code()`.
+  OUTCOME_TEMPLATE(class ErrorCondEnum)
+  OUTCOME_TREQUIRES(OUTCOME_TEXPR(S(make_error_code(ErrorCondEnum()))),  //
+                    OUTCOME_TPRED(_predicate::template enable_error_condition_converting_constructor<ErrorCondEnum>))
+  compact_outcome(ErrorCondEnum &&t, error_condition_converting_constructor_tag /*unused*/ = error_condition_converting_constructor_tag()) noexcept(noexcept(S(make_error_code(std::forward<ErrorCondEnum>(t)))))  // NOLINT
+  {
+    _construct(&_error, _have_error, make_error_code(t));
+  }
+  //! Implicitly constructs an excepted compact outcome from a `T` convertible only to `exception_type`.
+  OUTCOME_TEMPLATE(class T)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(!std::is_same<std::decay_t<T>, compact_outcome>::value && _predicate::template enable_exception_converting_constructor<T>))
+  compact_outcome(T &&t, exception_converting_constructor_tag /*unused*/ = exception_converting_constructor_tag()) noexcept(std::is_nothrow_constructible<P, T>::value)  // NOLINT
+  {
+    _construct(&_ptr, _have_exception, std::forward<T>(t));
+  }
+
+  //! Constructs the value in place from `args`.
+  template <class... Args>
+  explicit compact_outcome(in_place_type_t<value_type_if_enabled> /*unused*/, Args &&... args) noexcept(std::is_nothrow_constructible<_value_type, Args...>::value)
+  {
+    _construct(&_value, _have_value, std::forward<Args>(args)...);
+  }
+  //! Constructs the error in place from `args`.
+  template <class... Args>
+  explicit compact_outcome(in_place_type_t<error_type_if_enabled> /*unused*/, Args &&... args) noexcept(std::is_nothrow_constructible<S, Args...>::value)
+  {
+    _construct(&_error, _have_error, std::forward<Args>(args)...);
+  }
+  //! Constructs the exception in place from `args`.
+  template <class... Args>
+  explicit compact_outcome(in_place_type_t<exception_type_if_enabled> /*unused*/, Args &&... args) noexcept(std::is_nothrow_constructible<P, Args...>::value)
+  {
+    _construct(&_ptr, _have_exception, std::forward<Args>(args)...);
+  }
+
+  //! Implicitly constructs a successful compact outcome from the `success()` type sugar.
+  compact_outcome(const success_type<void> & /*unused*/) noexcept(std::is_nothrow_default_constructible<_value_type>::value)  // NOLINT
+  {
+    _construct(&_value, _have_value);
+  }
+  //! Implicitly constructs a successful compact outcome from the `success(T)` type sugar.
+  OUTCOME_TEMPLATE(class T)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(!std::is_void<T>::value && std::is_constructible<_value_type, T>::value))
+  compact_outcome(success_type<T> &&o) noexcept(std::is_nothrow_constructible<_value_type, T>::value)  // NOLINT
+  {
+    _construct(&_value, _have_value, std::move(o).value());
+  }
+  //! Implicitly constructs an errored compact outcome from the `failure(T)` type sugar.
+  OUTCOME_TEMPLATE(class T)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_constructible<S, T>::value))
+  compact_outcome(failure_type<T> &&o) noexcept(std::is_nothrow_constructible<S, T>::value)  // NOLINT
+  {
+    _construct(&_error, _have_error, std::move(o).error());
+  }
+  /*! Implicitly constructs a compact outcome from the `failure(T, U)` type sugar.
+  \effects Keeps the exception if it is not default constructed, else the error.
+  */
+  OUTCOME_TEMPLATE(class T, class U)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_constructible<S, T>::value &&std::is_constructible<P, U>::value))
+  compact_outcome(failure_type<T, U> &&o) noexcept(std::is_nothrow_constructible<S, T>::value &&std::is_nothrow_constructible<P, U>::value)  // NOLINT
+  {
+    if(o.exception() != U())
+    {
+      _construct(&_ptr, _have_exception, std::move(o).exception());
+    }
+    else
+    {
+      _construct(&_error, _have_error, std::move(o).error());
+    }
+  }
+
+  //! Explicitly converts from an `outcome`. An outcome holding both an error and an exception keeps only the exception.
+  template <class NoValuePolicy> explicit compact_outcome(const outcome<R, S, P, NoValuePolicy> &o) { _construct_from_outcome(o); }
+  //! Explicitly converts from an `outcome`, moving from it. An outcome holding both an error and an exception keeps only the exception.
+  template <class NoValuePolicy> explicit compact_outcome(outcome<R, S, P, NoValuePolicy> &&o) { _construct_from_outcome(std::move(o)); }
+
+  //! Copy constructor.
+  compact_outcome(const compact_outcome &o) noexcept(_nothrow_copy) { _construct_from(o); }
+  //! Move constructor.
+  compact_outcome(compact_outcome &&o) noexcept(_nothrow_move) { _construct_from(std::move(o)); }  // NOLINT
+  //! Copy assignment. See the class description for the exception guarantee.
+  compact_outcome &operator=(const compact_outcome &o) noexcept(_nothrow_copy)
+  {
+    if(this != &o)
+    {
+      _destroy();
+      _construct_from(o);
+    }
+    return *this;
+  }
+  //! Move assignment. See the class description for the exception guarantee.
+  compact_outcome &operator=(compact_outcome &&o) noexcept(_nothrow_move)  // NOLINT
+  {
+    if(this != &o)
+    {
+      _destroy();
+      _construct_from(std::move(o));
+    }
+    return *this;
+  }
+  //! Destructor.
+  ~compact_outcome() { _destroy(); }
+
+  //! Swaps with another compact outcome.
+  void swap(compact_outcome &o) noexcept(_nothrow_move)
+  {
+    compact_outcome t(std::move(o));
+    o = std::move(*this);
+    *this = std::move(t);
+  }
+  //! Swaps two compact outcomes.
+  friend void swap(compact_outcome &a, compact_outcome &b) noexcept(noexcept(a.swap(b))) { a.swap(b); }
+
+  //! True if successful.
+  constexpr explicit operator bool() const noexcept { return (_status & _have_value) != 0; }
+  //! True if successful.
+  constexpr bool has_value() const noexcept { return (_status & _have_value) != 0; }
+  //! True if errored.
+  constexpr bool has_error() const noexcept { return (_status & _have_error) != 0; }
+  //! True if excepted.
+  constexpr bool has_exception() const noexcept { return (_status & _have_exception) != 0; }
+  //! True if errored or excepted.
+  constexpr bool has_failure() const noexcept { return (_status & (_have_error | _have_exception)) != 0; }
+
+  /*! Access the value without runtime checks.
+  \requires `has_value()` to be true, else undefined behaviour.
+  \group assume_value
+  */
+  _lref assume_value() & noexcept { return static_cast<_lref>(_value); }
+  /// \group assume_value
+  _clref assume_value() const &noexcept { return static_cast<_clref>(_value); }
+  /// \group assume_value
+  _rref assume_value() && noexcept { return static_cast<_rref>(_value); }
+  /*! Access the value, throwing what `outcome<R, S, P>::value()` would if there is none.
+  \group value
+  */
+  _lref value() &
+  {
+    if(OUTCOME_UNLIKELY(!has_value()))
+    {
+      _throw_no_value();
+    }
+    return static_cast<_lref>(_value);
+  }
+  /// \group value
+  _clref value() const &
+  {
+    if(OUTCOME_UNLIKELY(!has_value()))
+    {
+      _throw_no_value();
+    }
+    return static_cast<_clref>(_value);
+  }
+  /// \group value
+  _rref value() &&
+  {
+    if(OUTCOME_UNLIKELY(!has_value()))
+    {
+      _throw_no_value();
+    }
+    return static_cast<_rref>(_value);
+  }
+
+  /*! Access the error without runtime checks.
+  \requires `has_error()` to be true, else undefined behaviour.
+  \group assume_error
+  */
+  S &assume_error() & noexcept { return _error; }
+  /// \group assume_error
+  const S &assume_error() const &noexcept { return _error; }
+  /// \group assume_error
+  S &&assume_error() && noexcept { return std::move(_error); }
+  /*! Access the error, throwing `bad_outcome_access` if there is none.
+  \group error
+  */
+  S &error() &
+  {
+    if(OUTCOME_UNLIKELY(!has_error()))
+    {
+      policy::detail::throw_bad_outcome_access("no error");
+    }
+    return _error;
+  }
+  /// \group error
+  const S &error() const &
+  {
+    if(OUTCOME_UNLIKELY(!has_error()))
+    {
+      policy::detail::throw_bad_outcome_access("no error");
+    }
+    return _error;
+  }
+  /// \group error
+  S &&error() && { return std::move(error()); }
+
+  /*! Access the exception without runtime checks.
+  \requires `has_exception()` to be true, else undefined behaviour.
+  \group assume_exception
+  */
+  P &assume_exception() & noexcept { return _ptr; }
+  /// \group assume_exception
+  const P &assume_exception() const &noexcept { return _ptr; }
+  /// \group assume_exception
+  P &&assume_exception() && noexcept { return std::move(_ptr); }
+  /*! Access the exception, throwing `bad_outcome_access` if there is none.
+  \group exception
+  */
+  P &exception() &
+  {
+    if(OUTCOME_UNLIKELY(!has_exception()))
+    {
+      policy::detail::throw_bad_outcome_access("no exception");
+    }
+    return _ptr;
+  }
+  /// \group exception
+  const P &exception() const &
+  {
+    if(OUTCOME_UNLIKELY(!has_exception()))
+    {
+      policy::detail::throw_bad_outcome_access("no exception");
+    }
+    return _ptr;
+  }
+  /// \group exception
+  P &&exception() && { return std::move(exception()); }
+
+  /*! The failure as type sugar, for the `OUTCOME_TRY` macros. Whichever of the error and the exception
+  is not held is default constructed.
+  \group as_failure
+  */
+  failure_type<S, P> as_failure() const &{ return has_exception() ? failure_type<S, P>(S(), _ptr) : failure_type<S, P>(_error, P()); }
+  /// \group as_failure
+  failure_type<S, P> as_failure() && { return has_exception() ? failure_type<S, P>(S(), std::move(_ptr)) : failure_type<S, P>(std::move(_error), P()); }
+
+  /*! Converts to an `outcome` with the default policy.
+  \group as_outcome
+  */
+  outcome<R, S, P> as_outcome() const &
+  {
+    if(has_value())
+    {
+      return _as_outcome(std::is_void<R>());
+    }
+    if(has_failure())
+    {
+      return _failure_as_outcome();
+    }
+    policy::detail::throw_bad_outcome_access("empty");
+  }
+  /// \group as_outcome
+  outcome<R, S, P> as_outcome() &&
+  {
+    using outcome_type = outcome<R, S, P>;
+    if(has_value())
+    {
+      return std::move(*this)._as_outcome(std::is_void<R>());
+    }
+    if(has_exception())
+    {
+      return outcome_type(in_place_type<typename outcome_type::exception_type_if_enabled>, std::move(_ptr));
+    }
+    if(has_error())
+    {
+      return outcome_type(in_place_type<typename outcome_type::error_type_if_enabled>, std::move(_error));
+    }
+    policy::detail::throw_bad_outcome_access("empty");
+  }
+
+  //! True if both are in the same state, and what they hold compares equal.
+  template <class T, class U, class V> bool operator==(const compact_outcome<T, U, V> &o) const
+  {
+    if(_status != o._status)
+    {
+      return false;
+    }
+    switch(_status)
+    {
+    case _have_value:
+      return detail::safe_compare_equal(_value, o._value);
+    case _have_error:
+      return detail::safe_compare_equal(_error, o._error);
+    case _have_exception:
+      return detail::safe_compare_equal(_ptr, o._ptr);
+    default:
+      return true;
+    }
+  }
+  //! True if not equal.
+  template <class T, class U, class V> bool operator!=(const compact_outcome<T, U, V> &o) const { return !(*this == o); }
+};
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -62,15 +62,127 @@ If you are not redirected automatically, follow this link to <a href='https://ne
 */
 #endif
 
+#ifdef STANDARDESE_IS_IN_THE_HOUSE
+/*! Define to handle `boost::system::error_code` natively. Its errno domain is detected without
+converting it to `std::error_code`, the policies which throw a system error throw
+`boost::system::system_error`, and `error_from_exception()` matches `boost::system::system_error`.
+Requires the Boost.System headers. The Boost edition of Outcome defines this by default.
+*/
+#define OUTCOME_ENABLE_BOOST_SYSTEM
+#undef OUTCOME_ENABLE_BOOST_SYSTEM
+/*! Define to use an eight bit status in `result` and `outcome` instead of thirty-two bits. This
+removes the sixteen bits of spare storage, and can save between three and eight bytes per object
+depending on alignment. The layout is not ABI compatible with the default, so it uses a distinct
+namespace.
+*/
+#define OUTCOME_ENABLE_COMPACT_STATUS
+#undef OUTCOME_ENABLE_COMPACT_STATUS
+/*! Define to make the storage of trivially copyable types in `result` and `outcome` trivially default
+constructible. The all bits zero state is then defined to be empty, i.e. neither valued nor errored,
+so `calloc()` or `mmap()` allocated arrays of `result<int>` need no per element construction. Niche
+packed and disjoint storage are unaffected. The layout is unchanged, so this is ABI compatible.
+*/
+#define OUTCOME_ENABLE_TRIVIAL_STORAGE
+#undef OUTCOME_ENABLE_TRIVIAL_STORAGE
+/*! Define to count the attempts and propagated failures of every TRY operation per call site, in
+per thread tables which `try_counters::snapshot()` sums and ranks. Off by default, when the TRY
+operations are unchanged.
+*/
+#define OUTCOME_ENABLE_TRY_COUNTERS
+#undef OUTCOME_ENABLE_TRY_COUNTERS
+/*! Define to build `result<T, E>` for custom `E` only, without `<system_error>` or `<exception>`.
+`E` has no default, `std::error_code` and `std::exception_ptr` get no special handling, the
+policies which throw are unavailable, and `policy::terminate` calls `std::abort()`. Defined by
+`result_lite.hpp`, which `single-header/result-lite.hpp` is preprocessed from.
+*/
+#define OUTCOME_RESULT_LITE
+#undef OUTCOME_RESULT_LITE
+#endif
+
 #ifndef OUTCOME_SYMBOL_VISIBLE
 #define OUTCOME_SYMBOL_VISIBLE QUICKCPPLIB_SYMBOL_VISIBLE
 #endif
 #ifndef OUTCOME_NODISCARD
 #define OUTCOME_NODISCARD QUICKCPPLIB_NODISCARD
 #endif
+#ifndef OUTCOME_NO_UNIQUE_ADDRESS
+#ifdef __has_cpp_attribute
+#if __has_cpp_attribute(no_unique_address)
+#define OUTCOME_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+#endif
+#if !defined(OUTCOME_NO_UNIQUE_ADDRESS) && defined(_MSC_VER) && _MSC_VER >= 1929
+#define OUTCOME_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#endif
+#ifndef OUTCOME_NO_UNIQUE_ADDRESS
+#define OUTCOME_NO_UNIQUE_ADDRESS
+#endif
+#endif
 #ifndef OUTCOME_THREAD_LOCAL
 #define OUTCOME_THREAD_LOCAL QUICKCPPLIB_THREAD_LOCAL
 #endif
+/* Under CUDA and HIP, constexpr functions are callable from device code, which covers almost all of
+`result` (nvcc needs `--expt-relaxed-constexpr` for this, clang does it by default). The few
+functions on its trivial storage path which are not constexpr are marked OUTCOME_HOST_DEVICE.
+*/
+#ifndef OUTCOME_HOST_DEVICE
+#if defined(__CUDACC__) || defined(__HIPCC__)
+//! Marks a function which is not constexpr as callable from both host and device code.
+#define OUTCOME_HOST_DEVICE __host__ __device__
+#else
+#define OUTCOME_HOST_DEVICE
+#endif
+#endif
+#if defined(__CUDA_ARCH__) || defined(__HIP_DEVICE_COMPILE__)
+//! Defined during the device side compilation of CUDA or HIP.
+#define OUTCOME_DEVICE_COMPILE 1
+#endif
+#ifndef OUTCOME_CONSTEXPR20
+#if defined(__cpp_constexpr_dynamic_alloc) && __cpp_constexpr_dynamic_alloc >= 201907L
+//! Defined if `result` and `outcome` with non-trivial types are usable in constant evaluation.
+#define OUTCOME_HAVE_CONSTEXPR20_STORAGE 1
+#define OUTCOME_CONSTEXPR20 constexpr
+#else
+#define OUTCOME_CONSTEXPR20 OUTCOME_HOST_DEVICE
+#endif
+#endif
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+//! Defined if `__builtin_is_constant_evaluated()` is available whatever the language standard.
+#define OUTCOME_HAVE_BUILTIN_IS_CONSTANT_EVALUATED 1
+#endif
+#endif
+/* Where the compiler has C++ 20 concepts and a conforming preprocessor, the constraints are standard
+requires clauses, which are cheaper in overload resolution than the enable_if default template
+arguments quickcpplib otherwise expands them into. Define OUTCOME_DISABLE_CXX20_CONCEPTS to opt out.
+*/
+#if !defined(OUTCOME_TEMPLATE) && !defined(OUTCOME_DISABLE_CXX20_CONCEPTS) && defined(__cpp_concepts) && __cpp_concepts >= 201907L && (!defined(_MSC_VER) || (defined(_MSVC_TRADITIONAL) && !_MSVC_TRADITIONAL))
+//! Defined if the constraints are C++ 20 requires clauses.
+#define OUTCOME_HAVE_CXX20_CONCEPTS 1
+#define OUTCOME_TEMPLATE(...) template <__VA_ARGS__
+#define OUTCOME_TREQUIRES(...) > requires OUTCOME_TREQUIRES_SELECT(__VA_ARGS__, OUTCOME_TREQUIRES_AND8, OUTCOME_TREQUIRES_AND7, OUTCOME_TREQUIRES_AND6, OUTCOME_TREQUIRES_AND5, OUTCOME_TREQUIRES_AND4, OUTCOME_TREQUIRES_AND3, OUTCOME_TREQUIRES_AND2, OUTCOME_TREQUIRES_AND1, )(__VA_ARGS__)
+#define OUTCOME_TEXPR(...) (requires { __VA_ARGS__; })
+#define OUTCOME_TPRED(...) (__VA_ARGS__)
+#define OUTCOME_REQUIRES(...) requires __VA_ARGS__
+//! \exclude
+#define OUTCOME_TREQUIRES_SELECT(_1, _2, _3, _4, _5, _6, _7, _8, and_n, ...) and_n
+//! \exclude
+#define OUTCOME_TREQUIRES_AND1(a) a
+//! \exclude
+#define OUTCOME_TREQUIRES_AND2(a, b) a &&b
+//! \exclude
+#define OUTCOME_TREQUIRES_AND3(a, b, c) a &&b &&c
+//! \exclude
+#define OUTCOME_TREQUIRES_AND4(a, b, c, d) a &&b &&c &&d
+//! \exclude
+#define OUTCOME_TREQUIRES_AND5(a, b, c, d, e) a &&b &&c &&d &&e
+//! \exclude
+#define OUTCOME_TREQUIRES_AND6(a, b, c, d, e, f) a &&b &&c &&d &&e &&f
+//! \exclude
+#define OUTCOME_TREQUIRES_AND7(a, b, c, d, e, f, g) a &&b &&c &&d &&e &&f &&g
+//! \exclude
+#define OUTCOME_TREQUIRES_AND8(a, b, c, d, e, f, g, h) a &&b &&c &&d &&e &&f &&g &&h
+#endif
 #ifndef OUTCOME_TEMPLATE
 #define OUTCOME_TEMPLATE(...) QUICKCPPLIB_TEMPLATE(__VA_ARGS__)
 #endif
@@ -118,9 +230,15 @@ exported Outcome v2 namespace.
 #define OUTCOME_V2_NAMESPACE_END }
 #else
 
-#if defined(OUTCOME_UNSTABLE_VERSION)
+// The compact status layout is not ABI compatible, so give it its own namespace
+#if defined(OUTCOME_UNSTABLE_VERSION) && defined(OUTCOME_ENABLE_COMPACT_STATUS)
+#include "revision.hpp"
+#define OUTCOME_V2 (QUICKCPPLIB_BIND_NAMESPACE_VERSION(outcome_v2, OUTCOME_PREVIOUS_COMMIT_UNIQUE, compact))
+#elif defined(OUTCOME_UNSTABLE_VERSION)
 #include "revision.hpp"
 #define OUTCOME_V2 (QUICKCPPLIB_BIND_NAMESPACE_VERSION(outcome_v2, OUTCOME_PREVIOUS_COMMIT_UNIQUE))
+#elif defined(OUTCOME_ENABLE_COMPACT_STATUS)
+#define OUTCOME_V2 (QUICKCPPLIB_BIND_NAMESPACE_VERSION(outcome_v2, compact))
 #else
 #define OUTCOME_V2 (QUICKCPPLIB_BIND_NAMESPACE_VERSION(outcome_v2))
 #endif
@@ -138,6 +256,50 @@ exported Outcome v2 namespace.
 #endif
 #endif
 
+#ifndef OUTCOME_COLD
+#if defined(__GNUC__) || defined(__clang__)
+//! Marks a function as rarely called and never inlined, so its callers stay small.
+#define OUTCOME_COLD __attribute__((cold, noinline))
+#elif defined(_MSC_VER)
+#define OUTCOME_COLD __declspec(noinline)
+#else
+#define OUTCOME_COLD
+#endif
+#endif
+#ifndef OUTCOME_LIKELY
+#if defined(__GNUC__) || defined(__clang__)
+//! Hints that the boolean expression is usually true.
+#define OUTCOME_LIKELY(expr) (__builtin_expect(!!(expr), true))
+//! Hints that the boolean expression is usually false.
+#define OUTCOME_UNLIKELY(expr) (__builtin_expect(!!(expr), false))
+#else
+#define OUTCOME_LIKELY(expr) (expr)
+#define OUTCOME_UNLIKELY(expr) (expr)
+#endif
+#endif
+#ifndef OUTCOME_ASSUME
+#if defined(__clang__)
+/*! Tells the optimiser that the boolean expression is always true. It must be free of side effects, as
+it is evaluated by GCC before 13, where this branches to `__builtin_unreachable()` if it is false.
+It is not evaluated by other compilers.
+*/
+#define OUTCOME_ASSUME(expr) __builtin_assume(expr)
+#elif defined(_MSC_VER)
+#define OUTCOME_ASSUME(expr) __assume(expr)
+#elif defined(__GNUC__) && __GNUC__ >= 13
+#define OUTCOME_ASSUME(expr) __attribute__((assume(expr)))
+#elif defined(__GNUC__)
+#define OUTCOME_ASSUME(expr)                                                                                                                                                                                                                                                                                                   \
+  do                                                                                                                                                                                                                                                                                                                           \
+  {                                                                                                                                                                                                                                                                                                                            \
+    if(!(expr))                                                                                                                                                                                                                                                                                                                \
+      __builtin_unreachable();                                                                                                                                                                                                                                                                                                 \
+  } while(0)
+#else
+#define OUTCOME_ASSUME(expr) ((void) 0)
+#endif
+#endif
+
 #ifndef OUTCOME_THROW_EXCEPTION
 #ifdef __cpp_exceptions
 #define OUTCOME_THROW_EXCEPTION(expr) throw expr
@@ -153,7 +315,7 @@ exported Outcome v2 namespace.
 OUTCOME_V2_NAMESPACE_BEGIN
 namespace detail
 {
-  QUICKCPPLIB_NORETURN inline void do_fatal_exit(const char *expr)
+  QUICKCPPLIB_NORETURN OUTCOME_COLD inline void do_fatal_exit(const char *expr)
   {
 #if !defined(__ANDROID__)
     void *bt[16];
@@ -27,12 +27,41 @@ http://www.boost.org/LICENSE_1_0.txt)
 
 #include "detail/result_storage.hpp"
 
+#if defined(__cpp_concepts) && __cpp_concepts >= 201907L
+#include <concepts>  // for std::convertible_to
+#endif
+
 OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
 
 //! Namespace for injected convertibility
 namespace convert
 {
-#if defined(__cpp_concepts)
+#if defined(__cpp_concepts) && __cpp_concepts >= 201907L
+  /* The `ValueOrNone` concept.
+  \requires That `U::value_type` exists and that `std::declval<U>().has_value()` returns a `bool` and `std::declval<U>().value()` exists.
+  */
+  template <class U> concept ValueOrNone = requires(U a)
+  {
+    {
+      a.has_value()
+    }
+    ->std::convertible_to<bool>;
+    {a.value()};
+  };
+  /* The `ValueOrError` concept.
+  \requires That `U::value_type` and `U::error_type` exist;
+  that `std::declval<U>().has_value()` returns a `bool`, `std::declval<U>().value()` and  `std::declval<U>().error()` exists.
+  */
+  template <class U> concept ValueOrError = requires(U a)
+  {
+    {
+      a.has_value()
+    }
+    ->std::convertible_to<bool>;
+    {a.value()};
+    {a.error()};
+  };
+#elif defined(__cpp_concepts)
   /* The `ValueOrNone` concept.
   \requires That `U::value_type` exists and that `std::declval<U>().has_value()` returns a `bool` and `std::declval<U>().value()` exists.
   */
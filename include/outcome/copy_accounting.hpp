@@ -0,0 +1,149 @@
+/* A hook policy which counts copies, moves and destructions per type
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_COPY_ACCOUNTING_HPP
+#define OUTCOME_COPY_ACCOUNTING_HPP
+
+#include "policy/hooks.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+//! The copies, moves and destructions counted by `policy::copy_accounting` for one value type.
+struct copy_account
+{
+  //! The name of the value type, as spelled by the compiler in a function signature.
+  const char *type;
+  std::atomic<uint64_t> copy_constructions{0};
+  std::atomic<uint64_t> move_constructions{0};
+  std::atomic<uint64_t> copy_assignments{0};
+  std::atomic<uint64_t> move_assignments{0};
+  std::atomic<uint64_t> destructions{0};
+  const copy_account *next{nullptr};
+
+  explicit copy_account(const char *_type) noexcept
+      : type(_type)
+  {
+  }
+  copy_account(const copy_account &) = delete;
+  copy_account &operator=(const copy_account &) = delete;
+};
+
+//! A snapshot of a `copy_account`, as returned by `copy_accounts()`.
+struct copy_account_counts
+{
+  const char *type;
+  uint64_t copy_constructions, move_constructions, copy_assignments, move_assignments, destructions;
+
+  //! The number of copies, constructions and assignments, which are the candidates for being moves.
+  uint64_t copies() const noexcept { return copy_constructions + copy_assignments; }
+};
+
+namespace detail
+{
+  template <class T> inline const char *copy_account_type_name() noexcept
+  {
+#ifdef _MSC_VER
+    return __FUNCSIG__;
+#else
+    return __PRETTY_FUNCTION__;
+#endif
+  }
+  // The list of every account, pushed to once per value type without locking
+  inline std::atomic<const copy_account *> &copy_account_head() noexcept
+  {
+    static std::atomic<const copy_account *> v{nullptr};
+    return v;
+  }
+  inline const copy_account *copy_account_register(copy_account *account) noexcept
+  {
+    auto &head = copy_account_head();
+    const copy_account *next = head.load(std::memory_order_relaxed);
+    do
+    {
+      account->next = next;
+    } while(!head.compare_exchange_weak(next, account, std::memory_order_release, std::memory_order_relaxed));
+    return account;
+  }
+  template <class T> struct copy_account_of
+  {
+    static copy_account &get() noexcept
+    {
+      static copy_account v(copy_account_type_name<T>());
+      static const copy_account *registered = copy_account_register(&v);
+      (void) registered;
+      return v;
+    }
+  };
+  inline void copy_account_bump(std::atomic<uint64_t> &c) noexcept { c.fetch_add(1, std::memory_order_relaxed); }
+}  // namespace detail
+
+//! The account of value type `T`, which must be the `value_type` of the results it counts.
+template <class T> inline copy_account &copy_account_of() noexcept
+{
+  return detail::copy_account_of<T>::get();
+}
+
+//! Snapshots every account, those with the most copies first.
+inline std::vector<copy_account_counts> copy_accounts()
+{
+  std::vector<copy_account_counts> ret;
+  for(const copy_account *a = detail::copy_account_head().load(std::memory_order_acquire); a != nullptr; a = a->next)
+  {
+    ret.push_back(copy_account_counts{a->type, a->copy_constructions.load(std::memory_order_relaxed), a->move_constructions.load(std::memory_order_relaxed), a->copy_assignments.load(std::memory_order_relaxed), a->move_assignments.load(std::memory_order_relaxed), a->destructions.load(std::memory_order_relaxed)});
+  }
+  std::stable_sort(ret.begin(), ret.end(), [](const copy_account_counts &a, const copy_account_counts &b) { return a.copies() > b.copies(); });
+  return ret;
+}
+
+namespace policy
+{
+  /*! Hook policy which counts the copies, moves and destructions of results and outcomes by
+  their value type, so that types being copied where they could be moved stand out. Use as
+  `result<T, E, with_hooks<Policy, copy_accounting>>`, and read the counts with `copy_accounts()`.
+
+  Counting is a relaxed atomic increment, and results using it are no longer trivially
+  copyable nor destructible, so this is for hunting allocation churn rather than for production.
+  */
+  struct copy_accounting : no_hooks
+  {
+    static constexpr bool has_lifetime_hooks = true;
+
+    template <class T, class U> static void on_copy_construction(T * /*unused*/, U && /*unused*/) noexcept { OUTCOME_V2_NAMESPACE::detail::copy_account_bump(copy_account_of<typename T::value_type>().copy_constructions); }
+    template <class T, class U> static void on_move_construction(T * /*unused*/, U && /*unused*/) noexcept { OUTCOME_V2_NAMESPACE::detail::copy_account_bump(copy_account_of<typename T::value_type>().move_constructions); }
+    template <class T, class U> static void on_copy_assignment(T * /*unused*/, U && /*unused*/) noexcept { OUTCOME_V2_NAMESPACE::detail::copy_account_bump(copy_account_of<typename T::value_type>().copy_assignments); }
+    template <class T, class U> static void on_move_assignment(T * /*unused*/, U && /*unused*/) noexcept { OUTCOME_V2_NAMESPACE::detail::copy_account_bump(copy_account_of<typename T::value_type>().move_assignments); }
+    template <class T> static void on_destruction(T * /*unused*/) noexcept { OUTCOME_V2_NAMESPACE::detail::copy_account_bump(copy_account_of<typename T::value_type>().destructions); }
+  };
+}  // namespace policy
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,534 @@
+/* Coroutine task types which co_await results like OUTCOME_TRY
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_COROUTINE_SUPPORT_HPP
+#define OUTCOME_COROUTINE_SUPPORT_HPP
+
+#include "result.hpp"
+#include "try.hpp"
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#include <cstddef>  // for max_align_t
+#include <iterator>
+#include <optional>
+
+//! Defined to 1 if the `awaitables` namespace is available.
+#define OUTCOME_HAVE_COROUTINE_SUPPORT 1
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+/*! Namespace for coroutine task types returning a `result` or `outcome`.
+
+Within these tasks `co_await` on a `result` or `outcome` behaves like `OUTCOME_TRY`: it becomes the
+unwrapped value if there is one, else it ends the coroutine with the failure as the task's return
+value, without throwing. `co_await` on another task becomes that task's return value. Completion
+resumes the awaiting coroutine by symmetric transfer, so deep chains do not grow the stack.
+
+Tasks are not thread safe. An `eager` task may be awaited only after it has completed, or from the
+thread which will complete it. Frames are allocated by the `frame_allocator` current for the calling
+thread, if any. Where the compiler elides the allocation of a frame, no allocator is called.
+*/
+namespace awaitables
+{
+  template <class T> class lazy;
+  template <class T> class eager;
+
+  /*! Interface for allocators of coroutine frames of the task types. The allocator current for this
+  thread when a task is called allocates its frame, and the frame remembers which allocator to return
+  itself to, so that may be done from any other scope.
+  */
+  class frame_allocator
+  {
+  public:
+    //! Allocates `bytes` aligned to `alignof(std::max_align_t)`.
+    virtual void *allocate(size_t bytes) = 0;
+    //! Deallocates `p`, which was returned by `allocate(bytes)`.
+    virtual void deallocate(void *p, size_t bytes) noexcept = 0;
+
+  protected:
+    frame_allocator() = default;
+    frame_allocator(const frame_allocator &) = default;
+    frame_allocator(frame_allocator &&) = default;
+    frame_allocator &operator=(const frame_allocator &) = default;
+    frame_allocator &operator=(frame_allocator &&) = default;
+    ~frame_allocator() = default;
+  };
+
+  namespace detail
+  {
+    inline frame_allocator *&current_frame_allocator() noexcept
+    {
+      static thread_local frame_allocator *v;
+      return v;
+    }
+  }  // namespace detail
+
+  //! The allocator of coroutine frames current for this thread, or null if frames come from `operator new`.
+  inline frame_allocator *current_frame_allocator() noexcept
+  {
+    return detail::current_frame_allocator();
+  }
+
+  //! Makes an allocator current for this thread until the end of the scope.
+  class frame_allocator_scope
+  {
+    frame_allocator *_prev;
+
+  public:
+    explicit frame_allocator_scope(frame_allocator &a) noexcept : _prev(detail::current_frame_allocator()) { detail::current_frame_allocator() = &a; }
+    frame_allocator_scope(const frame_allocator_scope &) = delete;
+    frame_allocator_scope(frame_allocator_scope &&) = delete;
+    frame_allocator_scope &operator=(const frame_allocator_scope &) = delete;
+    frame_allocator_scope &operator=(frame_allocator_scope &&) = delete;
+    ~frame_allocator_scope() { detail::current_frame_allocator() = _prev; }
+  };
+
+  /*! A frame allocator which keeps deallocated frames of up to `block_size` bytes on a free list for
+  reuse. Larger frames come from `operator new`. Not thread safe, and it must outlive all frames it
+  allocated.
+  */
+  class frame_pool final : public frame_allocator
+  {
+    struct _free_block
+    {
+      _free_block *next;
+    };
+    size_t _block_size;
+    _free_block *_free{nullptr};
+
+  public:
+    //! Constructs a pool of blocks of `block_size` bytes.
+    explicit frame_pool(size_t block_size = 1024) noexcept : _block_size(block_size < sizeof(_free_block) ? sizeof(_free_block) : block_size) {}
+    frame_pool(const frame_pool &) = delete;
+    frame_pool(frame_pool &&) = delete;
+    frame_pool &operator=(const frame_pool &) = delete;
+    frame_pool &operator=(frame_pool &&) = delete;
+    ~frame_pool()
+    {
+      while(_free != nullptr)
+      {
+        _free_block *next = _free->next;
+        ::operator delete(_free);
+        _free = next;
+      }
+    }
+
+    void *allocate(size_t bytes) override
+    {
+      if(bytes > _block_size)
+      {
+        return ::operator new(bytes);
+      }
+      if(_free != nullptr)
+      {
+        _free_block *ret = _free;
+        _free = ret->next;
+        return ret;
+      }
+      return ::operator new(_block_size);
+    }
+    void deallocate(void *p, size_t bytes) noexcept override
+    {
+      if(bytes > _block_size)
+      {
+        ::operator delete(p);
+        return;
+      }
+      auto *b = static_cast<_free_block *>(p);
+      b->next = _free;
+      _free = b;
+    }
+  };
+
+  namespace detail
+  {
+    // Frames are prefixed by the allocator which allocated them
+    static constexpr size_t frame_header_size = (sizeof(frame_allocator *) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+    struct frame_allocation
+    {
+      static void *operator new(size_t bytes)
+      {
+        frame_allocator *a = current_frame_allocator();
+        void *p = (a != nullptr) ? a->allocate(bytes + frame_header_size) : ::operator new(bytes + frame_header_size);
+        *static_cast<frame_allocator **>(p) = a;
+        return static_cast<char *>(p) + frame_header_size;
+      }
+      static void operator delete(void *p, size_t bytes) noexcept
+      {
+        void *base = static_cast<char *>(p) - frame_header_size;
+        frame_allocator *a = *static_cast<frame_allocator **>(base);
+        if(a != nullptr)
+        {
+          a->deallocate(base, bytes + frame_header_size);
+        }
+        else
+        {
+          ::operator delete(base);
+        }
+      }
+    };
+
+    // Anything which OUTCOME_TRY can propagate into a T
+    template <class A, class T>
+    concept try_awaitable = requires(A &&a)
+    {
+      {a.has_value()};
+      {a.as_failure()};
+      {OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<A &&>(a))};
+    }
+    &&std::is_convertible<decltype(OUTCOME_V2_NAMESPACE::try_operation_return_as(std::declval<A>())), T>::value;
+
+    template <class T, bool Eager> struct task_promise;
+
+    template <class Promise, class A> struct try_awaiter
+    {
+      A &&_v;
+
+      bool await_ready() noexcept { return OUTCOME_LIKELY(_v.has_value()); }
+      std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h)
+      {
+        // Short circuit: the failure becomes the return value, and this frame is never resumed
+        return h.promise()._fail(OUTCOME_V2_NAMESPACE::try_operation_return_as(static_cast<A &&>(_v)));
+      }
+      decltype(auto) await_resume() { return OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<A &&>(_v)); }
+    };
+
+    template <class T, bool Eager> struct task_promise : frame_allocation
+    {
+      using task_type = std::conditional_t<Eager, eager<T>, lazy<T>>;
+      using handle_type = std::coroutine_handle<task_promise>;
+
+      std::optional<T> _result;
+      std::coroutine_handle<> _continuation;
+      bool _done{false};
+
+      // Where to go once this coroutine has finished
+      std::coroutine_handle<> _complete() noexcept
+      {
+        _done = true;
+        return _continuation ? _continuation : std::noop_coroutine();
+      }
+      template <class F> std::coroutine_handle<> _fail(F &&f)
+      {
+        _result.emplace(std::forward<F>(f));
+        return _complete();
+      }
+
+      struct final_awaiter
+      {
+        bool await_ready() noexcept { return false; }
+        std::coroutine_handle<> await_suspend(handle_type h) noexcept { return h.promise()._complete(); }
+        void await_resume() noexcept {}
+      };
+
+      task_type get_return_object() noexcept { return task_type(handle_type::from_promise(*this)); }
+      auto initial_suspend() noexcept
+      {
+        if constexpr(Eager)
+        {
+          return std::suspend_never{};
+        }
+        else
+        {
+          return std::suspend_always{};
+        }
+      }
+      final_awaiter final_suspend() noexcept { return {}; }
+      template <class U> void return_value(U &&v) { _result.emplace(std::forward<U>(v)); }
+      void unhandled_exception()
+      {
+#ifdef __cpp_exceptions
+        if constexpr(std::is_constructible<T, std::exception_ptr>::value)
+        {
+          _result.emplace(std::current_exception());
+        }
+        else
+        {
+          throw;
+        }
+#endif
+      }
+
+      template <class A>
+      requires try_awaitable<A, T> try_awaiter<task_promise, A> await_transform(A &&a) noexcept { return {static_cast<A &&>(a)}; }
+      template <class A>
+      requires(!try_awaitable<A, T>) A &&await_transform(A &&a) noexcept { return static_cast<A &&>(a); }
+    };
+
+    template <class T, bool Eager> class task
+    {
+    public:
+      using promise_type = task_promise<T, Eager>;
+
+    protected:
+      using _handle_type = std::coroutine_handle<promise_type>;
+      _handle_type _h;
+
+      explicit task(_handle_type h) noexcept : _h(h) {}
+
+    public:
+      task(const task &) = delete;
+      task(task &&o) noexcept : _h(o._h) { o._h = nullptr; }
+      task &operator=(const task &) = delete;
+      task &operator=(task &&o) noexcept
+      {
+        if(this != &o)
+        {
+          this->~task();
+          new(this) task(std::move(o));
+        }
+        return *this;
+      }
+      ~task()
+      {
+        if(_h)
+        {
+          _h.destroy();
+        }
+      }
+
+      //! True if the task has run to completion, or has been short circuited by a failure.
+      bool ready() const noexcept { return _h && _h.promise()._done; }
+
+      struct awaiter
+      {
+        _handle_type _h;
+
+        bool await_ready() noexcept { return _h.promise()._done; }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) noexcept
+        {
+          _h.promise()._continuation = continuation;
+          if constexpr(Eager)
+          {
+            // Already running, it resumes us when it finishes
+            return std::noop_coroutine();
+          }
+          else
+          {
+            return _h;
+          }
+        }
+        T await_resume() { return std::move(*_h.promise()._result); }
+      };
+      //! Suspends the awaiting coroutine until the task has a return value, which becomes the value of the `co_await`.
+      awaiter operator co_await() && noexcept { return awaiter{_h}; }
+
+      /*! Returns the task's return value, first running it if it is lazy and not yet started.
+      \requires That the task does not suspend on anything other than results and other tasks, so it
+      completes on this thread before this returns.
+      */
+      T get() &&
+      {
+        if(!_h.promise()._done)
+        {
+          _h.resume();
+        }
+        return std::move(*_h.promise()._result);
+      }
+    };
+  }  // namespace detail
+
+  /*! A coroutine task returning `T`, a `result` or `outcome`, which does not begin to run until it is awaited.
+   */
+  template <class T> class lazy : public detail::task<T, false>
+  {
+    friend struct detail::task_promise<T, false>;
+    using detail::task<T, false>::task;
+  };
+
+  /*! A coroutine task returning `T`, a `result` or `outcome`, which begins to run immediately it is called.
+   */
+  template <class T> class eager : public detail::task<T, true>
+  {
+    friend struct detail::task_promise<T, true>;
+    using detail::task<T, true>::task;
+  };
+
+  template <class T> class generator;
+
+  namespace detail
+  {
+    template <class T> struct generator_promise : frame_allocation
+    {
+      using value_type = typename T::value_type;
+      using error_type = typename T::error_type;
+      using terminal_type = result<void, error_type>;
+      using handle_type = std::coroutine_handle<generator_promise>;
+      static_assert(!std::is_void<value_type>::value, "generator does not support a void value type");
+
+      // Points at the value most recently yielded, which lives in the coroutine frame
+      value_type *_current{nullptr};
+      std::optional<value_type> _copy;
+      std::optional<terminal_type> _terminal;
+
+      generator<T> get_return_object() noexcept { return generator<T>(handle_type::from_promise(*this)); }
+      std::suspend_always initial_suspend() noexcept { return {}; }
+      std::suspend_always final_suspend() noexcept { return {}; }
+      void return_void() { _terminal.emplace(in_place_type<void>); }
+      void unhandled_exception()
+      {
+#ifdef __cpp_exceptions
+        throw;
+#endif
+      }
+
+      std::suspend_always yield_value(value_type &v) noexcept
+      {
+        _current = &v;
+        return {};
+      }
+      std::suspend_always yield_value(value_type &&v) noexcept
+      {
+        _current = &v;
+        return {};
+      }
+      std::suspend_always yield_value(const value_type &v)
+      {
+        _copy.emplace(v);
+        _current = &*_copy;
+        return {};
+      }
+      //! A failed result ends the generator with its failure, a valued one yields its value.
+      template <class A>
+      requires try_awaitable<A, terminal_type> std::suspend_always yield_value(A &&a)
+      {
+        if(OUTCOME_LIKELY(a.has_value()))
+        {
+          _current = &a.assume_value();
+        }
+        else
+        {
+          _terminal.emplace(OUTCOME_V2_NAMESPACE::try_operation_return_as(static_cast<A &&>(a)));
+        }
+        return {};
+      }
+
+      // The frame is never resumed after this, so iteration ends
+      template <class F> std::coroutine_handle<> _fail(F &&f)
+      {
+        _terminal.emplace(std::forward<F>(f));
+        return std::noop_coroutine();
+      }
+      template <class A>
+      requires try_awaitable<A, terminal_type> try_awaiter<generator_promise, A> await_transform(A &&a) noexcept { return {static_cast<A &&>(a)}; }
+      template <class A>
+      requires(!try_awaitable<A, terminal_type>) A &&await_transform(A &&a) noexcept { return static_cast<A &&>(a); }
+    };
+  }  // namespace detail
+
+  /*! A lazy, single pass coroutine generator of the values of `T`, a `result`. Iterating it yields
+  the value type of `T` by rvalue reference, so values can be moved out without copies.
+
+  Within the generator `co_yield` takes a value, or a `T` which if failed ends the generator with its
+  failure. `co_await` on a result behaves like `OUTCOME_TRY`, and `co_return` ends it successfully.
+  Once iteration has ended, `terminal()` is a `result<void, E>` which has an error if the generator
+  ended with one.
+  */
+  template <class T> class generator
+  {
+  public:
+    using promise_type = detail::generator_promise<T>;
+    //! The type of value yielded.
+    using value_type = typename promise_type::value_type;
+    //! The type of the terminal state.
+    using terminal_type = typename promise_type::terminal_type;
+
+  private:
+    friend promise_type;
+    using _handle_type = typename promise_type::handle_type;
+    _handle_type _h;
+
+    explicit generator(_handle_type h) noexcept : _h(h) {}
+
+  public:
+    //! An input iterator over the values yielded.
+    class iterator
+    {
+      friend class generator;
+      _handle_type _h;
+
+      explicit iterator(_handle_type h) noexcept : _h(h) {}
+
+    public:
+      using iterator_category = std::input_iterator_tag;
+      using difference_type = std::ptrdiff_t;
+      using value_type = typename generator::value_type;
+      using reference = value_type &&;
+
+      iterator() = default;
+      reference operator*() const noexcept { return std::move(*_h.promise()._current); }
+      iterator &operator++()
+      {
+        _h.resume();
+        return *this;
+      }
+      void operator++(int) { ++*this; }
+      friend bool operator==(const iterator &it, std::default_sentinel_t /*unused*/) noexcept { return it._h.promise()._terminal.has_value(); }
+      friend bool operator!=(const iterator &it, std::default_sentinel_t s) noexcept { return !(it == s); }
+    };
+
+    generator(const generator &) = delete;
+    generator(generator &&o) noexcept : _h(o._h) { o._h = nullptr; }
+    generator &operator=(const generator &) = delete;
+    generator &operator=(generator &&o) noexcept
+    {
+      if(this != &o)
+      {
+        this->~generator();
+        new(this) generator(std::move(o));
+      }
+      return *this;
+    }
+    ~generator()
+    {
+      if(_h)
+      {
+        _h.destroy();
+      }
+    }
+
+    //! Runs the generator to its first value, or to its end.
+    iterator begin()
+    {
+      _h.resume();
+      return iterator(_h);
+    }
+    //! \group begin
+    std::default_sentinel_t end() const noexcept { return {}; }
+
+    //! True once the generator has ended, successfully or not.
+    bool finished() const noexcept { return _h.promise()._terminal.has_value(); }
+    /*! How the generator ended.
+    \requires `finished()` to be true.
+    */
+    const terminal_type &terminal() const noexcept { return *_h.promise()._terminal; }
+  };
+}  // namespace awaitables
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
+
+#endif
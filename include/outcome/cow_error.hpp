@@ -0,0 +1,244 @@
+/* Copy on write error payloads shared between copies of a failure
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_COW_ERROR_HPP
+#define OUTCOME_COW_ERROR_HPP
+
+#include "exception_box.hpp"
+
+#include <system_error>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  template <class T> inline auto cow_error_code(const T &v) noexcept(noexcept(make_error_code(v))) -> decltype(make_error_code(v)) { return make_error_code(v); }
+  inline std::error_code cow_error_code(const std::error_code &v) noexcept { return v; }
+
+  template <class T> inline auto cow_exception_ptr(const T &v) noexcept -> decltype(make_exception_ptr(v)) { return make_exception_ptr(v); }
+  inline std::exception_ptr cow_exception_ptr(const std::exception_ptr &v) noexcept { return v; }
+
+  template <class T> inline auto cow_error_throw(const T &v, int /*unused*/) -> decltype(throw_as_system_error_with_payload(v)) { throw_as_system_error_with_payload(v); }
+  template <class T> inline void cow_error_throw(const T &v, long /*unused*/) { OUTCOME_THROW_EXCEPTION(std::system_error(cow_error_code(v))); }
+}  // namespace detail
+
+/*! A reference counted, copy on write holder of an error payload, for use as the error type `S` or
+the exception type `P` of a `result` or `outcome` which is copied many times, such as a failure
+broadcast to many subscribers.
+
+Copies share one immutable `T`, so copying costs a count increment whatever the size of `T`, and
+moving copies a pointer. The count is not atomic unless `ThreadSafe`. `mutate()` gives a `T` which
+can be modified, first copying it into a block of its own if it is shared. Blocks are recycled
+through the same per thread free lists as `exception_box`, so making one rarely allocates.
+
+If `T` is an error code type, `make_error_code()` and `throw_as_system_error_with_payload()` forward
+to it, so `result<T, cow_error<E>>` uses the same default policy as `result<T, E>`. If `T` is a
+`std::exception_ptr` or an exception, `make_exception_ptr()` does the same.
+
+\tparam ThreadSafe Whether copies may be copied and destroyed concurrently on different threads.
+Use `cow_error` for failures which stay on one thread, and `shared_cow_error` otherwise. Choosing by
+type avoids any atomic operation in the one thread case, which telling at run time could not.
+*/
+template <class T, bool ThreadSafe> class basic_cow_error
+{
+  struct _block
+  {
+    detail::exception_box_count<ThreadSafe> count;
+    T value;
+
+    template <class... Args>
+    explicit _block(Args &&... args)
+        : value(std::forward<Args>(args)...)
+    {
+    }
+  };
+  using _pool = detail::exception_box_pool<sizeof(_block)>;
+  static_assert(alignof(_block) <= alignof(std::max_align_t), "Over aligned payloads cannot be shared");
+  _block *_b{nullptr};
+
+  template <class... Args> static _block *_make(Args &&... args)
+  {
+    // Returns the memory to the pool if constructing the payload throws
+    struct guard
+    {
+      void *p;
+      ~guard()
+      {
+        if(p != nullptr)
+        {
+          _pool::deallocate(p);
+        }
+      }
+    } g{_pool::allocate()};
+    _block *ret = new(g.p) _block(std::forward<Args>(args)...);
+    g.p = nullptr;
+    return ret;
+  }
+  void _release() noexcept
+  {
+    if(_b != nullptr && _b->count.decrement())
+    {
+      _b->~_block();
+      _pool::deallocate(_b);
+    }
+    _b = nullptr;
+  }
+
+public:
+  //! The type of the payload shared.
+  using value_type = T;
+
+  //! Default constructs an empty holder.
+  constexpr basic_cow_error() noexcept = default;
+  //! Shares a copy of `v`.
+  basic_cow_error(const T &v)  // NOLINT
+      : _b(_make(v))
+  {
+  }
+  //! Shares `v`.
+  basic_cow_error(T &&v)  // NOLINT
+      : _b(_make(std::move(v)))
+  {
+  }
+  //! Shares a `T` constructed from `args`.
+  template <class... Args>
+  explicit basic_cow_error(in_place_type_t<T> /*unused*/, Args &&... args)
+      : _b(_make(std::forward<Args>(args)...))
+  {
+  }
+  //! Copy constructor, which shares the payload.
+  basic_cow_error(const basic_cow_error &o) noexcept
+      : _b(o._b)
+  {
+    if(_b != nullptr)
+    {
+      _b->count.increment();
+    }
+  }
+  //! Move constructor.
+  basic_cow_error(basic_cow_error &&o) noexcept
+      : _b(o._b)
+  {
+    o._b = nullptr;
+  }
+  //! Copy assignment.
+  basic_cow_error &operator=(const basic_cow_error &o) noexcept
+  {
+    basic_cow_error temp(o);
+    swap(temp);
+    return *this;
+  }
+  //! Move assignment.
+  basic_cow_error &operator=(basic_cow_error &&o) noexcept
+  {
+    if(this != &o)
+    {
+      _release();
+      _b = o._b;
+      o._b = nullptr;
+    }
+    return *this;
+  }
+  ~basic_cow_error() { _release(); }
+
+  //! True if there is a payload.
+  explicit operator bool() const noexcept { return _b != nullptr; }
+  //! The payload, or null if empty.
+  const T *get() const noexcept { return (_b != nullptr) ? &_b->value : nullptr; }
+  //! The payload. \requires Not to be empty.
+  const T &operator*() const noexcept { return _b->value; }
+  //! The payload. \requires Not to be empty.
+  const T *operator->() const noexcept { return &_b->value; }
+  //! The number of holders sharing the payload, zero if empty.
+  uint32_t use_count() const noexcept { return (_b != nullptr) ? _b->count.load() : 0; }
+
+  /*! The payload for modification, copied into a block of its own first if it is shared, so that
+  no other holder sees the change.
+  \requires Not to be empty.
+  */
+  T &mutate()
+  {
+    if(_b->count.load() != 1)
+    {
+      _block *b = _make(static_cast<const T &>(_b->value));
+      _release();
+      _b = b;
+    }
+    return _b->value;
+  }
+  //! Swaps with another holder.
+  void swap(basic_cow_error &o) noexcept
+  {
+    _block *temp = _b;
+    _b = o._b;
+    o._b = temp;
+  }
+
+  //! True if both share the same payload, or have equal payloads, or are both empty.
+  friend inline bool operator==(const basic_cow_error &a, const basic_cow_error &b) noexcept(noexcept(std::declval<const T &>() == std::declval<const T &>()))
+  {
+    return a._b == b._b || (a._b != nullptr && b._b != nullptr && a._b->value == b._b->value);
+  }
+  //! True if the payloads differ.
+  friend inline bool operator!=(const basic_cow_error &a, const basic_cow_error &b) noexcept(noexcept(std::declval<const T &>() == std::declval<const T &>())) { return !(a == b); }
+};
+
+//! A copy on write payload for failures which stay on one thread.
+template <class T> using cow_error = basic_cow_error<T, false>;
+//! A copy on write payload for failures shared between threads.
+template <class T> using shared_cow_error = basic_cow_error<T, true>;
+
+//! The code of the payload as a `std::error_code`, which makes a holder of an error code an error code type.
+template <class T, bool ThreadSafe> inline auto make_error_code(const basic_cow_error<T, ThreadSafe> &e) noexcept(noexcept(detail::cow_error_code(*e))) -> decltype(detail::cow_error_code(*e))
+{
+  return e ? detail::cow_error_code(*e) : decltype(detail::cow_error_code(*e))();
+}
+//! Throws as the payload would, or else a `std::system_error` of its code.
+template <class T, bool ThreadSafe> inline auto throw_as_system_error_with_payload(const basic_cow_error<T, ThreadSafe> &e) -> decltype(detail::cow_error_code(*e), void())
+{
+  if(!e)
+  {
+    OUTCOME_THROW_EXCEPTION(std::system_error(std::error_code()));
+  }
+  detail::cow_error_throw(*e, 0);
+}
+//! The payload as a `std::exception_ptr`, which makes a holder of an exception an exception type.
+template <class T, bool ThreadSafe> inline auto make_exception_ptr(const basic_cow_error<T, ThreadSafe> &e) noexcept -> decltype(detail::cow_exception_ptr(*e))
+{
+  return e ? detail::cow_exception_ptr(*e) : std::exception_ptr();
+}
+
+namespace trait
+{
+  //! A holder is a pointer to its shared block.
+  template <class T, bool ThreadSafe> struct is_move_bitcopying<basic_cow_error<T, ThreadSafe>>
+  {
+    static constexpr bool value = true;
+  };
+}  // namespace trait
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,119 @@
+/* Helpers for the monadic operations of result and outcome
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_MONADIC_DETAIL_HPP
+#define OUTCOME_MONADIC_DETAIL_HPP
+
+#include "result_storage.hpp"
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  template <class Self> using monadic_value_is_void = std::is_void<typename std::decay_t<Self>::value_type>;
+
+  // True for outcome, whose failure may include an exception
+  template <class T, class = void> struct monadic_has_exception : std::false_type
+  {
+  };
+  template <class T> struct monadic_has_exception<T, fallback_void_t<typename T::exception_type>> : std::true_type
+  {
+  };
+
+  // Calls f with the value of self, or with nothing if its value type is void
+  template <class F, class Self> constexpr auto monadic_invoke_value(F &&f, Self &&self, std::false_type /*unused*/) -> decltype(static_cast<F &&>(f)(static_cast<Self &&>(self).assume_value()))
+  {
+    return static_cast<F &&>(f)(static_cast<Self &&>(self).assume_value());
+  }
+  template <class F, class Self> constexpr auto monadic_invoke_value(F &&f, Self && /*unused*/, std::true_type /*unused*/) -> decltype(static_cast<F &&>(f)())
+  {
+    return static_cast<F &&>(f)();
+  }
+  template <class F, class Self> using monadic_invoke_value_t = decltype(monadic_invoke_value(std::declval<F>(), std::declval<Self>(), monadic_value_is_void<Self>()));
+
+  // Calls f with the failure of self, being the error of a result, or the failure_type of an outcome
+  template <class F, class Self> constexpr auto monadic_invoke_failure(F &&f, Self &&self, std::false_type /*unused*/) -> decltype(static_cast<F &&>(f)(static_cast<Self &&>(self).assume_error()))
+  {
+    return static_cast<F &&>(f)(static_cast<Self &&>(self).assume_error());
+  }
+  template <class F, class Self> constexpr auto monadic_invoke_failure(F &&f, Self &&self, std::true_type /*unused*/) -> decltype(static_cast<F &&>(f)(static_cast<Self &&>(self).as_failure()))
+  {
+    return static_cast<F &&>(f)(static_cast<Self &&>(self).as_failure());
+  }
+  template <class F, class Self> using monadic_invoke_failure_t = decltype(monadic_invoke_failure(std::declval<F>(), std::declval<Self>(), monadic_has_exception<std::decay_t<Self>>()));
+
+  // Constructs R with the value which f returns when called with the value of self
+  template <class R, class F, class Self> constexpr R monadic_map_value(F &&f, Self &&self, std::false_type /*unused*/)
+  {
+    return R(in_place_type<typename R::value_type_if_enabled>, monadic_invoke_value(static_cast<F &&>(f), static_cast<Self &&>(self), monadic_value_is_void<Self>()));
+  }
+  template <class R, class F, class Self> constexpr R monadic_map_value(F &&f, Self &&self, std::true_type /*unused*/)
+  {
+    monadic_invoke_value(static_cast<F &&>(f), static_cast<Self &&>(self), monadic_value_is_void<Self>());
+    return R(in_place_type<typename R::value_type_if_enabled>);
+  }
+
+  // Constructs R with the value of self
+  template <class R, class Self> constexpr R monadic_pass_value(Self &&self, std::false_type /*unused*/) { return R(in_place_type<typename R::value_type_if_enabled>, static_cast<Self &&>(self).assume_value()); }
+  template <class R, class Self> constexpr R monadic_pass_value(Self && /*unused*/, std::true_type /*unused*/) { return R(in_place_type<typename R::value_type_if_enabled>); }
+
+  // Constructs R with the failure of self
+  template <class R, class Self> constexpr R monadic_pass_failure(Self &&self, std::false_type /*unused*/) { return R(in_place_type<typename R::error_type_if_enabled>, static_cast<Self &&>(self).assume_error()); }
+  template <class R, class Self> constexpr R monadic_pass_failure(Self &&self, std::true_type /*unused*/) { return R(static_cast<Self &&>(self).as_failure()); }
+
+  template <class Self, class F> constexpr auto monadic_map(Self &&self, F &&f)
+  {
+    using value_type = std::remove_cv_t<monadic_invoke_value_t<F, Self>>;
+    using R = typename std::decay_t<Self>::template rebind<value_type>;
+    if(self.has_value())
+    {
+      return monadic_map_value<R>(static_cast<F &&>(f), static_cast<Self &&>(self), std::is_void<value_type>());
+    }
+    return monadic_pass_failure<R>(static_cast<Self &&>(self), monadic_has_exception<std::decay_t<Self>>());
+  }
+  template <class Self, class F> constexpr auto monadic_and_then(Self &&self, F &&f)
+  {
+    using R = std::decay_t<monadic_invoke_value_t<F, Self>>;
+    static_assert(std::is_same<typename R::error_type, typename std::decay_t<Self>::error_type>::value, "and_then() requires f to return a result or outcome with the same error_type");
+    if(self.has_value())
+    {
+      return R(monadic_invoke_value(static_cast<F &&>(f), static_cast<Self &&>(self), monadic_value_is_void<Self>()));
+    }
+    return monadic_pass_failure<R>(static_cast<Self &&>(self), monadic_has_exception<std::decay_t<Self>>());
+  }
+  template <class Self, class F> constexpr auto monadic_or_else(Self &&self, F &&f)
+  {
+    using R = std::decay_t<monadic_invoke_failure_t<F, Self>>;
+    static_assert(std::is_same<typename R::value_type, typename std::decay_t<Self>::value_type>::value, "or_else() requires f to return a result or outcome with the same value_type");
+    if(self.has_value())
+    {
+      return monadic_pass_value<R>(static_cast<Self &&>(self), monadic_value_is_void<Self>());
+    }
+    return R(monadic_invoke_failure(static_cast<F &&>(f), static_cast<Self &&>(self), monadic_has_exception<std::decay_t<Self>>()));
+  }
+}  // namespace detail
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
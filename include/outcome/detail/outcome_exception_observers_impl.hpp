@@ -60,25 +60,25 @@ namespace detail
   {
     outcome<R, S, P, NoValuePolicy> &self = static_cast<outcome<R, S, P, NoValuePolicy> &>(*this);  // NOLINT
     NoValuePolicy::wide_exception_check(self);
-    return self._ptr;
+    return wide_exception_or_fallback<NoValuePolicy>((self._state.status() & status_have_exception) != 0, self._ptr);
   }
   template <class Base, class R, class S, class P, class NoValuePolicy> inline constexpr const typename outcome_exception_observers<Base, R, S, P, NoValuePolicy>::exception_type &outcome_exception_observers<Base, R, S, P, NoValuePolicy>::exception() const &
   {
     const outcome<R, S, P, NoValuePolicy> &self = static_cast<const outcome<R, S, P, NoValuePolicy> &>(*this);  // NOLINT
     NoValuePolicy::wide_exception_check(self);
-    return self._ptr;
+    return wide_exception_or_fallback<NoValuePolicy>((self._state.status() & status_have_exception) != 0, self._ptr);
   }
   template <class Base, class R, class S, class P, class NoValuePolicy> inline constexpr typename outcome_exception_observers<Base, R, S, P, NoValuePolicy>::exception_type &&outcome_exception_observers<Base, R, S, P, NoValuePolicy>::exception() &&
   {
     outcome<R, S, P, NoValuePolicy> &&self = static_cast<outcome<R, S, P, NoValuePolicy> &&>(*this);  // NOLINT
     NoValuePolicy::wide_exception_check(self);
-    return std::move(self._ptr);
+    return std::move(wide_exception_or_fallback<NoValuePolicy>((self._state.status() & status_have_exception) != 0, self._ptr));
   }
   template <class Base, class R, class S, class P, class NoValuePolicy> inline constexpr const typename outcome_exception_observers<Base, R, S, P, NoValuePolicy>::exception_type &&outcome_exception_observers<Base, R, S, P, NoValuePolicy>::exception() const &&
   {
     const outcome<R, S, P, NoValuePolicy> &&self = static_cast<const outcome<R, S, P, NoValuePolicy> &&>(*this);  // NOLINT
     NoValuePolicy::wide_exception_check(self);
-    return std::move(self._ptr);
+    return std::move(wide_exception_or_fallback<NoValuePolicy>((self._state.status() & status_have_exception) != 0, self._ptr));
   }
 }  // namespace detail
 
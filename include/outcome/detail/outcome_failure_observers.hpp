@@ -25,10 +25,94 @@ http://www.boost.org/LICENSE_1_0.txt)
 #ifndef OUTCOME_OUTCOME_FAILURE_OBSERVERS_HPP
 #define OUTCOME_OUTCOME_FAILURE_OBSERVERS_HPP
 
+#include "../policy/detail/common.hpp"
 #include "result_storage.hpp"
 
 OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
 
+/*! The failure of an `outcome`, as returned by `lazy_failure()`, which keeps the error code as it
+is rather than synthesising an exception from it. Comparing, inspecting or logging the failure
+therefore costs no allocation, which is only paid by `to_exception_ptr()`, and rethrowing an
+error code throws a `std::system_error` directly without an exception pointer at all.
+*/
+template <class S, class P = std::exception_ptr> class lazy_failure_handle
+{
+  S _error{};
+  P _exception{};
+  bool _has_error{false};
+
+public:
+  //! The error type.
+  using error_type = S;
+  //! The exception type.
+  using exception_type = P;
+
+  //! Default constructs to no failure.
+  lazy_failure_handle() = default;
+  //! Constructs from an error, an exception, or both as `outcome` permits.
+  lazy_failure_handle(const error_type *error, exception_type exception) noexcept(std::is_nothrow_copy_constructible<error_type>::value &&std::is_nothrow_move_constructible<exception_type>::value)
+      : _error((error != nullptr) ? *error : error_type())
+      , _exception(std::move(exception))
+      , _has_error(error != nullptr)
+  {
+  }
+
+  //! True if there is a failure.
+  explicit operator bool() const noexcept { return _has_error || _exception; }
+  //! True if an error is held.
+  bool has_error() const noexcept { return _has_error; }
+  //! True if an exception is held.
+  bool has_exception() const noexcept { return static_cast<bool>(_exception); }
+  //! The error held, or a default constructed error if none.
+  const error_type &error() const noexcept { return _error; }
+  //! The exception held, or a default constructed exception if none.
+  const exception_type &exception() const noexcept { return _exception; }
+
+  /*! Synthesises the exception which `outcome::failure()` would have returned.
+  \returns If excepted, `exception()`; if errored, `std::make_exception_ptr(std::system_error(error()))`;
+  otherwise a null exception pointer.
+  */
+  std::exception_ptr to_exception_ptr() const noexcept
+  {
+    if(_exception)
+    {
+      return policy::exception_ptr(_exception);
+    }
+    if(_has_error)
+    {
+      return std::make_exception_ptr(std::system_error(_error));
+    }
+    return std::exception_ptr();
+  }
+  /*! Throws the failure, the exception held if any, else a `std::system_error` of the error.
+  \requires There to be a failure, else throws `bad_outcome_access`.
+  */
+  QUICKCPPLIB_NORETURN void rethrow() const
+  {
+    if(_exception)
+    {
+      policy::detail::rethrow_exception_ptr(_exception);
+    }
+    if(_has_error)
+    {
+      policy::detail::throw_system_error(_error);
+    }
+    policy::detail::throw_bad_outcome_access("no failure");
+  }
+
+  //! True if both hold the same exception, or failing that, errors which compare equal.
+  friend bool operator==(const lazy_failure_handle &a, const lazy_failure_handle &b) noexcept
+  {
+    if(a._exception || b._exception)
+    {
+      return a._exception == b._exception;
+    }
+    return a._has_error == b._has_error && (!a._has_error || a._error == b._error);
+  }
+  //! True if the failures differ.
+  friend bool operator!=(const lazy_failure_handle &a, const lazy_failure_handle &b) noexcept { return !(a == b); }
+};
+
 namespace detail
 {
   //! The failure observers implementation of `outcome<R, S, P>`. Only appears separate due to standardese limitations.
@@ -46,16 +130,25 @@ namespace detail
     */
     exception_type failure() const noexcept
     {
-      if((this->_state._status & detail::status_have_exception) != 0)
+      if((this->_state.status() & detail::status_have_exception) != 0)
       {
-        return this->exception();
+        return policy::exception_ptr(this->exception());
       }
-      if((this->_state._status & detail::status_have_error) != 0)
+      if((this->_state.status() & detail::status_have_error) != 0)
       {
         return std::make_exception_ptr(std::system_error(this->error()));
       }
       return exception_type();
     }
+    /*! The failure, without synthesising an exception from an error.
+    \requires `trait::has_error_code_v<S>` and `trait::has_exception_ptr_v<P>` to be true, else it does not appear.
+    \returns A `lazy_failure_handle<S, P>` holding whichever of the error and the exception are present.
+    */
+    lazy_failure_handle<S, P> lazy_failure() const noexcept(std::is_nothrow_copy_constructible<S>::value &&std::is_nothrow_copy_constructible<P>::value)
+    {
+      const auto status = this->_state.status();
+      return lazy_failure_handle<S, P>(((status & detail::status_have_error) != 0) ? &this->assume_error() : nullptr, ((status & detail::status_have_exception) != 0) ? this->assume_exception() : P());
+    }
   };
 }  // namespace detail
 
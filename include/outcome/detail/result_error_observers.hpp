@@ -47,25 +47,25 @@ namespace detail
     constexpr error_type &assume_error() & noexcept
     {
       NoValuePolicy::narrow_error_check(static_cast<result_error_observers &>(*this));
-      return this->_error;
+      return this->_error_ref();
     }
     /// \group assume_error
     constexpr const error_type &assume_error() const &noexcept
     {
       NoValuePolicy::narrow_error_check(static_cast<const result_error_observers &>(*this));
-      return this->_error;
+      return this->_error_ref();
     }
     /// \group assume_error
     constexpr error_type &&assume_error() && noexcept
     {
       NoValuePolicy::narrow_error_check(static_cast<result_error_observers &&>(*this));
-      return std::move(this->_error);
+      return std::move(this->_error_ref());
     }
     /// \group assume_error
     constexpr const error_type &&assume_error() const &&noexcept
     {
       NoValuePolicy::narrow_error_check(static_cast<const result_error_observers &&>(*this));
-      return std::move(this->_error);
+      return std::move(this->_error_ref());
     }
 
     /// \output_section Wide state observers
@@ -77,26 +77,38 @@ namespace detail
     constexpr error_type &error() &
     {
       NoValuePolicy::wide_error_check(static_cast<result_error_observers &>(*this));
-      return this->_error;
+      return wide_error_or_fallback<NoValuePolicy>((this->_state.status() & status_have_error) != 0, this->_error_ref());
     }
     /// \group error
     constexpr const error_type &error() const &
     {
       NoValuePolicy::wide_error_check(static_cast<const result_error_observers &>(*this));
-      return this->_error;
+      return wide_error_or_fallback<NoValuePolicy>((this->_state.status() & status_have_error) != 0, this->_error_ref());
     }
     /// \group error
     constexpr error_type &&error() &&
     {
       NoValuePolicy::wide_error_check(static_cast<result_error_observers &&>(*this));
-      return std::move(this->_error);
+      return std::move(wide_error_or_fallback<NoValuePolicy>((this->_state.status() & status_have_error) != 0, this->_error_ref()));
     }
     /// \group error
     constexpr const error_type &&error() const &&
     {
       NoValuePolicy::wide_error_check(static_cast<const result_error_observers &&>(*this));
-      return std::move(this->_error);
+      return std::move(wide_error_or_fallback<NoValuePolicy>((this->_state.status() & status_have_error) != 0, this->_error_ref()));
     }
+    /*! Access error, or `fallback` if there is none, without calling `NoValuePolicy`.
+    \returns A copy of the held `error_type`, or `fallback` converted to `error_type`.
+    \remarks Trivially copyable errors of up to two pointers, such as `std::error_code`, are chosen without branching.
+    \group error_or
+    */
+    OUTCOME_TEMPLATE(class U)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_convertible<U, error_type>::value))
+    constexpr error_type error_or(U &&fallback) const & { return select_or<error_type>((this->_state.status() & status_have_error) != 0, this->_error_ref(), std::forward<U>(fallback)); }
+    /// \group error_or
+    OUTCOME_TEMPLATE(class U)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_convertible<U, error_type>::value))
+    constexpr error_type error_or(U &&fallback) && { return select_or<error_type>((this->_state.status() & status_have_error) != 0, std::move(this->_error_ref()), std::forward<U>(fallback)); }
   };
   template <class Base, class NoValuePolicy> class result_error_observers<Base, void, NoValuePolicy> : public Base
   {
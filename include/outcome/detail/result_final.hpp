@@ -30,8 +30,84 @@ http://www.boost.org/LICENSE_1_0.txt)
 
 OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
 
+/*! The state of a `result` or `outcome`, as returned by `status()`. It is a bitmask of which of
+the value, error and exception are present, so it may be tested, combined and used as an index
+without branching. Only the values named occur.
+*/
+enum class result_status : uint8_t
+{
+  //! Neither value nor failure, as a value initialised result with trivial storage has.
+  none = 0,
+  //! Has a value.
+  value = detail::status_have_value,
+  //! Has an error.
+  error = detail::status_have_error,
+  //! Has an exception, which only an `outcome` can.
+  exception = detail::status_have_exception,
+  //! Has an error and an exception, which only an `outcome` can.
+  error_and_exception = detail::status_have_error | detail::status_have_exception
+};
+//! One more than the largest `result_status`, for sizing tables indexed by it.
+static constexpr size_t result_status_count = 8;
+
+namespace hooks
+{
+  //! The type returned by the default lifetime hooks, by which they are told apart from overloads.
+  struct default_hook
+  {
+  };
+
+  /*! The default instantiation hook implementation called when a `result` is destroyed. Does nothing.
+  \param 1 The `detail::result_final<...>` part of some `result<...>` being destroyed.
+
+  Unlike the construction hooks, overloads of the lifetime hooks must be declared before the
+  `result` they hook is first instantiated. Only then does `result` find out that it must have
+  a destructor and assignment operators to call them from, which makes it no longer trivially
+  destructible nor trivially copyable. Results which are not hooked are unaffected.
+  */
+  template <class T> constexpr inline default_hook hook_result_destruction(T * /*unused*/) noexcept { return {}; }
+  /*! The default instantiation hook implementation called when a `result` has been copy assigned. Does nothing.
+  \param 1 The `detail::result_final<...>` part of some `result<...>` assigned to.
+  \param 2 The `detail::result_final<...>` part of the source.
+  */
+  template <class T, class U> constexpr inline default_hook hook_result_copy_assignment(T * /*unused*/, U && /*unused*/) noexcept { return {}; }
+  /*! The default instantiation hook implementation called when a `result` has been move assigned. Does nothing.
+  \param 1 The `detail::result_final<...>` part of some `result<...>` assigned to.
+  \param 2 The `detail::result_final<...>` part of the source.
+  */
+  template <class T, class U> constexpr inline default_hook hook_result_move_assignment(T * /*unused*/, U && /*unused*/) noexcept { return {}; }
+  /*! The default instantiation hook implementation called when an `outcome` is destroyed. Does nothing.
+  \param 1 The `detail::result_final<...>` part of some `outcome<...>` being destroyed, the
+  exception having been destroyed already.
+  */
+  template <class T> constexpr inline default_hook hook_outcome_destruction(T * /*unused*/) noexcept { return {}; }
+  /*! The default instantiation hook implementation called when an `outcome` has been copy assigned. Does nothing.
+  \param 1 The `detail::result_final<...>` part of some `outcome<...>` assigned to, called before
+  the exception is assigned.
+  \param 2 The `detail::result_final<...>` part of the source.
+  */
+  template <class T, class U> constexpr inline default_hook hook_outcome_copy_assignment(T * /*unused*/, U && /*unused*/) noexcept { return {}; }
+  /*! The default instantiation hook implementation called when an `outcome` has been move assigned. Does nothing.
+  \param 1 The `detail::result_final<...>` part of some `outcome<...>` assigned to, called before
+  the exception is assigned.
+  \param 2 The `detail::result_final<...>` part of the source.
+  */
+  template <class T, class U> constexpr inline default_hook hook_outcome_move_assignment(T * /*unused*/, U && /*unused*/) noexcept { return {}; }
+}  // namespace hooks
+
 namespace detail
 {
+  /* True if a `T` is equal to another exactly when their bytes are, which makes it trivially
+  copyable without padding.
+  */
+  template <class T>
+  struct is_bytewise_comparable : std::integral_constant<bool, std::is_integral<T>::value || std::is_enum<T>::value || std::is_pointer<T>::value
+#if defined(__cpp_lib_has_unique_object_representations)
+                                                               || (std::has_unique_object_representations<T>::value && !std::is_floating_point<T>::value)
+#endif
+                                                               >
+  {
+  };
   template <class R, class EC, class NoValuePolicy> using select_result_impl = result_error_observers<result_value_observers<result_storage<R, EC, NoValuePolicy>, R, NoValuePolicy>, EC, NoValuePolicy>;
 
   //! The assembled implementation type of `result<R, S, NoValuePolicy>`.
@@ -45,6 +121,23 @@ namespace detail
   {
     using base = select_result_impl<R, S, NoValuePolicy>;
 
+    /* Results of the same bytewise comparable value and error, in the overlapping layout which
+    always has an error to compare, are equal when their status and error bytes are and, if they
+    have one, their value bytes are. The bytes of an absent value are not normalised, so their
+    comparison is masked out rather than branched around.
+    */
+    template <class T, class U>
+    using _is_bytewise_comparable_with = std::integral_constant<bool, std::is_same<T, R>::value && std::is_same<U, S>::value && !base::_disjoint && !std::is_void<R>::value && !std::is_void<S>::value  //
+                                                                          && detail::is_bytewise_comparable<std::remove_cv_t<R>>::value && detail::is_bytewise_comparable<std::remove_cv_t<S>>::value>;
+    template <class O> static constexpr bool _bytewise_equal(const O & /*unused*/, std::false_type /*unused*/) noexcept { return false; }
+    template <class O> OUTCOME_HOST_DEVICE bool _bytewise_equal(const O &o, std::true_type /*unused*/) const noexcept
+    {
+      const auto status = this->_state.status();
+      const bool same = (status == o._state.status()) & (memcmp(&this->_error_ref(), &o._error_ref(), sizeof(S)) == 0);
+      const bool value = ((status & detail::status_have_value) == 0) | (memcmp(&this->_state._value, &o._state._value, sizeof(R)) == 0);  // NOLINT
+      return same & value;
+    }
+
   public:
     using base::base;
 
@@ -52,23 +145,28 @@ namespace detail
     /*! Checks if has value.
     \returns True if has value.
     */
-    constexpr explicit operator bool() const noexcept { return (this->_state._status & detail::status_have_value) != 0; }
+    constexpr explicit operator bool() const noexcept { return (this->_state.status() & detail::status_have_value) != 0; }
     /*! Checks if has value.
     \returns True if has value.
     */
-    constexpr bool has_value() const noexcept { return (this->_state._status & detail::status_have_value) != 0; }
+    constexpr bool has_value() const noexcept { return (this->_state.status() & detail::status_have_value) != 0; }
     /*! Checks if has error.
     \returns True if has error.
     */
-    constexpr bool has_error() const noexcept { return (this->_state._status & detail::status_have_error) != 0; }
+    constexpr bool has_error() const noexcept { return (this->_state.status() & detail::status_have_error) != 0; }
     /*! Checks if has exception.
     \returns True if has exception.
     */
-    constexpr bool has_exception() const noexcept { return (this->_state._status & detail::status_have_exception) != 0; }
+    constexpr bool has_exception() const noexcept { return (this->_state.status() & detail::status_have_exception) != 0; }
     /*! Checks if has error or exception.
     \returns True if has error or exception.
     */
-    constexpr bool has_failure() const noexcept { return (this->_state._status & detail::status_have_error) != 0 && (this->_state._status & detail::status_have_exception) != 0; }
+    constexpr bool has_failure() const noexcept { return (this->_state.status() & detail::status_have_error) != 0 && (this->_state.status() & detail::status_have_exception) != 0; }
+
+    /*! The state as one small integer, for testing many results without branching.
+    \returns The `result_status` of which of value, error and exception are present.
+    */
+    constexpr result_status status() const noexcept { return static_cast<result_status>(this->_state.status() & (detail::status_have_value | detail::status_have_error | detail::status_have_exception)); }
 
     /// \output_section Comparison operators
     /*! True if equal to the other result.
@@ -83,13 +181,18 @@ namespace detail
     noexcept(detail::safe_compare_equal(std::declval<detail::devoid<R>>(), std::declval<detail::devoid<T>>()))  //
     && noexcept(detail::safe_compare_equal(std::declval<detail::devoid<S>>(), std::declval<detail::devoid<U>>())))
     {
-      if(this->_state._status == o._state._status)
+      if(_is_bytewise_comparable_with<T, U>::value)
       {
-        if(this->_state._status & detail::status_have_value)
+        return _bytewise_equal(o, _is_bytewise_comparable_with<T, U>());
+      }
+      if(this->_state.status() == o._state.status())
+      {
+        if((this->_state.status() & detail::status_have_value) && !detail::safe_compare_equal(this->_state._value, o._state._value))  // NOLINT
         {
-          return detail::safe_compare_equal(this->_state._value, o._state._value) && detail::safe_compare_equal(this->_error, o._error);  // NOLINT
+          return false;
         }
-        return detail::safe_compare_equal(this->_error, o._error);
+        // The disjoint layout only stores an error whilst errored
+        return !this->_has_error_storage() || !o._has_error_storage() || detail::safe_compare_equal(this->_error_ref(), o._error_ref());
       }
       return false;
     }
@@ -101,9 +204,9 @@ namespace detail
     */
     template <class T> constexpr bool operator==(const success_type<T> &o) const noexcept(noexcept(detail::safe_compare_equal(std::declval<detail::devoid<R>>(), std::declval<detail::devoid<T>>())))
     {
-      if(this->_state._status & detail::status_have_value)
+      if(this->_state.status() & detail::status_have_value)
       {
-        return detail::safe_compare_equal(this->_state._value, o._value);  // NOLINT
+        return detail::safe_compare_equal(this->_state._value, o.value());  // NOLINT
       }
       return false;
     }
@@ -116,7 +219,7 @@ namespace detail
     constexpr bool operator==(const success_type<void> &o) const noexcept
     {
       (void) o;
-      return static_cast<bool>(this->_state._status & detail::status_have_value);
+      return static_cast<bool>(this->_state.status() & detail::status_have_value);
     }
     /*! True if equal to the failure type sugar.
     \param o The failure type sugar to compare to.
@@ -124,7 +227,10 @@ namespace detail
     \effects If a valid expression to do so, calls the `operator==` operation on the failure item returning true if equal. Otherwise returns false.
     \throws Any exception the `operator==` operation might throw.
     */
-    template <class T> constexpr bool operator==(const failure_type<T, void> &o) const noexcept(noexcept(detail::safe_compare_equal(std::declval<detail::devoid<S>>(), std::declval<detail::devoid<T>>()))) { return detail::safe_compare_equal(this->_error, o.error()); }
+    template <class T> constexpr bool operator==(const failure_type<T, void> &o) const noexcept(noexcept(detail::safe_compare_equal(std::declval<detail::devoid<S>>(), std::declval<detail::devoid<T>>())))
+    {
+      return this->_has_error_storage() ? detail::safe_compare_equal(this->_error_ref(), o.error()) : detail::safe_compare_equal(std::decay_t<decltype(this->_error_ref())>{}, o.error());
+    }
     /*! True if not equal to the other result.
     \param o The other result to compare to.
 
@@ -137,18 +243,22 @@ namespace detail
     noexcept(detail::safe_compare_notequal(std::declval<detail::devoid<R>>(), std::declval<detail::devoid<T>>()))  //
     && noexcept(detail::safe_compare_notequal(std::declval<detail::devoid<S>>(), std::declval<detail::devoid<U>>())))
     {
-      if(this->_state._status != o._state._status)
+      if(_is_bytewise_comparable_with<T, U>::value)
+      {
+        return !_bytewise_equal(o, _is_bytewise_comparable_with<T, U>());
+      }
+      if(this->_state.status() != o._state.status())
       {
         return true;
       }
-      if(this->_state._status & detail::status_have_value)
+      if(this->_state.status() & detail::status_have_value)
       {
         if(detail::safe_compare_notequal(this->_state._value, o._state._value))  // NOLINT
         {
           return true;
         }
       }
-      return detail::safe_compare_notequal(this->_error, o._error);
+      return this->_has_error_storage() && o._has_error_storage() && detail::safe_compare_notequal(this->_error_ref(), o._error_ref());
     }
     /*! True if not equal to the success type sugar.
     \param o The success type sugar to compare to.
@@ -158,9 +268,9 @@ namespace detail
     */
     template <class T> constexpr bool operator!=(const success_type<T> &o) const noexcept(noexcept(detail::safe_compare_notequal(std::declval<detail::devoid<R>>(), std::declval<detail::devoid<T>>())))
     {
-      if(this->_state._status & detail::status_have_value)
+      if(this->_state.status() & detail::status_have_value)
       {
-        return detail::safe_compare_notequal(this->_state._value, o._value);  // NOLINT
+        return detail::safe_compare_notequal(this->_state._value, o.value());  // NOLINT
       }
       return true;
     }
@@ -173,7 +283,7 @@ namespace detail
     constexpr bool operator!=(const success_type<void> &o) const noexcept
     {
       (void) o;
-      return !static_cast<bool>(this->_state._status & detail::status_have_value);
+      return !static_cast<bool>(this->_state.status() & detail::status_have_value);
     }
     /*! True if not equal to the failure type sugar.
     \param o The failure type sugar to compare to.
@@ -181,8 +291,75 @@ namespace detail
     \effects If a valid expression to do so, calls the `operator!=` operation on the failure item returning true if not equal. Otherwise returns false.
     \throws Any exception the `operator!=` operation might throw.
     */
-    template <class T> constexpr bool operator!=(const failure_type<T, void> &o) const noexcept(noexcept(detail::safe_compare_notequal(std::declval<detail::devoid<S>>(), std::declval<detail::devoid<T>>()))) { return detail::safe_compare_notequal(this->_error, o.error()); }
+    template <class T> constexpr bool operator!=(const failure_type<T, void> &o) const noexcept(noexcept(detail::safe_compare_notequal(std::declval<detail::devoid<S>>(), std::declval<detail::devoid<T>>())))
+    {
+      return this->_has_error_storage() ? detail::safe_compare_notequal(this->_error_ref(), o.error()) : detail::safe_compare_notequal(std::decay_t<decltype(this->_error_ref())>{}, o.error());
+    }
   };
+  // Calls the ADL discovered lifetime hooks of result, or of outcome
+  namespace lifetime_hooks
+  {
+    using namespace OUTCOME_V2_NAMESPACE::hooks;
+    template <bool Outcome> struct call
+    {
+      template <class T> static constexpr auto destruction(T *r) noexcept -> decltype(hook_result_destruction(r)) { return hook_result_destruction(r); }
+      template <class T, class U> static constexpr auto copy_assignment(T *r, U &&o) noexcept -> decltype(hook_result_copy_assignment(r, std::forward<U>(o))) { return hook_result_copy_assignment(r, std::forward<U>(o)); }
+      template <class T, class U> static constexpr auto move_assignment(T *r, U &&o) noexcept -> decltype(hook_result_move_assignment(r, std::forward<U>(o))) { return hook_result_move_assignment(r, std::forward<U>(o)); }
+    };
+    template <> struct call<true>
+    {
+      template <class T> static constexpr auto destruction(T *r) noexcept -> decltype(hook_outcome_destruction(r)) { return hook_outcome_destruction(r); }
+      template <class T, class U> static constexpr auto copy_assignment(T *r, U &&o) noexcept -> decltype(hook_outcome_copy_assignment(r, std::forward<U>(o))) { return hook_outcome_copy_assignment(r, std::forward<U>(o)); }
+      template <class T, class U> static constexpr auto move_assignment(T *r, U &&o) noexcept -> decltype(hook_outcome_move_assignment(r, std::forward<U>(o))) { return hook_outcome_move_assignment(r, std::forward<U>(o)); }
+    };
+    // True if any lifetime hook found by ADL is not the default
+    template <class T, bool Outcome>
+    static constexpr bool is_hooked = !std::is_same<decltype(call<Outcome>::destruction(std::declval<T *>())), default_hook>::value            //
+                                      || !std::is_same<decltype(call<Outcome>::copy_assignment(std::declval<T *>(), std::declval<const T &>())), default_hook>::value  //
+                                      || !std::is_same<decltype(call<Outcome>::move_assignment(std::declval<T *>(), std::declval<T &&>())), default_hook>::value;
+  }  // namespace lifetime_hooks
+
+  //! `result_final` with a destructor, copy, move and assignment which call the lifetime hooks.
+  template <class R, class S, class NoValuePolicy, bool Outcome> class result_final_lifetime_hooks : public result_final<R, S, NoValuePolicy>
+  {
+    using base = result_final<R, S, NoValuePolicy>;
+    using _hooks = policy_hooks_t<NoValuePolicy>;
+
+  public:
+    using base::base;
+    result_final_lifetime_hooks(const result_final_lifetime_hooks &o) noexcept(std::is_nothrow_copy_constructible<base>::value)
+        : base(o)
+    {
+      _hooks::on_copy_construction(static_cast<base *>(this), static_cast<const base &>(o));
+    }
+    result_final_lifetime_hooks(result_final_lifetime_hooks &&o) noexcept(std::is_nothrow_move_constructible<base>::value)  // NOLINT
+        : base(static_cast<base &&>(o))
+    {
+      _hooks::on_move_construction(static_cast<base *>(this), static_cast<base &&>(o));
+    }
+    result_final_lifetime_hooks &operator=(const result_final_lifetime_hooks &o) noexcept(std::is_nothrow_copy_assignable<base>::value)
+    {
+      base::operator=(o);
+      lifetime_hooks::call<Outcome>::copy_assignment(static_cast<base *>(this), static_cast<const base &>(o));
+      _hooks::on_copy_assignment(static_cast<base *>(this), static_cast<const base &>(o));
+      return *this;
+    }
+    result_final_lifetime_hooks &operator=(result_final_lifetime_hooks &&o) noexcept(std::is_nothrow_move_assignable<base>::value)  // NOLINT
+    {
+      base::operator=(static_cast<base &&>(o));
+      lifetime_hooks::call<Outcome>::move_assignment(static_cast<base *>(this), static_cast<base &&>(o));
+      _hooks::on_move_assignment(static_cast<base *>(this), static_cast<base &&>(o));
+      return *this;
+    }
+    ~result_final_lifetime_hooks()
+    {
+      lifetime_hooks::call<Outcome>::destruction(static_cast<base *>(this));
+      _hooks::on_destruction(static_cast<base *>(this));
+    }
+  };
+  // Only types with some lifetime hook lose trivial destruction and assignment
+  template <class R, class S, class NoValuePolicy, bool Outcome = false>
+  using select_result_final = std::conditional_t<policy_hooks_t<NoValuePolicy>::has_lifetime_hooks || lifetime_hooks::is_hooked<result_final<R, S, NoValuePolicy>, Outcome>, result_final_lifetime_hooks<R, S, NoValuePolicy, Outcome>, result_final<R, S, NoValuePolicy>>;
   /*! True if the result is equal to the success type sugar.
   \param a The success type sugar to compare.
   \param b The result to compare.
@@ -220,6 +397,12 @@ namespace detail
   */
   template <class T, class U, class V, class W> constexpr inline bool operator!=(const failure_type<W, void> &a, const result_final<T, U, V> &b) noexcept(noexcept(b == a)) { return b != a; }
 }  // namespace detail
+namespace trait
+{
+  template <class R, class S, class NoValuePolicy> struct is_move_bitcopying<OUTCOME_V2_NAMESPACE::detail::result_final<R, S, NoValuePolicy>> : is_move_bitcopying<OUTCOME_V2_NAMESPACE::detail::result_storage<R, S, NoValuePolicy>>
+  {
+  };
+}  // namespace trait
 
 OUTCOME_V2_NAMESPACE_END
 
@@ -25,13 +25,21 @@ http://www.boost.org/LICENSE_1_0.txt)
 #ifndef OUTCOME_RESULT_STORAGE_HPP
 #define OUTCOME_RESULT_STORAGE_HPP
 
+#include "../policy/hooks.hpp"
 #include "../success_failure.hpp"
 #include "value_storage.hpp"
 
+#include <cstddef>  // for offsetof
+#include <memory>   // for addressof
+#ifndef OUTCOME_RESULT_LITE
 #include <system_error>
+#endif
 
 OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
 
+class compact_error_code;
+class status_code;
+
 namespace detail
 {
   /* True if type is the same or constructible. Works around a bug where clang + libstdc++
@@ -92,53 +100,184 @@ namespace detail
 #endif
   OUTCOME_TEMPLATE(class T, class U)
   OUTCOME_TREQUIRES(OUTCOME_TEXPR(std::declval<T>() == std::declval<U>()))
-  inline bool safe_compare_equal(const T &a, const U &b) noexcept(noexcept(std::declval<T>() == std::declval<U>()))
+  OUTCOME_HOST_DEVICE inline bool safe_compare_equal(const T &a, const U &b) noexcept(noexcept(std::declval<T>() == std::declval<U>()))
   {
     // std::cout << "Taken " << typeid(T).name() << " == " << typeid(U).name() << " = " << (a == b) << std::endl;
     return a == b;
   }
-  template <class T, class U> inline bool safe_compare_equal(T && /*unused*/, U && /*unused*/) noexcept
+  template <class T, class U> OUTCOME_HOST_DEVICE inline bool safe_compare_equal(T && /*unused*/, U && /*unused*/) noexcept
   {
     // std::cout << "Fallback " << typeid(T).name() << " == " << typeid(U).name() << " = false" << std::endl;
     return false;
   }
   OUTCOME_TEMPLATE(class T, class U)
   OUTCOME_TREQUIRES(OUTCOME_TEXPR(std::declval<T>() != std::declval<U>()))
-  inline bool safe_compare_notequal(const T &a, const U &b) noexcept(noexcept(std::declval<T>() != std::declval<U>()))
+  OUTCOME_HOST_DEVICE inline bool safe_compare_notequal(const T &a, const U &b) noexcept(noexcept(std::declval<T>() != std::declval<U>()))
   {
     // std::cout << "Taken " << typeid(T).name() << " != " << typeid(U).name() << " = " << (a != b) << std::endl;
     return a != b;
   }
-  template <class T, class U> inline bool safe_compare_notequal(T && /*unused*/, U && /*unused*/) noexcept
+  template <class T, class U> OUTCOME_HOST_DEVICE inline bool safe_compare_notequal(T && /*unused*/, U && /*unused*/) noexcept
   {
     // std::cout << "Fallback " << typeid(T).name() << " != " << typeid(U).name() << " = true" << std::endl;
     return true;
   }
 
   template <class State, class E> constexpr inline void _set_error_is_errno(State & /*unused*/, const E & /*unused*/) {}
-  template <class State> constexpr inline void _set_error_is_errno(State &state, const std::error_code &error)
+#ifndef OUTCOME_RESULT_LITE
+  /* The addresses of the categories whose codes are errno values, taken once during static
+  initialisation. The categories live in the runtime library, so the compiler cannot fold calls to
+  `std::generic_category()` and `std::system_category()`, and they cost two calls per construction.
+  Both are taken by the one initialiser, so until it has run both are null.
+  */
+  struct errno_category_addresses
+  {
+    const std::error_category *generic;
+    const std::error_category *system;
+  };
+  template <class T = void> struct errno_categories
   {
-    if(error.category() == std::generic_category()
+    static const errno_category_addresses addresses;
+  };
+  template <class T> const errno_category_addresses errno_categories<T>::addresses = {&std::generic_category(), &std::system_category()};
+  OUTCOME_COLD inline bool is_errno_category_uncached(const std::error_category &category) noexcept
+  {
+    return category == std::generic_category()
 #ifndef _WIN32
-       || error.category() == std::system_category()
+           || category == std::system_category()
 #endif
-       )
+    ;
+  }
+  inline bool is_errno_category(const std::error_category &category) noexcept
+  {
+#if defined(__GNUC__) && !defined(__clang__)
+    // The runtime library declares the category functions const, so where the category came from one
+    // of them in view, as after make_error_code(std::errc), comparing against it folds to true
+    if(__builtin_constant_p(&category == &std::generic_category()) && &category == &std::generic_category())
     {
-      state._status |= status_error_is_errno;
+      return true;
+    }
+#ifndef _WIN32
+    if(__builtin_constant_p(&category == &std::system_category()) && &category == &std::system_category())
+    {
+      return true;
+    }
+#endif
+#endif
+    if(&category == errno_categories<>::addresses.generic
+#ifndef _WIN32
+       || &category == errno_categories<>::addresses.system
+#endif
+    )
+    {
+      return true;
+    }
+    // Only before the addresses have been taken, when constructed during static initialisation
+    return errno_categories<>::addresses.generic == nullptr && is_errno_category_uncached(category);
+  }
+  template <class State> constexpr inline void _set_error_is_errno(State &state, const std::error_code &error)
+  {
+    if(is_errno_category(error.category()))
+    {
+      state.set_status(state.status() | status_error_is_errno);
     }
   }
   template <class State> constexpr inline void _set_error_is_errno(State &state, const std::error_condition &error)
   {
-    if(error.category() == std::generic_category()
+    if(is_errno_category(error.category()))
+    {
+      state.set_status(state.status() | status_error_is_errno);
+    }
+  }
+  template <class State> constexpr inline void _set_error_is_errno(State &state, const std::errc & /*unused*/) { state.set_status(state.status() | status_error_is_errno); }
+#ifdef OUTCOME_ENABLE_BOOST_SYSTEM
+  // Boost.System categories compare by their unique id, so unlike the conversion to std::error_code this makes no virtual call
+  inline bool is_errno_category(const boost::system::error_category &category) noexcept
+  {
+    return category == boost::system::generic_category()
 #ifndef _WIN32
-       || error.category() == std::system_category()
+           || category == boost::system::system_category()
 #endif
-       )
+    ;
+  }
+  template <class State> constexpr inline void _set_error_is_errno(State &state, const boost::system::error_code &error)
+  {
+    if(is_errno_category(error.category()))
+    {
+      state.set_status(state.status() | status_error_is_errno);
+    }
+  }
+  template <class State> constexpr inline void _set_error_is_errno(State &state, const boost::system::error_condition &error)
+  {
+    if(is_errno_category(error.category()))
     {
-      state._status |= status_error_is_errno;
+      state.set_status(state.status() | status_error_is_errno);
     }
   }
-  template <class State> constexpr inline void _set_error_is_errno(State &state, const std::errc & /*unused*/) { state._status |= status_error_is_errno; }
+  template <class State> constexpr inline void _set_error_is_errno(State &state, const boost::system::errc::errc_t & /*unused*/) { state.set_status(state.status() | status_error_is_errno); }
+#endif
+#endif
+  // Defined by compact_error_code.hpp
+  template <class State> constexpr inline void _set_error_is_errno(State &state, const compact_error_code &error);
+  // Defined by status_code.hpp
+  template <class State> constexpr inline void _set_error_is_errno(State &state, const status_code &error);
+
+  /* A policy whose wide checks return rather than throw or terminate may provide static
+  `wide_value_fallback<T>()`, `wide_error_fallback<T>()` and `wide_exception_fallback<T>()`,
+  returning a `T &` which the wide observers return in place of the state absent.
+  */
+  template <class...> using fallback_void_t = void;
+  template <class Policy, class T, class = void> struct has_wide_value_fallback : std::false_type
+  {
+  };
+  template <class Policy, class T> struct has_wide_value_fallback<Policy, T, fallback_void_t<decltype(Policy::template wide_value_fallback<T>())>> : std::true_type
+  {
+  };
+  template <class Policy, class T, class = void> struct has_wide_error_fallback : std::false_type
+  {
+  };
+  template <class Policy, class T> struct has_wide_error_fallback<Policy, T, fallback_void_t<decltype(Policy::template wide_error_fallback<T>())>> : std::true_type
+  {
+  };
+  template <class Policy, class T, class = void> struct has_wide_exception_fallback : std::false_type
+  {
+  };
+  template <class Policy, class T> struct has_wide_exception_fallback<Policy, T, fallback_void_t<decltype(Policy::template wide_exception_fallback<T>())>> : std::true_type
+  {
+  };
+  template <class Policy, class T> constexpr inline T &_wide_value_or_fallback(std::false_type /*unused*/, bool /*unused*/, T &v) noexcept { return v; }
+  template <class Policy, class T> constexpr inline T &_wide_value_or_fallback(std::true_type /*unused*/, bool have, T &v) noexcept { return have ? v : Policy::template wide_value_fallback<std::remove_const_t<T>>(); }
+  template <class Policy, class T> constexpr inline T &_wide_error_or_fallback(std::false_type /*unused*/, bool /*unused*/, T &v) noexcept { return v; }
+  template <class Policy, class T> constexpr inline T &_wide_error_or_fallback(std::true_type /*unused*/, bool have, T &v) noexcept { return have ? v : Policy::template wide_error_fallback<std::remove_const_t<T>>(); }
+  template <class Policy, class T> constexpr inline T &_wide_exception_or_fallback(std::false_type /*unused*/, bool /*unused*/, T &v) noexcept { return v; }
+  template <class Policy, class T> constexpr inline T &_wide_exception_or_fallback(std::true_type /*unused*/, bool have, T &v) noexcept { return have ? v : Policy::template wide_exception_fallback<std::remove_const_t<T>>(); }
+  // What a wide observer returns after the wide check, `v` unless the state is absent and `Policy` has a fallback
+  template <class Policy, class T> constexpr inline T &wide_value_or_fallback(bool have, T &v) noexcept { return _wide_value_or_fallback<Policy>(has_wide_value_fallback<Policy, std::remove_const_t<T>>(), have, v); }
+  template <class Policy, class T> constexpr inline T &wide_error_or_fallback(bool have, T &v) noexcept { return _wide_error_or_fallback<Policy>(has_wide_error_fallback<Policy, std::remove_const_t<T>>(), have, v); }
+  template <class Policy, class T> constexpr inline T &wide_exception_or_fallback(bool have, T &v) noexcept { return _wide_exception_or_fallback<Policy>(has_wide_exception_fallback<Policy, std::remove_const_t<T>>(), have, v); }
+
+  /* What `value_or()` and `error_or()` return. Trivially copyable types of up to two pointers are
+  chosen by address, which compiles to a conditional move rather than a branch. Other types take
+  one branch, constructing only the one returned.
+  */
+  template <class T> struct select_or_by_address : std::integral_constant<bool, std::is_trivially_copyable<T>::value && sizeof(T) <= 2 * sizeof(void *)>
+  {
+  };
+  template <class T, class V, class U> constexpr inline T _select_or(std::true_type /*unused*/, bool have, V &&v, U &&fallback)
+  {
+    const T f(static_cast<U &&>(fallback));
+    const T *p = have ? &v : &f;
+    return *p;
+  }
+  template <class T, class V, class U> constexpr inline T _select_or(std::false_type /*unused*/, bool have, V &&v, U &&fallback)
+  {
+    if(have)
+    {
+      return static_cast<V &&>(v);
+    }
+    return static_cast<T>(static_cast<U &&>(fallback));
+  }
+  template <class T, class V, class U> constexpr inline T select_or(bool have, V &&v, U &&fallback) { return _select_or<T>(select_or_by_address<T>(), have, static_cast<V &&>(v), static_cast<U &&>(fallback)); }
 
   template <class R, class S, class NoValuePolicy> class result_final;
 }  // namespace detail
@@ -171,16 +310,89 @@ namespace detail
                                   && std::is_destructible<R>::value))  //
    );
 
+  //! Predicate for permitting type to be the value of a `result`, which may also be an lvalue reference
+  template <class R>                                                                            //
+  static constexpr bool value_type_can_be_used_in_result =                                      //
+  type_can_be_used_in_result<R>                                                                 //
+  || (std::is_lvalue_reference<R>::value && type_can_be_used_in_result<std::remove_reference_t<R>>  //
+      && !std::is_void<std::remove_reference_t<R>>::value);
+
+#ifdef OUTCOME_HAVE_CXX20_CONCEPTS
+  //! Concept for a type usable as the value or status of a `result`.
+  template <class R> concept usable_in_result = type_can_be_used_in_result<R>;
+  //! Concept for a type usable as the value of a `result`, which may be an lvalue reference.
+  template <class R> concept usable_as_result_value = value_type_can_be_used_in_result<R>;
+  //! Concept for a type usable as the status or payload of a `result` or `outcome`.
+  template <class S> concept usable_as_result_status = usable_in_result<S> && (std::is_void<S>::value || std::is_default_constructible<S>::value);
+#else
+  template <class R> static constexpr bool usable_in_result = type_can_be_used_in_result<R>;
+  template <class R> static constexpr bool usable_as_result_value = value_type_can_be_used_in_result<R>;
+  template <class S> static constexpr bool usable_as_result_status = usable_in_result<S> && (std::is_void<S>::value || std::is_default_constructible<S>::value);
+#endif
+
+  /* How `result<T &>` stores its value, a pointer which is never null and cannot be bound to a
+  temporary. It is trivially copyable and pointer sized, so `result<T &, E>` has the layout of
+  `result<T *, E>`. Assignment rebinds, as for `std::reference_wrapper`.
+  */
+  template <class T> class reference_storage
+  {
+    T *_p;
+
+  public:
+    constexpr reference_storage(T &v) noexcept  // NOLINT
+        : _p(std::addressof(v))
+    {
+    }
+    // Binding a temporary would leave the reference dangling
+    reference_storage(std::remove_const_t<T> &&) = delete;
+    // Binds to the referent of a compatible reference, such as `T &` to `const T &`
+    OUTCOME_TEMPLATE(class U)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(!std::is_same<U, T>::value && std::is_convertible<U *, T *>::value))
+    constexpr reference_storage(const reference_storage<U> &o) noexcept  // NOLINT
+        : _p(std::addressof(o.get()))
+    {
+    }
+
+    constexpr T &get() const noexcept { return *_p; }
+    constexpr operator T &() const noexcept { return *_p; }  // NOLINT
+  };
+  template <class T> constexpr inline T &reference_storage_get(const reference_storage<T> &v) noexcept { return v.get(); }
+  template <class T> constexpr inline const T &reference_storage_get(const T &v) noexcept { return v; }
+  // A referenced value compares as the value, so `result<T &>` compares as `result<T>` does
+  OUTCOME_TEMPLATE(class T, class U)
+  OUTCOME_TREQUIRES(OUTCOME_TEXPR(std::declval<T &>() == reference_storage_get(std::declval<const U &>())))
+  constexpr inline bool operator==(const reference_storage<T> &a, const U &b) noexcept(noexcept(std::declval<T &>() == reference_storage_get(std::declval<const U &>())))
+  {
+    return a.get() == reference_storage_get(b);
+  }
+  OUTCOME_TEMPLATE(class T, class U)
+  OUTCOME_TREQUIRES(OUTCOME_TEXPR(std::declval<T &>() != reference_storage_get(std::declval<const U &>())))
+  constexpr inline bool operator!=(const reference_storage<T> &a, const U &b) noexcept(noexcept(std::declval<T &>() != reference_storage_get(std::declval<const U &>())))
+  {
+    return a.get() != reference_storage_get(b);
+  }
+
+  //! The type a `result` stores its value as.
+  template <class R> struct result_stored_value
+  {
+    using type = R;
+  };
+  template <class R> struct result_stored_value<R &>
+  {
+    using type = reference_storage<R>;
+  };
+
   //! The base implementation type of `result<R, EC, NoValuePolicy>`.
-  template <class R, class EC, class NoValuePolicy>                                                                                                          //
-  OUTCOME_REQUIRES(type_can_be_used_in_result<R> &&type_can_be_used_in_result<EC> && (std::is_void<EC>::value || std::is_default_constructible<EC>::value))  //
+  template <class R, class EC, class NoValuePolicy>                            //
+  OUTCOME_REQUIRES(usable_as_result_value<R> &&usable_as_result_status<EC>)  //
   class result_storage
   {
-    static_assert(type_can_be_used_in_result<R>, "The type R cannot be used in a result");
+    static_assert(value_type_can_be_used_in_result<R>, "The type R cannot be used in a result");
     static_assert(type_can_be_used_in_result<EC>, "The type S cannot be used in a result");
     static_assert(std::is_void<EC>::value || std::is_default_constructible<EC>::value, "The type S must be void or default constructible");
 
     friend NoValuePolicy;
+    friend typename detail::unhooked_policy<NoValuePolicy>::type;
     friend struct policy::detail::base;
     template <class T, class U, class V> friend class result_storage;
     template <class T, class U, class V> friend class result_final;
@@ -195,22 +407,149 @@ namespace detail
     };
 
   protected:
-    using _value_type = std::conditional_t<std::is_same<R, EC>::value, disable_in_place_value_type, R>;
+    using _value_type = std::conditional_t<std::is_same<R, EC>::value, disable_in_place_value_type, typename result_stored_value<R>::type>;
     using _error_type = std::conditional_t<std::is_same<R, EC>::value, disable_in_place_error_type, EC>;
+    // The policy actually in use, which may extend the one whose code is running, see policy::with_hooks
+    using _no_value_policy_type = NoValuePolicy;
+
+    // True if the value and the error share one union, see trait::disjoint_storage
+    static constexpr bool _disjoint = trait::disjoint_storage<R, EC>::value && !std::is_void<R>::value && !std::is_void<EC>::value && !std::is_same<R, EC>::value  //
+                                      && std::is_trivially_copyable<detail::devoid<R>>::value && std::is_trivially_copyable<detail::devoid<EC>>::value;
+    using _state_type = typename detail::value_storage_select_state<_value_type, _error_type, _disjoint>::type;
+    struct _disjoint_error_placeholder
+    {
+    };
+    using _error_storage_type = std::conditional_t<_disjoint, _disjoint_error_placeholder, detail::devoid<_error_type>>;
 
 #ifdef STANDARDESE_IS_IN_THE_HOUSE
     detail::value_storage_trivial<_value_type> _state;
+#elif defined(OUTCOME_ENABLE_COMPACT_STATUS)
+    // Lets the error reuse the tail padding after the status byte
+    OUTCOME_NO_UNIQUE_ADDRESS _state_type _state;
 #else
-    detail::value_storage_select_impl<_value_type> _state;
+    _state_type _state;
 #endif
-    detail::devoid<_error_type> _error;
+    // Occupies no storage if the error lives inside _state
+    OUTCOME_NO_UNIQUE_ADDRESS _error_storage_type _error;
 
   public:
     // Used by iostream support to access state
-    detail::value_storage_select_impl<_value_type> &__state() { return _state; }
-    const detail::value_storage_select_impl<_value_type> &__state() const { return _state; }
+    _state_type &__state() { return _state; }
+    const _state_type &__state() const { return _state; }
+    // Used by trait::is_c_layout_compatible to find the error
+    static constexpr size_t __error_offset() noexcept { return offsetof(result_storage, _error); }
+
+  protected:
+    template <bool Disjoint, class = void> struct _error_access
+    {
+      template <class Self> static constexpr auto &get(Self &self) noexcept { return self._error; }
+    };
+    template <class Dummy> struct _error_access<true, Dummy>
+    {
+      template <class Self> static constexpr auto &get(Self &self) noexcept { return self._state._error; }  // NOLINT
+    };
+    //! The error, wherever the layout keeps it. Only valid if errored in the disjoint layout.
+    constexpr detail::devoid<_error_type> &_error_ref() & noexcept { return _error_access<_disjoint>::get(*this); }
+    constexpr const detail::devoid<_error_type> &_error_ref() const &noexcept { return _error_access<_disjoint>::get(*this); }
+    constexpr detail::devoid<_error_type> &&_error_ref() && noexcept { return std::move(_error_access<_disjoint>::get(*this)); }
+    constexpr const detail::devoid<_error_type> &&_error_ref() const &&noexcept { return std::move(_error_access<_disjoint>::get(*this)); }
+    //! True if `_error_ref()` refers to a live error.
+    constexpr bool _has_error_storage() const noexcept { return !_disjoint || (_state.status() & detail::status_have_error) != 0; }
+
+    // True if resetting an error to default constructed after emplacing a value cannot throw
+    static constexpr bool _is_nothrow_error_reset = _disjoint || (std::is_nothrow_default_constructible<detail::devoid<_error_type>>::value && std::is_nothrow_move_assignable<detail::devoid<_error_type>>::value);
+    //! Replaces any value or error with a value constructed in place. See `result::emplace()`.
+    template <class... Args> OUTCOME_CONSTEXPR20 void _emplace_value(Args &&... args)
+    {
+      const status_bitfield_type status = _state.status();
+      _destroy_value(std::is_trivially_destructible<_state_type>());
+      _construct_value(std::is_void<R>(), std::forward<Args>(args)...);
+      _state.set_status(detail::status_have_value);
+      if((status & detail::status_have_error) != 0)
+      {
+        _reset_error(std::integral_constant<bool, _disjoint>());
+      }
+    }
+    //! Replaces any value or error with an error constructed in place. See `result::emplace_error()`.
+    template <class... Args> OUTCOME_CONSTEXPR20 void _emplace_error(Args &&... args)
+    {
+      _destroy_value(std::is_trivially_destructible<_state_type>());
+      _construct_error(std::integral_constant<bool, _disjoint>(), std::forward<Args>(args)...);
+      _state.set_status(detail::status_have_error);
+      detail::_set_error_is_errno(_state, _error_ref());
+    }
+
+    // True if swapping the state cannot throw, which includes values relocated by copying their bytes
+    static constexpr bool _is_nothrow_state_swap = std::is_trivially_copyable<_state_type>::value || trait::is_move_bitcopying<detail::devoid<_value_type>>::value  //
+                                                   || (std::is_nothrow_move_constructible<detail::devoid<_value_type>>::value && detail::is_nothrow_swappable<detail::devoid<_value_type>>::value);
+    static constexpr bool _is_nothrow_error_swap = detail::is_nothrow_swappable<_error_storage_type>::value;
+    /*! Swaps the state and, only if either side is errored, the separately stored error, as otherwise
+    both errors are unused defaults. If only one of the two swaps can throw it is done first, so a throw
+    changes nothing, else a throwing error swap swaps the state back. See `result::swap()`.
+    */
+    OUTCOME_CONSTEXPR20 void _swap_state_and_error(result_storage &o) noexcept(_is_nothrow_state_swap &&_is_nothrow_error_swap)
+    {
+      if(_disjoint || ((_state.status() | o._state.status()) & detail::status_have_error) == 0)
+      {
+        _state.swap(o._state);
+        return;
+      }
+      _swap_state_and_error(o, std::integral_constant<int, _is_nothrow_error_swap ? 0 : (_is_nothrow_state_swap ? 1 : 2)>());
+    }
+
+  private:
+    OUTCOME_CONSTEXPR20 void _swap_state_and_error(result_storage &o, std::integral_constant<int, 0> /*unused*/)
+    {
+      using std::swap;
+      _state.swap(o._state);
+      swap(_error, o._error);
+    }
+    OUTCOME_CONSTEXPR20 void _swap_state_and_error(result_storage &o, std::integral_constant<int, 1> /*unused*/)
+    {
+      using std::swap;
+      swap(_error, o._error);
+      _state.swap(o._state);
+    }
+    OUTCOME_CONSTEXPR20 void _swap_state_and_error(result_storage &o, std::integral_constant<int, 2> /*unused*/)
+    {
+      using std::swap;
+      _state.swap(o._state);
+#ifdef __cpp_exceptions
+      try
+      {
+        swap(_error, o._error);
+      }
+      catch(...)
+      {
+        _state.swap(o._state);
+        throw;
+      }
+#else
+      swap(_error, o._error);
+#endif
+    }
+
+    // Whichever the layout, a value which throws on construction leaves behind no value, and any error as it was
+    OUTCOME_CONSTEXPR20 void _destroy_value(std::true_type /*unused*/) noexcept { _state.set_status(_state.status() & ~detail::status_have_value); }
+    OUTCOME_CONSTEXPR20 void _destroy_value(std::false_type /*unused*/) noexcept
+    {
+      if((_state.status() & detail::status_have_value) != 0)
+      {
+        using value_type = typename _state_type::value_type;
+        _state._value.~value_type();  // NOLINT
+        _state.set_status(_state.status() & ~detail::status_have_value);
+      }
+    }
+    OUTCOME_CONSTEXPR20 void _construct_value(std::true_type /*unused*/) noexcept {}
+    template <class... Args> OUTCOME_CONSTEXPR20 void _construct_value(std::false_type /*unused*/, Args &&... args) { detail::construct_value_at(std::addressof(_state._value), std::forward<Args>(args)...); }
+    // The disjoint layout overwrote the error with the value
+    OUTCOME_CONSTEXPR20 void _reset_error(std::true_type /*unused*/) noexcept {}
+    OUTCOME_CONSTEXPR20 void _reset_error(std::false_type /*unused*/) noexcept(_is_nothrow_error_reset) { _error = detail::devoid<_error_type>(); }
+    template <class... Args> OUTCOME_CONSTEXPR20 void _construct_error(std::true_type /*unused*/, Args &&... args) { detail::construct_value_at(std::addressof(_state._error), std::forward<Args>(args)...); }
+    template <class... Args> OUTCOME_CONSTEXPR20 void _construct_error(std::false_type /*unused*/, Args &&... args) { _error = detail::devoid<_error_type>(std::forward<Args>(args)...); }
 
   protected:
+
     result_storage() = default;
     result_storage(const result_storage &) = default;             // NOLINT
     result_storage(result_storage &&) = default;                  // NOLINT
@@ -230,49 +569,115 @@ namespace detail
         , _error()
     {
     }
+    // Uses-allocator construction of any value, see value_storage_nontrivial
+    template <class Alloc, class... Args>
+    OUTCOME_CONSTEXPR20 result_storage(std::allocator_arg_t _, const Alloc &a, in_place_type_t<_value_type> t, Args &&... args)
+        : _state{_, a, t, std::forward<Args>(args)...}
+        , _error()
+    {
+    }
+    template <class Alloc>
+    OUTCOME_CONSTEXPR20 result_storage(std::allocator_arg_t _, const Alloc &a, const result_storage &o)
+        : _state{_, a, o._state}
+        , _error(o._error)
+    {
+    }
+    template <class Alloc>
+    OUTCOME_CONSTEXPR20 result_storage(std::allocator_arg_t _, const Alloc &a, result_storage &&o)
+        : _state{_, a, std::move(o._state)}
+        , _error(std::move(o._error))
+    {
+    }
     template <class... Args>
-    constexpr explicit result_storage(in_place_type_t<_error_type> /*unused*/, Args &&... args) noexcept(std::is_nothrow_constructible<_error_type, Args...>::value)
-        : _state{detail::status_have_error}
-        , _error(std::forward<Args>(args)...)
+    constexpr explicit result_storage(in_place_type_t<_error_type> _, Args &&... args) noexcept(std::is_nothrow_constructible<_error_type, Args...>::value)
+        : result_storage(_layout_tag<_disjoint>(), _, std::forward<Args>(args)...)
     {
-      detail::_set_error_is_errno(_state, _error);
     }
     template <class U, class... Args>
-    constexpr result_storage(in_place_type_t<_error_type> /*unused*/, std::initializer_list<U> il, Args &&... args) noexcept(std::is_nothrow_constructible<_error_type, std::initializer_list<U>, Args...>::value)
-        : _state{detail::status_have_error}
-        , _error{il, std::forward<Args>(args)...}
+    constexpr result_storage(in_place_type_t<_error_type> _, std::initializer_list<U> il, Args &&... args) noexcept(std::is_nothrow_constructible<_error_type, std::initializer_list<U>, Args...>::value)
+        : result_storage(_layout_tag<_disjoint>(), _, il, std::forward<Args>(args)...)
     {
-      detail::_set_error_is_errno(_state, _error);
     }
     struct compatible_conversion_tag
     {
     };
     template <class T, class U, class V>
     constexpr result_storage(compatible_conversion_tag /*unused*/, const result_storage<T, U, V> &o) noexcept(std::is_nothrow_constructible<_value_type, T>::value &&std::is_nothrow_constructible<_error_type, U>::value)
-        : _state(o._state)
-        , _error(o._error)
+        : result_storage(_conversion_tag<_disjoint, result_storage<T, U, V>::_disjoint>(), o._state, o._error_ref())
     {
     }
     template <class T, class V>
     constexpr result_storage(compatible_conversion_tag /*unused*/, const result_storage<T, void, V> &o) noexcept(std::is_nothrow_constructible<_value_type, T>::value)
-        : _state(o._state)
-        , _error(_error_type{})
+        : result_storage(_conversion_tag<_disjoint, false>(), o._state, _error_type{})
     {
     }
     template <class T, class U, class V>
     constexpr result_storage(compatible_conversion_tag /*unused*/, result_storage<T, U, V> &&o) noexcept(std::is_nothrow_constructible<_value_type, T>::value &&std::is_nothrow_constructible<_error_type, U>::value)
-        : _state(std::move(o._state))
-        , _error(std::move(o._error))
+        : result_storage(_conversion_tag<_disjoint, result_storage<T, U, V>::_disjoint>(), std::move(o._state), std::move(o)._error_ref())
     {
     }
     template <class T, class V>
     constexpr result_storage(compatible_conversion_tag /*unused*/, result_storage<T, void, V> &&o) noexcept(std::is_nothrow_constructible<_value_type, T>::value)
-        : _state(std::move(o._state))
-        , _error(_error_type{})
+        : result_storage(_conversion_tag<_disjoint, false>(), std::move(o._state), _error_type{})
+    {
+    }
+
+  private:
+    template <bool Disjoint> struct _layout_tag
+    {
+    };
+    template <bool Disjoint, bool SourceDisjoint> struct _conversion_tag
+    {
+    };
+    template <class... Args>
+    constexpr result_storage(_layout_tag<false> /*unused*/, in_place_type_t<_error_type> /*unused*/, Args &&... args)
+        : _state{detail::status_have_error}
+        , _error(std::forward<Args>(args)...)
+    {
+      detail::_set_error_is_errno(_state, _error);
+    }
+    template <class... Args>
+    constexpr result_storage(_layout_tag<true> /*unused*/, in_place_type_t<_error_type> _, Args &&... args)
+        : _state{_, std::forward<Args>(args)...}
+        , _error()
+    {
+      detail::_set_error_is_errno(_state, _state._error);
+    }
+    // A source in the disjoint layout only has an error to read if it is errored
+    template <class State, class Error>
+    constexpr result_storage(_conversion_tag<false, false> /*unused*/, State &&state, Error &&error)
+        : _state(std::forward<State>(state))
+        , _error(std::forward<Error>(error))
+    {
+    }
+    template <class State, class Error>
+    constexpr result_storage(_conversion_tag<false, true> /*unused*/, State &&state, Error &&error)
+        : _state(std::forward<State>(state))
+        , _error(((state.status() & detail::status_have_error) != 0) ? _error_type(std::forward<Error>(error)) : _error_type())
+    {
+    }
+    template <class State, class Error>
+    constexpr result_storage(_conversion_tag<true, false> /*unused*/, State &&state, Error &&error)
+        : _state(std::forward<State>(state), std::forward<Error>(error))
+        , _error()
+    {
+    }
+    template <class State, class Error>
+    constexpr result_storage(_conversion_tag<true, true> /*unused*/, State &&state, Error && /*unused*/)
+        : _state(std::forward<State>(state))
+        , _error()
     {
     }
   };
 }  // namespace detail
+namespace trait
+{
+  //! A `result` can be relocated by `memcpy()` if its value and error types can.
+  template <class R, class EC, class NoValuePolicy> struct is_move_bitcopying<OUTCOME_V2_NAMESPACE::detail::result_storage<R, EC, NoValuePolicy>>
+  {
+    static constexpr bool value = is_move_bitcopying<OUTCOME_V2_NAMESPACE::detail::devoid<typename OUTCOME_V2_NAMESPACE::detail::result_stored_value<R>::type>>::value && is_move_bitcopying<OUTCOME_V2_NAMESPACE::detail::devoid<EC>>::value;
+  };
+}  // namespace trait
 OUTCOME_V2_NAMESPACE_END
 
 #endif
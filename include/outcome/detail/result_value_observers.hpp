@@ -67,6 +67,14 @@ namespace detail
       NoValuePolicy::narrow_value_check(static_cast<const result_value_observers &&>(*this));
       return std::move(this->_state._value);  // NOLINT
     }
+    /*! Access value, or `fallback` if there is none, without copying either.
+    \returns Reference to the held `value_type`, or to `fallback`, chosen without branching.
+    \remarks `fallback` must outlive the reference returned.
+    \group assume_value_or
+    */
+    constexpr value_type &assume_value_or(value_type &fallback) & noexcept { return *(((this->_state.status() & status_have_value) != 0) ? &this->_state._value : &fallback); }  // NOLINT
+    /// \group assume_value_or
+    constexpr const value_type &assume_value_or(const value_type &fallback) const &noexcept { return *(((this->_state.status() & status_have_value) != 0) ? &this->_state._value : &fallback); }  // NOLINT
 
     /// \output_section Wide state observers
     /*! Access value with runtime checks.
@@ -77,27 +85,94 @@ namespace detail
     constexpr value_type &value() &
     {
       NoValuePolicy::wide_value_check(static_cast<result_value_observers &>(*this));
-      return this->_state._value;  // NOLINT
+      return wide_value_or_fallback<NoValuePolicy>((this->_state.status() & status_have_value) != 0, this->_state._value);  // NOLINT
     }
     /// \group value
     constexpr const value_type &value() const &
     {
       NoValuePolicy::wide_value_check(static_cast<const result_value_observers &>(*this));
-      return this->_state._value;  // NOLINT
+      return wide_value_or_fallback<NoValuePolicy>((this->_state.status() & status_have_value) != 0, this->_state._value);  // NOLINT
     }
     /// \group value
     constexpr value_type &&value() &&
     {
       NoValuePolicy::wide_value_check(static_cast<result_value_observers &&>(*this));
-      return std::move(this->_state._value);  // NOLINT
+      return std::move(wide_value_or_fallback<NoValuePolicy>((this->_state.status() & status_have_value) != 0, this->_state._value));  // NOLINT
     }
     /// \group value
     constexpr const value_type &&value() const &&
     {
       NoValuePolicy::wide_value_check(static_cast<const result_value_observers &&>(*this));
-      return std::move(this->_state._value);  // NOLINT
+      return std::move(wide_value_or_fallback<NoValuePolicy>((this->_state.status() & status_have_value) != 0, this->_state._value));  // NOLINT
+    }
+    /*! Access value, or `fallback` if there is none, without calling `NoValuePolicy`.
+    \returns A copy of the held `value_type`, or `fallback` converted to `value_type`.
+    \remarks Trivially copyable values of up to two pointers are chosen without branching.
+    \group value_or
+    */
+    OUTCOME_TEMPLATE(class U)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_convertible<U, value_type>::value))
+    constexpr value_type value_or(U &&fallback) const & { return select_or<value_type>((this->_state.status() & status_have_value) != 0, this->_state._value, std::forward<U>(fallback)); }  // NOLINT
+    /// \group value_or
+    OUTCOME_TEMPLATE(class U)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_convertible<U, value_type>::value))
+    constexpr value_type value_or(U &&fallback) && { return select_or<value_type>((this->_state.status() & status_have_value) != 0, std::move(this->_state._value), std::forward<U>(fallback)); }  // NOLINT
+    /*! Access value, or what `f()` returns if there is none, without calling `NoValuePolicy`.
+    \returns A copy of the held `value_type`, or `f()` converted to `value_type`. `f` is only called if there is no value.
+    \group value_or_else
+    */
+    template <class F> constexpr value_type value_or_else(F &&f) const &
+    {
+      if((this->_state.status() & status_have_value) != 0)
+      {
+        return this->_state._value;  // NOLINT
+      }
+      return static_cast<value_type>(f());
+    }
+    /// \group value_or_else
+    template <class F> constexpr value_type value_or_else(F &&f) &&
+    {
+      if((this->_state.status() & status_have_value) != 0)
+      {
+        return std::move(this->_state._value);  // NOLINT
+      }
+      return static_cast<value_type>(f());
     }
   };
+  /* The value observers of `result<R &, EC, NoValuePolicy>`, which return the reference held. As for
+  a reference, the constness of the result does not pass through to the object referred to.
+  */
+  template <class Base, class R, class NoValuePolicy> class result_value_observers<Base, R &, NoValuePolicy> : public Base
+  {
+  public:
+    using value_type = R &;
+    using Base::Base;
+
+    /// \output_section Narrow state observers
+    /*! Access the object referred to without runtime checks.
+    \preconditions The result to have a successful state, otherwise it is undefined behaviour.
+    \returns The reference held.
+    */
+    constexpr value_type assume_value() const noexcept
+    {
+      NoValuePolicy::narrow_value_check(*this);
+      return this->_state._value.get();  // NOLINT
+    }
+    /// \output_section Wide state observers
+    /*! Access the object referred to with runtime checks.
+    \returns The reference held.
+    \requires The result to have a successful state, else whatever `NoValuePolicy` says ought to happen.
+    */
+    constexpr value_type value() const
+    {
+      NoValuePolicy::wide_value_check(*this);
+      return wide_value_or_fallback<NoValuePolicy>((this->_state.status() & status_have_value) != 0, this->_state._value).get();  // NOLINT
+    }
+    /*! Access the object referred to, or `fallback` if there is none, without calling `NoValuePolicy`.
+    \returns The reference held, or `fallback`.
+    */
+    constexpr value_type value_or(value_type fallback) const noexcept { return ((this->_state.status() & status_have_value) != 0) ? this->_state._value.get() : fallback; }  // NOLINT
+  };
   template <class Base, class NoValuePolicy> class result_value_observers<Base, void, NoValuePolicy> : public Base
   {
   public:
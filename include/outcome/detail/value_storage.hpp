@@ -28,8 +28,13 @@ http://www.boost.org/LICENSE_1_0.txt)
 #include "../config.hpp"
 
 #include <cstdint>  // for uint32_t etc
+#include <cstring>  // for memcpy
 #include <initializer_list>
+#ifndef OUTCOME_RESULT_LITE
 #include <iosfwd>  // for serialisation
+#endif
+#include <limits>
+#include <memory>  // for construct_at, uses_allocator
 #include <type_traits>
 #include <utility>  // for in_place_type_t
 
@@ -48,6 +53,102 @@ template <class T> struct in_place_type_t
 template <class T> constexpr in_place_type_t<T> in_place_type{};
 #endif
 
+namespace trait
+{
+  /*! Customisation point for types with bit patterns which a valid value never has (a "niche").
+  Specialise this to inherit from one of `niche_pointer<T>`, `niche_enum<E, first_unused>` or `niche_nan<T>`,
+  or supply your own `constexpr bool value`, `is_niche(const T &)`, `encode(uint32_t)` and
+  `decode(const T &)`. `result` and `outcome` will then store their status inside the niche of their
+  value type, so `sizeof(result<T, E>)` does not pay for a separate status word.
+
+  `encode()` receives a status which never has the have-value bit set, and must return a `T` for which
+  `is_niche()` is true and from which `decode()` returns the same status. Only the bottom eight bits
+  of status must round trip, so spare storage is best effort in types with small niches, and is
+  always unavailable whilst a niche packed result is valued.
+  */
+  template <class T> struct niche
+  {
+    static constexpr bool value = false;
+  };
+  //! True if the type `T` has opted into niche packed storage.
+  template <class T> constexpr bool has_niche_v = niche<T>::value;
+
+  /*! Niche implementation for pointers to types with an alignment of at least two. A set bottom
+  bit marks the niche, the status lives in the remaining bits.
+  */
+  template <class T> struct niche_pointer
+  {
+    static_assert(std::is_pointer<T>::value, "niche_pointer<T> requires T to be a pointer");
+    static_assert(alignof(std::remove_pointer_t<T>) >= 2, "niche_pointer<T> requires the pointee to have an alignment of at least two");
+    static constexpr bool value = true;
+    static bool is_niche(const T &v) noexcept { return (reinterpret_cast<uintptr_t>(v) & 1U) != 0; }           // NOLINT
+    static T encode(uint32_t status) noexcept { return reinterpret_cast<T>((static_cast<uintptr_t>(status) << 1U) | 1U); }  // NOLINT
+    static uint32_t decode(const T &v) noexcept { return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(v) >> 1U); }    // NOLINT
+  };
+
+  /*! Niche implementation for enums whose underlying values from `first_unused` upwards are never used
+  by a valid value. At least 128 unused values are required.
+  */
+  template <class E, std::underlying_type_t<E> first_unused> struct niche_enum
+  {
+    using underlying_type = std::underlying_type_t<E>;
+    static_assert(std::is_enum<E>::value, "niche_enum<E> requires E to be an enum");
+    static_assert(first_unused <= std::numeric_limits<underlying_type>::max() - 127, "niche_enum<E> requires at least 128 unused values");
+    static constexpr bool value = true;
+    static constexpr bool is_niche(const E &v) noexcept { return static_cast<underlying_type>(v) >= first_unused; }
+    static constexpr E encode(uint32_t status) noexcept { return static_cast<E>(first_unused + static_cast<underlying_type>((status & 0xffU) >> 1U)); }
+    static constexpr uint32_t decode(const E &v) noexcept { return static_cast<uint32_t>(static_cast<underlying_type>(v) - first_unused) << 1U; }
+  };
+
+  /*! Niche implementation for IEEE 754 `double` which reserves the signalling NaNs with the top sixteen
+  bits `0x7ff4`. Arithmetic never produces these, but beware of x87 loads quieting them.
+  */
+  template <class T> struct niche_nan
+  {
+    static_assert(std::is_same<T, double>::value && std::numeric_limits<double>::is_iec559, "niche_nan<T> requires T to be an IEEE 754 double");
+    static constexpr bool value = true;
+    static constexpr uint64_t marker = 0x7ff4000000000000ULL;
+    static uint64_t _bits(const T &v) noexcept
+    {
+      uint64_t ret;
+      memcpy(&ret, &v, sizeof(ret));
+      return ret;
+    }
+    static bool is_niche(const T &v) noexcept { return (_bits(v) >> 48U) == (marker >> 48U); }
+    static T encode(uint32_t status) noexcept
+    {
+      uint64_t bits = marker | status;
+      T ret;
+      memcpy(&ret, &bits, sizeof(ret));
+      return ret;
+    }
+    static uint32_t decode(const T &v) noexcept { return static_cast<uint32_t>(_bits(v)); }
+  };
+
+  /*! Customisation point to opt a `result<R, EC>` into the disjoint storage layout, where `R` and `EC`
+  share one union and the status says which is live. Only takes effect if both `R` and `EC` are
+  trivially copyable. A disjoint `result` does not carry a default constructed `EC` whilst valued,
+  so it is up to `min(sizeof(R), sizeof(EC))` smaller, and it is never valued and errored at once.
+  */
+  template <class R, class EC> struct disjoint_storage
+  {
+    static constexpr bool value = false;
+  };
+
+  /*! Customisation point for types which can be relocated by copying their bytes to new storage and
+  then forgetting the old storage without running its destructor. Defaults to true for trivially
+  copyable types, specialise it for types such as owning pointers. `result` and `outcome` are
+  bitcopying if all their component types are, so containers may grow blocks of them with `memcpy()`.
+  Note that relocation does not invoke the move construction hooks.
+  */
+  template <class T> struct is_move_bitcopying
+  {
+    static constexpr bool value = std::is_trivially_copyable<T>::value;
+  };
+  //! True if `T` has opted into being relocated by `memcpy()`.
+  template <class T> constexpr bool is_move_bitcopying_v = is_move_bitcopying<T>::value;
+}  // namespace trait
+
 namespace detail
 {
   // Test if type is an in_place_type_t
@@ -58,35 +159,52 @@ namespace detail
   {
   };
 
+#ifdef OUTCOME_ENABLE_COMPACT_STATUS
+  // Only the bottom eight bits, there is no spare storage
+  using status_bitfield_type = uint8_t;
+#else
   using status_bitfield_type = uint32_t;
+#endif
   static constexpr status_bitfield_type status_have_value = (1U << 0U);
   static constexpr status_bitfield_type status_have_error = (1U << 1U);
   static constexpr status_bitfield_type status_have_exception = (1U << 2U);
   static constexpr status_bitfield_type status_error_is_errno = (1U << 4U);  // can errno be set from this error?
   // bit 7 unused
+#ifndef OUTCOME_ENABLE_COMPACT_STATUS
   // bits 8-15 unused
   // bits 16-31 used for user supplied 16 bit value
   static constexpr status_bitfield_type status_2byte_shift = 16;
   static constexpr status_bitfield_type status_2byte_mask = (0xffffU << status_2byte_shift);
+#endif
+  /* The status stored next to something aligned to `Align`, which is the full status if it fits in the
+  padding `std::optional` would also pay for, else the bottom eight bits only, without spare storage.
+  */
+  template <size_t Align> using compact_status_bitfield_type = std::conditional_t<(Align >= sizeof(status_bitfield_type)), status_bitfield_type, uint8_t>;
+
+  template <class T, class Niche> struct value_storage_niche;
+  template <class T, class E> struct value_storage_disjoint;
 
   // Used if T is trivial
-  template <class T> struct value_storage_trivial
+  template <class T, class Status = status_bitfield_type> struct value_storage_trivial
   {
     using value_type = T;
     union {
       empty_type _empty;
       devoid<T> _value;
     };
-    status_bitfield_type _status{0};
+#ifdef OUTCOME_ENABLE_TRIVIAL_STORAGE
+    // Default initialisation leaves the bits alone, value initialisation zeroes them and zero means empty
+    Status _status;
+    value_storage_trivial() = default;
+#else
+    Status _status{0};
     constexpr value_storage_trivial() noexcept : _empty{} {}
+#endif
     // Special from-void catchall constructor, always constructs default T irrespective of whether void is valued or not (can do no better if T cannot be copied)
-    struct disable_void_catchall
-    {
-    };
-    using void_value_storage_trivial = std::conditional_t<std::is_void<T>::value, disable_void_catchall, value_storage_trivial<void>>;
-    explicit constexpr value_storage_trivial(const void_value_storage_trivial &o) noexcept(std::is_nothrow_default_constructible<value_type>::value)
+    template <class S>
+    explicit constexpr value_storage_trivial(const value_storage_trivial<void, S> &o) noexcept(std::is_nothrow_default_constructible<value_type>::value)
         : _value()
-        , _status(o._status)
+        , _status(static_cast<Status>(o._status))
     {
     }
     value_storage_trivial(const value_storage_trivial &) = default;             // NOLINT
@@ -94,9 +212,12 @@ namespace detail
     value_storage_trivial &operator=(const value_storage_trivial &) = default;  // NOLINT
     value_storage_trivial &operator=(value_storage_trivial &&) = default;       // NOLINT
     ~value_storage_trivial() = default;
+    constexpr status_bitfield_type status() const noexcept { return _status; }
+    // Any spare storage which does not fit into Status is dropped
+    constexpr void set_status(status_bitfield_type status) noexcept { _status = static_cast<Status>(status); }
     constexpr explicit value_storage_trivial(status_bitfield_type status)
         : _empty()
-        , _status(status)
+        , _status(static_cast<Status>(status))
     {
     }
     template <class... Args>
@@ -111,20 +232,73 @@ namespace detail
         , _status(status_have_value)
     {
     }
-    template <class U> static constexpr bool enable_converting_constructor = !std::is_same<std::decay_t<U>, value_type>::value && std::is_constructible<value_type, U>::value;
-    OUTCOME_TEMPLATE(class U)
+    // Converts from another value type, or from the same value type with a different width of status
+    template <class U, class S = Status> static constexpr bool enable_converting_constructor = (!std::is_same<std::decay_t<U>, value_type>::value || !std::is_same<S, Status>::value) && std::is_constructible<value_type, U>::value;
+    /* A scalar converts to a scalar without side effects, so rather than branching on the status to
+    construct the value or not, the converted value or a zero is selected, and the status copied as is.
+    */
+    template <class U> struct select_converting_tag
+    {
+    };
+    template <class U> using converting_tag = select_converting_tag<std::integral_constant<bool, std::is_scalar<value_type>::value && std::is_scalar<U>::value>>;
+    template <class Source> static constexpr value_type select_converted_value(const Source &o) noexcept
+    {
+      const bool valued = (o._status & status_have_value) != 0;
+#ifdef OUTCOME_HAVE_BUILTIN_IS_CONSTANT_EVALUATED
+      if(!__builtin_is_constant_evaluated())
+      {
+        // The bytes are read whether valued or not, so the compiler need not branch around the read
+        typename Source::value_type v{};
+        memcpy(&v, &o._value, sizeof(v));
+        return valued ? static_cast<value_type>(v) : value_type();
+      }
+#endif
+      return valued ? static_cast<value_type>(o._value) : value_type();
+    }
+    template <class Source>
+    constexpr value_storage_trivial(select_converting_tag<std::true_type> /*unused*/, const Source &o) noexcept
+        : _value(select_converted_value(o))
+        , _status(static_cast<Status>(o._status))
+    {
+    }
+    template <class Source>
+    constexpr value_storage_trivial(select_converting_tag<std::false_type> /*unused*/, Source &&o) noexcept(std::is_nothrow_constructible<value_type, decltype(static_cast<Source &&>(o)._value)>::value)
+        : value_storage_trivial(((o._status & status_have_value) != 0) ? value_storage_trivial(in_place_type<value_type>, static_cast<Source &&>(o)._value) : value_storage_trivial())  // NOLINT
+    {
+      _status = static_cast<Status>(o._status);
+    }
+    OUTCOME_TEMPLATE(class U, class S)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(enable_converting_constructor<U, S>))
+    constexpr explicit value_storage_trivial(const value_storage_trivial<U, S> &o) noexcept(std::is_nothrow_constructible<value_type, U>::value)
+        : value_storage_trivial(converting_tag<U>(), o)
+    {
+    }
+    OUTCOME_TEMPLATE(class U, class S)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(enable_converting_constructor<U, S>))
+    constexpr explicit value_storage_trivial(value_storage_trivial<U, S> &&o) noexcept(std::is_nothrow_constructible<value_type, U>::value)
+        : value_storage_trivial(converting_tag<U>(), std::move(o))
+    {
+    }
+    OUTCOME_TEMPLATE(class U, class N)
     OUTCOME_TREQUIRES(OUTCOME_TPRED(enable_converting_constructor<U>))
-    constexpr explicit value_storage_trivial(const value_storage_trivial<U> &o) noexcept(std::is_nothrow_constructible<value_type, U>::value)
-        : value_storage_trivial(((o._status & status_have_value) != 0) ? value_storage_trivial(in_place_type<value_type>, o._value) : value_storage_trivial())  // NOLINT
+    constexpr explicit value_storage_trivial(const value_storage_niche<U, N> &o) noexcept(std::is_nothrow_constructible<value_type, U>::value)
+        : value_storage_trivial(((o.status() & status_have_value) != 0) ? value_storage_trivial(in_place_type<value_type>, o._value) : value_storage_trivial())  // NOLINT
     {
-      _status = o._status;
+      _status = static_cast<Status>(o.status());
     }
-    OUTCOME_TEMPLATE(class U)
+    OUTCOME_TEMPLATE(class U, class N)
     OUTCOME_TREQUIRES(OUTCOME_TPRED(enable_converting_constructor<U>))
-    constexpr explicit value_storage_trivial(value_storage_trivial<U> &&o) noexcept(std::is_nothrow_constructible<value_type, U>::value)
-        : value_storage_trivial(((o._status & status_have_value) != 0) ? value_storage_trivial(in_place_type<value_type>, std::move(o._value)) : value_storage_trivial())  // NOLINT
+    constexpr explicit value_storage_trivial(value_storage_niche<U, N> &&o) noexcept(std::is_nothrow_constructible<value_type, U>::value)
+        : value_storage_trivial(((o.status() & status_have_value) != 0) ? value_storage_trivial(in_place_type<value_type>, std::move(o._value)) : value_storage_trivial())  // NOLINT
     {
-      _status = o._status;
+      _status = static_cast<Status>(o.status());
+    }
+    OUTCOME_TEMPLATE(class U, class F)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_constructible<value_type, U>::value))
+    constexpr explicit value_storage_trivial(const value_storage_disjoint<U, F> &o) noexcept(std::is_nothrow_constructible<value_type, U>::value)
+        : value_storage_trivial(((o._status & status_have_value) != 0) ? value_storage_trivial(in_place_type<value_type>, o._value) : value_storage_trivial())  // NOLINT
+    {
+      _status = static_cast<Status>(o._status);
     }
     constexpr void swap(value_storage_trivial &o)
     {
@@ -133,96 +307,232 @@ namespace detail
       swap(*this, o);
     }
   };
+  // Used if T is void, there being no value only the status takes up storage
+  template <class Status> struct value_storage_trivial<void, Status>
+  {
+    using value_type = void;
+    OUTCOME_NO_UNIQUE_ADDRESS devoid<void> _value;
+#ifdef OUTCOME_ENABLE_TRIVIAL_STORAGE
+    // Default initialisation leaves the bits alone, value initialisation zeroes them and zero means empty
+    Status _status;
+    value_storage_trivial() = default;
+#else
+    Status _status{0};
+    constexpr value_storage_trivial() noexcept : _value{} {}
+#endif
+    value_storage_trivial(const value_storage_trivial &) = default;             // NOLINT
+    value_storage_trivial(value_storage_trivial &&) = default;                  // NOLINT
+    value_storage_trivial &operator=(const value_storage_trivial &) = default;  // NOLINT
+    value_storage_trivial &operator=(value_storage_trivial &&) = default;       // NOLINT
+    ~value_storage_trivial() = default;
+    constexpr status_bitfield_type status() const noexcept { return _status; }
+    // Any spare storage which does not fit into Status is dropped
+    constexpr void set_status(status_bitfield_type status) noexcept { _status = static_cast<Status>(status); }
+    constexpr explicit value_storage_trivial(status_bitfield_type status)
+        : _value()
+        , _status(static_cast<Status>(status))
+    {
+    }
+    template <class... Args>
+    constexpr explicit value_storage_trivial(in_place_type_t<value_type> /*unused*/, Args &&... args) noexcept
+        : _value(std::forward<Args>(args)...)
+        , _status(status_have_value)
+    {
+    }
+    // Converts from the storage of void with a different width of status
+    OUTCOME_TEMPLATE(class S)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(!std::is_same<S, Status>::value))
+    constexpr explicit value_storage_trivial(const value_storage_trivial<void, S> &o) noexcept
+        : _value()
+        , _status(static_cast<Status>(o._status))
+    {
+    }
+    constexpr void swap(value_storage_trivial &o)
+    {
+      // storage is trivial, so just use assignment
+      using std::swap;
+      swap(*this, o);
+    }
+  };
+  // Placement new is not usable in constant evaluation, but std::construct_at is from C++ 20
+  template <class T, class... Args> OUTCOME_CONSTEXPR20 inline void construct_value_at(T *p, Args &&... args) noexcept(std::is_nothrow_constructible<T, Args...>::value)
+  {
+#if defined(__cpp_lib_constexpr_dynamic_alloc) && __cpp_lib_constexpr_dynamic_alloc >= 201907L
+    std::construct_at(p, std::forward<Args>(args)...);
+#else
+    new(p) T(std::forward<Args>(args)...);  // NOLINT
+#endif
+  }
+  /* How uses-allocator construction of a T from Args passes an Alloc, as in the C++ 20
+  std::uninitialized_construct_using_allocator(): not at all if T does not use Alloc, else after a
+  leading std::allocator_arg if T has such a constructor, else last.
+  */
+  template <class T, class Alloc, class... Args>
+  using uses_allocator_construction = std::integral_constant<int, !std::uses_allocator<T, Alloc>::value ? 0 : (std::is_constructible<T, std::allocator_arg_t, const Alloc &, Args...>::value ? 1 : 2)>;
+  template <class T, class Alloc, class... Args> OUTCOME_CONSTEXPR20 inline void construct_value_using_allocator_at(std::integral_constant<int, 0> /*unused*/, T *p, const Alloc & /*unused*/, Args &&... args)
+  {
+    construct_value_at(p, std::forward<Args>(args)...);
+  }
+  template <class T, class Alloc, class... Args> OUTCOME_CONSTEXPR20 inline void construct_value_using_allocator_at(std::integral_constant<int, 1> /*unused*/, T *p, const Alloc &a, Args &&... args)
+  {
+    construct_value_at(p, std::allocator_arg, a, std::forward<Args>(args)...);
+  }
+  template <class T, class Alloc, class... Args> OUTCOME_CONSTEXPR20 inline void construct_value_using_allocator_at(std::integral_constant<int, 2> /*unused*/, T *p, const Alloc &a, Args &&... args)
+  {
+    construct_value_at(p, std::forward<Args>(args)..., a);
+  }
+  // Constructs a T at p from args by uses-allocator construction with a
+  template <class T, class Alloc, class... Args> OUTCOME_CONSTEXPR20 inline void construct_value_using_allocator_at(T *p, const Alloc &a, Args &&... args)
+  {
+    construct_value_using_allocator_at(uses_allocator_construction<T, Alloc, Args...>(), p, a, std::forward<Args>(args)...);
+  }
   // Used if T is non-trivial
-  template <class T> struct value_storage_nontrivial
+  template <class T, class Status = status_bitfield_type> struct value_storage_nontrivial
   {
     using value_type = T;
     union {
       empty_type _empty;
       value_type _value;
     };
-    status_bitfield_type _status{0};
-    value_storage_nontrivial() noexcept : _empty{} {}
+    Status _status{0};
+    constexpr value_storage_nontrivial() noexcept : _empty{} {}
     value_storage_nontrivial &operator=(const value_storage_nontrivial &) = default;                                        // if reaches here, copy assignment is trivial
     value_storage_nontrivial &operator=(value_storage_nontrivial &&) = default;                                             // NOLINT if reaches here, move assignment is trivial
-    value_storage_nontrivial(value_storage_nontrivial &&o) noexcept(std::is_nothrow_move_constructible<value_type>::value)  // NOLINT
-    : _status(o._status)
+    OUTCOME_CONSTEXPR20 value_storage_nontrivial(value_storage_nontrivial &&o) noexcept(std::is_nothrow_move_constructible<value_type>::value)  // NOLINT
+    : _empty{}
+    , _status(o._status)
     {
       if(this->_status & status_have_value)
       {
         this->_status &= ~status_have_value;
-        new(&_value) value_type(std::move(o._value));  // NOLINT
+        construct_value_at(&_value, std::move(o._value));  // NOLINT
         _status = o._status;
       }
     }
-    value_storage_nontrivial(const value_storage_nontrivial &o) noexcept(std::is_nothrow_copy_constructible<value_type>::value)
-        : _status(o._status)
+    OUTCOME_CONSTEXPR20 value_storage_nontrivial(const value_storage_nontrivial &o) noexcept(std::is_nothrow_copy_constructible<value_type>::value)
+        : _empty{}
+        , _status(o._status)
     {
       if(this->_status & status_have_value)
       {
         this->_status &= ~status_have_value;
-        new(&_value) value_type(o._value);  // NOLINT
+        construct_value_at(&_value, o._value);  // NOLINT
         _status = o._status;
       }
     }
     // Special from-void constructor, constructs default T if void valued
-    explicit value_storage_nontrivial(const value_storage_trivial<void> &o) noexcept(std::is_nothrow_default_constructible<value_type>::value)
-        : _status(o._status)
+    template <class S>
+    OUTCOME_CONSTEXPR20 explicit value_storage_nontrivial(const value_storage_trivial<void, S> &o) noexcept(std::is_nothrow_default_constructible<value_type>::value)
+        : _empty{}
+        , _status(static_cast<Status>(o._status))
     {
       if(this->_status & status_have_value)
       {
         this->_status &= ~status_have_value;
-        new(&_value) value_type;  // NOLINT
-        _status = o._status;
+        construct_value_at(&_value);  // NOLINT
+        _status = static_cast<Status>(o._status);
       }
     }
-    explicit value_storage_nontrivial(status_bitfield_type status)
+    constexpr status_bitfield_type status() const noexcept { return _status; }
+    // Any spare storage which does not fit into Status is dropped
+    constexpr void set_status(status_bitfield_type status) noexcept { _status = static_cast<Status>(status); }
+    constexpr explicit value_storage_nontrivial(status_bitfield_type status)
         : _empty()
-        , _status(status)
+        , _status(static_cast<Status>(status))
     {
     }
     template <class... Args>
-    explicit value_storage_nontrivial(in_place_type_t<value_type> /*unused*/, Args &&... args) noexcept(std::is_nothrow_constructible<value_type, Args...>::value)
+    constexpr explicit value_storage_nontrivial(in_place_type_t<value_type> /*unused*/, Args &&... args) noexcept(std::is_nothrow_constructible<value_type, Args...>::value)
         : _value(std::forward<Args>(args)...)  // NOLINT
         , _status(status_have_value)
     {
     }
     template <class U, class... Args>
-    value_storage_nontrivial(in_place_type_t<value_type> /*unused*/, std::initializer_list<U> il, Args &&... args) noexcept(std::is_nothrow_constructible<value_type, std::initializer_list<U>, Args...>::value)
+    constexpr value_storage_nontrivial(in_place_type_t<value_type> /*unused*/, std::initializer_list<U> il, Args &&... args) noexcept(std::is_nothrow_constructible<value_type, std::initializer_list<U>, Args...>::value)
         : _value(il, std::forward<Args>(args)...)
         , _status(status_have_value)
     {
     }
-    template <class U> static constexpr bool enable_converting_constructor = !std::is_same<std::decay_t<U>, value_type>::value && std::is_constructible<value_type, U>::value;
-    OUTCOME_TEMPLATE(class U)
-    OUTCOME_TREQUIRES(OUTCOME_TPRED(enable_converting_constructor<U>))
-    constexpr explicit value_storage_nontrivial(const value_storage_nontrivial<U> &o) noexcept(std::is_nothrow_constructible<value_type, U>::value)
-        : value_storage_nontrivial((o._status & status_have_value) != 0 ? value_storage_nontrivial(in_place_type<value_type>, o._value) : value_storage_nontrivial())
+    // Uses-allocator construction of the value, or of a copy or move of the value of o
+    template <class Alloc, class... Args>
+    OUTCOME_CONSTEXPR20 value_storage_nontrivial(std::allocator_arg_t /*unused*/, const Alloc &a, in_place_type_t<value_type> /*unused*/, Args &&... args)
+        : _empty{}
+    {
+      construct_value_using_allocator_at(&_value, a, std::forward<Args>(args)...);  // NOLINT
+      _status = status_have_value;
+    }
+    template <class Alloc>
+    OUTCOME_CONSTEXPR20 value_storage_nontrivial(std::allocator_arg_t /*unused*/, const Alloc &a, const value_storage_nontrivial &o)
+        : _empty{}
     {
+      if(o._status & status_have_value)
+      {
+        construct_value_using_allocator_at(&_value, a, o._value);  // NOLINT
+      }
       _status = o._status;
     }
-    OUTCOME_TEMPLATE(class U)
-    OUTCOME_TREQUIRES(OUTCOME_TPRED(enable_converting_constructor<U>))
-    constexpr explicit value_storage_nontrivial(const value_storage_trivial<U> &o) noexcept(std::is_nothrow_constructible<value_type, U>::value)
-        : value_storage_nontrivial((o._status & status_have_value) != 0 ? value_storage_nontrivial(in_place_type<value_type>, o._value) : value_storage_nontrivial())
+    template <class Alloc>
+    OUTCOME_CONSTEXPR20 value_storage_nontrivial(std::allocator_arg_t /*unused*/, const Alloc &a, value_storage_nontrivial &&o)
+        : _empty{}
     {
+      if(o._status & status_have_value)
+      {
+        construct_value_using_allocator_at(&_value, a, std::move(o._value));  // NOLINT
+      }
       _status = o._status;
     }
-    OUTCOME_TEMPLATE(class U)
-    OUTCOME_TREQUIRES(OUTCOME_TPRED(enable_converting_constructor<U>))
-    constexpr explicit value_storage_nontrivial(value_storage_nontrivial<U> &&o) noexcept(std::is_nothrow_constructible<value_type, U>::value)
+    // Converts from another value type, or from the same value type with a different width of status
+    template <class U, class S = Status> static constexpr bool enable_converting_constructor = (!std::is_same<std::decay_t<U>, value_type>::value || !std::is_same<S, Status>::value) && std::is_constructible<value_type, U>::value;
+    OUTCOME_TEMPLATE(class U, class S)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(enable_converting_constructor<U, S>))
+    constexpr explicit value_storage_nontrivial(const value_storage_nontrivial<U, S> &o) noexcept(std::is_nothrow_constructible<value_type, U>::value)
+        : value_storage_nontrivial((o._status & status_have_value) != 0 ? value_storage_nontrivial(in_place_type<value_type>, o._value) : value_storage_nontrivial())
+    {
+      _status = static_cast<Status>(o._status);
+    }
+    OUTCOME_TEMPLATE(class U, class S)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(enable_converting_constructor<U, S>))
+    constexpr explicit value_storage_nontrivial(const value_storage_trivial<U, S> &o) noexcept(std::is_nothrow_constructible<value_type, U>::value)
+        : value_storage_nontrivial((o._status & status_have_value) != 0 ? value_storage_nontrivial(in_place_type<value_type>, o._value) : value_storage_nontrivial())
+    {
+      _status = static_cast<Status>(o._status);
+    }
+    OUTCOME_TEMPLATE(class U, class S)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(enable_converting_constructor<U, S>))
+    constexpr explicit value_storage_nontrivial(value_storage_nontrivial<U, S> &&o) noexcept(std::is_nothrow_constructible<value_type, U>::value)
         : value_storage_nontrivial((o._status & status_have_value) != 0 ? value_storage_nontrivial(in_place_type<value_type>, std::move(o._value)) : value_storage_nontrivial())
     {
-      _status = o._status;
+      _status = static_cast<Status>(o._status);
     }
-    OUTCOME_TEMPLATE(class U)
-    OUTCOME_TREQUIRES(OUTCOME_TPRED(enable_converting_constructor<U>))
-    constexpr explicit value_storage_nontrivial(value_storage_trivial<U> &&o) noexcept(std::is_nothrow_constructible<value_type, U>::value)
+    OUTCOME_TEMPLATE(class U, class S)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(enable_converting_constructor<U, S>))
+    constexpr explicit value_storage_nontrivial(value_storage_trivial<U, S> &&o) noexcept(std::is_nothrow_constructible<value_type, U>::value)
         : value_storage_nontrivial((o._status & status_have_value) != 0 ? value_storage_nontrivial(in_place_type<value_type>, std::move(o._value)) : value_storage_nontrivial())
     {
-      _status = o._status;
+      _status = static_cast<Status>(o._status);
     }
-    ~value_storage_nontrivial() noexcept(std::is_nothrow_destructible<T>::value)
+    OUTCOME_TEMPLATE(class U, class N)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(enable_converting_constructor<U>))
+    constexpr explicit value_storage_nontrivial(const value_storage_niche<U, N> &o) noexcept(std::is_nothrow_constructible<value_type, U>::value)
+        : value_storage_nontrivial((o.status() & status_have_value) != 0 ? value_storage_nontrivial(in_place_type<value_type>, o._value) : value_storage_nontrivial())
+    {
+      _status = static_cast<Status>(o.status());
+    }
+    OUTCOME_TEMPLATE(class U, class N)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(enable_converting_constructor<U>))
+    constexpr explicit value_storage_nontrivial(value_storage_niche<U, N> &&o) noexcept(std::is_nothrow_constructible<value_type, U>::value)
+        : value_storage_nontrivial((o.status() & status_have_value) != 0 ? value_storage_nontrivial(in_place_type<value_type>, std::move(o._value)) : value_storage_nontrivial())
+    {
+      _status = static_cast<Status>(o.status());
+    }
+    OUTCOME_TEMPLATE(class U, class F)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_constructible<value_type, U>::value))
+    constexpr explicit value_storage_nontrivial(const value_storage_disjoint<U, F> &o) noexcept(std::is_nothrow_constructible<value_type, U>::value)
+        : value_storage_nontrivial((o._status & status_have_value) != 0 ? value_storage_nontrivial(in_place_type<value_type>, o._value) : value_storage_nontrivial())
+    {
+      _status = static_cast<Status>(o._status);
+    }
+    OUTCOME_CONSTEXPR20 ~value_storage_nontrivial() noexcept(std::is_nothrow_destructible<T>::value)
     {
       if(this->_status & status_have_value)
       {
@@ -232,6 +542,26 @@ namespace detail
     }
     constexpr void swap(value_storage_nontrivial &o)
     {
+#if defined(__cpp_lib_is_constant_evaluated) && __cpp_lib_is_constant_evaluated >= 201811L
+      // Bytes cannot be copied in constant evaluation
+      if(std::is_constant_evaluated())
+      {
+        _swap(o, std::false_type());
+        return;
+      }
+#endif
+      _swap(o, std::integral_constant<bool, trait::is_move_bitcopying<value_type>::value>());
+    }
+    // Bitcopying types can exchange their bytes without running any constructors or destructors
+    void _swap(value_storage_nontrivial &o, std::true_type /*unused*/) noexcept
+    {
+      alignas(value_storage_nontrivial) char temp[sizeof(value_storage_nontrivial)];
+      memcpy(temp, static_cast<void *>(this), sizeof(value_storage_nontrivial));                     // NOLINT
+      memcpy(static_cast<void *>(this), static_cast<void *>(&o), sizeof(value_storage_nontrivial));  // NOLINT
+      memcpy(static_cast<void *>(&o), temp, sizeof(value_storage_nontrivial));                       // NOLINT
+    }
+    OUTCOME_CONSTEXPR20 void _swap(value_storage_nontrivial &o, std::false_type /*unused*/)
+    {
       using std::swap;
       if((_status & status_have_value) == 0 && (o._status & status_have_value) == 0)
       {
@@ -248,19 +578,171 @@ namespace detail
       if((_status & status_have_value) != 0)
       {
         // Move construct me into other
-        new(&o._value) value_type(std::move(_value));  // NOLINT
-        this->_value.~value_type();                    // NOLINT
+        construct_value_at(&o._value, std::move(_value));  // NOLINT
+        this->_value.~value_type();                        // NOLINT
         swap(_status, o._status);
       }
       else
       {
         // Move construct other into me
-        new(&_value) value_type(std::move(o._value));  // NOLINT
-        o._value.~value_type();                        // NOLINT
+        construct_value_at(&_value, std::move(o._value));  // NOLINT
+        o._value.~value_type();                            // NOLINT
         swap(_status, o._status);
       }
     }
   };
+  // Used if T has opted into niche packing via trait::niche<T>. There is no separate status word,
+  // whilst valued the status is implicitly status_have_value, otherwise it is encoded into the niche.
+  template <class T, class Niche> struct value_storage_niche
+  {
+    static_assert(std::is_trivially_copyable<T>::value, "Niche packed storage requires T to be trivially copyable");
+    using value_type = T;
+    value_type _value;
+    constexpr value_storage_niche() noexcept : _value(Niche::encode(0)) {}
+    // Special from-void constructor, constructs default T if void valued
+    template <class S>
+    explicit constexpr value_storage_niche(const value_storage_trivial<void, S> &o) noexcept(std::is_nothrow_default_constructible<value_type>::value)
+        : _value(((o._status & status_have_value) != 0) ? value_type() : Niche::encode(o._status))
+    {
+    }
+    value_storage_niche(const value_storage_niche &) = default;             // NOLINT
+    value_storage_niche(value_storage_niche &&) = default;                  // NOLINT
+    value_storage_niche &operator=(const value_storage_niche &) = default;  // NOLINT
+    value_storage_niche &operator=(value_storage_niche &&) = default;       // NOLINT
+    ~value_storage_niche() = default;
+    constexpr status_bitfield_type status() const noexcept { return Niche::is_niche(_value) ? Niche::decode(_value) : status_have_value; }
+    constexpr void set_status(status_bitfield_type status) noexcept
+    {
+      // Whilst valued every bit belongs to the value, so the other status bits cannot be kept
+      if((status & status_have_value) == 0)
+      {
+        _value = Niche::encode(status);
+      }
+    }
+    constexpr explicit value_storage_niche(status_bitfield_type status)
+        : _value(Niche::encode(status))
+    {
+    }
+    template <class... Args>
+    constexpr explicit value_storage_niche(in_place_type_t<value_type> /*unused*/, Args &&... args) noexcept(std::is_nothrow_constructible<value_type, Args...>::value)
+        : _value(std::forward<Args>(args)...)
+    {
+    }
+    template <class U, class... Args>
+    constexpr value_storage_niche(in_place_type_t<value_type> /*unused*/, std::initializer_list<U> il, Args &&... args) noexcept(std::is_nothrow_constructible<value_type, std::initializer_list<U>, Args...>::value)
+        : _value(il, std::forward<Args>(args)...)
+    {
+    }
+    template <class U> static constexpr bool enable_converting_constructor = !std::is_same<std::decay_t<U>, value_type>::value && std::is_constructible<value_type, U>::value;
+    OUTCOME_TEMPLATE(class U, class S)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(enable_converting_constructor<U>))
+    constexpr explicit value_storage_niche(const value_storage_trivial<U, S> &o) noexcept(std::is_nothrow_constructible<value_type, U>::value)
+        : value_storage_niche(((o._status & status_have_value) != 0) ? value_storage_niche(in_place_type<value_type>, o._value) : value_storage_niche(o._status))  // NOLINT
+    {
+    }
+    OUTCOME_TEMPLATE(class U, class S)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(enable_converting_constructor<U>))
+    constexpr explicit value_storage_niche(const value_storage_nontrivial<U, S> &o) noexcept(std::is_nothrow_constructible<value_type, U>::value)
+        : value_storage_niche(((o._status & status_have_value) != 0) ? value_storage_niche(in_place_type<value_type>, o._value) : value_storage_niche(o._status))  // NOLINT
+    {
+    }
+    OUTCOME_TEMPLATE(class U, class N)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(enable_converting_constructor<U>))
+    constexpr explicit value_storage_niche(const value_storage_niche<U, N> &o) noexcept(std::is_nothrow_constructible<value_type, U>::value)
+        : value_storage_niche(((o.status() & status_have_value) != 0) ? value_storage_niche(in_place_type<value_type>, o._value) : value_storage_niche(o.status()))  // NOLINT
+    {
+    }
+    OUTCOME_TEMPLATE(class U, class S)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(enable_converting_constructor<U>))
+    constexpr explicit value_storage_niche(value_storage_nontrivial<U, S> &&o) noexcept(std::is_nothrow_constructible<value_type, U>::value)
+        : value_storage_niche(((o._status & status_have_value) != 0) ? value_storage_niche(in_place_type<value_type>, std::move(o._value)) : value_storage_niche(o._status))  // NOLINT
+    {
+    }
+    OUTCOME_TEMPLATE(class U, class F)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_constructible<value_type, U>::value))
+    constexpr explicit value_storage_niche(const value_storage_disjoint<U, F> &o) noexcept(std::is_nothrow_constructible<value_type, U>::value)
+        : value_storage_niche(((o._status & status_have_value) != 0) ? value_storage_niche(in_place_type<value_type>, o._value) : value_storage_niche(o._status))  // NOLINT
+    {
+    }
+    constexpr void swap(value_storage_niche &o)
+    {
+      // storage is trivial, so just use assignment
+      using std::swap;
+      swap(*this, o);
+    }
+  };
+  // Used if trait::disjoint_storage<T, E> opts in, holds the value and the error in one union
+  template <class T, class E> struct value_storage_disjoint
+  {
+    static_assert(std::is_trivially_copyable<T>::value && std::is_trivially_copyable<E>::value, "Disjoint storage requires T and E to be trivially copyable");
+    using value_type = T;
+    using error_type = E;
+    union {
+      empty_type _empty;
+      value_type _value;
+      error_type _error;
+    };
+    status_bitfield_type _status{0};
+    constexpr value_storage_disjoint() noexcept : _empty{} {}
+    value_storage_disjoint(const value_storage_disjoint &) = default;             // NOLINT
+    value_storage_disjoint(value_storage_disjoint &&) = default;                  // NOLINT
+    value_storage_disjoint &operator=(const value_storage_disjoint &) = default;  // NOLINT
+    value_storage_disjoint &operator=(value_storage_disjoint &&) = default;       // NOLINT
+    ~value_storage_disjoint() = default;
+    constexpr status_bitfield_type status() const noexcept { return _status; }
+    constexpr void set_status(status_bitfield_type status) noexcept { _status = status; }
+    constexpr explicit value_storage_disjoint(status_bitfield_type status)
+        : _empty()
+        , _status(status)
+    {
+    }
+    template <class... Args>
+    constexpr explicit value_storage_disjoint(in_place_type_t<value_type> /*unused*/, Args &&... args) noexcept(std::is_nothrow_constructible<value_type, Args...>::value)
+        : _value(std::forward<Args>(args)...)
+        , _status(status_have_value)
+    {
+    }
+    template <class U, class... Args>
+    constexpr value_storage_disjoint(in_place_type_t<value_type> /*unused*/, std::initializer_list<U> il, Args &&... args) noexcept(std::is_nothrow_constructible<value_type, std::initializer_list<U>, Args...>::value)
+        : _value(il, std::forward<Args>(args)...)
+        , _status(status_have_value)
+    {
+    }
+    template <class... Args>
+    constexpr explicit value_storage_disjoint(in_place_type_t<error_type> /*unused*/, Args &&... args) noexcept(std::is_nothrow_constructible<error_type, Args...>::value)
+        : _error(std::forward<Args>(args)...)
+        , _status(status_have_error)
+    {
+    }
+    template <class U, class... Args>
+    constexpr value_storage_disjoint(in_place_type_t<error_type> /*unused*/, std::initializer_list<U> il, Args &&... args) noexcept(std::is_nothrow_constructible<error_type, std::initializer_list<U>, Args...>::value)
+        : _error(il, std::forward<Args>(args)...)
+        , _status(status_have_error)
+    {
+    }
+    // Converts from a value storage plus a separately stored error, the error is only read if errored
+    OUTCOME_TEMPLATE(class State, class Error)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_constructible<value_type, decltype(std::declval<State>()._value)>::value), OUTCOME_TPRED(std::is_constructible<error_type, Error>::value))
+    constexpr value_storage_disjoint(State &&state, Error &&error)
+        : value_storage_disjoint(((state.status() & status_have_value) != 0) ? value_storage_disjoint(in_place_type<value_type>, std::forward<State>(state)._value)                                                                       //
+                                                                             : (((state.status() & status_have_error) != 0) ? value_storage_disjoint(in_place_type<error_type>, std::forward<Error>(error)) : value_storage_disjoint()))  // NOLINT
+    {
+      _status = state.status();
+    }
+    template <class U, class F> static constexpr bool enable_converting_constructor = !std::is_same<value_storage_disjoint<U, F>, value_storage_disjoint>::value && std::is_constructible<value_type, U>::value && std::is_constructible<error_type, F>::value;
+    OUTCOME_TEMPLATE(class U, class F)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(enable_converting_constructor<U, F>))
+    constexpr explicit value_storage_disjoint(const value_storage_disjoint<U, F> &o) noexcept(std::is_nothrow_constructible<value_type, U>::value &&std::is_nothrow_constructible<error_type, F>::value)
+        : value_storage_disjoint(o, o._error)
+    {
+    }
+    constexpr void swap(value_storage_disjoint &o)
+    {
+      // storage is trivial, so just use assignment
+      using std::swap;
+      swap(*this, o);
+    }
+  };
   template <class Base> struct value_storage_delete_copy_constructor : Base  // NOLINT
   {
     using Base::Base;
@@ -305,7 +787,7 @@ namespace detail
     value_storage_nontrivial_move_assignment(const value_storage_nontrivial_move_assignment &) = default;
     value_storage_nontrivial_move_assignment(value_storage_nontrivial_move_assignment &&) = default;  // NOLINT
     value_storage_nontrivial_move_assignment &operator=(const value_storage_nontrivial_move_assignment &o) = default;
-    value_storage_nontrivial_move_assignment &operator=(value_storage_nontrivial_move_assignment &&o) noexcept(std::is_nothrow_move_assignable<value_type>::value)  // NOLINT
+    OUTCOME_CONSTEXPR20 value_storage_nontrivial_move_assignment &operator=(value_storage_nontrivial_move_assignment &&o) noexcept(std::is_nothrow_move_assignable<value_type>::value)  // NOLINT
     {
       if((this->_status & status_have_value) != 0 && (o._status & status_have_value) != 0)
       {
@@ -317,7 +799,7 @@ namespace detail
       }
       else if((this->_status & status_have_value) == 0 && (o._status & status_have_value) != 0)
       {
-        new(&this->_value) value_type(std::move(o._value));  // NOLINT
+        construct_value_at(&this->_value, std::move(o._value));  // NOLINT
       }
       this->_status = o._status;
       return *this;
@@ -331,7 +813,7 @@ namespace detail
     value_storage_nontrivial_copy_assignment(const value_storage_nontrivial_copy_assignment &) = default;
     value_storage_nontrivial_copy_assignment(value_storage_nontrivial_copy_assignment &&) = default;              // NOLINT
     value_storage_nontrivial_copy_assignment &operator=(value_storage_nontrivial_copy_assignment &&o) = default;  // NOLINT
-    value_storage_nontrivial_copy_assignment &operator=(const value_storage_nontrivial_copy_assignment &o) noexcept(std::is_nothrow_copy_assignable<value_type>::value)
+    OUTCOME_CONSTEXPR20 value_storage_nontrivial_copy_assignment &operator=(const value_storage_nontrivial_copy_assignment &o) noexcept(std::is_nothrow_copy_assignable<value_type>::value)
     {
       if((this->_status & status_have_value) != 0 && (o._status & status_have_value) != 0)
       {
@@ -343,28 +825,83 @@ namespace detail
       }
       else if((this->_status & status_have_value) == 0 && (o._status & status_have_value) != 0)
       {
-        new(&this->_value) value_type(o._value);  // NOLINT
+        construct_value_at(&this->_value, o._value);  // NOLINT
       }
       this->_status = o._status;
       return *this;
     }
   };
 
-  // We don't actually need all of std::is_trivial<>, std::is_trivially_copyable<> is sufficient
-  template <class T> using value_storage_select_trivality = std::conditional_t<std::is_trivially_copyable<devoid<T>>::value, value_storage_trivial<T>, value_storage_nontrivial<T>>;
-  template <class T> using value_storage_select_move_constructor = std::conditional_t<std::is_move_constructible<devoid<T>>::value, value_storage_select_trivality<T>, value_storage_delete_move_constructor<value_storage_select_trivality<T>>>;
-  template <class T> using value_storage_select_copy_constructor = std::conditional_t<std::is_copy_constructible<devoid<T>>::value, value_storage_select_move_constructor<T>, value_storage_delete_copy_constructor<value_storage_select_move_constructor<T>>>;
-  template <class T>
-  using value_storage_select_move_assignment = std::conditional_t<std::is_trivially_move_assignable<devoid<T>>::value, value_storage_select_copy_constructor<T>,
-                                                                  std::conditional_t<std::is_move_assignable<devoid<T>>::value, value_storage_nontrivial_move_assignment<value_storage_select_copy_constructor<T>>, value_storage_delete_copy_assignment<value_storage_select_copy_constructor<T>>>>;
-  template <class T>
-  using value_storage_select_copy_assignment = std::conditional_t<std::is_trivially_copy_assignable<devoid<T>>::value, value_storage_select_move_assignment<T>,
-                                                                  std::conditional_t<std::is_copy_assignable<devoid<T>>::value, value_storage_nontrivial_copy_assignment<value_storage_select_move_assignment<T>>, value_storage_delete_copy_assignment<value_storage_select_move_assignment<T>>>>;
-  template <class T> using value_storage_select_impl = value_storage_select_copy_assignment<T>;
+  // Applies Wrapper to Base only if Apply, so unused wrappers are never named
+  template <bool Apply, template <class> class Wrapper, class Base> struct value_storage_wrap_if
+  {
+    using type = Base;
+  };
+  template <template <class> class Wrapper, class Base> struct value_storage_wrap_if<true, Wrapper, Base>
+  {
+    using type = Wrapper<Base>;
+  };
+  // IsAssignable is only asked for its value if assignment is not trivial
+  template <class Base, template <class> class Nontrivial, class IsAssignable, bool Trivial> struct value_storage_select_assignment
+  {
+    using type = Base;
+  };
+  template <class Base, template <class> class Nontrivial, class IsAssignable> struct value_storage_select_assignment<Base, Nontrivial, IsAssignable, false>
+  {
+    using type = std::conditional_t<IsAssignable::value, Nontrivial<Base>, value_storage_delete_copy_assignment<Base>>;
+  };
+  /* Selects the storage for T. Each trait of T is asked for once, and each layer is only named if it is
+  applied, as this is instantiated for every value type in a program.
+  */
+  template <class T, class Status = status_bitfield_type, bool = trait::has_niche_v<T>> struct value_storage_select
+  {
+    using type = value_storage_niche<T, trait::niche<T>>;
+  };
+  template <class T, class Status> struct value_storage_select<T, Status, false>
+  {
+    using _t = devoid<T>;
+    // We don't actually need all of std::is_trivial<>, std::is_trivially_copyable<> is sufficient
+    using _trivality = std::conditional_t<std::is_trivially_copyable<_t>::value, value_storage_trivial<T, Status>, value_storage_nontrivial<T, Status>>;
+    using _move_constructor = typename value_storage_wrap_if<!std::is_move_constructible<_t>::value, value_storage_delete_move_constructor, _trivality>::type;
+    using _copy_constructor = typename value_storage_wrap_if<!std::is_copy_constructible<_t>::value, value_storage_delete_copy_constructor, _move_constructor>::type;
+    using _move_assignment = typename value_storage_select_assignment<_copy_constructor, value_storage_nontrivial_move_assignment, std::is_move_assignable<_t>, std::is_trivially_move_assignable<_t>::value>::type;
+    using type = typename value_storage_select_assignment<_move_assignment, value_storage_nontrivial_copy_assignment, std::is_copy_assignable<_t>, std::is_trivially_copy_assignable<_t>::value>::type;
+  };
+  template <class T> using value_storage_select_impl = typename value_storage_select<T>::type;
+  /* Selects the width of the status of a result. If its value or its error is void, the status only
+  takes up the padding after the other, so the result is no larger than a `std::optional` of the other.
+  */
+  template <class T, class E> struct value_storage_select_status
+  {
+    using type = status_bitfield_type;
+  };
+  template <class T> struct value_storage_select_status<T, void>
+  {
+    using type = compact_status_bitfield_type<alignof(T)>;
+  };
+  template <class E> struct value_storage_select_status<void, E>
+  {
+    using type = compact_status_bitfield_type<alignof(E)>;
+  };
+  // Selects the state of a result, only selecting the storage of the value if it is not disjoint
+  template <class T, class E, bool Disjoint> struct value_storage_select_state : value_storage_select<T, typename value_storage_select_status<T, E>::type>
+  {
+  };
+  template <class T, class E> struct value_storage_select_state<T, E, true>
+  {
+    using type = value_storage_disjoint<devoid<T>, devoid<E>>;
+  };
 #ifndef NDEBUG
+#ifdef OUTCOME_ENABLE_TRIVIAL_STORAGE
+  // Check is trivial in all ways, and that the all bits zero state is empty
+  static_assert(std::is_trivial<value_storage_select_impl<int>>::value, "value_storage_select_impl<int> is not trivial!");
+  static_assert(std::is_trivially_default_constructible<value_storage_select_impl<int>>::value, "value_storage_select_impl<int> is not trivially default constructible!");
+  static_assert(value_storage_select_impl<int>().status() == 0, "value_storage_select_impl<int> does not value initialise to empty!");
+#else
   // Check is trivial in all ways except default constructibility
   // static_assert(std::is_trivial<value_storage_select_impl<int>>::value, "value_storage_select_impl<int> is not trivial!");
   // static_assert(std::is_trivially_default_constructible<value_storage_select_impl<int>>::value, "value_storage_select_impl<int> is not trivially default constructible!");
+#endif
   static_assert(std::is_trivially_copyable<value_storage_select_impl<int>>::value, "value_storage_select_impl<int> is not trivially copyable!");
   static_assert(std::is_trivially_assignable<value_storage_select_impl<int>, value_storage_select_impl<int>>::value, "value_storage_select_impl<int> is not trivially assignable!");
   static_assert(std::is_trivially_destructible<value_storage_select_impl<int>>::value, "value_storage_select_impl<int> is not trivially destructible!");
@@ -374,6 +911,26 @@ namespace detail
   static_assert(std::is_trivially_move_assignable<value_storage_select_impl<int>>::value, "value_storage_select_impl<int> is not trivially move assignable!");
   // Also check is standard layout
   static_assert(std::is_standard_layout<value_storage_select_impl<int>>::value, "value_storage_select_impl<int> is not a standard layout type!");
+  // Check the niche packed layout really does not add a status word
+#ifdef OUTCOME_ENABLE_COMPACT_STATUS
+  static_assert(sizeof(value_storage_select_impl<uint32_t>) == 8, "value_storage_select_impl<uint32_t> does not fit into eight bytes!");
+  static_assert(sizeof(value_storage_select_impl<uint16_t>) == 4, "value_storage_select_impl<uint16_t> does not fit into four bytes!");
+#else
+  static_assert(sizeof(value_storage_select_impl<int>) == sizeof(int) + sizeof(status_bitfield_type), "value_storage_select_impl<int> is not the size expected!");
+#endif
+  static_assert(sizeof(value_storage_niche<int *, trait::niche_pointer<int *>>) == sizeof(int *), "value_storage_niche<int *> is bigger than a pointer!");
+  static_assert(std::is_trivially_copyable<value_storage_niche<int *, trait::niche_pointer<int *>>>::value, "value_storage_niche<int *> is not trivially copyable!");
+  static_assert(std::is_standard_layout<value_storage_niche<int *, trait::niche_pointer<int *>>>::value, "value_storage_niche<int *> is not a standard layout type!");
+  // Check the disjoint layout overlaps the value and the error
+  static_assert(sizeof(value_storage_disjoint<uint64_t, uint32_t>) == 8 + sizeof(uint64_t), "value_storage_disjoint<uint64_t, uint32_t> does not overlap value and error!");
+  static_assert(std::is_trivially_copyable<value_storage_disjoint<int, long>>::value, "value_storage_disjoint<int, long> is not trivially copyable!");
+  static_assert(std::is_standard_layout<value_storage_disjoint<int, long>>::value, "value_storage_disjoint<int, long> is not a standard layout type!");
+  // Check a void value or error costs no more than the tag of a std::optional
+  static_assert(sizeof(value_storage_select_state<char, void, false>::type) == 2, "the state of result<char, void> is not two bytes!");
+  static_assert(sizeof(value_storage_select_state<uint64_t, void, false>::type) == 16, "the state of result<uint64_t, void> is not sixteen bytes!");
+  static_assert(sizeof(value_storage_select_state<void, char, false>::type) == 1, "the state of result<void, char> is not one byte!");
+  static_assert(sizeof(value_storage_select_state<void, uint64_t, false>::type) == sizeof(status_bitfield_type), "the state of result<void, uint64_t> is not the size of the status!");
+  static_assert(std::is_trivially_copyable<value_storage_select_state<void, char, false>::type>::value, "the state of result<void, char> is not trivially copyable!");
 #endif
 }  // namespace detail
 
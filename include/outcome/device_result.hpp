@@ -0,0 +1,84 @@
+/* A result usable in CUDA and HIP device code
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_DEVICE_RESULT_HPP
+#define OUTCOME_DEVICE_RESULT_HPP
+
+/* Include result_lite.hpp before this to keep <system_error> and <exception> out of the device
+compilation. The full edition works too, as only the host calls what they declare.
+*/
+#include "result.hpp"
+
+#if defined(__CUDACC__) && !defined(__clang__) && !defined(__CUDACC_RELAXED_CONSTEXPR__)
+#error device_result needs nvcc --expt-relaxed-constexpr, so that the constexpr functions of result are callable from device code
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace trait
+{
+  /*! Customisation point for whether `device_result` accepts a type as its error. Defaults to
+  true for integers and enumerations, which mean the same on the host as on the device.
+  */
+  template <class E> struct is_device_error
+  {
+    static constexpr bool value = std::is_integral<E>::value || std::is_enum<E>::value;
+  };
+  /*! Customisation point for whether `device_result` accepts a policy. Defaults to true for
+  `policy::terminate`, which traps the kernel on a wide check failing in device code, and
+  `policy::all_narrow`.
+  */
+  template <class NoValuePolicy> struct is_device_policy
+  {
+    static constexpr bool value = std::is_same<NoValuePolicy, policy::terminate>::value || std::is_same<NoValuePolicy, policy::all_narrow>::value;
+  };
+}  // namespace trait
+
+namespace detail
+{
+  template <class T, class E, class NoValuePolicy> struct device_result_type
+  {
+    static_assert(std::is_void<T>::value || std::is_trivially_copyable<T>::value, "device_result needs a trivially copyable value type");
+    static_assert(trait::is_device_error<E>::value, "device_result needs an integer or enumeration error type, or trait::is_device_error to be specialised");
+    static_assert(trait::is_device_policy<NoValuePolicy>::value, "device_result needs a policy which neither throws nor calls host only code");
+    using type = result<T, E, NoValuePolicy>;
+    static_assert(std::is_trivially_copyable<type>::value, "device_result must be trivially copyable, so check that no lifetime hooks are overloaded for it");
+  };
+}  // namespace detail
+
+/*! A `result<T, E, NoValuePolicy>` checked to be usable in both host and device code, and to have
+the same bytes in each. `T` must be trivially copyable and `E` an integer or enumeration, so the
+trivial storage is used and the result is trivially copyable: an array of them written by a
+kernel can be copied back with `cudaMemcpy()` or `hipMemcpy()` and inspected on the host directly,
+with no translation pass. `policy::terminate`, the default, traps the kernel on the device and calls
+`std::terminate()` on the host.
+
+Under nvcc, `--expt-relaxed-constexpr` must be given. `value()`, `error()`, the observers, the
+constructors and `OUTCOME_TRY` are all usable in `__device__` functions.
+*/
+template <class T, class E, class NoValuePolicy = policy::terminate> using device_result = typename detail::device_result_type<T, E, NoValuePolicy>::type;
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
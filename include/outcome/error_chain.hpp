@@ -0,0 +1,296 @@
+/* An error code carrying a chain of context added as it propagates
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_ERROR_CHAIN_HPP
+#define OUTCOME_ERROR_CHAIN_HPP
+
+#include "error_site.hpp"
+
+#include <memory>
+#include <new>
+#include <string>
+#include <system_error>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+//! One frame of context of an `error_chain`.
+struct error_chain_frame
+{
+  //! What was being done, which must have static storage duration, such as a string literal.
+  const char *context;
+  //! Where the frame was added, see `OUTCOME_ERROR_SITE_ID()`, or zero if unknown.
+  uint16_t site;
+};
+
+/*! An error code `E` plus a chain of frames of context added as the error climbs the stack, such
+as "while parsing header" then "while reading file". A frame is only a pointer to a static string
+and a site id, and the first `N` are kept inline, so adding context does not allocate until a
+chain is deeper than `N`. Frames which cannot be allocated are dropped, see `truncated()`.
+
+`make_error_code()` returns the code as a `std::error_code`, so `result<T, error_chain<>>`
+has the default policy of `result<T, std::error_code>`, throwing a `std::system_error` whose
+`what()` includes the chain. See `OUTCOME_TRY_CONTEXT()` for adding frames whilst propagating.
+
+\tparam E The error code, `std::error_code` or a type with an ADL discovered `make_error_code()`.
+\tparam N The number of frames kept inline.
+*/
+template <class E = std::error_code, size_t N = 4> class error_chain
+{
+  static_assert(N > 0 && N < 65535, "N must be between 1 and 65534");
+
+  E _code{};
+  error_chain_frame _frames[N]{};
+  // Frames past N, of which there is room for _capacity - N
+  std::unique_ptr<error_chain_frame[]> _overflow;
+  uint16_t _size{0}, _capacity{static_cast<uint16_t>(N)};
+  bool _truncated{false};
+
+  void _copy_frames(const error_chain &o) noexcept
+  {
+    for(size_t n = 0; n < N; n++)
+    {
+      _frames[n] = o._frames[n];
+    }
+    _size = static_cast<uint16_t>((o._size < N) ? o._size : N);
+    _truncated = o._truncated;
+    for(size_t n = N; n < o._size; n++)
+    {
+      push(o[n].context, o[n].site);
+    }
+  }
+
+public:
+  //! The error code type.
+  using code_type = E;
+  //! The number of frames kept inline.
+  static constexpr size_t inline_frames = N;
+
+  //! Default constructs the code, without context.
+  error_chain() = default;
+  //! Constructs from a code, without context.
+  error_chain(E code) noexcept(std::is_nothrow_move_constructible<E>::value)  // NOLINT
+      : _code(static_cast<E &&>(code))
+  {
+  }
+  //! Constructs from a code with one frame of context.
+  error_chain(E code, const char *context, uint16_t site = 0) noexcept(std::is_nothrow_move_constructible<E>::value)
+      : _code(static_cast<E &&>(code))
+  {
+    push(context, site);
+  }
+  //! Copies the chain, which allocates if it is deeper than `N`.
+  error_chain(const error_chain &o)
+      : _code(o._code)
+  {
+    _copy_frames(o);
+  }
+  error_chain(error_chain &&) = default;  // NOLINT
+  error_chain &operator=(const error_chain &o)
+  {
+    if(this != &o)
+    {
+      _code = o._code;
+      _size = 0;
+      _copy_frames(o);
+    }
+    return *this;
+  }
+  error_chain &operator=(error_chain &&) = default;  // NOLINT
+  ~error_chain() = default;
+
+  /*! Adds a frame of context, outside those already added. Does not allocate unless there are
+  already `N` frames, and if the allocation fails the frame is dropped.
+  \returns `*this`, so additions may be chained.
+  */
+  error_chain &push(const char *context, uint16_t site = 0) noexcept
+  {
+    if(_size == _capacity)
+    {
+      if(_capacity == 65535)
+      {
+        _truncated = true;
+        return *this;
+      }
+      const uint16_t capacity = static_cast<uint16_t>((_capacity < 32767) ? _capacity * 2 : 65535);
+      std::unique_ptr<error_chain_frame[]> overflow(new(std::nothrow) error_chain_frame[capacity - N]);
+      if(!overflow)
+      {
+        _truncated = true;
+        return *this;
+      }
+      for(size_t n = N; n < _size; n++)
+      {
+        overflow[n - N] = _overflow[n - N];
+      }
+      _overflow = std::move(overflow);
+      _capacity = capacity;
+    }
+    error_chain_frame &frame = (_size < N) ? _frames[_size] : _overflow[_size - N];
+    frame.context = context;
+    frame.site = site;
+    ++_size;
+    return *this;
+  }
+
+  //! The error code.
+  const E &code() const noexcept { return _code; }
+  //! The number of frames of context.
+  size_t size() const noexcept { return _size; }
+  //! True if there are no frames of context.
+  bool empty() const noexcept { return _size == 0; }
+  //! True if some frames could not be allocated and were dropped.
+  bool truncated() const noexcept { return _truncated; }
+  //! The frame `n`, where frame zero was added first, nearest to where the error arose.
+  const error_chain_frame &operator[](size_t n) const noexcept { return (n < N) ? _frames[n] : _overflow[n - N]; }
+  //! Calls `f(frame)` with each frame, in the order added.
+  template <class F> void for_each_frame(F &&f) const
+  {
+    for(size_t n = 0; n < _size; n++)
+    {
+      f((*this)[n]);
+    }
+  }
+  /*! The frames from the outermost in, each followed by ": ", then the message of the code,
+  such as "while reading file: while parsing header: Invalid argument". This allocates.
+  */
+  std::string message() const
+  {
+    std::string ret;
+    for(size_t n = _size; n > 0; n--)
+    {
+      ret.append((*this)[n - 1].context);
+      ret.append(": ");
+    }
+    ret.append(make_error_code(*this).message());
+    return ret;
+  }
+
+  //! Errors compare by their code alone.
+  friend bool operator==(const error_chain &a, const error_chain &b) noexcept(noexcept(a._code == b._code)) { return a._code == b._code; }
+  friend bool operator!=(const error_chain &a, const error_chain &b) noexcept(noexcept(a._code == b._code)) { return !(a._code == b._code); }
+};
+
+namespace detail
+{
+  inline std::error_code error_chain_code(const std::error_code &ec) noexcept { return ec; }
+  template <class E> inline auto error_chain_code(const E &e) -> decltype(make_error_code(e)) { return make_error_code(e); }
+
+  template <class T> struct is_error_chain : std::false_type
+  {
+  };
+  template <class E, size_t N> struct is_error_chain<error_chain<E, N>> : std::true_type
+  {
+  };
+  // True if T is a result or outcome whose error is an error_chain
+  template <class T, class = void> struct has_error_chain : std::false_type
+  {
+  };
+  template <class T> struct has_error_chain<T, fallback_void_t<typename T::error_type>> : is_error_chain<typename T::error_type>
+  {
+  };
+
+  // Adds a frame of context to the failure as it converts into the caller's return type
+  template <class T> class try_failure_with_context
+  {
+    T &&_v;
+    const char *_context;
+    uint16_t _site;
+
+    template <class U> static constexpr void _push(U & /*unused*/, std::false_type /*unused*/, const char * /*unused*/, uint16_t /*unused*/) noexcept {}
+    template <class U> static void _push(U &r, std::true_type /*unused*/, const char *context, uint16_t site) noexcept { r.assume_error().push(context, site); }
+
+  public:
+    constexpr try_failure_with_context(T &&v, const char *context, uint16_t site) noexcept
+        : _v(std::forward<T>(v))
+        , _context(context)
+        , _site(site)
+    {
+    }
+    try_failure_with_context(const try_failure_with_context &) = delete;
+    try_failure_with_context(try_failure_with_context &&) = default;  // NOLINT, needed to return by value before C++ 17
+    try_failure_with_context &operator=(const try_failure_with_context &) = delete;
+    try_failure_with_context &operator=(try_failure_with_context &&) = delete;
+    ~try_failure_with_context() = default;
+
+    OUTCOME_TEMPLATE(class U)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(try_convertible_failure<U, T>::value))
+    operator U()  // NOLINT
+    {
+      U ret = try_convert_failure<U>(std::forward<T>(_v));
+      _push(ret, has_error_chain<U>(), _context, _site);
+      return ret;
+    }
+  };
+}  // namespace detail
+
+//! The code of an `error_chain` as a `std::error_code`, which makes `error_chain` an error code type.
+template <class E, size_t N> inline std::error_code make_error_code(const error_chain<E, N> &e) noexcept(noexcept(detail::error_chain_code(e.code()))) { return detail::error_chain_code(e.code()); }
+
+//! Throws a `std::system_error` of the code, with the frames of context as its description.
+template <class E, size_t N> inline void throw_as_system_error_with_payload(const error_chain<E, N> &e)
+{
+  if(e.empty())
+  {
+    OUTCOME_THROW_EXCEPTION(std::system_error(make_error_code(e)));
+  }
+  std::string context;
+  for(size_t n = e.size(); n > 0; n--)
+  {
+    context.append(e[n - 1].context);
+    if(n > 1)
+    {
+      context.append(": ");
+    }
+  }
+  OUTCOME_THROW_EXCEPTION(std::system_error(make_error_code(e), context));
+}
+
+/*! As `try_operation_return_as()`, but adds a frame of `context` at `site` to the failure if the
+caller's return type has an `error_chain` for its error.
+*/
+template <class T> constexpr detail::try_failure_with_context<T> try_operation_return_with_context(T &&v, const char *context, uint16_t site)
+{
+  detail::trace_propagation(v, site);
+  return detail::try_failure_with_context<T>(std::forward<T>(v), context, site);
+}
+
+OUTCOME_V2_NAMESPACE_END
+
+//! \exclude
+#define OUTCOME_TRYV_CONTEXT2(unique, context, ...) OUTCOME_TRYV2_RETURN(unique, (unique).has_value(), OUTCOME_V2_NAMESPACE::try_operation_return_with_context(std::forward<decltype(unique)>(unique), (context), OUTCOME_ERROR_SITE_ID()), __VA_ARGS__)
+//! \exclude
+#define OUTCOME_TRY_CONTEXT2(unique, context, v, ...)                                                                                                                                                                                                                                                                          \
+  OUTCOME_TRYV_CONTEXT2(unique, context, __VA_ARGS__);                                                                                                                                                                                                                                                                         \
+  OUTCOME_TRY2_EXTRACT(unique, v)
+
+/*! As `OUTCOME_TRYV()`, but adds a frame of `context`, a string literal, and of where this macro is
+used to the failure returned, if the caller's error type is an `error_chain`.
+*/
+#define OUTCOME_TRYV_CONTEXT(context, ...) OUTCOME_TRYV_CONTEXT2(OUTCOME_TRY_UNIQUE_NAME, context, __VA_ARGS__)
+/*! As `OUTCOME_TRY()`, but adds a frame of `context`, a string literal, and of where this macro is
+used to the failure returned, if the caller's error type is an `error_chain`.
+*/
+#define OUTCOME_TRY_CONTEXT(context, v, ...) OUTCOME_TRY_CONTEXT2(OUTCOME_TRY_UNIQUE_NAME, context, v, __VA_ARGS__)
+
+#endif
@@ -0,0 +1,362 @@
+/* Per thread counters of failures by error category and code
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_ERROR_COUNTERS_HPP
+#define OUTCOME_ERROR_COUNTERS_HPP
+
+#include "config.hpp"
+#ifdef OUTCOME_ENABLE_PERCPU_COUNTERS
+#include "percpu_counters.hpp"
+#endif
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <system_error>
+#include <vector>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+//! How many times a failure with some error category and value was counted.
+struct error_count
+{
+  const std::error_category *category;
+  int value;
+  uint64_t count;
+};
+
+//! A snapshot of the failures counted by all threads, as returned by `error_counters::snapshot()`.
+struct error_counts
+{
+  //! A count per distinct error category and value, in no particular order.
+  std::vector<error_count> counts;
+  //! Failures not counted by category and value, because the shard of their thread was full.
+  uint64_t overflow{0};
+
+  //! The count for `category` and `value`, zero if none were counted.
+  uint64_t count(const std::error_category &category, int value) const noexcept
+  {
+    for(const error_count &c : counts)
+    {
+      if(c.category == &category && c.value == value)
+      {
+        return c.count;
+      }
+    }
+    return 0;
+  }
+  //! The sum of all counts, including the overflow.
+  uint64_t total() const noexcept
+  {
+    uint64_t ret = overflow;
+    for(const error_count &c : counts)
+    {
+      ret += c.count;
+    }
+    return ret;
+  }
+  //! Adds a count for `category` and `value`.
+  void add(const std::error_category *category, int value, uint64_t count)
+  {
+    for(error_count &c : counts)
+    {
+      if(c.category == category && c.value == value)
+      {
+        c.count += count;
+        return;
+      }
+    }
+    counts.push_back(error_count{category, value, count});
+  }
+};
+
+namespace detail
+{
+  /* A fixed size open addressed table of counters written only by its own thread, and read by
+  any thread. A slot's key is published by the release store of its category, and counts
+  are bumped by a relaxed load and store, as there is only ever the one writer.
+  */
+  struct error_counter_shard
+  {
+    static constexpr size_t slots = 128;
+    struct slot
+    {
+      std::atomic<const std::error_category *> category{nullptr};
+      std::atomic<int> value{0};
+      std::atomic<uint64_t> count{0};
+    } table[slots];
+    std::atomic<uint64_t> overflow{0};
+
+    static void bump(std::atomic<uint64_t> &c) noexcept { c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+    void add(const std::error_category &category, int value) noexcept
+    {
+      size_t idx = (reinterpret_cast<uintptr_t>(&category) >> 4) ^ (static_cast<size_t>(value) * 0x9e3779b1u);  // NOLINT
+      for(size_t probe = 0; probe < slots; probe++, idx++)
+      {
+        slot &s = table[idx % slots];
+        const std::error_category *c = s.category.load(std::memory_order_relaxed);
+        if(c == nullptr)
+        {
+          s.value.store(value, std::memory_order_relaxed);
+          s.count.store(1, std::memory_order_relaxed);
+          s.category.store(&category, std::memory_order_release);
+          return;
+        }
+        if(c == &category && s.value.load(std::memory_order_relaxed) == value)
+        {
+          bump(s.count);
+          return;
+        }
+      }
+      bump(overflow);
+    }
+    void merge_into(error_counts &out) const
+    {
+      for(const slot &s : table)
+      {
+        const std::error_category *c = s.category.load(std::memory_order_acquire);
+        if(c != nullptr)
+        {
+          out.add(c, s.value.load(std::memory_order_relaxed), s.count.load(std::memory_order_relaxed));
+        }
+      }
+      out.overflow += overflow.load(std::memory_order_relaxed);
+    }
+  };
+
+  // All live shards, and the counts of the shards of threads which have exited
+  struct error_counter_registry
+  {
+    std::mutex lock;
+    std::vector<const error_counter_shard *> shards;
+    error_counts retired;
+
+    static error_counter_registry &get() noexcept
+    {
+      static error_counter_registry v;
+      return v;
+    }
+  };
+
+#ifdef OUTCOME_ENABLE_PERCPU_COUNTERS
+  /* The keys of the counters kept per CPU, shared by every CPU so that a key has the same index in
+  each. A slot is claimed by its state going from empty to claimed, and published by the release
+  store of it going to published. A thread which finds a slot claimed but not yet published moves on
+  to the next rather than wait, so a key may come to have more than one slot, which `add()` of
+  `error_counts` merges. Once the keys in use are published, lookups only read, so do not contend.
+  */
+  struct error_counter_keys
+  {
+    static constexpr size_t slots = error_counter_shard::slots;
+    enum : uint8_t
+    {
+      empty,
+      claimed,
+      published
+    };
+    struct slot
+    {
+      std::atomic<uint8_t> state{empty};
+      const std::error_category *category{nullptr};
+      int value{0};
+    } table[slots];
+    // Each key's count, then the count of failures for which no slot was free
+    percpu_counters<slots + 1> counts;
+
+    static error_counter_keys &get()
+    {
+      static error_counter_keys v;
+      return v;
+    }
+    // The index of the key, claiming a slot for it if new, or `slots` if the table is full
+    size_t index(const std::error_category &category, int value) noexcept
+    {
+      size_t idx = (reinterpret_cast<uintptr_t>(&category) >> 4) ^ (static_cast<size_t>(value) * 0x9e3779b1u);  // NOLINT
+      for(size_t probe = 0; probe < slots; probe++, idx++)
+      {
+        slot &s = table[idx % slots];
+        uint8_t state = s.state.load(std::memory_order_acquire);
+        if(state == empty && s.state.compare_exchange_strong(state, claimed, std::memory_order_relaxed))
+        {
+          s.category = &category;
+          s.value = value;
+          s.state.store(published, std::memory_order_release);
+          return idx % slots;
+        }
+        if(state == published && s.category == &category && s.value == value)
+        {
+          return idx % slots;
+        }
+      }
+      return slots;
+    }
+    bool add(const std::error_category &category, int value) noexcept
+    {
+      if(counts.cpus() == 0)
+      {
+        return false;
+      }
+      return counts.add(index(category, value));
+    }
+    void merge_into(error_counts &out) const
+    {
+      for(size_t n = 0; n < slots; n++)
+      {
+        if(table[n].state.load(std::memory_order_acquire) == published)
+        {
+          const uint64_t count = counts.sum(n);
+          if(count > 0)
+          {
+            out.add(table[n].category, table[n].value, count);
+          }
+        }
+      }
+      out.overflow += counts.sum(slots);
+    }
+  };
+#endif
+
+  // Registers on first use by a thread, and folds its counts into the retired counts on thread exit
+  struct error_counter_thread
+  {
+    error_counter_shard shard;
+
+    error_counter_thread()
+    {
+      error_counter_registry &r = error_counter_registry::get();
+      std::lock_guard<std::mutex> g(r.lock);
+      r.shards.push_back(&shard);
+    }
+    error_counter_thread(const error_counter_thread &) = delete;
+    error_counter_thread &operator=(const error_counter_thread &) = delete;
+    ~error_counter_thread()
+    {
+      error_counter_registry &r = error_counter_registry::get();
+      std::lock_guard<std::mutex> g(r.lock);
+      shard.merge_into(r.retired);
+      for(auto it = r.shards.begin(); it != r.shards.end(); ++it)
+      {
+        if(*it == &shard)
+        {
+          r.shards.erase(it);
+          break;
+        }
+      }
+    }
+  };
+}  // namespace detail
+
+/*! Counters of failures keyed by error category and value, sharded per thread so that counting
+never contends and never takes a lock. Each thread counts into its own fixed size table, and
+`snapshot()` sums every thread's table without stopping any of them. A thread takes a lock
+once, when it first counts, to register its table, and again on exit to fold its counts into
+those kept for exited threads.
+
+Typical use is from hooks found by ADL:
+
+```c++
+template <class T, class U> inline void hook_result_construction(result<T> *res, U &&) noexcept
+{
+  error_counters::count_failure(res);
+}
+template <class T, class U> inline void hook_outcome_construction(outcome<T> *res, U &&) noexcept
+{
+  error_counters::count_failure(res);
+}
+```
+
+A snapshot taken while threads are counting sees each counter at some recent value, but not
+necessarily every counter at the same instant.
+
+With `OUTCOME_ENABLE_PERCPU_COUNTERS` defined, failures are counted in `percpu_counters`, one table
+per CPU rather than per thread, where restartable sequences are available. The counters then take
+memory in proportion to the cores of the machine rather than its threads, a count is a plain add
+rather than a locked one, and `snapshot()` sums once per core. Threads which cannot count per CPU
+count in their own tables as before. The keys are shared by every CPU, so at most 128 distinct
+failures are counted by key in all, beyond which they count as overflow.
+*/
+struct error_counters
+{
+  //! The counters of the calling thread.
+  static detail::error_counter_shard &this_thread()
+  {
+    static thread_local detail::error_counter_thread v;
+    return v.shard;
+  }
+
+  //! Counts one failure with `category` and `value` on the calling thread.
+  static void count(const std::error_category &category, int value)
+  {
+#ifdef OUTCOME_ENABLE_PERCPU_COUNTERS
+    if(OUTCOME_LIKELY(detail::error_counter_keys::get().add(category, value)))
+    {
+      return;
+    }
+#endif
+    this_thread().add(category, value);
+  }
+  //! \group count
+  template <class ErrorCode> static void count(const ErrorCode &ec) { count(ec.category(), ec.value()); }
+  /*! Counts the error of `r` on the calling thread, if `r` is a `result` or `outcome` in the
+  errored state. The error type must have `category()` and `value()` like `std::error_code`.
+  */
+  template <class Result> static void count_failure(const Result *r)
+  {
+    if(OUTCOME_UNLIKELY(r->has_error()))
+    {
+      count(r->assume_error());
+    }
+  }
+
+  //! Sums the counts of every thread, including those which have exited.
+  static error_counts snapshot()
+  {
+    error_counts ret;
+    snapshot(ret);
+    return ret;
+  }
+  /*! Sums the counts of every thread, including those which have exited, into `out`, replacing
+  what it held. Reuses the capacity of `out`, so allocates nothing once it has grown to the number
+  of distinct errors counted.
+  */
+  static void snapshot(error_counts &out)
+  {
+    detail::error_counter_registry &r = detail::error_counter_registry::get();
+    std::lock_guard<std::mutex> g(r.lock);
+    out.counts.assign(r.retired.counts.begin(), r.retired.counts.end());
+    out.overflow = r.retired.overflow;
+    for(const detail::error_counter_shard *shard : r.shards)
+    {
+      shard->merge_into(out);
+    }
+#ifdef OUTCOME_ENABLE_PERCPU_COUNTERS
+    detail::error_counter_keys::get().merge_into(out);
+#endif
+  }
+};
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
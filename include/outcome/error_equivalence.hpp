@@ -0,0 +1,108 @@
+/* A per thread cache of error code to error condition equivalence
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_ERROR_EQUIVALENCE_HPP
+#define OUTCOME_ERROR_EQUIVALENCE_HPP
+
+#include "result.hpp"
+
+#include <cstring>
+#include <system_error>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  // So that an entry is 32 bytes on 64 bit targets
+  struct equivalence_cache_entry
+  {
+    const std::error_category *code_category;
+    const std::error_category *condition_category;
+    int code;
+    int condition;
+    bool equivalent;
+  };
+  // Trivial, so it is zero initialised without a guard per access
+  struct equivalence_cache
+  {
+    static constexpr size_t entries = 256;
+    equivalence_cache_entry items[entries];
+  };
+  inline equivalence_cache &equivalence_cache_this_thread() noexcept
+  {
+    static thread_local equivalence_cache cache;
+    return cache;
+  }
+
+  inline const std::error_code &equivalence_error_code(const std::error_code &ec) noexcept { return ec; }
+  template <class E> inline auto equivalence_error_code(const E &e) -> decltype(make_error_code(e)) { return make_error_code(e); }
+}  // namespace detail
+
+/*! True if `ec` is equivalent to `cond`, as `ec == cond` is, but remembering the answer in a small
+per thread table of 256 entries keyed by both categories and values, so repeating a query costs a
+hash and a compare instead of up to two virtual calls into the categories. Entries are overwritten
+on collision, so this helps most where a few dozen pairs of code and condition are queried repeatedly.
+
+Categories must answer equivalence queries the same way every time, and must not be destroyed while
+cached, see `clear_equivalence_cache()`.
+*/
+inline bool cached_equivalent(const std::error_code &ec, const std::error_condition &cond) noexcept
+{
+  const auto hash = (reinterpret_cast<uintptr_t>(&ec.category()) >> 4U) ^ (reinterpret_cast<uintptr_t>(&cond.category()) >> 3U)  // NOLINT
+                    ^ static_cast<uintptr_t>(static_cast<unsigned>(ec.value()) * 2654435761U) ^ static_cast<uintptr_t>(static_cast<unsigned>(cond.value()) * 2246822519U);
+  detail::equivalence_cache_entry &entry = detail::equivalence_cache_this_thread().items[hash % detail::equivalence_cache::entries];
+  if(entry.code_category != &ec.category() || entry.condition_category != &cond.category() || entry.code != ec.value() || entry.condition != cond.value())
+  {
+    entry.equivalent = (ec == cond);
+    entry.code_category = &ec.category();
+    entry.condition_category = &cond.category();
+    entry.code = ec.value();
+    entry.condition = cond.value();
+  }
+  return entry.equivalent;
+}
+//! \overload
+OUTCOME_TEMPLATE(class ErrorCondEnum)
+OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_error_condition_enum<ErrorCondEnum>::value))
+inline bool cached_equivalent(const std::error_code &ec, ErrorCondEnum cond) noexcept { return cached_equivalent(ec, std::error_condition(cond)); }
+
+/*! True if `r` has an error equivalent to `cond`, per `cached_equivalent()`. The error must be
+a `std::error_code`, or have an ADL discovered `make_error_code()`.
+*/
+OUTCOME_TEMPLATE(class R, class S, class NoValuePolicy, class Cond)
+OUTCOME_TREQUIRES(OUTCOME_TEXPR(detail::equivalence_error_code(std::declval<const S &>())), OUTCOME_TEXPR(std::error_condition(std::declval<Cond>())))
+inline bool error_equivalent(const detail::result_final<R, S, NoValuePolicy> &r, Cond &&cond) noexcept
+{
+  return r.has_error() && cached_equivalent(detail::equivalence_error_code(r.assume_error()), std::error_condition(std::forward<Cond>(cond)));
+}
+
+//! Forgets the equivalences cached by the calling thread, for example before a category is destroyed.
+inline void clear_equivalence_cache() noexcept
+{
+  memset(&detail::equivalence_cache_this_thread(), 0, sizeof(detail::equivalence_cache));
+}
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
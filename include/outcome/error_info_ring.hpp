@@ -0,0 +1,115 @@
+/* A thread local ring buffer of extended error information
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_ERROR_INFO_RING_HPP
+#define OUTCOME_ERROR_INFO_RING_HPP
+
+#include "result.hpp"
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+/*! A per thread ring of `Slots` items of extended error information of type `Info`, which failed
+results refer to by a sixteen bit tag kept in their spare storage (see `hooks::set_spare_storage()`).
+The low bits of a tag index the slot, the remaining bits are a generation count, so a tag whose
+slot has since been reused is detected as stale. Tag zero is never issued, so a result which
+never claimed a slot is told apart.
+
+Each thread has its own ring, so there are no locks and no atomics. A tag looked up on a thread
+other than the one which claimed it finds nothing, or unrelated information whose generation
+happens to match, so look up the information of a result on the thread which created it.
+
+Typical use is from a `hook_result_construction()` overload found by ADL:
+
+```c++
+template <class T, class U> inline void hook_result_construction(result<T> *res, U &&) noexcept
+{
+  if(res->has_error())
+  {
+    my_info &info = error_info_ring<my_info>::capture(res);
+    // optionally fill in info
+  }
+}
+```
+
+\tparam Info The default constructible extended error information.
+\tparam Slots The number of slots, a power of two between 2 and 4096.
+*/
+template <class Info, size_t Slots = 16> class error_info_ring
+{
+  static_assert(Slots >= 2 && Slots <= 4096 && (Slots & (Slots - 1)) == 0, "Slots must be a power of two between 2 and 4096");
+  static_assert(std::is_default_constructible<Info>::value, "Info must be default constructible");
+
+  Info _slots[Slots];
+  // The tag each slot was last claimed with
+  uint16_t _tags[Slots]{};
+  uint16_t _next{1};
+
+public:
+  //! The extended error information type.
+  using info_type = Info;
+  //! The number of slots.
+  static constexpr size_t slots = Slots;
+
+  //! The ring of the calling thread.
+  static error_info_ring &this_thread() noexcept
+  {
+    static thread_local error_info_ring v;
+    return v;
+  }
+
+  /*! Claims the oldest slot, overwriting whatever it held.
+  \returns The tag of the slot claimed, never zero.
+  */
+  uint16_t claim() noexcept
+  {
+    const uint16_t tag = _next;
+    _next = (_next == 0xffff) ? 1 : static_cast<uint16_t>(_next + 1);
+    _tags[tag % Slots] = tag;
+    return tag;
+  }
+  //! The slot claimed with `tag`, or null if `tag` is zero or stale.
+  Info *find(uint16_t tag) noexcept { return (tag != 0 && _tags[tag % Slots] == tag) ? &_slots[tag % Slots] : nullptr; }
+  //! \group find
+  const Info *find(uint16_t tag) const noexcept { return (tag != 0 && _tags[tag % Slots] == tag) ? &_slots[tag % Slots] : nullptr; }
+  //! The slot for `tag` without checking that it is current.
+  Info &operator[](uint16_t tag) noexcept { return _slots[tag % Slots]; }
+
+  /*! Claims a slot on the calling thread's ring and writes its tag into the spare storage of `r`,
+  which must not already hold a tag.
+  \returns The slot claimed, left as its last user wrote it.
+  */
+  template <class R, class S, class P> static Info &capture(detail::result_final<R, S, P> *r) noexcept
+  {
+    error_info_ring &ring = this_thread();
+    const uint16_t tag = ring.claim();
+    hooks::set_spare_storage(r, tag);
+    return ring[tag];
+  }
+  //! The information captured for `r` on the calling thread's ring, or null if none or stale.
+  template <class R, class S, class P> static Info *lookup(const detail::result_final<R, S, P> &r) noexcept { return this_thread().find(hooks::spare_storage(&r)); }
+};
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,200 @@
+/* Sixteen bit ids of the source locations where failures arise
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_ERROR_SITE_HPP
+#define OUTCOME_ERROR_SITE_HPP
+
+#include "result.hpp"
+#include "try.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#ifndef OUTCOME_MAX_ERROR_SITES
+//! The number of distinct error sites which can be given ids, at most 65535.
+#define OUTCOME_MAX_ERROR_SITES 4096
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+//! A source location where failures arise, as registered by `OUTCOME_ERROR_SITE_ID()`.
+struct error_site
+{
+  const char *file;
+  unsigned line;
+};
+
+namespace detail
+{
+  static_assert(OUTCOME_MAX_ERROR_SITES > 0 && OUTCOME_MAX_ERROR_SITES <= 65535, "OUTCOME_MAX_ERROR_SITES must be between 1 and 65535");
+  struct error_site_table
+  {
+    std::atomic<uint32_t> count{0};
+    std::atomic<const error_site *> sites[OUTCOME_MAX_ERROR_SITES];
+
+    static error_site_table &get() noexcept
+    {
+      static error_site_table v;
+      return v;
+    }
+  };
+}  // namespace detail
+
+/*! Gives `site` an id, which should be done once per site, as `OUTCOME_ERROR_SITE_ID()` does.
+Ids are handed out in order of registration from one, and so differ between runs. Decode them
+with a table from the same process, see `error_sites()`.
+\returns The id, or zero if `OUTCOME_MAX_ERROR_SITES` sites have been registered already.
+*/
+inline uint16_t register_error_site(const error_site *site) noexcept
+{
+  detail::error_site_table &t = detail::error_site_table::get();
+  const uint32_t idx = t.count.fetch_add(1, std::memory_order_relaxed);
+  if(idx >= OUTCOME_MAX_ERROR_SITES)
+  {
+    t.count.store(OUTCOME_MAX_ERROR_SITES, std::memory_order_relaxed);
+    return 0;
+  }
+  t.sites[idx].store(site, std::memory_order_release);
+  return static_cast<uint16_t>(idx + 1);
+}
+//! The site with `id`, or null if there is none.
+inline const error_site *find_error_site(uint16_t id) noexcept
+{
+  if(id == 0 || id > OUTCOME_MAX_ERROR_SITES)
+  {
+    return nullptr;
+  }
+  return detail::error_site_table::get().sites[id - 1].load(std::memory_order_acquire);
+}
+//! Every site registered so far, the site with id `n` being at index `n - 1`, for decoding ids elsewhere.
+inline std::vector<const error_site *> error_sites()
+{
+  detail::error_site_table &t = detail::error_site_table::get();
+  const uint32_t count = std::min<uint32_t>(t.count.load(std::memory_order_relaxed), OUTCOME_MAX_ERROR_SITES);
+  std::vector<const error_site *> ret(count);
+  for(uint32_t n = 0; n < count; n++)
+  {
+    ret[n] = t.sites[n].load(std::memory_order_acquire);
+  }
+  return ret;
+}
+
+/*! Records the error site `id` in the spare storage of `r`, if it is errored. This shares the spare
+storage with anything else using it, such as `error_info_ring`, so use one or the other.
+*/
+template <class R, class S, class P> inline void tag_error_site(detail::result_final<R, S, P> *r, uint16_t id) noexcept
+{
+  if(OUTCOME_UNLIKELY(r->has_error()))
+  {
+    hooks::set_spare_storage(r, id);
+  }
+}
+//! The site recorded in `r` by `tag_error_site()`, or null if none.
+template <class R, class S, class P> inline const error_site *error_site_of(const detail::result_final<R, S, P> &r) noexcept
+{
+  return find_error_site(hooks::spare_storage(&r));
+}
+//! Returns `r`, having recorded the error site `id` in it if it is errored.
+OUTCOME_TEMPLATE(class T)
+OUTCOME_TREQUIRES(OUTCOME_TPRED(is_result_v<T>))
+inline std::decay_t<T> at_error_site(T &&r, uint16_t id) noexcept(std::is_nothrow_constructible<std::decay_t<T>, T>::value)
+{
+  std::decay_t<T> ret(std::forward<T>(r));
+  tag_error_site(&ret, id);
+  return ret;
+}
+
+namespace detail
+{
+  // Tags the failure with a site as it converts into the caller's return type
+  template <class T> class try_failure_at_site
+  {
+    T &&_v;
+    uint16_t _site;
+
+    template <class U> static constexpr void _tag(U & /*unused*/, std::false_type /*unused*/, uint16_t /*unused*/) noexcept {}
+    template <class U> static void _tag(U &r, std::true_type /*unused*/, uint16_t site) noexcept { tag_error_site(&r, site); }
+
+  public:
+    constexpr try_failure_at_site(T &&v, uint16_t site) noexcept : _v(std::forward<T>(v)), _site(site) {}
+    try_failure_at_site(const try_failure_at_site &) = delete;
+    try_failure_at_site(try_failure_at_site &&) = default;  // NOLINT, needed to return by value before C++ 17
+    try_failure_at_site &operator=(const try_failure_at_site &) = delete;
+    try_failure_at_site &operator=(try_failure_at_site &&) = delete;
+    ~try_failure_at_site() = default;
+
+    OUTCOME_TEMPLATE(class U)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(try_convertible_failure<U, T>::value))
+    operator U()  // NOLINT
+    {
+      U ret = try_convert_failure<U>(std::forward<T>(_v));
+      _tag(ret, is_result<U>(), _site);
+      return ret;
+    }
+  };
+}  // namespace detail
+
+/*! As `try_operation_return_as()`, but records the error site `site` in the caller's return type if it
+is a `result`.
+*/
+template <class T> constexpr detail::try_failure_at_site<T> try_operation_return_at_site(T &&v, uint16_t site)
+{
+  detail::trace_propagation(v, site);
+  return detail::try_failure_at_site<T>(std::forward<T>(v), site);
+}
+
+OUTCOME_V2_NAMESPACE_END
+
+/*! The id of the source location where this macro is used. The location is registered the first
+time the expansion is evaluated, after which this costs one load and a branch.
+*/
+#define OUTCOME_ERROR_SITE_ID()                                                                                                                                                                                                                                                                                                \
+  ([]() noexcept -> uint16_t {                                                                                                                                                                                                                                                                                                 \
+    static const OUTCOME_V2_NAMESPACE::error_site site{__FILE__, __LINE__};                                                                                                                                                                                                                                                    \
+    static const uint16_t id = OUTCOME_V2_NAMESPACE::register_error_site(&site);                                                                                                                                                                                                                                               \
+    return id;                                                                                                                                                                                                                                                                                                                 \
+  }())
+
+//! `r`, having recorded where this macro is used in its spare storage if it is errored.
+#define OUTCOME_AT_ERROR_SITE(...) OUTCOME_V2_NAMESPACE::at_error_site((__VA_ARGS__), OUTCOME_ERROR_SITE_ID())
+
+//! \exclude
+#define OUTCOME_TRYV_SITE2(unique, ...) OUTCOME_TRYV2_RETURN(unique, (unique).has_value(), OUTCOME_V2_NAMESPACE::try_operation_return_at_site(std::forward<decltype(unique)>(unique), OUTCOME_ERROR_SITE_ID()), __VA_ARGS__)
+//! \exclude
+#define OUTCOME_TRY_SITE2(unique, v, ...)                                                                                                                                                                                                                                                                                      \
+  OUTCOME_TRYV_SITE2(unique, __VA_ARGS__);                                                                                                                                                                                                                                                                                     \
+  OUTCOME_TRY2_EXTRACT(unique, v)
+
+/*! As `OUTCOME_TRYV()`, but records where this macro is used in the failure returned, if the caller
+returns a `result`.
+*/
+#define OUTCOME_TRYV_SITE(...) OUTCOME_TRYV_SITE2(OUTCOME_TRY_UNIQUE_NAME, __VA_ARGS__)
+/*! As `OUTCOME_TRY()`, but records where this macro is used in the failure returned, if the caller
+returns a `result`.
+*/
+#define OUTCOME_TRY_SITE(v, ...) OUTCOME_TRY_SITE2(OUTCOME_TRY_UNIQUE_NAME, v, __VA_ARGS__)
+
+#endif
@@ -0,0 +1,246 @@
+/* A multi error type whose active type is kept in the status of a result
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_ERRORS_HPP
+#define OUTCOME_ERRORS_HPP
+
+#include "result.hpp"
+
+#include <system_error>
+#include <utility>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+template <class... Es> class errors;
+
+namespace detail
+{
+  // The index of E in Es, or the count of Es if not one of them
+  template <class E, class... Es> constexpr inline size_t errors_index_of() noexcept
+  {
+    constexpr bool same[] = {std::is_same<E, Es>::value..., false};
+    size_t n = 0;
+    while(n < sizeof...(Es) && !same[n])
+    {
+      ++n;
+    }
+    return n;
+  }
+  template <class... Es> constexpr inline bool errors_are_distinct() noexcept
+  {
+    constexpr size_t indices[] = {errors_index_of<Es, Es...>()..., 0};
+    for(size_t n = 0; n < sizeof...(Es); n++)
+    {
+      if(indices[n] != n)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+  constexpr inline bool errors_all(std::initializer_list<bool> bs) noexcept
+  {
+    for(bool b : bs)
+    {
+      if(!b)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+  // A union of Es, which is trivially copyable as they are
+  template <class... Es> union errors_union;
+  template <> union errors_union<>
+  {
+    char _empty;
+    constexpr errors_union() noexcept
+        : _empty()
+    {
+    }
+  };
+  template <class E, class... Es> union errors_union<E, Es...>
+  {
+    E _head;
+    errors_union<Es...> _tail;
+    constexpr errors_union() noexcept
+        : _head()
+    {
+    }
+    constexpr errors_union(std::integral_constant<size_t, 0> /*unused*/, const E &e) noexcept
+        : _head(e)
+    {
+    }
+    template <size_t N, class F>
+    constexpr errors_union(std::integral_constant<size_t, N> /*unused*/, const F &f) noexcept
+        : _tail(std::integral_constant<size_t, N - 1>(), f)
+    {
+    }
+  };
+  template <size_t N> struct errors_get
+  {
+    template <class U> static constexpr decltype(auto) get(const U &u) noexcept { return errors_get<N - 1>::get(u._tail); }
+  };
+  template <> struct errors_get<0>
+  {
+    template <class U> static constexpr decltype(auto) get(const U &u) noexcept { return (u._head); }
+  };
+
+  // A table of the visitor called with each type of Es, indexed by the index of the active type
+  template <class F, class... Es> struct errors_visit_table
+  {
+    using union_type = errors_union<Es...>;
+    using result_type = std::common_type_t<decltype(std::declval<F &>()(std::declval<const Es &>()))...>;
+    using entry = result_type (*)(const union_type &, F &);
+
+    template <size_t N> static result_type call(const union_type &u, F &f) { return f(errors_get<N>::get(u)); }
+    template <size_t... Ns> static result_type dispatch(size_t index, const union_type &u, F &f, std::index_sequence<Ns...> /*unused*/)
+    {
+      static constexpr entry table[] = {&call<Ns>...};
+      return table[index](u, f);
+    }
+  };
+
+  // Converts from the errors of a subset, by the index of each of their types in ours
+  template <class To, class... Fs> struct errors_convert
+  {
+    template <size_t... Ns> static constexpr To convert(size_t index, const errors_union<Fs...> &u, std::index_sequence<Ns...> /*unused*/) noexcept
+    {
+      using entry = To (*)(const errors_union<Fs...> &);
+      constexpr entry table[] = {&one<Ns>...};
+      return table[index](u);
+    }
+    template <size_t N> static constexpr To one(const errors_union<Fs...> &u) noexcept { return To(errors_get<N>::get(u)); }
+  };
+}  // namespace detail
+
+/*! An error which is exactly one of the error types `Es...`, such as the unrelated error enums of
+several layers, without erasing them into a `std::error_code`, and so without the virtual call of
+its category on every inspection.
+
+Each type must be trivially copyable, and the types must be distinct, of which there may be up to
+255. It keeps the index of its active type, as does `std::variant`, which is all `visit()` and
+`visit_error()` dispatch on, through a table of the visitor called with each type.
+
+If every type is an error code enum, `make_error_code()` maps the active error to a
+`std::error_code`, only when called, which makes the default policy of such a result throw it
+as a `std::system_error`.
+*/
+template <class... Es> class errors
+{
+  static_assert(sizeof...(Es) > 0 && sizeof...(Es) < 256, "errors<> needs between one and 255 error types");
+  static_assert(detail::errors_all({std::is_trivially_copyable<Es>::value...}), "errors<> needs error types which are trivially copyable");
+  static_assert(detail::errors_are_distinct<Es...>(), "errors<> needs error types which are distinct");
+  template <class... Fs> friend class errors;
+
+  detail::errors_union<Es...> _u;
+  uint8_t _index{0};
+
+public:
+  //! The number of error types.
+  static constexpr size_t types = sizeof...(Es);
+  //! The index of `E` in the error types, or `types` if not one of them.
+  template <class E> static constexpr size_t index_of() noexcept { return detail::errors_index_of<E, Es...>(); }
+
+  //! Default constructs to a value initialised first error type, as does `std::variant`.
+  constexpr errors() noexcept = default;
+  //! Implicitly constructs from one of the error types.
+  OUTCOME_TEMPLATE(class E)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(detail::errors_index_of<E, Es...>() < sizeof...(Es)))
+  constexpr errors(const E &e) noexcept  // NOLINT
+      : _u(std::integral_constant<size_t, detail::errors_index_of<E, Es...>()>(), e)
+      , _index(static_cast<uint8_t>(detail::errors_index_of<E, Es...>()))
+  {
+  }
+  //! Implicitly constructs from the errors of a subset of the error types.
+  OUTCOME_TEMPLATE(class... Fs)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(!std::is_same<errors<Fs...>, errors>::value && detail::errors_all({(detail::errors_index_of<Fs, Es...>() < sizeof...(Es))...})))
+  constexpr errors(const errors<Fs...> &o) noexcept  // NOLINT
+      : errors(detail::errors_convert<errors, Fs...>::convert(o._index, o._u, std::index_sequence_for<Fs...>()))
+  {
+  }
+
+  //! The index of the active error type.
+  constexpr size_t index() const noexcept { return _index; }
+  //! True if the active error type is `E`.
+  template <class E> constexpr bool holds() const noexcept { return _index == detail::errors_index_of<E, Es...>(); }
+  //! A pointer to the error if its type is `E`, else null.
+  template <class E> constexpr const E *get_if() const noexcept { return holds<E>() ? &detail::errors_get<detail::errors_index_of<E, Es...>()>::get(_u) : nullptr; }
+  //! The error, which must be of type `E`.
+  template <class E> constexpr const E &get() const noexcept { return detail::errors_get<detail::errors_index_of<E, Es...>()>::get(_u); }
+
+  /*! Calls `f` with the error as its active type, through a table of `f` called with each type
+  indexed by the active one.
+  \returns What `f` returns, the common type of what it returns for each type.
+  */
+  template <class F> decltype(auto) visit(F &&f) const
+  {
+    using table = detail::errors_visit_table<std::remove_reference_t<F>, Es...>;
+    return table::dispatch(_index, _u, f, std::index_sequence_for<Es...>());
+  }
+
+  //! True if the active error types are the same and their errors are equal.
+  bool operator==(const errors &o) const noexcept { return _index == o._index && visit([&o](const auto &e) { return e == *o.template get_if<std::decay_t<decltype(e)>>(); }); }
+  //! True if the active error types differ, or their errors do.
+  bool operator!=(const errors &o) const noexcept { return !(*this == o); }
+  //! True if the active error type is `E` and the error equals `e`.
+  OUTCOME_TEMPLATE(class E)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(detail::errors_index_of<E, Es...>() < sizeof...(Es)))
+  friend constexpr bool operator==(const errors &a, const E &e) noexcept { return a.holds<E>() && a.get<E>() == e; }
+  //! True if the active error type is not `E`, or the error does not equal `e`.
+  OUTCOME_TEMPLATE(class E)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(detail::errors_index_of<E, Es...>() < sizeof...(Es)))
+  friend constexpr bool operator!=(const errors &a, const E &e) noexcept { return !(a == e); }
+};
+
+/*! Calls `f` with the error of `e` as its active type. See `errors::visit()`.
+\returns What `f` returns, the common type of what it returns for each type.
+*/
+template <class... Es, class F> inline decltype(auto) visit_error(const errors<Es...> &e, F &&f) { return e.visit(static_cast<F &&>(f)); }
+
+/*! Calls `f` with the error of `r` as its active type. See `errors::visit()`.
+\returns What `f` returns, the common type of what it returns for each type.
+\requires `r` to have an error.
+*/
+template <class T, class... Es, class P, class F> inline decltype(auto) visit_error(const result<T, errors<Es...>, P> &r, F &&f) { return r.assume_error().visit(static_cast<F &&>(f)); }
+
+/*! Maps the error to a `std::error_code`, only when called, which makes `errors` an error code
+type if every one of its types is an error code enum.
+*/
+OUTCOME_TEMPLATE(class... Es)
+OUTCOME_TREQUIRES(OUTCOME_TPRED(detail::errors_all({std::is_error_code_enum<Es>::value...})))
+inline std::error_code make_error_code(const errors<Es...> &e) noexcept
+{
+  return e.visit([](const auto &v) {
+    using std::make_error_code;
+    return make_error_code(v);
+  });
+}
+
+//! Throws a `std::system_error` of the error mapped to a `std::error_code`.
+template <class... Es> inline void throw_as_system_error_with_payload(const errors<Es...> &e) { OUTCOME_THROW_EXCEPTION(std::system_error(make_error_code(e))); }
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,361 @@
+/* A reference counted exception holder usable as the exception type of outcome
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_EXCEPTION_BOX_HPP
+#define OUTCOME_EXCEPTION_BOX_HPP
+
+#include "outcome.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <new>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  // What a box needs to know about the type of exception it holds
+  struct exception_box_ops
+  {
+    void (*destroy)(void *p) noexcept;
+    void (*rethrow)(const void *p);
+    std::exception_ptr (*to_exception_ptr)(const void *p) noexcept;
+    const std::exception *(*get)(const void *p) noexcept;
+  };
+  template <class E> inline const std::exception *exception_box_get(const E *p, std::true_type /*unused*/) noexcept { return p; }
+  template <class E> inline const std::exception *exception_box_get(const E * /*unused*/, std::false_type /*unused*/) noexcept { return nullptr; }
+  template <class E> struct exception_box_ops_for
+  {
+    static void destroy(void *p) noexcept { static_cast<E *>(p)->~E(); }
+    QUICKCPPLIB_NORETURN static void rethrow(const void *p) { OUTCOME_THROW_EXCEPTION(*static_cast<const E *>(p)); }
+    static std::exception_ptr to_exception_ptr(const void *p) noexcept { return std::make_exception_ptr(*static_cast<const E *>(p)); }
+    static const std::exception *get(const void *p) noexcept { return exception_box_get(static_cast<const E *>(p), std::is_base_of<std::exception, E>()); }
+    static const exception_box_ops *ops() noexcept
+    {
+      static constexpr exception_box_ops v{destroy, rethrow, to_exception_ptr, get};
+      return &v;
+    }
+  };
+  // A boxed std::exception_ptr is rethrown as itself
+  template <> struct exception_box_ops_for<std::exception_ptr>
+  {
+    static void destroy(void *p) noexcept { static_cast<std::exception_ptr *>(p)->~exception_ptr(); }
+    QUICKCPPLIB_NORETURN static void rethrow(const void *p) { std::rethrow_exception(*static_cast<const std::exception_ptr *>(p)); }
+    static std::exception_ptr to_exception_ptr(const void *p) noexcept { return *static_cast<const std::exception_ptr *>(p); }
+    static const std::exception *get(const void * /*unused*/) noexcept { return nullptr; }
+    static const exception_box_ops *ops() noexcept
+    {
+      static constexpr exception_box_ops v{destroy, rethrow, to_exception_ptr, get};
+      return &v;
+    }
+  };
+
+  template <bool ThreadSafe> struct exception_box_count
+  {
+    std::atomic<uint32_t> _v{1};
+    void increment() noexcept { _v.fetch_add(1, std::memory_order_relaxed); }
+    bool decrement() noexcept { return _v.fetch_sub(1, std::memory_order_acq_rel) == 1; }
+    uint32_t load() const noexcept { return _v.load(std::memory_order_relaxed); }
+  };
+  template <> struct exception_box_count<false>
+  {
+    uint32_t _v{1};
+    void increment() noexcept { ++_v; }
+    bool decrement() noexcept { return --_v == 0; }
+    uint32_t load() const noexcept { return _v; }
+  };
+
+  //! The largest exception kept in a box's own block, rather than allocated separately.
+  static constexpr size_t exception_box_small_size = 64;
+
+  /* A box's shared state. The exception lives in `storage` if small enough, else on the heap,
+  and blocks are recycled through a per thread free list, so boxing a small exception does not
+  usually allocate.
+  */
+  template <bool ThreadSafe> struct exception_box_block
+  {
+    exception_box_count<ThreadSafe> count;
+    const exception_box_ops *ops{nullptr};
+    void *object{nullptr};
+    alignas(std::max_align_t) unsigned char storage[exception_box_small_size];
+
+    bool is_small() const noexcept { return object == static_cast<const void *>(storage); }
+  };
+
+  /* A per thread free list of blocks of `Bytes`. The list head and length are trivially
+  destructible so they remain usable while other thread locals are destroyed, after which
+  the reaper has emptied the list and disabled it.
+  */
+  template <size_t Bytes> struct exception_box_pool
+  {
+    static constexpr size_t max_free = 32;
+    struct node
+    {
+      node *next;
+    };
+    struct reaper
+    {
+      ~reaper()
+      {
+        while(head() != nullptr)
+        {
+          node *n = head();
+          head() = n->next;
+          ::operator delete(n);
+        }
+        length() = max_free;
+      }
+    };
+    static node *&head() noexcept
+    {
+      static thread_local node *v;
+      return v;
+    }
+    static size_t &length() noexcept
+    {
+      static thread_local size_t v;
+      return v;
+    }
+    static void *allocate()
+    {
+      node *n = head();
+      if(n != nullptr)
+      {
+        head() = n->next;
+        --length();
+        return n;
+      }
+      return ::operator new(Bytes);
+    }
+    static void deallocate(void *p) noexcept
+    {
+      if(length() >= max_free)
+      {
+        ::operator delete(p);
+        return;
+      }
+      if(length() == 0 && head() == nullptr)
+      {
+        // Ensure the list is emptied at thread exit
+        static thread_local reaper r;
+        (void) r;
+      }
+      auto *n = static_cast<node *>(p);
+      n->next = head();
+      head() = n;
+      ++length();
+    }
+  };
+}  // namespace detail
+
+/*! A reference counted holder of an exception of any type, for use as the exception type `P` of
+`outcome<R, S, P>` in place of `std::exception_ptr`.
+
+Copying a box increments a count, which is not atomic unless `ThreadSafe`, and moving one copies
+a pointer. Exceptions up to `detail::exception_box_small_size` bytes, such as `std::runtime_error`
+and `std::system_error`, are kept in the box's shared block, and blocks are recycled through a
+per thread free list, so boxing one rarely allocates. Larger exceptions are allocated separately.
+
+`trait::has_exception_ptr_v` is true for a box, so `outcome` uses the `exception_ptr_rethrow`
+policy by default, which throws the exception boxed directly without creating a `std::exception_ptr`.
+`to_exception_ptr()` converts for code needing a `std::exception_ptr`, which allocates.
+
+\tparam ThreadSafe Whether copies of a box may be copied and destroyed concurrently on different threads.
+Use `exception_box` for outcomes confined to one thread, and `shared_exception_box` otherwise.
+*/
+template <bool ThreadSafe> class basic_exception_box
+{
+  using _block = detail::exception_box_block<ThreadSafe>;
+  using _pool = detail::exception_box_pool<sizeof(_block)>;
+  _block *_b{nullptr};
+
+  template <class E> struct _small
+  {
+    static constexpr bool value = sizeof(E) <= detail::exception_box_small_size;
+  };
+  template <class E, class... Args> static void *_construct(_block *b, std::true_type /*unused*/, Args &&... args) { return new(b->storage) E(std::forward<Args>(args)...); }
+  template <class E, class... Args> static void *_construct(_block * /*unused*/, std::false_type /*unused*/, Args &&... args)
+  {
+    struct guard
+    {
+      void *p;
+      ~guard() { ::operator delete(p); }
+    } g{::operator new(sizeof(E))};
+    void *ret = new(g.p) E(std::forward<Args>(args)...);
+    g.p = nullptr;
+    return ret;
+  }
+  void _release() noexcept
+  {
+    if(_b != nullptr && _b->count.decrement())
+    {
+      _b->ops->destroy(_b->object);
+      if(!_b->is_small())
+      {
+        ::operator delete(_b->object);
+      }
+      _b->~_block();
+      _pool::deallocate(_b);
+    }
+    _b = nullptr;
+  }
+
+public:
+  //! Default constructs an empty box.
+  constexpr basic_exception_box() noexcept = default;
+  //! Boxes `e`, an empty box if `e` is null.
+  explicit basic_exception_box(std::exception_ptr e)
+  {
+    if(e)
+    {
+      *this = make<std::exception_ptr>(std::move(e));
+    }
+  }
+  //! Boxes a copy of the exception `e`.
+  OUTCOME_TEMPLATE(class E)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(!std::is_same<std::decay_t<E>, basic_exception_box>::value && !std::is_same<std::decay_t<E>, std::exception_ptr>::value && !std::is_same<std::decay_t<E>, basic_exception_box<!ThreadSafe>>::value))
+  explicit basic_exception_box(E &&e)
+      : basic_exception_box(make<std::decay_t<E>>(std::forward<E>(e)))
+  {
+  }
+  //! Copy constructor, which shares the exception boxed.
+  basic_exception_box(const basic_exception_box &o) noexcept
+      : _b(o._b)
+  {
+    if(_b != nullptr)
+    {
+      _b->count.increment();
+    }
+  }
+  //! Move constructor.
+  basic_exception_box(basic_exception_box &&o) noexcept
+      : _b(o._b)
+  {
+    o._b = nullptr;
+  }
+  //! Copy assignment.
+  basic_exception_box &operator=(const basic_exception_box &o) noexcept
+  {
+    basic_exception_box temp(o);
+    swap(temp);
+    return *this;
+  }
+  //! Move assignment.
+  basic_exception_box &operator=(basic_exception_box &&o) noexcept
+  {
+    if(this != &o)
+    {
+      _release();
+      _b = o._b;
+      o._b = nullptr;
+    }
+    return *this;
+  }
+  ~basic_exception_box() { _release(); }
+
+  //! Boxes an exception of type `E` constructed from `args`.
+  template <class E, class... Args> static basic_exception_box make(Args &&... args)
+  {
+    static_assert(alignof(E) <= alignof(std::max_align_t), "Over aligned exceptions cannot be boxed");
+    // Returns the block to the pool if constructing the exception throws
+    struct guard
+    {
+      _block *b;
+      ~guard()
+      {
+        if(b != nullptr)
+        {
+          b->~_block();
+          _pool::deallocate(b);
+        }
+      }
+    } g{new(_pool::allocate()) _block};
+    g.b->object = _construct<E>(g.b, std::integral_constant<bool, _small<E>::value>(), std::forward<Args>(args)...);
+    g.b->ops = detail::exception_box_ops_for<E>::ops();
+    basic_exception_box ret;
+    ret._b = g.b;
+    g.b = nullptr;
+    return ret;
+  }
+
+  //! True if an exception is boxed.
+  explicit operator bool() const noexcept { return _b != nullptr; }
+  //! The exception boxed if it derives from `std::exception`, else null.
+  const std::exception *get() const noexcept { return (_b != nullptr) ? _b->ops->get(_b->object) : nullptr; }
+  //! The number of boxes sharing the exception, zero if empty.
+  uint32_t use_count() const noexcept { return (_b != nullptr) ? _b->count.load() : 0; }
+  /*! Throws the exception boxed.
+  \requires An exception to be boxed, else `std::terminate()` is called.
+  */
+  QUICKCPPLIB_NORETURN void rethrow() const
+  {
+    if(_b == nullptr)
+    {
+      std::terminate();
+    }
+    _b->ops->rethrow(_b->object);
+    std::terminate();  // unreachable
+  }
+  //! A `std::exception_ptr` to a copy of the exception boxed, or null if empty.
+  std::exception_ptr to_exception_ptr() const noexcept { return (_b != nullptr) ? _b->ops->to_exception_ptr(_b->object) : std::exception_ptr(); }
+  //! Swaps with another box.
+  void swap(basic_exception_box &o) noexcept
+  {
+    _block *temp = _b;
+    _b = o._b;
+    o._b = temp;
+  }
+
+  //! Found by ADL for `policy::exception_ptr()` and `trait::has_exception_ptr_v`.
+  friend inline std::exception_ptr make_exception_ptr(const basic_exception_box &v) noexcept { return v.to_exception_ptr(); }
+  //! True if both box the same exception, or neither boxes one.
+  friend inline bool operator==(const basic_exception_box &a, const basic_exception_box &b) noexcept { return a._b == b._b; }
+  //! True if the boxes hold different exceptions.
+  friend inline bool operator!=(const basic_exception_box &a, const basic_exception_box &b) noexcept { return a._b != b._b; }
+};
+
+//! A box for exceptions of outcomes which stay on one thread.
+using exception_box = basic_exception_box<false>;
+//! A box for exceptions of outcomes shared between threads.
+using shared_exception_box = basic_exception_box<true>;
+
+//! Boxes an exception of type `E` constructed from `args` for outcomes which stay on one thread.
+template <class E, class... Args> inline exception_box make_exception_box(Args &&... args)
+{
+  return exception_box::make<E>(std::forward<Args>(args)...);
+}
+
+namespace trait
+{
+  //! A box is a pointer to its shared block.
+  template <bool ThreadSafe> struct is_move_bitcopying<basic_exception_box<ThreadSafe>>
+  {
+    static constexpr bool value = true;
+  };
+}  // namespace trait
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,636 @@
+/* A work stealing executor of tasks returning results
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_EXECUTOR_HPP
+#define OUTCOME_EXECUTOR_HPP
+
+#include "outcome.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+class executor;
+template <class R> class task_handle;
+template <class R> class task_group;
+
+namespace detail
+{
+  // A unit of work. run() is called exactly once, and disposes of the job
+  struct executor_job
+  {
+    virtual void run() noexcept = 0;
+
+  protected:
+    executor_job() = default;
+    executor_job(const executor_job &) = delete;
+    executor_job &operator=(const executor_job &) = delete;
+    ~executor_job() = default;
+  };
+
+  /* A fixed capacity Chase-Lev deque, as corrected for weak memory models by Lê et al. Only the owning
+  worker pushes and pops at the bottom, any thread steals from the top.
+  */
+  class work_stealing_deque
+  {
+    static constexpr int64_t _capacity = 1024;
+    // Padded rather than aligned, as these are allocated by array new before C++ 17
+    std::atomic<int64_t> _top{0};
+    char _pad1[64 - sizeof(std::atomic<int64_t>)];
+    std::atomic<int64_t> _bottom{0};
+    char _pad2[64 - sizeof(std::atomic<int64_t>)];
+    std::atomic<executor_job *> _buffer[_capacity];
+
+  public:
+    work_stealing_deque() noexcept {}  // NOLINT
+    work_stealing_deque(const work_stealing_deque &) = delete;
+    work_stealing_deque &operator=(const work_stealing_deque &) = delete;
+
+    // Returns false if full
+    bool push(executor_job *j) noexcept
+    {
+      const int64_t b = _bottom.load(std::memory_order_relaxed);
+      const int64_t t = _top.load(std::memory_order_acquire);
+      if(b - t >= _capacity)
+      {
+        return false;
+      }
+      _buffer[b & (_capacity - 1)].store(j, std::memory_order_relaxed);
+      _bottom.store(b + 1, std::memory_order_release);
+      return true;
+    }
+    executor_job *pop() noexcept
+    {
+      const int64_t b = _bottom.load(std::memory_order_relaxed) - 1;
+      _bottom.store(b, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      int64_t t = _top.load(std::memory_order_relaxed);
+      if(t > b)
+      {
+        _bottom.store(b + 1, std::memory_order_relaxed);
+        return nullptr;
+      }
+      executor_job *j = _buffer[b & (_capacity - 1)].load(std::memory_order_relaxed);
+      if(t == b)
+      {
+        // The last item, so race any thieves for it
+        if(!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+          j = nullptr;
+        }
+        _bottom.store(b + 1, std::memory_order_relaxed);
+      }
+      return j;
+    }
+    executor_job *steal() noexcept
+    {
+      int64_t t = _top.load(std::memory_order_acquire);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      const int64_t b = _bottom.load(std::memory_order_acquire);
+      if(t >= b)
+      {
+        return nullptr;
+      }
+      executor_job *j = _buffer[t & (_capacity - 1)].load(std::memory_order_relaxed);
+      if(!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+      {
+        return nullptr;
+      }
+      return j;
+    }
+  };
+
+  // Which executor, and which of its workers, this thread is
+  struct executor_worker
+  {
+    executor *owner{nullptr};
+    size_t index{0};
+  };
+  inline executor_worker &current_executor_worker() noexcept
+  {
+    static thread_local executor_worker v;
+    return v;
+  }
+
+  // The state shared by a task's job and its handle
+  template <class R> struct task_state : executor_job
+  {
+    executor *owner;
+    task_group<R> *group;
+    std::atomic<uint32_t> refs{2};
+    std::atomic<bool> ready{false};
+    std::exception_ptr exception;
+    bool have_result{false};
+    union {
+      empty_type _empty;
+      R result;
+    };
+
+    task_state(executor *o, task_group<R> *g) noexcept
+        : owner(o)
+        , group(g)
+        , _empty{}
+    {
+    }
+    virtual ~task_state()
+    {
+      if(have_result)
+      {
+        result.~R();
+      }
+    }
+    void release() noexcept
+    {
+      if(refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      {
+        delete this;
+      }
+    }
+    template <class U> void complete(U &&v) noexcept
+    {
+      new(&result) R(static_cast<U &&>(v));  // NOLINT
+      have_result = true;
+    }
+  };
+
+  template <class R, class F> struct task_job final : task_state<R>
+  {
+    F f;
+
+    template <class U>
+    task_job(executor *o, task_group<R> *g, U &&u)
+        : task_state<R>(o, g)
+        , f(static_cast<U &&>(u))
+    {
+    }
+    inline void run() noexcept override;
+  };
+
+  // The type task_group<R>::wait() returns
+  template <class R, bool = is_outcome_v<R>> struct task_group_join
+  {
+    using type = result<void, typename R::error_type>;
+  };
+  template <class R> struct task_group_join<R, true>
+  {
+    using type = outcome<void, typename R::error_type, typename R::exception_type>;
+  };
+}  // namespace detail
+
+/*! A fixed set of worker threads, each with its own Chase-Lev deque, which run tasks returning a
+`result` or `outcome`.
+
+Tasks submitted from a worker go onto that worker's deque, where it takes the newest first. Tasks
+submitted from other threads go onto a shared queue. Idle workers take from the shared queue, then
+steal the oldest tasks from other workers' deques, then sleep. Threads waiting on a task or a group
+help run tasks until it is done, so tasks may wait on tasks they spawned without deadlocking.
+
+Exceptions thrown by a task are captured and rethrown on the thread which gets the task's result.
+*/
+class executor
+{
+  template <class R> friend class task_handle;
+  template <class R> friend class task_group;
+
+  size_t _worker_count;
+  std::unique_ptr<detail::work_stealing_deque[]> _deques;
+  std::vector<std::thread> _threads;
+  std::mutex _lock;
+  std::condition_variable _wake;
+  std::deque<detail::executor_job *> _injected;
+  bool _stopping{false};
+  // How many tasks are queued anywhere, how many are in the shared queue, and how many workers sleep
+  std::atomic<size_t> _pending{0};
+  std::atomic<size_t> _injected_count{0};
+  std::atomic<size_t> _sleepers{0};
+
+  static constexpr size_t _no_worker = static_cast<size_t>(-1);
+
+  size_t _current_worker() noexcept
+  {
+    const detail::executor_worker &w = detail::current_executor_worker();
+    return (w.owner == this) ? w.index : _no_worker;
+  }
+  void _enqueue(detail::executor_job *j)
+  {
+    // Either this sees a sleeper, or the sleeper sees this task pending and looks for it
+    _pending.fetch_add(1, std::memory_order_seq_cst);
+    const size_t self = _current_worker();
+    if(self == _no_worker || !_deques[self].push(j))
+    {
+      std::lock_guard<std::mutex> g(_lock);
+      _injected.push_back(j);
+      _injected_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    if(_sleepers.load(std::memory_order_seq_cst) != 0)
+    {
+      std::lock_guard<std::mutex> g(_lock);
+      _wake.notify_one();
+    }
+  }
+  detail::executor_job *_take(size_t self) noexcept
+  {
+    detail::executor_job *j = nullptr;
+    if(self != _no_worker)
+    {
+      j = _deques[self].pop();
+    }
+    if(j == nullptr && _injected_count.load(std::memory_order_relaxed) != 0)
+    {
+      std::lock_guard<std::mutex> g(_lock);
+      if(!_injected.empty())
+      {
+        j = _injected.front();
+        _injected.pop_front();
+        _injected_count.fetch_sub(1, std::memory_order_relaxed);
+      }
+    }
+    // Steal from the workers after this one in turn, wrapping around to start from the first for
+    // threads which are not workers
+    for(size_t n = 1; j == nullptr && n <= _worker_count; n++)
+    {
+      const size_t victim = (self + n) % _worker_count;
+      if(victim != self)
+      {
+        j = _deques[victim].steal();
+      }
+    }
+    return j;
+  }
+  // Runs one queued task, returning false if none could be found
+  bool _run_one(size_t self) noexcept
+  {
+    detail::executor_job *j = _take(self);
+    if(j == nullptr)
+    {
+      return false;
+    }
+    _pending.fetch_sub(1, std::memory_order_relaxed);
+    j->run();
+    return true;
+  }
+  template <class Pred> void _help_until(Pred &&done) noexcept
+  {
+    const size_t self = _current_worker();
+    while(!done())
+    {
+      if(!_run_one(self))
+      {
+        std::this_thread::yield();
+      }
+    }
+  }
+  void _worker(size_t idx)
+  {
+    detail::current_executor_worker() = {this, idx};
+    for(;;)
+    {
+      if(_run_one(idx))
+      {
+        continue;
+      }
+      std::unique_lock<std::mutex> g(_lock);
+      _sleepers.fetch_add(1, std::memory_order_seq_cst);
+      while(_pending.load(std::memory_order_seq_cst) == 0 && !_stopping)
+      {
+        _wake.wait(g);
+      }
+      _sleepers.fetch_sub(1, std::memory_order_relaxed);
+      if(_stopping && _pending.load(std::memory_order_relaxed) == 0)
+      {
+        return;
+      }
+    }
+  }
+  template <class R, class F> task_handle<R> _submit(task_group<R> *group, F &&f);
+
+public:
+  //! Starts `threads` workers, zero meaning one per hardware thread.
+  explicit executor(size_t threads = 0)
+      : _worker_count((threads != 0) ? threads : std::max<size_t>(1, std::thread::hardware_concurrency()))
+      , _deques(new detail::work_stealing_deque[_worker_count])
+  {
+    _threads.reserve(_worker_count);
+    for(size_t n = 0; n < _worker_count; n++)
+    {
+      _threads.emplace_back([this, n] { _worker(n); });
+    }
+  }
+  executor(const executor &) = delete;
+  executor(executor &&) = delete;
+  executor &operator=(const executor &) = delete;
+  executor &operator=(executor &&) = delete;
+  //! Runs all queued tasks, then stops and joins the workers.
+  ~executor()
+  {
+    {
+      std::lock_guard<std::mutex> g(_lock);
+      _stopping = true;
+      _wake.notify_all();
+    }
+    for(auto &t : _threads)
+    {
+      t.join();
+    }
+  }
+
+  //! The number of worker threads.
+  size_t size() const noexcept { return _worker_count; }
+
+  /*! Queues `f()` to be run by a worker.
+  \returns A handle to the `result` or `outcome` which `f()` returns.
+  */
+  template <class F, class R = std::decay_t<decltype(std::declval<F &>()())>> task_handle<R> submit(F &&f);
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+  /*! Returns an awaitable which resumes the awaiting coroutine on a worker, for example from within
+  an `awaitables::lazy` task.
+  */
+  auto schedule() noexcept
+  {
+    struct resume_job final : detail::executor_job
+    {
+      std::coroutine_handle<> h;
+      void run() noexcept override
+      {
+        auto h_ = h;
+        delete this;
+        h_.resume();
+      }
+    };
+    struct awaiter
+    {
+      executor *ex;
+      bool await_ready() const noexcept { return false; }
+      void await_suspend(std::coroutine_handle<> h)
+      {
+        auto *j = new resume_job;
+        j->h = h;
+        ex->_enqueue(j);
+      }
+      void await_resume() const noexcept {}
+    };
+    return awaiter{this};
+  }
+#endif
+};
+
+/*! A handle to the `result` or `outcome` returned by a task, which is of type `R`.
+
+Waiting helps the executor run tasks until this one is done.
+*/
+template <class R> class task_handle
+{
+  friend class executor;
+  detail::task_state<R> *_state{nullptr};
+
+  explicit task_handle(detail::task_state<R> *s) noexcept
+      : _state(s)
+  {
+  }
+
+public:
+  //! The type of `result` or `outcome` returned by the task.
+  using result_type = R;
+
+  //! Constructs a handle to no task.
+  task_handle() = default;
+  task_handle(const task_handle &) = delete;
+  task_handle(task_handle &&o) noexcept
+      : _state(o._state)
+  {
+    o._state = nullptr;
+  }
+  task_handle &operator=(const task_handle &) = delete;
+  task_handle &operator=(task_handle &&o) noexcept
+  {
+    if(this != &o)
+    {
+      this->~task_handle();
+      new(this) task_handle(static_cast<task_handle &&>(o));
+    }
+    return *this;
+  }
+  //! Detaches from the task, which still runs unless its group is cancelled.
+  ~task_handle()
+  {
+    if(_state != nullptr)
+    {
+      _state->release();
+      _state = nullptr;
+    }
+  }
+
+  //! True if this handle refers to a task.
+  bool valid() const noexcept { return _state != nullptr; }
+  //! True if the task has been run or dropped.
+  bool is_ready() const noexcept { return _state->ready.load(std::memory_order_acquire); }
+  /*! Waits until the task has been run or dropped, then returns what it returned. A task dropped
+  because its group was cancelled returns the group's first failure.
+  \throws Any exception the task threw, or which cancelled its group.
+  */
+  result_type &wait()
+  {
+    _state->owner->_help_until([this] { return is_ready(); });
+    if(!_state->have_result)
+    {
+      std::rethrow_exception(_state->exception);
+    }
+    return _state->result;
+  }
+  //! Waits as `wait()` does, then moves out what the task returned.
+  result_type get() { return static_cast<result_type &&>(wait()); }
+};
+
+/*! A group of tasks returning `R`, a `result` or `outcome`, which fails as a whole.
+
+The first task of the group to return a failure, or to throw, cancels the group. Tasks of the group
+which have not yet started are then dropped without running, and their handles return the group's
+first failure. The group must outlive its tasks, and its destructor waits for them.
+*/
+template <class R> class task_group
+{
+  template <class, class> friend struct detail::task_job;
+
+public:
+  //! The type of `result` or `outcome` returned by the tasks.
+  using result_type = R;
+  //! The type of failure recorded.
+  using failure_type = std::decay_t<decltype(std::declval<R &&>().as_failure())>;
+  //! The type returned by `wait()`, valued if no task failed.
+  using join_type = typename detail::task_group_join<R>::type;
+
+private:
+  executor *_executor;
+  std::atomic<size_t> _outstanding{0};
+  std::atomic<bool> _failed{false};
+  std::atomic<bool> _cancelled{false};
+  std::unique_ptr<failure_type> _failure;
+  std::exception_ptr _exception;
+
+  // Called by the task which failed first, with r failed
+  void _fail(R &r) noexcept
+  {
+    if(!_failed.exchange(true, std::memory_order_relaxed))
+    {
+      _failure.reset(new failure_type(r.as_failure()));
+      _cancelled.store(true, std::memory_order_release);
+    }
+  }
+  void _fail(std::exception_ptr e) noexcept
+  {
+    if(!_failed.exchange(true, std::memory_order_relaxed))
+    {
+      _exception = std::move(e);
+      _cancelled.store(true, std::memory_order_release);
+    }
+  }
+  void _done() noexcept { _outstanding.fetch_sub(1, std::memory_order_release); }
+
+public:
+  //! Constructs a group of tasks run by `ex`.
+  explicit task_group(executor &ex) noexcept
+      : _executor(&ex)
+  {
+  }
+  task_group(const task_group &) = delete;
+  task_group(task_group &&) = delete;
+  task_group &operator=(const task_group &) = delete;
+  task_group &operator=(task_group &&) = delete;
+  //! Waits for all the tasks of the group to be run or dropped.
+  ~task_group()
+  {
+    _executor->_help_until([this] { return _outstanding.load(std::memory_order_acquire) == 0; });
+  }
+
+  //! True if a task of the group has failed, so its remaining tasks will be dropped.
+  bool cancelled() const noexcept { return _cancelled.load(std::memory_order_acquire); }
+
+  /*! Queues `f()`, which must return `R`, to be run by a worker unless the group is cancelled first.
+  \returns A handle to what `f()` returns.
+  */
+  template <class F> task_handle<R> spawn(F &&f)
+  {
+    static_assert(std::is_convertible<decltype(std::declval<std::decay_t<F> &>()()), R>::value, "The task must return the group's result type");
+    _outstanding.fetch_add(1, std::memory_order_relaxed);
+    return _executor->_submit(this, std::forward<F>(f));
+  }
+
+  /*! Waits until all the tasks of the group have been run or dropped.
+  \returns Success if no task failed, else the first failure.
+  \throws The exception which cancelled the group, if one did.
+  */
+  join_type wait()
+  {
+    _executor->_help_until([this] { return _outstanding.load(std::memory_order_acquire) == 0; });
+    if(!_failed.load(std::memory_order_acquire))
+    {
+      return success();
+    }
+    if(_exception)
+    {
+      std::rethrow_exception(_exception);
+    }
+    return *_failure;
+  }
+};
+
+namespace detail
+{
+  template <class R, class F> inline void task_job<R, F>::run() noexcept
+  {
+    task_group<R> *g = this->group;
+    if(g != nullptr && g->cancelled())
+    {
+      // Dropped, so complete with the group's failure
+      if(g->_failure)
+      {
+        this->complete(*g->_failure);
+      }
+      else
+      {
+        this->exception = g->_exception;
+      }
+    }
+    else
+    {
+#ifdef __cpp_exceptions
+      try
+#endif
+      {
+        this->complete(f());
+        if(g != nullptr && !this->result.has_value())
+        {
+          g->_fail(this->result);
+        }
+      }
+#ifdef __cpp_exceptions
+      catch(...)
+      {
+        this->exception = std::current_exception();
+        if(g != nullptr)
+        {
+          g->_fail(this->exception);
+        }
+      }
+#endif
+    }
+    this->ready.store(true, std::memory_order_release);
+    if(g != nullptr)
+    {
+      g->_done();
+    }
+    this->release();
+  }
+}  // namespace detail
+
+template <class R, class F> inline task_handle<R> executor::_submit(task_group<R> *group, F &&f)
+{
+  auto *j = new detail::task_job<R, std::decay_t<F>>(this, group, std::forward<F>(f));
+  _enqueue(j);
+  return task_handle<R>(j);
+}
+
+template <class F, class R> inline task_handle<R> executor::submit(F &&f)
+{
+  static_assert(is_result_v<R> || is_outcome_v<R>, "The task must return a result or an outcome");
+  return _submit<R>(nullptr, std::forward<F>(f));
+}
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,433 @@
+/* Batches of file opens, reads and closes returning results, through io_uring on Linux
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_FILE_BATCH_HPP
+#define OUTCOME_FILE_BATCH_HPP
+
+#include "result.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+#include <vector>
+
+#if defined(__has_include)
+#if __has_include(<version>)
+#include <version>
+#endif
+#endif
+#ifdef __cpp_lib_span
+#include <span>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && defined(__NR_io_uring_register)
+//! Defined to 1 if `file_batch` can submit through io_uring on this platform, when the kernel allows.
+#define OUTCOME_HAVE_IO_URING 1
+#endif
+#endif
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+//! A read of `bytes` bytes at `offset` of the file `fd` into `buffer`, for `file_batch::read()`.
+struct file_read
+{
+  int fd;
+  void *buffer;
+  size_t bytes;
+  uint64_t offset;
+};
+
+namespace detail
+{
+  // An errno as an error, which the result flags with status_error_is_errno
+  inline result<int> file_batch_result(int ret, int code) noexcept
+  {
+    if(ret < 0)
+    {
+      return std::error_code(code, std::generic_category());
+    }
+    return ret;
+  }
+
+#ifdef OUTCOME_HAVE_IO_URING
+  /* The rings of an io_uring, mapped with the kernel. The heads and tails are shared with the
+  kernel, so are accessed with the atomic builtins rather than std::atomic.
+  */
+  class io_uring_rings
+  {
+    int _fd{-1};
+    void *_sq{MAP_FAILED}, *_cq{MAP_FAILED};
+    size_t _sq_bytes{0}, _cq_bytes{0};
+    io_uring_sqe *_sqes{static_cast<io_uring_sqe *>(MAP_FAILED)};
+    size_t _sqes_bytes{0};
+    unsigned *_sq_head{nullptr}, *_sq_tail{nullptr}, *_sq_mask{nullptr}, *_sq_array{nullptr};
+    unsigned *_cq_head{nullptr}, *_cq_tail{nullptr}, *_cq_mask{nullptr};
+    io_uring_cqe *_cqes{nullptr};
+    unsigned _entries{0};
+
+    static bool _supports(int fd, std::initializer_list<int> ops) noexcept
+    {
+      // The probe is also the check of the kernel being new enough for these opcodes
+      alignas(io_uring_probe) char buffer[sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op)];
+      memset(buffer, 0, sizeof(buffer));
+      auto *probe = reinterpret_cast<io_uring_probe *>(buffer);  // NOLINT
+      if(::syscall(__NR_io_uring_register, fd, IORING_REGISTER_PROBE, probe, 256) < 0)
+      {
+        return false;
+      }
+      for(int op : ops)
+      {
+        if(op > probe->last_op || (probe->ops[op].flags & IO_URING_OP_SUPPORTED) == 0)
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    void _release() noexcept
+    {
+      if(_sqes != MAP_FAILED)
+      {
+        ::munmap(_sqes, _sqes_bytes);
+      }
+      if(_cq != MAP_FAILED)
+      {
+        ::munmap(_cq, _cq_bytes);
+      }
+      if(_sq != MAP_FAILED)
+      {
+        ::munmap(_sq, _sq_bytes);
+      }
+      if(_fd >= 0)
+      {
+        ::close(_fd);
+      }
+      _fd = -1;
+      _sq = _cq = MAP_FAILED;
+      _sqes = static_cast<io_uring_sqe *>(MAP_FAILED);
+      _entries = 0;
+    }
+
+  public:
+    explicit io_uring_rings(unsigned entries) noexcept
+    {
+      io_uring_params params;
+      memset(&params, 0, sizeof(params));
+      _fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+      if(_fd < 0)
+      {
+        return;
+      }
+      _sq_bytes = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+      _cq_bytes = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+      _sqes_bytes = params.sq_entries * sizeof(io_uring_sqe);
+      _sq = ::mmap(nullptr, _sq_bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQ_RING);
+      _cq = ::mmap(nullptr, _cq_bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_CQ_RING);
+      _sqes = static_cast<io_uring_sqe *>(::mmap(nullptr, _sqes_bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQES));
+      if(_sq == MAP_FAILED || _cq == MAP_FAILED || _sqes == MAP_FAILED || !_supports(_fd, {IORING_OP_OPENAT, IORING_OP_READ, IORING_OP_CLOSE}))
+      {
+        _release();
+        return;
+      }
+      auto *sq = static_cast<char *>(_sq), *cq = static_cast<char *>(_cq);
+      _sq_head = reinterpret_cast<unsigned *>(sq + params.sq_off.head);  // NOLINT
+      _sq_tail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);  // NOLINT
+      _sq_mask = reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);  // NOLINT
+      _sq_array = reinterpret_cast<unsigned *>(sq + params.sq_off.array);  // NOLINT
+      _cq_head = reinterpret_cast<unsigned *>(cq + params.cq_off.head);  // NOLINT
+      _cq_tail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);  // NOLINT
+      _cq_mask = reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);  // NOLINT
+      _cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);  // NOLINT
+      _entries = params.sq_entries;
+    }
+    io_uring_rings(const io_uring_rings &) = delete;
+    io_uring_rings &operator=(const io_uring_rings &) = delete;
+    ~io_uring_rings() { _release(); }
+
+    bool valid() const noexcept { return _entries != 0; }
+
+    /* Submits `n` operations, prepared by `prep(sqe, index)`, a ring full at a time, and stores
+    the result of each into out[index]. Returns false if the ring failed, in which case the
+    operations not yet submitted are left untouched in `out` and `first_unsubmitted` says where.
+    */
+    template <class Prep> bool run(size_t n, result<int> *out, Prep &&prep, size_t &first_unsubmitted) noexcept
+    {
+      size_t next = 0, completed = 0;
+      unsigned in_flight = 0;
+      while(completed < n)
+      {
+        // Fill the free submission entries
+        unsigned queued = 0;
+        const unsigned tail = *_sq_tail;
+        while(next < n && in_flight + queued < _entries)
+        {
+          const unsigned idx = (tail + queued) & *_sq_mask;
+          io_uring_sqe *sqe = &_sqes[idx];
+          memset(sqe, 0, sizeof(*sqe));
+          prep(sqe, next);
+          sqe->user_data = next;
+          _sq_array[idx] = idx;
+          queued++;
+          next++;
+        }
+        __atomic_store_n(_sq_tail, tail + queued, __ATOMIC_RELEASE);
+        // Submit what was queued, and wait for at least one completion
+        unsigned to_submit = queued;
+        for(;;)
+        {
+          const long ret = ::syscall(__NR_io_uring_enter, _fd, to_submit, 1U, IORING_ENTER_GETEVENTS, nullptr, 0);
+          if(ret >= 0)
+          {
+            in_flight += static_cast<unsigned>(ret);
+            to_submit -= static_cast<unsigned>(ret);
+            if(to_submit == 0)
+            {
+              break;
+            }
+            continue;
+          }
+          if(errno != EINTR && errno != EAGAIN && errno != EBUSY)
+          {
+            // What the kernel did not take is rewound, and left to the caller
+            __atomic_store_n(_sq_tail, tail + queued - to_submit, __ATOMIC_RELEASE);
+            next -= to_submit;
+            while(in_flight > 0)
+            {
+              in_flight -= _reap(out, completed);
+              if(in_flight > 0 && ::syscall(__NR_io_uring_enter, _fd, 0U, 1U, IORING_ENTER_GETEVENTS, nullptr, 0) < 0 && errno != EINTR)
+              {
+                break;
+              }
+            }
+            first_unsubmitted = next;
+            return false;
+          }
+        }
+        in_flight -= _reap(out, completed);
+      }
+      first_unsubmitted = n;
+      return true;
+    }
+
+    // Stores every completion available, returning how many
+    unsigned _reap(result<int> *out, size_t &completed) noexcept
+    {
+      unsigned head = *_cq_head, ret = 0;
+      const unsigned tail = __atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE);
+      for(; head != tail; head++, ret++)
+      {
+        const io_uring_cqe &cqe = _cqes[head & *_cq_mask];
+        out[cqe.user_data] = file_batch_result(cqe.res, -cqe.res);
+        completed++;
+      }
+      __atomic_store_n(_cq_head, head, __ATOMIC_RELEASE);
+      return ret;
+    }
+  };
+#endif
+}  // namespace detail
+
+/*! Opens, reads and closes files in batches, returning a `result<int>` per operation, whose error
+is the `errno` of the operation, in the generic category and so flagged `status_error_is_errno`.
+
+On Linux, each batch is submitted through an io_uring, a ring full of operations per system call,
+so that thousands of operations cost a few submissions rather than a system call each. The ring is
+set up by the constructor, and if the kernel does not allow io_uring, or lacks the opcodes needed,
+which came in Linux 5.6, each operation is made as a blocking system call instead, which is also
+what happens on other POSIX platforms. `uses_io_uring()` says which.
+
+The operations of a batch run concurrently and in no particular order, so a batch must not read a
+file which it also opens. A `file_batch` is not thread safe, so use one per thread.
+*/
+class file_batch
+{
+#ifdef OUTCOME_HAVE_IO_URING
+  detail::io_uring_rings _ring;
+#endif
+
+  template <class Prep, class Call> void _run(size_t n, result<int> *out, Prep &&prep, Call &&call) noexcept
+  {
+    size_t first = 0;
+#ifdef OUTCOME_HAVE_IO_URING
+    if(_ring.valid() && _ring.run(n, out, prep, first))
+    {
+      return;
+    }
+#else
+    (void) prep;
+#endif
+    for(size_t idx = first; idx < n; idx++)
+    {
+      out[idx] = call(idx);
+    }
+  }
+
+public:
+  /*! Sets up a ring of `entries` submissions, rounded up to a power of two by the kernel. Batches
+  larger than the ring are submitted a ring full at a time.
+  */
+  explicit file_batch(unsigned entries = 256) noexcept
+#ifdef OUTCOME_HAVE_IO_URING
+      : _ring(entries)
+#endif
+  {
+    (void) entries;
+  }
+
+  //! True if batches are submitted through an io_uring, false if they are made a system call each.
+  bool uses_io_uring() const noexcept
+  {
+#ifdef OUTCOME_HAVE_IO_URING
+    return _ring.valid();
+#else
+    return false;
+#endif
+  }
+
+#if defined(__unix__) || defined(__APPLE__)
+  /*! Opens each of the `n` paths, relative to `dirfd`, with `flags` and `mode` as `openat()`
+  does, into `out`, the file descriptor opened or the `errno` of the failure.
+  */
+  void open(const char *const *paths, size_t n, result<int> *out, int flags = O_RDONLY | O_CLOEXEC, mode_t mode = 0, int dirfd = AT_FDCWD) noexcept
+  {
+    _run(
+    n, out,
+    [&](void *sqe, size_t idx) {
+#ifdef OUTCOME_HAVE_IO_URING
+      auto *s = static_cast<io_uring_sqe *>(sqe);
+      s->opcode = IORING_OP_OPENAT;
+      s->fd = dirfd;
+      s->addr = reinterpret_cast<uintptr_t>(paths[idx]);  // NOLINT
+      s->len = mode;
+      s->open_flags = static_cast<uint32_t>(flags);
+#else
+      (void) sqe;
+      (void) idx;
+#endif
+    },
+    [&](size_t idx) {
+      int fd;
+      do
+      {
+        fd = ::openat(dirfd, paths[idx], flags, mode);  // NOLINT
+      } while(-1 == fd && EINTR == errno);
+      return detail::file_batch_result(fd, errno);
+    });
+  }
+  /*! Makes each of the `n` reads into `out`, the number of bytes read, which is less than asked
+  for at the end of the file, or the `errno` of the failure.
+  */
+  void read(const file_read *reads, size_t n, result<int> *out) noexcept
+  {
+    _run(
+    n, out,
+    [&](void *sqe, size_t idx) {
+#ifdef OUTCOME_HAVE_IO_URING
+      auto *s = static_cast<io_uring_sqe *>(sqe);
+      s->opcode = IORING_OP_READ;
+      s->fd = reads[idx].fd;
+      s->addr = reinterpret_cast<uintptr_t>(reads[idx].buffer);  // NOLINT
+      s->len = static_cast<uint32_t>(reads[idx].bytes);
+      s->off = reads[idx].offset;
+#else
+      (void) sqe;
+      (void) idx;
+#endif
+    },
+    [&](size_t idx) {
+      ssize_t bytes;
+      do
+      {
+        bytes = ::pread(reads[idx].fd, reads[idx].buffer, reads[idx].bytes, static_cast<off_t>(reads[idx].offset));
+      } while(-1 == bytes && EINTR == errno);
+      return detail::file_batch_result(static_cast<int>(bytes), errno);
+    });
+  }
+  //! Closes each of the `n` file descriptors into `out`, zero or the `errno` of the failure.
+  void close(const int *fds, size_t n, result<int> *out) noexcept
+  {
+    _run(
+    n, out,
+    [&](void *sqe, size_t idx) {
+#ifdef OUTCOME_HAVE_IO_URING
+      auto *s = static_cast<io_uring_sqe *>(sqe);
+      s->opcode = IORING_OP_CLOSE;
+      s->fd = fds[idx];
+#else
+      (void) sqe;
+      (void) idx;
+#endif
+    },
+    // Not retried on EINTR, as the descriptor is released regardless
+    [&](size_t idx) { return detail::file_batch_result(::close(fds[idx]), errno); });
+  }
+
+  //! \group open
+  std::vector<result<int>> open(const std::vector<const char *> &paths, int flags = O_RDONLY | O_CLOEXEC, mode_t mode = 0, int dirfd = AT_FDCWD)
+  {
+    std::vector<result<int>> ret(paths.size(), result<int>(0));
+    open(paths.data(), paths.size(), ret.data(), flags, mode, dirfd);
+    return ret;
+  }
+  //! \group read
+  std::vector<result<int>> read(const std::vector<file_read> &reads)
+  {
+    std::vector<result<int>> ret(reads.size(), result<int>(0));
+    read(reads.data(), reads.size(), ret.data());
+    return ret;
+  }
+  //! \group close
+  std::vector<result<int>> close(const std::vector<int> &fds)
+  {
+    std::vector<result<int>> ret(fds.size(), result<int>(0));
+    close(fds.data(), fds.size(), ret.data());
+    return ret;
+  }
+#ifdef __cpp_lib_span
+  //! \group open
+  void open(std::span<const char *const> paths, std::span<result<int>> out, int flags = O_RDONLY | O_CLOEXEC, mode_t mode = 0, int dirfd = AT_FDCWD) noexcept { open(paths.data(), std::min(paths.size(), out.size()), out.data(), flags, mode, dirfd); }
+  //! \group read
+  void read(std::span<const file_read> reads, std::span<result<int>> out) noexcept { read(reads.data(), std::min(reads.size(), out.size()), out.data()); }
+  //! \group close
+  void close(std::span<const int> fds, std::span<result<int>> out) noexcept { close(fds.data(), std::min(fds.size(), out.size()), out.data()); }
+#endif
+#endif
+};
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
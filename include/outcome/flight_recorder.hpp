@@ -0,0 +1,387 @@
+/* A memory mapped flight recorder of failures which survives the process
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_FLIGHT_RECORDER_HPP
+#define OUTCOME_FLIGHT_RECORDER_HPP
+
+#include "error_site.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define OUTCOME_HAVE_FLIGHT_RECORDER 1
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+//! The layout of a flight recorder file, which post-mortem tools may read directly.
+namespace flight_recorder_layout
+{
+  //! The file begins with these eight bytes.
+  static constexpr char magic[8] = {'O', 'U', 'T', 'C', 'F', 'L', 'T', '1'};
+  //! The most error categories whose names are kept.
+  static constexpr uint32_t max_categories = 64;
+  //! The length of the space for each category name, including its terminating zero.
+  static constexpr uint32_t category_name_length = 32;
+
+  //! One failure, exactly one cache line.
+  struct alignas(64) record
+  {
+    //! One plus its index in its ring, written last, so a reader can detect torn or stale records.
+    std::atomic<uint64_t> sequence;
+    //! Nanoseconds since the system clock epoch.
+    uint64_t timestamp;
+    //! One plus the index of the name of the error category, or zero if unknown.
+    uint32_t category;
+    //! The error code value.
+    int32_t code;
+    //! The error site id, see `error_site`, or zero if unknown.
+    uint16_t site;
+    uint16_t _reserved16;
+    uint32_t _reserved32;
+    uint64_t _reserved[4];
+  };
+  static_assert(sizeof(record) == 64, "record must be one cache line");
+
+  //! The header of each thread's ring, which its records follow.
+  struct alignas(64) ring
+  {
+    //! The number of records ever written to this ring.
+    std::atomic<uint64_t> head;
+    //! An identifier of the thread which owns the ring.
+    uint64_t thread;
+  };
+
+  //! The header of the file, which the rings follow.
+  struct alignas(64) file
+  {
+    char magic[8];
+    uint32_t record_size;
+    uint32_t rings;
+    uint32_t slots;
+    //! The number of rings claimed by threads.
+    std::atomic<uint32_t> rings_claimed;
+    //! The number of category names stored.
+    std::atomic<uint32_t> categories;
+    char category_names[max_categories][category_name_length];
+  };
+
+  //! The bytes taken by each ring, including its header.
+  constexpr size_t ring_bytes(uint32_t slots) noexcept { return sizeof(ring) + size_t(slots) * sizeof(record); }
+  //! The bytes taken by a file of `rings` rings of `slots` records.
+  constexpr size_t file_bytes(uint32_t rings, uint32_t slots) noexcept { return sizeof(file) + size_t(rings) * ring_bytes(slots); }
+  //! The ring `idx` of a mapped file.
+  inline ring *ring_at(file *f, uint32_t idx) noexcept { return reinterpret_cast<ring *>(reinterpret_cast<char *>(f) + sizeof(file) + idx * ring_bytes(f->slots)); }  // NOLINT
+  //! The records following a ring header.
+  inline record *records_of(ring *r) noexcept { return reinterpret_cast<record *>(r + 1); }  // NOLINT
+}  // namespace flight_recorder_layout
+
+//! A failure read back from a flight recorder file by `flight_recorder::read()`.
+struct flight_record
+{
+  //! Nanoseconds since the system clock epoch.
+  uint64_t timestamp;
+  //! The index of the ring, and so of the thread, which recorded it.
+  uint32_t ring;
+  //! The owning thread identifier of the ring.
+  uint64_t thread;
+  //! The name of the error category, empty if unknown.
+  std::string category;
+  int code;
+  //! The error site id in the recording process, zero if unknown.
+  uint16_t site;
+};
+
+namespace detail
+{
+  struct flight_recorder_state
+  {
+    std::atomic<flight_recorder_layout::file *> mapping{nullptr};
+    std::atomic<uint32_t> generation{0};
+    size_t bytes{0};
+    std::mutex lock;
+
+    static flight_recorder_state &get() noexcept
+    {
+      static flight_recorder_state v;
+      return v;
+    }
+
+    // The id of a category, registering its name if new. Only called on a thread's cache miss.
+    uint32_t category_id(flight_recorder_layout::file *f, const std::error_category &category) noexcept
+    {
+      const char *name = category.name();
+      std::lock_guard<std::mutex> g(lock);
+      const uint32_t count = f->categories.load(std::memory_order_relaxed);
+      for(uint32_t n = 0; n < count; n++)
+      {
+        if(0 == strncmp(f->category_names[n], name, flight_recorder_layout::category_name_length - 1))
+        {
+          return n + 1;
+        }
+      }
+      if(count == flight_recorder_layout::max_categories)
+      {
+        return 0;
+      }
+      strncpy(f->category_names[count], name, flight_recorder_layout::category_name_length - 1);  // NOLINT
+      f->categories.store(count + 1, std::memory_order_release);
+      return count + 1;
+    }
+  };
+
+  // Each thread's claimed ring, and a small cache of category ids
+  struct flight_recorder_thread
+  {
+    uint32_t generation{0};
+    flight_recorder_layout::ring *ring{nullptr};
+    const std::error_category *categories[8]{};
+    uint32_t category_ids[8]{};
+
+    static flight_recorder_thread &get() noexcept
+    {
+      static thread_local flight_recorder_thread v;
+      return v;
+    }
+  };
+}  // namespace detail
+
+/*! A flight recorder of failures, kept in a memory mapped file so that it survives the death of
+the process. Each thread appends to its own ring in the file, one cache line per failure,
+using plain stores and a release fence, with no system calls and no locks, save for the first
+time a thread records, or sees an error category it has not seen before.
+
+Typical use is from hooks found by ADL, along with error sites (see `OUTCOME_TRY_SITE`):
+
+```c++
+template <class T, class U> inline void hook_result_construction(result<T> *res, U &&) noexcept
+{
+  flight_recorder::record_failure(res);
+}
+```
+
+The file outlives the process which wrote it, and `read()` turns it back into records. Error sites
+are recorded as ids, which must be decoded with `error_sites()` from the recording process.
+*/
+class flight_recorder
+{
+public:
+  /*! Creates or truncates the file at `path` and maps it, replacing any file already open. Threads
+  which record once all `rings` rings are claimed record nothing.
+  \param path The file.
+  \param rings The number of rings, one per recording thread.
+  \param slots The number of records per ring, after which the oldest are overwritten.
+  */
+  static result<void> open(const char *path, uint32_t rings = 64, uint32_t slots = 1024) noexcept
+  {
+    namespace layout = flight_recorder_layout;
+    const size_t bytes = layout::file_bytes(rings, slots);
+    int fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);  // NOLINT
+    if(fd == -1)
+    {
+      return std::error_code(errno, std::system_category());
+    }
+    if(-1 == ::ftruncate(fd, static_cast<off_t>(bytes)))
+    {
+      const int code = errno;
+      ::close(fd);
+      return std::error_code(code, std::system_category());
+    }
+    void *addr = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    const int code = errno;
+    ::close(fd);
+    if(addr == MAP_FAILED)  // NOLINT
+    {
+      return std::error_code(code, std::system_category());
+    }
+    auto *f = static_cast<layout::file *>(addr);
+    memcpy(f->magic, layout::magic, sizeof(f->magic));
+    f->record_size = sizeof(layout::record);
+    f->rings = rings;
+    f->slots = slots;
+    close();
+    detail::flight_recorder_state &state = detail::flight_recorder_state::get();
+    state.bytes = bytes;
+    state.generation.fetch_add(1, std::memory_order_relaxed);
+    state.mapping.store(f, std::memory_order_release);
+    return success();
+  }
+  /*! Flushes and unmaps the file, if open. Must not race with threads recording.
+  */
+  static void close() noexcept
+  {
+    detail::flight_recorder_state &state = detail::flight_recorder_state::get();
+    flight_recorder_layout::file *f = state.mapping.exchange(nullptr, std::memory_order_acq_rel);
+    if(f != nullptr)
+    {
+      ::msync(f, state.bytes, MS_ASYNC);
+      ::munmap(f, state.bytes);
+    }
+  }
+
+  //! Records a failure with `category` and `code` at error site `site` on the calling thread, if the file is open.
+  static void record(const std::error_category &category, int code, uint16_t site = 0) noexcept
+  {
+    namespace layout = flight_recorder_layout;
+    detail::flight_recorder_state &state = detail::flight_recorder_state::get();
+    layout::file *f = state.mapping.load(std::memory_order_acquire);
+    if(f == nullptr)
+    {
+      return;
+    }
+    detail::flight_recorder_thread &me = detail::flight_recorder_thread::get();
+    const uint32_t generation = state.generation.load(std::memory_order_relaxed);
+    if(me.generation != generation)
+    {
+      me = detail::flight_recorder_thread();
+      me.generation = generation;
+      const uint32_t idx = f->rings_claimed.fetch_add(1, std::memory_order_relaxed);
+      if(idx < f->rings)
+      {
+        me.ring = layout::ring_at(f, idx);
+        me.ring->thread = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(&me));  // NOLINT
+      }
+    }
+    if(me.ring == nullptr)
+    {
+      return;
+    }
+    const size_t cache = (reinterpret_cast<uintptr_t>(&category) >> 4) % 8;  // NOLINT
+    if(me.categories[cache] != &category)
+    {
+      me.categories[cache] = &category;
+      me.category_ids[cache] = state.category_id(f, category);
+    }
+    const uint64_t idx = me.ring->head.load(std::memory_order_relaxed);
+    layout::record &r = layout::records_of(me.ring)[idx % f->slots];
+    r.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    r.timestamp = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+    r.category = me.category_ids[cache];
+    r.code = code;
+    r.site = site;
+    std::atomic_thread_fence(std::memory_order_release);
+    r.sequence.store(idx + 1, std::memory_order_relaxed);
+    me.ring->head.store(idx + 1, std::memory_order_release);
+  }
+  /*! Records the error of `r` on the calling thread, if it is a `result` or `outcome` in the errored
+  state, along with any error site recorded in its spare storage by `tag_error_site()`. The error
+  type must have `category()` and `value()` like `std::error_code`.
+  */
+  template <class R, class S, class P> static void record_failure(const detail::result_final<R, S, P> *r) noexcept
+  {
+    if(OUTCOME_UNLIKELY(r->has_error()))
+    {
+      const auto &ec = r->assume_error();
+      record(ec.category(), ec.value(), hooks::spare_storage(r));
+    }
+  }
+
+  /*! Reads back the records of the flight recorder file at `path`, which may be being written to.
+  \returns The records of every ring, oldest first, less any overwritten as they were read.
+  */
+  static result<std::vector<flight_record>> read(const char *path)
+  {
+    namespace layout = flight_recorder_layout;
+    int fd = ::open(path, O_RDONLY);  // NOLINT
+    if(fd == -1)
+    {
+      return std::error_code(errno, std::system_category());
+    }
+    struct stat st;  // NOLINT
+    if(-1 == ::fstat(fd, &st))
+    {
+      const int code = errno;
+      ::close(fd);
+      return std::error_code(code, std::system_category());
+    }
+    const auto bytes = static_cast<size_t>(st.st_size);
+    if(bytes < sizeof(layout::file))
+    {
+      ::close(fd);
+      return std::make_error_code(std::errc::invalid_argument);
+    }
+    void *addr = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    const int code = errno;
+    ::close(fd);
+    if(addr == MAP_FAILED)  // NOLINT
+    {
+      return std::error_code(code, std::system_category());
+    }
+    auto *f = static_cast<layout::file *>(addr);
+    if(0 != memcmp(f->magic, layout::magic, sizeof(f->magic)) || f->record_size != sizeof(layout::record) || layout::file_bytes(f->rings, f->slots) > bytes)
+    {
+      ::munmap(addr, bytes);
+      return std::make_error_code(std::errc::invalid_argument);
+    }
+    std::vector<flight_record> ret;
+    const uint32_t categories = std::min(f->categories.load(std::memory_order_acquire), layout::max_categories);
+    const uint32_t rings = std::min(f->rings_claimed.load(std::memory_order_relaxed), f->rings);
+    for(uint32_t n = 0; n < rings; n++)
+    {
+      layout::ring *ring = layout::ring_at(f, n);
+      const uint64_t head = ring->head.load(std::memory_order_acquire);
+      for(uint64_t idx = (head > f->slots) ? head - f->slots : 0; idx < head; idx++)
+      {
+        const layout::record &r = layout::records_of(ring)[idx % f->slots];
+        if(r.sequence.load(std::memory_order_acquire) != idx + 1)
+        {
+          continue;
+        }
+        flight_record out{r.timestamp, n, ring->thread, {}, r.code, r.site};
+        if(r.category != 0 && r.category <= categories)
+        {
+          out.category.assign(f->category_names[r.category - 1], strnlen(f->category_names[r.category - 1], layout::category_name_length));
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        // Skip the record if it was overwritten whilst being read
+        if(r.sequence.load(std::memory_order_relaxed) == idx + 1)
+        {
+          ret.push_back(std::move(out));
+        }
+      }
+    }
+    ::munmap(addr, bytes);
+    std::stable_sort(ret.begin(), ret.end(), [](const flight_record &a, const flight_record &b) { return a.timestamp < b.timestamp; });
+    return {std::move(ret)};
+  }
+};
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
+#endif
@@ -0,0 +1,365 @@
+/* Formatting of results and outcomes into caller owned buffers
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_FORMAT_HPP
+#define OUTCOME_FORMAT_HPP
+
+#include "outcome.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <system_error>
+
+#if defined(__has_include)
+#if __has_include(<version>)
+#include <version>
+#endif
+#endif
+#ifdef __cpp_lib_string_view
+#include <string_view>
+#endif
+#ifdef __cpp_lib_format
+#include <format>
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  // So that an entry is 128 bytes on 64 bit targets
+  static constexpr size_t error_message_cache_text = 115;
+  struct error_message_cache_entry
+  {
+    const std::error_category *category;
+    int value;
+    unsigned char length;
+    char text[error_message_cache_text];
+  };
+  // Trivial, so it is zero initialised without a guard per access
+  struct error_message_cache
+  {
+    static constexpr size_t entries = 64;
+    error_message_cache_entry items[entries];
+  };
+  inline std::atomic<bool> &error_message_cache_enabled() noexcept
+  {
+    static std::atomic<bool> v{false};
+    return v;
+  }
+
+  template <class OutputIt> inline OutputIt format_chars(OutputIt out, const char *data, size_t length)
+  {
+    for(size_t n = 0; n < length; n++)
+    {
+      *out++ = data[n];
+    }
+    return out;
+  }
+  template <class OutputIt> inline OutputIt format_chars(OutputIt out, const char *data) { return format_chars(out, data, strlen(data)); }
+
+  // Calls f(data, length) with the message of ec, from the calling thread's cache if enabled
+  template <class F> inline auto with_error_message(const std::error_code &ec, F &&f)
+  {
+    if(!error_message_cache_enabled().load(std::memory_order_relaxed))
+    {
+      const std::string message = ec.message();
+      return f(message.data(), message.size());
+    }
+    static thread_local error_message_cache cache;
+    const auto hash = (reinterpret_cast<uintptr_t>(&ec.category()) >> 4U) ^ static_cast<uintptr_t>(static_cast<unsigned>(ec.value()) * 2654435761U);  // NOLINT
+    error_message_cache_entry &entry = cache.items[hash % error_message_cache::entries];
+    if(entry.category != &ec.category() || entry.value != ec.value())
+    {
+      const std::string message = ec.message();
+      entry.length = static_cast<unsigned char>(std::min(message.size(), error_message_cache_text));
+      memcpy(entry.text, message.data(), entry.length);
+      entry.category = &ec.category();
+      entry.value = ec.value();
+    }
+    return f(entry.text, static_cast<size_t>(entry.length));
+  }
+
+  // Formats an item as streaming it into a default formatted std::ostream would
+  template <class OutputIt> inline OutputIt format_item(OutputIt out, bool v) { return format_chars(out, v ? "1" : "0", 1); }
+  template <class OutputIt> inline OutputIt format_item(OutputIt out, char v)
+  {
+    *out++ = v;
+    return out;
+  }
+  OUTCOME_TEMPLATE(class OutputIt, class T)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_integral<T>::value && !std::is_same<T, bool>::value && !std::is_same<T, char>::value))
+  inline OutputIt format_item(OutputIt out, T v)
+  {
+    char buffer[24];
+    char *p = buffer + sizeof(buffer);
+    using unsigned_type = std::make_unsigned_t<T>;
+    auto u = static_cast<unsigned_type>(v);
+    const bool negative = v < T(0);  // NOLINT
+    if(negative)
+    {
+      u = static_cast<unsigned_type>(unsigned_type(0) - u);
+    }
+    do
+    {
+      *--p = static_cast<char>('0' + u % 10);
+      u = static_cast<unsigned_type>(u / 10);
+    } while(u != 0);
+    if(negative)
+    {
+      *--p = '-';
+    }
+    return format_chars(out, p, static_cast<size_t>(buffer + sizeof(buffer) - p));
+  }
+  template <class OutputIt> inline OutputIt format_item(OutputIt out, double v)
+  {
+    char buffer[32];
+    const int length = snprintf(buffer, sizeof(buffer), "%g", v);
+    return format_chars(out, buffer, static_cast<size_t>(length));
+  }
+  template <class OutputIt> inline OutputIt format_item(OutputIt out, float v) { return format_item(out, static_cast<double>(v)); }
+  template <class OutputIt> inline OutputIt format_item(OutputIt out, long double v)
+  {
+    char buffer[48];
+    const int length = snprintf(buffer, sizeof(buffer), "%Lg", v);
+    return format_chars(out, buffer, static_cast<size_t>(length));
+  }
+  template <class OutputIt> inline OutputIt format_item(OutputIt out, const char *v) { return format_chars(out, v); }
+  template <class OutputIt> inline OutputIt format_item(OutputIt out, const std::string &v) { return format_chars(out, v.data(), v.size()); }
+#ifdef __cpp_lib_string_view
+  template <class OutputIt> inline OutputIt format_item(OutputIt out, std::string_view v) { return format_chars(out, v.data(), v.size()); }
+#endif
+  // Formatted as print() does, with the message after the code
+  template <class OutputIt> inline OutputIt format_item(OutputIt out, const std::error_code &v)
+  {
+    out = format_chars(out, v.category().name());
+    *out++ = ':';
+    out = format_item(out, v.value());
+    out = format_chars(out, " (", 2);
+    out = with_error_message(v, [&](const char *data, size_t length) { return format_chars(out, data, length); });
+    *out++ = ')';
+    return out;
+  }
+  // Anything else is streamed, which allocates
+  OUTCOME_TEMPLATE(class OutputIt, class T)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(!std::is_arithmetic<T>::value && !std::is_convertible<const T &, const char *>::value && !std::is_convertible<const T &, const std::error_code &>::value
+#ifdef __cpp_lib_string_view
+                                  && !std::is_convertible<const T &, std::string_view>::value
+#endif
+                                  ))
+  inline OutputIt format_item(OutputIt out, const T &v)
+  {
+    std::ostringstream s;
+    s << v;
+    const std::string str = s.str();
+    return format_chars(out, str.data(), str.size());
+  }
+
+  template <class OutputIt, class R> inline OutputIt format_value(OutputIt out, const R &v, std::false_type /*is void*/) { return format_item(out, v.assume_value()); }
+  template <class OutputIt, class R> inline OutputIt format_value(OutputIt out, const R & /*unused*/, std::true_type /*is void*/) { return format_chars(out, "(+void)", 7); }
+  template <class OutputIt, class R> inline OutputIt format_error(OutputIt out, const R &v, std::false_type /*is void*/) { return format_item(out, v.assume_error()); }
+  template <class OutputIt, class R> inline OutputIt format_error(OutputIt out, const R & /*unused*/, std::true_type /*is void*/) { return format_chars(out, "(-void)", 7); }
+
+  template <class OutputIt, class P> inline OutputIt format_exception(OutputIt out, const P &v)
+  {
+#ifdef __cpp_exceptions
+    try
+    {
+      std::rethrow_exception(OUTCOME_V2_NAMESPACE::policy::exception_ptr(v));
+    }
+    catch(const std::system_error &e)
+    {
+      out = format_chars(out, "std::system_error code ", 23);
+      const std::error_code &ec = e.code();
+      out = format_chars(out, ec.category().name());
+      *out++ = ':';
+      out = format_item(out, ec.value());
+      out = format_chars(out, ": ", 2);
+      return format_chars(out, e.what());
+    }
+    catch(const std::exception &e)
+    {
+      out = format_chars(out, "std::exception: ", 16);
+      return format_chars(out, e.what());
+    }
+    catch(...)
+#else
+    (void) v;
+#endif
+    {
+      return format_chars(out, "unknown exception", 17);
+    }
+  }
+  template <class OutputIt, class O> inline OutputIt format_exception(OutputIt out, const O &v, std::false_type /*is void*/) { return format_exception(out, v.assume_exception()); }
+  template <class OutputIt, class O> inline OutputIt format_exception(OutputIt out, const O & /*unused*/, std::true_type /*is void*/) { return out; }
+
+  // Drops what would not fit, noting that it did so
+  class bounded_chars
+  {
+    char *_cur, *_end;
+    bool *_overflow;
+
+  public:
+    using iterator_category = std::output_iterator_tag;
+    using value_type = void;
+    using difference_type = ptrdiff_t;
+    using pointer = void;
+    using reference = void;
+
+    bounded_chars(char *cur, char *end, bool *overflow) noexcept
+        : _cur(cur)
+        , _end(end)
+        , _overflow(overflow)
+    {
+    }
+    bounded_chars &operator*() noexcept { return *this; }
+    bounded_chars &operator++() noexcept { return *this; }
+    bounded_chars &operator++(int) noexcept { return *this; }
+    bounded_chars &operator=(char c) noexcept
+    {
+      if(_cur != _end)
+      {
+        *_cur++ = c;
+      }
+      else
+      {
+        *_overflow = true;
+      }
+      return *this;
+    }
+    char *get() const noexcept { return _cur; }
+  };
+}  // namespace detail
+
+/*! Enables or disables the cache of error code messages used by `format_to()` and `to_chars()`.
+Once enabled, the message of each error code is fetched once per thread and kept in a small fixed
+size table, so formatting a code seen before allocates nothing. Cached messages are truncated to
+115 characters, and error categories must not change their messages nor be destroyed while cached.
+The cache is disabled by default.
+*/
+inline void enable_error_message_cache(bool enabled = true) noexcept { detail::error_message_cache_enabled().store(enabled, std::memory_order_relaxed); }
+
+/*! Formats `v` into `out` as `print()` does, except that `hooks::hook_result_print()` is not called.
+Arithmetic values, strings and error codes are formatted without allocating, save for the message
+of an error code unless `enable_error_message_cache()` was called. Other types are streamed into a
+`std::ostream`, which allocates.
+\returns The output iterator after the last character written.
+*/
+template <class OutputIt, class R, class S, class P> inline OutputIt format_to(OutputIt out, const detail::result_final<R, S, P> &v)
+{
+  if(v.has_value())
+  {
+    out = detail::format_value(out, v, std::is_void<R>());
+  }
+  if(v.has_error())
+  {
+    out = detail::format_error(out, v, std::is_void<S>());
+  }
+  return out;
+}
+//! Formats `v` into `out` as `print()` does, see the overload for `result`.
+template <class OutputIt, class R, class S, class P, class N> inline OutputIt format_to(OutputIt out, const outcome<R, S, P, N> &v)
+{
+  const int total = static_cast<int>(v.has_value()) + static_cast<int>(v.has_error()) + static_cast<int>(v.has_exception());
+  if(total > 1)
+  {
+    out = detail::format_chars(out, "{ ", 2);
+  }
+  out = format_to(out, static_cast<const detail::result_final<R, S, N> &>(v));
+  if(total > 1)
+  {
+    out = detail::format_chars(out, ", ", 2);
+  }
+  if(v.has_exception())
+  {
+    out = detail::format_exception(out, v, std::is_void<P>());
+  }
+  if(total > 1)
+  {
+    out = detail::format_chars(out, " }", 2);
+  }
+  return out;
+}
+
+//! The result of `to_chars()`, as for `std::to_chars()`.
+struct to_chars_result
+{
+  //! One past the last character written.
+  char *ptr;
+  //! `std::errc::value_too_large` if the buffer was too small, else the default.
+  std::errc ec;
+};
+/*! Formats `v` into the buffer `[first, last)` as `format_to()` does, without null terminating it.
+\returns The end of what was written, and `std::errc::value_too_large` if it did not all fit, in
+which case the buffer holds as much as fitted.
+*/
+template <class T> inline auto to_chars(char *first, char *last, const T &v) -> decltype(format_to(std::declval<char *>(), v), to_chars_result())
+{
+  bool overflow = false;
+  const detail::bounded_chars end = format_to(detail::bounded_chars(first, last, &overflow), v);
+  return {end.get(), overflow ? std::errc::value_too_large : std::errc()};
+}
+
+OUTCOME_V2_NAMESPACE_END
+
+#ifdef __cpp_lib_format
+namespace std
+{
+  //! Formats a `result` as `OUTCOME_V2_NAMESPACE::format_to()` does. Only the empty format specification is accepted.
+  template <class R, class S, class P> struct formatter<OUTCOME_V2_NAMESPACE::result<R, S, P>, char>
+  {
+    constexpr auto parse(std::format_parse_context &ctx)
+    {
+      auto it = ctx.begin();
+      if(it != ctx.end() && *it != '}')
+      {
+        throw std::format_error("result takes no format specification");
+      }
+      return it;
+    }
+    template <class FormatContext> auto format(const OUTCOME_V2_NAMESPACE::result<R, S, P> &v, FormatContext &ctx) const { return OUTCOME_V2_NAMESPACE::format_to(ctx.out(), v); }
+  };
+  //! Formats an `outcome` as `OUTCOME_V2_NAMESPACE::format_to()` does. Only the empty format specification is accepted.
+  template <class R, class S, class P, class N> struct formatter<OUTCOME_V2_NAMESPACE::outcome<R, S, P, N>, char>
+  {
+    constexpr auto parse(std::format_parse_context &ctx)
+    {
+      auto it = ctx.begin();
+      if(it != ctx.end() && *it != '}')
+      {
+        throw std::format_error("outcome takes no format specification");
+      }
+      return it;
+    }
+    template <class FormatContext> auto format(const OUTCOME_V2_NAMESPACE::outcome<R, S, P, N> &v, FormatContext &ctx) const { return OUTCOME_V2_NAMESPACE::format_to(ctx.out(), v); }
+  };
+}  // namespace std
+#endif
+
+#endif
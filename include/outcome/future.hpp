@@ -0,0 +1,355 @@
+/* An allocation free promise and future pair carrying a result
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_FUTURE_HPP
+#define OUTCOME_FUTURE_HPP
+
+#include "atomic_result.hpp"
+
+#include <cassert>
+#include <cstddef>  // for max_align_t
+#include <exception>  // for terminate
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+template <class T, class E> class promise;
+template <class T, class E> class future;
+template <class T, class E, size_t N> class shared_state_pool;
+
+/*! The state shared by one `promise` and its `future`, which the caller provides or takes from a
+`shared_state_pool`. Neither ever allocates.
+
+A caller provided state must outlive both the promise and the future made from it, and is used once.
+*/
+template <class T, class E = std::error_code> class shared_state
+{
+  template <class, class> friend class promise;
+  template <class, class> friend class future;
+  template <class, class, size_t> friend class shared_state_pool;
+
+public:
+  //! The type of result carried.
+  using result_type = result<T, E>;
+  //! The bytes available to store a continuation, larger callables must capture by pointer.
+  static constexpr size_t continuation_capacity = 4 * sizeof(void *);
+
+private:
+  static constexpr uint32_t _continuation_none = 0;
+  static constexpr uint32_t _continuation_attached = 1;
+  static constexpr uint32_t _continuation_completed = 2;
+
+  atomic_result<T, E> _result;
+  // Whichever of completion and attachment comes second runs the continuation
+  std::atomic<uint32_t> _continuation{_continuation_none};
+  // The promise and the future each hold a reference
+  std::atomic<uint32_t> _refs{0};
+  void (*_release)(shared_state *, void *){nullptr};
+  void *_pool{nullptr};
+  void (*_invoke)(void *, const result_type &){nullptr};
+  void (*_destroy)(void *){nullptr};
+  alignas(std::max_align_t) unsigned char _storage[continuation_capacity];
+
+  void _run_continuation() noexcept { _invoke(_storage, _result.wait()); }
+  void _complete() noexcept
+  {
+    if(_continuation.exchange(_continuation_completed, std::memory_order_acq_rel) == _continuation_attached)
+    {
+      _run_continuation();
+    }
+  }
+  void _retain() noexcept { _refs.fetch_add(1, std::memory_order_relaxed); }
+  void _unretain() noexcept
+  {
+    if(_refs.fetch_sub(1, std::memory_order_acq_rel) == 1 && _release != nullptr)
+    {
+      _release(this, _pool);
+    }
+  }
+
+public:
+  //! Constructs an unused state.
+  shared_state() = default;
+  shared_state(const shared_state &) = delete;
+  shared_state(shared_state &&) = delete;
+  shared_state &operator=(const shared_state &) = delete;
+  shared_state &operator=(shared_state &&) = delete;
+  ~shared_state()
+  {
+    if(_destroy != nullptr)
+    {
+      _destroy(_storage);
+    }
+  }
+};
+
+/*! The writing end of a `shared_state`, which completes it exactly once.
+
+If destroyed without having completed the state, the state is completed with
+`std::errc::operation_canceled` if `E` can be constructed from a `std::error_code`, else the
+program is terminated.
+*/
+template <class T, class E = std::error_code> class promise
+{
+public:
+  //! The type of result carried.
+  using result_type = result<T, E>;
+  //! The type of shared state used.
+  using state_type = shared_state<T, E>;
+
+private:
+  state_type *_state{nullptr};
+  bool _future_retrieved{false};
+
+  template <class U = E, typename std::enable_if<std::is_constructible<U, std::error_code>::value, bool>::type = true> void _abandon() noexcept
+  {
+    set_result(result_type(in_place_type<E>, std::make_error_code(std::errc::operation_canceled)));
+  }
+  template <class U = E, typename std::enable_if<!std::is_constructible<U, std::error_code>::value, bool>::type = true> void _abandon() noexcept { std::terminate(); }
+
+public:
+  //! Constructs a promise not associated with any state.
+  promise() = default;
+  //! Constructs a promise completing `state`, which must not have been used before.
+  explicit promise(state_type &state) noexcept
+      : _state(&state)
+  {
+    _state->_retain();
+  }
+  promise(const promise &) = delete;
+  promise(promise &&o) noexcept
+      : _state(o._state)
+      , _future_retrieved(o._future_retrieved)
+  {
+    o._state = nullptr;
+  }
+  promise &operator=(const promise &) = delete;
+  promise &operator=(promise &&o) noexcept
+  {
+    if(this != &o)
+    {
+      this->~promise();
+      new(this) promise(static_cast<promise &&>(o));
+    }
+    return *this;
+  }
+  ~promise()
+  {
+    if(_state != nullptr)
+    {
+      if(!_state->_result.is_ready())
+      {
+        _abandon();
+      }
+      _state->_unretain();
+      _state = nullptr;
+    }
+  }
+
+  //! True if this promise is associated with a state.
+  bool valid() const noexcept { return _state != nullptr; }
+  /*! Returns the future reading the state of this promise.
+  \requires This promise to be valid, and no future to have been retrieved from it before.
+  */
+  future<T, E> get_future() noexcept
+  {
+    assert(_state != nullptr && !_future_retrieved);
+    _future_retrieved = true;
+    return future<T, E>(*_state);
+  }
+  /*! Constructs the result in place from `args`, then completes the state, running any
+  continuation on this thread.
+  \returns False if the state was already completed.
+  */
+  template <class... Args> bool set_result(Args &&... args) noexcept(std::is_nothrow_constructible<result_type, Args...>::value)
+  {
+    if(!_state->_result.emplace(std::forward<Args>(args)...))
+    {
+      return false;
+    }
+    _state->_complete();
+    return true;
+  }
+  //! \group set_result
+  template <class... Args> bool set_value(Args &&... args) { return set_result(in_place_type<typename result_type::value_type>, std::forward<Args>(args)...); }
+  //! \group set_result
+  template <class... Args> bool set_error(Args &&... args) { return set_result(in_place_type<typename result_type::error_type>, std::forward<Args>(args)...); }
+};
+
+//! The reading end of a `shared_state`.
+template <class T, class E = std::error_code> class future
+{
+  friend class promise<T, E>;
+
+public:
+  //! The type of result carried.
+  using result_type = result<T, E>;
+  //! The type of shared state used.
+  using state_type = shared_state<T, E>;
+
+private:
+  state_type *_state{nullptr};
+
+  explicit future(state_type &state) noexcept
+      : _state(&state)
+  {
+    _state->_retain();
+  }
+
+public:
+  //! Constructs a future not associated with any state.
+  future() = default;
+  future(const future &) = delete;
+  future(future &&o) noexcept
+      : _state(o._state)
+  {
+    o._state = nullptr;
+  }
+  future &operator=(const future &) = delete;
+  future &operator=(future &&o) noexcept
+  {
+    if(this != &o)
+    {
+      this->~future();
+      new(this) future(static_cast<future &&>(o));
+    }
+    return *this;
+  }
+  ~future()
+  {
+    if(_state != nullptr)
+    {
+      _state->_unretain();
+      _state = nullptr;
+    }
+  }
+
+  //! True if this future is associated with a state.
+  bool valid() const noexcept { return _state != nullptr; }
+  //! True if the state has been completed.
+  bool is_ready() const noexcept { return _state->_result.is_ready(); }
+  //! Returns the result, or null if the state has not been completed yet.
+  const result_type *try_get() const noexcept { return _state->_result.try_get(); }
+  //! Blocks until the state has been completed, then returns the result.
+  const result_type &wait() const noexcept { return _state->_result.wait(); }
+
+  /*! Attaches a continuation called with the result on completion. If the state has already been
+  completed, `f` is called now on this thread, otherwise by the thread completing the state.
+  \requires This future to be valid, no continuation to have been attached before, and `F` to fit
+  into `state_type::continuation_capacity` bytes.
+  */
+  template <class F> void then(F &&f) noexcept
+  {
+    using callable_type = std::decay_t<F>;
+    static_assert(sizeof(callable_type) <= state_type::continuation_capacity && alignof(callable_type) <= alignof(std::max_align_t), "The continuation is too large, capture by pointer instead");
+    static_assert(std::is_nothrow_constructible<callable_type, F>::value, "The continuation must be nothrow constructible");
+    assert(_state->_invoke == nullptr);
+    new(_state->_storage) callable_type(std::forward<F>(f));  // NOLINT
+    _state->_invoke = [](void *p, const result_type &r) { (*static_cast<callable_type *>(p))(r); };
+    _state->_destroy = [](void *p) { static_cast<callable_type *>(p)->~callable_type(); };
+    if(_state->_continuation.exchange(state_type::_continuation_attached, std::memory_order_acq_rel) == state_type::_continuation_completed)
+    {
+      _state->_run_continuation();
+    }
+  }
+};
+
+/*! A fixed pool of `N` shared states, which returns each to the pool once both its promise and its
+future are destroyed. Acquiring and releasing are lock free, and the pool never allocates.
+
+The pool must outlive all the promises and futures made from it.
+*/
+template <class T, class E = std::error_code, size_t N = 64> class shared_state_pool
+{
+public:
+  //! The type of shared state pooled.
+  using state_type = shared_state<T, E>;
+
+private:
+  static_assert(N < 0xffffffffU, "Pool is too large");
+  static constexpr uint32_t _end = 0xffffffffU;
+
+  union slot {
+    detail::empty_type _empty;
+    state_type _state;
+    slot() noexcept
+        : _empty{}
+    {
+    }
+    ~slot() {}  // NOLINT
+  };
+  slot _slots[N];
+  std::atomic<uint32_t> _next[N];
+  // The index of the first free slot in the bottom half, and a generation count against ABA in the top half
+  std::atomic<uint64_t> _free;
+
+  static void _release(state_type *state, void *pool) noexcept
+  {
+    auto *self = static_cast<shared_state_pool *>(pool);
+    const auto idx = static_cast<uint32_t>(reinterpret_cast<slot *>(state) - self->_slots);  // NOLINT
+    state->~state_type();
+    uint64_t head = self->_free.load(std::memory_order_relaxed);
+    do
+    {
+      self->_next[idx].store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+    } while(!self->_free.compare_exchange_weak(head, ((head >> 32U) + 1) << 32U | idx, std::memory_order_release, std::memory_order_relaxed));
+  }
+
+public:
+  //! Constructs a pool with all states free.
+  shared_state_pool() noexcept
+  {
+    for(size_t n = 0; n < N; n++)
+    {
+      _next[n].store((n + 1 < N) ? static_cast<uint32_t>(n + 1) : _end, std::memory_order_relaxed);
+    }
+    _free.store(0, std::memory_order_relaxed);
+  }
+  shared_state_pool(const shared_state_pool &) = delete;
+  shared_state_pool(shared_state_pool &&) = delete;
+  shared_state_pool &operator=(const shared_state_pool &) = delete;
+  shared_state_pool &operator=(shared_state_pool &&) = delete;
+
+  //! Returns a promise using a state from the pool, which is not valid if the pool is exhausted.
+  promise<T, E> make_promise() noexcept
+  {
+    uint64_t head = _free.load(std::memory_order_acquire);
+    uint32_t idx;
+    do
+    {
+      idx = static_cast<uint32_t>(head);
+      if(idx == _end)
+      {
+        return {};
+      }
+    } while(!_free.compare_exchange_weak(head, ((head >> 32U) + 1) << 32U | _next[idx].load(std::memory_order_relaxed), std::memory_order_acquire, std::memory_order_acquire));
+    auto *state = new(&_slots[idx]._state) state_type;  // NOLINT
+    state->_release = &_release;
+    state->_pool = this;
+    return promise<T, E>(*state);
+  }
+};
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,155 @@
+/* std::hash support for result and outcome
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_HASH_HPP
+#define OUTCOME_HASH_HPP
+
+#include "category_registry.hpp"
+#include "outcome.hpp"
+
+#include <functional>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  // The finaliser of splitmix64, which spreads every input bit over every output bit
+  constexpr inline uint64_t hash_mix(uint64_t x) noexcept
+  {
+    x ^= x >> 30U;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27U;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31U;
+    return x;
+  }
+  constexpr inline uint64_t hash_combine(uint64_t h, uint64_t v) noexcept { return hash_mix(h ^ (v + 0x9e3779b97f4a7c15ULL)); }
+
+  template <class T, class = void> struct is_std_hashable : std::false_type
+  {
+  };
+  template <class T> struct is_std_hashable<T, fallback_void_t<decltype(std::hash<T>()(std::declval<const T &>()))>> : std::is_default_constructible<std::hash<T>>
+  {
+  };
+  // True if `hash_of()` can hash a T, void being hashed as nothing
+  template <class T> struct is_outcome_hashable : std::integral_constant<bool, std::is_void<T>::value || is_std_hashable<T>::value>
+  {
+  };
+  template <> struct is_outcome_hashable<std::error_code> : std::true_type
+  {
+  };
+
+  template <class T> inline uint64_t hash_of(const T &v) noexcept(noexcept(std::hash<T>()(v))) { return std::hash<T>()(v); }
+  // Error codes hash by value and stable category id, so hashes agree between processes registering categories alike
+  inline uint64_t hash_of(const std::error_code &ec) noexcept
+  {
+    uint64_t category = 0;
+#ifdef __cpp_exceptions
+    try
+#endif
+    {
+      category = error_category_id(ec.category());
+    }
+#ifdef __cpp_exceptions
+    catch(...)
+    {
+    }
+#endif
+    if(category == 0)
+    {
+      // The registry is full, so only the address is left
+      category = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(&ec.category()));
+    }
+    return (category << 32U) ^ static_cast<uint32_t>(ec.value());
+  }
+
+  // The hash of the alternatives present in `r`, of which those void or without a hash count as nothing
+  template <class Result> inline uint64_t hash_value_of(const Result &r, std::true_type /*hashable*/) { return hash_of(r.assume_value()); }
+  template <class Result> constexpr inline uint64_t hash_value_of(const Result & /*unused*/, std::false_type /*hashable*/) noexcept { return 0; }
+  template <class Result> inline uint64_t hash_error_of(const Result &r, std::true_type /*hashable*/) { return hash_of(r.assume_error()); }
+  template <class Result> constexpr inline uint64_t hash_error_of(const Result & /*unused*/, std::false_type /*hashable*/) noexcept { return 0; }
+  template <class Result> inline uint64_t hash_exception_of(const Result &r, std::true_type /*hashable*/) { return hash_of(r.assume_exception()); }
+  template <class Result> constexpr inline uint64_t hash_exception_of(const Result & /*unused*/, std::false_type /*hashable*/) noexcept { return 0; }
+
+  template <class Result, class R, class S, class P> inline size_t hash_result(const Result &r)
+  {
+    const uint8_t status = static_cast<uint8_t>(r.status());
+    uint64_t h = hash_mix(status);
+    if((status & static_cast<uint8_t>(result_status::value)) != 0)
+    {
+      h = hash_combine(h, hash_value_of(r, std::integral_constant<bool, !std::is_void<R>::value && is_outcome_hashable<R>::value>()));
+    }
+    if((status & static_cast<uint8_t>(result_status::error)) != 0)
+    {
+      h = hash_combine(h, hash_error_of(r, std::integral_constant<bool, !std::is_void<S>::value && is_outcome_hashable<S>::value>()));
+    }
+    if((status & static_cast<uint8_t>(result_status::exception)) != 0)
+    {
+      h = hash_combine(h, hash_exception_of(r, std::integral_constant<bool, !std::is_void<P>::value && is_std_hashable<P>::value>()));
+    }
+    return static_cast<size_t>(h);
+  }
+
+  // The std::hash of a result is disabled, as the standard's are, unless its value and error can be hashed
+  template <class Result, bool Enabled> struct result_hash
+  {
+    result_hash() = delete;
+    result_hash(const result_hash &) = delete;
+    result_hash &operator=(const result_hash &) = delete;
+  };
+  template <class R, class S, class NoValuePolicy> struct result_hash<result<R, S, NoValuePolicy>, true>
+  {
+    size_t operator()(const result<R, S, NoValuePolicy> &r) const { return hash_result<result<R, S, NoValuePolicy>, R, S, void>(r); }
+  };
+  template <class R, class S, class P, class NoValuePolicy> struct result_hash<outcome<R, S, P, NoValuePolicy>, true>
+  {
+    size_t operator()(const outcome<R, S, P, NoValuePolicy> &o) const { return hash_result<outcome<R, S, P, NoValuePolicy>, R, S, P>(o); }
+  };
+}  // namespace detail
+
+OUTCOME_V2_NAMESPACE_END
+
+namespace std
+{
+  /*! Hashes a `result` by its status and whichever of its value and error it has, for use as the
+  key of unordered containers. Error codes hash by their stable category id, see `error_category_id()`,
+  rather than by the address of their category. Disabled unless the value and error types are `void`,
+  `std::error_code` or have a `std::hash`.
+  */
+  template <class R, class S, class NoValuePolicy>
+  struct hash<OUTCOME_V2_NAMESPACE::result<R, S, NoValuePolicy>>
+      : OUTCOME_V2_NAMESPACE::detail::result_hash<OUTCOME_V2_NAMESPACE::result<R, S, NoValuePolicy>, OUTCOME_V2_NAMESPACE::detail::is_outcome_hashable<R>::value && OUTCOME_V2_NAMESPACE::detail::is_outcome_hashable<S>::value>
+  {
+  };
+  /*! Hashes an `outcome` as `std::hash<result>` does, also hashing its exception if the exception
+  type has a `std::hash`. A `std::exception_ptr` has none, so only the presence of one is hashed.
+  */
+  template <class R, class S, class P, class NoValuePolicy>
+  struct hash<OUTCOME_V2_NAMESPACE::outcome<R, S, P, NoValuePolicy>>
+      : OUTCOME_V2_NAMESPACE::detail::result_hash<OUTCOME_V2_NAMESPACE::outcome<R, S, P, NoValuePolicy>, OUTCOME_V2_NAMESPACE::detail::is_outcome_hashable<R>::value && OUTCOME_V2_NAMESPACE::detail::is_outcome_hashable<S>::value>
+  {
+  };
+}  // namespace std
+
+#endif
@@ -0,0 +1,145 @@
+/* Sampling of hook invocations
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_HOOK_SAMPLER_HPP
+#define OUTCOME_HOOK_SAMPLER_HPP
+
+#include "result.hpp"
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+//! The kinds of event which `hook_sampler` keeps separate rates for.
+enum class sample_event
+{
+  failure,   //!< An errored result was constructed.
+  success,   //!< A valued result was constructed.
+  copy_move  //!< A result was copy or move constructed from a compatible result.
+};
+
+//! One in how many of each kind of event is sampled. Zero means never.
+struct sample_rates
+{
+  uint32_t failure{1};
+  uint32_t success{0};
+  uint32_t copy_move{0};
+};
+
+/*! Decides which hook invocations are worth acting upon, so that expensive telemetry hung off
+the `result` hooks costs only a decrement and a branch on most events. Each thread has its own
+countdown per kind of event and its own rates, so there are no atomics or locks, and rates
+must be set on each thread which should not use the defaults.
+
+Typical use is from hooks found by ADL:
+
+```c++
+template <class T, class U> inline void hook_result_construction(result<T> *res, U &&) noexcept
+{
+  hook_sampler<>::sample_construction(res, [](auto *r) { record(*r); });
+}
+template <class T, class U> inline void hook_result_copy_construction(result<T> *res, U &&) noexcept
+{
+  hook_sampler<>::sample_copy_move(res, [](auto *r) { record(*r); });
+}
+```
+
+\tparam Tag Distinguishes independent samplers, each having its own rates and countdowns.
+*/
+template <class Tag = void> class hook_sampler
+{
+  sample_rates _rates;
+  uint32_t _countdown[3];
+
+  uint32_t _rate(sample_event e) const noexcept
+  {
+    switch(e)
+    {
+    case sample_event::failure:
+      return _rates.failure;
+    case sample_event::success:
+      return _rates.success;
+    case sample_event::copy_move:
+      return _rates.copy_move;
+    }
+    return 0;
+  }
+
+public:
+  //! Constructs a sampler with the default rates, which samples every failure and nothing else.
+  hook_sampler() noexcept { set_rates(sample_rates{}); }
+
+  //! The sampler of the calling thread.
+  static hook_sampler &this_thread() noexcept
+  {
+    static thread_local hook_sampler v;
+    return v;
+  }
+
+  //! The rates in use.
+  sample_rates rates() const noexcept { return _rates; }
+  //! Replaces the rates, restarting every countdown.
+  void set_rates(sample_rates rates) noexcept
+  {
+    _rates = rates;
+    for(size_t n = 0; n < 3; n++)
+    {
+      _countdown[n] = _rate(static_cast<sample_event>(n));
+    }
+  }
+
+  //! Counts an event of kind `e`. \returns True if it is one to be sampled.
+  bool sample(sample_event e) noexcept
+  {
+    uint32_t &countdown = _countdown[static_cast<size_t>(e)];
+    if(countdown == 0 || --countdown != 0)
+    {
+      return false;
+    }
+    countdown = _rate(e);
+    return true;
+  }
+
+  /*! Counts the construction of `r` on the calling thread as a failure or a success,
+  calling `f(r)` if it is sampled.
+  */
+  template <class Result, class F> static void sample_construction(Result *r, F &&f) noexcept(noexcept(f(r)))
+  {
+    if(this_thread().sample(r->has_error() ? sample_event::failure : sample_event::success))
+    {
+      f(r);
+    }
+  }
+  //! Counts the copy or move construction of `r` on the calling thread, calling `f(r)` if it is sampled.
+  template <class Result, class F> static void sample_copy_move(Result *r, F &&f) noexcept(noexcept(f(r)))
+  {
+    if(this_thread().sample(sample_event::copy_move))
+    {
+      f(r);
+    }
+  }
+};
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
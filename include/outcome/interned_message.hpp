@@ -0,0 +1,158 @@
+/* Process wide interning of the messages of error codes
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_INTERNED_MESSAGE_HPP
+#define OUTCOME_INTERNED_MESSAGE_HPP
+
+#include "config.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <system_error>
+
+#if defined(__has_include)
+#if __has_include(<version>)
+#include <version>
+#endif
+#endif
+#ifdef __cpp_lib_string_view
+#include <string_view>
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+//! A view of the interned message of an error code, see `interned_message()`.
+class interned_text
+{
+  const char *_data{""};
+  size_t _size{0};
+
+public:
+  constexpr interned_text() noexcept {}  // NOLINT
+  constexpr interned_text(const char *data, size_t size) noexcept
+      : _data(data)
+      , _size(size)
+  {
+  }
+  //! The text, which is always zero terminated.
+  constexpr const char *data() const noexcept { return _data; }
+  constexpr size_t size() const noexcept { return _size; }
+  constexpr bool empty() const noexcept { return _size == 0; }
+  //! A copy of the text, which allocates.
+  std::string str() const { return std::string(_data, _size); }
+#ifdef __cpp_lib_string_view
+  constexpr operator std::string_view() const noexcept { return {_data, _size}; }  // NOLINT
+#endif
+  friend bool operator==(const interned_text &a, const char *b) noexcept { return a._size == strlen(b) && memcmp(a._data, b, a._size) == 0; }
+  friend bool operator!=(const interned_text &a, const char *b) noexcept { return !(a == b); }
+  friend std::ostream &operator<<(std::ostream &s, const interned_text &v) { return s.write(v._data, static_cast<std::streamsize>(v._size)); }
+};
+
+namespace detail
+{
+  struct interned_message_node
+  {
+    const std::error_category *category;
+    int value;
+    size_t size;
+    char text[1];
+  };
+  static constexpr size_t interned_message_slots = 1024;
+  // How far a lookup probes before giving up, so a full table costs a bounded search
+  static constexpr size_t interned_message_probes = 32;
+  inline std::atomic<interned_message_node *> *interned_message_table() noexcept
+  {
+    static std::atomic<interned_message_node *> table[interned_message_slots];
+    return table;
+  }
+  inline interned_message_node *make_interned_message_node(const std::error_category &category, int value, const std::string &message) noexcept
+  {
+    auto *node = static_cast<interned_message_node *>(malloc(sizeof(interned_message_node) + message.size()));  // NOLINT
+    if(node != nullptr)
+    {
+      node->category = &category;
+      node->value = value;
+      node->size = message.size();
+      memcpy(node->text, message.data(), message.size());
+      node->text[message.size()] = 0;
+    }
+    return node;
+  }
+}  // namespace detail
+
+/*! The message of code `value` of `category`, interned into a process wide table on first use, so
+later calls for the same code return the same text without allocating, locking nor calling the
+category. Publication is lock free: threads racing to intern the same code each fetch the
+message, and all but the first to publish discard theirs.
+
+The table holds 1024 messages, which are never freed. Categories must not change their messages,
+as some do with the locale, nor be destroyed whilst the process runs. If a message cannot be
+interned because the table is full around its slot, or allocation fails, it is returned from a
+thread local buffer instead, valid until the calling thread's next such failure.
+*/
+inline interned_text interned_message(const std::error_category &category, int value)
+{
+  auto *table = detail::interned_message_table();
+  const auto hash = (reinterpret_cast<uintptr_t>(&category) >> 4U) ^ static_cast<uintptr_t>(static_cast<unsigned>(value) * 2654435761U);  // NOLINT
+  detail::interned_message_node *mine = nullptr;
+  for(size_t probe = 0; probe < detail::interned_message_probes; probe++)
+  {
+    std::atomic<detail::interned_message_node *> &slot = table[(hash + probe) % detail::interned_message_slots];
+    detail::interned_message_node *node = slot.load(std::memory_order_acquire);
+    if(node == nullptr)
+    {
+      if(mine == nullptr)
+      {
+        mine = detail::make_interned_message_node(category, value, category.message(value));
+        if(mine == nullptr)
+        {
+          break;
+        }
+      }
+      if(slot.compare_exchange_strong(node, mine, std::memory_order_acq_rel, std::memory_order_acquire))
+      {
+        return {mine->text, mine->size};
+      }
+      // node is now whoever published first
+    }
+    if(node->category == &category && node->value == value)
+    {
+      free(mine);  // NOLINT
+      return {node->text, node->size};
+    }
+  }
+  free(mine);  // NOLINT
+  static thread_local std::string fallback;
+  fallback = category.message(value);
+  return {fallback.c_str(), fallback.size()};
+}
+//! \overload
+inline interned_text interned_message(const std::error_code &ec) { return interned_message(ec.category(), ec.value()); }
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
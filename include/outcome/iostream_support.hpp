@@ -25,6 +25,7 @@ http://www.boost.org/LICENSE_1_0.txt)
 #ifndef OUTCOME_IOSTREAM_SUPPORT_HPP
 #define OUTCOME_IOSTREAM_SUPPORT_HPP
 
+#include "interned_message.hpp"
 #include "outcome.hpp"
 
 #include <iostream>
@@ -36,33 +37,74 @@ namespace detail
 {
   template <class T> typename std::add_lvalue_reference<T>::type lvalueref() noexcept;
 
-  template <class T> inline std::ostream &operator<<(std::ostream &s, const value_storage_trivial<T> &v)
+  template <class T, class S> inline std::ostream &operator<<(std::ostream &s, const value_storage_trivial<T, S> &v)
   {
-    s << v._status << " ";
+    s << static_cast<uint32_t>(v._status) << " ";
     if((v._status & status_have_value) != 0)
     {
       s << v._value;  // NOLINT
     }
     return s;
   }
-  inline std::ostream &operator<<(std::ostream &s, const value_storage_trivial<void> &v)
+  template <class S> inline std::ostream &operator<<(std::ostream &s, const value_storage_trivial<void, S> &v)
   {
-    s << v._status << " ";
+    s << static_cast<uint32_t>(v._status) << " ";
     return s;
   }
-  template <class T> inline std::ostream &operator<<(std::ostream &s, const value_storage_nontrivial<T> &v)
+  template <class T, class S> inline std::ostream &operator<<(std::ostream &s, const value_storage_nontrivial<T, S> &v)
   {
-    s << v._status << " ";
+    s << static_cast<uint32_t>(v._status) << " ";
     if((v._status & status_have_value) != 0)
     {
       s << v._value;  // NOLINT
     }
     return s;
   }
-  template <class T> inline std::istream &operator>>(std::istream &s, value_storage_trivial<T> &v)
+  template <class T, class N> inline std::ostream &operator<<(std::ostream &s, const value_storage_niche<T, N> &v)
   {
-    v = value_storage_trivial<T>();
-    s >> v._status;
+    s << static_cast<uint32_t>(v.status()) << " ";
+    if((v.status() & status_have_value) != 0)
+    {
+      s << v._value;  // NOLINT
+    }
+    return s;
+  }
+  template <class T, class E> inline std::ostream &operator<<(std::ostream &s, const value_storage_disjoint<T, E> &v)
+  {
+    s << static_cast<uint32_t>(v._status) << " ";
+    if((v._status & status_have_value) != 0)
+    {
+      s << v._value;  // NOLINT
+    }
+    return s;
+  }
+  template <class T, class S> inline std::istream &operator>>(std::istream &s, value_storage_trivial<T, S> &v)
+  {
+    v = value_storage_trivial<T, S>();
+    uint32_t status = 0;
+    s >> status;
+    v._status = static_cast<S>(status);
+    if((v._status & status_have_value) != 0)
+    {
+      new(&v._value) decltype(v._value)();  // NOLINT
+      s >> v._value;                        // NOLINT
+    }
+    return s;
+  }
+  template <class S> inline std::istream &operator>>(std::istream &s, value_storage_trivial<void, S> &v)
+  {
+    v = value_storage_trivial<void, S>();
+    uint32_t status = 0;
+    s >> status;
+    v._status = static_cast<S>(status);
+    return s;
+  }
+  template <class T, class S> inline std::istream &operator>>(std::istream &s, value_storage_nontrivial<T, S> &v)
+  {
+    v = value_storage_nontrivial<T, S>();
+    uint32_t status = 0;
+    s >> status;
+    v._status = static_cast<S>(status);
     if((v._status & status_have_value) != 0)
     {
       new(&v._value) decltype(v._value)();  // NOLINT
@@ -70,29 +112,55 @@ namespace detail
     }
     return s;
   }
-  inline std::istream &operator>>(std::istream &s, value_storage_trivial<devoid<void>> &v)
+  template <class T, class N> inline std::istream &operator>>(std::istream &s, value_storage_niche<T, N> &v)
   {
-    v = value_storage_trivial<devoid<void>>();
-    s >> v._status;
+    uint32_t status = 0;
+    s >> status;
+    if((status & status_have_value) != 0)
+    {
+      s >> v._value;  // NOLINT
+    }
+    else
+    {
+      v.set_status(status);
+    }
     return s;
   }
-  template <class T> inline std::istream &operator>>(std::istream &s, value_storage_nontrivial<T> &v)
+  template <class T, class E> inline std::istream &operator>>(std::istream &s, value_storage_disjoint<T, E> &v)
   {
-    v = value_storage_nontrivial<T>();
-    s >> v._status;
+    v = value_storage_disjoint<T, E>();
+    uint32_t status = 0;
+    s >> status;
+    v._status = static_cast<status_bitfield_type>(status);
     if((v._status & status_have_value) != 0)
     {
       new(&v._value) decltype(v._value)();  // NOLINT
       s >> v._value;                        // NOLINT
     }
+    else if((v._status & status_have_error) != 0)
+    {
+      new(&v._error) decltype(v._error)();  // NOLINT
+    }
     return s;
   }
   OUTCOME_TEMPLATE(class T)
   OUTCOME_TREQUIRES(OUTCOME_TPRED(!std::is_constructible<std::error_code, T>::value))
-  inline std::string safe_message(T && /*unused*/) { return {}; }
-  inline std::string safe_message(const std::error_code &ec) { return " (" + ec.message() + ")"; }
+  inline void print_message(std::ostream & /*unused*/, T && /*unused*/) {}
+  // Interned, so printing does not allocate a string per error
+  inline void print_message(std::ostream &s, const std::error_code &ec) { s << " (" << interned_message(ec) << ")"; }
 }  // namespace detail
 
+namespace hooks
+{
+  /*! The default hook implementation called by `print()` after printing the error of a `result`, or
+  the result part of an `outcome`. Does nothing. Overload it to append extended error information,
+  such as the backtrace recorded by `capture_backtrace()` (see `print_backtrace()`).
+  \param 1 The stream being printed into.
+  \param 2 The errored `result<...>` being printed.
+  */
+  template <class T> inline void hook_result_print(std::ostream & /*unused*/, const T * /*unused*/) {}
+}  // namespace hooks
+
 /*! Deserialise a result. Format is `status_unsigned [value][error]`. Spare storage is preserved.
 \tparam 3
 \exclude
@@ -133,7 +201,8 @@ inline std::ostream &operator<<(std::ostream &s, const result<R, S, P> &v)
   return s;
 }
 /*! Debug print a result into a form suitable for human reading. Format is `value|error`. If the
-error type is `error_code`, appends `" (ec.message())"` afterwards.
+error type is `error_code`, appends `" (ec.message())"` afterwards, the message interned by
+`interned_message()`, followed by anything written by `hooks::hook_result_print()`.
 */
 template <class R, class S, class P> inline std::string print(const detail::result_final<R, S, P> &v)
 {
@@ -144,12 +213,16 @@ template <class R, class S, class P> inline std::string print(const detail::resu
   }
   if(v.has_error())
   {
-    s << v.error() << detail::safe_message(v.error());
+    s << v.error();
+    detail::print_message(s, v.error());
+    using namespace hooks;
+    hook_result_print(s, &v);
   }
   return s.str();
 }
 /*! Debug print a result into a form suitable for human reading. Format is `(+void)|error`. If the
-error type is `error_code`, appends `" (ec.message())"` afterwards.
+error type is `error_code`, appends `" (ec.message())"` afterwards, the message interned by
+`interned_message()`, followed by anything written by `hooks::hook_result_print()`.
 */
 template <class S, class P> inline std::string print(const detail::result_final<void, S, P> &v)
 {
@@ -160,7 +233,10 @@ template <class S, class P> inline std::string print(const detail::result_final<
   }
   if(v.has_error())
   {
-    s << v.error() << detail::safe_message(v.error());
+    s << v.error();
+    detail::print_message(s, v.error());
+    using namespace hooks;
+    hook_result_print(s, &v);
   }
   return s.str();
 }
@@ -176,6 +252,8 @@ template <class R, class P> inline std::string print(const detail::result_final<
   if(v.has_error())
   {
     s << "(-void)";
+    using namespace hooks;
+    hook_result_print(s, &v);
   }
   return s.str();
 }
@@ -191,6 +269,8 @@ template <class P> inline std::string print(const detail::result_final<void, voi
   if(v.has_error())
   {
     s << "(-void)";
+    using namespace hooks;
+    hook_result_print(s, &v);
   }
   return s.str();
 }
@@ -0,0 +1,217 @@
+/* A result computed once on first use, shared by many threads
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_LAZY_RESULT_HPP
+#define OUTCOME_LAZY_RESULT_HPP
+
+#include "result.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+//! What a `lazy_result` does with a failure returned by its factory.
+enum class lazy_result_failure
+{
+  keep,      //!< The failure is kept, and returned to every caller as a success would be.
+  recompute  //!< The failure is returned only to the callers which saw it computed, and the next call computes again.
+};
+
+namespace detail
+{
+  template <class T> struct lazy_result_reference
+  {
+    using type = const T &;
+  };
+  template <> struct lazy_result_reference<void>
+  {
+    using type = void;
+  };
+}  // namespace detail
+
+/*! A `result<T, E>` computed by a factory on first use, then shared by any number of threads,
+without a lock or a separate once flag, in place of `std::call_once` and a `result` member.
+
+A single atomic state word is both the once flag and a copy of whether the result is valued. The
+first caller of `get()` claims the word and runs the factory, constructing the result in place
+inside the cell and publishing it with one release store. Callers arriving meanwhile spin briefly,
+then block on the word, which is a futex wait on C++ 20 and a yielding loop before. Every call
+after publication costs one acquire load.
+
+With `lazy_result_failure::recompute`, a failure is not kept: the callers waiting on the
+computation which failed each go on to compute in turn, and later callers compute again, until one
+computation succeeds. If the factory throws, the cell is left as it was before the call, and the
+exception propagates to the caller which ran it.
+
+`get()` returns a `result` of a reference to the value inside the cell, which stays valid for the
+lifetime of the cell, or a copy of the error.
+*/
+template <class T, class E = std::error_code> class lazy_result
+{
+public:
+  //! The type of result computed.
+  using result_type = result<T, E>;
+  //! The value type of the result.
+  using value_type = typename result_type::value_type;
+  //! The error type of the result.
+  using error_type = typename result_type::error_type;
+  //! The type of the factory computing the result.
+  using factory_type = std::function<result_type()>;
+  //! The type returned by `get()`, referring to the value inside the cell.
+  using view_type = result<typename detail::lazy_result_reference<T>::type, E>;
+
+private:
+  static constexpr uint32_t _state_empty = 0;
+  static constexpr uint32_t _state_computing = 1U << 0U;
+  static constexpr uint32_t _state_ready = 1U << 1U;
+  static constexpr uint32_t _state_have_value = 1U << 2U;
+  // How many times a caller polls the state before blocking on it
+  static constexpr unsigned _spin_count = 64;
+
+  std::atomic<uint32_t> _state{_state_empty};
+  lazy_result_failure _failures;
+  factory_type _factory;
+  union {
+    detail::empty_type _empty;
+    result_type _value;
+  };
+
+  void _notify() noexcept
+  {
+#if defined(__cpp_lib_atomic_wait) && __cpp_lib_atomic_wait >= 201907L
+    _state.notify_all();
+#endif
+  }
+  view_type _view(std::false_type /*is void*/) const { return _value.has_value() ? view_type(in_place_type<typename view_type::value_type_if_enabled>, _value.assume_value()) : view_type(in_place_type<error_type>, _value.assume_error()); }
+  view_type _view(std::true_type /*is void*/) const { return _value.has_value() ? view_type(in_place_type<void>) : view_type(in_place_type<error_type>, _value.assume_error()); }
+  view_type _view() const { return _view(std::is_void<T>()); }
+
+  // Runs the factory, the state having been claimed by this caller
+  view_type _compute()
+  {
+    // If the factory throws, the cell is left empty for another caller
+    struct guard_t
+    {
+      lazy_result *self;
+      bool armed;
+      ~guard_t()
+      {
+        if(armed)
+        {
+          self->_state.store(_state_empty, std::memory_order_relaxed);
+          self->_notify();
+        }
+      }
+    } g{this, true};
+    new(&_value) result_type(_factory());  // NOLINT
+    g.armed = false;
+    if(!_value.has_value() && _failures == lazy_result_failure::recompute)
+    {
+      view_type ret(in_place_type<error_type>, std::move(_value).assume_error());
+      _value.~result_type();
+      _state.store(_state_empty, std::memory_order_release);
+      _notify();
+      return ret;
+    }
+    _state.store(_state_ready | (_value.has_value() ? _state_have_value : 0U), std::memory_order_release);
+    _notify();
+    return _view();
+  }
+  OUTCOME_COLD view_type _get_slow()
+  {
+    for(unsigned n = 0;; n++)
+    {
+      uint32_t state = _state.load(std::memory_order_acquire);
+      if((state & _state_ready) != 0)
+      {
+        return _view();
+      }
+      if(state == _state_empty)
+      {
+        if(_state.compare_exchange_strong(state, _state_computing, std::memory_order_acquire, std::memory_order_acquire))
+        {
+          return _compute();
+        }
+        continue;
+      }
+      if(n < _spin_count)
+      {
+        continue;
+      }
+#if defined(__cpp_lib_atomic_wait) && __cpp_lib_atomic_wait >= 201907L
+      _state.wait(state, std::memory_order_acquire);
+#else
+      std::this_thread::yield();
+#endif
+    }
+  }
+
+public:
+  //! Constructs a cell whose result `factory` computes on first use.
+  explicit lazy_result(factory_type factory, lazy_result_failure failures = lazy_result_failure::keep)
+      : _failures(failures)
+      , _factory(std::move(factory))
+      , _empty{}
+  {
+  }
+  lazy_result(const lazy_result &) = delete;
+  lazy_result(lazy_result &&) = delete;
+  lazy_result &operator=(const lazy_result &) = delete;
+  lazy_result &operator=(lazy_result &&) = delete;
+  //! Destroys any computed result. No thread may be calling `get()`.
+  ~lazy_result()
+  {
+    if((_state.load(std::memory_order_acquire) & _state_ready) != 0)
+    {
+      _value.~result_type();
+    }
+  }
+
+  /*! Returns the result, computing it first if no caller has yet, or waiting for it if another
+  caller is computing it. Once computed, costs one acquire load.
+  \throws Any exception the factory throws, if this caller ran it.
+  */
+  view_type get()
+  {
+    if(OUTCOME_LIKELY((_state.load(std::memory_order_acquire) & _state_ready) != 0))
+    {
+      return _view();
+    }
+    return _get_slow();
+  }
+
+  //! True if a result has been computed and kept.
+  bool is_ready() const noexcept { return (_state.load(std::memory_order_acquire) & _state_ready) != 0; }
+  //! True if a result has been computed and kept, and it is valued.
+  bool has_value() const noexcept { return (_state.load(std::memory_order_acquire) & _state_have_value) != 0; }
+  //! Returns the kept result, or null if none has been computed yet, without computing it.
+  const result_type *try_get() const noexcept { return is_ready() ? &_value : nullptr; }
+};
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
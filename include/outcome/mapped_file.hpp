@@ -0,0 +1,217 @@
+/* Read only memory mapped files returned as results
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_MAPPED_FILE_HPP
+#define OUTCOME_MAPPED_FILE_HPP
+
+#include "result.hpp"
+
+#include <cerrno>
+#include <cstddef>
+#include <system_error>
+
+#if defined(__has_include)
+#if __has_include(<version>)
+#include <version>
+#endif
+#endif
+#ifdef __cpp_lib_span
+#include <span>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+//! How a `mapped_file` will be accessed, passed to the kernel as a hint with `madvise()`.
+enum class map_access
+{
+  normal,      //!< No hint.
+  sequential,  //!< From start to end, so read ahead aggressively and drop pages soon after use.
+  random       //!< In no particular order, so do not read ahead.
+};
+
+namespace detail
+{
+#ifdef __cpp_lib_byte
+  using mapped_byte = std::byte;
+#else
+  using mapped_byte = unsigned char;
+#endif
+}  // namespace detail
+
+/*! A read only, private mapping of the whole of a file, as made by `map_file()`, unmapped on
+destruction. The bytes may be handed straight to the decoders, for example
+`binary::decode<T>(f.bytes())`, so that loading a file copies nothing.
+
+Move only. An empty file, or a default constructed `mapped_file`, has no bytes and maps nothing.
+*/
+class mapped_file
+{
+  const detail::mapped_byte *_data{nullptr};
+  size_t _size{0};
+
+  void _unmap() noexcept
+  {
+#if defined(__unix__) || defined(__APPLE__)
+    if(_size != 0)
+    {
+      ::munmap(const_cast<detail::mapped_byte *>(_data), _size);  // NOLINT
+    }
+#endif
+    _data = nullptr;
+    _size = 0;
+  }
+
+public:
+  //! The type of each byte, `std::byte` where available, else `unsigned char`.
+  using byte_type = detail::mapped_byte;
+
+  //! Default constructs an empty mapping.
+  constexpr mapped_file() noexcept = default;
+  //! Takes ownership of the `size` bytes mapped at `data`.
+  mapped_file(const byte_type *data, size_t size) noexcept
+      : _data(data)
+      , _size(size)
+  {
+  }
+  mapped_file(const mapped_file &) = delete;
+  mapped_file &operator=(const mapped_file &) = delete;
+  //! Takes ownership of the mapping of `o`.
+  mapped_file(mapped_file &&o) noexcept
+      : _data(o._data)
+      , _size(o._size)
+  {
+    o._data = nullptr;
+    o._size = 0;
+  }
+  //! Unmaps this, then takes ownership of the mapping of `o`.
+  mapped_file &operator=(mapped_file &&o) noexcept
+  {
+    if(this != &o)
+    {
+      _unmap();
+      _data = o._data;
+      _size = o._size;
+      o._data = nullptr;
+      o._size = 0;
+    }
+    return *this;
+  }
+  //! Unmaps the file.
+  ~mapped_file() { _unmap(); }
+
+  //! The first byte of the file, or null if it is empty.
+  const byte_type *data() const noexcept { return _data; }
+  //! The size of the file in bytes.
+  size_t size() const noexcept { return _size; }
+  //! True if the file is empty.
+  bool empty() const noexcept { return _size == 0; }
+#ifdef __cpp_lib_span
+  //! The bytes of the file.
+  std::span<const byte_type> bytes() const noexcept { return {_data, _size}; }
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+  /*! Tells the kernel how the bytes will now be accessed. As a hint, it may be ignored.
+  \returns The `errno` of `madvise()` failing, flagged as such.
+  */
+  result<void> advise(map_access access) const noexcept
+  {
+    const int advice = (access == map_access::sequential) ? MADV_SEQUENTIAL : (access == map_access::random) ? MADV_RANDOM : MADV_NORMAL;
+    if(_size != 0 && -1 == ::madvise(const_cast<byte_type *>(_data), _size, advice))  // NOLINT
+    {
+      return std::error_code(errno, std::generic_category());
+    }
+    return success();
+  }
+#endif
+};
+
+#if defined(__unix__) || defined(__APPLE__)
+/*! Maps the whole of the file at `path` read only, with `access` passed to the kernel as a hint.
+If `huge_pages`, transparent huge pages are asked for too, where the platform has them, which cuts
+TLB misses over large files on filesystems which can back them; elsewhere it is ignored. The file
+is closed once mapped, as the mapping keeps its own reference.
+\returns The mapping, or the `errno` of the first call failing, in the generic category and so
+flagged `status_error_is_errno`.
+*/
+inline result<mapped_file> map_file(const char *path, map_access access = map_access::normal, bool huge_pages = false) noexcept
+{
+  int fd;
+  do
+  {
+    fd = ::open(path, O_RDONLY | O_CLOEXEC);  // NOLINT
+  } while(-1 == fd && EINTR == errno);
+  if(-1 == fd)
+  {
+    return std::error_code(errno, std::generic_category());
+  }
+  struct stat st
+  {
+  };
+  if(-1 == ::fstat(fd, &st))
+  {
+    const int code = errno;
+    ::close(fd);
+    return std::error_code(code, std::generic_category());
+  }
+  const auto bytes = static_cast<size_t>(st.st_size);
+  if(bytes == 0)
+  {
+    ::close(fd);
+    return mapped_file();
+  }
+  void *addr = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+  const int code = errno;
+  ::close(fd);
+  if(addr == MAP_FAILED)
+  {
+    return std::error_code(code, std::generic_category());
+  }
+  mapped_file ret(static_cast<const mapped_file::byte_type *>(addr), bytes);
+  if(access != map_access::normal)
+  {
+    (void) ret.advise(access);
+  }
+#ifdef MADV_HUGEPAGE
+  if(huge_pages)
+  {
+    (void) ::madvise(addr, bytes, MADV_HUGEPAGE);
+  }
+#else
+  (void) huge_pages;
+#endif
+  return ret;
+}
+#endif
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,128 @@
+/* Dispatching on the status of a result through a jump table
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_MATCH_HPP
+#define OUTCOME_MATCH_HPP
+
+#include "result.hpp"
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  // What F returns when called with T, or with nothing if T is void
+  template <class F, class T> struct match_invoke_result
+  {
+    using type = decltype(std::declval<F &>()(std::declval<T>()));
+  };
+  template <class F> struct match_invoke_result<F, void>
+  {
+    using type = decltype(std::declval<F &>()());
+  };
+  template <class R> using match_value_t = decltype(std::declval<R>().assume_value());
+  template <class F, class R> using match_result_t = typename match_invoke_result<std::remove_reference_t<F>, match_value_t<R>>::type;
+  // True if R is an outcome, which has an exception
+  template <class R, class = void> struct match_has_exception : std::false_type
+  {
+  };
+  template <class R> struct match_has_exception<R, fallback_void_t<decltype(std::declval<R>().assume_exception())>> : std::true_type
+  {
+  };
+
+  // Stands in for the exception handler of a result, which is never called
+  struct match_no_exception
+  {
+  };
+
+  // A table of handlers indexed by result_status, with only the exception handler of an outcome being called for its exception
+  template <class Ret, class R, class FV, class FE, class FX, bool Exception> struct match_table
+  {
+    using error_type = typename std::decay_t<R>::error_type;
+    struct handlers
+    {
+      FV &on_value;
+      FE &on_error;
+      FX &on_exception;
+    };
+    using entry = Ret (*)(R &&, handlers &);
+
+    static Ret _value(R &&r, handlers &h, std::true_type /*void*/)
+    {
+      static_cast<R &&>(r).assume_value();
+      return h.on_value();
+    }
+    static Ret _value(R &&r, handlers &h, std::false_type /*void*/) { return h.on_value(static_cast<R &&>(r).assume_value()); }
+    static Ret _error(R && /*unused*/, handlers &h, std::true_type /*void*/) { return h.on_error(); }
+    static Ret _error(R &&r, handlers &h, std::false_type /*void*/) { return h.on_error(static_cast<R &&>(r).assume_error()); }
+    static Ret _none(handlers &h, std::true_type /*void*/) { return h.on_error(); }
+    static Ret _none(handlers &h, std::false_type /*void*/) { return h.on_error(error_type{}); }
+    static Ret _exception(R &&r, handlers &h, std::true_type /*outcome*/) { return h.on_exception(static_cast<R &&>(r).assume_exception()); }
+    static Ret _exception(R && /*unused*/, handlers &h, std::false_type /*outcome*/) { return _none(h, std::is_void<error_type>()); }
+
+    static Ret on_value(R &&r, handlers &h) { return _value(static_cast<R &&>(r), h, std::is_void<match_value_t<R>>()); }
+    static Ret on_error(R &&r, handlers &h) { return _error(static_cast<R &&>(r), h, std::is_void<error_type>()); }
+    static Ret on_exception(R &&r, handlers &h) { return _exception(static_cast<R &&>(r), h, std::integral_constant<bool, Exception>()); }
+    static Ret on_none(R && /*unused*/, handlers &h) { return _none(h, std::is_void<error_type>()); }
+
+    static Ret dispatch(R &&r, FV &fv, FE &fe, FX &fx)
+    {
+      static constexpr entry table[result_status_count] = {&on_none, &on_value, &on_error, &on_none, &on_exception, &on_none, &on_exception, &on_none};
+      handlers h{fv, fe, fx};
+      return table[static_cast<uint8_t>(r.status())](static_cast<R &&>(r), h);
+    }
+  };
+}  // namespace detail
+
+/*! Calls `on_value` with the value of `r`, or `on_error` with its error, choosing which by
+indexing a table of the two with `r.status()` rather than by testing it bit by bit. A `void`
+value or error is passed as no argument. A result of status `result_status::none` is passed to
+`on_error` as a default constructed error.
+\returns What the handler called returns, which must be the type `on_value` returns.
+\requires `R` to be a `result`.
+*/
+OUTCOME_TEMPLATE(class R, class FV, class FE)
+OUTCOME_TREQUIRES(OUTCOME_TPRED(is_result_v<R>))
+inline detail::match_result_t<FV, R> match(R &&r, FV &&on_value, FE &&on_error)
+{
+  using table = detail::match_table<detail::match_result_t<FV, R>, R, std::remove_reference_t<FV>, std::remove_reference_t<FE>, detail::match_no_exception, false>;
+  detail::match_no_exception no_exception;
+  return table::dispatch(static_cast<R &&>(r), on_value, on_error, no_exception);
+}
+
+/*! As `match(r, on_value, on_error)`, but for an `outcome`, whose exception if it has one is
+passed to `on_exception`, even if it also has an error.
+\returns What the handler called returns, which must be the type `on_value` returns.
+\requires `R` to be an `outcome`.
+*/
+OUTCOME_TEMPLATE(class R, class FV, class FE, class FX)
+OUTCOME_TREQUIRES(OUTCOME_TPRED(detail::match_has_exception<R>::value))
+inline detail::match_result_t<FV, R> match(R &&r, FV &&on_value, FE &&on_error, FX &&on_exception)
+{
+  using table = detail::match_table<detail::match_result_t<FV, R>, R, std::remove_reference_t<FV>, std::remove_reference_t<FE>, std::remove_reference_t<FX>, true>;
+  return table::dispatch(static_cast<R &&>(r), on_value, on_error, on_exception);
+}
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,227 @@
+/* Arrays of results in memory shared between processes
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_MMAP_RESULT_ARRAY_HPP
+#define OUTCOME_MMAP_RESULT_ARRAY_HPP
+
+#include "c_result.hpp"
+
+#include <cerrno>
+#include <system_error>
+
+#if defined(__has_include)
+#if __has_include(<version>)
+#include <version>
+#endif
+#endif
+#ifdef __cpp_lib_span
+#include <span>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+//! Tag type for constructing a `mmap_result_array` which unmaps its region on destruction.
+struct adopt_mapping_t
+{
+};
+//! Tag for constructing a `mmap_result_array` which unmaps its region on destruction.
+static constexpr adopt_mapping_t adopt_mapping{};
+
+/*! An array of `result<T, E>` in a region of memory which other processes, including ones written
+in C using `CXX_DECLARE_RESULT()`, may map too, so that producer and consumer share the results
+without copying them. Either views a region the caller mapped, or owns a mapping of a file made by
+`map_result_array_file()`. Zeroed memory holds results which are neither valued nor errored.
+
+Accesses are not synchronised, so producers and consumers must agree how they take turns, for
+example with an atomic counter of the results published.
+
+\tparam T The value type.
+\tparam E The error type, which must not hold pointers, which would differ between processes. Use
+`cxx_portable_error_code` rather than `std::error_code`.
+\requires `trait::is_c_layout_compatible_v<T, E>`.
+*/
+template <class T, class E> class mmap_result_array
+{
+  static_assert(trait::is_c_layout_compatible_v<T, E>, "result<T, E> must be layout compatible with its C struct");
+  static_assert(!std::is_same<E, std::error_code>::value, "std::error_code refers to its category by pointer, which is not valid in other processes, use cxx_portable_error_code");
+
+public:
+  //! The result type.
+  using result_type = result<T, E>;
+  //! The C struct type of each result.
+  using c_type = c_result<T, E>;
+  //! The type of the items.
+  using value_type = result_type;
+  //! The size type.
+  using size_type = size_t;
+  //! The iterator type.
+  using iterator = result_type *;
+  //! The const iterator type.
+  using const_iterator = const result_type *;
+
+private:
+  result_type *_data{nullptr};
+  size_type _size{0};
+  // Bytes to unmap, zero if the region is not owned
+  size_t _mapped{0};
+
+  void _unmap() noexcept
+  {
+#if defined(__unix__) || defined(__APPLE__)
+    if(_mapped != 0)
+    {
+      ::munmap(_data, _mapped);
+    }
+#endif
+    _data = nullptr;
+    _size = 0;
+    _mapped = 0;
+  }
+
+public:
+  //! Default constructs an empty array.
+  constexpr mmap_result_array() noexcept = default;
+  /*! Views the `bytes` bytes at `region` as an array of results. The caller owns the region, and
+  must keep it mapped for as long as the array is used. Bytes after the last whole result are unused.
+  \requires `region` to be aligned to `alignof(result_type)`.
+  */
+  mmap_result_array(void *region, size_t bytes) noexcept
+      : _data(static_cast<result_type *>(region))
+      , _size(bytes / sizeof(result_type))
+  {
+  }
+  //! Views the mapping of `bytes` bytes at `region`, which is unmapped on destruction.
+  mmap_result_array(void *region, size_t bytes, adopt_mapping_t /*unused*/) noexcept
+      : _data(static_cast<result_type *>(region))
+      , _size(bytes / sizeof(result_type))
+      , _mapped(bytes)
+  {
+  }
+  mmap_result_array(const mmap_result_array &) = delete;
+  //! Move constructor, which takes over any mapping of `o`.
+  mmap_result_array(mmap_result_array &&o) noexcept
+      : _data(o._data)
+      , _size(o._size)
+      , _mapped(o._mapped)
+  {
+    o._data = nullptr;
+    o._size = 0;
+    o._mapped = 0;
+  }
+  mmap_result_array &operator=(const mmap_result_array &) = delete;
+  //! Move assignment, which unmaps any mapping owned first.
+  mmap_result_array &operator=(mmap_result_array &&o) noexcept
+  {
+    if(this != &o)
+    {
+      _unmap();
+      _data = o._data;
+      _size = o._size;
+      _mapped = o._mapped;
+      o._data = nullptr;
+      o._size = 0;
+      o._mapped = 0;
+    }
+    return *this;
+  }
+  //! Unmaps the region if it owns its mapping.
+  ~mmap_result_array() { _unmap(); }
+
+  //! The number of results.
+  size_type size() const noexcept { return _size; }
+  //! True if there are no results.
+  bool empty() const noexcept { return _size == 0; }
+  //! \group data
+  result_type *data() noexcept { return _data; }
+  //! \group data
+  const result_type *data() const noexcept { return _data; }
+  //! \group c_data
+  c_type *c_data() noexcept { return reinterpret_cast<c_type *>(_data); }  // NOLINT
+  //! \group c_data
+  const c_type *c_data() const noexcept { return reinterpret_cast<const c_type *>(_data); }  // NOLINT
+  //! \group index
+  result_type &operator[](size_type idx) noexcept { return _data[idx]; }
+  //! \group index
+  const result_type &operator[](size_type idx) const noexcept { return _data[idx]; }
+  //! \group begin
+  iterator begin() noexcept { return _data; }
+  //! \group begin
+  const_iterator begin() const noexcept { return _data; }
+  //! \group end
+  iterator end() noexcept { return _data + _size; }
+  //! \group end
+  const_iterator end() const noexcept { return _data + _size; }
+#ifdef __cpp_lib_span
+  //! \group span
+  std::span<result_type> span() noexcept { return {_data, _size}; }
+  //! \group span
+  std::span<const result_type> span() const noexcept { return {_data, _size}; }
+#endif
+};
+
+#if defined(__unix__) || defined(__APPLE__)
+/*! Maps `count` results of the file at `path` shared, creating the file if it does not exist, and
+extending it with zeroes if it is shorter than that. Other processes mapping the same file see
+the same results.
+\returns The array, or the `errno` of whichever of opening, extending or mapping the file failed.
+*/
+template <class T, class E> inline result<mmap_result_array<T, E>> map_result_array_file(const char *path, size_t count) noexcept
+{
+  const size_t bytes = count * sizeof(typename mmap_result_array<T, E>::result_type);
+  int fd = ::open(path, O_RDWR | O_CREAT, 0644);  // NOLINT
+  if(fd == -1)
+  {
+    return std::error_code(errno, std::system_category());
+  }
+  struct stat st
+  {
+  };
+  if(-1 == ::fstat(fd, &st) || (static_cast<size_t>(st.st_size) < bytes && -1 == ::ftruncate(fd, static_cast<off_t>(bytes))))
+  {
+    const int code = errno;
+    ::close(fd);
+    return std::error_code(code, std::system_category());
+  }
+  void *addr = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  const int code = errno;
+  ::close(fd);
+  if(addr == MAP_FAILED)  // NOLINT
+  {
+    return std::error_code(code, std::system_category());
+  }
+  return result<mmap_result_array<T, E>>{in_place_type<mmap_result_array<T, E>>, addr, bytes, adopt_mapping};
+}
+#endif
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,219 @@
+/* Pipeable monadic operations on result, evaluated as one fused expression
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_MONADIC_HPP
+#define OUTCOME_MONADIC_HPP
+
+#include "result.hpp"
+
+#include <tuple>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+/*! Pipeable forms of the monadic operations of `result`. `r | map(f) | and_then(g) | or_else(h)`
+builds an unevaluated chain, which is evaluated as a whole when converted to its result type, or by
+`get()`. The status of `r` is checked once, and thereafter only the status of the results which the
+`and_then()` and `or_else()` stages return, which is where the chain may start or stop failing.
+Stages which cannot change the state, such as a `map()` of a failure, are skipped without any check.
+
+A chain refers to `r` rather than copying it, so it must be evaluated within the full expression
+which built it. Assign it to a `result`, or return it, rather than to `auto`.
+*/
+namespace monadic
+{
+  //! A stage transforming any value, as `result::map()` does. Made by `map()`.
+  template <class F> struct map_stage
+  {
+    F f;
+  };
+  //! A stage replacing any value with the result of a function, as `result::and_then()` does. Made by `and_then()`.
+  template <class F> struct and_then_stage
+  {
+    F f;
+  };
+  //! A stage replacing any error with the result of a function, as `result::or_else()` does. Made by `or_else()`.
+  template <class F> struct or_else_stage
+  {
+    F f;
+  };
+
+  //! Returns a chain stage transforming any value with `f`.
+  template <class F> constexpr inline map_stage<std::decay_t<F>> map(F &&f) { return map_stage<std::decay_t<F>>{std::forward<F>(f)}; }
+  //! Returns a chain stage replacing any value with the result which `f` returns when given it.
+  template <class F> constexpr inline and_then_stage<std::decay_t<F>> and_then(F &&f) { return and_then_stage<std::decay_t<F>>{std::forward<F>(f)}; }
+  //! Returns a chain stage replacing any error with the result which `f` returns when given it.
+  template <class F> constexpr inline or_else_stage<std::decay_t<F>> or_else(F &&f) { return or_else_stage<std::decay_t<F>>{std::forward<F>(f)}; }
+
+  namespace detail
+  {
+    template <class T> struct is_stage : std::false_type
+    {
+    };
+    template <class F> struct is_stage<map_stage<F>> : std::true_type
+    {
+    };
+    template <class F> struct is_stage<and_then_stage<F>> : std::true_type
+    {
+    };
+    template <class F> struct is_stage<or_else_stage<F>> : std::true_type
+    {
+    };
+
+    // The type f returns when given a V, or nothing if V is void
+    template <class F, class V, bool = std::is_void<V>::value> struct invoke_value
+    {
+      using type = decltype(std::declval<F &>()(std::declval<V>()));
+    };
+    template <class F, class V> struct invoke_value<F, V, true>
+    {
+      using type = decltype(std::declval<F &>()());
+    };
+
+    // The value and error types after a stage
+    template <class V, class E, class Stage> struct stage_types;
+    template <class V, class E, class F> struct stage_types<V, E, map_stage<F>>
+    {
+      using value_type = std::remove_cv_t<typename invoke_value<F, V>::type>;
+      using error_type = E;
+    };
+    template <class V, class E, class F> struct stage_types<V, E, and_then_stage<F>>
+    {
+      using returned = std::decay_t<typename invoke_value<F, V>::type>;
+      static_assert(std::is_same<typename returned::error_type, E>::value, "and_then() requires f to return a result with the same error_type");
+      using value_type = typename returned::value_type;
+      using error_type = E;
+    };
+    template <class V, class E, class F> struct stage_types<V, E, or_else_stage<F>>
+    {
+      using returned = std::decay_t<typename invoke_value<F, E>::type>;
+      static_assert(std::is_same<typename returned::value_type, V>::value, "or_else() requires f to return a result with the same value_type");
+      using value_type = V;
+      using error_type = typename returned::error_type;
+    };
+    // The value and error types after all the stages
+    template <class V, class E, class... Stages> struct chain_types
+    {
+      using value_type = V;
+      using error_type = E;
+    };
+    template <class V, class E, class Stage, class... Stages> struct chain_types<V, E, Stage, Stages...> : chain_types<typename stage_types<V, E, Stage>::value_type, typename stage_types<V, E, Stage>::error_type, Stages...>
+    {
+    };
+
+    // Continues the chain with the value or error of r. This is the only status check made.
+    template <class Next, class Stages, class R> constexpr inline decltype(auto) branch_value(Stages &stages, R &&r, std::false_type /*unused*/) { return Next::value(stages, static_cast<R &&>(r).assume_value()); }
+    template <class Next, class Stages, class R> constexpr inline decltype(auto) branch_value(Stages &stages, R && /*unused*/, std::true_type /*unused*/) { return Next::value(stages); }
+    template <class Next, class Stages, class R> constexpr inline decltype(auto) branch(Stages &stages, R &&r)
+    {
+      if(!r.has_value())
+      {
+        return Next::error(stages, static_cast<R &&>(r).assume_error());
+      }
+      return branch_value<Next>(stages, static_cast<R &&>(r), std::is_void<typename std::decay_t<R>::value_type>());
+    }
+
+    // Evaluates the stages from I onwards, with a value passed as V..., which is empty if void, or with an error
+    template <class Result, size_t I, size_t N> struct evaluate
+    {
+      using next = evaluate<Result, I + 1, N>;
+
+      template <class Stages, class... V> static constexpr Result value(Stages &stages, V &&... v) { return on_value(std::get<I>(stages), stages, static_cast<V &&>(v)...); }
+      template <class Stages, class E> static constexpr Result error(Stages &stages, E &&e) { return on_error(std::get<I>(stages), stages, static_cast<E &&>(e)); }
+
+      // map() transforms the value without any check
+      template <class F, class Stages, class... V> static constexpr Result on_value(map_stage<F> &s, Stages &stages, V &&... v) { return map_value(std::is_void<decltype(s.f(static_cast<V &&>(v)...))>(), s.f, stages, static_cast<V &&>(v)...); }
+      template <class F, class Stages, class... V> static constexpr Result map_value(std::false_type /*unused*/, F &f, Stages &stages, V &&... v) { return next::value(stages, f(static_cast<V &&>(v)...)); }
+      template <class F, class Stages, class... V> static constexpr Result map_value(std::true_type /*unused*/, F &f, Stages &stages, V &&... v)
+      {
+        f(static_cast<V &&>(v)...);
+        return next::value(stages);
+      }
+      // and_then() is where the chain may start failing
+      template <class F, class Stages, class... V> static constexpr Result on_value(and_then_stage<F> &s, Stages &stages, V &&... v) { return branch<next>(stages, s.f(static_cast<V &&>(v)...)); }
+      template <class F, class Stages, class... V> static constexpr Result on_value(or_else_stage<F> & /*unused*/, Stages &stages, V &&... v) { return next::value(stages, static_cast<V &&>(v)...); }
+
+      template <class F, class Stages, class E> static constexpr Result on_error(map_stage<F> & /*unused*/, Stages &stages, E &&e) { return next::error(stages, static_cast<E &&>(e)); }
+      template <class F, class Stages, class E> static constexpr Result on_error(and_then_stage<F> & /*unused*/, Stages &stages, E &&e) { return next::error(stages, static_cast<E &&>(e)); }
+      // or_else() is where the chain may stop failing
+      template <class F, class Stages, class E> static constexpr Result on_error(or_else_stage<F> &s, Stages &stages, E &&e) { return branch<next>(stages, s.f(static_cast<E &&>(e))); }
+    };
+    template <class Result, size_t N> struct evaluate<Result, N, N>
+    {
+      template <class Stages, class... V> static constexpr Result value(Stages & /*unused*/, V &&... v) { return Result(in_place_type<typename Result::value_type_if_enabled>, static_cast<V &&>(v)...); }
+      // As a hand written early return of failure() would, so that the compiler merges the failure exits the same way
+      template <class Stages, class E> static constexpr Result error(Stages & /*unused*/, E &&e) { return Result(failure(static_cast<E &&>(e))); }
+    };
+  }  // namespace detail
+
+  /*! An unevaluated chain of stages applied to the result `Source`, which is an lvalue reference if
+  the chain was begun on an lvalue.
+  */
+  template <class Source, class... Stages> class chain
+  {
+    template <class S, class... T> friend class chain;
+    using _types = detail::chain_types<typename std::decay_t<Source>::value_type, typename std::decay_t<Source>::error_type, Stages...>;
+
+  public:
+    //! The type of `result` the chain evaluates to.
+    using result_type = typename std::decay_t<Source>::template rebind<typename _types::value_type, typename _types::error_type>;
+
+  private:
+    Source &&_source;
+    std::tuple<Stages...> _stages;
+
+  public:
+    //! Begins a chain on `source`, which is referred to, not copied.
+    constexpr chain(Source &&source, std::tuple<Stages...> &&stages)
+        : _source(static_cast<Source &&>(source))
+        , _stages(std::move(stages))
+    {
+    }
+    chain(const chain &) = delete;
+    chain(chain &&) = default;  // NOLINT
+    chain &operator=(const chain &) = delete;
+    chain &operator=(chain &&) = delete;
+    ~chain() = default;
+
+    //! Returns this chain with `stage` appended, still unevaluated.
+    template <class Stage> constexpr chain<Source, Stages..., std::decay_t<Stage>> append(Stage &&stage) && { return {static_cast<Source &&>(_source), std::tuple_cat(std::move(_stages), std::make_tuple(std::forward<Stage>(stage)))}; }
+
+    //! Evaluates the chain.
+    constexpr result_type get() && { return detail::branch<detail::evaluate<result_type, 0, sizeof...(Stages)>>(_stages, static_cast<Source &&>(_source)); }
+    //! Evaluates the chain.
+    constexpr operator result_type() && { return std::move(*this).get(); }  // NOLINT
+  };
+
+  //! Begins a chain of stages on a `result`.
+  OUTCOME_TEMPLATE(class R, class Stage)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(is_result_v<R> &&detail::is_stage<std::decay_t<Stage>>::value))
+  constexpr inline chain<R, std::decay_t<Stage>> operator|(R &&r, Stage &&stage) { return {static_cast<R &&>(r), std::make_tuple(std::forward<Stage>(stage))}; }
+  //! Appends a stage to a chain.
+  OUTCOME_TEMPLATE(class Source, class... Stages, class Stage)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(detail::is_stage<std::decay_t<Stage>>::value))
+  constexpr inline chain<Source, Stages..., std::decay_t<Stage>> operator|(chain<Source, Stages...> &&c, Stage &&stage) { return std::move(c).append(std::forward<Stage>(stage)); }
+}  // namespace monadic
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
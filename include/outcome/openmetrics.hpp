@@ -0,0 +1,161 @@
+/* Rendering of the failure and TRY counters as OpenMetrics text
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_OPENMETRICS_HPP
+#define OUTCOME_OPENMETRICS_HPP
+
+#include "error_counters.hpp"
+#include "format.hpp"
+#include "try_counters.hpp"
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  // A label value, with backslash, double quote and line feed escaped as OpenMetrics requires
+  template <class OutputIt> inline OutputIt openmetrics_label(OutputIt out, const char *name, const char *value)
+  {
+    out = format_chars(out, name);
+    out = format_chars(out, "=\"", 2);
+    for(const char *p = (value != nullptr) ? value : ""; *p != 0; ++p)
+    {
+      switch(*p)
+      {
+      case '\\':
+        out = format_chars(out, "\\\\", 2);
+        break;
+      case '"':
+        out = format_chars(out, "\\\"", 2);
+        break;
+      case '\n':
+        out = format_chars(out, "\\n", 2);
+        break;
+      default:
+        *out++ = *p;
+      }
+    }
+    return format_chars(out, "\"", 1);
+  }
+  template <class OutputIt> inline OutputIt openmetrics_family(OutputIt out, const char *name, const char *help)
+  {
+    out = format_chars(out, "# TYPE ", 7);
+    out = format_chars(out, name);
+    out = format_chars(out, " counter\n# HELP ", 16);
+    out = format_chars(out, name);
+    out = format_chars(out, " ", 1);
+    out = format_chars(out, help);
+    return format_chars(out, "\n", 1);
+  }
+  template <class OutputIt> inline OutputIt openmetrics_site_sample(OutputIt out, const char *name, const try_site &site, uint64_t count)
+  {
+    out = format_chars(out, name);
+    out = format_chars(out, "_total{", 7);
+    out = openmetrics_label(out, "function", site.function);
+    out = format_chars(out, ",", 1);
+    out = openmetrics_label(out, "file", site.file);
+    out = format_chars(out, ",line=\"", 7);
+    out = format_item(out, site.line);
+    out = format_chars(out, "\"} ", 3);
+    out = format_item(out, count);
+    return format_chars(out, "\n", 1);
+  }
+}  // namespace detail
+
+/*! Renders the counts of `error_counters` and `try_counters` as OpenMetrics text, which
+Prometheus also accepts, into a buffer supplied by the caller. Each scrape snapshots every
+counter without stopping the threads counting, as their `snapshot()` functions do, into tables
+the exporter keeps, so once those have grown to the number of distinct errors and TRY sites
+counted, rendering allocates nothing and may be done every second without disturbing the threads
+doing the work.
+
+The metric families rendered are:
+- `outcome_failures`, with labels `category`, the name of the error category, and `code`.
+- `outcome_failures_uncounted`, the failures not counted by category and code as a shard was full.
+- `outcome_try_attempts` and `outcome_try_failures`, with labels `function`, `file` and `line` of
+the TRY site, counted only if `OUTCOME_ENABLE_TRY_COUNTERS` is defined.
+
+An exporter is not thread safe, so one per scraping thread.
+*/
+class openmetrics_exporter
+{
+  error_counts _errors;
+  std::vector<try_site_count> _sites;
+
+public:
+  //! Reserves room for `errors` distinct errors and every TRY site, so that the first scrapes need not allocate either.
+  explicit openmetrics_exporter(size_t errors = detail::error_counter_shard::slots)
+  {
+    _errors.counts.reserve(errors);
+    _sites.reserve(OUTCOME_MAX_TRY_SITES);
+  }
+
+  /*! Snapshots the counters and writes them as OpenMetrics text, terminated by `# EOF`, into
+  `[first, last)`, without null terminating it.
+  \returns The end of what was written, and `std::errc::value_too_large` if it did not all fit,
+  in which case the text is truncated and should not be served.
+  */
+  to_chars_result render(char *first, char *last)
+  {
+    error_counters::snapshot(_errors);
+    try_counters::snapshot(_sites);
+    bool overflow = false;
+    const detail::bounded_chars end = render_to(detail::bounded_chars(first, last, &overflow));
+    return {end.get(), overflow ? std::errc::value_too_large : std::errc()};
+  }
+
+  //! Writes the counters of the last `render()` as OpenMetrics text into `out`.
+  template <class OutputIt> OutputIt render_to(OutputIt out) const
+  {
+    out = detail::openmetrics_family(out, "outcome_failures", "Failures counted by error category and code.");
+    for(const error_count &c : _errors.counts)
+    {
+      out = detail::format_chars(out, "outcome_failures_total{", 23);
+      out = detail::openmetrics_label(out, "category", c.category->name());
+      out = detail::format_chars(out, ",code=\"", 7);
+      out = detail::format_item(out, c.value);
+      out = detail::format_chars(out, "\"} ", 3);
+      out = detail::format_item(out, c.count);
+      out = detail::format_chars(out, "\n", 1);
+    }
+    out = detail::openmetrics_family(out, "outcome_failures_uncounted", "Failures not counted by error category and code, as the table of their thread was full.");
+    out = detail::format_chars(out, "outcome_failures_uncounted_total ", 33);
+    out = detail::format_item(out, _errors.overflow);
+    out = detail::format_chars(out, "\n", 1);
+    out = detail::openmetrics_family(out, "outcome_try_attempts", "Attempts of each TRY operation.");
+    for(const try_site_count &c : _sites)
+    {
+      out = detail::openmetrics_site_sample(out, "outcome_try_attempts", *c.site, c.attempts);
+    }
+    out = detail::openmetrics_family(out, "outcome_try_failures", "Failures propagated by each TRY operation.");
+    for(const try_site_count &c : _sites)
+    {
+      out = detail::openmetrics_site_sample(out, "outcome_try_failures", *c.site, c.failures);
+    }
+    return detail::format_chars(out, "# EOF\n", 6);
+  }
+};
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
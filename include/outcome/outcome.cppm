@@ -0,0 +1,149 @@
+/* C++ 20 module interface unit for result, outcome, the TRY operations and iostream support
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+/* Build this with the outcome_module CMake target, then `import outcome;` instead of including
+result.hpp, outcome.hpp, try.hpp and iostream_support.hpp. Modules cannot export macros, so
+include try_macros.hpp after the import for the OUTCOME_TRY macros.
+
+The headers are parsed once here in the global module fragment, and their public names are
+exported by using declarations. Everything in the `detail` namespaces stays unexported, but is
+still reachable by the templates which need it. The versioned namespace is exported as the
+namespace alias `outcome`, as its real name depends on the build.
+*/
+
+module;
+
+#include "iostream_support.hpp"
+#include "outcome.hpp"
+#include "result.hpp"
+#include "try.hpp"
+
+export module outcome;
+
+export namespace outcome = OUTCOME_V2_NAMESPACE;
+
+// Exporting the namespace definition exports everything declared within it
+export OUTCOME_V2_NAMESPACE_BEGIN
+
+using OUTCOME_V2_NAMESPACE::in_place_type;
+using OUTCOME_V2_NAMESPACE::in_place_type_t;
+
+using OUTCOME_V2_NAMESPACE::failure;
+using OUTCOME_V2_NAMESPACE::failure_type;
+using OUTCOME_V2_NAMESPACE::success;
+using OUTCOME_V2_NAMESPACE::success_type;
+
+using OUTCOME_V2_NAMESPACE::bad_outcome_access;
+using OUTCOME_V2_NAMESPACE::bad_result_access;
+using OUTCOME_V2_NAMESPACE::bad_result_access_with;
+
+using OUTCOME_V2_NAMESPACE::checked;
+using OUTCOME_V2_NAMESPACE::is_result;
+using OUTCOME_V2_NAMESPACE::is_result_v;
+using OUTCOME_V2_NAMESPACE::result;
+using OUTCOME_V2_NAMESPACE::unchecked;
+
+using OUTCOME_V2_NAMESPACE::is_outcome;
+using OUTCOME_V2_NAMESPACE::is_outcome_v;
+using OUTCOME_V2_NAMESPACE::lazy_failure_handle;
+using OUTCOME_V2_NAMESPACE::outcome;
+
+using OUTCOME_V2_NAMESPACE::operator==;
+using OUTCOME_V2_NAMESPACE::operator!=;
+using OUTCOME_V2_NAMESPACE::swap;
+
+using OUTCOME_V2_NAMESPACE::error_from_exception;
+using OUTCOME_V2_NAMESPACE::register_exception_error;
+using OUTCOME_V2_NAMESPACE::try_throw_std_exception_from_error;
+
+using OUTCOME_V2_NAMESPACE::try_operation_extract_value;
+using OUTCOME_V2_NAMESPACE::try_operation_return_as;
+
+using OUTCOME_V2_NAMESPACE::operator<<;
+using OUTCOME_V2_NAMESPACE::operator>>;
+using OUTCOME_V2_NAMESPACE::print;
+
+namespace convert
+{
+  using OUTCOME_V2_NAMESPACE::convert::value_or_error;
+  using OUTCOME_V2_NAMESPACE::convert::ValueOrError;
+  using OUTCOME_V2_NAMESPACE::convert::ValueOrNone;
+}  // namespace convert
+
+namespace hooks
+{
+  using OUTCOME_V2_NAMESPACE::hooks::default_hook;
+  using OUTCOME_V2_NAMESPACE::hooks::hook_outcome_construction;
+  using OUTCOME_V2_NAMESPACE::hooks::hook_outcome_copy_assignment;
+  using OUTCOME_V2_NAMESPACE::hooks::hook_outcome_copy_construction;
+  using OUTCOME_V2_NAMESPACE::hooks::hook_outcome_destruction;
+  using OUTCOME_V2_NAMESPACE::hooks::hook_outcome_in_place_construction;
+  using OUTCOME_V2_NAMESPACE::hooks::hook_outcome_move_assignment;
+  using OUTCOME_V2_NAMESPACE::hooks::hook_outcome_move_construction;
+  using OUTCOME_V2_NAMESPACE::hooks::hook_result_construction;
+  using OUTCOME_V2_NAMESPACE::hooks::hook_result_copy_assignment;
+  using OUTCOME_V2_NAMESPACE::hooks::hook_result_copy_construction;
+  using OUTCOME_V2_NAMESPACE::hooks::hook_result_destruction;
+  using OUTCOME_V2_NAMESPACE::hooks::hook_result_in_place_construction;
+  using OUTCOME_V2_NAMESPACE::hooks::hook_result_move_assignment;
+  using OUTCOME_V2_NAMESPACE::hooks::hook_result_move_construction;
+  using OUTCOME_V2_NAMESPACE::hooks::hook_result_print;
+  using OUTCOME_V2_NAMESPACE::hooks::override_outcome_exception;
+  using OUTCOME_V2_NAMESPACE::hooks::set_spare_storage;
+  using OUTCOME_V2_NAMESPACE::hooks::spare_storage;
+}  // namespace hooks
+
+namespace policy
+{
+  using OUTCOME_V2_NAMESPACE::policy::all_narrow;
+  using OUTCOME_V2_NAMESPACE::policy::debug_checked;
+  using OUTCOME_V2_NAMESPACE::policy::default_policy;
+  using OUTCOME_V2_NAMESPACE::policy::error_code;
+  using OUTCOME_V2_NAMESPACE::policy::error_code_throw_as_system_error;
+  using OUTCOME_V2_NAMESPACE::policy::exception_ptr;
+  using OUTCOME_V2_NAMESPACE::policy::exception_ptr_rethrow;
+  using OUTCOME_V2_NAMESPACE::policy::no_hooks;
+  using OUTCOME_V2_NAMESPACE::policy::terminate;
+  using OUTCOME_V2_NAMESPACE::policy::throw_as_system_error_with_payload;
+  using OUTCOME_V2_NAMESPACE::policy::throw_bad_result_access;
+  using OUTCOME_V2_NAMESPACE::policy::with_hooks;
+}  // namespace policy
+
+namespace trait
+{
+  using OUTCOME_V2_NAMESPACE::trait::disjoint_storage;
+  using OUTCOME_V2_NAMESPACE::trait::has_error_code;
+  using OUTCOME_V2_NAMESPACE::trait::has_error_code_v;
+  using OUTCOME_V2_NAMESPACE::trait::has_exception_ptr;
+  using OUTCOME_V2_NAMESPACE::trait::has_exception_ptr_v;
+  using OUTCOME_V2_NAMESPACE::trait::has_niche_v;
+  using OUTCOME_V2_NAMESPACE::trait::is_move_bitcopying;
+  using OUTCOME_V2_NAMESPACE::trait::is_move_bitcopying_v;
+  using OUTCOME_V2_NAMESPACE::trait::niche;
+  using OUTCOME_V2_NAMESPACE::trait::niche_enum;
+  using OUTCOME_V2_NAMESPACE::trait::niche_nan;
+  using OUTCOME_V2_NAMESPACE::trait::niche_pointer;
+}  // namespace trait
+
+OUTCOME_V2_NAMESPACE_END
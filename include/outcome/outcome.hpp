@@ -25,6 +25,10 @@ http://www.boost.org/LICENSE_1_0.txt)
 #ifndef OUTCOME_OUTCOME_HPP
 #define OUTCOME_OUTCOME_HPP
 
+#ifdef OUTCOME_RESULT_LITE
+#error outcome needs std::exception_ptr, so cannot be used with OUTCOME_RESULT_LITE
+#endif
+
 #include "detail/outcome_exception_observers.hpp"
 #include "detail/outcome_failure_observers.hpp"
 #include "result.hpp"
@@ -39,7 +43,7 @@ http://www.boost.org/LICENSE_1_0.txt)
 OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
 
 template <class R, class S = std::error_code, class P = std::exception_ptr, class NoValuePolicy = policy::default_policy<R, S, P>>  //
-OUTCOME_REQUIRES(detail::type_can_be_used_in_result<P> && (std::is_void<P>::value || std::is_default_constructible<P>::value))      //
+OUTCOME_REQUIRES(detail::usable_as_result_status<P>)  //
 class outcome;
 
 namespace detail
@@ -107,12 +111,13 @@ namespace detail
     std::is_constructible<exception_type, Args...>::value,                                                                                                                                                                        //
     exception_type,                                                                                                                                                                                                               //
     disable_inplace_value_error_exception_constructor>>>>;
+    // Enabled if exactly one of value_type, error_type and exception_type is constructible, without instantiating the choice for every candidate
     template <class... Args>
     static constexpr bool enable_inplace_value_error_exception_constructor =  //
-    implicit_constructors_enabled && !std::is_same<choose_inplace_value_error_exception_constructor<Args...>, disable_inplace_value_error_exception_constructor>::value;
+    implicit_constructors_enabled && (static_cast<int>(std::is_constructible<value_type, Args...>::value) + static_cast<int>(std::is_constructible<error_type, Args...>::value) + static_cast<int>(std::is_constructible<exception_type, Args...>::value)) == 1;
   };
 
-  template <class R, class S, class P, class NoValuePolicy> using select_outcome_impl2 = detail::outcome_exception_observers<detail::result_final<R, S, NoValuePolicy>, R, S, P, NoValuePolicy>;
+  template <class R, class S, class P, class NoValuePolicy> using select_outcome_impl2 = detail::outcome_exception_observers<detail::select_result_final<R, S, NoValuePolicy, true>, R, S, P, NoValuePolicy>;
   template <class R, class S, class P, class NoValuePolicy> using select_outcome_impl = std::conditional_t<trait::has_error_code_v<S> && trait::has_exception_ptr_v<P>, detail::outcome_failure_observers<select_outcome_impl2<R, S, P, NoValuePolicy>, R, S, P, NoValuePolicy>, select_outcome_impl2<R, S, P, NoValuePolicy>>;
 
   template <class T, class U, class V> constexpr inline const V &extract_exception_from_failure(const failure_type<U, V> &v) { return v.exception(); }
@@ -212,7 +217,7 @@ or if `S` is `void`, do `throw bad_outcome_access()`
    - If `S` is none of the above, then it is undefined behaviour [`policy::all_narrow`]
 */
 template <class R, class S, class P, class NoValuePolicy>                                                                       //
-OUTCOME_REQUIRES(detail::type_can_be_used_in_result<P> && (std::is_void<P>::value || std::is_default_constructible<P>::value))  //
+OUTCOME_REQUIRES(detail::usable_as_result_status<P>)  //
 class OUTCOME_NODISCARD outcome
 #if defined(DOXYGEN_IS_IN_THE_HOUSE) || defined(STANDARDESE_IS_IN_THE_HOUSE)
 : public detail::outcome_failure_observers<detail::select_outcome_impl2<R, S, P, NoValuePolicy>, R, S, P, NoValuePolicy>,
@@ -222,10 +227,12 @@ class OUTCOME_NODISCARD outcome
 : public detail::select_outcome_impl<R, S, P, NoValuePolicy>
 #endif
 {
+  static_assert(!std::is_reference<R>::value, "The value_type of an outcome cannot be a reference, use result<T &> instead");
   static_assert(detail::type_can_be_used_in_result<P>, "The exception_type cannot be used");
   static_assert(std::is_void<P>::value || std::is_default_constructible<P>::value, "exception_type must be void or default constructible");
   using base = detail::select_outcome_impl<R, S, P, NoValuePolicy>;
   friend NoValuePolicy;
+  friend typename detail::unhooked_policy<NoValuePolicy>::type;
   friend detail::select_outcome_impl2<R, S, P, NoValuePolicy>;
   template <class T, class U, class V, class W> friend class outcome;
   template <class T, class U, class V, class W, class X> friend constexpr inline void hooks::override_outcome_exception(outcome<T, U, V, W> *o, X &&v) noexcept;  // NOLINT
@@ -245,6 +252,15 @@ class OUTCOME_NODISCARD outcome
   struct explicit_valueorerror_converting_constructor_tag
   {
   };
+  struct in_place_type_sugar_tag
+  {
+  };
+  // Unpacks the references held by success_in_place_type and failure_in_place_type into an in place constructor
+  template <class Tag, class Tuple, size_t... I>
+  constexpr outcome(in_place_type_sugar_tag /*unused*/, Tag _, Tuple &&args, std::index_sequence<I...> /*unused*/)
+      : outcome(_, std::get<I>(std::forward<Tuple>(args))...)
+  {
+  }
 
   struct disable_in_place_value_type
   {
@@ -322,6 +338,19 @@ protected:
     std::is_void<exception_type>::value                           //
     || std::is_constructible<exception_type, Args...>::value;
 
+    //! Predicate for the allocator extended constructors to be available.
+    template <class Alloc>
+    static constexpr bool enable_allocator_construction =  //
+    std::uses_allocator<detail::devoid<value_type>, Alloc>::value;
+
+    //! Predicate for the allocator extended constructor forwarding to another constructor to be available.
+    template <class A1, class... Args>
+    static constexpr bool enable_allocator_forwarding_constructor =  //
+    !std::is_same<std::decay_t<A1>, outcome>::value                // not copy or move
+    && !std::is_same<std::decay_t<A1>, in_place_type_t<value_type>>::value  // not in place value
+    && !(sizeof...(Args) == 0 && enable_value_converting_constructor<A1>)   // not value converting
+    && std::is_constructible<outcome, A1, Args...>::value;
+
     // Predicate for the implicit converting inplace constructor to be available.
     template <class... Args>
     static constexpr bool enable_inplace_value_error_exception_constructor =  //
@@ -361,6 +390,7 @@ public:
   {
     using namespace hooks;
     hook_outcome_construction(this, std::forward<T>(t));
+    detail::policy_hooks_t<NoValuePolicy>::on_construction(this, std::forward<T>(t));
   }
   /*! Converting constructor to an errored outcome.
   \tparam 1
@@ -382,6 +412,7 @@ public:
   {
     using namespace hooks;
     hook_outcome_construction(this, std::forward<T>(t));
+    detail::policy_hooks_t<NoValuePolicy>::on_construction(this, std::forward<T>(t));
   }
   /*! Special error condition converting constructor to an errored outcome.
   \tparam 1
@@ -406,6 +437,7 @@ public:
   {
     using namespace hooks;
     hook_outcome_construction(this, std::forward<ErrorCondEnum>(t));
+    detail::policy_hooks_t<NoValuePolicy>::on_construction(this, std::forward<ErrorCondEnum>(t));
   }
   /*! Converting constructor to an excepted outcome.
   \tparam 1
@@ -426,8 +458,9 @@ public:
     _ptr(std::forward<T>(t))
   {
     using namespace hooks;
-    this->_state._status |= detail::status_have_exception;
+    this->_state.set_status(this->_state.status() | detail::status_have_exception);
     hook_outcome_construction(this, std::forward<T>(t));
+    detail::policy_hooks_t<NoValuePolicy>::on_construction(this, std::forward<T>(t));
   }
 
   /*! Explicit converting constructor from a compatible `ValueOrError` type.
@@ -472,6 +505,7 @@ public:
   {
     using namespace hooks;
     hook_outcome_copy_construction(this, o);
+    detail::policy_hooks_t<NoValuePolicy>::on_copy_construction(this, o);
   }
   /*! Explicit converting move constructor from a compatible outcome type.
   \tparam 4
@@ -490,6 +524,7 @@ public:
   {
     using namespace hooks;
     hook_outcome_move_construction(this, std::move(o));
+    detail::policy_hooks_t<NoValuePolicy>::on_move_construction(this, std::move(o));
   }
   /*! Explicit converting copy constructor from a compatible result type.
   \tparam 3
@@ -508,6 +543,7 @@ public:
   {
     using namespace hooks;
     hook_outcome_copy_construction(this, o);
+    detail::policy_hooks_t<NoValuePolicy>::on_copy_construction(this, o);
   }
   /*! Explicit converting move constructor from a compatible result type.
   \tparam 3
@@ -526,6 +562,7 @@ public:
   {
     using namespace hooks;
     hook_outcome_move_construction(this, std::move(o));
+    detail::policy_hooks_t<NoValuePolicy>::on_move_construction(this, std::move(o));
   }
 
 
@@ -548,6 +585,7 @@ public:
   {
     using namespace hooks;
     hook_outcome_in_place_construction(this, in_place_type<value_type>, std::forward<Args>(args)...);
+    detail::policy_hooks_t<NoValuePolicy>::on_in_place_construction(this, in_place_type<value_type>, std::forward<Args>(args)...);
   }
   /*! Inplace constructor to a successful value.
   \tparam 2
@@ -568,6 +606,7 @@ public:
   {
     using namespace hooks;
     hook_outcome_in_place_construction(this, in_place_type<value_type>, il, std::forward<Args>(args)...);
+    detail::policy_hooks_t<NoValuePolicy>::on_in_place_construction(this, in_place_type<value_type>, il, std::forward<Args>(args)...);
   }
   /*! Inplace constructor to an unsuccessful error.
   \tparam 1
@@ -587,6 +626,7 @@ public:
   {
     using namespace hooks;
     hook_outcome_in_place_construction(this, in_place_type<error_type>, std::forward<Args>(args)...);
+    detail::policy_hooks_t<NoValuePolicy>::on_in_place_construction(this, in_place_type<error_type>, std::forward<Args>(args)...);
   }
   /*! Inplace constructor to an unsuccessful error.
   \tparam 2
@@ -607,6 +647,7 @@ public:
   {
     using namespace hooks;
     hook_outcome_in_place_construction(this, in_place_type<error_type>, il, std::forward<Args>(args)...);
+    detail::policy_hooks_t<NoValuePolicy>::on_in_place_construction(this, in_place_type<error_type>, il, std::forward<Args>(args)...);
   }
   /*! Inplace constructor to an unsuccessful exception.
   \tparam 1
@@ -625,8 +666,9 @@ public:
       , _ptr(std::forward<Args>(args)...)
   {
     using namespace hooks;
-    this->_state._status |= detail::status_have_exception;
+    this->_state.set_status(this->_state.status() | detail::status_have_exception);
     hook_outcome_in_place_construction(this, in_place_type<exception_type>, std::forward<Args>(args)...);
+    detail::policy_hooks_t<NoValuePolicy>::on_in_place_construction(this, in_place_type<exception_type>, std::forward<Args>(args)...);
   }
   /*! Inplace constructor to an unsuccessful exception.
   \tparam 2
@@ -646,8 +688,9 @@ public:
       , _ptr(il, std::forward<Args>(args)...)
   {
     using namespace hooks;
-    this->_state._status |= detail::status_have_exception;
+    this->_state.set_status(this->_state.status() | detail::status_have_exception);
     hook_outcome_in_place_construction(this, in_place_type<exception_type>, il, std::forward<Args>(args)...);
+    detail::policy_hooks_t<NoValuePolicy>::on_in_place_construction(this, in_place_type<exception_type>, il, std::forward<Args>(args)...);
   }
   /*! Implicit inplace constructor to successful value, or unsuccessful error, or unsuccessful exception.
   \tparam 3
@@ -665,6 +708,110 @@ public:
   {
   }
 
+  /// \output_section Allocator extended constructors
+  /*! Explicit inplace constructor to a successful outcome, passing an allocator to the value.
+  \tparam 2
+  \exclude
+  \param _ Tag type to indicate we are doing allocator extended construction.
+  \param a The allocator.
+  \param t Tag type to indicate we are doing in place construction of `value_type`.
+  \param args Arguments with which to in place construct.
+
+  \effects Initialises the outcome with a `value_type` constructed from `args` by uses-allocator
+  construction with `a`, as `std::make_obj_using_allocator()` would.
+  \requires `std::uses_allocator<value_type, Alloc>` to be true, and `Args...` are constructible to `value_type`.
+  \throws Any exception the construction of `value_type` might throw.
+  */
+  OUTCOME_TEMPLATE(class Alloc, class... Args)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template enable_allocator_construction<Alloc> &&predicate::template enable_inplace_value_constructor<Args...>))
+  OUTCOME_CONSTEXPR20 explicit outcome(std::allocator_arg_t _, const Alloc &a, in_place_type_t<value_type_if_enabled> t, Args &&... args)
+      : base{_, a, t, std::forward<Args>(args)...}
+      , _ptr()
+  {
+    using namespace hooks;
+    hook_outcome_in_place_construction(this, in_place_type<value_type>, std::forward<Args>(args)...);
+    detail::policy_hooks_t<NoValuePolicy>::on_in_place_construction(this, in_place_type<value_type>, std::forward<Args>(args)...);
+  }
+  /*! Allocator extended converting constructor to a successful outcome.
+  \tparam 2
+  \exclude
+  \param _ Tag type to indicate we are doing allocator extended construction.
+  \param a The allocator.
+  \param t The value from which to initialise the `value_type`.
+
+  \effects Initialises the outcome with a `value_type` constructed from `t` by uses-allocator construction with `a`.
+  \requires `std::uses_allocator<value_type, Alloc>` to be true, and `outcome(T)` to be the converting constructor to a successful outcome.
+  \throws Any exception the construction of `value_type` might throw.
+  */
+  OUTCOME_TEMPLATE(class Alloc, class T)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template enable_allocator_construction<Alloc> &&predicate::template enable_value_converting_constructor<T>))
+  OUTCOME_CONSTEXPR20 outcome(std::allocator_arg_t _, const Alloc &a, T &&t)
+      : base{_, a, in_place_type<typename base::_value_type>, std::forward<T>(t)}
+      , _ptr()
+  {
+    using namespace hooks;
+    hook_outcome_construction(this, std::forward<T>(t));
+    detail::policy_hooks_t<NoValuePolicy>::on_construction(this, std::forward<T>(t));
+  }
+  /*! Allocator extended copy constructor.
+  \tparam 1
+  \exclude
+  \param _ Tag type to indicate we are doing allocator extended construction.
+  \param a The allocator.
+  \param o The outcome to copy.
+
+  \effects Initialises the outcome with a copy of `o`, any value being copied by uses-allocator construction with `a`.
+  \requires `std::uses_allocator<value_type, Alloc>` to be true.
+  \throws Any exception the construction of `value_type`, `error_type` and `exception_type` might throw.
+  */
+  OUTCOME_TEMPLATE(class Alloc)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template enable_allocator_construction<Alloc>))
+  OUTCOME_CONSTEXPR20 outcome(std::allocator_arg_t _, const Alloc &a, const outcome &o)
+      : base{_, a, o}
+      , _ptr(o._ptr)
+  {
+    detail::policy_hooks_t<NoValuePolicy>::on_copy_construction(this, o);
+  }
+  /*! Allocator extended move constructor.
+  \tparam 1
+  \exclude
+  \param _ Tag type to indicate we are doing allocator extended construction.
+  \param a The allocator.
+  \param o The outcome to move.
+
+  \effects Initialises the outcome with a move of `o`, any value being moved by uses-allocator construction with `a`.
+  \requires `std::uses_allocator<value_type, Alloc>` to be true.
+  \throws Any exception the construction of `value_type`, `error_type` and `exception_type` might throw.
+  */
+  OUTCOME_TEMPLATE(class Alloc)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template enable_allocator_construction<Alloc>))
+  OUTCOME_CONSTEXPR20 outcome(std::allocator_arg_t _, const Alloc &a, outcome &&o)
+      : base{_, a, std::move(o)}
+      , _ptr(std::move(o._ptr))
+  {
+    detail::policy_hooks_t<NoValuePolicy>::on_move_construction(this, std::move(o));
+  }
+  /*! Allocator extended constructor from anything else an outcome can be constructed from, such as
+  an error, an exception or the type sugar, so that uses-allocator construction of an outcome always succeeds.
+  \tparam 3
+  \exclude
+  \param 1
+  \exclude
+  \param 2
+  \exclude
+  \param args Arguments from which to construct.
+
+  \effects Constructs as `outcome(args...)` would, without the allocator.
+  \requires `std::uses_allocator<value_type, Alloc>` to be true.
+  \throws Any exception `outcome(args...)` might throw.
+  */
+  OUTCOME_TEMPLATE(class Alloc, class A1, class... Args)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template enable_allocator_construction<Alloc> &&predicate::template enable_allocator_forwarding_constructor<A1, Args...>))
+  OUTCOME_CONSTEXPR20 outcome(std::allocator_arg_t /*unused*/, const Alloc & /*unused*/, A1 &&a1, Args &&... args)
+      : outcome(std::forward<A1>(a1), std::forward<Args>(args)...)
+  {
+  }
+
   /// \output_section Tagged constructors
   /*! Implicit tagged constructor of a successful outcome.
   \param o The compatible success type sugar.
@@ -678,6 +825,7 @@ public:
   {
     using namespace hooks;
     hook_outcome_copy_construction(this, o);
+    detail::policy_hooks_t<NoValuePolicy>::on_copy_construction(this, o);
   }
   /*! Implicit tagged constructor of a successful outcome.
   \tparam 1
@@ -695,6 +843,7 @@ public:
   {
     using namespace hooks;
     hook_outcome_copy_construction(this, o);
+    detail::policy_hooks_t<NoValuePolicy>::on_copy_construction(this, o);
   }
   /*! Implicit tagged constructor of a successful outcome.
   \tparam 1
@@ -712,6 +861,7 @@ public:
   {
     using namespace hooks;
     hook_outcome_move_construction(this, std::move(o));
+    detail::policy_hooks_t<NoValuePolicy>::on_move_construction(this, std::move(o));
   }
   /*! Implicit tagged constructor of a failure outcome.
   \tparam 2
@@ -728,16 +878,17 @@ public:
   : base{in_place_type<typename base::_error_type>, detail::extract_error_from_failure<error_type>(o)},
     _ptr(detail::extract_exception_from_failure<exception_type>(o))
   {
-    if(this->_error == decltype(this->_error){})  // NOLINT
+    if(this->_error_ref() == std::decay_t<decltype(this->_error_ref())>{})  // NOLINT
     {
-      this->_state._status &= ~detail::status_have_error;
+      this->_state.set_status(this->_state.status() & ~detail::status_have_error);
     }
     if(_ptr != decltype(_ptr){})
     {
-      this->_state._status |= detail::status_have_exception;
+      this->_state.set_status(this->_state.status() | detail::status_have_exception);
     }
     using namespace hooks;
     hook_outcome_copy_construction(this, o);
+    detail::policy_hooks_t<NoValuePolicy>::on_copy_construction(this, o);
   }
   /*! Implicit tagged constructor of a failure outcome.
   \tparam 2
@@ -754,16 +905,48 @@ public:
   : base{in_place_type<typename base::_error_type>, std::move(detail::extract_error_from_failure<error_type>(std::move(o)))},
     _ptr(std::move(detail::extract_exception_from_failure<decltype(_ptr)>(std::move(o))))
   {
-    if(this->_error == decltype(this->_error){})  // NOLINT
+    if(this->_error_ref() == std::decay_t<decltype(this->_error_ref())>{})  // NOLINT
     {
-      this->_state._status &= ~detail::status_have_error;
+      this->_state.set_status(this->_state.status() & ~detail::status_have_error);
     }
     if(_ptr != decltype(_ptr){})
     {
-      this->_state._status |= detail::status_have_exception;
+      this->_state.set_status(this->_state.status() | detail::status_have_exception);
     }
     using namespace hooks;
     hook_outcome_move_construction(this, std::move(o));
+    detail::policy_hooks_t<NoValuePolicy>::on_move_construction(this, std::move(o));
+  }
+
+  /*! Implicit tagged constructor of a successful outcome.
+  \tparam 1
+  \exclude
+  \param o The in place success type sugar.
+
+  \effects Initialises the outcome with a `value_type` constructed in place from the arguments referenced by the type sugar.
+  \requires `value_type` is void or `Args...` are constructible to `value_type`.
+  \throws Any exception the construction of `value_type(Args...)` might throw.
+  */
+  OUTCOME_TEMPLATE(class... Args)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template enable_inplace_value_constructor<Args...>))
+  constexpr outcome(success_in_place_type<Args...> &&o) noexcept(std::is_nothrow_constructible<value_type, Args...>::value)  // NOLINT
+      : outcome(in_place_type_sugar_tag(), in_place_type<value_type_if_enabled>, std::move(o.args), std::index_sequence_for<Args...>())
+  {
+  }
+  /*! Implicit tagged constructor of a failure outcome.
+  \tparam 1
+  \exclude
+  \param o The in place failure type sugar.
+
+  \effects Initialises the outcome with an `error_type` constructed in place from the arguments referenced by the type sugar.
+  \requires `error_type` is void or `Args...` are constructible to `error_type`.
+  \throws Any exception the construction of `error_type(Args...)` might throw.
+  */
+  OUTCOME_TEMPLATE(class... Args)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template enable_inplace_error_constructor<Args...>))
+  constexpr outcome(failure_in_place_type<Args...> &&o) noexcept(std::is_nothrow_constructible<error_type, Args...>::value)  // NOLINT
+      : outcome(in_place_type_sugar_tag(), in_place_type<error_type_if_enabled>, std::move(o.args), std::index_sequence_for<Args...>())
+  {
   }
 
   /// \output_section Comparison operators
@@ -782,13 +965,13 @@ public:
   && noexcept(detail::safe_compare_equal(std::declval<detail::devoid<S>>(), std::declval<detail::devoid<U>>()))  //
   && noexcept(detail::safe_compare_equal(std::declval<detail::devoid<P>>(), std::declval<detail::devoid<V>>())))
   {
-    if(this->_state._status == o._state._status)
+    if(this->_state.status() == o._state.status())
     {
       if(!base::operator==(o))
       {
         return false;
       }
-      if((this->_state._status & detail::status_have_exception))
+      if((this->_state.status() & detail::status_have_exception))
       {
         return detail::safe_compare_equal(this->_ptr, o._ptr);
       }
@@ -806,18 +989,18 @@ public:
   noexcept(detail::safe_compare_equal(std::declval<detail::devoid<S>>(), std::declval<detail::devoid<T>>()))  //
   && noexcept(detail::safe_compare_equal(std::declval<detail::devoid<P>>(), std::declval<detail::devoid<U>>())))
   {
-    if(!(this->_state._status & detail::status_have_exception))
+    if(!(this->_state.status() & detail::status_have_exception))
     {
       return false;
     }
-    if(this->_state._status & detail::status_have_error)
+    if(this->_state.status() & detail::status_have_error)
     {
-      if(!detail::safe_compare_equal(this->_error, o.error()))
+      if(!detail::safe_compare_equal(this->_error_ref(), o.error()))
       {
         return false;
       }
     }
-    if((this->_state._status & detail::status_have_exception))
+    if((this->_state.status() & detail::status_have_exception))
     {
       return detail::safe_compare_equal(this->_ptr, o.exception());
     }
@@ -836,7 +1019,7 @@ public:
   && noexcept(detail::safe_compare_notequal(std::declval<detail::devoid<S>>(), std::declval<detail::devoid<U>>()))  //
   && noexcept(detail::safe_compare_notequal(std::declval<detail::devoid<P>>(), std::declval<detail::devoid<V>>())))
   {
-    if(this->_state._status != o._state._status)
+    if(this->_state.status() != o._state.status())
     {
       return true;
     }
@@ -844,7 +1027,7 @@ public:
     {
       return true;
     }
-    if((this->_state._status & detail::status_have_exception))
+    if((this->_state.status() & detail::status_have_exception))
     {
       return detail::safe_compare_notequal(this->_ptr, o._ptr);
     }
@@ -861,18 +1044,18 @@ public:
   noexcept(detail::safe_compare_notequal(std::declval<detail::devoid<S>>(), std::declval<detail::devoid<T>>()))  //
   && noexcept(detail::safe_compare_notequal(std::declval<detail::devoid<P>>(), std::declval<detail::devoid<U>>())))
   {
-    if(!(this->_state._status & detail::status_have_exception))
+    if(!(this->_state.status() & detail::status_have_exception))
     {
       return true;
     }
-    if(this->_state._status & detail::status_have_error)
+    if(this->_state.status() & detail::status_have_error)
     {
-      if(detail::safe_compare_notequal(this->_error, o.error()))
+      if(detail::safe_compare_notequal(this->_error_ref(), o.error()))
       {
         return true;
       }
     }
-    if((this->_state._status & detail::status_have_exception))
+    if((this->_state.status() & detail::status_have_exception))
     {
       return detail::safe_compare_notequal(this->_ptr, o.exception());
     }
@@ -881,45 +1064,48 @@ public:
 
   /// \output_section Swap
   /*! Swaps this result with another result
-  \effects Any `R` and/or `S` is swapped along with the metadata tracking them.
+  \effects Any `R` and/or `S` is swapped along with the metadata tracking them. Only live members
+  are touched, so the errors and exceptions are not swapped unless either outcome has one. Members
+  which can throw when swapped are swapped before those which cannot.
   */
-  void swap(outcome &o) noexcept(detail::is_nothrow_swappable<value_type>::value    //
-                                 &&detail::is_nothrow_swappable<error_type>::value  //
-                                 &&detail::is_nothrow_swappable<exception_type>::value)
+  OUTCOME_CONSTEXPR20 void swap(outcome &o) noexcept(detail::is_nothrow_swappable<value_type>::value    //
+                                                     &&detail::is_nothrow_swappable<error_type>::value  //
+                                                     &&detail::is_nothrow_swappable<exception_type>::value)
   {
     using std::swap;
+    // The exceptions are unused defaults unless either side has one
+    if(((this->_state.status() | o._state.status()) & detail::status_have_exception) == 0)
+    {
+      this->_swap_state_and_error(o);
+      return;
+    }
+    if(detail::is_nothrow_swappable<detail::devoid<exception_type>>::value)
+    {
+      this->_swap_state_and_error(o);
+      swap(this->_ptr, o._ptr);
+      return;
+    }
+    // Swap the exception first, so if it throws nothing has been swapped
+    swap(this->_ptr, o._ptr);
 #ifdef __cpp_exceptions
 #ifdef _MSC_VER
 #pragma warning(push)
 #pragma warning(disable : 4297)  // use of throw in noexcept function
 #endif
-    this->_state.swap(o._state);
     try
     {
-      swap(this->_error, o._error);
-      try
-      {
-        swap(this->_ptr, o._ptr);
-      }
-      catch(...)
-      {
-        swap(this->_state, o._state);
-        swap(this->_error, o._error);
-        throw;
-      }
+      this->_swap_state_and_error(o);
     }
     catch(...)
     {
-      swap(this->_state, o._state);
+      swap(this->_ptr, o._ptr);
       throw;
     }
 #ifdef _MSC_VER
 #pragma warning(pop)
 #endif
 #else
-    swap(this->_state, o._state);
-    swap(this->_error, o._error);
-    swap(this->_ptr, o._ptr);
+    this->_swap_state_and_error(o);
 #endif
   }
 
@@ -955,6 +1141,36 @@ public:
     }
     return OUTCOME_V2_NAMESPACE::failure(std::move(this->assume_error()), exception_type());
   }
+
+  /// \output_section Monadic operations
+  /*! Returns any value transformed by `f`, or else any failure.
+  \returns A `rebind<U>` where `U` is what `f` returns, being void if `f` returns nothing.
+  \effects If this outcome has a value, returns what `f(value)` returns as the value, calling `f()` if
+  `value_type` is `void`. Otherwise returns a copy of the failure, which is moved from an rvalue outcome.
+  \group outcome_map
+  */
+  template <class F> constexpr auto map(F &&f) const & { return detail::monadic_map(*this, std::forward<F>(f)); }
+  /// \group outcome_map
+  template <class F> constexpr auto map(F &&f) && { return detail::monadic_map(std::move(*this), std::forward<F>(f)); }
+  /*! Returns what `f` returns when given any value, or else any failure.
+  \returns The outcome which `f` returns, which must have the same `error_type` as this outcome.
+  \effects If this outcome has a value, returns `f(value)`, calling `f()` if `value_type` is `void`.
+  Otherwise returns a copy of the failure, which is moved from an rvalue outcome.
+  \group outcome_and_then
+  */
+  template <class F> constexpr auto and_then(F &&f) const & { return detail::monadic_and_then(*this, std::forward<F>(f)); }
+  /// \group outcome_and_then
+  template <class F> constexpr auto and_then(F &&f) && { return detail::monadic_and_then(std::move(*this), std::forward<F>(f)); }
+  /*! Returns what `f` returns when given any failure, or else any value.
+  \returns The outcome which `f` returns, which must have the same `value_type` as this outcome.
+  \effects If this outcome has no value, returns `f(as_failure())`, so `f` receives the error and
+  the exception as a `failure_type`. Otherwise returns a copy of the value, which is moved from an
+  rvalue outcome.
+  \group outcome_or_else
+  */
+  template <class F> constexpr auto or_else(F &&f) const & { return detail::monadic_or_else(*this, std::forward<F>(f)); }
+  /// \group outcome_or_else
+  template <class F> constexpr auto or_else(F &&f) && { return detail::monadic_or_else(std::move(*this), std::forward<F>(f)); }
 };
 
 /*! True if the result is equal to the outcome
@@ -996,11 +1212,25 @@ noexcept(std::declval<outcome<R, S, P, N>>() != std::declval<result<T, U, V>>())
 /*! Specialise swap for outcome.
 \effects Calls `a.swap(b)`.
 */
-template <class R, class S, class P, class N> inline void swap(outcome<R, S, P, N> &a, outcome<R, S, P, N> &b) noexcept(noexcept(a.swap(b)))
+template <class R, class S, class P, class N> OUTCOME_CONSTEXPR20 inline void swap(outcome<R, S, P, N> &a, outcome<R, S, P, N> &b) noexcept(noexcept(a.swap(b)))
 {
   a.swap(b);
 }
 
+namespace trait
+{
+  //! `std::exception_ptr` is a reference counted pointer in all the major standard libraries.
+  template <> struct is_move_bitcopying<std::exception_ptr>
+  {
+    static constexpr bool value = true;
+  };
+  //! An `outcome` can be relocated by `memcpy()` if its value, error and exception types can.
+  template <class R, class S, class P, class N> struct is_move_bitcopying<outcome<R, S, P, N>>
+  {
+    static constexpr bool value = is_move_bitcopying<OUTCOME_V2_NAMESPACE::detail::result_final<R, S, N>>::value && is_move_bitcopying<OUTCOME_V2_NAMESPACE::detail::devoid<P>>::value;
+  };
+}  // namespace trait
+
 namespace hooks
 {
   /*! Used to set/override an exception during a construction hook implementation.
@@ -1012,12 +1242,20 @@ namespace hooks
   template <class R, class S, class P, class NoValuePolicy, class U> constexpr inline void override_outcome_exception(outcome<R, S, P, NoValuePolicy> *o, U &&v) noexcept
   {
     o->_ptr = std::forward<U>(v);
-    o->_state._status |= detail::status_have_exception;
+    o->_state.set_status(o->_state.status() | detail::status_have_exception);
   }
 }  // namespace hooks
 
 OUTCOME_V2_NAMESPACE_END
 
+namespace std
+{
+  //! An `outcome` uses an allocator if its value does, so allocator aware containers pass theirs on to the value.
+  template <class R, class S, class P, class N, class Alloc> struct uses_allocator<OUTCOME_V2_NAMESPACE::outcome<R, S, P, N>, Alloc> : uses_allocator<OUTCOME_V2_NAMESPACE::detail::devoid<R>, Alloc>
+  {
+  };
+}  // namespace std
+
 #ifdef __clang__
 #pragma clang diagnostic pop
 #endif
@@ -0,0 +1,333 @@
+/* Parallel algorithms over callables returning results
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_PARALLEL_HPP
+#define OUTCOME_PARALLEL_HPP
+
+#include "result.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+/*! Namespace for algorithms which run a callable returning a `result` over a range on many threads.
+
+The first failure to be observed cancels all sibling work through a shared flag, so workers stop
+as soon as they next look. Which failure is returned is the first one observed, which need not
+be the lowest indexed one, except by `for_each_collect()`, which gathers every failure instead.
+Exceptions thrown by the callable are rethrown on the calling thread.
+*/
+namespace parallel
+{
+  namespace detail
+  {
+    template <class It, class F> using transform_result_t = std::decay_t<decltype(std::declval<F &>()(*std::declval<It>()))>;
+
+    // Shared state of one parallel run
+    template <class Error> struct cancellation
+    {
+      std::atomic<bool> cancelled{false};
+      std::atomic<size_t> next{0};
+      Error error{};
+#ifdef __cpp_exceptions
+      std::exception_ptr exception;
+#endif
+      // Returns true if the caller won the race to cancel, and so may record why
+      bool cancel() noexcept { return !cancelled.exchange(true, std::memory_order_acq_rel); }
+    };
+
+    inline size_t thread_count(size_t requested, size_t items) noexcept
+    {
+      size_t threads = (requested != 0) ? requested : std::thread::hardware_concurrency();
+      return std::max<size_t>(1, std::min(threads, items));
+    }
+
+    /* Runs worker(idx) on each of `threads` threads, including the calling one. The workers claim
+    chunks of the `items` indices and call op(n) for each, stopping when op returns false or
+    when cancelled.
+    */
+    template <class Error, class Op> inline void run(cancellation<Error> &state, size_t items, size_t threads, Op &&op)
+    {
+      const size_t grain = std::max<size_t>(1, items / (threads * 8));
+      auto worker = [&](size_t idx) {
+#ifdef __cpp_exceptions
+        try
+#endif
+        {
+          for(;;)
+          {
+            const size_t begin = state.next.fetch_add(grain, std::memory_order_relaxed);
+            if(begin >= items)
+            {
+              return;
+            }
+            const size_t end = std::min(items, begin + grain);
+            for(size_t n = begin; n < end; n++)
+            {
+              if(state.cancelled.load(std::memory_order_relaxed) || !op(idx, n))
+              {
+                return;
+              }
+            }
+          }
+        }
+#ifdef __cpp_exceptions
+        catch(...)
+        {
+          if(state.cancel())
+          {
+            state.exception = std::current_exception();
+          }
+        }
+#endif
+      };
+      std::vector<std::thread> workers;
+      workers.reserve(threads - 1);
+#ifdef __cpp_exceptions
+      try
+#endif
+      {
+        for(size_t n = 1; n < threads; n++)
+        {
+          workers.emplace_back(worker, n);
+        }
+      }
+#ifdef __cpp_exceptions
+      catch(...)
+      {
+        // Stop and join the threads already started, as destroying a joinable thread terminates
+        state.cancel();
+        for(auto &t : workers)
+        {
+          t.join();
+        }
+        throw;
+      }
+#endif
+      worker(0);
+      for(auto &t : workers)
+      {
+        t.join();
+      }
+#ifdef __cpp_exceptions
+      if(state.exception)
+      {
+        std::rethrow_exception(state.exception);
+      }
+#endif
+    }
+
+    // One value in a vector, which unlike std::vector<bool> threads may write apart from its neighbours
+    template <class T> struct value_slot
+    {
+      T value{};
+      value_slot() = default;
+      explicit value_slot(const T &v)
+          : value(v)
+      {
+      }
+    };
+
+    // The failures of one thread, on a cache line of its own
+    template <class E> struct alignas(64) failure_buffer
+    {
+      std::vector<E> failures;
+    };
+  }  // namespace detail
+
+  //! The error of one item of a batch, and the index of the item.
+  template <class E> struct batch_error
+  {
+    //! The index of the item in the input.
+    size_t index;
+    //! The error which `f` returned for it.
+    E error;
+  };
+  //! Every error of a batch, as returned by `for_each_collect()`.
+  template <class E> struct batch_errors
+  {
+    //! The number of items in the batch.
+    size_t items{0};
+    //! The errors, in the order of their items in the input.
+    std::vector<batch_error<E>> errors;
+  };
+
+  /*! Calls `f` on each item in `[first, last)` on up to `threads` threads, zero meaning one per hardware thread.
+  \returns A `result` of a `std::vector` of the values returned by `f` in the order of the input, or
+  the first error observed, in which case no further calls to `f` begin.
+  \requires `RandomIt` to be a random access iterator, `f` to return a `result` whose value type is
+  default constructible, and `f` to be safe to call concurrently.
+  */
+  template <class RandomIt, class F, class R = detail::transform_result_t<RandomIt, F>>  //
+  inline result<std::vector<typename R::value_type>, typename R::error_type> transform(RandomIt first, RandomIt last, F &&f, size_t threads = 0)
+  {
+    using value_type = typename R::value_type;
+    using error_type = typename R::error_type;
+    const auto items = static_cast<size_t>(std::distance(first, last));
+    std::vector<detail::value_slot<value_type>> slots(items);
+    detail::cancellation<error_type> state;
+    detail::run(state, items, detail::thread_count(threads, items), [&](size_t /*unused*/, size_t n) {
+      auto r = f(first[n]);
+      if(OUTCOME_UNLIKELY(!r.has_value()))
+      {
+        if(state.cancel())
+        {
+          state.error = std::move(r).assume_error();
+        }
+        return false;
+      }
+      slots[n].value = std::move(r).assume_value();
+      return true;
+    });
+    if(state.cancelled.load(std::memory_order_acquire))
+    {
+      return failure(std::move(state.error));
+    }
+    std::vector<value_type> out;
+    out.reserve(items);
+    for(auto &slot : slots)
+    {
+      out.push_back(std::move(slot.value));
+    }
+    return {std::move(out)};
+  }
+  //! \group transform
+  template <class Range, class F>
+  inline auto transform(const Range &range, F &&f, size_t threads = 0) -> decltype(transform(std::begin(range), std::end(range), std::forward<F>(f), threads))
+  {
+    return transform(std::begin(range), std::end(range), std::forward<F>(f), threads);
+  }
+
+  /*! Calls `f` on each item in `[first, last)` on up to `threads` threads, zero meaning one per hardware
+  thread, and combines the values returned with `reduce`, starting from `init`.
+  \returns A `result` of the reduction, or the first error observed, in which case no further calls
+  to `f` begin.
+  \requires `RandomIt` to be a random access iterator, and `f` and `reduce` to be safe to call concurrently.
+  `reduce` must be associative and commutative, as items are combined in no particular order.
+  */
+  template <class RandomIt, class T, class Reduce, class F, class R = detail::transform_result_t<RandomIt, F>>  //
+  inline result<T, typename R::error_type> transform_reduce(RandomIt first, RandomIt last, T init, Reduce &&reduce, F &&f, size_t threads = 0)
+  {
+    using error_type = typename R::error_type;
+    const auto items = static_cast<size_t>(std::distance(first, last));
+    const size_t count = detail::thread_count(threads, items);
+    // One partial reduction per thread, slots are only touched by their thread until joined
+    std::vector<detail::value_slot<T>> partial(count, detail::value_slot<T>(init));
+    std::vector<char> used(count, 0);
+    detail::cancellation<error_type> state;
+    detail::run(state, items, count, [&](size_t idx, size_t n) {
+      auto r = f(first[n]);
+      if(OUTCOME_UNLIKELY(!r.has_value()))
+      {
+        if(state.cancel())
+        {
+          state.error = std::move(r).assume_error();
+        }
+        return false;
+      }
+      partial[idx].value = used[idx] ? reduce(std::move(partial[idx].value), std::move(r).assume_value()) : T(std::move(r).assume_value());
+      used[idx] = 1;
+      return true;
+    });
+    if(state.cancelled.load(std::memory_order_acquire))
+    {
+      return failure(std::move(state.error));
+    }
+    for(size_t n = 0; n < count; n++)
+    {
+      if(used[n])
+      {
+        init = reduce(std::move(init), std::move(partial[n].value));
+      }
+    }
+    return {std::move(init)};
+  }
+  //! \group transform_reduce
+  template <class Range, class T, class Reduce, class F>
+  inline auto transform_reduce(const Range &range, T init, Reduce &&reduce, F &&f, size_t threads = 0) -> decltype(transform_reduce(std::begin(range), std::end(range), std::move(init), std::forward<Reduce>(reduce), std::forward<F>(f), threads))
+  {
+    return transform_reduce(std::begin(range), std::end(range), std::move(init), std::forward<Reduce>(reduce), std::forward<F>(f), threads);
+  }
+
+  /*! Calls `f` on every item in `[first, last)` on up to `threads` threads, zero meaning one per hardware
+  thread, gathering every failure rather than stopping at the first. Each thread appends the failures it
+  sees to a buffer of its own, without a lock, and the buffers are merged once all threads are done.
+  \returns An empty `result` if every call succeeded, else a `batch_errors` of every error returned,
+  each with the index of its item, in the order of the input.
+  \requires `RandomIt` to be a random access iterator, `f` to return a `result`, and `f` to be safe to
+  call concurrently.
+  */
+  template <class RandomIt, class F, class R = detail::transform_result_t<RandomIt, F>>  //
+  inline result<void, batch_errors<typename R::error_type>> for_each_collect(RandomIt first, RandomIt last, F &&f, size_t threads = 0)
+  {
+    using error_type = typename R::error_type;
+    const auto items = static_cast<size_t>(std::distance(first, last));
+    const size_t count = detail::thread_count(threads, items);
+    // Buffers are only touched by their thread until joined
+    std::vector<detail::failure_buffer<batch_error<error_type>>> buffers(count);
+    // Only cancelled by an exception thrown by f
+    detail::cancellation<bool> state;
+    detail::run(state, items, count, [&](size_t idx, size_t n) {
+      auto r = f(first[n]);
+      if(OUTCOME_UNLIKELY(!r.has_value()))
+      {
+        buffers[idx].failures.push_back(batch_error<error_type>{n, std::move(r).assume_error()});
+      }
+      return true;
+    });
+    size_t failures = 0;
+    for(auto &b : buffers)
+    {
+      failures += b.failures.size();
+    }
+    if(failures == 0)
+    {
+      return success();
+    }
+    batch_errors<error_type> ret;
+    ret.items = items;
+    ret.errors.reserve(failures);
+    for(auto &b : buffers)
+    {
+      std::move(b.failures.begin(), b.failures.end(), std::back_inserter(ret.errors));
+    }
+    std::sort(ret.errors.begin(), ret.errors.end(), [](const batch_error<error_type> &a, const batch_error<error_type> &b) { return a.index < b.index; });
+    return failure(std::move(ret));
+  }
+  //! \group for_each_collect
+  template <class Range, class F>
+  inline auto for_each_collect(const Range &range, F &&f, size_t threads = 0) -> decltype(for_each_collect(std::begin(range), std::end(range), std::forward<F>(f), threads))
+  {
+    return for_each_collect(std::begin(range), std::end(range), std::forward<F>(f), threads);
+  }
+}  // namespace parallel
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
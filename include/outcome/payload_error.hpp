@@ -0,0 +1,391 @@
+/* Rich error payloads kept in a monotonic arena rather than on the heap
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_PAYLOAD_ERROR_HPP
+#define OUTCOME_PAYLOAD_ERROR_HPP
+
+#include "result.hpp"
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <string>
+#include <system_error>
+
+#if defined(__has_include)
+#if __has_include(<version>)
+#include <version>
+#endif
+#endif
+#ifdef __cpp_lib_string_view
+#include <string_view>
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+/*! A monotonic arena from which `payload_error` takes the storage for its payloads. Allocation
+only bumps a pointer, and nothing is freed until `reset()` frees everything at once, which is
+meant to happen at request boundaries, see `payload_arena_scope`. Once the arena is exhausted
+further payloads are dropped rather than allocated elsewhere, and counted by `dropped()`.
+
+An arena is not thread safe, each thread normally uses its own, see `this_thread()`.
+*/
+class payload_arena
+{
+  char *_begin{nullptr}, *_end{nullptr}, *_next{nullptr};
+  char *_owned{nullptr};
+  uint32_t _generation{1};
+  size_t _dropped{0};
+
+  static payload_arena *&_current() noexcept
+  {
+    static thread_local payload_arena *v;
+    return v;
+  }
+  friend class payload_arena_scope;
+
+public:
+  //! The size of the arena each thread has by default.
+  static constexpr size_t default_size = 16384;
+
+  //! Constructs an arena owning `bytes` of storage, allocated once now.
+  explicit payload_arena(size_t bytes = default_size)
+      : _begin(new char[bytes])
+      , _end(_begin + bytes)
+      , _next(_begin)
+      , _owned(_begin)
+  {
+  }
+  //! Constructs an arena using `bytes` of caller supplied storage at `buffer`, which must outlive it.
+  payload_arena(void *buffer, size_t bytes) noexcept
+      : _begin(static_cast<char *>(buffer))
+      , _end(_begin + bytes)
+      , _next(_begin)
+  {
+  }
+  payload_arena(const payload_arena &) = delete;
+  payload_arena &operator=(const payload_arena &) = delete;
+  ~payload_arena() { delete[] _owned; }
+
+  //! The arena of the calling thread, used by `payload_error` unless a `payload_arena_scope` says otherwise.
+  static payload_arena &this_thread()
+  {
+    static thread_local payload_arena v;
+    return v;
+  }
+  //! The arena new payloads on the calling thread are allocated from.
+  static payload_arena &current()
+  {
+    payload_arena *v = _current();
+    return (v != nullptr) ? *v : this_thread();
+  }
+
+  /*! Allocates `bytes` aligned to `align`, which must be a power of two.
+  \returns The storage, or null if the arena is exhausted.
+  */
+  void *allocate(size_t bytes, size_t align = alignof(std::max_align_t)) noexcept
+  {
+    const uintptr_t addr = (reinterpret_cast<uintptr_t>(_next) + align - 1) & ~static_cast<uintptr_t>(align - 1);  // NOLINT
+    char *p = _next + (addr - reinterpret_cast<uintptr_t>(_next));                                                // NOLINT
+    if(p > _end || static_cast<size_t>(_end - p) < bytes)
+    {
+      ++_dropped;
+      return nullptr;
+    }
+    _next = p + bytes;
+    return p;
+  }
+  /*! Frees everything allocated, after which the payloads of existing `payload_error`s read as empty.
+  */
+  void reset() noexcept
+  {
+    _next = _begin;
+    _generation = (_generation == UINT32_MAX) ? 1 : _generation + 1;
+  }
+
+  //! Incremented by each `reset()`, so payloads can tell if they have been freed.
+  uint32_t generation() const noexcept { return _generation; }
+  //! The bytes allocated since the last `reset()`.
+  size_t used() const noexcept { return static_cast<size_t>(_next - _begin); }
+  //! The bytes the arena can hold.
+  size_t capacity() const noexcept { return static_cast<size_t>(_end - _begin); }
+  //! How many allocations have not fitted, since construction.
+  size_t dropped() const noexcept { return _dropped; }
+};
+
+/*! Scopes a request on the calling thread. Whilst it exists new payloads are allocated from its
+arena, and its destruction resets that arena and restores the arena previously in use.
+*/
+class payload_arena_scope
+{
+  payload_arena &_arena;
+  payload_arena *_previous;
+
+public:
+  //! Makes `arena` the calling thread's arena until destruction, which defaults to `payload_arena::this_thread()`.
+  explicit payload_arena_scope(payload_arena &arena = payload_arena::this_thread()) noexcept
+      : _arena(arena)
+      , _previous(payload_arena::_current())
+  {
+    payload_arena::_current() = &_arena;
+  }
+  payload_arena_scope(const payload_arena_scope &) = delete;
+  payload_arena_scope &operator=(const payload_arena_scope &) = delete;
+  ~payload_arena_scope()
+  {
+    _arena.reset();
+    payload_arena::_current() = _previous;
+  }
+};
+
+//! Some text of a `payload_error` payload, which lives in its arena.
+class payload_error_text
+{
+  const char *_data{""};
+  size_t _size{0};
+
+public:
+  constexpr payload_error_text() noexcept {}  // NOLINT
+  constexpr payload_error_text(const char *data, size_t size) noexcept
+      : _data(data)
+      , _size(size)
+  {
+  }
+  //! The text, which is always zero terminated.
+  constexpr const char *data() const noexcept { return _data; }
+  constexpr size_t size() const noexcept { return _size; }
+  constexpr bool empty() const noexcept { return _size == 0; }
+  //! A copy of the text, which allocates.
+  std::string str() const { return std::string(_data, _size); }
+#ifdef __cpp_lib_string_view
+  constexpr operator std::string_view() const noexcept { return {_data, _size}; }  // NOLINT
+#endif
+  friend bool operator==(const payload_error_text &a, const char *b) noexcept { return a._size == strlen(b) && memcmp(a._data, b, a._size) == 0; }
+  friend bool operator!=(const payload_error_text &a, const char *b) noexcept { return !(a == b); }
+};
+
+namespace detail
+{
+  struct payload_error_context
+  {
+    payload_error_text key, value;
+    payload_error_context *next;
+  };
+  struct payload_error_record
+  {
+    payload_error_text message;
+    payload_error_context *first, *last;
+    size_t count;
+  };
+  // Copies text into the arena with a zero terminator, or returns empty text if it does not fit
+  inline payload_error_text payload_error_copy(payload_arena &arena, const char *data, size_t size) noexcept
+  {
+    auto *p = static_cast<char *>(arena.allocate(size + 1, 1));
+    if(p == nullptr)
+    {
+      return {};
+    }
+    memcpy(p, data, size);
+    p[size] = 0;
+    return {p, size};
+  }
+  inline std::error_code payload_error_code(const std::error_code &ec) noexcept { return ec; }
+  template <class E> inline auto payload_error_code(const E &e) -> decltype(make_error_code(e)) { return make_error_code(e); }
+}  // namespace detail
+
+/*! An error code `E` plus a payload of a message and key/value context, for example the paths
+involved in a failed file copy. The payload lives in the calling thread's current `payload_arena`,
+so a failure does not allocate from the heap, and it reads as empty after that arena is reset.
+The payload is allocated on first use, and if the arena is exhausted it is dropped.
+
+Copies share the payload, adding context through one adds it to all. The arena must outlive any
+error whose payload is read, which is always so for the default per thread arena.
+
+`make_error_code()` returns the code as a `std::error_code`, so `result<T, payload_error<>>`
+has the default policy of `result<T, std::error_code>`, throwing a `std::system_error` whose
+`what()` includes the message.
+
+\tparam E The error code, `std::error_code` or a type with an ADL discovered `make_error_code()`.
+*/
+template <class E = std::error_code> class payload_error
+{
+  E _code{};
+  payload_arena *_arena{nullptr};
+  detail::payload_error_record *_record{nullptr};
+  uint32_t _generation{0};
+
+  const detail::payload_error_record *_live() const noexcept { return (_record != nullptr && _arena->generation() == _generation) ? _record : nullptr; }
+  detail::payload_error_record *_live_or_new()
+  {
+    if(_live() != nullptr)
+    {
+      return _record;
+    }
+    payload_arena &arena = payload_arena::current();
+    void *p = arena.allocate(sizeof(detail::payload_error_record), alignof(detail::payload_error_record));
+    if(p == nullptr)
+    {
+      return nullptr;
+    }
+    _arena = &arena;
+    _generation = arena.generation();
+    _record = new(p) detail::payload_error_record{{}, nullptr, nullptr, 0};
+    return _record;
+  }
+
+public:
+  //! The error code type.
+  using code_type = E;
+
+  //! Default constructs the code, without a payload.
+  payload_error() = default;
+  //! Constructs from a code, without a payload.
+  payload_error(E code) noexcept(std::is_nothrow_move_constructible<E>::value)  // NOLINT
+      : _code(static_cast<E &&>(code))
+  {
+  }
+  //! Constructs from a code and a message of `size` chars.
+  payload_error(E code, const char *message, size_t size)
+      : _code(static_cast<E &&>(code))
+  {
+    if(detail::payload_error_record *record = _live_or_new())
+    {
+      record->message = detail::payload_error_copy(*_arena, message, size);
+    }
+  }
+  //! Constructs from a code and a zero terminated message.
+  payload_error(E code, const char *message)
+      : payload_error(static_cast<E &&>(code), message, strlen(message))
+  {
+  }
+  //! Constructs from a code and a message.
+  payload_error(E code, const std::string &message)
+      : payload_error(static_cast<E &&>(code), message.data(), message.size())
+  {
+  }
+
+  /*! Adds a key and a value of `size` chars to the context, both copied into the arena.
+  \returns `*this`, so additions may be chained.
+  */
+  payload_error &with(const char *key, const char *value, size_t size)
+  {
+    detail::payload_error_record *record = _live_or_new();
+    if(record == nullptr)
+    {
+      return *this;
+    }
+    auto *p = _arena->allocate(sizeof(detail::payload_error_context), alignof(detail::payload_error_context));
+    if(p == nullptr)
+    {
+      return *this;
+    }
+    auto *context = new(p) detail::payload_error_context{detail::payload_error_copy(*_arena, key, strlen(key)), detail::payload_error_copy(*_arena, value, size), nullptr};
+    if(record->last != nullptr)
+    {
+      record->last->next = context;
+    }
+    else
+    {
+      record->first = context;
+    }
+    record->last = context;
+    ++record->count;
+    return *this;
+  }
+  //! \group with
+  payload_error &with(const char *key, const char *value) { return with(key, value, strlen(value)); }
+  //! \group with
+  payload_error &with(const char *key, const std::string &value) { return with(key, value.data(), value.size()); }
+  //! \group with
+  OUTCOME_TEMPLATE(class T)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_integral<T>::value && !std::is_same<T, bool>::value && !std::is_same<T, char>::value))
+  payload_error &with(const char *key, T value)
+  {
+    char buffer[24];
+    const int length = std::is_signed<T>::value ? snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(value)) : snprintf(buffer, sizeof(buffer), "%llu", static_cast<unsigned long long>(value));
+    return with(key, buffer, static_cast<size_t>(length));
+  }
+
+  //! The error code.
+  const E &code() const noexcept { return _code; }
+  //! True if there is a payload which has not been freed.
+  bool has_payload() const noexcept { return _live() != nullptr; }
+  //! The message, empty if none or freed.
+  payload_error_text message() const noexcept
+  {
+    const detail::payload_error_record *record = _live();
+    return (record != nullptr) ? record->message : payload_error_text();
+  }
+  //! The number of key/value items of context, zero if freed.
+  size_t context_size() const noexcept
+  {
+    const detail::payload_error_record *record = _live();
+    return (record != nullptr) ? record->count : 0;
+  }
+  //! The value of the first context item with `key`, empty if none or freed.
+  payload_error_text context(const char *key) const noexcept
+  {
+    const detail::payload_error_record *record = _live();
+    for(const detail::payload_error_context *i = (record != nullptr) ? record->first : nullptr; i != nullptr; i = i->next)
+    {
+      if(i->key == key)
+      {
+        return i->value;
+      }
+    }
+    return {};
+  }
+  //! Calls `f(key, value)` with each item of context in the order added, as `payload_error_text`.
+  template <class F> void for_each_context(F &&f) const
+  {
+    const detail::payload_error_record *record = _live();
+    for(const detail::payload_error_context *i = (record != nullptr) ? record->first : nullptr; i != nullptr; i = i->next)
+    {
+      f(i->key, i->value);
+    }
+  }
+
+  //! Errors compare by their code alone.
+  friend bool operator==(const payload_error &a, const payload_error &b) noexcept(noexcept(a._code == b._code)) { return a._code == b._code; }
+  friend bool operator!=(const payload_error &a, const payload_error &b) noexcept(noexcept(a._code == b._code)) { return !(a._code == b._code); }
+};
+
+//! The code of a `payload_error` as a `std::error_code`, which makes `payload_error` an error code type.
+template <class E> inline std::error_code make_error_code(const payload_error<E> &e) noexcept(noexcept(detail::payload_error_code(e.code()))) { return detail::payload_error_code(e.code()); }
+
+//! Throws a `std::system_error` of the code, with the message as its description if there is one.
+template <class E> inline void throw_as_system_error_with_payload(const payload_error<E> &e)
+{
+  const payload_error_text message = e.message();
+  if(message.empty())
+  {
+    OUTCOME_THROW_EXCEPTION(std::system_error(make_error_code(e)));
+  }
+  OUTCOME_THROW_EXCEPTION(std::system_error(make_error_code(e), message.data()));
+}
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,190 @@
+/* Counters sharded per CPU, incremented without atomics through restartable sequences
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_PERCPU_COUNTERS_HPP
+#define OUTCOME_PERCPU_COUNTERS_HPP
+
+#include "config.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#if defined(__linux__) && defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && defined(__has_include)
+#if __has_include(<sys/rseq.h>)
+#include <sys/rseq.h>
+#include <unistd.h>
+#ifdef RSEQ_SIG
+//! Defined to 1 if `percpu_counters` can count through restartable sequences on this platform, when the kernel allows.
+#define OUTCOME_HAVE_RSEQ 1
+#endif
+#endif
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+#ifdef OUTCOME_HAVE_RSEQ
+#define OUTCOME_RSEQ_STRINGIZE2(x) #x
+#define OUTCOME_RSEQ_STRINGIZE(x) OUTCOME_RSEQ_STRINGIZE2(x)
+  // The restartable sequence area which the C library registered for the calling thread, or null
+  inline struct rseq *percpu_rseq() noexcept
+  {
+    if(__rseq_size == 0)
+    {
+      return nullptr;
+    }
+    return reinterpret_cast<struct rseq *>(static_cast<char *>(__builtin_thread_pointer()) + __rseq_offset);  // NOLINT
+  }
+  inline size_t percpu_cpus() noexcept
+  {
+    const long ret = sysconf(_SC_NPROCESSORS_CONF);
+    return (percpu_rseq() == nullptr || ret <= 0) ? 0 : static_cast<size_t>(ret);
+  }
+  /* Adds `v` to the counter at `p + cpu * stride` bytes, where `cpu` is the CPU running the calling
+  thread, as a restartable sequence. If the thread is preempted, migrated or signalled before the add
+  commits, the kernel restarts it from the top, so the add is a plain one and never a locked one.
+  Returns false without adding if the thread's CPU is unknown or not below `cpus`.
+
+  The descriptor and abort handler are put in sections of the same group as the function's code, so
+  the linker keeps or discards them together when the function is emitted in more than one object.
+  */
+  inline bool percpu_add(struct rseq *rs, std::atomic<uint64_t> *p, size_t stride, size_t cpus, uint64_t v) noexcept
+  {
+  restart:
+    __asm__ __volatile__ goto(".pushsection __rseq_cs, \"aw?\"\n\t"
+                              ".balign 32\n\t"
+                              "3:\n\t"
+                              ".long 0x0, 0x0\n\t"
+                              ".quad 1f, (2f - 1f), 4f\n\t"
+                              ".popsection\n\t"
+                              "leaq 3b(%%rip), %%rax\n\t"
+                              "movq %%rax, %[rseq_cs]\n\t"
+                              "1:\n\t"
+                              "movl %[cpu_id], %%eax\n\t"
+                              "cmpq %[cpus], %%rax\n\t"
+                              "jae %l[unavailable]\n\t"
+                              "imulq %[stride], %%rax\n\t"
+                              "addq %[v], (%[p], %%rax)\n\t"
+                              "2:\n\t"
+                              ".pushsection __rseq_failure, \"ax?\"\n\t"
+                              ".byte 0x0f, 0xb9, 0x3d\n\t"
+                              ".long " OUTCOME_RSEQ_STRINGIZE(RSEQ_SIG) "\n\t"
+                              "4:\n\t"
+                              "jmp %l[restart]\n\t"
+                              ".popsection\n\t"
+                              :
+                              : [rseq_cs] "m"(rs->rseq_cs), [cpu_id] "m"(rs->cpu_id), [cpus] "r"(cpus), [stride] "r"(stride), [p] "r"(p), [v] "r"(v)
+                              : "memory", "cc", "rax"
+                              : restart, unavailable);
+    return true;
+  unavailable:
+    return false;
+  }
+#undef OUTCOME_RSEQ_STRINGIZE
+#undef OUTCOME_RSEQ_STRINGIZE2
+#else
+  inline size_t percpu_cpus() noexcept { return 0; }
+#endif
+}  // namespace detail
+
+/*! `N` counters kept once per CPU rather than once per thread, so that their memory grows with the
+cores of the machine and not with its threads, and summing them visits each core once. On Linux on
+x86-64 with a C library which registers restartable sequences, as glibc does from 2.35, `add()` is
+a plain add to the counters of the CPU running the calling thread, which the kernel restarts if the
+thread is preempted or migrated part way through, so no atomic instruction is used.
+
+Where restartable sequences are unavailable, `add()` returns false and counts nothing, for the
+caller to count some other way, such as in counters of its own thread. `error_counters` and
+`try_counters` do this when `OUTCOME_ENABLE_PERCPU_COUNTERS` is defined.
+
+Each CPU's counters start on their own cache line. Any thread may read them at any time, seeing
+each counter at some recent value.
+*/
+template <size_t N> class percpu_counters
+{
+  static_assert(N > 0, "percpu_counters needs at least one counter");
+  // Counters per CPU, rounded up to whole cache lines
+  static constexpr size_t _stride = (N + 7) / 8 * 8;
+
+  size_t _cpus;
+  std::unique_ptr<std::atomic<uint64_t>[]> _storage;
+  std::atomic<uint64_t> *_counters{nullptr};
+
+public:
+  //! Allocates the counters of every CPU configured, or nothing if they cannot be counted.
+  percpu_counters()
+      : _cpus(detail::percpu_cpus())
+  {
+    if(_cpus > 0)
+    {
+      _storage.reset(new std::atomic<uint64_t>[_cpus * _stride + 8]());
+      const uintptr_t addr = reinterpret_cast<uintptr_t>(_storage.get());  // NOLINT
+      _counters = _storage.get() + ((64 - addr % 64) % 64) / sizeof(uint64_t);
+    }
+  }
+  percpu_counters(const percpu_counters &) = delete;
+  percpu_counters &operator=(const percpu_counters &) = delete;
+
+  //! The number of counters per CPU.
+  static constexpr size_t size() noexcept { return N; }
+  //! The number of CPUs counted, zero if restartable sequences are unavailable.
+  size_t cpus() const noexcept { return _cpus; }
+
+  /*! Adds `v` to counter `idx` of the CPU running the calling thread.
+  \returns False if nothing was added, because the calling thread cannot count through a
+  restartable sequence or runs on a CPU not present at construction.
+  */
+  bool add(size_t idx, uint64_t v = 1) noexcept
+  {
+#ifdef OUTCOME_HAVE_RSEQ
+    if(OUTCOME_LIKELY(_cpus > 0))
+    {
+      return detail::percpu_add(detail::percpu_rseq(), _counters + idx, _stride * sizeof(uint64_t), _cpus, v);
+    }
+#else
+    (void) idx;
+    (void) v;
+#endif
+    return false;
+  }
+  //! Counter `idx` of CPU `cpu`.
+  uint64_t read(size_t cpu, size_t idx) const noexcept { return _counters[cpu * _stride + idx].load(std::memory_order_relaxed); }
+  //! The sum of counter `idx` over every CPU.
+  uint64_t sum(size_t idx) const noexcept
+  {
+    uint64_t ret = 0;
+    for(size_t cpu = 0; cpu < _cpus; cpu++)
+    {
+      ret += read(cpu, idx);
+    }
+    return ret;
+  }
+};
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
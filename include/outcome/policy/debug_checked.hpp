@@ -0,0 +1,114 @@
+/* Policies for result and outcome
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_POLICY_DEBUG_CHECKED_HPP
+#define OUTCOME_POLICY_DEBUG_CHECKED_HPP
+
+#include "detail/common.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+
+//! Whether `policy::debug_checked` checks state, by default unless `NDEBUG` is defined.
+#ifndef OUTCOME_DEBUG_CHECKED
+#ifdef NDEBUG
+#define OUTCOME_DEBUG_CHECKED 0
+#else
+#define OUTCOME_DEBUG_CHECKED 1
+#endif
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace policy
+{
+  namespace detail
+  {
+    QUICKCPPLIB_NORETURN OUTCOME_COLD inline void debug_checked_failed(const char *what) noexcept
+    {
+      fprintf(stderr, "FATAL: Outcome wide check failed with policy::debug_checked: %s\n", what);  // NOLINT
+      abort();
+    }
+  }  // namespace detail
+
+  /*! Policy which checks wide state access in debug builds, and assumes it valid in release builds.
+
+  With `OUTCOME_DEBUG_CHECKED` true, by default unless `NDEBUG` is defined, a wide attempt to access
+  state where there is none prints which state was wanted and aborts the process. Otherwise the
+  state is assumed present with `OUTCOME_ASSUME()`, so the optimiser drops the check as with
+  `all_narrow`, and may also specialise the code which follows on the state being known.
+
+  Can be used in both `result` and `outcome`.
+  */
+  struct debug_checked : detail::base
+  {
+    /*! Performs a wide check of state, used in the value() functions.
+    \effects If checking and there is no value, aborts with a diagnostic, else none.
+    */
+    template <class Impl> static constexpr void wide_value_check(Impl &&self) noexcept
+    {
+#if OUTCOME_DEBUG_CHECKED
+      if(OUTCOME_UNLIKELY((self._state.status() & OUTCOME_V2_NAMESPACE::detail::status_have_value) == 0))
+      {
+        detail::debug_checked_failed("no value");
+      }
+#else
+      OUTCOME_ASSUME((self._state.status() & OUTCOME_V2_NAMESPACE::detail::status_have_value) != 0);
+#endif
+    }
+    /*! Performs a wide check of state, used in the error() functions.
+    \effects If checking and there is no error, aborts with a diagnostic, else none.
+    */
+    template <class Impl> static constexpr void wide_error_check(Impl &&self) noexcept
+    {
+#if OUTCOME_DEBUG_CHECKED
+      if(OUTCOME_UNLIKELY((self._state.status() & OUTCOME_V2_NAMESPACE::detail::status_have_error) == 0))
+      {
+        detail::debug_checked_failed("no error");
+      }
+#else
+      OUTCOME_ASSUME((self._state.status() & OUTCOME_V2_NAMESPACE::detail::status_have_error) != 0);
+#endif
+    }
+    /*! Performs a wide check of state, used in the exception() functions.
+    \effects If checking and there is no exception, aborts with a diagnostic, else none.
+    */
+    template <class Impl> static constexpr void wide_exception_check(Impl &&self) noexcept
+    {
+#if OUTCOME_DEBUG_CHECKED
+      if(OUTCOME_UNLIKELY((self._state.status() & OUTCOME_V2_NAMESPACE::detail::status_have_exception) == 0))
+      {
+        detail::debug_checked_failed("no exception");
+      }
+#else
+      OUTCOME_ASSUME((self._state.status() & OUTCOME_V2_NAMESPACE::detail::status_have_exception) != 0);
+#endif
+    }
+  };
+}  // namespace policy
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
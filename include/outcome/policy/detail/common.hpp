@@ -25,9 +25,32 @@ http://www.boost.org/LICENSE_1_0.txt)
 #ifndef OUTCOME_POLICY_DETAIL_COMMON_HPP
 #define OUTCOME_POLICY_DETAIL_COMMON_HPP
 
-#include "../../config.hpp"
+#ifndef OUTCOME_RESULT_LITE
+#include "../../bad_access.hpp"
+#endif
+#include "../../success_failure.hpp"
 
 #include <cassert>
+#ifdef OUTCOME_RESULT_LITE
+#include <cstdlib>
+#else
+#include <exception>
+#include <system_error>
+#endif
+#if !defined(__cpp_exceptions) && !defined(OUTCOME_RESULT_LITE) && !defined(OUTCOME_DEVICE_COMPILE)
+#include "../../detail/value_storage.hpp"
+#include "../../interned_message.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+#endif
 
 OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
 
@@ -35,6 +58,177 @@ namespace policy
 {
   namespace detail
   {
+    /* The throwing and terminating paths of the policies, kept cold and out of line so that each
+    wide check inlined into a call site costs no more than a test and a call.
+    */
+#if defined(OUTCOME_DEVICE_COMPILE)
+    // Device code can neither throw nor call std::terminate(), so the kernel is trapped instead
+    QUICKCPPLIB_NORETURN OUTCOME_COLD OUTCOME_HOST_DEVICE inline void call_terminate() noexcept
+    {
+#ifdef __CUDA_ARCH__
+      __trap();
+#else
+      __builtin_trap();
+#endif
+    }
+#elif defined(OUTCOME_RESULT_LITE)
+    QUICKCPPLIB_NORETURN OUTCOME_COLD OUTCOME_HOST_DEVICE inline void call_terminate() noexcept { std::abort(); }
+#endif
+#ifndef OUTCOME_RESULT_LITE
+#if defined(__cpp_exceptions) || defined(OUTCOME_DEVICE_COMPILE)
+    QUICKCPPLIB_NORETURN OUTCOME_COLD inline void throw_bad_result_access(const char *what) { OUTCOME_THROW_EXCEPTION(bad_result_access(what)); }
+    QUICKCPPLIB_NORETURN OUTCOME_COLD inline void throw_bad_outcome_access(const char *what) { OUTCOME_THROW_EXCEPTION(bad_outcome_access(what)); }
+    template <class EC, class Error> QUICKCPPLIB_NORETURN OUTCOME_COLD inline void throw_bad_result_access_with(Error &&error) { OUTCOME_THROW_EXCEPTION(bad_result_access_with<EC>(std::forward<Error>(error))); }
+#endif
+    // Returns if the ADL discovered throw_as_system_error_with_payload() chooses not to throw
+    template <class Error> OUTCOME_COLD inline void throw_as_system_error(Error &&error)
+    {
+      // ADL discovered
+      throw_as_system_error_with_payload(std::forward<Error>(error));
+    }
+#if defined(__cpp_exceptions) || defined(OUTCOME_DEVICE_COMPILE)
+    template <class Error> QUICKCPPLIB_NORETURN OUTCOME_COLD inline void throw_system_error(const Error &error) { OUTCOME_THROW_EXCEPTION(std::system_error(error)); }
+    // Exception holders which can throw what they hold themselves, such as exception_box, are asked to
+    template <class Exception> QUICKCPPLIB_NORETURN inline auto rethrow_exception_holder(Exception &&excpt, int /*unused*/) -> decltype(excpt.rethrow()) { excpt.rethrow(); }
+    template <class Exception> QUICKCPPLIB_NORETURN inline void rethrow_exception_holder(Exception &&excpt, ...) { std::rethrow_exception(policy::exception_ptr(std::forward<Exception>(excpt))); }
+    template <class Exception> QUICKCPPLIB_NORETURN OUTCOME_COLD inline void rethrow_exception_ptr(Exception &&excpt) { rethrow_exception_holder(std::forward<Exception>(excpt), 0); }
+#endif
+#ifndef OUTCOME_DEVICE_COMPILE
+    QUICKCPPLIB_NORETURN OUTCOME_COLD OUTCOME_HOST_DEVICE inline void call_terminate() noexcept { std::terminate(); }
+#endif
+#endif
+
+#if !defined(__cpp_exceptions) && !defined(OUTCOME_RESULT_LITE) && !defined(OUTCOME_DEVICE_COMPILE)
+    /* Without C++ exceptions, a failed wide check is reported on stderr before aborting, rather than
+    throwing or terminating without a word. The report is formatted into a fixed buffer per thread
+    and written with write(), so reporting neither allocates nor locks. The one exception is the
+    message of a code whose category is neither the generic nor the system category, which is
+    whatever that category's message() returns.
+    */
+    struct fatal_report
+    {
+      char *begin, *end, *p;
+
+      fatal_report() noexcept
+      {
+        static thread_local char buffer[512];
+        begin = p = buffer;
+        end = buffer + sizeof(buffer) - 1;  // room for the newline
+      }
+      void append(const char *data, size_t length) noexcept
+      {
+        length = std::min(length, static_cast<size_t>(end - p));
+        memcpy(p, data, length);
+        p += length;
+      }
+      void append(const char *s) noexcept { append(s, strlen(s)); }
+      void append(long long v) noexcept
+      {
+        char digits[24], *q = digits + sizeof(digits);
+        unsigned long long u = (v < 0) ? 0ULL - static_cast<unsigned long long>(v) : static_cast<unsigned long long>(v);
+        do
+        {
+          *--q = static_cast<char>('0' + u % 10);
+          u /= 10;
+        } while(u != 0);
+        if(v < 0)
+        {
+          *--q = '-';
+        }
+        append(q, static_cast<size_t>(digits + sizeof(digits) - q));
+      }
+      // Writes the report as one line, retrying partial and interrupted writes
+      void write() noexcept
+      {
+        *p++ = '\n';
+        for(const char *q = begin; q < p;)
+        {
+#ifdef _WIN32
+          const int written = ::_write(2, q, static_cast<unsigned>(p - q));
+#else
+          const ssize_t written = ::write(2, q, static_cast<size_t>(p - q));
+          if(written < 0 && errno == EINTR)
+          {
+            continue;
+          }
+#endif
+          if(written <= 0)
+          {
+            return;
+          }
+          q += written;
+        }
+      }
+    };
+    // strerror_r() returns an int in its POSIX form, and the message in its GNU form
+    inline const char *fatal_strerror(int /*unused*/, const char *buffer) noexcept { return buffer; }
+    inline const char *fatal_strerror(const char *message, const char * /*unused*/) noexcept { return message; }
+    inline void fatal_append_message(fatal_report &r, const std::error_code &ec) noexcept
+    {
+      char buffer[256] = "";
+#ifdef _WIN32
+      if(ec.category() == std::generic_category())
+      {
+        (void) strerror_s(buffer, sizeof(buffer), ec.value());
+        r.append(buffer);
+        return;
+      }
+#else
+      if(ec.category() == std::generic_category() || ec.category() == std::system_category())
+      {
+        r.append(fatal_strerror(strerror_r(ec.value(), buffer, sizeof(buffer)), buffer));
+        return;
+      }
+#endif
+      // Only the first report of a code asks its category, later ones reuse the interned text
+      const interned_text message = interned_message(ec);
+      r.append(message.data(), message.size());
+    }
+    //! Reports which state was wanted, the error code if any, and the error site if any, then aborts.
+    QUICKCPPLIB_NORETURN OUTCOME_COLD inline void fatal_exit(const char *what, const std::error_code *ec, unsigned site) noexcept
+    {
+      fatal_report r;
+      r.append("FATAL: Outcome wide check failed with exceptions disabled: ");
+      r.append(what);
+      if(ec != nullptr)
+      {
+        r.append(", error ");
+        r.append(ec->category().name());
+        r.append(":");
+        r.append(static_cast<long long>(ec->value()));
+        r.append(" (");
+        fatal_append_message(r, *ec);
+        r.append(")");
+      }
+      if(site != 0)
+      {
+        r.append(", error site ");
+        r.append(static_cast<long long>(site));
+      }
+      r.write();
+      abort();
+    }
+    template <class Error> inline bool fatal_error_code(const Error &error, std::error_code &ec, std::true_type /*unused*/)
+    {
+      ec = policy::error_code(error);
+      return true;
+    }
+    template <class Error> inline bool fatal_error_code(const Error & /*unused*/, std::error_code & /*unused*/, std::false_type /*unused*/) { return false; }
+    template <class Error> QUICKCPPLIB_NORETURN OUTCOME_COLD inline void fatal_exit_with(const char *what, const Error &error, unsigned site) noexcept
+    {
+      std::error_code ec;
+      const bool has_code = fatal_error_code(error, ec, std::integral_constant<bool, trait::has_error_code_v<Error>>());
+      fatal_exit(what, has_code ? &ec : nullptr, site);
+    }
+
+    // Without C++ exceptions, what would be thrown is reported instead
+    QUICKCPPLIB_NORETURN OUTCOME_COLD inline void throw_bad_result_access(const char *what) { fatal_exit(what, nullptr, 0); }
+    QUICKCPPLIB_NORETURN OUTCOME_COLD inline void throw_bad_outcome_access(const char *what) { fatal_exit(what, nullptr, 0); }
+    template <class EC, class Error> QUICKCPPLIB_NORETURN OUTCOME_COLD inline void throw_bad_result_access_with(Error &&error) { fatal_exit_with("no value", error, 0); }
+    template <class Error> QUICKCPPLIB_NORETURN OUTCOME_COLD inline void throw_system_error(const Error &error) { fatal_exit_with("no value", error, 0); }
+    template <class Exception> QUICKCPPLIB_NORETURN OUTCOME_COLD inline void rethrow_exception_ptr(Exception && /*unused*/) { fatal_exit("no value, has an exception", nullptr, 0); }
+#endif
+
     struct base
     {
     private:
@@ -53,13 +247,44 @@ namespace policy
 #endif
       }
 
+    protected:
+#if !defined(__cpp_exceptions) && !defined(OUTCOME_RESULT_LITE) && !defined(OUTCOME_DEVICE_COMPILE)
+      // The id of the error site kept in the spare storage of a result, see error_site.hpp
+      template <class Impl> static unsigned _error_site(const Impl &self) noexcept
+      {
+#ifndef OUTCOME_ENABLE_COMPACT_STATUS
+        return (self._state.status() & OUTCOME_V2_NAMESPACE::detail::status_2byte_mask) >> OUTCOME_V2_NAMESPACE::detail::status_2byte_shift;
+#else
+        (void) self;
+        return 0;
+#endif
+      }
+      // Reports the failed wide check of a result with its error and error site, if it has them
+      template <class Impl> QUICKCPPLIB_NORETURN OUTCOME_COLD static void _fatal_exit(const Impl &self, const char *what) noexcept
+      {
+        if((self._state.status() & OUTCOME_V2_NAMESPACE::detail::status_have_error) != 0)
+        {
+          fatal_exit_with(what, self._error_ref(), _error_site(self));
+        }
+        fatal_exit(what, nullptr, _error_site(self));
+      }
+      template <class Impl> QUICKCPPLIB_NORETURN OUTCOME_COLD static void _throw_as_system_error(Impl &&self) { _fatal_exit(self, "no value"); }
+      template <class Impl> QUICKCPPLIB_NORETURN OUTCOME_COLD OUTCOME_HOST_DEVICE static void _terminate(const Impl &self, const char *what) noexcept { _fatal_exit(self, what); }
+#else
+#ifndef OUTCOME_RESULT_LITE
+      // Returns if the ADL discovered throw_as_system_error_with_payload() chooses not to throw
+      template <class Impl> OUTCOME_COLD static void _throw_as_system_error(Impl &&self) { throw_as_system_error(std::forward<Impl>(self)._error_ref()); }
+#endif
+      template <class Impl> QUICKCPPLIB_NORETURN OUTCOME_COLD OUTCOME_HOST_DEVICE static void _terminate(const Impl & /*unused*/, const char * /*unused*/) noexcept { call_terminate(); }
+#endif
+
     public:
       /*! Performs a narrow check of state, used in the assume_value() functions.
       \effects None.
       */
       template <class Impl> static constexpr void narrow_value_check(Impl &&self) noexcept
       {
-        if((self._state._status & OUTCOME_V2_NAMESPACE::detail::status_have_value) == 0)
+        if(OUTCOME_UNLIKELY((self._state.status() & OUTCOME_V2_NAMESPACE::detail::status_have_value) == 0))
         {
           _ub(self);
         }
@@ -69,7 +294,7 @@ namespace policy
       */
       template <class Impl> static constexpr void narrow_error_check(Impl &&self) noexcept
       {
-        if((self._state._status & OUTCOME_V2_NAMESPACE::detail::status_have_error) == 0)
+        if(OUTCOME_UNLIKELY((self._state.status() & OUTCOME_V2_NAMESPACE::detail::status_have_error) == 0))
         {
           _ub(self);
         }
@@ -79,7 +304,7 @@ namespace policy
       */
       template <class Impl> static constexpr void narrow_exception_check(Impl &&self) noexcept
       {
-        if((self._state._status & OUTCOME_V2_NAMESPACE::detail::status_have_exception) == 0)
+        if(OUTCOME_UNLIKELY((self._state.status() & OUTCOME_V2_NAMESPACE::detail::status_have_exception) == 0))
         {
           _ub(self);
         }
@@ -0,0 +1,134 @@
+/* Policies for result and outcome
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_POLICY_HOOKS_HPP
+#define OUTCOME_POLICY_HOOKS_HPP
+
+#include "../config.hpp"
+
+#include <type_traits>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace policy
+{
+  /*! Hook policy whose hooks do nothing, used by every policy which does not name another.
+
+  A hook policy is a type with the static members below, which `result` and `outcome` call on
+  the same events as the ADL discovered hooks in namespace `hooks`. Unlike those, which hooks
+  are called is a property of the type, so instrumented and uninstrumented results can sit
+  side by side in one program. A hook policy is attached to a policy by `with_hooks<>`, or by
+  a policy declaring a `hook_policy` member type.
+  */
+  struct no_hooks
+  {
+    /*! True if `on_destruction()`, `on_copy_assignment()` and `on_move_assignment()` should be called.
+    If false, destruction and assignment stay trivial where they were.
+    */
+    static constexpr bool has_lifetime_hooks = false;
+
+    /*! Called when a `result` or `outcome` is first created by conversion from one of its possible types.
+    \param 1 The `result<...>` or `outcome<...>` being constructed.
+    \param 2 The source data.
+    */
+    template <class T, class U> static constexpr void on_construction(T * /*unused*/, U && /*unused*/) noexcept {}
+    /*! Called when a `result` or `outcome` is created by copying from a compatible `result` or `outcome`,
+    or if `has_lifetime_hooks` is true, from one of the same type.
+    \param 1 The `result<...>` or `outcome<...>` being constructed, or for same type copies its
+    `detail::result_final<...>` part.
+    \param 2 The source.
+    */
+    template <class T, class U> static constexpr void on_copy_construction(T * /*unused*/, U && /*unused*/) noexcept {}
+    /*! Called when a `result` or `outcome` is created by moving from a compatible `result` or `outcome`,
+    or if `has_lifetime_hooks` is true, from one of the same type.
+    \param 1 The `result<...>` or `outcome<...>` being constructed, or for same type moves its
+    `detail::result_final<...>` part.
+    \param 2 The source.
+    */
+    template <class T, class U> static constexpr void on_move_construction(T * /*unused*/, U && /*unused*/) noexcept {}
+    /*! Called when a `result` or `outcome` is created by in place construction.
+    \param 1 The `result<...>` or `outcome<...>` being constructed.
+    \param 2 The `in_place_type_t<>` of the type constructed, followed by the source data.
+    */
+    template <class T, class... Args> static constexpr void on_in_place_construction(T * /*unused*/, Args &&... /*unused*/) noexcept {}
+    /*! Called when a `result` or `outcome` is about to be destroyed, if `has_lifetime_hooks` is true.
+    \param 1 The `detail::result_final<...>` part being destroyed, which for an `outcome` is all that
+    remains of it.
+    */
+    template <class T> static void on_destruction(T * /*unused*/) noexcept {}
+    /*! Called when a `result` or `outcome` has been copy assigned, if `has_lifetime_hooks` is true.
+    \param 1 The `detail::result_final<...>` part assigned to.
+    \param 2 The `detail::result_final<...>` part of the source.
+    */
+    template <class T, class U> static void on_copy_assignment(T * /*unused*/, U && /*unused*/) noexcept {}
+    /*! Called when a `result` or `outcome` has been move assigned, if `has_lifetime_hooks` is true.
+    \param 1 The `detail::result_final<...>` part assigned to.
+    \param 2 The `detail::result_final<...>` part of the source.
+    */
+    template <class T, class U> static void on_move_assignment(T * /*unused*/, U && /*unused*/) noexcept {}
+  };
+
+  /*! Policy which is `Policy`, but calls the hooks of the hook policy `Hooks` (see `no_hooks`).
+
+  Can be used in both `result` and `outcome`.
+  */
+  template <class Policy, class Hooks> struct with_hooks : Policy
+  {
+    //! The policy extended.
+    using base_policy = Policy;
+    //! The hook policy.
+    using hook_policy = Hooks;
+  };
+}  // namespace policy
+
+namespace detail
+{
+  template <class...> using hooks_void_t = void;
+
+  // The hook policy of a policy, no_hooks unless it declares one
+  template <class Policy, class = void> struct policy_hooks
+  {
+    using type = policy::no_hooks;
+  };
+  template <class Policy> struct policy_hooks<Policy, hooks_void_t<typename Policy::hook_policy>>
+  {
+    using type = typename Policy::hook_policy;
+  };
+  template <class Policy> using policy_hooks_t = typename policy_hooks<Policy>::type;
+
+  // The policy with_hooks<> extends, which must be befriended as well as with_hooks<> itself
+  template <class Policy> struct unhooked_policy
+  {
+    using type = Policy;
+  };
+  template <class Policy, class Hooks> struct unhooked_policy<policy::with_hooks<Policy, Hooks>>
+  {
+    using type = Policy;
+  };
+}  // namespace detail
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,122 @@
+/* Policies for result and outcome
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_POLICY_LOG_AND_DEFAULT_HPP
+#define OUTCOME_POLICY_LOG_AND_DEFAULT_HPP
+
+#include "../bad_access_log.hpp"
+#include "detail/common.hpp"
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace policy
+{
+  namespace detail
+  {
+    template <class Impl> OUTCOME_COLD inline void log_bad_access(const char *what) noexcept { bad_access_log::global().push(OUTCOME_V2_NAMESPACE::detail::make_bad_access_record<std::decay_t<Impl>>(what)); }
+    template <class Impl, class Error> OUTCOME_COLD inline void log_bad_access(const char *what, const Error &error) noexcept
+    {
+      bad_access_record r = OUTCOME_V2_NAMESPACE::detail::make_bad_access_record<std::decay_t<Impl>>(what);
+      OUTCOME_V2_NAMESPACE::detail::bad_access_record_error(r, error);
+      bad_access_log::global().push(r);
+    }
+    // Reset on each use, as the caller may have modified or moved from the last one returned
+    template <class T> inline T &default_fallback() noexcept
+    {
+      static_assert(std::is_default_constructible<T>::value && std::is_move_assignable<T>::value, "policy::log_and_default requires default constructible and move assignable state");
+      static thread_local T v;
+      v = T();
+      return v;
+    }
+  }  // namespace detail
+
+  /*! Policy which never throws nor terminates. A wide attempt to access state where there is none
+  pushes a `bad_access_record` onto `bad_access_log::global()`, and the wide observer returns a
+  default constructed instance of the state's type instead.
+
+  The failure path neither allocates nor locks: the record is a few words pushed onto a lock free
+  queue, and records are formatted later by whoever drains the log, usually a `bad_access_drainer`.
+  The default returned is thread local, and is constructed afresh by each failing access, so
+  it remains valid until the same thread next fails an access.
+
+  Can be used in both `result` and `outcome`.
+  */
+  struct log_and_default : detail::base
+  {
+    /*! Performs a wide check of state, used in the value() functions.
+    \effects If result does not have a value, logs the access and any error code held.
+    */
+    template <class Impl> static constexpr void wide_value_check(Impl &&self) noexcept
+    {
+      if(OUTCOME_UNLIKELY((self._state.status() & OUTCOME_V2_NAMESPACE::detail::status_have_value) == 0))
+      {
+        if((self._state.status() & OUTCOME_V2_NAMESPACE::detail::status_have_error) != 0)
+        {
+          detail::log_bad_access<Impl>("no value", self._error_ref());
+        }
+        else
+        {
+          detail::log_bad_access<Impl>("no value");
+        }
+      }
+    }
+    /*! Performs a wide check of state, used in the error() functions.
+    \effects If result does not have an error, logs the access.
+    */
+    template <class Impl> static constexpr void wide_error_check(Impl &&self) noexcept
+    {
+      if(OUTCOME_UNLIKELY((self._state.status() & OUTCOME_V2_NAMESPACE::detail::status_have_error) == 0))
+      {
+        detail::log_bad_access<Impl>("no error");
+      }
+    }
+    /*! Performs a wide check of state, used in the exception() functions.
+    \effects If outcome does not have an exception, logs the access and any error code held.
+    */
+    template <class Impl> static constexpr void wide_exception_check(Impl &&self) noexcept
+    {
+      if(OUTCOME_UNLIKELY((self._state.status() & OUTCOME_V2_NAMESPACE::detail::status_have_exception) == 0))
+      {
+        if((self._state.status() & OUTCOME_V2_NAMESPACE::detail::status_have_error) != 0)
+        {
+          detail::log_bad_access<Impl>("no exception", self._error_ref());
+        }
+        else
+        {
+          detail::log_bad_access<Impl>("no exception");
+        }
+      }
+    }
+    //! The value returned by the value() functions when there is none.
+    template <class T> static T &wide_value_fallback() noexcept { return detail::default_fallback<T>(); }
+    //! The error returned by the error() functions when there is none.
+    template <class T> static T &wide_error_fallback() noexcept { return detail::default_fallback<T>(); }
+    //! The exception returned by the exception() functions when there is none.
+    template <class T> static T &wide_exception_fallback() noexcept { return detail::default_fallback<T>(); }
+  };
+}  // namespace policy
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -43,7 +43,7 @@ namespace policy
     {
       template <class Exception> explicit rethrow_exception(Exception &&excpt)  // NOLINT
       {
-        std::rethrow_exception(policy::exception_ptr(std::forward<Exception>(excpt)));
+        rethrow_exception_ptr(std::forward<Exception>(excpt));
       }
     };
   }  // namespace detail
@@ -63,20 +63,19 @@ namespace policy
     */
     template <class Impl> static constexpr void wide_value_check(Impl &&self)
     {
-      if((self._state._status & OUTCOME_V2_NAMESPACE::detail::status_have_value) == 0)
+      if(OUTCOME_UNLIKELY((self._state.status() & OUTCOME_V2_NAMESPACE::detail::status_have_value) == 0))
       {
-        if((self._state._status & OUTCOME_V2_NAMESPACE::detail::status_have_exception) != 0)
+        if((self._state.status() & OUTCOME_V2_NAMESPACE::detail::status_have_exception) != 0)
         {
-          using Outcome = OUTCOME_V2_NAMESPACE::detail::rebind_type<outcome<T, EC, E, error_code_throw_as_system_error>, decltype(self)>;
+          using Outcome = OUTCOME_V2_NAMESPACE::detail::rebind_type<outcome<T, EC, E, typename std::decay_t<Impl>::_no_value_policy_type>, decltype(self)>;
           Outcome _self = static_cast<Outcome>(self);  // NOLINT
           detail::rethrow_exception<trait::has_exception_ptr_v<E>>{std::forward<Outcome>(_self)._ptr};
         }
-        if((self._state._status & OUTCOME_V2_NAMESPACE::detail::status_have_error) != 0)
+        if((self._state.status() & OUTCOME_V2_NAMESPACE::detail::status_have_error) != 0)
         {
-          // ADL discovered
-          throw_as_system_error_with_payload(std::forward<Impl>(self)._error);
+          _throw_as_system_error(std::forward<Impl>(self));
         }
-        OUTCOME_THROW_EXCEPTION(bad_outcome_access("no value"));
+        detail::throw_bad_outcome_access("no value");
       }
     }
     /*! Performs a wide check of state, used in the error() functions
@@ -84,9 +83,9 @@ namespace policy
     */
     template <class Impl> static constexpr void wide_error_check(Impl &&self)
     {
-      if((self._state._status & OUTCOME_V2_NAMESPACE::detail::status_have_error) == 0)
+      if(OUTCOME_UNLIKELY((self._state.status() & OUTCOME_V2_NAMESPACE::detail::status_have_error) == 0))
       {
-        OUTCOME_THROW_EXCEPTION(bad_outcome_access("no error"));
+        detail::throw_bad_outcome_access("no error");
       }
     }
     /*! Performs a wide check of state, used in the exception() functions
@@ -94,9 +93,9 @@ namespace policy
     */
     template <class Impl> static constexpr void wide_exception_check(Impl &&self)
     {
-      if((self._state._status & OUTCOME_V2_NAMESPACE::detail::status_have_exception) == 0)
+      if(OUTCOME_UNLIKELY((self._state.status() & OUTCOME_V2_NAMESPACE::detail::status_have_exception) == 0))
       {
-        OUTCOME_THROW_EXCEPTION(bad_outcome_access("no exception"));
+        detail::throw_bad_outcome_access("no exception");
       }
     }
   };
@@ -27,6 +27,8 @@ http://www.boost.org/LICENSE_1_0.txt)
 
 #include "result_exception_ptr_rethrow.hpp"
 
+#include "../utils.hpp"
+
 OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
 
 namespace policy
@@ -43,19 +45,19 @@ namespace policy
     */
     template <class Impl> static constexpr void wide_value_check(Impl &&self)
     {
-      if((self._state._status & OUTCOME_V2_NAMESPACE::detail::status_have_value) == 0)
+      if(OUTCOME_UNLIKELY((self._state.status() & OUTCOME_V2_NAMESPACE::detail::status_have_value) == 0))
       {
-        if((self._state._status & OUTCOME_V2_NAMESPACE::detail::status_have_exception) != 0)
+        if((self._state.status() & OUTCOME_V2_NAMESPACE::detail::status_have_exception) != 0)
         {
-          using Outcome = OUTCOME_V2_NAMESPACE::detail::rebind_type<outcome<T, EC, E, exception_ptr_rethrow>, decltype(self)>;
+          using Outcome = OUTCOME_V2_NAMESPACE::detail::rebind_type<outcome<T, EC, E, typename std::decay_t<Impl>::_no_value_policy_type>, decltype(self)>;
           Outcome _self = static_cast<Outcome>(self);  // NOLINT
           detail::rethrow_exception<trait::has_exception_ptr_v<E>>{std::forward<Outcome>(_self)._ptr};
         }
-        if((self._state._status & OUTCOME_V2_NAMESPACE::detail::status_have_error) != 0)
+        if((self._state.status() & OUTCOME_V2_NAMESPACE::detail::status_have_error) != 0)
         {
-          detail::rethrow_exception<trait::has_exception_ptr_v<EC>>{std::forward<Impl>(self)._error};
+          detail::rethrow_exception<trait::has_exception_ptr_v<EC>>{std::forward<Impl>(self)._error_ref()};
         }
-        OUTCOME_THROW_EXCEPTION(bad_outcome_access("no value"));
+        detail::throw_bad_outcome_access("no value");
       }
     }
     /*! Performs a wide check of state, used in the error() functions
@@ -63,9 +65,9 @@ namespace policy
     */
     template <class Impl> static constexpr void wide_error_check(Impl &&self)
     {
-      if((self._state._status & OUTCOME_V2_NAMESPACE::detail::status_have_error) == 0)
+      if(OUTCOME_UNLIKELY((self._state.status() & OUTCOME_V2_NAMESPACE::detail::status_have_error) == 0))
       {
-        OUTCOME_THROW_EXCEPTION(bad_outcome_access("no error"));
+        detail::throw_bad_outcome_access("no error");
       }
     }
     /*! Performs a wide check of state, used in the exception() functions
@@ -73,14 +75,30 @@ namespace policy
     */
     template <class Impl> static constexpr void wide_exception_check(Impl &&self)
     {
-      if((self._state._status & OUTCOME_V2_NAMESPACE::detail::status_have_exception) == 0)
+      if(OUTCOME_UNLIKELY((self._state.status() & OUTCOME_V2_NAMESPACE::detail::status_have_exception) == 0))
       {
-        OUTCOME_THROW_EXCEPTION(bad_outcome_access("no exception"));
+        detail::throw_bad_outcome_access("no exception");
       }
     }
   };
 }  // namespace policy
 
+#ifdef __cpp_exceptions
+/*! The error code equivalent to the exception of an outcome, found by `error_from_exception()`,
+so exceptions of types registered with `register_exception_error()` are matched without first
+rethrowing them out of `.value()`.
+\returns A null error code if `o` has no exception, the equivalent of its exception if matched,
+else `not_matched`.
+\requires `trait::has_exception_ptr_v<P>` to be true.
+*/
+template <class R, class S, class P, class NoValuePolicy>  //
+inline std::error_code error_from_exception(const outcome<R, S, P, NoValuePolicy> &o, std::error_code not_matched = std::make_error_code(std::errc::resource_unavailable_try_again)) noexcept
+{
+  static_assert(trait::has_exception_ptr_v<P>, "error_from_exception() requires an outcome whose exception type is an exception_ptr");
+  return o.has_exception() ? error_from_exception(policy::exception_ptr(o.assume_exception()), not_matched) : std::error_code();
+}
+#endif
+
 OUTCOME_V2_NAMESPACE_END
 
 #endif
@@ -49,14 +49,13 @@ namespace policy
     */
     template <class Impl> static constexpr void wide_value_check(Impl &&self)
     {
-      if((self._state._status & OUTCOME_V2_NAMESPACE::detail::status_have_value) == 0)
+      if(OUTCOME_UNLIKELY((self._state.status() & OUTCOME_V2_NAMESPACE::detail::status_have_value) == 0))
       {
-        if((self._state._status & OUTCOME_V2_NAMESPACE::detail::status_have_error) != 0)
+        if((self._state.status() & OUTCOME_V2_NAMESPACE::detail::status_have_error) != 0)
         {
-          // ADL discovered
-          throw_as_system_error_with_payload(std::forward<Impl>(self)._error);
+          _throw_as_system_error(std::forward<Impl>(self));
         }
-        OUTCOME_THROW_EXCEPTION(bad_result_access("no value"));
+        detail::throw_bad_result_access("no value");
       }
     }
     /*! Performs a wide check of state, used in the error() functions
@@ -64,9 +63,9 @@ namespace policy
     */
     template <class Impl> static constexpr void wide_error_check(Impl &&self)
     {
-      if((self._state._status & OUTCOME_V2_NAMESPACE::detail::status_have_error) == 0)
+      if(OUTCOME_UNLIKELY((self._state.status() & OUTCOME_V2_NAMESPACE::detail::status_have_error) == 0))
       {
-        OUTCOME_THROW_EXCEPTION(bad_result_access("no error"));
+        detail::throw_bad_result_access("no error");
       }
     }
   };
@@ -27,15 +27,14 @@ http://www.boost.org/LICENSE_1_0.txt)
 
 #include "detail/common.hpp"
 
-#include <system_error>
-
 OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
 
 namespace policy
 {
   /*! Policy implementing any wide attempt to access the successful state as calling `std::terminate`
 
-  Can be used in both `result` and `outcome`.
+  Can be used in both `result` and `outcome`. Without C++ exceptions, the state wanted, the error
+  code and the error site, where known, are written to stderr before aborting instead.
   */
   struct terminate : detail::base
   {
@@ -44,9 +43,9 @@ namespace policy
     */
     template <class Impl> static constexpr void wide_value_check(Impl &&self)
     {
-      if((self._state._status & OUTCOME_V2_NAMESPACE::detail::status_have_value) == 0)
+      if(OUTCOME_UNLIKELY((self._state.status() & OUTCOME_V2_NAMESPACE::detail::status_have_value) == 0))
       {
-        std::terminate();
+        _terminate(self, "no value");
       }
     }
     /*! Performs a wide check of state, used in the error() functions
@@ -54,9 +53,9 @@ namespace policy
     */
     template <class Impl> static constexpr void wide_error_check(Impl &&self) noexcept
     {
-      if((self._state._status & OUTCOME_V2_NAMESPACE::detail::status_have_error) == 0)
+      if(OUTCOME_UNLIKELY((self._state.status() & OUTCOME_V2_NAMESPACE::detail::status_have_error) == 0))
       {
-        std::terminate();
+        _terminate(self, "no error");
       }
     }
     /*! Performs a wide check of state, used in the exception() functions
@@ -64,9 +63,9 @@ namespace policy
     */
     template <class Impl> static constexpr void wide_exception_check(Impl &&self)
     {
-      if((self._state._status & OUTCOME_V2_NAMESPACE::detail::status_have_exception) == 0)
+      if(OUTCOME_UNLIKELY((self._state.status() & OUTCOME_V2_NAMESPACE::detail::status_have_exception) == 0))
       {
-        std::terminate();
+        _terminate(self, "no exception");
       }
     }
   };
@@ -43,9 +43,9 @@ namespace policy
     */
     template <class Impl> static constexpr void wide_value_check(Impl &&self)
     {
-      if((self._state._status & OUTCOME_V2_NAMESPACE::detail::status_have_value) == 0)
+      if(OUTCOME_UNLIKELY((self._state.status() & OUTCOME_V2_NAMESPACE::detail::status_have_value) == 0))
       {
-        OUTCOME_THROW_EXCEPTION(bad_result_access_with<EC>(std::forward<Impl>(self)._error));
+        detail::throw_bad_result_access_with<EC>(std::forward<Impl>(self)._error_ref());
       }
     }
     /*! Performs a wide check of state, used in the error() functions
@@ -53,9 +53,9 @@ namespace policy
     */
     template <class Impl> static constexpr void wide_error_check(Impl &&self)
     {
-      if((self._state._status & OUTCOME_V2_NAMESPACE::detail::status_have_error) == 0)
+      if(OUTCOME_UNLIKELY((self._state.status() & OUTCOME_V2_NAMESPACE::detail::status_have_error) == 0))
       {
-        OUTCOME_THROW_EXCEPTION(bad_result_access("no error"));
+        detail::throw_bad_result_access("no error");
       }
     }
     /*! Performs a wide check of state, used in the exception() functions
@@ -63,9 +63,9 @@ namespace policy
     */
     template <class Impl> static constexpr void wide_exception_check(Impl &&self)
     {
-      if((self._state._status & OUTCOME_V2_NAMESPACE::detail::status_have_exception) == 0)
+      if(OUTCOME_UNLIKELY((self._state.status() & OUTCOME_V2_NAMESPACE::detail::status_have_exception) == 0))
       {
-        OUTCOME_THROW_EXCEPTION(bad_outcome_access("no exception"));
+        detail::throw_bad_outcome_access("no exception");
       }
     }
   };
@@ -28,6 +28,8 @@ http://www.boost.org/LICENSE_1_0.txt)
 /// \file
 /// \output_name result_c
 
+#include <stddef.h>  // for size_t
+
 //! A C struct representation of `std::error_code`.
 struct cxx_error_code
 {
@@ -35,6 +37,22 @@ struct cxx_error_code
   void *category;
 };
 
+/*! A C struct representation of `std::error_code` which can be sent between processes, with the
+category as its stable identifier from `error_category_id()` in `category_registry.hpp`.
+*/
+struct cxx_portable_error_code
+{
+  int code;
+  unsigned category;
+};
+
+//! The C type of the status flags, which is smaller if `OUTCOME_ENABLE_COMPACT_STATUS` is defined.
+#ifdef OUTCOME_ENABLE_COMPACT_STATUS
+#define CXX_RESULT_FLAGS_TYPE unsigned char
+#else
+#define CXX_RESULT_FLAGS_TYPE unsigned
+#endif
+
 /*! Declares a C struct representation of `result<R, S>`.
 
 \param R The unique postfix for `struct result_##R##_##S`.
@@ -46,7 +64,7 @@ struct cxx_error_code
   struct result_##R##_##S                                                                                                                                                                                                                                                                                                      \
   {                                                                                                                                                                                                                                                                                                                            \
     RD value;                                                                                                                                                                                                                                                                                                                  \
-    unsigned flags;                                                                                                                                                                                                                                                                                                            \
+    CXX_RESULT_FLAGS_TYPE flags;                                                                                                                                                                                                                                                                                               \
     SD error;                                                                                                                                                                                                                                                                                                                  \
   }
 /*! Declares a C struct representation of `result<R, std::error_code>`.
@@ -70,4 +88,69 @@ struct cxx_error_code
 //! Convenience macro setting `errno` to a result struct's `errno` compatible error if present, or `EAGAIN` if errored but incompatible.
 #define CXX_RESULT_SET_ERRNO(r) (errno = CXX_RESULT_HAS_ERROR(r) ? (CXX_RESULT_ERROR_IS_ERRNO(r) ? CXX_RESULT_ERROR(r) : EAGAIN) : 0)
 
+/*! Declares a compact C struct representation of `result<R, std::error_code>`, whose category is its
+32 bit stable identifier from `error_category_id()` in `category_registry.hpp`, and whose code is packed
+into the top 24 bits of `flags` above the status bits. For an `R` of up to eight bytes it is no larger
+than two registers, which the SysV x86-64 and AArch64 ABIs return in registers rather than through
+memory, unlike the struct declared by `CXX_DECLARE_RESULT_EC()`. Codes outside the signed 24 bit
+range keep only their bottom 24 bits, and set `CXX_RESULT_EC32_CODE_TRUNCATED`.
+
+\param R The unique postfix for `struct result_##R##_errorcode32`.
+\param RD The declaration for the `R` type.
+*/
+#define CXX_DECLARE_RESULT_EC32(R, RD)                                                                                                                                                                                                                                                                                         \
+  struct result_##R##_errorcode32                                                                                                                                                                                                                                                                                              \
+  {                                                                                                                                                                                                                                                                                                                            \
+    RD value;                                                                                                                                                                                                                                                                                                                  \
+    unsigned category;                                                                                                                                                                                                                                                                                                         \
+    unsigned flags;                                                                                                                                                                                                                                                                                                            \
+  }
+//! A reference to a previously declared struct by `CXX_DECLARE_RESULT_EC32(R, RD)`
+#define CXX_RESULT_EC32(R) struct result_##R##_errorcode32
+//! The status bit set in a compact result struct whose code did not fit in 24 bits.
+#define CXX_RESULT_EC32_CODE_TRUNCATED (1U << 7U)
+//! The sign extended error code of a compact result struct.
+#define CXX_RESULT_EC32_ERROR(r) ((int) (((r).flags >> 8U) ^ 0x800000U) - 0x800000)
+//! Convenience macro setting `errno` to a compact result struct's `errno` compatible error if present, or `EAGAIN` if errored but incompatible.
+#define CXX_RESULT_EC32_SET_ERRNO(r) (errno = CXX_RESULT_HAS_ERROR(r) ? (CXX_RESULT_ERROR_IS_ERRNO(r) ? CXX_RESULT_EC32_ERROR(r) : EAGAIN) : 0)
+
+/* Defines the batch functions for the result struct `result_##NAME`, whose integer error is `CODE(r)`.
+The loops have no branches besides their condition, so compilers vectorise them.
+*/
+#define CXX_DECLARE_RESULTS_TO_ERRNO_IMPL(NAME, RD, CODE)                                                                                                                                                                                                                                                                      \
+  static inline size_t cxx_results_##NAME##_to_errno(const struct result_##NAME *results, size_t count, int *out)                                                                                                                                                                                                              \
+  {                                                                                                                                                                                                                                                                                                                            \
+    size_t n, errored = 0;                                                                                                                                                                                                                                                                                                     \
+    for(n = 0; n < count; n++)                                                                                                                                                                                                                                                                                                 \
+    {                                                                                                                                                                                                                                                                                                                          \
+      const int is_error = -(int) (((results[n].flags) >> 1U) & 1U), is_errno = -(int) (((results[n].flags) >> 4U) & 1U);                                                                                                                                                                                                      \
+      out[n] = is_error & ((is_errno & CODE(results[n])) | (~is_errno & EAGAIN));                                                                                                                                                                                                                                              \
+      errored += (size_t) (is_error & 1);                                                                                                                                                                                                                                                                                      \
+    }                                                                                                                                                                                                                                                                                                                          \
+    return errored;                                                                                                                                                                                                                                                                                                            \
+  }                                                                                                                                                                                                                                                                                                                            \
+  static inline size_t cxx_results_##NAME##_to_values_and_errno(const struct result_##NAME *results, size_t count, RD *values, int *out)                                                                                                                                                                                       \
+  {                                                                                                                                                                                                                                                                                                                            \
+    size_t n;                                                                                                                                                                                                                                                                                                                  \
+    for(n = 0; n < count; n++)                                                                                                                                                                                                                                                                                                 \
+    {                                                                                                                                                                                                                                                                                                                          \
+      values[n] = CXX_RESULT_HAS_VALUE(results[n]) ? results[n].value : (RD) 0;                                                                                                                                                                                                                                                \
+    }                                                                                                                                                                                                                                                                                                                          \
+    return cxx_results_##NAME##_to_errno(results, count, out);                                                                                                                                                                                                                                                                 \
+  }
+#define CXX_RESULT_EC_CODE_IMPL(r) ((r).error.code)
+/*! Defines, for the struct declared by `CXX_DECLARE_RESULT_EC(R, RD)`, the batch versions of `CXX_RESULT_SET_ERRNO()`:
+
+- `size_t cxx_results_##R##_errorcode_to_errno(const CXX_RESULT_EC(R) *results, size_t count, int *out)`
+writes into `out[n]` zero if `results[n]` is valued, its error if that is `errno` compatible, and
+`EAGAIN` if not, returning the number which were errored.
+- `size_t cxx_results_##R##_errorcode_to_values_and_errno(const CXX_RESULT_EC(R) *results, size_t count, RD *values, int *out)`
+also writes into `values[n]` the value of `results[n]`, or zero if it was errored.
+
+`RD` must be an arithmetic or pointer type, and `<errno.h>` must be included first.
+*/
+#define CXX_DECLARE_RESULT_EC_TO_ERRNO(R, RD) CXX_DECLARE_RESULTS_TO_ERRNO_IMPL(R##_errorcode, RD, CXX_RESULT_EC_CODE_IMPL)
+//! As `CXX_DECLARE_RESULT_EC_TO_ERRNO(R, RD)`, for the struct declared by `CXX_DECLARE_RESULT_EC32(R, RD)`.
+#define CXX_DECLARE_RESULT_EC32_TO_ERRNO(R, RD) CXX_DECLARE_RESULTS_TO_ERRNO_IMPL(R##_errorcode32, RD, CXX_RESULT_EC32_ERROR)
+
 #endif
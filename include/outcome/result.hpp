@@ -26,13 +26,19 @@ http://www.boost.org/LICENSE_1_0.txt)
 #define OUTCOME_RESULT_HPP
 
 #include "convert.hpp"
+#include "detail/monadic.hpp"
 #include "detail/result_final.hpp"
 
 #include "policy/all_narrow.hpp"
+#include "policy/debug_checked.hpp"
+#ifndef OUTCOME_RESULT_LITE
 #include "policy/result_error_code_throw_as_system_error.hpp"
 #include "policy/result_exception_ptr_rethrow.hpp"
+#endif
 #include "policy/terminate.hpp"
+#ifndef OUTCOME_RESULT_LITE
 #include "policy/throw_bad_result_access.hpp"
+#endif
 
 #ifdef __clang__
 #pragma clang diagnostic push
@@ -46,6 +52,9 @@ namespace policy
 {
   /*! Default policy selector.
   */
+#ifdef OUTCOME_RESULT_LITE
+  template <class T, class EC, class E> using default_policy = std::conditional_t<std::is_void<EC>::value && std::is_void<E>::value, terminate, all_narrow>;
+#else
   template <class T, class EC, class E>
   using default_policy = std::conditional_t<  //
   std::is_void<EC>::value && std::is_void<E>::value,
@@ -56,11 +65,16 @@ namespace policy
   trait::has_exception_ptr_v<EC> || trait::has_exception_ptr_v<E>, exception_ptr_rethrow<T, EC, E>,  //
   all_narrow                                                                                         //
   >>>;
+#endif
 }  // namespace policy
 
+#ifdef OUTCOME_RESULT_LITE
+template <class R, class S, class NoValuePolicy = policy::default_policy<R, S, void>>  //
+#else
 template <class R, class S = std::error_code, class NoValuePolicy = policy::default_policy<R, S, void>>                                                                 //
+#endif
 #if !defined(__GNUC__) || __GNUC__ >= 8                                                                                                                                 // GCC's constraints implementation is buggy
-OUTCOME_REQUIRES(detail::type_can_be_used_in_result<R> &&detail::type_can_be_used_in_result<S> && (std::is_void<S>::value || std::is_default_constructible<S>::value))  //
+OUTCOME_REQUIRES(detail::usable_as_result_value<R> &&detail::usable_as_result_status<S>)  //
 #endif
 class result;
 
@@ -93,11 +107,15 @@ namespace detail
     && !detail::is_implicitly_constructible<value_type, T> && detail::is_implicitly_constructible<error_type, T>;
 
     // Predicate for the error condition converting constructor to be available.
+#ifdef OUTCOME_RESULT_LITE
+    template <class ErrorCondEnum> static constexpr bool enable_error_condition_converting_constructor = false;
+#else
     template <class ErrorCondEnum>
     static constexpr bool enable_error_condition_converting_constructor =                                                                   //
     !is_in_place_type_t<std::decay_t<ErrorCondEnum>>::value                                                                                 // not in place construction
     && std::is_error_condition_enum<ErrorCondEnum>::value                                                                                   // is an error condition enum
     && !detail::is_implicitly_constructible<value_type, ErrorCondEnum> && !detail::is_implicitly_constructible<error_type, ErrorCondEnum>;  // not constructible via any other means
+#endif
 
     // Predicate for the converting copy constructor from a compatible input to be available.
     template <class T, class U, class V>
@@ -119,9 +137,10 @@ namespace detail
     std::is_constructible<error_type, Args...>::value,                                                       //
     error_type,                                                                                              //
     disable_inplace_value_error_constructor>>>;
+    // Enabled if exactly one of value_type and error_type is constructible, without instantiating the choice for every candidate
     template <class... Args>
     static constexpr bool enable_inplace_value_error_constructor = implicit_constructors_enabled  //
-                                                                   && !std::is_same<choose_inplace_value_error_constructor<Args...>, disable_inplace_value_error_constructor>::value;
+                                                                   && (std::is_constructible<value_type, Args...>::value != std::is_constructible<error_type, Args...>::value);
   };
 
   template <class T, class U> constexpr inline const U &extract_value_from_success(const success_type<U> &v) { return v.value(); }
@@ -182,15 +201,26 @@ namespace hooks
   */
   template <class T, class U, class... Args> constexpr inline void hook_result_in_place_construction(T * /*unused*/, in_place_type_t<U> /*unused*/, Args &&... /*unused*/) noexcept {}
 
+#ifdef OUTCOME_ENABLE_COMPACT_STATUS
+  //! Retrieves the 16 bits of spare storage in result/outcome. There is none with `OUTCOME_ENABLE_COMPACT_STATUS`, so this always returns zero.
+  template <class R, class S, class NoValuePolicy> constexpr inline uint16_t spare_storage(const detail::result_final<R, S, NoValuePolicy> * /*unused*/) noexcept { return 0; }
+  //! Sets the 16 bits of spare storage in result/outcome. Not available with `OUTCOME_ENABLE_COMPACT_STATUS`.
+  template <class R, class S, class NoValuePolicy> constexpr inline void set_spare_storage(detail::result_final<R, S, NoValuePolicy> * /*unused*/, uint16_t /*unused*/) noexcept
+  {
+    static_assert(sizeof(R *) == 0, "There is no spare storage in result/outcome when OUTCOME_ENABLE_COMPACT_STATUS is defined");
+  }
+#else
   //! Retrieves the 16 bits of spare storage in result/outcome.
-  template <class R, class S, class NoValuePolicy> constexpr inline uint16_t spare_storage(const detail::result_final<R, S, NoValuePolicy> *r) noexcept { return (r->_state._status >> detail::status_2byte_shift) & 0xffff; }
-  //! Sets the 16 bits of spare storage in result/outcome.
-  template <class R, class S, class NoValuePolicy> constexpr inline void set_spare_storage(detail::result_final<R, S, NoValuePolicy> *r, uint16_t v) noexcept { r->_state._status |= (v << detail::status_2byte_shift); }
+  template <class R, class S, class NoValuePolicy> constexpr inline uint16_t spare_storage(const detail::result_final<R, S, NoValuePolicy> *r) noexcept { return (r->_state.status() >> detail::status_2byte_shift) & 0xffff; }
+  //! Sets the 16 bits of spare storage in result/outcome, replacing whatever was there.
+  template <class R, class S, class NoValuePolicy> constexpr inline void set_spare_storage(detail::result_final<R, S, NoValuePolicy> *r, uint16_t v) noexcept { r->_state.set_status((r->_state.status() & ~detail::status_2byte_mask) | (static_cast<detail::status_bitfield_type>(v) << detail::status_2byte_shift)); }
+#endif
 }  // namespace hooks
 
 /*! Used to return from functions either (i) a successful value (ii) a cause of failure. `constexpr` capable.
 
-\tparam R The optional type of the successful result (use `void` to disable). Cannot be a reference, a `in_place_type_t<>`, `success<>`, `failure<>`, an array, a function or non-destructible.
+\tparam R The optional type of the successful result (use `void` to disable). Cannot be an rvalue reference, a `in_place_type_t<>`, `success<>`, `failure<>`, an array, a function or non-destructible.
+May be an lvalue reference `T &`, in which case the result holds a pointer, `.value()` returns the reference and assignment rebinds it.
 \tparam S The optional type of the failure result (use `void` to disable). Must be either `void` or `DefaultConstructible`. Cannot be a reference, a `in_place_type_t<>`, `success<>`, `failure<>`, an array, a function or non-destructible.
 \tparam NoValuePolicy Policy on how to interpret type `S` when a wide observation of a not present value occurs.
 
@@ -213,15 +243,15 @@ or if `S` is `void`, do `throw bad_result_access()`
 */
 template <class R, class S, class NoValuePolicy>                                                                                                                        //
 #if !defined(__GNUC__) || __GNUC__ >= 8                                                                                                                                 // GCC's constraints implementation is buggy
-OUTCOME_REQUIRES(detail::type_can_be_used_in_result<R> &&detail::type_can_be_used_in_result<S> && (std::is_void<S>::value || std::is_default_constructible<S>::value))  //
+OUTCOME_REQUIRES(detail::usable_as_result_value<R> &&detail::usable_as_result_status<S>)  //
 #endif
-class OUTCOME_NODISCARD result : public detail::result_final<R, S, NoValuePolicy>
+class OUTCOME_NODISCARD result : public detail::select_result_final<R, S, NoValuePolicy>
 {
-  static_assert(detail::type_can_be_used_in_result<R>, "The type R cannot be used in a result");
+  static_assert(detail::value_type_can_be_used_in_result<R>, "The type R cannot be used in a result");
   static_assert(detail::type_can_be_used_in_result<S>, "The type S cannot be used in a result");
   static_assert(std::is_void<S>::value || std::is_default_constructible<S>::value, "The type S must be void or default constructible");
 
-  using base = detail::result_final<R, S, NoValuePolicy>;
+  using base = detail::select_result_final<R, S, NoValuePolicy>;
 
   struct value_converting_constructor_tag
   {
@@ -238,6 +268,15 @@ class OUTCOME_NODISCARD result : public detail::result_final<R, S, NoValuePolicy
   struct explicit_valueorerror_converting_constructor_tag
   {
   };
+  struct in_place_type_sugar_tag
+  {
+  };
+  // Unpacks the references held by success_in_place_type and failure_in_place_type into an in place constructor
+  template <class Tag, class Tuple, size_t... I>
+  constexpr result(in_place_type_sugar_tag /*unused*/, Tag _, Tuple &&args, std::index_sequence<I...> /*unused*/)
+      : result(_, std::get<I>(std::forward<Tuple>(args))...)
+  {
+  }
 
 public:
   /// \output_section Member types
@@ -280,8 +319,9 @@ protected:
 
     //! Predicate for the converting copy constructor from a compatible input to be available.
     template <class T, class U, class V>
-    static constexpr bool enable_compatible_conversion =  //
-    !std::is_same<result<T, U, V>, result>::value         // not my type
+    static constexpr bool enable_compatible_conversion =                  //
+    !std::is_same<result<T, U, V>, result>::value                         // not my type
+    && (!std::is_reference<value_type>::value || std::is_reference<T>::value)  // a reference can only bind to another's referent
     && base::template enable_compatible_conversion<T, U, V>;
 
     //! Predicate for the inplace construction of value to be available.
@@ -296,6 +336,36 @@ protected:
     std::is_void<error_type>::value                           //
     || std::is_constructible<error_type, Args...>::value;
 
+    //! Predicate for `emplace()` to be available.
+    template <class... Args>
+    static constexpr bool enable_emplace =                                                       //
+    (std::is_void<value_type>::value && sizeof...(Args) == 0)                                    //
+    || (!std::is_void<value_type>::value && std::is_constructible<value_type_if_enabled, Args...>::value);
+
+    //! Predicate for `value_mut_or_emplace()` to be available.
+    template <class... Args>
+    static constexpr bool enable_value_mut_or_emplace =  //
+    !std::is_void<value_type>::value && enable_emplace<Args...>;
+
+    //! Predicate for `emplace_error()` to be available.
+    template <class... Args>
+    static constexpr bool enable_emplace_error =                                                 //
+    (std::is_void<error_type>::value && sizeof...(Args) == 0)                                    //
+    || (!std::is_void<error_type>::value && std::is_constructible<error_type_if_enabled, Args...>::value);
+
+    //! Predicate for the allocator extended constructors to be available.
+    template <class Alloc>
+    static constexpr bool enable_allocator_construction =  //
+    std::uses_allocator<detail::devoid<value_type>, Alloc>::value;
+
+    //! Predicate for the allocator extended constructor forwarding to another constructor to be available.
+    template <class A1, class... Args>
+    static constexpr bool enable_allocator_forwarding_constructor =  //
+    !std::is_same<std::decay_t<A1>, result>::value                 // not copy or move
+    && !std::is_same<std::decay_t<A1>, in_place_type_t<value_type_if_enabled>>::value  // not in place value
+    && !(sizeof...(Args) == 0 && enable_value_converting_constructor<A1>)             // not value converting
+    && std::is_constructible<result, A1, Args...>::value;
+
     // Predicate for the implicit converting inplace constructor to be available.
     template <class... Args>
     static constexpr bool enable_inplace_value_error_constructor =  //
@@ -332,10 +402,11 @@ public:
   OUTCOME_TEMPLATE(class T)
   OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template enable_value_converting_constructor<T>))
   constexpr result(T &&t, value_converting_constructor_tag /*unused*/ = value_converting_constructor_tag()) noexcept(std::is_nothrow_constructible<value_type, T>::value)  // NOLINT
-  : base{in_place_type<typename base::value_type>, std::forward<T>(t)}
+  : base{in_place_type<value_type_if_enabled>, std::forward<T>(t)}
   {
     using namespace hooks;
     hook_result_construction(this, std::forward<T>(t));
+    detail::policy_hooks_t<NoValuePolicy>::on_construction(this, std::forward<T>(t));
   }
   /*! Implicit converting constructor to a failure result.
   \tparam 1
@@ -356,6 +427,7 @@ public:
   {
     using namespace hooks;
     hook_result_construction(this, std::forward<T>(t));
+    detail::policy_hooks_t<NoValuePolicy>::on_construction(this, std::forward<T>(t));
   }
   /*! Implicit special error condition converting constructor to a failure result.
   \tparam 1
@@ -380,6 +452,7 @@ public:
   {
     using namespace hooks;
     hook_result_construction(this, std::forward<ErrorCondEnum>(t));
+    detail::policy_hooks_t<NoValuePolicy>::on_construction(this, std::forward<ErrorCondEnum>(t));
   }
 
   /*! Explicit converting constructor from a compatible `ValueOrError` type.
@@ -420,6 +493,7 @@ public:
   {
     using namespace hooks;
     hook_result_copy_construction(this, o);
+    detail::policy_hooks_t<NoValuePolicy>::on_copy_construction(this, o);
   }
   /*! Explicit converting move constructor from a compatible result type.
   \tparam 3
@@ -437,6 +511,7 @@ public:
   {
     using namespace hooks;
     hook_result_move_construction(this, std::move(o));
+    detail::policy_hooks_t<NoValuePolicy>::on_move_construction(this, std::move(o));
   }
 
   /// \output_section In place constructors
@@ -457,6 +532,7 @@ public:
   {
     using namespace hooks;
     hook_result_in_place_construction(this, in_place_type<value_type>, std::forward<Args>(args)...);
+    detail::policy_hooks_t<NoValuePolicy>::on_in_place_construction(this, in_place_type<value_type>, std::forward<Args>(args)...);
   }
   /*! Explicit inplace constructor to a successful result.
   \tparam 2
@@ -476,6 +552,7 @@ public:
   {
     using namespace hooks;
     hook_result_in_place_construction(this, in_place_type<value_type>, il, std::forward<Args>(args)...);
+    detail::policy_hooks_t<NoValuePolicy>::on_in_place_construction(this, in_place_type<value_type>, il, std::forward<Args>(args)...);
   }
   /*! Explicit inplace constructor to a failure result.
   \tparam 1
@@ -494,6 +571,7 @@ public:
   {
     using namespace hooks;
     hook_result_in_place_construction(this, in_place_type<error_type>, std::forward<Args>(args)...);
+    detail::policy_hooks_t<NoValuePolicy>::on_in_place_construction(this, in_place_type<error_type>, std::forward<Args>(args)...);
   }
   /*! Explicit inplace constructor to a failure result.
   \tparam 2
@@ -513,6 +591,7 @@ public:
   {
     using namespace hooks;
     hook_result_in_place_construction(this, in_place_type<error_type>, il, std::forward<Args>(args)...);
+    detail::policy_hooks_t<NoValuePolicy>::on_in_place_construction(this, in_place_type<error_type>, il, std::forward<Args>(args)...);
   }
   /*! Implicit inplace constructor to successful or failure result.
   \tparam 3
@@ -535,6 +614,106 @@ public:
     // hook_result_in_place_construction(in_place_type<typename predicate::template choose_inplace_value_error_constructor<A1, A2, Args...>>, this);
   }
 
+  /// \output_section Allocator extended constructors
+  /*! Explicit inplace constructor to a successful result, passing an allocator to the value.
+  \tparam 2
+  \exclude
+  \param _ Tag type to indicate we are doing allocator extended construction.
+  \param a The allocator.
+  \param t Tag type to indicate we are doing in place construction of `value_type`.
+  \param args Arguments with which to in place construct.
+
+  \effects Initialises the result with a `value_type` constructed from `args` by uses-allocator
+  construction with `a`, as `std::make_obj_using_allocator()` would.
+  \requires `std::uses_allocator<value_type, Alloc>` to be true, and `Args...` are constructible to `value_type`.
+  \throws Any exception the construction of `value_type` might throw.
+  */
+  OUTCOME_TEMPLATE(class Alloc, class... Args)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template enable_allocator_construction<Alloc> &&predicate::template enable_inplace_value_constructor<Args...>))
+  OUTCOME_CONSTEXPR20 explicit result(std::allocator_arg_t _, const Alloc &a, in_place_type_t<value_type_if_enabled> t, Args &&... args)
+      : base{_, a, t, std::forward<Args>(args)...}
+  {
+    using namespace hooks;
+    hook_result_in_place_construction(this, in_place_type<value_type>, std::forward<Args>(args)...);
+    detail::policy_hooks_t<NoValuePolicy>::on_in_place_construction(this, in_place_type<value_type>, std::forward<Args>(args)...);
+  }
+  /*! Allocator extended converting constructor to a successful result.
+  \tparam 2
+  \exclude
+  \param _ Tag type to indicate we are doing allocator extended construction.
+  \param a The allocator.
+  \param t The value from which to initialise the `value_type`.
+
+  \effects Initialises the result with a `value_type` constructed from `t` by uses-allocator construction with `a`.
+  \requires `std::uses_allocator<value_type, Alloc>` to be true, and `result(T)` to be the implicit converting constructor to a successful result.
+  \throws Any exception the construction of `value_type` might throw.
+  */
+  OUTCOME_TEMPLATE(class Alloc, class T)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template enable_allocator_construction<Alloc> &&predicate::template enable_value_converting_constructor<T>))
+  OUTCOME_CONSTEXPR20 result(std::allocator_arg_t _, const Alloc &a, T &&t)
+      : base{_, a, in_place_type<value_type_if_enabled>, std::forward<T>(t)}
+  {
+    using namespace hooks;
+    hook_result_construction(this, std::forward<T>(t));
+    detail::policy_hooks_t<NoValuePolicy>::on_construction(this, std::forward<T>(t));
+  }
+  /*! Allocator extended copy constructor.
+  \tparam 1
+  \exclude
+  \param _ Tag type to indicate we are doing allocator extended construction.
+  \param a The allocator.
+  \param o The result to copy.
+
+  \effects Initialises the result with a copy of `o`, any value being copied by uses-allocator construction with `a`.
+  \requires `std::uses_allocator<value_type, Alloc>` to be true.
+  \throws Any exception the construction of `value_type` and `error_type` might throw.
+  */
+  OUTCOME_TEMPLATE(class Alloc)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template enable_allocator_construction<Alloc>))
+  OUTCOME_CONSTEXPR20 result(std::allocator_arg_t _, const Alloc &a, const result &o)
+      : base{_, a, o}
+  {
+    detail::policy_hooks_t<NoValuePolicy>::on_copy_construction(this, o);
+  }
+  /*! Allocator extended move constructor.
+  \tparam 1
+  \exclude
+  \param _ Tag type to indicate we are doing allocator extended construction.
+  \param a The allocator.
+  \param o The result to move.
+
+  \effects Initialises the result with a move of `o`, any value being moved by uses-allocator construction with `a`.
+  \requires `std::uses_allocator<value_type, Alloc>` to be true.
+  \throws Any exception the construction of `value_type` and `error_type` might throw.
+  */
+  OUTCOME_TEMPLATE(class Alloc)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template enable_allocator_construction<Alloc>))
+  OUTCOME_CONSTEXPR20 result(std::allocator_arg_t _, const Alloc &a, result &&o)
+      : base{_, a, std::move(o)}
+  {
+    detail::policy_hooks_t<NoValuePolicy>::on_move_construction(this, std::move(o));
+  }
+  /*! Allocator extended constructor from anything else a result can be constructed from, such as
+  an error or the type sugar, so that uses-allocator construction of a result always succeeds.
+  \tparam 3
+  \exclude
+  \param 1
+  \exclude
+  \param 2
+  \exclude
+  \param args Arguments from which to construct.
+
+  \effects Constructs as `result(args...)` would, without the allocator.
+  \requires `std::uses_allocator<value_type, Alloc>` to be true.
+  \throws Any exception `result(args...)` might throw.
+  */
+  OUTCOME_TEMPLATE(class Alloc, class A1, class... Args)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template enable_allocator_construction<Alloc> &&predicate::template enable_allocator_forwarding_constructor<A1, Args...>))
+  OUTCOME_CONSTEXPR20 result(std::allocator_arg_t /*unused*/, const Alloc & /*unused*/, A1 &&a1, Args &&... args)
+      : result(std::forward<A1>(a1), std::forward<Args>(args)...)
+  {
+  }
+
   /// \output_section Tagged constructors
   /*! Implicit tagged constructor of a successful result.
   \param o The compatible success type sugar.
@@ -548,6 +727,7 @@ public:
   {
     using namespace hooks;
     hook_result_copy_construction(this, o);
+    detail::policy_hooks_t<NoValuePolicy>::on_copy_construction(this, o);
   }
   /*! Implicit tagged constructor of a successful result.
   \tparam 1
@@ -565,6 +745,7 @@ public:
   {
     using namespace hooks;
     hook_result_copy_construction(this, o);
+    detail::policy_hooks_t<NoValuePolicy>::on_copy_construction(this, o);
   }
   /*! Implicit tagged constructor of a successful result.
   \tparam 1
@@ -582,6 +763,7 @@ public:
   {
     using namespace hooks;
     hook_result_move_construction(this, std::move(o));
+    detail::policy_hooks_t<NoValuePolicy>::on_move_construction(this, std::move(o));
   }
   /*! Implicit tagged constructor of a failure result.
   \tparam 1
@@ -599,6 +781,7 @@ public:
   {
     using namespace hooks;
     hook_result_copy_construction(this, o);
+    detail::policy_hooks_t<NoValuePolicy>::on_copy_construction(this, o);
   }
   /*! Implicit tagged constructor of a failure result.
   \tparam 1
@@ -616,38 +799,117 @@ public:
   {
     using namespace hooks;
     hook_result_move_construction(this, std::move(o));
+    detail::policy_hooks_t<NoValuePolicy>::on_move_construction(this, std::move(o));
   }
 
-  /// \output_section Swap
-  /*! Swaps this result with another result
-  \effects Any `R` and/or `S` is swapped along with the metadata tracking them.
+  /*! Implicit tagged constructor of a successful result.
+  \tparam 1
+  \exclude
+  \param o The in place success type sugar.
+
+  \effects Initialises the result with a `value_type` constructed in place from the arguments referenced by the type sugar.
+  \requires `value_type` is void or `Args...` are constructible to `value_type`.
+  \throws Any exception the construction of `value_type(Args...)` might throw.
   */
-  void swap(result &o) noexcept(detail::is_nothrow_swappable<value_type>::value  //
-                                &&detail::is_nothrow_swappable<error_type>::value)
+  OUTCOME_TEMPLATE(class... Args)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template enable_inplace_value_constructor<Args...>))
+  constexpr result(success_in_place_type<Args...> &&o) noexcept(std::is_nothrow_constructible<value_type, Args...>::value)  // NOLINT
+      : result(in_place_type_sugar_tag(), in_place_type<value_type_if_enabled>, std::move(o.args), std::index_sequence_for<Args...>())
   {
-    using std::swap;
-#ifdef __cpp_exceptions
-#ifdef _MSC_VER
-#pragma warning(push)
-#pragma warning(disable : 4297)  // use of throw in noexcept function
-#endif
-    this->_state.swap(o._state);
-    try
-    {
-      swap(this->_error, o._error);
-    }
-    catch(...)
+  }
+  /*! Implicit tagged constructor of a failure result.
+  \tparam 1
+  \exclude
+  \param o The in place failure type sugar.
+
+  \effects Initialises the result with an `error_type` constructed in place from the arguments referenced by the type sugar.
+  \requires `error_type` is void or `Args...` are constructible to `error_type`.
+  \throws Any exception the construction of `error_type(Args...)` might throw.
+  */
+  OUTCOME_TEMPLATE(class... Args)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template enable_inplace_error_constructor<Args...>))
+  constexpr result(failure_in_place_type<Args...> &&o) noexcept(std::is_nothrow_constructible<error_type, Args...>::value)  // NOLINT
+      : result(in_place_type_sugar_tag(), in_place_type<error_type_if_enabled>, std::move(o.args), std::index_sequence_for<Args...>())
+  {
+  }
+
+  /// \output_section Modifiers
+  /*! Replaces any value or error with a value constructed in place, as would assigning a result
+  constructed with `in_place_type<value_type>`, but without destroying the result.
+  \param args Arguments with which to in place construct.
+
+  \effects Destroys any value, then constructs a `value_type` from `args` in its storage. Any error is reset
+  to default constructed, and the spare storage is cleared.
+  \returns A reference to the new value, or `void` if `value_type` is `void`.
+  \throws Any exception the construction of `value_type(Args...)` might throw. This result then has any
+  error it had before, but no value.
+  */
+  OUTCOME_TEMPLATE(class... Args)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template enable_emplace<Args...>))
+  OUTCOME_CONSTEXPR20 decltype(auto) emplace(Args &&... args) noexcept(std::is_nothrow_constructible<detail::devoid<value_type_if_enabled>, Args...>::value &&base::_is_nothrow_error_reset)
+  {
+    this->_emplace_value(std::forward<Args>(args)...);
+    using namespace hooks;
+    hook_result_in_place_construction(this, in_place_type<value_type>, std::forward<Args>(args)...);
+    detail::policy_hooks_t<NoValuePolicy>::on_in_place_construction(this, in_place_type<value_type>, std::forward<Args>(args)...);
+    return this->assume_value();
+  }
+  /*! The value, after emplacing one constructed from `args` if there is none.
+  \param args Arguments with which to in place construct, if not valued.
+
+  \effects If valued, nothing, so a value reused from one loop iteration to the next keeps any capacity
+  it has. Otherwise `emplace(args...)`.
+  \returns A reference to the value.
+  \throws Any exception `emplace()` might throw.
+  */
+  OUTCOME_TEMPLATE(class... Args)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template enable_value_mut_or_emplace<Args...>))
+  OUTCOME_CONSTEXPR20 std::add_lvalue_reference_t<value_type> value_mut_or_emplace(Args &&... args) noexcept(noexcept(std::declval<result &>().emplace(std::forward<Args>(args)...)))
+  {
+    if(!this->has_value())
     {
-      swap(this->_state, o._state);
-      throw;
+      return emplace(std::forward<Args>(args)...);
     }
-#ifdef _MSC_VER
-#pragma warning(pop)
-#endif
-#else
-    swap(this->_state, o._state);
-    swap(this->_error, o._error);
-#endif
+    return this->assume_value();
+  }
+  /*! Replaces any value or error with an error constructed in place, as would assigning a result
+  constructed with `in_place_type<error_type>`, but without destroying the result.
+  \param args Arguments with which to in place construct.
+
+  \effects Destroys any value, then replaces any error with an `error_type` constructed from `args`. The
+  spare storage is cleared.
+  \throws Any exception the construction of `error_type(Args...)` might throw. This result then has any
+  error it had before, but no value.
+  */
+  OUTCOME_TEMPLATE(class... Args)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template enable_emplace_error<Args...>))
+  OUTCOME_CONSTEXPR20 void emplace_error(Args &&... args) noexcept(std::is_nothrow_constructible<detail::devoid<error_type_if_enabled>, Args...>::value &&std::is_nothrow_move_assignable<detail::devoid<error_type_if_enabled>>::value)
+  {
+    this->_emplace_error(std::forward<Args>(args)...);
+    using namespace hooks;
+    hook_result_in_place_construction(this, in_place_type<error_type>, std::forward<Args>(args)...);
+    detail::policy_hooks_t<NoValuePolicy>::on_in_place_construction(this, in_place_type<error_type>, std::forward<Args>(args)...);
+  }
+  /*! Replaces any value or error with a default constructed value, as would assigning `success()`.
+
+  \effects `emplace()`.
+  \requires `value_type` to be default constructible, or `void`.
+  */
+  OUTCOME_CONSTEXPR20 void reset() noexcept(noexcept(std::declval<result &>().emplace()))
+  {
+    emplace();
+  }
+
+  /// \output_section Swap
+  /*! Swaps this result with another result
+  \effects Any `R` and/or `S` is swapped along with the metadata tracking them. Only live members
+  are touched, so the errors are not swapped unless either result is errored. If only one of the value
+  and the error can throw when swapped it is swapped first, so a throw never leaves the other swapped.
+  */
+  OUTCOME_CONSTEXPR20 void swap(result &o) noexcept(detail::is_nothrow_swappable<value_type>::value  //
+                                                    &&detail::is_nothrow_swappable<error_type>::value)
+  {
+    this->_swap_state_and_error(o);
   }
 
   /// \output_section Converters
@@ -659,17 +921,54 @@ public:
   \requires This result to have a failed state, else whatever `assume_error()` would do.
   */
   auto as_failure() && { return failure(std::move(this->assume_error())); }
+
+  /// \output_section Monadic operations
+  /*! Returns any value transformed by `f`, or else any failure.
+  \returns A `rebind<U>` where `U` is what `f` returns, being void if `f` returns nothing.
+  \effects If this result has a value, returns what `f(value)` returns as the value, calling `f()` if
+  `value_type` is `void`. Otherwise returns a copy of the failure, which is moved from an rvalue result.
+  \group result_map
+  */
+  template <class F> constexpr auto map(F &&f) const & { return detail::monadic_map(*this, std::forward<F>(f)); }
+  /// \group result_map
+  template <class F> constexpr auto map(F &&f) && { return detail::monadic_map(std::move(*this), std::forward<F>(f)); }
+  /*! Returns what `f` returns when given any value, or else any failure.
+  \returns The result which `f` returns, which must have the same `error_type` as this result.
+  \effects If this result has a value, returns `f(value)`, calling `f()` if `value_type` is `void`.
+  Otherwise returns a copy of the failure, which is moved from an rvalue result.
+  \group result_and_then
+  */
+  template <class F> constexpr auto and_then(F &&f) const & { return detail::monadic_and_then(*this, std::forward<F>(f)); }
+  /// \group result_and_then
+  template <class F> constexpr auto and_then(F &&f) && { return detail::monadic_and_then(std::move(*this), std::forward<F>(f)); }
+  /*! Returns what `f` returns when given any failure, or else any value.
+  \returns The result which `f` returns, which must have the same `value_type` as this result.
+  \effects If this result has no value, returns `f(error())`. Otherwise returns a copy of the
+  value, which is moved from an rvalue result.
+  \group result_or_else
+  */
+  template <class F> constexpr auto or_else(F &&f) const & { return detail::monadic_or_else(*this, std::forward<F>(f)); }
+  /// \group result_or_else
+  template <class F> constexpr auto or_else(F &&f) && { return detail::monadic_or_else(std::move(*this), std::forward<F>(f)); }
 };
 
 /*! Specialise swap for result.
 \effects Calls `a.swap(b)`.
 */
-template <class R, class S, class P> inline void swap(result<R, S, P> &a, result<R, S, P> &b) noexcept(noexcept(a.swap(b)))
+template <class R, class S, class P> OUTCOME_CONSTEXPR20 inline void swap(result<R, S, P> &a, result<R, S, P> &b) noexcept(noexcept(a.swap(b)))
 {
   a.swap(b);
 }
 
-#if !defined(NDEBUG)
+namespace trait
+{
+  //! A `result` can be relocated by `memcpy()` if its value and error types can.
+  template <class R, class S, class P> struct is_move_bitcopying<result<R, S, P>> : is_move_bitcopying<OUTCOME_V2_NAMESPACE::detail::result_final<R, S, P>>
+  {
+  };
+}  // namespace trait
+
+#if !defined(NDEBUG) && !defined(OUTCOME_RESULT_LITE)
 // Check is trivial in all ways except default constructibility
 // static_assert(std::is_trivial<result<int>>::value, "result<int> is not trivial!");
 // static_assert(std::is_trivially_default_constructible<result<int>>::value, "result<int> is not trivially default constructible!");
@@ -688,7 +987,11 @@ static_assert(std::is_standard_layout<result<int>>::value, "result<int> is not a
 Attempting to access `T` when there is an `E` results in nothing happening at all, it is treated with a narrow
 contract (i.e. undefined behaviour).
 */
+#ifdef OUTCOME_RESULT_LITE
+template <class R, class S> using unchecked = result<R, S, policy::all_narrow>;
+#else
 template <class R, class S = std::error_code> using unchecked = result<R, S, policy::all_narrow>;
+#endif
 
 /*! A "checked" edition of `result<T, E>` which resembles fairly closely a `std::expected<T, E>`.
 Attempting to access `T` when there is an `E` results in `bad_result_access<E>` being thrown. Nothing else.
@@ -696,11 +999,58 @@ Attempting to access `T` when there is an `E` results in `bad_result_access<E>`
 Note that this approximates the proposed `expected<T, E>` up for standardisation, see the FAQ for more
 detail.
 */
+#ifndef OUTCOME_RESULT_LITE
 template <class R, class S = std::error_code> using checked = result<R, S, policy::throw_bad_result_access<S>>;
+#endif
+
+/*! Returns a view of `r` as a `result<R, S, NewPolicy>`, reinterpreting the same storage with no copy.
+The policy only affects what happens on wide contract observation, not the layout, so this lets hot loops
+skip checks on an already validated `result` without paying for a converting copy or move.
+*/
+template <class NewPolicy, class R, class S, class P> inline result<R, S, NewPolicy> &rebind_policy(result<R, S, P> &r) noexcept
+{
+  static_assert(sizeof(result<R, S, NewPolicy>) == sizeof(result<R, S, P>), "rebinding the policy of a result must not change its size");
+  static_assert(alignof(result<R, S, NewPolicy>) == alignof(result<R, S, P>), "rebinding the policy of a result must not change its alignment");
+  return reinterpret_cast<result<R, S, NewPolicy> &>(r);  // NOLINT
+}
+//! Returns a const view of `r` as a `result<R, S, NewPolicy>`. No copy is made.
+template <class NewPolicy, class R, class S, class P> inline const result<R, S, NewPolicy> &rebind_policy(const result<R, S, P> &r) noexcept
+{
+  return rebind_policy<NewPolicy>(const_cast<result<R, S, P> &>(r));  // NOLINT
+}
+//! Returns an rvalue view of `r` as a `result<R, S, NewPolicy>`. No copy is made.
+template <class NewPolicy, class R, class S, class P> inline result<R, S, NewPolicy> &&rebind_policy(result<R, S, P> &&r) noexcept
+{
+  return static_cast<result<R, S, NewPolicy> &&>(rebind_policy<NewPolicy>(r));
+}
+
+//! Returns a view of `r` as an `unchecked<R, S>` i.e. with all observers narrow. No copy is made.
+template <class R, class S, class P> inline result<R, S, policy::all_narrow> &as_narrow(result<R, S, P> &r) noexcept
+{
+  return rebind_policy<policy::all_narrow>(r);
+}
+//! Returns a const view of `r` as an `unchecked<R, S>`. No copy is made.
+template <class R, class S, class P> inline const result<R, S, policy::all_narrow> &as_narrow(const result<R, S, P> &r) noexcept
+{
+  return rebind_policy<policy::all_narrow>(r);
+}
+//! Returns an rvalue view of `r` as an `unchecked<R, S>`. No copy is made.
+template <class R, class S, class P> inline result<R, S, policy::all_narrow> &&as_narrow(result<R, S, P> &&r) noexcept
+{
+  return rebind_policy<policy::all_narrow>(static_cast<result<R, S, P> &&>(r));
+}
 
 
 OUTCOME_V2_NAMESPACE_END
 
+namespace std
+{
+  //! A `result` uses an allocator if its value does, so allocator aware containers pass theirs on to the value.
+  template <class R, class S, class P, class Alloc> struct uses_allocator<OUTCOME_V2_NAMESPACE::result<R, S, P>, Alloc> : uses_allocator<OUTCOME_V2_NAMESPACE::detail::devoid<R>, Alloc>
+  {
+  };
+}  // namespace std
+
 #ifdef __clang__
 #pragma clang diagnostic pop
 #endif
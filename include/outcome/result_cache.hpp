@@ -0,0 +1,269 @@
+/* A sharded memoisation cache of results, caching failures for less time than successes
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_RESULT_CACHE_HPP
+#define OUTCOME_RESULT_CACHE_HPP
+
+#include "result.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+/*! A concurrent memoisation cache of `result<T, E>` by key `K`, for expensive functions returning
+results.
+
+Successes and failures are kept for separate times, so that failures can be cached briefly to stop
+a failing backend being called again and again, without keeping them as long as successes.
+`get_or_compute()` coalesces concurrent misses of a key into one computation, whose result every
+caller waiting on it receives, even if it is cached for no time at all.
+
+The keys are spread over `Shards` shards, each with its own lock and on its own cache lines. Expired
+entries are removed when next looked up, or by `purge()`.
+
+\tparam Clock The clock the times to live are measured by, with a static `now()`.
+*/
+template <class K, class T, class E = std::error_code, size_t Shards = 16, class Hash = std::hash<K>, class KeyEqual = std::equal_to<K>, class Clock = std::chrono::steady_clock> class result_cache
+{
+  static_assert(Shards > 0 && (Shards & (Shards - 1)) == 0, "The number of shards must be a power of two");
+
+public:
+  //! The type of key.
+  using key_type = K;
+  //! The type of result cached.
+  using result_type = result<T, E>;
+  //! The clock times to live are measured by.
+  using clock = Clock;
+  //! The type of a time to live.
+  using duration = typename Clock::duration;
+  //! The number of shards.
+  static constexpr size_t shards = Shards;
+
+private:
+  struct _entry
+  {
+    result_type value;
+    typename Clock::time_point expires;
+  };
+  struct alignas(64) _shard
+  {
+    std::mutex lock;
+    // Signalled whenever a computation of a key of this shard finishes
+    std::condition_variable computed;
+    std::unordered_map<K, _entry, Hash, KeyEqual> entries;
+    // The keys being computed, so that other misses wait rather than compute them too
+    std::unordered_set<K, Hash, KeyEqual> computing;
+  };
+
+  duration _success_ttl, _failure_ttl;
+  Hash _hash;
+  mutable _shard _shards[Shards];
+
+  _shard &_shard_of(const K &key) const
+  {
+    // Mixed, as the standard hashes of integers are often the integer itself
+    const uint64_t h = static_cast<uint64_t>(_hash(key)) * 0x9e3779b97f4a7c15ULL;
+    return _shards[(h >> 32U) & (Shards - 1)];
+  }
+  duration _ttl_of(const result_type &r) const noexcept { return r.has_value() ? _success_ttl : _failure_ttl; }
+  // The entry of key, if there is one and it has not expired, else removes any expired entry. Called under the lock.
+  static _entry *_find(_shard &s, const K &key, typename Clock::time_point now)
+  {
+    auto it = s.entries.find(key);
+    if(it == s.entries.end())
+    {
+      return nullptr;
+    }
+    if(now >= it->second.expires)
+    {
+      s.entries.erase(it);
+      return nullptr;
+    }
+    return &it->second;
+  }
+  void _store(_shard &s, const K &key, result_type r)
+  {
+    const auto expires = Clock::now() + _ttl_of(r);
+    auto it = s.entries.find(key);
+    if(it != s.entries.end())
+    {
+      it->second.value = std::move(r);
+      it->second.expires = expires;
+      return;
+    }
+    s.entries.emplace(key, _entry{std::move(r), expires});
+  }
+
+public:
+  /*! Constructs an empty cache.
+  \param success_ttl How long successes are kept.
+  \param failure_ttl How long failures are kept, which may be zero to only coalesce concurrent misses.
+  */
+  result_cache(duration success_ttl, duration failure_ttl, Hash hash = Hash())
+      : _success_ttl(success_ttl)
+      , _failure_ttl(failure_ttl)
+      , _hash(std::move(hash))
+  {
+  }
+  result_cache(const result_cache &) = delete;
+  result_cache &operator=(const result_cache &) = delete;
+
+  //! How long successes are kept.
+  duration success_ttl() const noexcept { return _success_ttl; }
+  //! How long failures are kept.
+  duration failure_ttl() const noexcept { return _failure_ttl; }
+
+  /*! Looks up `key`.
+  \returns True, having copied the cached result into `out`, if there is one which has not expired.
+  */
+  bool find(const K &key, result_type &out) const
+  {
+    _shard &s = _shard_of(key);
+    std::lock_guard<std::mutex> g(s.lock);
+    const _entry *e = _find(s, key, Clock::now());
+    if(e == nullptr)
+    {
+      return false;
+    }
+    out = e->value;
+    return true;
+  }
+
+  //! Caches `r` for `key`, replacing any result already cached, for the time to live of a success or a failure as it is.
+  void insert(const K &key, result_type r)
+  {
+    _shard &s = _shard_of(key);
+    std::lock_guard<std::mutex> g(s.lock);
+    _store(s, key, std::move(r));
+  }
+
+  /*! The result cached for `key`, else what `f()` returns, which is then cached.
+
+  If another thread is already computing `key`, waits for it to finish and returns what it
+  computed instead of calling `f()`. If that computation threw, this thread computes `key`
+  itself. `f()` is called without any lock held.
+  \throws Whatever `f()` throws, in which case nothing is cached.
+  */
+  template <class F> result_type get_or_compute(const K &key, F &&f)
+  {
+    _shard &s = _shard_of(key);
+    std::unique_lock<std::mutex> g(s.lock);
+    bool waited = false;
+    for(;;)
+    {
+      if(waited)
+      {
+        // Take what the computation waited for stored, even if already expired
+        auto it = s.entries.find(key);
+        if(it != s.entries.end())
+        {
+          return it->second.value;
+        }
+      }
+      else if(const _entry *e = _find(s, key, Clock::now()))
+      {
+        return e->value;
+      }
+      if(s.computing.count(key) == 0)
+      {
+        break;
+      }
+      s.computed.wait(g);
+      waited = s.computing.count(key) == 0;
+    }
+    s.computing.insert(key);
+    g.unlock();
+    struct finish_computing
+    {
+      _shard &s;
+      const K &key;
+      std::unique_lock<std::mutex> &g;
+      ~finish_computing()
+      {
+        if(!g.owns_lock())
+        {
+          g.lock();
+        }
+        s.computing.erase(key);
+        g.unlock();
+        s.computed.notify_all();
+      }
+    } finish{s, key, g};
+    result_type ret = f();
+    g.lock();
+    _store(s, key, ret);
+    return ret;
+  }
+
+  //! Removes any result cached for `key`.
+  void erase(const K &key)
+  {
+    _shard &s = _shard_of(key);
+    std::lock_guard<std::mutex> g(s.lock);
+    s.entries.erase(key);
+  }
+  //! Removes every expired result.
+  void purge()
+  {
+    const auto now = Clock::now();
+    for(_shard &s : _shards)
+    {
+      std::lock_guard<std::mutex> g(s.lock);
+      for(auto it = s.entries.begin(); it != s.entries.end();)
+      {
+        it = (now >= it->second.expires) ? s.entries.erase(it) : std::next(it);
+      }
+    }
+  }
+  //! Removes every result.
+  void clear()
+  {
+    for(_shard &s : _shards)
+    {
+      std::lock_guard<std::mutex> g(s.lock);
+      s.entries.clear();
+    }
+  }
+  //! The number of results cached, including any expired but not yet removed.
+  size_t size() const
+  {
+    size_t ret = 0;
+    for(_shard &s : _shards)
+    {
+      std::lock_guard<std::mutex> g(s.lock);
+      ret += s.entries.size();
+    }
+    return ret;
+  }
+};
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,42 @@
+/* result<T, E> for custom E only, without <system_error> or <exception>
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_RESULT_LITE_HPP
+#define OUTCOME_RESULT_LITE_HPP
+
+/* single-header/result-lite.hpp is preprocessed from this, in the same step as single-header/outcome.hpp.
+See OUTCOME_RESULT_LITE in config.hpp for what is left out. It must be included before any other
+outcome header, and outcome.hpp cannot be used alongside it.
+*/
+#ifndef OUTCOME_RESULT_LITE
+#ifdef OUTCOME_SUCCESS_FAILURE_HPP
+#error result_lite.hpp must be included before any other outcome header
+#endif
+#define OUTCOME_RESULT_LITE 1
+#endif
+
+#include "result.hpp"
+#include "try.hpp"
+
+#endif
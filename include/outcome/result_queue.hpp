@@ -0,0 +1,325 @@
+/* Bounded lock free queues of results
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_RESULT_QUEUE_HPP
+#define OUTCOME_RESULT_QUEUE_HPP
+
+#include "result.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>  // for memcpy
+#include <iterator>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  /* Storage for one queued result. Trivially copyable results, which is to say those with trivial
+  value storage and a trivially copyable error, are moved in and out as bytes.
+  */
+  template <class R> struct result_queue_item
+  {
+    static constexpr bool trivial = std::is_trivially_copyable<R>::value;
+
+    alignas(R) unsigned char bytes[sizeof(R)];
+
+    R *get() noexcept { return reinterpret_cast<R *>(bytes); }  // NOLINT
+    template <class U> void construct(U &&v) noexcept { _construct(std::forward<U>(v), std::integral_constant<bool, trivial && std::is_same<std::decay_t<U>, R>::value>()); }
+    template <class U> void _construct(U &&v, std::true_type /*unused*/) noexcept { memcpy(bytes, static_cast<const void *>(std::addressof(v)), sizeof(R)); }
+    template <class U> void _construct(U &&v, std::false_type /*unused*/) noexcept { new(bytes) R(std::forward<U>(v)); }  // NOLINT
+    // Moves the result into out, and ends its lifetime here
+    void extract(R &out) noexcept { _extract(out, std::integral_constant<bool, trivial>()); }
+    void _extract(R &out, std::true_type /*unused*/) noexcept { memcpy(static_cast<void *>(std::addressof(out)), bytes, sizeof(R)); }
+    void _extract(R &out, std::false_type /*unused*/) noexcept
+    {
+      out = std::move(*get());
+      get()->~R();
+    }
+    void destroy() noexcept
+    {
+      if(!trivial)
+      {
+        get()->~R();
+      }
+    }
+  };
+
+  template <class R, class It> static constexpr bool result_queue_nothrow_push = std::is_nothrow_constructible<R, decltype(*std::declval<It>())>::value;
+  template <class R> static constexpr bool result_queue_nothrow_pop = result_queue_item<R>::trivial || std::is_nothrow_move_assignable<R>::value;
+}  // namespace detail
+
+/*! A bounded lock free queue of `result<T, E>` with `N` slots, for exactly one pushing thread and
+exactly one popping thread at a time.
+
+The head and tail indices live on their own cache lines, and each end caches the other's index so
+it only reloads it when the queue looks full or empty. The batch operations move many items for one
+pair of atomic operations. Trivially copyable results are moved by `memcpy()`. Errors pass through
+as they are, nothing throws.
+
+Pushing must not throw, so results which are not nothrow copyable must be moved in.
+*/
+template <class T, class E = std::error_code, size_t N = 1024> class spsc_result_queue
+{
+  static_assert(N > 0 && (N & (N - 1)) == 0, "The number of slots must be a power of two");
+
+public:
+  //! The type of result queued.
+  using result_type = result<T, E>;
+  //! The number of slots.
+  static constexpr size_t slots = N;
+
+private:
+  using _item = detail::result_queue_item<result_type>;
+
+  // Written by the pushing thread, with its cache of the tail alongside
+  alignas(64) std::atomic<size_t> _head{0};
+  size_t _tail_cache{0};
+  // Written by the popping thread, with its cache of the head alongside
+  alignas(64) std::atomic<size_t> _tail{0};
+  size_t _head_cache{0};
+  alignas(64) _item _items[N];
+
+public:
+  //! Constructs an empty queue.
+  spsc_result_queue() noexcept {}  // NOLINT
+  spsc_result_queue(const spsc_result_queue &) = delete;
+  spsc_result_queue &operator=(const spsc_result_queue &) = delete;
+  //! Destroys any results still queued.
+  ~spsc_result_queue()
+  {
+    for(size_t pos = _tail.load(std::memory_order_relaxed), head = _head.load(std::memory_order_relaxed); pos != head; pos++)
+    {
+      _items[pos & (N - 1)].destroy();
+    }
+  }
+
+  /*! Pushes up to `n` results constructed from `*first`, `*++first` and so on, to move them in use
+  `std::make_move_iterator()`.
+  \returns How many were pushed, which is less than `n` if the queue became full.
+  */
+  template <class InputIt> size_t try_push_n(InputIt first, size_t n) noexcept
+  {
+    static_assert(detail::result_queue_nothrow_push<result_type, InputIt>, "Pushing must not throw, so move the results in");
+    const size_t head = _head.load(std::memory_order_relaxed);
+    if(N - (head - _tail_cache) < n)
+    {
+      _tail_cache = _tail.load(std::memory_order_acquire);
+    }
+    const size_t count = std::min(n, N - (head - _tail_cache));
+    for(size_t i = 0; i < count; i++, ++first)
+    {
+      _items[(head + i) & (N - 1)].construct(*first);
+    }
+    if(count > 0)
+    {
+      _head.store(head + count, std::memory_order_release);
+    }
+    return count;
+  }
+  /*! Pushes a result.
+  \returns False if the queue was full.
+  */
+  bool try_push(result_type &&r) noexcept { return try_push_n(std::make_move_iterator(std::addressof(r)), 1) == 1; }
+  //! \group try_push
+  bool try_push(const result_type &r) noexcept { return try_push_n(std::addressof(r), 1) == 1; }
+
+  /*! Pops up to `n` results, assigning each to `*out` then incrementing `out`.
+  \returns How many were popped, which is less than `n` if the queue became empty.
+  */
+  template <class OutputIt> size_t try_pop_n(OutputIt out, size_t n) noexcept
+  {
+    static_assert(detail::result_queue_nothrow_pop<result_type>, "Popping must not throw");
+    const size_t tail = _tail.load(std::memory_order_relaxed);
+    if(_head_cache - tail < n)
+    {
+      _head_cache = _head.load(std::memory_order_acquire);
+    }
+    const size_t count = std::min(n, _head_cache - tail);
+    for(size_t i = 0; i < count; i++, ++out)
+    {
+      _items[(tail + i) & (N - 1)].extract(*out);
+    }
+    if(count > 0)
+    {
+      _tail.store(tail + count, std::memory_order_release);
+    }
+    return count;
+  }
+  /*! Pops the oldest result into `r`.
+  \returns False if the queue was empty.
+  */
+  bool try_pop(result_type &r) noexcept { return try_pop_n(std::addressof(r), 1) == 1; }
+
+  //! True if the queue looked empty. Exact only when called by the popping thread.
+  bool empty() const noexcept { return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire); }
+};
+
+/*! A bounded lock free queue of `result<T, E>` with `N` slots, for any number of pushing and popping
+threads.
+
+Each slot carries a sequence number saying whether it awaits a push or a pop, so pushers and poppers
+only contend on their own index, which each lives on its own cache line. The batch operations claim
+many consecutive slots with one compare and swap. Trivially copyable results are moved by
+`memcpy()`. Errors pass through as they are, nothing throws.
+
+Pushing must not throw, so results which are not nothrow copyable must be moved in.
+*/
+template <class T, class E = std::error_code, size_t N = 1024> class mpmc_result_queue
+{
+  // With one slot, a full slot and one awaiting the next lap's push would have the same sequence
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "The number of slots must be a power of two of at least two");
+
+public:
+  //! The type of result queued.
+  using result_type = result<T, E>;
+  //! The number of slots.
+  static constexpr size_t slots = N;
+
+private:
+  /* Each slot's sequence is relative to its lap, as in `bad_access_log`: it is zero less the lap's
+  start when awaiting a push, one more when full, and `N` more when awaiting the next lap's push.
+  */
+  struct _slot
+  {
+    std::atomic<size_t> sequence{0};
+    detail::result_queue_item<result_type> item;
+  };
+  alignas(64) std::atomic<size_t> _head{0};
+  alignas(64) std::atomic<size_t> _tail{0};
+  alignas(64) _slot _slots[N];
+
+  /* How many slots from pos onwards are in the state awaiting, up to n. If none are because the slot at
+  pos is already past that state, another thread claimed pos after it was read, and stale is set.
+  */
+  size_t _ready(size_t pos, size_t n, size_t awaiting, bool &stale) const noexcept
+  {
+    size_t count = 0;
+    stale = false;
+    for(; count < n; count++)
+    {
+      const size_t p = pos + count;
+      const auto diff = static_cast<ptrdiff_t>(_slots[p & (N - 1)].sequence.load(std::memory_order_acquire) - (p - (p & (N - 1)) + awaiting));
+      if(diff != 0)
+      {
+        stale = (count == 0 && diff > 0);
+        break;
+      }
+    }
+    return count;
+  }
+
+public:
+  //! Constructs an empty queue.
+  mpmc_result_queue() noexcept {}  // NOLINT
+  mpmc_result_queue(const mpmc_result_queue &) = delete;
+  mpmc_result_queue &operator=(const mpmc_result_queue &) = delete;
+  //! Destroys any results still queued. No thread may be using the queue.
+  ~mpmc_result_queue()
+  {
+    for(size_t pos = _tail.load(std::memory_order_relaxed), head = _head.load(std::memory_order_relaxed); pos != head; pos++)
+    {
+      _slots[pos & (N - 1)].item.destroy();
+    }
+  }
+
+  /*! Pushes up to `n` results constructed from `*first`, `*++first` and so on, to move them in use
+  `std::make_move_iterator()`. The results pushed are consecutive in the queue.
+  \returns How many were pushed, which is less than `n` if the queue became full.
+  */
+  template <class InputIt> size_t try_push_n(InputIt first, size_t n) noexcept
+  {
+    static_assert(detail::result_queue_nothrow_push<result_type, InputIt>, "Pushing must not throw, so move the results in");
+    size_t pos = _head.load(std::memory_order_relaxed);
+    size_t count;
+    bool stale;
+    do
+    {
+      // A slot awaiting this lap's push stays so until its position is claimed
+      count = _ready(pos, n, 0, stale);
+      if(count == 0)
+      {
+        if(!stale)
+        {
+          return 0;
+        }
+        pos = _head.load(std::memory_order_relaxed);
+      }
+    } while(count == 0 || !_head.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed));
+    for(size_t i = 0; i < count; i++, ++first)
+    {
+      const size_t p = pos + i;
+      _slot &s = _slots[p & (N - 1)];
+      s.item.construct(*first);
+      s.sequence.store(p - (p & (N - 1)) + 1, std::memory_order_release);
+    }
+    return count;
+  }
+  /*! Pushes a result.
+  \returns False if the queue was full.
+  */
+  bool try_push(result_type &&r) noexcept { return try_push_n(std::make_move_iterator(std::addressof(r)), 1) == 1; }
+  //! \group try_push
+  bool try_push(const result_type &r) noexcept { return try_push_n(std::addressof(r), 1) == 1; }
+
+  /*! Pops up to `n` consecutive results, assigning each to `*out` then incrementing `out`.
+  \returns How many were popped, which is less than `n` if the queue became empty.
+  */
+  template <class OutputIt> size_t try_pop_n(OutputIt out, size_t n) noexcept
+  {
+    static_assert(detail::result_queue_nothrow_pop<result_type>, "Popping must not throw");
+    size_t pos = _tail.load(std::memory_order_relaxed);
+    size_t count;
+    bool stale;
+    do
+    {
+      count = _ready(pos, n, 1, stale);
+      if(count == 0)
+      {
+        if(!stale)
+        {
+          return 0;
+        }
+        pos = _tail.load(std::memory_order_relaxed);
+      }
+    } while(count == 0 || !_tail.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed));
+    for(size_t i = 0; i < count; i++, ++out)
+    {
+      const size_t p = pos + i;
+      _slot &s = _slots[p & (N - 1)];
+      s.item.extract(*out);
+      s.sequence.store(p - (p & (N - 1)) + N, std::memory_order_release);
+    }
+    return count;
+  }
+  /*! Pops the oldest result into `r`.
+  \returns False if the queue was empty.
+  */
+  bool try_pop(result_type &r) noexcept { return try_pop_n(std::addressof(r), 1) == 1; }
+};
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,445 @@
+/* A structure of arrays container of results
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_RESULT_VECTOR_HPP
+#define OUTCOME_RESULT_VECTOR_HPP
+
+#include "result.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#if !defined(__GNUC__) && !defined(__clang__) && defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+#ifndef OUTCOME_RESULT_VECTOR_PREFETCH_DISTANCE
+/*! The number of items ahead of the block being visited whose values or errors are prefetched by the
+iteration of `result_vector`, unless another distance is passed. Rounded up to a multiple of sixty-four.
+Zero, the default, turns the prefetching off, as the hardware prefetchers of most CPUs already follow
+a sequential stream. `benchmark/prefetch.cpp` measures which distance, if any, helps on a machine.
+*/
+#define OUTCOME_RESULT_VECTOR_PREFETCH_DISTANCE 0
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  inline size_t result_vector_popcount(uint64_t v) noexcept
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_t>(__builtin_popcountll(v));
+#else
+    size_t ret = 0;
+    for(; v != 0; v &= v - 1)
+    {
+      ++ret;
+    }
+    return ret;
+#endif
+  }
+  // v must not be zero
+  inline size_t result_vector_lowest_bit(uint64_t v) noexcept
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_t>(__builtin_ctzll(v));
+#else
+    size_t ret = 0;
+    for(; (v & 1U) == 0; v >>= 1U)
+    {
+      ++ret;
+    }
+    return ret;
+#endif
+  }
+  inline void result_vector_prefetch_line(uintptr_t addr) noexcept
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(reinterpret_cast<const void *>(addr), 0, 3);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch(reinterpret_cast<const char *>(addr), _MM_HINT_T0);
+#else
+    (void) addr;
+#endif
+  }
+  // Prefetches each cache line holding any of items[n] for the bits n set in live, each line once
+  template <class U> inline void result_vector_prefetch(const U *items, uint64_t live) noexcept
+  {
+    constexpr uintptr_t line = 64;
+    const uintptr_t base = reinterpret_cast<uintptr_t>(items);
+    if(live == 0)
+    {
+      return;
+    }
+    if(sizeof(U) < line)
+    {
+      // Visit the few lines under the sixty-four items, rather than each item
+      for(uintptr_t addr = base & ~(line - 1); addr < base + 64 * sizeof(U); addr += line)
+      {
+        const uintptr_t first = (addr > base) ? (addr - base) / sizeof(U) : 0;
+        const uintptr_t last = (std::min)((addr + line - 1 - base) / sizeof(U), uintptr_t(63));
+        const uint64_t under = (~uint64_t(0) >> (63 - last)) & (~uint64_t(0) << first);
+        if((live & under) != 0)
+        {
+          result_vector_prefetch_line(addr);
+        }
+      }
+      return;
+    }
+    for(; live != 0; live &= live - 1)
+    {
+      const uintptr_t begin = base + result_vector_lowest_bit(live) * sizeof(U);
+      for(uintptr_t addr = begin & ~(line - 1); addr < begin + sizeof(U); addr += line)
+      {
+        result_vector_prefetch_line(addr);
+      }
+    }
+  }
+}  // namespace detail
+
+/*! A container of `result<T, E, NoValuePolicy>` laid out as a structure of arrays. The values, the
+errors and a bitmap of which items failed are kept in three separate arrays. Scans for failures such
+as `all_succeeded()`, `first_failure()` and `count_failures()` touch only the bitmap, one bit per item.
+The iterations `for_each_value()`, `for_each_error()` and `unwrap_all()` can use the bitmap to
+prefetch the values or errors they will visit next, without fetching the cache lines of the others.
+
+Every item is either valued or errored. Slots not in use hold a default constructed `T` or `E`, so
+both must be default constructible. Items are handed out as proxies which observe and assign the
+item in place, and which convert into a `result`.
+*/
+template <class T, class E = std::error_code, class NoValuePolicy = policy::default_policy<T, E, void>> class result_vector
+{
+  static_assert(!std::is_void<T>::value && !std::is_void<E>::value, "result_vector does not support void value or error types");
+  static_assert(std::is_default_constructible<T>::value && std::is_default_constructible<E>::value, "result_vector requires default constructible value and error types");
+
+public:
+  //! The result type stored.
+  using result_type = result<T, E, NoValuePolicy>;
+  //! The value type.
+  using value_type = T;
+  //! The error type.
+  using error_type = E;
+  //! The size type.
+  using size_type = size_t;
+
+private:
+  static constexpr size_type _bits = 64;
+  std::vector<value_type> _values;
+  std::vector<error_type> _errors;
+  // Bit set if errored, bits past the end are always zero
+  std::vector<uint64_t> _failed;
+
+  bool _is_failed(size_type idx) const noexcept { return ((_failed[idx / _bits] >> (idx % _bits)) & 1U) != 0; }
+  void _set_failed(size_type idx, bool v) noexcept
+  {
+    const uint64_t mask = uint64_t(1) << (idx % _bits);
+    _failed[idx / _bits] = v ? (_failed[idx / _bits] | mask) : (_failed[idx / _bits] & ~mask);
+  }
+  void _grow_bitmap(size_type n)
+  {
+    if(_failed.size() * _bits < n)
+    {
+      _failed.push_back(0);
+    }
+  }
+  // The bits of word w of the bitmap which are set for items in use
+  uint64_t _in_use(size_type w) const noexcept { return ((w + 1) * _bits <= size()) ? ~uint64_t(0) : ((uint64_t(1) << (size() % _bits)) - 1); }
+  template <bool Failed> uint64_t _select(size_type w) const noexcept { return Failed ? _failed[w] : (~_failed[w] & _in_use(w)); }
+  // The number of words of the bitmap ahead of the one being visited to prefetch
+  static size_type _prefetch_words(size_type distance) noexcept { return (distance + _bits - 1) / _bits; }
+  template <bool Failed, class U> void _prefetch(const U *items, size_type w) const noexcept
+  {
+    if(w < _failed.size())
+    {
+      detail::result_vector_prefetch(items + w * _bits, _select<Failed>(w));
+    }
+  }
+  // Calls f(idx, items[idx]) for each item errored if Failed, else valued
+  template <bool Failed, class U, class F> void _for_each(U *items, F &f, size_type distance) const
+  {
+    const size_type ahead = _prefetch_words(distance);
+    for(size_type w = 0; w < ahead && w < _failed.size(); w++)
+    {
+      _prefetch<Failed>(items, w);
+    }
+    for(size_type w = 0; w < _failed.size(); w++)
+    {
+      if(ahead != 0)
+      {
+        _prefetch<Failed>(items, w + ahead);
+      }
+      for(uint64_t m = _select<Failed>(w); m != 0; m &= m - 1)
+      {
+        const size_type idx = w * _bits + detail::result_vector_lowest_bit(m);
+        f(idx, items[idx]);
+      }
+    }
+  }
+  template <class Self> class _reference_base
+  {
+  protected:
+    Self *_parent;
+    size_type _idx;
+
+    constexpr _reference_base(Self *parent, size_type idx) noexcept : _parent(parent), _idx(idx) {}
+    // Invokes the result's wide value check by constructing a failed result
+    void _value_check() const
+    {
+      if(has_error())
+      {
+        result_type(in_place_type<error_type>, _parent->_errors[_idx]).value();
+      }
+    }
+    void _error_check() const
+    {
+      if(has_value())
+      {
+        result_type(in_place_type<value_type>, _parent->_values[_idx]).error();
+      }
+    }
+
+  public:
+    //! True if the item is valued.
+    bool has_value() const noexcept { return !_parent->_is_failed(_idx); }
+    //! True if the item is errored.
+    bool has_error() const noexcept { return _parent->_is_failed(_idx); }
+    //! \group reference_bool
+    explicit operator bool() const noexcept { return has_value(); }
+    //! Access the value without runtime checks.
+    decltype(auto) assume_value() const noexcept { return _parent->_values[_idx]; }
+    //! Access the error without runtime checks.
+    decltype(auto) assume_error() const noexcept { return _parent->_errors[_idx]; }
+    //! Access the value, with the same checks as `result_type::value()`.
+    decltype(auto) value() const
+    {
+      _value_check();
+      return _parent->_values[_idx];
+    }
+    //! Access the error, with the same checks as `result_type::error()`.
+    decltype(auto) error() const
+    {
+      _error_check();
+      return _parent->_errors[_idx];
+    }
+    //! Returns a copy of the item as a `result`.
+    operator result_type() const  // NOLINT
+    {
+      return has_value() ? result_type(in_place_type<value_type>, _parent->_values[_idx]) : result_type(in_place_type<error_type>, _parent->_errors[_idx]);
+    }
+  };
+
+public:
+  //! A proxy observing an item in place.
+  class const_reference : public _reference_base<const result_vector>
+  {
+    friend class result_vector;
+    using _base = _reference_base<const result_vector>;
+    using _base::_base;
+  };
+  //! A proxy observing and assigning an item in place.
+  class reference : public _reference_base<result_vector>
+  {
+    friend class result_vector;
+    using _base = _reference_base<result_vector>;
+    using _base::_base;
+
+  public:
+    //! Converts to a read only proxy.
+    operator const_reference() const noexcept { return const_reference(this->_parent, this->_idx); }  // NOLINT
+    //! Assigns a result to the item.
+    reference &operator=(const result_type &o)
+    {
+      this->_parent->_assign(this->_idx, o);
+      return *this;
+    }
+    //! \group reference_assign
+    reference &operator=(result_type &&o)
+    {
+      this->_parent->_assign(this->_idx, std::move(o));
+      return *this;
+    }
+  };
+
+  //! Default constructs an empty container.
+  result_vector() = default;
+
+  //! The number of items.
+  size_type size() const noexcept { return _values.size(); }
+  //! True if there are no items.
+  bool empty() const noexcept { return _values.empty(); }
+  //! Reserves storage for at least `n` items.
+  void reserve(size_type n)
+  {
+    _values.reserve(n);
+    _errors.reserve(n);
+    _failed.reserve((n + _bits - 1) / _bits);
+  }
+  //! Removes all items.
+  void clear() noexcept
+  {
+    _values.clear();
+    _errors.clear();
+    _failed.clear();
+  }
+
+  /*! Appends a result.
+  \requires `r` to be valued or errored.
+  */
+  void push_back(const result_type &r)
+  {
+    _grow_bitmap(size() + 1);
+    if(r.has_value())
+    {
+      _values.push_back(r.assume_value());
+      _errors.emplace_back();
+    }
+    else
+    {
+      _values.emplace_back();
+      _errors.push_back(r.assume_error());
+    }
+    _set_failed(size() - 1, !r.has_value());
+  }
+  //! \group push_back
+  void push_back(result_type &&r)
+  {
+    _grow_bitmap(size() + 1);
+    if(r.has_value())
+    {
+      _values.push_back(std::move(r).assume_value());
+      _errors.emplace_back();
+    }
+    else
+    {
+      _values.emplace_back();
+      _errors.push_back(std::move(r).assume_error());
+    }
+    _set_failed(size() - 1, !r.has_value());
+  }
+
+  //! \group index
+  reference operator[](size_type idx) noexcept { return reference(this, idx); }
+  //! \group index
+  const_reference operator[](size_type idx) const noexcept { return const_reference(this, idx); }
+
+  //! True if no item has failed. Only reads the bitmap.
+  bool all_succeeded() const noexcept
+  {
+    for(uint64_t word : _failed)
+    {
+      if(word != 0)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+  //! The index of the first failed item, or `size()` if none failed. Only reads the bitmap.
+  size_type first_failure() const noexcept
+  {
+    for(size_type n = 0; n < _failed.size(); n++)
+    {
+      if(_failed[n] != 0)
+      {
+        return n * _bits + detail::result_vector_lowest_bit(_failed[n]);
+      }
+    }
+    return size();
+  }
+  //! The number of failed items. Only reads the bitmap.
+  size_type count_failures() const noexcept
+  {
+    size_type ret = 0;
+    for(uint64_t word : _failed)
+    {
+      ret += detail::result_vector_popcount(word);
+    }
+    return ret;
+  }
+
+  /*! Calls `f(idx, value)` for each valued item in order, where `idx` is its index. The values of
+  the valued items in the `prefetch_distance` items after the block of sixty-four being visited are
+  prefetched, if it is not zero, and the cache lines holding only the values of errored items are
+  not, so a batch far larger than the cache can be streamed without waiting on memory.
+  */
+  template <class F> void for_each_value(F &&f, size_type prefetch_distance = OUTCOME_RESULT_VECTOR_PREFETCH_DISTANCE) const { _for_each<false>(_values.data(), f, prefetch_distance); }
+  //! \group for_each_value
+  template <class F> void for_each_value(F &&f, size_type prefetch_distance = OUTCOME_RESULT_VECTOR_PREFETCH_DISTANCE) { _for_each<false>(_values.data(), f, prefetch_distance); }
+  //! As `for_each_value()`, but calls `f(idx, error)` for each errored item, prefetching their errors.
+  template <class F> void for_each_error(F &&f, size_type prefetch_distance = OUTCOME_RESULT_VECTOR_PREFETCH_DISTANCE) const { _for_each<true>(_errors.data(), f, prefetch_distance); }
+  //! \group for_each_error
+  template <class F> void for_each_error(F &&f, size_type prefetch_distance = OUTCOME_RESULT_VECTOR_PREFETCH_DISTANCE) { _for_each<true>(_errors.data(), f, prefetch_distance); }
+
+  /*! Copies the values of the items to `out`, in order, stopping at the first errored item. The
+  values are prefetched `prefetch_distance` items ahead as for `for_each_value()`.
+  \returns `size()`, or the error of the first errored item, in which case the values of the items
+  before it have been written.
+  */
+  template <class OutputIt> result<size_type, error_type> unwrap_all(OutputIt out, size_type prefetch_distance = OUTCOME_RESULT_VECTOR_PREFETCH_DISTANCE) const
+  {
+    const size_type ahead = _prefetch_words(prefetch_distance);
+    for(size_type w = 0; w < ahead && w < _failed.size(); w++)
+    {
+      _prefetch<false>(_values.data(), w);
+    }
+    for(size_type w = 0; w < _failed.size(); w++)
+    {
+      if(ahead != 0)
+      {
+        _prefetch<false>(_values.data(), w + ahead);
+      }
+      // Every item of the word in use is copied unchecked, or those before its first failure
+      const size_type begin = w * _bits;
+      const size_type end = (_failed[w] == 0) ? (std::min)(begin + _bits, size()) : begin + detail::result_vector_lowest_bit(_failed[w]);
+      for(size_type idx = begin; idx < end; idx++)
+      {
+        *out++ = _values[idx];
+      }
+      if(_failed[w] != 0)
+      {
+        return result<size_type, error_type>(in_place_type<error_type>, _errors[end]);
+      }
+    }
+    return result<size_type, error_type>(in_place_type<size_type>, size());
+  }
+
+private:
+  template <class R> void _assign(size_type idx, R &&r)
+  {
+    if(r.has_value())
+    {
+      _values[idx] = std::forward<R>(r).assume_value();
+    }
+    else
+    {
+      _errors[idx] = std::forward<R>(r).assume_error();
+    }
+    _set_failed(idx, !r.has_value());
+  }
+};
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,177 @@
+/* Retrying operations returning results, with jittered exponential backoff
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_RETRY_HPP
+#define OUTCOME_RETRY_HPP
+
+#include "error_equivalence.hpp"
+
+#include <chrono>
+#include <system_error>
+#include <thread>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+//! Classifies every error as retryable.
+struct retry_always
+{
+  template <class E> constexpr bool operator()(const E & /*unused*/) const noexcept { return true; }
+};
+
+namespace detail
+{
+  // A xorshift64* generator per thread, for jitter, which never allocates
+  inline uint64_t retry_random() noexcept
+  {
+    static thread_local uint64_t state = 0;
+    if(state == 0)
+    {
+      state = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(&state)) ^ static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()) ^ 0x9e3779b97f4a7c15ULL;
+      state = (state != 0) ? state : 1;
+    }
+    state ^= state >> 12U;
+    state ^= state << 25U;
+    state ^= state >> 27U;
+    return state * 0x2545f4914f6cdd1dULL;
+  }
+}  // namespace detail
+
+/*! Classifies as retryable the errors equivalent to one of `N` error conditions, such as
+`std::errc::connection_refused`. The errors must be `std::error_code`, or have an ADL discovered
+`make_error_code()`. Equivalence is looked up with `cached_equivalent()`. See `retry_on()`.
+*/
+template <size_t N> struct retry_on_conditions
+{
+  //! The conditions of retryable errors.
+  std::error_condition conditions[N];
+
+  template <class E> bool operator()(const E &e) const noexcept
+  {
+    const std::error_code ec = detail::equivalence_error_code(e);
+    for(const auto &c : conditions)
+    {
+      if(cached_equivalent(ec, c))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+//! Classifies as retryable the errors equivalent to any of `conditions`.
+template <class... Conditions> inline retry_on_conditions<sizeof...(Conditions)> retry_on(Conditions... conditions) noexcept { return {{std::error_condition(conditions)...}}; }
+
+/*! How to retry: which errors to retry, how many attempts to make, and how long to back off between
+them. The backoff after attempt `n` is drawn uniformly from between zero and `initial_backoff`
+doubled `n - 1` times, at most `max_backoff`, which is exponential backoff with full jitter.
+*/
+template <class Retryable = retry_always> struct retry_policy
+{
+  //! Called with the error of a failed attempt, returns true if it is worth retrying.
+  Retryable retryable{};
+  //! The most attempts to make, including the first.
+  unsigned max_attempts{3};
+  //! The backoff after the first attempt, before jitter.
+  std::chrono::nanoseconds initial_backoff{std::chrono::milliseconds(10)};
+  //! The most backoff after any attempt, before jitter.
+  std::chrono::nanoseconds max_backoff{std::chrono::seconds(1)};
+
+  //! The backoff after the failure of attempt `attempt`, counting from one.
+  std::chrono::nanoseconds backoff(unsigned attempt) const noexcept
+  {
+    auto cap = initial_backoff.count();
+    for(unsigned n = 1; n < attempt && cap < max_backoff.count(); n++)
+    {
+      cap *= 2;
+    }
+    if(cap > max_backoff.count())
+    {
+      cap = max_backoff.count();
+    }
+    if(cap <= 0)
+    {
+      return std::chrono::nanoseconds(0);
+    }
+    return std::chrono::nanoseconds(static_cast<std::chrono::nanoseconds::rep>(detail::retry_random() % (static_cast<uint64_t>(cap) + 1)));
+  }
+};
+//! A `retry_policy` retrying the errors `retryable` returns true for.
+template <class Retryable> inline retry_policy<std::decay_t<Retryable>> make_retry_policy(Retryable &&retryable, unsigned max_attempts = 3, std::chrono::nanoseconds initial_backoff = std::chrono::milliseconds(10), std::chrono::nanoseconds max_backoff = std::chrono::seconds(1))
+{
+  return {std::forward<Retryable>(retryable), max_attempts, initial_backoff, max_backoff};
+}
+
+//! Backs off by sleeping the calling thread.
+struct retry_sleep
+{
+  void operator()(std::chrono::nanoseconds d) const { std::this_thread::sleep_for(d); }
+};
+
+namespace detail
+{
+  template <class R> inline void retry_record_attempts(R &r, unsigned attempts) noexcept
+  {
+#ifndef OUTCOME_ENABLE_COMPACT_STATUS
+    hooks::set_spare_storage(&r, static_cast<uint16_t>((attempts < 0xffffU) ? attempts : 0xffffU));
+#else
+    (void) r;
+    (void) attempts;
+#endif
+  }
+}  // namespace detail
+
+/*! Calls `f()` until it returns a value, it fails with an error `policy.retryable` does not return
+true for, or `policy.max_attempts` attempts have been made, calling `sleep(policy.backoff(n))` between
+attempts. Nothing is allocated between attempts. Failures with an exception are not retried.
+
+The number of attempts made is recorded in the spare storage of the result returned, see
+`retry_attempts()`. This shares the spare storage with anything else using it, such as
+`error_site`, replacing what `f()` put there.
+\returns The result of the last attempt.
+*/
+template <class Retryable, class F, class Sleep = retry_sleep> inline auto retry(const retry_policy<Retryable> &policy, F &&f, Sleep &&sleep = Sleep()) -> std::decay_t<decltype(f())>
+{
+  using result_type = std::decay_t<decltype(f())>;
+  for(unsigned attempt = 1;; attempt++)
+  {
+    result_type r = f();
+    if(r.has_value() || !r.has_error() || attempt >= policy.max_attempts || !policy.retryable(r.assume_error()))
+    {
+      detail::retry_record_attempts(r, attempt);
+      return r;
+    }
+    sleep(policy.backoff(attempt));
+  }
+}
+
+/*! The number of attempts `retry()` made to produce `r`, read from its spare storage, and so always
+zero where there is none. Nothing marks who wrote the spare storage, so for a result which did not
+come from `retry()`, or whose spare storage was written since, such as by `error_site`, this is
+whatever it holds instead, which is zero only if nothing set it.
+*/
+template <class R, class S, class NoValuePolicy> constexpr inline uint16_t retry_attempts(const detail::result_final<R, S, NoValuePolicy> &r) noexcept { return hooks::spare_storage(&r); }
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,125 @@
+/* Hooks which can be switched on and off at runtime
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_RUNTIME_HOOKS_HPP
+#define OUTCOME_RUNTIME_HOOKS_HPP
+
+#include "result.hpp"
+#include "tracepoints.hpp"
+
+#include <atomic>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+//! The kinds of event passed to a `runtime_hook`.
+enum class runtime_hook_kind : uint8_t
+{
+  success,  //!< A valued result was constructed.
+  failure,  //!< A result without a value was constructed.
+  copy,     //!< A result was copy constructed from a compatible result.
+  move      //!< A result was move constructed from a compatible result.
+};
+
+//! An event passed to a `runtime_hook`.
+struct runtime_hook_event
+{
+  //! What happened.
+  runtime_hook_kind kind;
+  //! The `result` or `outcome` constructed.
+  const void *object;
+  //! The address of the category of its error, as for `trace_failure()`, or null.
+  const void *category;
+  //! The value of its error, as for `trace_failure()`, or zero.
+  long code;
+};
+
+//! A function called by `policy::runtime_hooks` on every event. Must not throw.
+using runtime_hook = void (*)(const runtime_hook_event &);
+
+namespace detail
+{
+  // A template so the definition can live in a header, and constant initialised so no guard is checked
+  template <class T = void> struct runtime_hook_state
+  {
+    static std::atomic<runtime_hook> hook;
+  };
+  template <class T> std::atomic<runtime_hook> runtime_hook_state<T>::hook{nullptr};
+
+  template <class R> OUTCOME_COLD inline void runtime_hook_call(runtime_hook h, runtime_hook_kind kind, const R *r) noexcept
+  {
+    const tracepoint_error e = tracepoint_failure_of(*r, 0);
+    h(runtime_hook_event{kind, r, e.category, e.code});
+  }
+  // A relaxed load and a branch which always predicts the same way whilst no hook is set
+  template <class R> inline void runtime_hook_dispatch(runtime_hook_kind kind, const R *r) noexcept
+  {
+    const runtime_hook h = runtime_hook_state<>::hook.load(std::memory_order_relaxed);
+    if(OUTCOME_UNLIKELY(h != nullptr))
+    {
+      runtime_hook_call(h, kind, r);
+    }
+  }
+  template <class R> inline void runtime_hook_dispatch_construction(const R *r) noexcept { runtime_hook_dispatch(r->has_value() ? runtime_hook_kind::success : runtime_hook_kind::failure, r); }
+}  // namespace detail
+
+/*! Sets the function which every result using `policy::runtime_hooks` calls on each event, or
+turns the hooks off if `h` is null. Safe to call at any time from any thread, so telemetry can be
+turned on and off in a running process. A result being constructed concurrently may call either
+the old function or the new one.
+\returns The function previously set, or null.
+*/
+inline runtime_hook set_runtime_hook(runtime_hook h) noexcept { return detail::runtime_hook_state<>::hook.exchange(h, std::memory_order_acq_rel); }
+//! The function set by `set_runtime_hook()`, or null.
+inline runtime_hook current_runtime_hook() noexcept { return detail::runtime_hook_state<>::hook.load(std::memory_order_relaxed); }
+
+namespace policy
+{
+  /*! Hook policy which calls the `runtime_hook` set by `set_runtime_hook()`, if any, on the
+  construction of a result, and on its copy or move construction from a compatible result. Whilst
+  no hook is set, each event costs a relaxed load of a pointer and a branch which always predicts
+  correctly. Attach it with `with_hooks<>`, or use `runtime_hooked_result`.
+  */
+  struct runtime_hooks : no_hooks
+  {
+    //! Reports a `success` or `failure` event.
+    template <class T, class U> static void on_construction(T *r, U && /*unused*/) noexcept { OUTCOME_V2_NAMESPACE::detail::runtime_hook_dispatch_construction(r); }
+    //! Reports a `copy` event.
+    template <class T, class U> static void on_copy_construction(T *r, U && /*unused*/) noexcept { OUTCOME_V2_NAMESPACE::detail::runtime_hook_dispatch(runtime_hook_kind::copy, r); }
+    //! Reports a `move` event.
+    template <class T, class U> static void on_move_construction(T *r, U && /*unused*/) noexcept { OUTCOME_V2_NAMESPACE::detail::runtime_hook_dispatch(runtime_hook_kind::move, r); }
+    //! Reports a `success` or `failure` event.
+    template <class T, class... Args> static void on_in_place_construction(T *r, Args &&... /*unused*/) noexcept { OUTCOME_V2_NAMESPACE::detail::runtime_hook_dispatch_construction(r); }
+  };
+}  // namespace policy
+
+//! A `result<T, E>` with the default policy, which calls the hook set by `set_runtime_hook()`.
+#ifdef OUTCOME_RESULT_LITE
+template <class T, class E> using runtime_hooked_result = result<T, E, policy::with_hooks<policy::default_policy<T, E, void>, policy::runtime_hooks>>;
+#else
+template <class T, class E = std::error_code> using runtime_hooked_result = result<T, E, policy::with_hooks<policy::default_policy<T, E, void>, policy::runtime_hooks>>;
+#endif
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
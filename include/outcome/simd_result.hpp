@@ -0,0 +1,246 @@
+/* A batch of results computed a vector of lanes at a time
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_SIMD_RESULT_HPP
+#define OUTCOME_SIMD_RESULT_HPP
+
+#include "result_vector.hpp"
+
+#include <array>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  // The smallest unsigned integer with a bit per lane
+  template <size_t N>
+  using simd_result_mask_t = std::conditional_t<(N <= 8), uint8_t, std::conditional_t<(N <= 16), uint16_t, std::conditional_t<(N <= 32), uint32_t, uint64_t>>>;
+}  // namespace detail
+
+/*! `N` results of `result<T, E, NoValuePolicy>` laid out for SIMD: an array of `N` values, an array
+of `N` errors, and a mask with a bit set for each failed lane, much as `status_bitfield_type` holds
+the state of a single `result`.
+
+The combinators `map()`, `and_then()` and `combine()` run their callable on every lane, failed or
+not, and propagate failures by merging masks rather than by branching, so that loops over lanes of
+arithmetic types vectorise. The callable therefore sees the value of failed lanes too, which is a
+default constructed `T` unless set otherwise, and must be safe to call on it. A lane which fails
+keeps its first error.
+
+Every lane is either valued or errored. Both `T` and `E` must be default constructible.
+*/
+template <class T, size_t N, class E = std::error_code, class NoValuePolicy = policy::default_policy<T, E, void>> class simd_result
+{
+  static_assert(N >= 1 && N <= 64, "simd_result supports between 1 and 64 lanes");
+  static_assert(!std::is_void<T>::value && !std::is_void<E>::value, "simd_result does not support void value or error types");
+  static_assert(std::is_default_constructible<T>::value && std::is_default_constructible<E>::value, "simd_result requires default constructible value and error types");
+
+  template <class U, size_t M, class F, class P> friend class simd_result;
+
+public:
+  //! The result type of each lane.
+  using result_type = result<T, E, NoValuePolicy>;
+  //! The value type.
+  using value_type = T;
+  //! The error type.
+  using error_type = E;
+  //! The type of the failure mask, with a bit per lane.
+  using mask_type = detail::simd_result_mask_t<N>;
+  //! The number of lanes.
+  static constexpr size_t lanes = N;
+  //! The mask with a bit set for every lane.
+  static constexpr mask_type all_lanes = static_cast<mask_type>((N == 64) ? ~uint64_t(0) : ((uint64_t(1) << N) - 1));
+
+private:
+  std::array<value_type, N> _values{};
+  std::array<error_type, N> _errors{};
+  // Bit set if errored, bits past the last lane are always zero
+  mask_type _failed{0};
+
+  static constexpr mask_type _bit(size_t lane) noexcept { return static_cast<mask_type>(mask_type(1) << lane); }
+  bool _is_failed(size_t lane) const noexcept { return ((_failed >> lane) & 1U) != 0; }
+  // Invokes the result's wide checks by constructing a lane as a result
+  void _value_check(size_t lane) const
+  {
+    if(_is_failed(lane))
+    {
+      result_type(in_place_type<error_type>, _errors[lane]).value();
+    }
+  }
+  void _error_check(size_t lane) const
+  {
+    if(!_is_failed(lane))
+    {
+      result_type(in_place_type<value_type>, _values[lane]).error();
+    }
+  }
+
+public:
+  //! Default constructs every lane valued with a default constructed `T`.
+  simd_result() = default;
+  //! Constructs every lane valued from `values`.
+  explicit simd_result(const std::array<value_type, N> &values)
+      : _values(values)
+  {
+  }
+  //! Gathers `N` results into lanes.
+  explicit simd_result(const std::array<result_type, N> &results)
+  {
+    for(size_t n = 0; n < N; n++)
+    {
+      if(results[n].has_value())
+      {
+        _values[n] = results[n].assume_value();
+      }
+      else
+      {
+        _errors[n] = results[n].assume_error();
+        _failed |= _bit(n);
+      }
+    }
+  }
+
+  //! Makes a lane valued.
+  void set_value(size_t lane, value_type v)
+  {
+    _values[lane] = std::move(v);
+    _failed &= static_cast<mask_type>(~_bit(lane));
+  }
+  //! Makes a lane errored.
+  void set_error(size_t lane, error_type e)
+  {
+    _errors[lane] = std::move(e);
+    _failed |= _bit(lane);
+  }
+
+  //! A bit set for every errored lane.
+  constexpr mask_type failure_mask() const noexcept { return _failed; }
+  //! A bit set for every valued lane.
+  constexpr mask_type success_mask() const noexcept { return static_cast<mask_type>(~_failed & all_lanes); }
+  //! True if no lane has failed.
+  constexpr bool all_succeeded() const noexcept { return _failed == 0; }
+  //! True if any lane has failed.
+  constexpr bool any_failed() const noexcept { return _failed != 0; }
+  //! The number of failed lanes.
+  size_t count_failures() const noexcept { return detail::result_vector_popcount(_failed); }
+  //! The first failed lane, or `N` if none failed.
+  size_t first_failure() const noexcept { return (_failed != 0) ? detail::result_vector_lowest_bit(_failed) : N; }
+
+  //! True if the lane is valued.
+  bool has_value(size_t lane) const noexcept { return !_is_failed(lane); }
+  //! True if the lane is errored.
+  bool has_error(size_t lane) const noexcept { return _is_failed(lane); }
+  //! The values of all lanes, including those which failed.
+  constexpr const std::array<value_type, N> &values() const noexcept { return _values; }
+  //! The errors of all lanes, default constructed in those which did not fail.
+  constexpr const std::array<error_type, N> &errors() const noexcept { return _errors; }
+  //! Access the value of a lane without runtime checks.
+  const value_type &assume_value(size_t lane) const noexcept { return _values[lane]; }
+  //! Access the error of a lane without runtime checks.
+  const error_type &assume_error(size_t lane) const noexcept { return _errors[lane]; }
+  //! Access the value of a lane, with the same checks as `result_type::value()`.
+  const value_type &value(size_t lane) const
+  {
+    _value_check(lane);
+    return _values[lane];
+  }
+  //! Access the error of a lane, with the same checks as `result_type::error()`.
+  const error_type &error(size_t lane) const
+  {
+    _error_check(lane);
+    return _errors[lane];
+  }
+  //! A lane as a `result`.
+  result_type operator[](size_t lane) const { return _is_failed(lane) ? result_type(in_place_type<error_type>, _errors[lane]) : result_type(in_place_type<value_type>, _values[lane]); }
+  //! Scatters the lanes into `N` results, for scalar code.
+  std::array<result_type, N> to_array() const
+  {
+    return _to_array(std::make_index_sequence<N>());
+  }
+
+  /*! Applies `f` to the value of every lane.
+  \returns A `simd_result` of the values returned by `f`, failed where this is failed.
+  */
+  template <class F> auto map(F &&f) const -> simd_result<std::decay_t<decltype(f(std::declval<const value_type &>()))>, N, E>
+  {
+    simd_result<std::decay_t<decltype(f(std::declval<const value_type &>()))>, N, E> ret;
+    for(size_t n = 0; n < N; n++)
+    {
+      ret._values[n] = f(_values[n]);
+    }
+    ret._errors = _errors;
+    ret._failed = _failed;
+    return ret;
+  }
+  /*! Applies `f`, returning a `result`, to the value of every lane.
+  \returns A `simd_result` of the values returned by `f`. A lane is failed if it was failed here,
+  with the error it had, or if `f` returned an error for it, with that error.
+  */
+  template <class F> auto and_then(F &&f) const -> simd_result<typename std::decay_t<decltype(f(std::declval<const value_type &>()))>::value_type, N, E>
+  {
+    using U = typename std::decay_t<decltype(f(std::declval<const value_type &>()))>::value_type;
+    simd_result<U, N, E> ret;
+    mask_type failed = 0;
+    for(size_t n = 0; n < N; n++)
+    {
+      auto r = f(_values[n]);
+      const bool ok = r.has_value();
+      ret._values[n] = ok ? std::move(r).assume_value() : U();
+      ret._errors[n] = ok ? error_type() : error_type(std::move(r).assume_error());
+      failed |= static_cast<mask_type>(mask_type(ok ? 0U : 1U) << n);
+    }
+    for(size_t n = 0; n < N; n++)
+    {
+      ret._errors[n] = _is_failed(n) ? _errors[n] : ret._errors[n];
+    }
+    ret._failed = static_cast<mask_type>(_failed | failed);
+    return ret;
+  }
+  /*! Applies `f` to the values of each lane of this and of `o`.
+  \returns A `simd_result` of the values returned by `f`. A lane is failed if it was failed in either
+  input, with the error it had here if failed here, else with the error it had in `o`.
+  */
+  template <class U, class P, class F> auto combine(const simd_result<U, N, E, P> &o, F &&f) const -> simd_result<std::decay_t<decltype(f(std::declval<const value_type &>(), std::declval<const U &>()))>, N, E>
+  {
+    simd_result<std::decay_t<decltype(f(std::declval<const value_type &>(), std::declval<const U &>()))>, N, E> ret;
+    // The values are computed in a loop of their own, so that it vectorises
+    for(size_t n = 0; n < N; n++)
+    {
+      ret._values[n] = f(_values[n], o._values[n]);
+    }
+    for(size_t n = 0; n < N; n++)
+    {
+      ret._errors[n] = _is_failed(n) ? _errors[n] : o._errors[n];
+    }
+    ret._failed = static_cast<mask_type>(_failed | o._failed);
+    return ret;
+  }
+
+private:
+  template <size_t... I> std::array<result_type, N> _to_array(std::index_sequence<I...> /*unused*/) const { return {{(*this)[I]...}}; }
+};
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,333 @@
+/* A trivially copyable error type whose domains and messages are usable in constant evaluation
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_STATUS_CODE_HPP
+#define OUTCOME_STATUS_CODE_HPP
+
+#include "result.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <system_error>
+
+#if defined(__has_include)
+#if __has_include(<version>)
+#include <version>
+#endif
+#endif
+#ifdef __cpp_lib_string_view
+#include <string_view>
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+/*! The domain of a `status_code`, which gives its values meaning. A literal type, so domains are
+defined as `constexpr` objects of static storage duration, and everything about them is usable in
+constant evaluation, including the messages of their codes:
+
+```c++
+constexpr const char *http_message(int c) noexcept { return c == 404 ? "not found" : "unknown"; }
+// In C++ 17, else use a static data member of a class template to get one object per program
+inline constexpr status_domain http_domain{0x5d4c8bd4a1e2f307, "http", http_message};
+```
+
+Domains are told apart by `id`, a random 64 bit number chosen by their author, so a domain
+duplicated per translation unit or per shared library still compares equal to itself.
+*/
+struct status_domain
+{
+  //! The unique identifier of the domain.
+  uint64_t id;
+  //! The name of the domain.
+  const char *name;
+  //! Returns the static, null terminated message of a code. May be evaluated at compile time.
+  const char *(*message)(int code) noexcept;
+  //! The equivalent `std::error_category`, or null for one to be synthesised on conversion.
+  const std::error_category &(*category)() noexcept;
+};
+
+namespace detail
+{
+  constexpr inline const char *generic_status_message(int code) noexcept
+  {
+    // The codes whose errno values are distinct on every platform, with POSIX's wording
+    switch(code)
+    {
+    case 0:
+      return "Success";
+    case EPERM:
+      return "Operation not permitted";
+    case ENOENT:
+      return "No such file or directory";
+    case ESRCH:
+      return "No such process";
+    case EINTR:
+      return "Interrupted system call";
+    case EIO:
+      return "Input/output error";
+    case ENXIO:
+      return "No such device or address";
+    case E2BIG:
+      return "Argument list too long";
+    case ENOEXEC:
+      return "Exec format error";
+    case EBADF:
+      return "Bad file descriptor";
+    case ECHILD:
+      return "No child processes";
+    case EAGAIN:
+      return "Resource temporarily unavailable";
+    case ENOMEM:
+      return "Cannot allocate memory";
+    case EACCES:
+      return "Permission denied";
+    case EFAULT:
+      return "Bad address";
+    case EBUSY:
+      return "Device or resource busy";
+    case EEXIST:
+      return "File exists";
+    case EXDEV:
+      return "Invalid cross-device link";
+    case ENODEV:
+      return "No such device";
+    case ENOTDIR:
+      return "Not a directory";
+    case EISDIR:
+      return "Is a directory";
+    case EINVAL:
+      return "Invalid argument";
+    case ENFILE:
+      return "Too many open files in system";
+    case EMFILE:
+      return "Too many open files";
+    case ENOTTY:
+      return "Inappropriate ioctl for device";
+    case EFBIG:
+      return "File too large";
+    case ENOSPC:
+      return "No space left on device";
+    case ESPIPE:
+      return "Illegal seek";
+    case EROFS:
+      return "Read-only file system";
+    case EMLINK:
+      return "Too many links";
+    case EPIPE:
+      return "Broken pipe";
+    case EDOM:
+      return "Numerical argument out of domain";
+    case ERANGE:
+      return "Numerical result out of range";
+    case EDEADLK:
+      return "Resource deadlock avoided";
+    case ENAMETOOLONG:
+      return "File name too long";
+    case ENOLCK:
+      return "No locks available";
+    case ENOSYS:
+      return "Function not implemented";
+    case ENOTEMPTY:
+      return "Directory not empty";
+    case ETIMEDOUT:
+      return "Connection timed out";
+    case ECONNREFUSED:
+      return "Connection refused";
+    case ECONNRESET:
+      return "Connection reset by peer";
+    case ECONNABORTED:
+      return "Software caused connection abort";
+    case EADDRINUSE:
+      return "Address already in use";
+    case EINPROGRESS:
+      return "Operation now in progress";
+    case ECANCELED:
+      return "Operation canceled";
+    case EOVERFLOW:
+      return "Value too large for defined data type";
+    default:
+      return "Unknown error";
+    }
+  }
+  // One object per program, as inline variables need C++ 17
+  template <class T = void> struct status_domains
+  {
+    static constexpr status_domain generic{0x746d6f6347e5a6d1ULL, "generic", generic_status_message, std::generic_category};
+  };
+  template <class T> constexpr status_domain status_domains<T>::generic;
+}  // namespace detail
+
+//! The domain of errno values, whose `std::error_category` is the generic category.
+constexpr inline const status_domain &generic_status_domain() noexcept
+{
+  return detail::status_domains<>::generic;
+}
+
+/*! A sixteen byte trivially copyable error type, a value in a `status_domain`, which unlike
+`std::error_code` can be constructed, compared and have its message fetched during constant
+evaluation, and whose message is a static string, so fetching it never allocates. A value of zero
+means success, as with `std::error_code`.
+
+`result<T, status_code>` is a literal type for literal `T`. It converts to `std::error_code`, so
+the default policy throws `std::system_error` on wide access of a missing value. Domains without
+a `std::error_category` of their own have one synthesised on conversion, of which there may be
+at most 64 per process.
+*/
+class status_code
+{
+  const status_domain *_domain{nullptr};
+  int _value{0};
+
+public:
+  //! Default constructs to success, with no domain.
+  constexpr status_code() noexcept = default;
+  //! Constructs a code of `value` in `domain`, which must outlive this.
+  constexpr status_code(int value, const status_domain &domain) noexcept
+      : _domain(&domain)
+      , _value(value)
+  {
+  }
+  //! Implicit construction from an errno value, in the generic domain.
+  constexpr status_code(std::errc e) noexcept  // NOLINT
+      : _domain(&generic_status_domain())
+      , _value(static_cast<int>(e))
+  {
+  }
+
+  //! The code value.
+  constexpr int value() const noexcept { return _value; }
+  //! The domain, or null if default constructed.
+  constexpr const status_domain *domain() const noexcept { return _domain; }
+  //! True if the value is not zero.
+  constexpr explicit operator bool() const noexcept { return _value != 0; }
+  //! True if in the generic domain, so the value is an errno value.
+  constexpr bool is_errno() const noexcept { return _domain != nullptr && _domain->id == generic_status_domain().id; }
+  //! The static, null terminated message of the code, which may be fetched during constant evaluation.
+  constexpr const char *message() const noexcept { return (_domain != nullptr) ? _domain->message(_value) : "Success"; }
+#ifdef __cpp_lib_string_view
+  //! \group message
+  constexpr std::string_view message_view() const noexcept { return message(); }
+#endif
+
+  /*! Converts to the equivalent `std::error_code`. A code in a domain without a category of its own
+  converts into `std::errc::not_supported` if 64 other such domains have already been converted.
+  */
+  std::error_code to_error_code() const noexcept;
+
+  //! True if both the value and the domain are equal.
+  friend constexpr bool operator==(status_code a, status_code b) noexcept { return a._value == b._value && _same_domain(a._domain, b._domain); }
+  //! True if either the value or the domain differ.
+  friend constexpr bool operator!=(status_code a, status_code b) noexcept { return !(a == b); }
+  //! \group status_code_compare
+  friend bool operator==(status_code a, const std::error_code &b) noexcept { return a.to_error_code() == b; }
+  //! \group status_code_compare
+  friend bool operator==(const std::error_code &a, status_code b) noexcept { return a == b.to_error_code(); }
+  //! \group status_code_compare
+  friend bool operator!=(status_code a, const std::error_code &b) noexcept { return a.to_error_code() != b; }
+  //! \group status_code_compare
+  friend bool operator!=(const std::error_code &a, status_code b) noexcept { return a != b.to_error_code(); }
+
+private:
+  static constexpr bool _same_domain(const status_domain *a, const status_domain *b) noexcept { return (a == nullptr || b == nullptr) ? a == b : a->id == b->id; }
+};
+static_assert(std::is_trivially_copyable<status_code>::value, "status_code is not trivially copyable!");
+
+namespace detail
+{
+  // Stands in for the std::error_category of a domain which has none
+  class status_domain_category : public std::error_category
+  {
+  public:
+    std::atomic<const status_domain *> domain{nullptr};
+
+    const char *name() const noexcept override { return domain.load(std::memory_order_acquire)->name; }
+    std::string message(int code) const override { return domain.load(std::memory_order_acquire)->message(code); }
+  };
+  static constexpr size_t status_domain_categories = 64;
+  inline status_domain_category *status_domain_category_registry() noexcept
+  {
+    static status_domain_category registry[status_domain_categories];
+    return registry;
+  }
+  // Returns null if the registry is full
+  inline const status_domain_category *status_domain_category_for(const status_domain &domain) noexcept
+  {
+    auto *registry = status_domain_category_registry();
+    for(size_t n = 0; n < status_domain_categories; n++)
+    {
+      const status_domain *current = registry[n].domain.load(std::memory_order_acquire);
+      if(current == nullptr && registry[n].domain.compare_exchange_strong(current, &domain, std::memory_order_acq_rel, std::memory_order_acquire))
+      {
+        return &registry[n];
+      }
+      // current is never null here, a failed exchange loads the winner
+      if(current->id == domain.id)
+      {
+        return &registry[n];
+      }
+    }
+    return nullptr;
+  }
+
+  template <class State> constexpr inline void _set_error_is_errno(State &state, const status_code &error)
+  {
+    if(error.is_errno())
+    {
+      state.set_status(state.status() | status_error_is_errno);
+    }
+  }
+}  // namespace detail
+
+inline std::error_code status_code::to_error_code() const noexcept
+{
+  if(_domain == nullptr)
+  {
+    return {};
+  }
+  if(_domain->category != nullptr)
+  {
+    return {_value, _domain->category()};
+  }
+  if(const auto *category = detail::status_domain_category_for(*_domain))
+  {
+    return {_value, *category};
+  }
+  return make_error_code(std::errc::not_supported);
+}
+
+//! Makes `trait::has_error_code_v<status_code>` true.
+inline std::error_code make_error_code(status_code sc) noexcept
+{
+  return sc.to_error_code();
+}
+
+//! Lets the policies throw a `status_code` as a `std::system_error` of the equivalent `std::error_code`.
+inline void throw_as_system_error_with_payload(status_code sc)
+{
+  OUTCOME_THROW_EXCEPTION(std::system_error(sc.to_error_code()));
+}
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
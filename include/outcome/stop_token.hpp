@@ -0,0 +1,156 @@
+/* Cooperative cancellation of chains of TRY operations
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_STOP_TOKEN_HPP
+#define OUTCOME_STOP_TOKEN_HPP
+
+#include "try.hpp"
+
+#include <atomic>
+#include <string>
+#include <system_error>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+//! The error codes of `cancellation_category()`.
+enum class cancellation_errc
+{
+  cancelled = 1  //!< The operation was cancelled by a stop request.
+};
+
+namespace detail
+{
+  class cancellation_category_impl : public std::error_category
+  {
+  public:
+    const char *name() const noexcept override { return "outcome.cancellation"; }
+    std::string message(int c) const override { return (c == static_cast<int>(cancellation_errc::cancelled)) ? "operation cancelled" : "unknown"; }
+    std::error_condition default_error_condition(int c) const noexcept override
+    {
+      if(c == static_cast<int>(cancellation_errc::cancelled))
+      {
+        return std::errc::operation_canceled;
+      }
+      return std::error_condition(c, *this);
+    }
+  };
+}  // namespace detail
+
+//! The category of the error codes returned when a chain of TRY operations is cancelled.
+inline const std::error_category &cancellation_category() noexcept
+{
+  static detail::cancellation_category_impl v;
+  return v;
+}
+//! Makes an error code of `cancellation_category()`, which compares equal to `std::errc::operation_canceled`.
+inline std::error_code make_error_code(cancellation_errc c) noexcept { return {static_cast<int>(c), cancellation_category()}; }
+
+class stop_source;
+
+/*! A view of whether a `stop_source` has been asked to stop. Checking costs one relaxed load, so
+it can be done between every step of a pipeline. A default constructed token never stops.
+*/
+class stop_token
+{
+  friend class stop_source;
+  const std::atomic<bool> *_flag{nullptr};
+
+  constexpr explicit stop_token(const std::atomic<bool> *flag) noexcept
+      : _flag(flag)
+  {
+  }
+
+public:
+  //! Constructs a token which never stops.
+  constexpr stop_token() noexcept = default;
+
+  //! True if this token is associated with a `stop_source`.
+  constexpr bool stop_possible() const noexcept { return _flag != nullptr; }
+  //! True if the associated `stop_source` has been asked to stop.
+  bool stop_requested() const noexcept { return _flag != nullptr && _flag->load(std::memory_order_relaxed); }
+};
+
+/*! Owns the flag which its tokens check. The source must outlive its tokens, and never allocates.
+*/
+class stop_source
+{
+  std::atomic<bool> _flag{false};
+
+public:
+  //! Constructs a source not yet asked to stop.
+  stop_source() = default;
+  stop_source(const stop_source &) = delete;
+  stop_source(stop_source &&) = delete;
+  stop_source &operator=(const stop_source &) = delete;
+  stop_source &operator=(stop_source &&) = delete;
+  ~stop_source() = default;
+
+  //! Returns a token checking this source.
+  constexpr stop_token get_token() const noexcept { return stop_token(&_flag); }
+  /*! Asks the operations checking this source's tokens to stop, which they will see at their next
+  check, rather than immediately.
+  \returns False if a stop had already been requested.
+  */
+  bool request_stop() noexcept { return !_flag.exchange(true, std::memory_order_relaxed); }
+  //! True if a stop has been requested.
+  bool stop_requested() const noexcept { return _flag.load(std::memory_order_relaxed); }
+};
+
+/*! The failure returned by `OUTCOME_TRY_CANCELLABLE()` and `OUTCOME_TRYV_CANCELLABLE()` when
+stopped, which converts into any `result` or `outcome` whose error type can be made from a
+`std::error_code`.
+*/
+inline auto try_operation_return_cancelled() noexcept { return failure(make_error_code(cancellation_errc::cancelled)); }
+
+OUTCOME_V2_NAMESPACE_END
+
+namespace std
+{
+  template <> struct is_error_code_enum<OUTCOME_V2_NAMESPACE::cancellation_errc> : std::true_type
+  {
+  };
+}  // namespace std
+
+//! \exclude
+#define OUTCOME_TRYV_CANCELLABLE2(unique, token, ...)                                                                                                                                                                                                                                                                         \
+  if(OUTCOME_UNLIKELY((token).stop_requested()))                                                                                                                                                                                                                                                                              \
+  return OUTCOME_V2_NAMESPACE::try_operation_return_cancelled();                                                                                                                                                                                                                                                              \
+  OUTCOME_TRYV2(unique, __VA_ARGS__)
+//! \exclude
+#define OUTCOME_TRY_CANCELLABLE2(unique, token, v, ...)                                                                                                                                                                                                                                                                       \
+  OUTCOME_TRYV_CANCELLABLE2(unique, token, __VA_ARGS__);                                                                                                                                                                                                                                                                      \
+  OUTCOME_TRY2_EXTRACT(unique, v)
+
+/*! As `OUTCOME_TRYV()`, but first returns `cancellation_errc::cancelled` without evaluating the
+expression if `token.stop_requested()`. `token` may be an `outcome::stop_token`, or anything else
+with a `stop_requested()` member function such as a `std::stop_token`.
+*/
+#define OUTCOME_TRYV_CANCELLABLE(token, ...) OUTCOME_TRYV_CANCELLABLE2(OUTCOME_TRY_UNIQUE_NAME, token, __VA_ARGS__)
+/*! As `OUTCOME_TRY()`, but first returns `cancellation_errc::cancelled` without evaluating the
+expression if `token.stop_requested()`. `token` may be an `outcome::stop_token`, or anything else
+with a `stop_requested()` member function such as a `std::stop_token`.
+*/
+#define OUTCOME_TRY_CANCELLABLE(token, v, ...) OUTCOME_TRY_CANCELLABLE2(OUTCOME_TRY_UNIQUE_NAME, token, v, __VA_ARGS__)
+
+#endif
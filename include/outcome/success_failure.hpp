@@ -27,9 +27,16 @@ http://www.boost.org/LICENSE_1_0.txt)
 
 #include "config.hpp"
 
+#ifndef OUTCOME_RESULT_LITE
 #include <exception>
 #include <system_error>
+#ifdef OUTCOME_ENABLE_BOOST_SYSTEM
+#include <boost/system/system_error.hpp>
+#endif
+#endif
+#include <tuple>
 #include <type_traits>
+#include <utility>
 
 OUTCOME_V2_NAMESPACE_BEGIN
 
@@ -72,6 +79,7 @@ namespace detail
   // static_assert(std::is_same_v<rebind_type<int, volatile const double &&>, volatile const int &&>, "");
 }  // namespace detail
 
+#ifndef OUTCOME_RESULT_LITE
 //! Namespace for policies
 namespace policy
 {
@@ -118,13 +126,27 @@ namespace policy
                   "To use the error_code_throw_as_system_error policy with a custom Error type, you must define a throw_as_system_error_with_payload() free function to say how to handle the payload");
     OUTCOME_THROW_EXCEPTION(std::system_error(error_code(error)));
   }
+#ifdef OUTCOME_ENABLE_BOOST_SYSTEM
+  //! Throws a `boost::system::error_code` as a `boost::system::system_error`, without converting it to a `std::error_code`.
+  inline void throw_as_system_error_with_payload(const boost::system::error_code &error) { OUTCOME_THROW_EXCEPTION(boost::system::system_error(error)); }
+#endif
 }  // namespace policy
+#endif
 
 //! Namespace for traits
 namespace trait
 {
   namespace detail
   {
+#ifdef OUTCOME_RESULT_LITE
+    // Without <system_error> and <exception> no type can be either
+    template <class T> struct has_error_code : std::false_type
+    {
+    };
+    template <class T> struct has_exception_ptr : std::false_type
+    {
+    };
+#else
     template <class T> using devoid = OUTCOME_V2_NAMESPACE::detail::devoid<T>;
     template <size_t N, class T> constexpr inline void get(const T & /*unused*/);
     constexpr inline void make_error_code(...);
@@ -140,6 +162,7 @@ namespace trait
     template <class T, typename V = decltype(make_exception_ptr(std::declval<devoid<T>>()))> struct has_exception_ptr : std::integral_constant<bool, std::is_base_of<std::exception_ptr, std::decay_t<V>>::value || std::is_convertible<T, std::exception_ptr>::value>
     {
     };
+#endif
   }  // namespace detail
   /*! Trait for whether a free function `make_error_code(T)` returning a `std::error_code` exists or not.
   Also returns true if `std::error_code` is convertible from T.
@@ -238,7 +261,12 @@ template <class T> inline constexpr success_type<std::decay_t<T>> success(T &&v)
 
 /*! Type sugar for implicitly constructing a `result<>` with a failure state of error code and exception.
 */
-template <class EC = std::error_code, class E = void> struct failure_type
+#ifdef OUTCOME_RESULT_LITE
+template <class EC, class E = void> struct failure_type;
+#else
+template <class EC = std::error_code, class E = void> struct failure_type;
+#endif
+template <class EC, class E> struct failure_type
 {
   //! The type of the error code
   using error_type = EC;
@@ -415,6 +443,44 @@ template <class EC, class E> inline constexpr failure_type<std::decay_t<EC>, std
   return failure_type<std::decay_t<EC>, std::decay_t<E>>{std::forward<EC>(v), std::forward<E>(w)};
 }
 
+/*! Type sugar for implicitly constructing a `result<>` or `outcome<>` with a successful state
+constructed in place. It holds references to its arguments, so it must be consumed within the full
+expression which created it, typically a `return` statement.
+*/
+template <class... Args> struct success_in_place_type
+{
+  //! References to the arguments with which to construct the successful state.
+  std::tuple<Args &&...> args;
+};
+/*! Returns type sugar for implicitly constructing a `result<T>` with a successful state, with `T`
+constructed from `args...` directly inside the result.
+\effects Captures references to `args...`. Unlike `success()`, the value is never copied nor moved,
+so `T` need not be copyable nor movable.
+*/
+template <class... Args> inline constexpr success_in_place_type<Args...> success_in_place(Args &&... args) noexcept
+{
+  return success_in_place_type<Args...>{std::forward_as_tuple(std::forward<Args>(args)...)};
+}
+
+/*! Type sugar for implicitly constructing a `result<>` or `outcome<>` with a failure state of error
+constructed in place. It holds references to its arguments, so it must be consumed within the full
+expression which created it, typically a `return` statement.
+*/
+template <class... Args> struct failure_in_place_type
+{
+  //! References to the arguments with which to construct the failure state.
+  std::tuple<Args &&...> args;
+};
+/*! Returns type sugar for implicitly constructing a `result<T, E>` with a failure state, with `E`
+constructed from `args...` directly inside the result.
+\effects Captures references to `args...`. Unlike `failure()`, the error is never copied nor moved,
+so `E` need not be copyable nor movable.
+*/
+template <class... Args> inline constexpr failure_in_place_type<Args...> failure_in_place(Args &&... args) noexcept
+{
+  return failure_in_place_type<Args...>{std::forward_as_tuple(std::forward<Args>(args)...)};
+}
+
 namespace detail
 {
   template <class T> struct is_success_type : std::false_type
@@ -0,0 +1,206 @@
+/* A fast parser of the text serialisation of results
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_TEXT_PARSE_HPP
+#define OUTCOME_TEXT_PARSE_HPP
+
+#include "result.hpp"
+
+#if __cplusplus >= 201700 || _HAS_CXX17
+
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  inline const char *text_parse_skip_space(const char *first, const char *last) noexcept
+  {
+    while(first != last && (*first == ' ' || (*first >= '\t' && *first <= '\r')))
+    {
+      ++first;
+    }
+    return first;
+  }
+  inline const char *text_parse_word_end(const char *first, const char *last) noexcept
+  {
+    while(first != last && !(*first == ' ' || (*first >= '\t' && *first <= '\r')))
+    {
+      ++first;
+    }
+    return first;
+  }
+
+  // Each reads what formatted extraction from a default std::istream would, after skipping whitespace
+  template <class T> inline std::enable_if_t<std::is_same<T, char>::value || std::is_same<T, signed char>::value || std::is_same<T, unsigned char>::value, std::from_chars_result> text_parse_item(const char *first, const char *last, T &v) noexcept
+  {
+    first = text_parse_skip_space(first, last);
+    if(first == last)
+    {
+      return {first, std::errc::invalid_argument};
+    }
+    v = static_cast<T>(*first);
+    return {first + 1, std::errc()};
+  }
+  inline std::from_chars_result text_parse_item(const char *first, const char *last, bool &v) noexcept
+  {
+    unsigned value = 0;
+    first = text_parse_skip_space(first, last);
+    auto r = std::from_chars(first, last, value);
+    if(r.ec == std::errc() && value > 1)
+    {
+      return {first, std::errc::invalid_argument};
+    }
+    v = (value != 0);
+    return r;
+  }
+  template <class T>
+  inline std::enable_if_t<std::is_integral<T>::value && !std::is_same<T, bool>::value && !std::is_same<T, char>::value && !std::is_same<T, signed char>::value && !std::is_same<T, unsigned char>::value, std::from_chars_result>
+  text_parse_item(const char *first, const char *last, T &v) noexcept
+  {
+    first = text_parse_skip_space(first, last);
+    // Streams accept a leading plus, from_chars does not
+    if(first != last && *first == '+')
+    {
+      ++first;
+    }
+    return std::from_chars(first, last, v);
+  }
+  template <class T> inline std::enable_if_t<std::is_floating_point<T>::value, std::from_chars_result> text_parse_item(const char *first, const char *last, T &v) noexcept
+  {
+    first = text_parse_skip_space(first, last);
+#if __cpp_lib_to_chars >= 201611L
+    if(first != last && *first == '+')
+    {
+      ++first;
+    }
+    return std::from_chars(first, last, v);
+#else
+    // Without floating point from_chars, strtod a local copy so the input need not be null terminated
+    char buffer[64];
+    const size_t length = std::min<size_t>(static_cast<size_t>(text_parse_word_end(first, last) - first), sizeof(buffer) - 1);
+    memcpy(buffer, first, length);
+    buffer[length] = 0;
+    char *end = nullptr;
+    const long double value = strtold(buffer, &end);
+    if(end == buffer)
+    {
+      return {first, std::errc::invalid_argument};
+    }
+    v = static_cast<T>(value);
+    return {first + (end - buffer), std::errc()};
+#endif
+  }
+  inline std::from_chars_result text_parse_item(const char *first, const char *last, std::string &v)
+  {
+    first = text_parse_skip_space(first, last);
+    const char *end = text_parse_word_end(first, last);
+    if(end == first)
+    {
+      return {first, std::errc::invalid_argument};
+    }
+    v.assign(first, end);
+    return {end, std::errc()};
+  }
+  // Anything else is extracted from a stream over the text, which is as slow as the stream path
+  template <class T> inline std::enable_if_t<!std::is_arithmetic<T>::value, std::from_chars_result> text_parse_item(const char *first, const char *last, T &v)
+  {
+    std::istringstream s(std::string(first, last));
+    if(!(s >> v))
+    {
+      return {first, std::errc::invalid_argument};
+    }
+    const auto pos = s.tellg();
+    return {(pos < 0) ? last : first + static_cast<ptrdiff_t>(pos), std::errc()};
+  }
+
+  template <class T> inline std::from_chars_result text_parse_value(const char *first, const char *last, T &v, std::false_type /*is void*/) { return text_parse_item(first, last, v); }
+  template <class T> inline std::from_chars_result text_parse_value(const char *first, const char * /*unused*/, T & /*unused*/, std::true_type /*is void*/) noexcept { return {first, std::errc()}; }
+  template <class R> inline success_type<R> text_parse_success(devoid<R> &&v, std::false_type /*is void*/) { return success_type<R>(std::move(v)); }
+  template <class R> inline success_type<void> text_parse_success(devoid<R> && /*unused*/, std::true_type /*is void*/) noexcept { return success(); }
+}  // namespace detail
+
+/*! Parses a result in the format written by `operator<<(std::ostream &, const result<R, S, P> &)`
+from `[first, last)`, the same as `operator>>(std::istream &, result<R, S, P> &)` would but using
+`std::from_chars()` for arithmetic types, so without streams, locales or allocation. Leading
+whitespace is skipped. Strings are read up to the next whitespace. Other types are extracted from
+a `std::istringstream`, and so are no faster. Spare storage is preserved.
+\returns The end of what was parsed, and `std::errc::invalid_argument` or `std::errc::result_out_of_range`
+if parsing failed, in which case `v` is not changed.
+\requires That `R` and `S` be default constructible, and `S` not be void.
+*/
+template <class R, class S, class P> inline std::from_chars_result from_chars(const char *first, const char *last, result<R, S, P> &v)
+{
+  static_assert(!std::is_void<S>::value, "Results with a void error type cannot be parsed");
+  uint32_t status = 0;
+  auto r = detail::text_parse_item(first, last, status);
+  if(r.ec != std::errc())
+  {
+    return r;
+  }
+  if((status & detail::status_have_value) != 0)
+  {
+    detail::devoid<R> value{};
+    r = detail::text_parse_value(r.ptr, last, value, std::is_void<R>());
+    if(r.ec != std::errc())
+    {
+      return r;
+    }
+    v = detail::text_parse_success<R>(std::move(value), std::is_void<R>());
+  }
+  else if((status & detail::status_have_error) != 0)
+  {
+    S error{};
+    r = detail::text_parse_item(r.ptr, last, error);
+    if(r.ec != std::errc())
+    {
+      return r;
+    }
+    v = result<R, S, P>(in_place_type<S>, std::move(error));
+  }
+  else
+  {
+    return {first, std::errc::invalid_argument};
+  }
+#ifndef OUTCOME_ENABLE_COMPACT_STATUS
+  hooks::set_spare_storage(&v, static_cast<uint16_t>(status >> detail::status_2byte_shift));
+#endif
+  return r;
+}
+//! \group from_chars
+template <class T> inline auto from_chars(std::string_view text, T &v) -> decltype(from_chars(text.data(), text.data(), v)) { return from_chars(text.data(), text.data() + text.size(), v); }
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
+
+#endif
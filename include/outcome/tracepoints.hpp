@@ -0,0 +1,135 @@
+/* Optional static tracepoints on failure construction and propagation
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_TRACEPOINTS_HPP
+#define OUTCOME_TRACEPOINTS_HPP
+
+#include "config.hpp"
+
+#include <cstdint>
+#include <type_traits>
+
+/* Define OUTCOME_ENABLE_TRACEPOINTS to compile in static probes for SystemTap and bpftrace on Linux,
+or DTrace on Mac OS and the BSDs, wherever <sys/sdt.h> is available. A probe costs a single nop where
+no tracer is attached, and the tracer patches in a trap where one is.
+*/
+#if defined(OUTCOME_ENABLE_TRACEPOINTS) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define OUTCOME_HAVE_TRACEPOINTS 1
+#endif
+#endif
+
+#ifdef OUTCOME_HAVE_TRACEPOINTS
+//! Fires the static probe `outcome:name` with three integer or pointer arguments.
+#define OUTCOME_TRACEPOINT(name, a, b, c) DTRACE_PROBE3(outcome, name, a, b, c)
+#else
+#define OUTCOME_TRACEPOINT(name, a, b, c) ((void) (a), (void) (b), (void) (c))
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  // The arguments a probe carries for an error
+  struct tracepoint_error
+  {
+    const void *category;
+    long code;
+  };
+  // Error codes give their category and value, integers and enums their value, anything else nothing
+  template <class E> inline auto tracepoint_error_of(const E &e, int /*unused*/) noexcept -> decltype(tracepoint_error{&e.category(), static_cast<long>(e.value())})
+  {
+    return tracepoint_error{&e.category(), static_cast<long>(e.value())};
+  }
+  template <class E, typename std::enable_if<std::is_integral<E>::value || std::is_enum<E>::value, bool>::type = true> inline tracepoint_error tracepoint_error_of(const E &e, long /*unused*/) noexcept
+  {
+    return tracepoint_error{nullptr, static_cast<long>(e)};
+  }
+  template <class E> inline tracepoint_error tracepoint_error_of(const E & /*unused*/, ...) noexcept { return tracepoint_error{nullptr, 0}; }
+
+  // The error of a failed result or outcome, or nothing if it has only an exception or is some other type
+  template <class T> inline auto tracepoint_failure_of(const T &v, int /*unused*/) noexcept -> decltype(v.has_error(), tracepoint_error_of(v.assume_error(), 0))
+  {
+    return v.has_error() ? tracepoint_error_of(v.assume_error(), 0) : tracepoint_error{nullptr, 0};
+  }
+  template <class T> inline tracepoint_error tracepoint_failure_of(const T & /*unused*/, ...) noexcept { return tracepoint_error{nullptr, 0}; }
+
+  template <class T> inline void trace_propagation_probe(const T &v, uint16_t site) noexcept
+  {
+    const tracepoint_error e = tracepoint_failure_of(v, 0);
+    OUTCOME_TRACEPOINT(propagate, e.category, e.code, site);
+  }
+  // Called by the TRY operations with the failed input, fires nothing in constant evaluation
+  template <class T> constexpr inline void trace_propagation(const T &v, uint16_t site) noexcept
+  {
+#ifdef OUTCOME_HAVE_TRACEPOINTS
+#if defined(__cpp_lib_is_constant_evaluated) && __cpp_lib_is_constant_evaluated >= 201811L
+    if(std::is_constant_evaluated())
+    {
+      return;
+    }
+#endif
+    trace_propagation_probe(v, site);
+#else
+    (void) v;
+    (void) site;
+#endif
+  }
+}  // namespace detail
+
+/*! Fires the probe `outcome:failure` with the address of the error category, the error code and
+`site`, if `r` is a `result` or `outcome` in the errored state. Meant to be called from construction
+hooks found by ADL:
+
+```c++
+template <class T, class U> inline void hook_result_construction(result<T> *res, U &&) noexcept
+{
+  OUTCOME_V2_NAMESPACE::trace_failure(res);
+}
+```
+
+The category is null for error types without a `category()`, whose code is their value if they are
+integers or enums, else zero. `site` is usually an `OUTCOME_ERROR_SITE_ID()`, or zero for none. The
+probe `outcome:category` fires with the address, identifier and name of each category as it is
+registered with `error_category_id()`, from which a tracer attached early enough can map addresses
+to stable identifiers. The `OUTCOME_TRY` operations fire `outcome:propagate` with the same arguments
+for the failure they return.
+
+Does nothing unless `OUTCOME_HAVE_TRACEPOINTS` is defined, which requires `OUTCOME_ENABLE_TRACEPOINTS`
+to be defined and `<sys/sdt.h>` to be available.
+*/
+template <class T> inline void trace_failure(const T *r, uint16_t site = 0) noexcept
+{
+  if(OUTCOME_UNLIKELY(r->has_error()))
+  {
+    const detail::tracepoint_error e = detail::tracepoint_error_of(r->assume_error(), 0);
+    OUTCOME_TRACEPOINT(failure, e.category, e.code, site);
+  }
+}
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -26,67 +26,119 @@ http://www.boost.org/LICENSE_1_0.txt)
 #define OUTCOME_TRY_HPP
 
 #include "success_failure.hpp"
+// after success_failure.hpp, which it relies upon
+#include "detail/value_storage.hpp"
+#include "tracepoints.hpp"
 
 OUTCOME_V2_NAMESPACE_BEGIN
 
+namespace detail
+{
+  template <class...> struct try_void
+  {
+    using type = void;
+  };
+  template <class T, class = void> struct try_has_exception_type : std::false_type
+  {
+  };
+  template <class T> struct try_has_exception_type<T, typename try_void<typename T::exception_type>::type> : std::true_type
+  {
+  };
+  // True if U can be built in place from the error of Source, and Source has no other failure state to carry
+  template <class U, class Source, class = void> struct try_direct_failure : std::false_type
+  {
+  };
+  template <class U, class Source>
+  struct try_direct_failure<U, Source, typename try_void<typename U::error_type, decltype(std::declval<Source>().assume_error())>::type>
+      : std::integral_constant<bool, !is_failure_type<U>::value && !try_has_exception_type<std::decay_t<Source>>::value && std::is_constructible<U, in_place_type_t<typename U::error_type>, decltype(std::declval<Source>().assume_error())>::value>
+  {
+  };
+
+  /* Builds U from the failure of the failed input, straight from its error where possible, else via
+  `as_failure()`. This is one move of the error instead of two. Used by the TRY macros which must know
+  the caller's return type to add to the failure, such as `OUTCOME_TRY_SITE`.
+  */
+  template <class U, class T> constexpr U try_convert_failure(std::true_type /*unused*/, T &&v) { return U(in_place_type<typename U::error_type>, std::forward<T>(v).assume_error()); }
+  template <class U, class T> constexpr U try_convert_failure(std::false_type /*unused*/, T &&v) { return std::forward<T>(v).as_failure(); }
+  template <class U, class T> constexpr U try_convert_failure(T &&v) { return try_convert_failure<U>(try_direct_failure<U, T>(), std::forward<T>(v)); }
+  template <class U, class T> struct try_convertible_failure : std::integral_constant<bool, try_direct_failure<U, T>::value || std::is_constructible<U, decltype(std::declval<T>().as_failure())>::value>
+  {
+  };
+}  // namespace detail
+
 /*! Customisation point for changing what the `OUTCOME_TRY` macros
 do. This function defaults to returning `std::forward<T>(v).as_failure()`.
+It is not called where the macros build the caller's return type straight
+from the error instead, see `try_operation_return_direct()`.
 \effects Extracts any state apart from value into a `failure_type`.
-\requires The input value to have a `.as_failure()` member function.
+Fires the probe `outcome:propagate` if tracepoints are enabled, see `trace_failure()`.
+\requires The input value to have a `.as_failure()` member function. Overloads must
+return by value an object which does not refer to `v`, as the result of the
+call may outlive `v` when one overload forwards to another.
 */
-template <class T> OUTCOME_REQUIRES(requires(T &&v){{v.as_failure()}}) decltype(auto) try_operation_return_as(T &&v)
+template <class T> OUTCOME_REQUIRES(requires(T &&v){{v.as_failure()};}) constexpr decltype(auto) try_operation_return_as(T &&v)
 {
+  detail::trace_propagation(v, 0);
   return std::forward<T>(v).as_failure();
 }
 
-OUTCOME_V2_NAMESPACE_END
-
-//! \exclude
-#define OUTCOME_TRY_GLUE2(x, y) x##y
-//! \exclude
-#define OUTCOME_TRY_GLUE(x, y) OUTCOME_TRY_GLUE2(x, y)
-//! \exclude
-#define OUTCOME_TRY_UNIQUE_NAME OUTCOME_TRY_GLUE(__t, __COUNTER__)
-
-//! \exclude
-#define OUTCOME_TRYV2(unique, ...)                                                                                                                                                                                                                                                                                             \
-  auto && (unique) = (__VA_ARGS__);                                                                                                                                                                                                                                                                                            \
-  if(!(unique).has_value())                                                                                                                                                                                                                                                                                                    \
-  return OUTCOME_V2_NAMESPACE::try_operation_return_as(std::forward<decltype(unique)>(unique))
-//! \exclude
-#define OUTCOME_TRY2(unique, v, ...)                                                                                                                                                                                                                                                                                           \
-  OUTCOME_TRYV2(unique, __VA_ARGS__);                                                                                                                                                                                                                                                                                          \
-  auto && (v) = std::forward<decltype(unique)>(unique).value()
-
-/*! If the outcome returned by expression ... is not valued, propagate any
-failure by immediately returning that failure state immediately
+namespace detail
+{
+  /* Converts the failed input of a TRY into the caller's return type. Where `try_direct_failure` allows,
+  the error is moved once straight into it, else it is built from `try_operation_return_as()`, which
+  moves the error twice. Only lives until the end of the return statement, so keeping a reference is fine.
+  */
+  template <class T> class try_failure_return
+  {
+    T &&_v;
+
+    template <class U> constexpr U _convert(std::true_type /*unused*/)
+    {
+      trace_propagation(_v, 0);
+      return U(in_place_type<typename U::error_type>, std::forward<T>(_v).assume_error());
+    }
+    template <class U> constexpr U _convert(std::false_type /*unused*/) { return OUTCOME_V2_NAMESPACE::try_operation_return_as(std::forward<T>(_v)); }
+
+  public:
+    constexpr explicit try_failure_return(T &&v) noexcept : _v(std::forward<T>(v)) {}
+    try_failure_return(const try_failure_return &) = delete;
+    try_failure_return(try_failure_return &&) = default;  // NOLINT, needed to return by value before C++ 17
+    try_failure_return &operator=(const try_failure_return &) = delete;
+    try_failure_return &operator=(try_failure_return &&) = delete;
+    ~try_failure_return() = default;
+
+    OUTCOME_TEMPLATE(class U)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(try_direct_failure<U, T>::value || std::is_constructible<U, decltype(OUTCOME_V2_NAMESPACE::try_operation_return_as(std::declval<T>()))>::value))
+    constexpr operator U() { return _convert<U>(try_direct_failure<U, T>()); }  // NOLINT
+  };
+}  // namespace detail
+
+/*! What the `OUTCOME_TRY` macros return from the caller on failure. This converts into the caller's
+return type, which is built in place from `std::forward<T>(v).assume_error()` if it can be, and `v` has
+no exception state, saving a move of the error. Otherwise it is built from `try_operation_return_as(v)`.
 */
-#define OUTCOME_TRYV(...) OUTCOME_TRYV2(OUTCOME_TRY_UNIQUE_NAME, __VA_ARGS__)
+template <class T> constexpr detail::try_failure_return<T> try_operation_return_direct(T &&v) noexcept
+{
+  return detail::try_failure_return<T>(std::forward<T>(v));
+}
 
-#if defined(__GNUC__) || defined(__clang__)
+/*! Customisation point for changing how the `OUTCOME_TRY` macros
+extract the value once they have checked that there is one. This function
+defaults to returning `std::forward<T>(v).assume_value()`, so the check is
+not repeated by the `NoValuePolicy`.
+\effects Extracts the value without runtime checks.
+\requires The input value to have a `.assume_value()` member function.
+*/
+template <class T> OUTCOME_REQUIRES(requires(T &&v){{v.assume_value()};}) constexpr decltype(auto) try_operation_extract_value(T &&v)
+{
+  return std::forward<T>(v).assume_value();
+}
 
-/*! If the outcome returned by expression ... is not valued, propagate any
-failure by immediately returning that failure state immediately, else become the
-unwrapped value as an expression. This makes `OUTCOME_TRYX(expr)` an expression
-which can be used exactly like the `try` operator in other languages.
+OUTCOME_V2_NAMESPACE_END
 
-\remarks This macro makes use of a proprietary extension in GCC and clang and is not
-portable. The macro is not made available on unsupported compilers,
-so you can test for its presence using `#ifdef OUTCOME_TRYX`.
-*/
-#define OUTCOME_TRYX(...)                                                                                                                                                                                                                                                                                                      \
-  ({                                                                                                                                                                                                                                                                                                                           \
-    auto &&res = (__VA_ARGS__);                                                                                                                                                                                                                                                                                                \
-    if(!res.has_value())                                                                                                                                                                                                                                                                                                       \
-      return OUTCOME_V2_NAMESPACE::try_operation_return_as(std::forward<decltype(res)>(res));                                                                                                                                                                                                                                  \
-    std::forward<decltype(res)>(res).value();                                                                                                                                                                                                                                                                                  \
-  \
-})
+#ifdef OUTCOME_ENABLE_TRY_COUNTERS
+#include "try_counters.hpp"
 #endif
-
-/*! If the outcome returned by expression ... is not valued, propagate any
-failure by immediately returning that failure immediately, else set *v* to the unwrapped value.
-*/
-#define OUTCOME_TRY(v, ...) OUTCOME_TRY2(OUTCOME_TRY_UNIQUE_NAME, v, __VA_ARGS__)
+#include "try_macros.hpp"
 
 #endif
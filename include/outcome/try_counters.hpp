@@ -0,0 +1,313 @@
+/* Per call site counters of attempts and failures of the TRY operations
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_TRY_COUNTERS_HPP
+#define OUTCOME_TRY_COUNTERS_HPP
+
+#include "config.hpp"
+#ifdef OUTCOME_ENABLE_PERCPU_COUNTERS
+#include "percpu_counters.hpp"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+#ifndef OUTCOME_MAX_TRY_SITES
+//! The number of distinct TRY operations which can be counted, each costing sixteen bytes per thread.
+#define OUTCOME_MAX_TRY_SITES 1024
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+//! A TRY operation in the source, as registered by the TRY macros when `OUTCOME_ENABLE_TRY_COUNTERS` is defined.
+struct try_site
+{
+  const char *file;
+  unsigned line;
+  //! The name of the function containing the TRY operation.
+  const char *function;
+};
+
+//! How many times a TRY operation was attempted, and how many of those propagated a failure.
+struct try_site_count
+{
+  const try_site *site;
+  uint64_t attempts;
+  uint64_t failures;
+
+  //! The fraction of the attempts which failed.
+  double failure_rate() const noexcept { return attempts == 0 ? 0.0 : static_cast<double>(failures) / static_cast<double>(attempts); }
+};
+
+namespace detail
+{
+  static_assert(OUTCOME_MAX_TRY_SITES > 0, "OUTCOME_MAX_TRY_SITES must be positive");
+  struct try_site_table
+  {
+    std::atomic<uint32_t> count{0};
+    std::atomic<const try_site *> sites[OUTCOME_MAX_TRY_SITES];
+
+    static try_site_table &get() noexcept
+    {
+      static try_site_table v;
+      return v;
+    }
+  };
+
+  /* The counters of one thread, indexed by site id less one, written only by their own thread and
+  read by any thread. There is only ever the one writer, so counts are bumped by a relaxed load and
+  store rather than a locked add.
+  */
+  struct try_counter_shard
+  {
+    struct slot
+    {
+      std::atomic<uint64_t> attempts{0};
+      std::atomic<uint64_t> failures{0};
+    } table[OUTCOME_MAX_TRY_SITES];
+
+    static void bump(std::atomic<uint64_t> &c) noexcept { c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+    void add(uint32_t idx, bool failed) noexcept
+    {
+      bump(table[idx].attempts);
+      if(failed)
+      {
+        bump(table[idx].failures);
+      }
+    }
+    // Adds the counts of the first `sites` slots into `out`, which has at least as many entries
+    void merge_into(std::vector<try_site_count> &out, uint32_t sites) const noexcept
+    {
+      for(uint32_t n = 0; n < sites; n++)
+      {
+        out[n].attempts += table[n].attempts.load(std::memory_order_relaxed);
+        out[n].failures += table[n].failures.load(std::memory_order_relaxed);
+      }
+    }
+  };
+
+  // All live shards, and the counts of the shards of threads which have exited
+  struct try_counter_registry
+  {
+    std::mutex lock;
+    std::vector<const try_counter_shard *> shards;
+    std::vector<try_site_count> retired;
+
+    static try_counter_registry &get() noexcept
+    {
+      static try_counter_registry v;
+      return v;
+    }
+  };
+
+#ifdef OUTCOME_ENABLE_PERCPU_COUNTERS
+  // The attempts and failures of each site, kept per CPU, at twice the site index and one after
+  struct try_counter_percpu
+  {
+    percpu_counters<2 * OUTCOME_MAX_TRY_SITES> counts;
+
+    static try_counter_percpu &get()
+    {
+      static try_counter_percpu v;
+      return v;
+    }
+    bool add(uint32_t idx, bool failed) noexcept
+    {
+      if(counts.cpus() == 0 || !counts.add(2 * idx))
+      {
+        return false;
+      }
+      // A thread which could count the attempt per CPU can count the failure, unless it has since moved to a CPU brought online after construction
+      if(failed)
+      {
+        (void) counts.add(2 * idx + 1);
+      }
+      return true;
+    }
+    void merge_into(std::vector<try_site_count> &out, uint32_t sites) const noexcept
+    {
+      for(uint32_t n = 0; n < sites; n++)
+      {
+        out[n].attempts += counts.sum(2 * n);
+        out[n].failures += counts.sum(2 * n + 1);
+      }
+    }
+  };
+#endif
+
+  // Registers on first use by a thread, and folds its counts into the retired counts on thread exit
+  struct try_counter_thread
+  {
+    try_counter_shard shard;
+
+    try_counter_thread()
+    {
+      try_counter_registry &r = try_counter_registry::get();
+      std::lock_guard<std::mutex> g(r.lock);
+      r.shards.push_back(&shard);
+    }
+    try_counter_thread(const try_counter_thread &) = delete;
+    try_counter_thread &operator=(const try_counter_thread &) = delete;
+    ~try_counter_thread()
+    {
+      try_counter_registry &r = try_counter_registry::get();
+      std::lock_guard<std::mutex> g(r.lock);
+      r.retired.resize(OUTCOME_MAX_TRY_SITES);
+      shard.merge_into(r.retired, OUTCOME_MAX_TRY_SITES);
+      for(auto it = r.shards.begin(); it != r.shards.end(); ++it)
+      {
+        if(*it == &shard)
+        {
+          r.shards.erase(it);
+          break;
+        }
+      }
+    }
+  };
+}  // namespace detail
+
+/*! Gives `site` an id, which the TRY macros do once per TRY operation the first time it runs.
+\returns The id, or zero if `OUTCOME_MAX_TRY_SITES` sites have been registered already, in which
+case the TRY operation is not counted.
+*/
+inline uint32_t register_try_site(const try_site *site) noexcept
+{
+  detail::try_site_table &t = detail::try_site_table::get();
+  const uint32_t idx = t.count.fetch_add(1, std::memory_order_relaxed);
+  if(idx >= OUTCOME_MAX_TRY_SITES)
+  {
+    t.count.store(OUTCOME_MAX_TRY_SITES, std::memory_order_relaxed);
+    return 0;
+  }
+  t.sites[idx].store(site, std::memory_order_release);
+  return idx + 1;
+}
+
+/*! Counters of the attempts and propagated failures of each TRY operation, kept per thread so that
+counting never contends and never takes a lock. Defining `OUTCOME_ENABLE_TRY_COUNTERS` makes every
+`OUTCOME_TRY`, `OUTCOME_TRYV`, `OUTCOME_TRYX` and `OUTCOME_TRY_ALL` register its site the first time
+it runs, and count into the calling thread's table thereafter. Without it, nothing is counted and
+the TRY operations are unchanged.
+
+With `OUTCOME_ENABLE_PERCPU_COUNTERS` also defined, the counts are kept in `percpu_counters`, one
+table per CPU rather than per thread, where restartable sequences are available. Their memory then
+grows with the cores of the machine rather than its threads, each count is a plain add rather than
+a locked one, and `snapshot()` sums once per core. Threads which cannot count per CPU count in their
+own tables as before.
+
+`snapshot()` sums every thread's table without stopping any of them, and ranks the sites which
+failed most first, for finding the paths which fail the most. A snapshot taken whilst threads are
+counting sees each counter at some recent value, but not necessarily every counter at the same
+instant.
+*/
+struct try_counters
+{
+  //! The counters of the calling thread.
+  static detail::try_counter_shard &this_thread()
+  {
+    static thread_local detail::try_counter_thread v;
+    return v.shard;
+  }
+
+  //! Counts an attempt of the TRY operation with id `site`, and a failure if not `valued`. Returns `valued`.
+  static bool count(uint32_t site, bool valued) noexcept
+  {
+    if(OUTCOME_LIKELY(site != 0))
+    {
+#ifdef OUTCOME_ENABLE_PERCPU_COUNTERS
+      if(OUTCOME_LIKELY(detail::try_counter_percpu::get().add(site - 1, !valued)))
+      {
+        return valued;
+      }
+#endif
+      this_thread().add(site - 1, !valued);
+    }
+    return valued;
+  }
+
+  /*! Sums the counts of every thread, including those which have exited, for every site attempted
+  at least once. Sorted by failures, then attempts, most first.
+  */
+  static std::vector<try_site_count> snapshot()
+  {
+    std::vector<try_site_count> ret;
+    snapshot(ret);
+    std::stable_sort(ret.begin(), ret.end(), [](const try_site_count &a, const try_site_count &b) { return a.failures > b.failures || (a.failures == b.failures && a.attempts > b.attempts); });
+    return ret;
+  }
+  /*! As `snapshot()`, into `out` and in the order the sites were registered rather than sorted.
+  Reuses the capacity of `out`, so allocates nothing once it has room for every registered site.
+  */
+  static void snapshot(std::vector<try_site_count> &out)
+  {
+    detail::try_site_table &t = detail::try_site_table::get();
+    const uint32_t sites = std::min<uint32_t>(t.count.load(std::memory_order_acquire), OUTCOME_MAX_TRY_SITES);
+    out.assign(sites, try_site_count{nullptr, 0, 0});
+    {
+      detail::try_counter_registry &r = detail::try_counter_registry::get();
+      std::lock_guard<std::mutex> g(r.lock);
+      for(uint32_t n = 0; n < sites && n < r.retired.size(); n++)
+      {
+        out[n].attempts += r.retired[n].attempts;
+        out[n].failures += r.retired[n].failures;
+      }
+      for(const detail::try_counter_shard *shard : r.shards)
+      {
+        shard->merge_into(out, sites);
+      }
+#ifdef OUTCOME_ENABLE_PERCPU_COUNTERS
+      detail::try_counter_percpu::get().merge_into(out, sites);
+#endif
+    }
+    for(uint32_t n = 0; n < sites; n++)
+    {
+      out[n].site = t.sites[n].load(std::memory_order_acquire);
+    }
+    // A site is published just after its id is taken, so may not be visible yet
+    out.erase(std::remove_if(out.begin(), out.end(), [](const try_site_count &c) { return c.site == nullptr || c.attempts == 0; }), out.end());
+  }
+
+  /*! Writes a table of the `top` sites of `snapshot()` into `s`, one per line, as the failures, the
+  attempts, the percentage failing, the function and the source location.
+  */
+  static void dump(std::ostream &s, size_t top = 20)
+  {
+    const std::vector<try_site_count> counts = snapshot();
+    s << "failures attempts rate function location\n";
+    for(size_t n = 0; n < counts.size() && n < top; n++)
+    {
+      const try_site_count &c = counts[n];
+      s << c.failures << ' ' << c.attempts << ' ' << (c.failure_rate() * 100.0) << "% " << c.site->function << ' ' << c.site->file << ':' << c.site->line << '\n';
+    }
+  }
+};
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
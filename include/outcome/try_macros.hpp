@@ -0,0 +1,165 @@
+/* The OUTCOME_TRY macros
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_TRY_MACROS_HPP
+#define OUTCOME_TRY_MACROS_HPP
+
+/* Included by try.hpp. Also included on its own after `import outcome;`, as modules cannot export
+macros, in which case the namespace alias `outcome` exported by the module is used. Do not then
+also include the outcome headers, they would redefine OUTCOME_V2_NAMESPACE.
+*/
+#ifndef OUTCOME_V2_NAMESPACE
+#define OUTCOME_V2_NAMESPACE ::outcome
+#endif
+#ifndef OUTCOME_UNLIKELY
+#if defined(__GNUC__) || defined(__clang__)
+#define OUTCOME_UNLIKELY(expr) (__builtin_expect(!!(expr), false))
+#else
+#define OUTCOME_UNLIKELY(expr) (expr)
+#endif
+#endif
+
+//! \exclude
+#define OUTCOME_TRY_GLUE2(x, y) x##y
+//! \exclude
+#define OUTCOME_TRY_GLUE(x, y) OUTCOME_TRY_GLUE2(x, y)
+//! \exclude
+#define OUTCOME_TRY_UNIQUE_NAME OUTCOME_TRY_GLUE(__t, __COUNTER__)
+
+#ifdef OUTCOME_ENABLE_TRY_COUNTERS
+//! \exclude
+#define OUTCOME_TRY_COUNTED(valued)                                                                                                                                                                                                                                                                                            \
+  OUTCOME_V2_NAMESPACE::try_counters::count(([](const char *function) noexcept -> uint32_t {                                                                                                                                                                                                                                   \
+                                              static const OUTCOME_V2_NAMESPACE::try_site site{__FILE__, __LINE__, function};                                                                                                                                                                                                  \
+                                              static const uint32_t id = OUTCOME_V2_NAMESPACE::register_try_site(&site);                                                                                                                                                                                                       \
+                                              return id;                                                                                                                                                                                                                                                                       \
+                                            }(__func__)),                                                                                                                                                                                                                                                                      \
+                                            (valued))
+#else
+//! \exclude
+#define OUTCOME_TRY_COUNTED(valued) (valued)
+#endif
+
+//! \exclude
+#define OUTCOME_TRYV2_RETURN(unique, valued, ret, ...)                                                                                                                                                                                                                                                                         \
+  auto &&unique = (__VA_ARGS__);                                                                                                                                                                                                                                                                                               \
+  if(OUTCOME_UNLIKELY(!OUTCOME_TRY_COUNTED(valued)))                                                                                                                                                                                                                                                                           \
+  return ret
+//! \exclude
+#define OUTCOME_TRY2_EXTRACT(unique, v) auto &&v = OUTCOME_V2_NAMESPACE::try_operation_extract_value(std::forward<decltype(unique)>(unique))
+//! \exclude
+#define OUTCOME_TRYV2(unique, ...) OUTCOME_TRYV2_RETURN(unique, (unique).has_value(), OUTCOME_V2_NAMESPACE::try_operation_return_direct(std::forward<decltype(unique)>(unique)), __VA_ARGS__)
+//! \exclude
+#define OUTCOME_TRY2(unique, v, ...)                                                                                                                                                                                                                                                                                           \
+  OUTCOME_TRYV2(unique, __VA_ARGS__);                                                                                                                                                                                                                                                                                          \
+  OUTCOME_TRY2_EXTRACT(unique, v)
+
+/*! If the outcome returned by expression ... is not valued, propagate any
+failure by immediately returning that failure state immediately
+*/
+#define OUTCOME_TRYV(...) OUTCOME_TRYV2(OUTCOME_TRY_UNIQUE_NAME, __VA_ARGS__)
+
+#if defined(__GNUC__) || defined(__clang__)
+
+/*! If the outcome returned by expression ... is not valued, propagate any
+failure by immediately returning that failure state immediately, else become the
+unwrapped value as an expression. This makes `OUTCOME_TRYX(expr)` an expression
+which can be used exactly like the `try` operator in other languages.
+
+\remarks This macro makes use of a proprietary extension in GCC and clang and is not
+portable. The macro is not made available on unsupported compilers,
+so you can test for its presence using `#ifdef OUTCOME_TRYX`.
+*/
+#define OUTCOME_TRYX(...)                                                                                                                                                                                                                                                                                                      \
+  ({                                                                                                                                                                                                                                                                                                                           \
+    auto &&res = (__VA_ARGS__);                                                                                                                                                                                                                                                                                                \
+    if(OUTCOME_UNLIKELY(!OUTCOME_TRY_COUNTED(res.has_value())))                                                                                                                                                                                                                                                                \
+      return OUTCOME_V2_NAMESPACE::try_operation_return_direct(std::forward<decltype(res)>(res));                                                                                                                                                                                                                              \
+    OUTCOME_V2_NAMESPACE::try_operation_extract_value(std::forward<decltype(res)>(res));                                                                                                                                                                                                                                       \
+  \
+})
+#endif
+
+/*! If the outcome returned by expression ... is not valued, propagate any
+failure by immediately returning that failure immediately, else set *v* to the unwrapped value.
+*/
+#define OUTCOME_TRY(v, ...) OUTCOME_TRY2(OUTCOME_TRY_UNIQUE_NAME, v, __VA_ARGS__)
+
+//! \exclude
+#define OUTCOME_TRY_ALL_COUNT2(_1, _2, _3, _4, _5, _6, _7, _8, count, ...) count
+//! \exclude
+#define OUTCOME_TRY_ALL_COUNT1(args) OUTCOME_TRY_ALL_COUNT2 args
+//! \exclude
+#define OUTCOME_TRY_ALL_COUNT(...) OUTCOME_TRY_ALL_COUNT1((__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0))
+//! \exclude
+#define OUTCOME_TRY_ALL_EACH1(m, s, unique, p) m(unique, 1, p)
+//! \exclude
+#define OUTCOME_TRY_ALL_EACH2(m, s, unique, p, ...) m(unique, 2, p) s OUTCOME_TRY_ALL_EACH1(m, s, unique, __VA_ARGS__)
+//! \exclude
+#define OUTCOME_TRY_ALL_EACH3(m, s, unique, p, ...) m(unique, 3, p) s OUTCOME_TRY_ALL_EACH2(m, s, unique, __VA_ARGS__)
+//! \exclude
+#define OUTCOME_TRY_ALL_EACH4(m, s, unique, p, ...) m(unique, 4, p) s OUTCOME_TRY_ALL_EACH3(m, s, unique, __VA_ARGS__)
+//! \exclude
+#define OUTCOME_TRY_ALL_EACH5(m, s, unique, p, ...) m(unique, 5, p) s OUTCOME_TRY_ALL_EACH4(m, s, unique, __VA_ARGS__)
+//! \exclude
+#define OUTCOME_TRY_ALL_EACH6(m, s, unique, p, ...) m(unique, 6, p) s OUTCOME_TRY_ALL_EACH5(m, s, unique, __VA_ARGS__)
+//! \exclude
+#define OUTCOME_TRY_ALL_EACH7(m, s, unique, p, ...) m(unique, 7, p) s OUTCOME_TRY_ALL_EACH6(m, s, unique, __VA_ARGS__)
+//! \exclude
+#define OUTCOME_TRY_ALL_EACH8(m, s, unique, p, ...) m(unique, 8, p) s OUTCOME_TRY_ALL_EACH7(m, s, unique, __VA_ARGS__)
+//! \exclude
+#define OUTCOME_TRY_ALL_EACH(m, s, unique, ...) OUTCOME_TRY_GLUE(OUTCOME_TRY_ALL_EACH, OUTCOME_TRY_ALL_COUNT(__VA_ARGS__))(m, s, unique, __VA_ARGS__)
+//! \exclude
+#define OUTCOME_TRY_ALL_NAME(v, ...) v
+//! \exclude
+#define OUTCOME_TRY_ALL_EXPR(v, ...) __VA_ARGS__
+//! \exclude
+#define OUTCOME_TRY_ALL_TEMP(unique, n) OUTCOME_TRY_GLUE(OUTCOME_TRY_GLUE(unique, _), n)
+//! \exclude
+#define OUTCOME_TRY_ALL_EVALUATE(unique, n, p) auto &&OUTCOME_TRY_ALL_TEMP(unique, n) = (OUTCOME_TRY_ALL_EXPR p)
+//! \exclude
+#define OUTCOME_TRY_ALL_TEST(unique, n, p) static_cast<bool>(OUTCOME_TRY_ALL_TEMP(unique, n).has_value())
+//! \exclude
+#define OUTCOME_TRY_ALL_PROPAGATE(unique, n, p)                                                                                                                                                                                                                                                                                \
+  if(!OUTCOME_TRY_ALL_TEMP(unique, n).has_value())                                                                                                                                                                                                                                                                             \
+  return OUTCOME_V2_NAMESPACE::try_operation_return_direct(std::forward<decltype(OUTCOME_TRY_ALL_TEMP(unique, n))>(OUTCOME_TRY_ALL_TEMP(unique, n)))
+//! \exclude
+#define OUTCOME_TRY_ALL_EXTRACT(unique, n, p) auto &&OUTCOME_TRY_ALL_NAME p = OUTCOME_V2_NAMESPACE::try_operation_extract_value(std::forward<decltype(OUTCOME_TRY_ALL_TEMP(unique, n))>(OUTCOME_TRY_ALL_TEMP(unique, n)))
+//! \exclude
+#define OUTCOME_TRY_ALL2(unique, ...)                                                                                                                                                                                                                                                                                          \
+  OUTCOME_TRY_ALL_EACH(OUTCOME_TRY_ALL_EVALUATE, ;, unique, __VA_ARGS__);                                                                                                                                                                                                                                                      \
+  if(OUTCOME_UNLIKELY(!OUTCOME_TRY_COUNTED((OUTCOME_TRY_ALL_EACH(OUTCOME_TRY_ALL_TEST, &, unique, __VA_ARGS__)))))                                                                                                                                                                                                             \
+  {                                                                                                                                                                                                                                                                                                                            \
+    OUTCOME_TRY_ALL_EACH(OUTCOME_TRY_ALL_PROPAGATE, ;, unique, __VA_ARGS__);                                                                                                                                                                                                                                                   \
+  }                                                                                                                                                                                                                                                                                                                            \
+  OUTCOME_TRY_ALL_EACH(OUTCOME_TRY_ALL_EXTRACT, ;, unique, __VA_ARGS__)
+
+/*! Evaluates every expression of up to eight `(v, expr)` pairs in order, then if any outcome returned
+is not valued, propagates the failure of the first one by immediately returning it, else sets each *v*
+to its unwrapped value. Unlike a sequence of `OUTCOME_TRY`, this tests all the outcomes with a single
+branch, so use it where the expressions do not depend on one another, and failure is rare.
+*/
+#define OUTCOME_TRY_ALL(...) OUTCOME_TRY_ALL2(OUTCOME_TRY_UNIQUE_NAME, __VA_ARGS__)
+
+#endif
@@ -0,0 +1,361 @@
+/* Per call site histograms of how long TRY operations take
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_TRY_TIMING_HPP
+#define OUTCOME_TRY_TIMING_HPP
+
+#include "try.hpp"
+#include "try_counters.hpp"
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#if(defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <x86intrin.h>
+#define OUTCOME_TRY_TIMING_RDTSC 1
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define OUTCOME_TRY_TIMING_RDTSC 1
+#endif
+
+#ifndef OUTCOME_MAX_TIMED_TRY_SITES
+//! The number of distinct timed TRY operations which can be timed, each costing 336 bytes per thread.
+#define OUTCOME_MAX_TIMED_TRY_SITES 128
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+//! The durations of a timed TRY operation, summed over all threads by `try_timings::snapshot()`.
+struct try_site_timing
+{
+  //! Durations are counted into power of two buckets of clock ticks, the last also counting anything longer.
+  static constexpr size_t buckets = 40;
+
+  const try_site *site;
+  uint64_t attempts;
+  uint64_t failures;
+  uint64_t total_ticks;
+  //! Bucket `n` counts durations of at least `2^(n-1)` and less than `2^n` ticks, and bucket zero durations of zero ticks.
+  uint64_t histogram[buckets];
+  //! The rate of the clock the durations were measured with.
+  double ticks_per_second;
+
+  //! The mean duration in seconds.
+  double mean() const noexcept { return attempts == 0 ? 0.0 : static_cast<double>(total_ticks) / static_cast<double>(attempts) / ticks_per_second; }
+  /*! An upper bound on the duration in seconds which `fraction` of the attempts took no longer than,
+  accurate to the power of two bucket it falls into.
+  */
+  double percentile(double fraction) const noexcept
+  {
+    const double want = fraction * static_cast<double>(attempts);
+    uint64_t seen = 0;
+    for(size_t n = 0; n < buckets; n++)
+    {
+      seen += histogram[n];
+      if(seen > 0 && static_cast<double>(seen) >= want)
+      {
+        return static_cast<double>(uint64_t(1) << n) / ticks_per_second;
+      }
+    }
+    return static_cast<double>(uint64_t(1) << (buckets - 1)) / ticks_per_second;
+  }
+};
+
+namespace detail
+{
+  // A cheap clock of unspecified rate: the time stamp counter where there is one, else the steady clock
+  struct try_timing_clock
+  {
+    static uint64_t now() noexcept
+    {
+#if defined(OUTCOME_TRY_TIMING_RDTSC)
+      return __rdtsc();
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+      uint64_t ret;
+      __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(ret));
+      return ret;
+#else
+      return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+    // Measured once against the steady clock, which takes a few milliseconds
+    static double ticks_per_second()
+    {
+      static const double v = [] {
+        const auto begin = std::chrono::steady_clock::now();
+        const uint64_t ticks = now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        const auto end = std::chrono::steady_clock::now();
+        const uint64_t elapsed = now() - ticks;
+        return static_cast<double>(elapsed) / std::chrono::duration<double>(end - begin).count();
+      }();
+      return v;
+    }
+    static size_t bucket(uint64_t ticks) noexcept
+    {
+      size_t ret = 0;
+      while(ticks != 0 && ret < try_site_timing::buckets - 1)
+      {
+        ticks >>= 1;
+        ++ret;
+      }
+      return ret;
+    }
+  };
+
+  struct timed_try_site_table
+  {
+    std::atomic<uint32_t> count{0};
+    std::atomic<const try_site *> sites[OUTCOME_MAX_TIMED_TRY_SITES];
+
+    static timed_try_site_table &get() noexcept
+    {
+      static timed_try_site_table v;
+      return v;
+    }
+  };
+
+  // The histograms of one thread, indexed by site id less one, written only by their own thread
+  struct try_timing_shard
+  {
+    struct slot
+    {
+      std::atomic<uint64_t> attempts{0};
+      std::atomic<uint64_t> failures{0};
+      std::atomic<uint64_t> total_ticks{0};
+      std::atomic<uint64_t> histogram[try_site_timing::buckets];
+
+      slot()
+      {
+        for(auto &i : histogram)
+        {
+          i.store(0, std::memory_order_relaxed);
+        }
+      }
+    } table[OUTCOME_MAX_TIMED_TRY_SITES];
+
+    static void add(std::atomic<uint64_t> &c, uint64_t v) noexcept { c.store(c.load(std::memory_order_relaxed) + v, std::memory_order_relaxed); }
+    void record(uint32_t idx, uint64_t ticks, bool failed) noexcept
+    {
+      slot &s = table[idx];
+      add(s.attempts, 1);
+      if(failed)
+      {
+        add(s.failures, 1);
+      }
+      add(s.total_ticks, ticks);
+      add(s.histogram[try_timing_clock::bucket(ticks)], 1);
+    }
+    // Adds the first `sites` slots into `out`, which has at least as many entries
+    void merge_into(std::vector<try_site_timing> &out, uint32_t sites) const noexcept
+    {
+      for(uint32_t n = 0; n < sites; n++)
+      {
+        const slot &s = table[n];
+        out[n].attempts += s.attempts.load(std::memory_order_relaxed);
+        out[n].failures += s.failures.load(std::memory_order_relaxed);
+        out[n].total_ticks += s.total_ticks.load(std::memory_order_relaxed);
+        for(size_t b = 0; b < try_site_timing::buckets; b++)
+        {
+          out[n].histogram[b] += s.histogram[b].load(std::memory_order_relaxed);
+        }
+      }
+    }
+  };
+
+  // All live shards, and the histograms of the shards of threads which have exited
+  struct try_timing_registry
+  {
+    std::mutex lock;
+    std::vector<const try_timing_shard *> shards;
+    std::vector<try_site_timing> retired;
+
+    static try_timing_registry &get() noexcept
+    {
+      static try_timing_registry v;
+      return v;
+    }
+  };
+
+  // Allocated on a thread's first timed TRY, as the shard is too big for thread local storage
+  struct try_timing_thread
+  {
+    std::unique_ptr<try_timing_shard> shard{new try_timing_shard};
+
+    try_timing_thread()
+    {
+      try_timing_registry &r = try_timing_registry::get();
+      std::lock_guard<std::mutex> g(r.lock);
+      r.shards.push_back(shard.get());
+    }
+    try_timing_thread(const try_timing_thread &) = delete;
+    try_timing_thread &operator=(const try_timing_thread &) = delete;
+    ~try_timing_thread()
+    {
+      try_timing_registry &r = try_timing_registry::get();
+      std::lock_guard<std::mutex> g(r.lock);
+      r.retired.resize(OUTCOME_MAX_TIMED_TRY_SITES, try_site_timing{});
+      shard->merge_into(r.retired, OUTCOME_MAX_TIMED_TRY_SITES);
+      for(auto it = r.shards.begin(); it != r.shards.end(); ++it)
+      {
+        if(*it == shard.get())
+        {
+          r.shards.erase(it);
+          break;
+        }
+      }
+    }
+  };
+}  // namespace detail
+
+/*! Gives `site` an id, which the timed TRY macros do once per TRY operation the first time it runs.
+\returns The id, or zero if `OUTCOME_MAX_TIMED_TRY_SITES` sites have been registered already, in which
+case the TRY operation is not timed.
+*/
+inline uint32_t register_timed_try_site(const try_site *site) noexcept
+{
+  detail::timed_try_site_table &t = detail::timed_try_site_table::get();
+  const uint32_t idx = t.count.fetch_add(1, std::memory_order_relaxed);
+  if(idx >= OUTCOME_MAX_TIMED_TRY_SITES)
+  {
+    t.count.store(OUTCOME_MAX_TIMED_TRY_SITES, std::memory_order_relaxed);
+    return 0;
+  }
+  t.sites[idx].store(site, std::memory_order_release);
+  return idx + 1;
+}
+
+/*! Histograms of how long each timed TRY operation took to evaluate its expression, whether it
+failed or not, kept per thread so that recording never contends and never takes a lock. Only
+`OUTCOME_TRY_TIMED` and `OUTCOME_TRYV_TIMED` are timed, the ordinary TRY operations cost nothing
+extra. The clock is the time stamp counter on x86 and the virtual counter on ARM64, which cost a few
+nanoseconds to read, else the steady clock.
+
+`snapshot()` sums every thread's histograms without stopping any of them, and ranks the sites which
+took the longest in total first.
+*/
+struct try_timings
+{
+  //! The histograms of the calling thread.
+  static detail::try_timing_shard &this_thread()
+  {
+    static thread_local detail::try_timing_thread v;
+    return *v.shard;
+  }
+
+  //! Reads the clock, for passing to `record()` after the TRY expression has been evaluated.
+  static uint64_t now() noexcept { return detail::try_timing_clock::now(); }
+  //! Records an attempt of the timed TRY operation `site` which began at `begin`, and a failure if not `valued`. Returns `valued`.
+  static bool record(uint32_t site, uint64_t begin, bool valued) noexcept
+  {
+    const uint64_t end = now();
+    if(OUTCOME_LIKELY(site != 0))
+    {
+      this_thread().record(site - 1, end > begin ? end - begin : 0, !valued);
+    }
+    return valued;
+  }
+
+  /*! Sums the histograms of every thread, including those which have exited, for every site attempted
+  at least once. Sorted by total time taken, most first. The first call measures the rate of the clock,
+  which takes a few milliseconds.
+  */
+  static std::vector<try_site_timing> snapshot()
+  {
+    detail::timed_try_site_table &t = detail::timed_try_site_table::get();
+    const uint32_t sites = std::min<uint32_t>(t.count.load(std::memory_order_acquire), OUTCOME_MAX_TIMED_TRY_SITES);
+    std::vector<try_site_timing> ret(sites, try_site_timing{});
+    {
+      detail::try_timing_registry &r = detail::try_timing_registry::get();
+      std::lock_guard<std::mutex> g(r.lock);
+      for(uint32_t n = 0; n < sites && n < r.retired.size(); n++)
+      {
+        ret[n] = r.retired[n];
+      }
+      for(const detail::try_timing_shard *shard : r.shards)
+      {
+        shard->merge_into(ret, sites);
+      }
+    }
+    const double rate = detail::try_timing_clock::ticks_per_second();
+    for(uint32_t n = 0; n < sites; n++)
+    {
+      ret[n].site = t.sites[n].load(std::memory_order_acquire);
+      ret[n].ticks_per_second = rate;
+    }
+    // A site is published just after its id is taken, so may not be visible yet
+    ret.erase(std::remove_if(ret.begin(), ret.end(), [](const try_site_timing &c) { return c.site == nullptr || c.attempts == 0; }), ret.end());
+    std::stable_sort(ret.begin(), ret.end(), [](const try_site_timing &a, const try_site_timing &b) { return a.total_ticks > b.total_ticks; });
+    return ret;
+  }
+
+  /*! Writes a table of the `top` sites of `snapshot()` into `s`, one per line, as the attempts, the
+  failures, the mean, the median and the 99th percentile in microseconds, the function and the source
+  location.
+  */
+  static void dump(std::ostream &s, size_t top = 20)
+  {
+    const std::vector<try_site_timing> timings = snapshot();
+    s << "attempts failures mean_us p50_us p99_us function location\n";
+    for(size_t n = 0; n < timings.size() && n < top; n++)
+    {
+      const try_site_timing &c = timings[n];
+      s << c.attempts << ' ' << c.failures << ' ' << c.mean() * 1e6 << ' ' << c.percentile(0.5) * 1e6 << ' ' << c.percentile(0.99) * 1e6 << ' ' << c.site->function << ' ' << c.site->file << ':' << c.site->line << '\n';
+    }
+  }
+};
+
+OUTCOME_V2_NAMESPACE_END
+
+/*! The id of the timed TRY operation where this macro is used. The site is registered the first
+time the expansion is evaluated, after which this costs one load and a branch.
+*/
+#define OUTCOME_TIMED_TRY_SITE_ID()                                                                                                                                                                                                                                                                                            \
+  ([](const char *function) noexcept -> uint32_t {                                                                                                                                                                                                                                                                             \
+    static const OUTCOME_V2_NAMESPACE::try_site site{__FILE__, __LINE__, function};                                                                                                                                                                                                                                            \
+    static const uint32_t id = OUTCOME_V2_NAMESPACE::register_timed_try_site(&site);                                                                                                                                                                                                                                           \
+    return id;                                                                                                                                                                                                                                                                                                                 \
+  }(__func__))
+
+//! \exclude
+#define OUTCOME_TRYV_TIMED2(unique, ...)                                                                                                                                                                                                                                                                                       \
+  const uint64_t OUTCOME_TRY_GLUE(unique, _begin) = OUTCOME_V2_NAMESPACE::try_timings::now();                                                                                                                                                                                                                                  \
+  OUTCOME_TRYV2_RETURN(unique, OUTCOME_V2_NAMESPACE::try_timings::record(OUTCOME_TIMED_TRY_SITE_ID(), OUTCOME_TRY_GLUE(unique, _begin), (unique).has_value()), OUTCOME_V2_NAMESPACE::try_operation_return_direct(std::forward<decltype(unique)>(unique)), __VA_ARGS__)
+//! \exclude
+#define OUTCOME_TRY_TIMED2(unique, v, ...)                                                                                                                                                                                                                                                                                     \
+  OUTCOME_TRYV_TIMED2(unique, __VA_ARGS__);                                                                                                                                                                                                                                                                                    \
+  OUTCOME_TRY2_EXTRACT(unique, v)
+
+/*! As `OUTCOME_TRYV()`, but records how long the expression took to evaluate into the histogram of
+this site, whether it failed or not. See `try_timings`.
+*/
+#define OUTCOME_TRYV_TIMED(...) OUTCOME_TRYV_TIMED2(OUTCOME_TRY_UNIQUE_NAME, __VA_ARGS__)
+/*! As `OUTCOME_TRY()`, but records how long the expression took to evaluate into the histogram of
+this site, whether it failed or not. See `try_timings`.
+*/
+#define OUTCOME_TRY_TIMED(v, ...) OUTCOME_TRY_TIMED2(OUTCOME_TRY_UNIQUE_NAME, v, __VA_ARGS__)
+
+#endif
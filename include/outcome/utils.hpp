@@ -27,88 +27,376 @@ http://www.boost.org/LICENSE_1_0.txt)
 
 #include "config.hpp"
 
+#include <atomic>
+#include <cstring>
 #include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <system_error>
+#include <typeindex>
+#include <typeinfo>
+#include <vector>
+#ifdef OUTCOME_ENABLE_BOOST_SYSTEM
+#include <boost/system/system_error.hpp>
+#endif
+
+/* libstdc++ can report the type of the exception in an exception_ptr without rethrowing it, and its
+exception_ptr is a pointer to the thrown object.
+*/
+#if !defined(OUTCOME_HAVE_EXCEPTION_PTR_TYPE) && defined(__cpp_exceptions) && defined(__GLIBCXX__) && (defined(__cpp_rtti) || defined(__GXX_RTTI))
+#define OUTCOME_HAVE_EXCEPTION_PTR_TYPE 1
+#endif
+#if !defined(OUTCOME_HAVE_EXCEPTION_REGISTRY) && defined(__cpp_exceptions) && (defined(__cpp_rtti) || defined(__GXX_RTTI) || defined(_CPPRTTI))
+#define OUTCOME_HAVE_EXCEPTION_REGISTRY 1
+#endif
 
 OUTCOME_V2_NAMESPACE_BEGIN
 
 #ifdef __cpp_exceptions
-/*! Utility function which tries to match the exception in the pointer provided
-to an equivalent error code. Ought to work for all standard STL types.
-\param ep The pointer to an exception to convert. If matched, on exit this is
-reset to a null pointer.
-\param not_matched The error code to return if we could not match the exception.
-Note that a null pointer in returns a null error code.
-
-\effects Rethrows the exception in the pointer, and via a long sequence of `catch`
-clauses attempts to match the equivalent error code. If a match is found, the
-pointer is reset to null. If a match is not found, *not_matched* is returned instead
-and the pointer is left unmodified.
-*/
-inline std::error_code error_from_exception(std::exception_ptr &&ep = std::current_exception(), std::error_code not_matched = std::make_error_code(std::errc::resource_unavailable_try_again)) noexcept
+namespace detail
 {
-  if(!ep)
-  {
-    return {};
-  }
-  try
-  {
-    std::rethrow_exception(ep);
-  }
-  catch(const std::invalid_argument & /*unused*/)
+#ifdef OUTCOME_ENABLE_BOOST_SYSTEM
+  // The errno domained codes map directly onto the STL categories, the rest need Boost's adaptor
+  inline std::error_code boost_error_code_to_std(const boost::system::error_code &ec)
   {
-    ep = std::exception_ptr();
-    return std::make_error_code(std::errc::invalid_argument);
-  }
-  catch(const std::domain_error & /*unused*/)
-  {
-    ep = std::exception_ptr();
-    return std::make_error_code(std::errc::argument_out_of_domain);
-  }
-  catch(const std::length_error & /*unused*/)
-  {
-    ep = std::exception_ptr();
-    return std::make_error_code(std::errc::argument_list_too_long);
-  }
-  catch(const std::out_of_range & /*unused*/)
-  {
-    ep = std::exception_ptr();
-    return std::make_error_code(std::errc::result_out_of_range);
+    if(ec.category() == boost::system::generic_category())
+    {
+      return {ec.value(), std::generic_category()};
+    }
+#ifndef _WIN32
+    if(ec.category() == boost::system::system_category())
+    {
+      return {ec.value(), std::system_category()};
+    }
+#endif
+    return ec;
   }
-  catch(const std::logic_error & /*unused*/) /* base class for this group */
+#endif
+#ifdef OUTCOME_HAVE_EXCEPTION_REGISTRY
+  using exception_error_make = void (*)();
+
+  template <class E> inline std::error_code exception_error_convert(const void *object, exception_error_make make) { return reinterpret_cast<std::error_code (*)(const E &)>(make)(*static_cast<const E *>(object)); }  // NOLINT
+  // Must be called from within a catch clause
+  template <class E> inline bool exception_error_match_current(exception_error_make make, std::error_code &ec)
   {
-    ep = std::exception_ptr();
-    return std::make_error_code(std::errc::invalid_argument);
+    try
+    {
+      throw;
+    }
+    catch(const E &e)
+    {
+      ec = reinterpret_cast<std::error_code (*)(const E &)>(make)(e);  // NOLINT
+      return true;
+    }
+    catch(...)
+    {
+    }
+    return false;
   }
-  catch(const std::system_error &e) /* also catches ios::failure */
+  template <class E, std::errc Code> inline std::error_code exception_errc(const E & /*unused*/) { return std::make_error_code(Code); }
+  inline std::error_code exception_system_error(const std::system_error &e) { return e.code(); }
+#ifdef OUTCOME_ENABLE_BOOST_SYSTEM
+  inline std::error_code exception_boost_system_error(const boost::system::system_error &e) { return boost_error_code_to_std(e.code()); }
+#endif
+
+  /* An immutable table from the exact type of an exception to its error code factory, replaced
+  as a whole on each registration so readers need no lock.
+  */
+  class exception_error_snapshot
   {
-    ep = std::exception_ptr();
-    return e.code();
-  }
-  catch(const std::overflow_error & /*unused*/)
+  public:
+    struct entry
+    {
+      std::type_index type;
+      exception_error_make make;
+      std::error_code (*convert)(const void *object, exception_error_make make);
+      bool (*match_current)(exception_error_make make, std::error_code &ec);
+    };
+
+  private:
+    // In order of registration, the built in STL types first
+    std::vector<entry> _entries;
+    size_t _builtins{0};
+    // Open addressed, power of two sized, holding one plus an index into _entries, or zero if empty
+    std::vector<uint32_t> _index;
+
+    void _reindex()
+    {
+      size_t slots = 16;
+      while(slots < _entries.size() * 2)
+      {
+        slots *= 2;
+      }
+      _index.assign(slots, 0);
+      for(size_t n = 0; n < _entries.size(); n++)
+      {
+        size_t idx = _entries[n].type.hash_code() & (slots - 1);
+        while(_index[idx] != 0)
+        {
+          idx = (idx + 1) & (slots - 1);
+        }
+        _index[idx] = static_cast<uint32_t>(n + 1);
+      }
+    }
+
+  public:
+    // The table of the STL types which error_from_rethrown_exception() would match
+    exception_error_snapshot()
+    {
+      add<std::invalid_argument>(&exception_errc<std::invalid_argument, std::errc::invalid_argument>);
+      add<std::domain_error>(&exception_errc<std::domain_error, std::errc::argument_out_of_domain>);
+      add<std::length_error>(&exception_errc<std::length_error, std::errc::argument_list_too_long>);
+      add<std::out_of_range>(&exception_errc<std::out_of_range, std::errc::result_out_of_range>);
+      add<std::logic_error>(&exception_errc<std::logic_error, std::errc::invalid_argument>);
+      add<std::system_error>(&exception_system_error);
+#ifdef OUTCOME_ENABLE_BOOST_SYSTEM
+      add<boost::system::system_error>(&exception_boost_system_error);
+#endif
+      add<std::overflow_error>(&exception_errc<std::overflow_error, std::errc::value_too_large>);
+      add<std::range_error>(&exception_errc<std::range_error, std::errc::result_out_of_range>);
+      add<std::runtime_error>(&exception_errc<std::runtime_error, std::errc::resource_unavailable_try_again>);
+      add<std::bad_alloc>(&exception_errc<std::bad_alloc, std::errc::not_enough_memory>);
+      _builtins = _entries.size();
+    }
+    // Adds or replaces the factory for exceptions of exactly E, which becomes the newest registered
+    template <class E> void add(std::error_code (*make)(const E &))
+    {
+      const entry e{typeid(E), reinterpret_cast<exception_error_make>(make), &exception_error_convert<E>, &exception_error_match_current<E>};  // NOLINT
+      for(size_t n = 0; n < _entries.size(); n++)
+      {
+        if(_entries[n].type == e.type)
+        {
+          _entries.erase(_entries.begin() + n);
+          if(n < _builtins)
+          {
+            --_builtins;
+          }
+          break;
+        }
+      }
+      _entries.push_back(e);
+      _reindex();
+    }
+    // The entry for exceptions of exactly `type`, or null if none
+    const entry *find(std::type_index type) const noexcept
+    {
+      const size_t mask = _index.size() - 1;
+      for(size_t idx = type.hash_code() & mask; _index[idx] != 0; idx = (idx + 1) & mask)
+      {
+        const entry &e = _entries[_index[idx] - 1];
+        if(e.type == type)
+        {
+          return &e;
+        }
+      }
+      return nullptr;
+    }
+    // True if the application has registered types of its own
+    bool has_registered() const noexcept { return _entries.size() > _builtins; }
+    /* Tries the types the application registered against the exception currently being handled,
+    newest first, so that types registered after their bases are preferred. Must be called from
+    within a catch clause.
+    */
+    bool match_current(std::error_code &ec) const noexcept
+    {
+      for(size_t n = _entries.size(); n > _builtins; n--)
+      {
+        const entry &e = _entries[n - 1];
+        if(e.match_current(e.make, ec))
+        {
+          return true;
+        }
+      }
+      return false;
+    }
+  };
+
+  class exception_error_registry
   {
-    ep = std::exception_ptr();
-    return std::make_error_code(std::errc::value_too_large);
-  }
-  catch(const std::range_error & /*unused*/)
+    std::mutex _lock;
+    std::atomic<const exception_error_snapshot *> _current{nullptr};
+    // Every snapshot ever published, as readers may still be using any of them
+    std::vector<std::unique_ptr<exception_error_snapshot>> _snapshots;
+
+    exception_error_registry()
+    {
+      _snapshots.emplace_back(new exception_error_snapshot);
+      _current.store(_snapshots.back().get(), std::memory_order_release);
+    }
+
+  public:
+    static exception_error_registry &get() noexcept
+    {
+      static exception_error_registry v;
+      return v;
+    }
+    const exception_error_snapshot &snapshot() const noexcept { return *_current.load(std::memory_order_acquire); }
+    template <class E> void add(std::error_code (*make)(const E &))
+    {
+      std::lock_guard<std::mutex> g(_lock);
+      std::unique_ptr<exception_error_snapshot> next(new exception_error_snapshot(*_snapshots.back()));
+      next->add<E>(make);
+      _snapshots.push_back(std::move(next));
+      _current.store(_snapshots.back().get(), std::memory_order_release);
+    }
+  };
+#endif
+
+  /* Matches the exception in ep by rethrowing it, trying any types the application registered,
+  then a long sequence of catch clauses. Works for any type derived from those matched, but costs
+  an unwind per registered type tried, and unwinding takes a global lock on some platforms.
+  */
+  inline std::error_code error_from_rethrown_exception(std::exception_ptr &ep, std::error_code not_matched) noexcept
   {
-    ep = std::exception_ptr();
-    return std::make_error_code(std::errc::result_out_of_range);
+#ifdef OUTCOME_HAVE_EXCEPTION_REGISTRY
+    const exception_error_snapshot &snapshot = exception_error_registry::get().snapshot();
+    if(snapshot.has_registered())
+    {
+      std::error_code ec;
+      try
+      {
+        std::rethrow_exception(ep);
+      }
+      catch(...)
+      {
+        if(snapshot.match_current(ec))
+        {
+          ep = std::exception_ptr();
+          return ec;
+        }
+      }
+    }
+#endif
+    try
+    {
+      std::rethrow_exception(ep);
+    }
+    catch(const std::invalid_argument & /*unused*/)
+    {
+      ep = std::exception_ptr();
+      return std::make_error_code(std::errc::invalid_argument);
+    }
+    catch(const std::domain_error & /*unused*/)
+    {
+      ep = std::exception_ptr();
+      return std::make_error_code(std::errc::argument_out_of_domain);
+    }
+    catch(const std::length_error & /*unused*/)
+    {
+      ep = std::exception_ptr();
+      return std::make_error_code(std::errc::argument_list_too_long);
+    }
+    catch(const std::out_of_range & /*unused*/)
+    {
+      ep = std::exception_ptr();
+      return std::make_error_code(std::errc::result_out_of_range);
+    }
+    catch(const std::logic_error & /*unused*/) /* base class for this group */
+    {
+      ep = std::exception_ptr();
+      return std::make_error_code(std::errc::invalid_argument);
+    }
+    catch(const std::system_error &e) /* also catches ios::failure */
+    {
+      ep = std::exception_ptr();
+      return e.code();
+    }
+#ifdef OUTCOME_ENABLE_BOOST_SYSTEM
+    catch(const boost::system::system_error &e) /* before its base class std::runtime_error */
+    {
+      ep = std::exception_ptr();
+      return boost_error_code_to_std(e.code());
+    }
+#endif
+    catch(const std::overflow_error & /*unused*/)
+    {
+      ep = std::exception_ptr();
+      return std::make_error_code(std::errc::value_too_large);
+    }
+    catch(const std::range_error & /*unused*/)
+    {
+      ep = std::exception_ptr();
+      return std::make_error_code(std::errc::result_out_of_range);
+    }
+    catch(const std::runtime_error & /*unused*/) /* base class for this group */
+    {
+      ep = std::exception_ptr();
+      return std::make_error_code(std::errc::resource_unavailable_try_again);
+    }
+    catch(const std::bad_alloc & /*unused*/)
+    {
+      ep = std::exception_ptr();
+      return std::make_error_code(std::errc::not_enough_memory);
+    }
+    catch(...)
+    {
+    }
+    return not_matched;
   }
-  catch(const std::runtime_error & /*unused*/) /* base class for this group */
+
+#ifdef OUTCOME_HAVE_EXCEPTION_PTR_TYPE
+  inline const void *exception_object(const std::exception_ptr &ep) noexcept
   {
-    ep = std::exception_ptr();
-    return std::make_error_code(std::errc::resource_unavailable_try_again);
+    static_assert(sizeof(std::exception_ptr) == sizeof(void *), "libstdc++ exception_ptr is expected to be a pointer to the thrown object");
+    const void *object;
+    memcpy(&object, &ep, sizeof(object));
+    return object;
   }
-  catch(const std::bad_alloc & /*unused*/)
+#endif
+}  // namespace detail
+
+#ifdef OUTCOME_HAVE_EXCEPTION_REGISTRY
+/*! Registers `make` as the factory of the error code equivalent to exceptions of type `E`, for
+`error_from_exception()` to use, replacing any factory previously registered for `E`, including
+those built in for the STL exception types. Typically called once per type at startup.
+
+Registration copies the whole table and so is slow, but lookups take no lock. Exceptions of exactly
+type `E` are found by a single hash lookup where the ABI can report the type of an exception without
+rethrowing it (`OUTCOME_HAVE_EXCEPTION_PTR_TYPE`). Otherwise, or for types derived from `E`, the
+exception is rethrown and matched against each registered type in turn, newest first.
+\requires `make` must not throw.
+*/
+template <class E> inline void register_exception_error(std::error_code (*make)(const E &))
+{
+  detail::exception_error_registry::get().add<E>(make);
+}
+#endif
+
+/*! Utility function which tries to match the exception in the pointer provided
+to an equivalent error code. Ought to work for all standard STL types, and all types
+registered with `register_exception_error()`.
+\param ep The pointer to an exception to convert. If matched, on exit this is
+reset to a null pointer.
+\param not_matched The error code to return if we could not match the exception.
+Note that a null pointer in returns a null error code.
+
+\effects Where the ABI can report the type of the exception in the pointer without
+rethrowing it (`OUTCOME_HAVE_EXCEPTION_PTR_TYPE`), looks up the exact type in the table of
+registered and STL exception types. Otherwise, or if the type is not in the table, rethrows the
+exception in the pointer, and tries the registered types, then a long sequence of `catch`
+clauses, to match the equivalent error code. If a match is found, the pointer is reset to null.
+If a match is not found, *not_matched* is returned instead and the pointer is left unmodified.
+*/
+inline std::error_code error_from_exception(std::exception_ptr &&ep = std::current_exception(), std::error_code not_matched = std::make_error_code(std::errc::resource_unavailable_try_again)) noexcept
+{
+  if(!ep)
   {
-    ep = std::exception_ptr();
-    return std::make_error_code(std::errc::not_enough_memory);
+    return {};
   }
-  catch(...)
+#ifdef OUTCOME_HAVE_EXCEPTION_PTR_TYPE
+  const std::type_info *type = ep.__cxa_exception_type();
+  if(type != nullptr)
   {
+    if(const detail::exception_error_snapshot::entry *e = detail::exception_error_registry::get().snapshot().find(*type))
+    {
+      std::error_code ret = e->convert(detail::exception_object(ep), e->make);
+      ep = std::exception_ptr();
+      return ret;
+    }
   }
-  return not_matched;
+#endif
+  return detail::error_from_rethrown_exception(ep, not_matched);
 }
 
 /*! Utility function which tries to throw the equivalent STL exception type for
@@ -147,6 +435,25 @@ inline void try_throw_std_exception_from_error(std::error_code ec, const std::st
     throw std::bad_alloc();
   }
 }
+#ifdef OUTCOME_ENABLE_BOOST_SYSTEM
+/*! Overload of `try_throw_std_exception_from_error()` for `boost::system::error_code`.
+
+\effects As for the `std::error_code` overload, with the categories being `boost::system::generic_category()`
+(all platforms) and `boost::system::system_category()` (POSIX only).
+*/
+inline void try_throw_std_exception_from_error(const boost::system::error_code &ec, const std::string &msg = std::string{})
+{
+  if(!ec || (ec.category() != boost::system::generic_category()
+#ifndef _WIN32
+             && ec.category() != boost::system::system_category()
+#endif
+             ))
+  {
+    return;
+  }
+  try_throw_std_exception_from_error(std::error_code(ec.value(), std::generic_category()), msg);
+}
+#endif
 #endif
 
 OUTCOME_V2_NAMESPACE_END
@@ -0,0 +1,34 @@
+/* Explicit instantiation definitions of the common result and outcome specialisations
+(C) 2017 Niall Douglas <http://www.nedproductions.biz/> (59 commits)
+File Created: Oct 2017
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../include/outcome/common_instantiations.hpp"
+
+//! \brief Defines one of `OUTCOME_COMMON_INSTANTIATIONS`, following its extern declaration.
+#define OUTCOME_COMMON_TEMPLATE(...) template class __VA_ARGS__;
+
+OUTCOME_V2_NAMESPACE_BEGIN
+
+OUTCOME_COMMON_INSTANTIATIONS(OUTCOME_COMMON_TEMPLATE)
+
+OUTCOME_V2_NAMESPACE_END
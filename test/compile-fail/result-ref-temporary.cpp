@@ -0,0 +1,14 @@
+/* clang-format off
+(error: use of deleted function|error: call to deleted constructor|attempting to reference a deleted function|error: no matching function for call to .+::result<const int ?&>::result|error: no matching constructor for initialization of 'result<const int ?&>')
+clang-format on
+*/
+
+#include "../../include/outcome/result.hpp"
+
+int main()
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  // Must not be possible to bind a reference holding result to a temporary
+  result<const int &> m(5);
+  return 0;
+}
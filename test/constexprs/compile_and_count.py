@@ -56,6 +56,46 @@ limits = {
 "min_option_next"                              : { 'gcc' :  5, 'clang' :  5, 'msvc' :  5 },
 "min_result_construct_value_move_destruct"     : { 'gcc' :  5, 'clang' :  5, 'msvc' :  5 },
 "min_result_next"                              : { 'gcc' :  5, 'clang' :  5, 'msvc' :  5 },
+"min_result_try_chain"                         : { 'gcc' : 65, 'clang' : 65, 'msvc' : 100 },
+"min_result_try_chain_no_hooks"                : { 'gcc' : 65, 'clang' : 65, 'msvc' : 100 },
+"min_result_monadic_chain"                     : { 'gcc' : 65, 'clang' : 65, 'msvc' : 100 },
+"min_outcome_value_sum"                        : { 'gcc' : 45, 'clang' : 45, 'msvc' : 100 },
+"min_result_all_narrow_value_sum"              : { 'gcc' : 20, 'clang' : 20, 'msvc' : 100 },
+"min_result_debug_checked_value_sum"           : { 'gcc' : 20, 'clang' : 20, 'msvc' : 100 },
+"min_result_exception_ptr_value_sum"           : { 'gcc' : 45, 'clang' : 45, 'msvc' : 100 },
+"min_result_terminate_value_sum"               : { 'gcc' : 30, 'clang' : 30, 'msvc' : 100 },
+"min_result_value_sum"                         : { 'gcc' : 30, 'clang' : 30, 'msvc' : 100 },
+"min_result_try_depth1"                        : { 'gcc' : 40, 'clang' : 40, 'msvc' : 100 },
+"min_result_try_depth2"                        : { 'gcc' : 52, 'clang' : 52, 'msvc' : 104 },
+"min_result_try_depth3"                        : { 'gcc' : 70, 'clang' : 70, 'msvc' : 140 },
+"min_result_try_depth4"                        : { 'gcc' : 88, 'clang' : 88, 'msvc' : 176 },
+"min_result_try_depth5"                        : { 'gcc' : 107, 'clang' : 107, 'msvc' : 214 },
+"min_result_try_depth6"                        : { 'gcc' : 124, 'clang' : 124, 'msvc' : 248 },
+"min_result_try_depth7"                        : { 'gcc' : 148, 'clang' : 148, 'msvc' : 296 },
+"min_result_try_depth8"                        : { 'gcc' : 165, 'clang' : 165, 'msvc' : 330 },
+"min_outcome_three_states"                     : { 'gcc' : 30, 'clang' : 30, 'msvc' : 100 },
+"min_outcome_construct_states"                 : { 'gcc' : 60, 'clang' : 60, 'msvc' : 120 },
+"min_result_convert"                           : { 'gcc' : 20, 'clang' : 20, 'msvc' : 100 },
+"min_outcome_from_result"                      : { 'gcc' : 16, 'clang' : 16, 'msvc' : 100 },
+"min_outcome_from_result_convert"              : { 'gcc' : 20, 'clang' : 20, 'msvc' : 100 },
+"min_result_swap"                              : { 'gcc' : 16, 'clang' : 16, 'msvc' : 100 },
+"min_result_value_or"                          : { 'gcc' : 18, 'clang' : 18, 'msvc' : 100 },
+"min_result_value_or_else"                     : { 'gcc' : 14, 'clang' : 14, 'msvc' : 100 },
+"min_result_assume_value_or"                   : { 'gcc' : 14, 'clang' : 14, 'msvc' : 100 },
+"min_result_error_or"                          : { 'gcc' : 14, 'clang' : 14, 'msvc' : 100 },
+"min_result_construct_error_code"              : { 'gcc' : 22, 'clang' : 22, 'msvc' : 100 },
+}
+
+#
+# Pairs of tests which must generate exactly the same number of ops
+#
+matches = {
+"min_result_try_chain"                         : "min_result_try_chain_handwritten",
+"min_result_try_chain_no_hooks"                : "min_result_try_chain",
+"min_result_debug_checked_value_sum"           : "min_result_all_narrow_value_sum",
+"min_result_try_depth3"                        : "min_result_try_chain",
+"min_result_value_or"                          : "min_result_value_or_handwritten",
+"min_result_monadic_chain"                     : "min_result_monadic_chain_handwritten",
 }
 
 
@@ -157,6 +197,14 @@ def test_all(func : str):
                 src_file, compiler, 1)
             csv_data.append((compiler, name, count))
             xml_string += xml_output
+    for compiler in _compilers_[os.name]:
+        counts = dict((t[1], t[2]) for t in csv_data if t[0] == compiler)
+        for test_name, other in matches.items():
+            if test_name in counts and other in counts and counts[test_name] != counts[other]:
+                xml_string += '  <testcase name="' + test_name + '.matches.' + compiler + '">\n' + \
+                    '    <failure message="Opcodes generated ' + str(counts[test_name]) + \
+                    ' differ from ' + str(counts[other]) + ' of ' + other + '"/>\n' + \
+                    '  </testcase>\n'
     xml_string += '</testsuite>'
 
     with open("results." + os.name + ".xml", "wt") as xml_file:
@@ -86,8 +86,9 @@ _get_call_target_ = \
     , 'dumpbin' : lambda l: re.match(r".*call\s+(.+)$", l).group(1)
     }
 
+# GCC moves unlikely paths into a '[clone .cold]' partition, which is not part of the hot path counted
 _is_our_function_ = \
-    { 'objdump' : lambda f: lambda l: (f in l) and ('-0x' not in l)
+    { 'objdump' : lambda f: lambda l: (f in l) and ('-0x' not in l) and ('.cold' not in l) and not l.startswith('_GLOBAL__sub_I_')
     , 'dumpbin' : lambda f: lambda l: (f in l) and ('?dtor' not in l)
     }
 
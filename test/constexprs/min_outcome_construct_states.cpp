@@ -0,0 +1,33 @@
+#include "../../include/outcome.hpp"
+
+#ifdef __GNUC__
+#define WEAK __attribute__((weak))
+#else
+#define WEAK
+#endif
+
+using namespace OUTCOME_V2_NAMESPACE;
+// Constructing an outcome in whichever of its three states is asked for
+extern std::exception_ptr unknown_exception WEAK;
+extern QUICKCPPLIB_NOINLINE outcome<int> test1(int which)
+{
+  switch(which)
+  {
+  case 0:
+    return 5;
+  case 1:
+    return std::error_code(5, std::generic_category());
+  default:
+    return unknown_exception;
+  }
+}
+extern QUICKCPPLIB_NOINLINE void test2()
+{
+}
+
+int main(void)
+{
+  outcome<int> m(test1(0));
+  test2();
+  return 0;
+}
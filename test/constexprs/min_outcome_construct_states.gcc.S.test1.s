@@ -0,0 +1,52 @@
+    11f0:	53                   	push   %rbx
+    11f1:	48 89 fb             	mov    %rdi,%rbx
+    11f4:	85 f6                	test   %esi,%esi
+    11f6:	74 60                	je     1258 <test1(int)+0x68>
+    11f8:	83 fe 01             	cmp    $0x1,%esi
+    11fb:	0f 84 87 00 00 00    	je     1288 <test1(int)+0x98>
+    1201:	48 c7 47 10 00 00 00 	movq   $0x0,0x10(%rdi)
+    1208:	00 
+    1209:	66 0f ef c0          	pxor   %xmm0,%xmm0
+    120d:	0f 11 07             	movups %xmm0,(%rdi)
+    1210:	e8 3b fe ff ff       	call   1050 <std::_V2::system_category()@plt>
+    1215:	48 8b 15 ac 2d 00 00 	mov    0x2dac(%rip),%rdx        # 3fc8 <unknown_exception@Base>
+    121c:	66 48 0f 6e c0       	movq   %rax,%xmm0
+    1221:	b8 04 00 00 00       	mov    $0x4,%eax
+    1226:	48 8b 12             	mov    (%rdx),%rdx
+    1229:	66 48 0f 6e ca       	movq   %rdx,%xmm1
+    122e:	66 0f 6c c1          	punpcklqdq %xmm1,%xmm0
+    1232:	0f 11 43 10          	movups %xmm0,0x10(%rbx)
+    1236:	48 85 d2             	test   %rdx,%rdx
+    1239:	74 0f                	je     124a <test1(int)+0x5a>
+    123b:	48 8d 7b 18          	lea    0x18(%rbx),%rdi
+    123f:	e8 ec fd ff ff       	call   1030 <std::__exception_ptr::exception_ptr::_M_addref()@plt>
+    1244:	8b 43 04             	mov    0x4(%rbx),%eax
+    1247:	83 c8 04             	or     $0x4,%eax
+    124a:	89 43 04             	mov    %eax,0x4(%rbx)
+    124d:	48 89 d8             	mov    %rbx,%rax
+    1250:	5b                   	pop    %rbx
+    1251:	c3                   	ret
+    1252:	66 0f 1f 44 00 00    	nopw   0x0(%rax,%rax,1)
+    1258:	48 b8 05 00 00 00 01 	movabs $0x100000005,%rax
+    125f:	00 00 00 
+    1262:	c7 47 08 00 00 00 00 	movl   $0x0,0x8(%rdi)
+    1269:	48 89 07             	mov    %rax,(%rdi)
+    126c:	e8 df fd ff ff       	call   1050 <std::_V2::system_category()@plt>
+    1271:	48 c7 43 18 00 00 00 	movq   $0x0,0x18(%rbx)
+    1278:	00 
+    1279:	48 89 43 10          	mov    %rax,0x10(%rbx)
+    127d:	48 89 d8             	mov    %rbx,%rax
+    1280:	5b                   	pop    %rbx
+    1281:	c3                   	ret
+    1282:	66 0f 1f 44 00 00    	nopw   0x0(%rax,%rax,1)
+    1288:	e8 b3 fd ff ff       	call   1040 <std::_V2::generic_category()@plt>
+    128d:	48 c7 43 18 00 00 00 	movq   $0x0,0x18(%rbx)
+    1294:	00 
+    1295:	48 89 43 10          	mov    %rax,0x10(%rbx)
+    1299:	48 b8 12 00 00 00 05 	movabs $0x500000012,%rax
+    12a0:	00 00 00 
+    12a3:	48 89 43 04          	mov    %rax,0x4(%rbx)
+    12a7:	48 89 d8             	mov    %rbx,%rax
+    12aa:	5b                   	pop    %rbx
+    12ab:	c3                   	ret
+    12ac:	0f 1f 40 00          	nopl   0x0(%rax)
@@ -0,0 +1,18 @@
+    1220:	53                   	push   %rbx
+    1221:	48 89 fb             	mov    %rdi,%rbx
+    1224:	48 83 ec 20          	sub    $0x20,%rsp
+    1228:	48 89 e7             	mov    %rsp,%rdi
+    122b:	e8 40 fe ff ff       	call   1070 <unknown1()@plt>
+    1230:	48 8b 04 24          	mov    (%rsp),%rax
+    1234:	f3 0f 6f 44 24 08    	movdqu 0x8(%rsp),%xmm0
+    123a:	48 c7 43 18 00 00 00 	movq   $0x0,0x18(%rbx)
+    1241:	00 
+    1242:	48 89 03             	mov    %rax,(%rbx)
+    1245:	48 89 d8             	mov    %rbx,%rax
+    1248:	0f 11 43 08          	movups %xmm0,0x8(%rbx)
+    124c:	48 83 c4 20          	add    $0x20,%rsp
+    1250:	5b                   	pop    %rbx
+    1251:	c3                   	ret
+    1252:	66 66 2e 0f 1f 84 00 	data16 cs nopw 0x0(%rax,%rax,1)
+    1259:	00 00 00 00 
+    125d:	0f 1f 00             	nopl   (%rax)
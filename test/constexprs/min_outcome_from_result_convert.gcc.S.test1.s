@@ -0,0 +1,23 @@
+    1220:	53                   	push   %rbx
+    1221:	48 89 fb             	mov    %rdi,%rbx
+    1224:	48 83 ec 20          	sub    $0x20,%rsp
+    1228:	48 89 e7             	mov    %rsp,%rdi
+    122b:	e8 40 fe ff ff       	call   1070 <unknown1()@plt>
+    1230:	8b 54 24 04          	mov    0x4(%rsp),%edx
+    1234:	48 63 04 24          	movslq (%rsp),%rax
+    1238:	31 c9                	xor    %ecx,%ecx
+    123a:	f3 0f 6f 44 24 08    	movdqu 0x8(%rsp),%xmm0
+    1240:	48 c7 43 20 00 00 00 	movq   $0x0,0x20(%rbx)
+    1247:	00 
+    1248:	f6 c2 01             	test   $0x1,%dl
+    124b:	89 53 08             	mov    %edx,0x8(%rbx)
+    124e:	48 0f 44 c1          	cmove  %rcx,%rax
+    1252:	0f 11 43 10          	movups %xmm0,0x10(%rbx)
+    1256:	48 89 03             	mov    %rax,(%rbx)
+    1259:	48 83 c4 20          	add    $0x20,%rsp
+    125d:	48 89 d8             	mov    %rbx,%rax
+    1260:	5b                   	pop    %rbx
+    1261:	c3                   	ret
+    1262:	66 66 2e 0f 1f 84 00 	data16 cs nopw 0x0(%rax,%rax,1)
+    1269:	00 00 00 00 
+    126d:	0f 1f 00             	nopl   (%rax)
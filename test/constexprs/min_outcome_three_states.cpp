@@ -0,0 +1,34 @@
+#include "../../include/outcome.hpp"
+
+#ifdef __GNUC__
+#define WEAK __attribute__((weak))
+#else
+#define WEAK
+#endif
+
+using namespace OUTCOME_V2_NAMESPACE;
+// Inspecting each of the three states of an outcome
+extern outcome<int> unknown1() WEAK;
+extern QUICKCPPLIB_NOINLINE int test1()
+{
+  outcome<int> o(unknown1());
+  if(o.has_value())
+  {
+    return o.assume_value();
+  }
+  if(o.has_error())
+  {
+    return o.assume_error().value();
+  }
+  return o.has_exception() ? -1 : -2;
+}
+extern QUICKCPPLIB_NOINLINE void test2()
+{
+}
+
+int main(void)
+{
+  int ret = test1();
+  test2();
+  return ret;
+}
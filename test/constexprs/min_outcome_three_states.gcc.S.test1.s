@@ -0,0 +1,25 @@
+    11b0:	53                   	push   %rbx
+    11b1:	48 83 ec 20          	sub    $0x20,%rsp
+    11b5:	48 89 e7             	mov    %rsp,%rdi
+    11b8:	e8 93 fe ff ff       	call   1050 <unknown1()@plt>
+    11bd:	8b 44 24 04          	mov    0x4(%rsp),%eax
+    11c1:	8b 1c 24             	mov    (%rsp),%ebx
+    11c4:	a8 01                	test   $0x1,%al
+    11c6:	75 08                	jne    11d0 <test1()+0x20>
+    11c8:	a8 02                	test   $0x2,%al
+    11ca:	74 24                	je     11f0 <test1()+0x40>
+    11cc:	8b 5c 24 08          	mov    0x8(%rsp),%ebx
+    11d0:	48 83 7c 24 18 00    	cmpq   $0x0,0x18(%rsp)
+    11d6:	74 0a                	je     11e2 <test1()+0x32>
+    11d8:	48 8d 7c 24 18       	lea    0x18(%rsp),%rdi
+    11dd:	e8 4e fe ff ff       	call   1030 <std::__exception_ptr::exception_ptr::_M_release()@plt>
+    11e2:	48 83 c4 20          	add    $0x20,%rsp
+    11e6:	89 d8                	mov    %ebx,%eax
+    11e8:	5b                   	pop    %rbx
+    11e9:	c3                   	ret
+    11ea:	66 0f 1f 44 00 00    	nopw   0x0(%rax,%rax,1)
+    11f0:	c1 e8 02             	shr    $0x2,%eax
+    11f3:	89 c3                	mov    %eax,%ebx
+    11f5:	83 cb fe             	or     $0xfffffffe,%ebx
+    11f8:	eb d6                	jmp    11d0 <test1()+0x20>
+    11fa:	66 0f 1f 44 00 00    	nopw   0x0(%rax,%rax,1)
@@ -0,0 +1,29 @@
+#include "../../include/outcome.hpp"
+
+#ifdef __GNUC__
+#define WEAK __attribute__((weak))
+#else
+#define WEAK
+#endif
+
+using namespace OUTCOME_V2_NAMESPACE;
+// As min_result_value_sum, for the outcome policy rethrowing an exception or throwing the error
+extern outcome<int> unknown1() WEAK;
+extern outcome<int> unknown2() WEAK;
+extern outcome<int> unknown3() WEAK;
+extern QUICKCPPLIB_NOINLINE int test1()
+{
+  return unknown1().value() + unknown2().value() + unknown3().value();
+}
+extern QUICKCPPLIB_NOINLINE void test2()
+{
+}
+
+int main(void)
+{
+  int ret = 0;
+  if(5 != test1())
+    ret = 1;
+  test2();
+  return ret;
+}
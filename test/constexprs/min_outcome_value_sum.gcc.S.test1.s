@@ -0,0 +1,40 @@
+    1490:	53                   	push   %rbx
+    1491:	48 83 ec 60          	sub    $0x60,%rsp
+    1495:	48 89 e7             	mov    %rsp,%rdi
+    1498:	e8 03 fc ff ff       	call   10a0 <unknown1()@plt>
+    149d:	8b 44 24 04          	mov    0x4(%rsp),%eax
+    14a1:	a8 01                	test   $0x1,%al
+    14a3:	0f 84 c7 fd ff ff    	je     1270 <test1() [clone .cold]>
+    14a9:	48 8d 7c 24 20       	lea    0x20(%rsp),%rdi
+    14ae:	8b 1c 24             	mov    (%rsp),%ebx
+    14b1:	e8 1a fc ff ff       	call   10d0 <unknown2()@plt>
+    14b6:	8b 44 24 24          	mov    0x24(%rsp),%eax
+    14ba:	a8 01                	test   $0x1,%al
+    14bc:	0f 84 2e fe ff ff    	je     12f0 <test1() [clone .cold]+0x80>
+    14c2:	48 8d 7c 24 40       	lea    0x40(%rsp),%rdi
+    14c7:	03 5c 24 20          	add    0x20(%rsp),%ebx
+    14cb:	e8 80 fb ff ff       	call   1050 <unknown3()@plt>
+    14d0:	8b 44 24 44          	mov    0x44(%rsp),%eax
+    14d4:	a8 01                	test   $0x1,%al
+    14d6:	0f 84 a6 fd ff ff    	je     1282 <test1() [clone .cold]+0x12>
+    14dc:	03 5c 24 40          	add    0x40(%rsp),%ebx
+    14e0:	48 83 7c 24 58 00    	cmpq   $0x0,0x58(%rsp)
+    14e6:	74 0a                	je     14f2 <test1()+0x62>
+    14e8:	48 8d 7c 24 58       	lea    0x58(%rsp),%rdi
+    14ed:	e8 6e fb ff ff       	call   1060 <std::__exception_ptr::exception_ptr::_M_release()@plt>
+    14f2:	48 83 7c 24 38 00    	cmpq   $0x0,0x38(%rsp)
+    14f8:	74 0a                	je     1504 <test1()+0x74>
+    14fa:	48 8d 7c 24 38       	lea    0x38(%rsp),%rdi
+    14ff:	e8 5c fb ff ff       	call   1060 <std::__exception_ptr::exception_ptr::_M_release()@plt>
+    1504:	48 83 7c 24 18 00    	cmpq   $0x0,0x18(%rsp)
+    150a:	74 0a                	je     1516 <test1()+0x86>
+    150c:	48 8d 7c 24 18       	lea    0x18(%rsp),%rdi
+    1511:	e8 4a fb ff ff       	call   1060 <std::__exception_ptr::exception_ptr::_M_release()@plt>
+    1516:	48 83 c4 60          	add    $0x60,%rsp
+    151a:	89 d8                	mov    %ebx,%eax
+    151c:	5b                   	pop    %rbx
+    151d:	c3                   	ret
+    151e:	e9 7b fd ff ff       	jmp    129e <test1() [clone .cold]+0x2e>
+    1523:	e9 fe fd ff ff       	jmp    1326 <test1() [clone .cold]+0xb6>
+    1528:	0f 1f 84 00 00 00 00 	nopl   0x0(%rax,%rax,1)
+    152f:	00 
@@ -0,0 +1,15 @@
+    11a0:	53                   	push   %rbx
+    11a1:	89 fb                	mov    %edi,%ebx
+    11a3:	48 83 ec 20          	sub    $0x20,%rsp
+    11a7:	48 89 e7             	mov    %rsp,%rdi
+    11aa:	e8 91 fe ff ff       	call   1040 <unknown1()@plt>
+    11af:	f6 44 24 04 01       	testb  $0x1,0x4(%rsp)
+    11b4:	74 03                	je     11b9 <test1(int)+0x19>
+    11b6:	8b 1c 24             	mov    (%rsp),%ebx
+    11b9:	48 83 c4 20          	add    $0x20,%rsp
+    11bd:	89 d8                	mov    %ebx,%eax
+    11bf:	5b                   	pop    %rbx
+    11c0:	c3                   	ret
+    11c1:	66 66 2e 0f 1f 84 00 	data16 cs nopw 0x0(%rax,%rax,1)
+    11c8:	00 00 00 00 
+    11cc:	0f 1f 40 00          	nopl   0x0(%rax)
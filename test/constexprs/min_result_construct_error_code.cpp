@@ -0,0 +1,25 @@
+#include "../../include/outcome.hpp"
+
+#ifdef __GNUC__
+#define WEAK __attribute__((weak))
+#else
+#define WEAK
+#endif
+
+using namespace OUTCOME_V2_NAMESPACE;
+// Constructing from an error code, which decides whether errno can be set from it
+extern std::error_code unknown1() WEAK;
+extern QUICKCPPLIB_NOINLINE result<int> test1()
+{
+  return result<int>(unknown1());
+}
+extern QUICKCPPLIB_NOINLINE void test2()
+{
+}
+
+int main(void)
+{
+  result<int> m(test1());
+  test2();
+  return 0;
+}
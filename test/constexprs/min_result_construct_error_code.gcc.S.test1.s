@@ -0,0 +1,22 @@
+    1230:	53                   	push   %rbx
+    1231:	48 89 fb             	mov    %rdi,%rbx
+    1234:	e8 27 fe ff ff       	call   1060 <unknown1()@plt>
+    1239:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    1240:	48 89 43 08          	mov    %rax,0x8(%rbx)
+    1244:	48 8b 05 05 2e 00 00 	mov    0x2e05(%rip),%rax        # 4050 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    124b:	48 89 53 10          	mov    %rdx,0x10(%rbx)
+    124f:	48 39 c2             	cmp    %rax,%rdx
+    1252:	74 1c                	je     1270 <test1()+0x40>
+    1254:	48 3b 15 fd 2d 00 00 	cmp    0x2dfd(%rip),%rdx        # 4058 <outcome_v2_xxx::detail::errno_categories<void>::addresses+0x8>
+    125b:	74 13                	je     1270 <test1()+0x40>
+    125d:	48 85 c0             	test   %rax,%rax
+    1260:	0f 84 4a fe ff ff    	je     10b0 <test1() [clone .cold]>
+    1266:	48 89 d8             	mov    %rbx,%rax
+    1269:	5b                   	pop    %rbx
+    126a:	c3                   	ret
+    126b:	0f 1f 44 00 00       	nopl   0x0(%rax,%rax,1)
+    1270:	48 89 d8             	mov    %rbx,%rax
+    1273:	c7 43 04 12 00 00 00 	movl   $0x12,0x4(%rbx)
+    127a:	5b                   	pop    %rbx
+    127b:	c3                   	ret
+    127c:	0f 1f 40 00          	nopl   0x0(%rax)
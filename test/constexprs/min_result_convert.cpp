@@ -0,0 +1,25 @@
+#include "../../include/outcome.hpp"
+
+#ifdef __GNUC__
+#define WEAK __attribute__((weak))
+#else
+#define WEAK
+#endif
+
+using namespace OUTCOME_V2_NAMESPACE;
+// The converting constructor from a compatible result
+extern result<int> unknown1() WEAK;
+extern QUICKCPPLIB_NOINLINE result<long> test1()
+{
+  return result<long>(unknown1());
+}
+extern QUICKCPPLIB_NOINLINE void test2()
+{
+}
+
+int main(void)
+{
+  result<long> m(test1());
+  test2();
+  return 0;
+}
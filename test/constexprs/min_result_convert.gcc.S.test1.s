@@ -0,0 +1,19 @@
+    1200:	53                   	push   %rbx
+    1201:	48 89 fb             	mov    %rdi,%rbx
+    1204:	48 83 ec 20          	sub    $0x20,%rsp
+    1208:	48 89 e7             	mov    %rsp,%rdi
+    120b:	e8 50 fe ff ff       	call   1060 <unknown1()@plt>
+    1210:	8b 54 24 04          	mov    0x4(%rsp),%edx
+    1214:	48 63 04 24          	movslq (%rsp),%rax
+    1218:	31 c9                	xor    %ecx,%ecx
+    121a:	f3 0f 6f 44 24 08    	movdqu 0x8(%rsp),%xmm0
+    1220:	f6 c2 01             	test   $0x1,%dl
+    1223:	89 53 08             	mov    %edx,0x8(%rbx)
+    1226:	48 0f 44 c1          	cmove  %rcx,%rax
+    122a:	0f 11 43 10          	movups %xmm0,0x10(%rbx)
+    122e:	48 89 03             	mov    %rax,(%rbx)
+    1231:	48 83 c4 20          	add    $0x20,%rsp
+    1235:	48 89 d8             	mov    %rbx,%rax
+    1238:	5b                   	pop    %rbx
+    1239:	c3                   	ret
+    123a:	66 0f 1f 44 00 00    	nopw   0x0(%rax,%rax,1)
@@ -0,0 +1,29 @@
+#include "../../include/outcome.hpp"
+
+#ifdef __GNUC__
+#define WEAK __attribute__((weak))
+#else
+#define WEAK
+#endif
+
+using namespace OUTCOME_V2_NAMESPACE;
+// In release builds the wide checks of debug_checked must cost no more than those of all_narrow
+extern result<int, std::error_code, policy::debug_checked> unknown1() WEAK;
+extern result<int, std::error_code, policy::debug_checked> unknown2() WEAK;
+extern result<int, std::error_code, policy::debug_checked> unknown3() WEAK;
+extern QUICKCPPLIB_NOINLINE int test1()
+{
+  return unknown1().value() + unknown2().value() + unknown3().value();
+}
+extern QUICKCPPLIB_NOINLINE void test2()
+{
+}
+
+int main(void)
+{
+  int ret = 0;
+  if(5 != test1())
+    ret = 1;
+  test2();
+  return ret;
+}
@@ -0,0 +1,18 @@
+    11d0:	53                   	push   %rbx
+    11d1:	48 83 ec 60          	sub    $0x60,%rsp
+    11d5:	48 89 e7             	mov    %rsp,%rdi
+    11d8:	e8 73 fe ff ff       	call   1050 <unknown1()@plt>
+    11dd:	48 8d 7c 24 20       	lea    0x20(%rsp),%rdi
+    11e2:	8b 1c 24             	mov    (%rsp),%ebx
+    11e5:	e8 76 fe ff ff       	call   1060 <unknown2()@plt>
+    11ea:	48 8d 7c 24 40       	lea    0x40(%rsp),%rdi
+    11ef:	03 5c 24 20          	add    0x20(%rsp),%ebx
+    11f3:	e8 38 fe ff ff       	call   1030 <unknown3()@plt>
+    11f8:	8b 44 24 40          	mov    0x40(%rsp),%eax
+    11fc:	48 83 c4 60          	add    $0x60,%rsp
+    1200:	01 d8                	add    %ebx,%eax
+    1202:	5b                   	pop    %rbx
+    1203:	c3                   	ret
+    1204:	66 66 2e 0f 1f 84 00 	data16 cs nopw 0x0(%rax,%rax,1)
+    120b:	00 00 00 00 
+    120f:	90                   	nop
@@ -0,0 +1,40 @@
+    13a0:	53                   	push   %rbx
+    13a1:	48 83 ec 30          	sub    $0x30,%rsp
+    13a5:	48 89 e7             	mov    %rsp,%rdi
+    13a8:	e8 f3 fc ff ff       	call   10a0 <unknown1()@plt>
+    13ad:	8b 44 24 04          	mov    0x4(%rsp),%eax
+    13b1:	a8 01                	test   $0x1,%al
+    13b3:	0f 84 f3 fd ff ff    	je     11ac <test1() [clone .cold]>
+    13b9:	48 8d 7c 24 10       	lea    0x10(%rsp),%rdi
+    13be:	8b 1c 24             	mov    (%rsp),%ebx
+    13c1:	e8 fa fc ff ff       	call   10c0 <unknown2()@plt>
+    13c6:	8b 44 24 14          	mov    0x14(%rsp),%eax
+    13ca:	a8 01                	test   $0x1,%al
+    13cc:	0f 84 4c fe ff ff    	je     121e <test1() [clone .cold]+0x72>
+    13d2:	48 8d 7c 24 20       	lea    0x20(%rsp),%rdi
+    13d7:	03 5c 24 10          	add    0x10(%rsp),%ebx
+    13db:	e8 70 fc ff ff       	call   1050 <unknown3()@plt>
+    13e0:	8b 44 24 24          	mov    0x24(%rsp),%eax
+    13e4:	a8 01                	test   $0x1,%al
+    13e6:	0f 84 d2 fd ff ff    	je     11be <test1() [clone .cold]+0x12>
+    13ec:	03 5c 24 20          	add    0x20(%rsp),%ebx
+    13f0:	48 83 7c 24 28 00    	cmpq   $0x0,0x28(%rsp)
+    13f6:	74 0a                	je     1402 <test1()+0x62>
+    13f8:	48 8d 7c 24 28       	lea    0x28(%rsp),%rdi
+    13fd:	e8 5e fc ff ff       	call   1060 <std::__exception_ptr::exception_ptr::_M_release()@plt>
+    1402:	48 83 7c 24 18 00    	cmpq   $0x0,0x18(%rsp)
+    1408:	74 0a                	je     1414 <test1()+0x74>
+    140a:	48 8d 7c 24 18       	lea    0x18(%rsp),%rdi
+    140f:	e8 4c fc ff ff       	call   1060 <std::__exception_ptr::exception_ptr::_M_release()@plt>
+    1414:	48 83 7c 24 08 00    	cmpq   $0x0,0x8(%rsp)
+    141a:	74 0a                	je     1426 <test1()+0x86>
+    141c:	48 8d 7c 24 08       	lea    0x8(%rsp),%rdi
+    1421:	e8 3a fc ff ff       	call   1060 <std::__exception_ptr::exception_ptr::_M_release()@plt>
+    1426:	48 83 c4 30          	add    $0x30,%rsp
+    142a:	89 d8                	mov    %ebx,%eax
+    142c:	5b                   	pop    %rbx
+    142d:	c3                   	ret
+    142e:	e9 a5 fd ff ff       	jmp    11d8 <test1() [clone .cold]+0x2c>
+    1433:	e9 0c fe ff ff       	jmp    1244 <test1() [clone .cold]+0x98>
+    1438:	0f 1f 84 00 00 00 00 	nopl   0x0(%rax,%rax,1)
+    143f:	00 
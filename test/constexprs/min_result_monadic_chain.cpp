@@ -0,0 +1,33 @@
+#include "../../include/outcome.hpp"
+
+#ifdef __GNUC__
+#define WEAK __attribute__((weak))
+#else
+#define WEAK
+#endif
+
+using namespace OUTCOME_V2_NAMESPACE;
+using namespace OUTCOME_V2_NAMESPACE::monadic;
+extern result<int> unknown1() WEAK;
+extern result<int> unknown2(int) WEAK;
+extern result<int> unknown3(int) WEAK;
+extern QUICKCPPLIB_NOINLINE result<int> test1()
+{
+  // Five stages, which must generate the same code as min_result_monadic_chain_handwritten.cpp
+  return unknown1()                                     //
+         | map([](int v) { return v * 2; })              //
+         | and_then([](int v) { return unknown2(v); })   //
+         | map([](int v) { return v + 1; })              //
+         | and_then([](int v) { return unknown3(v); })   //
+         | map([](int v) { return v * 3; });
+}
+extern QUICKCPPLIB_NOINLINE void test2()
+{
+}
+
+int main(void)
+{
+  result<int> m(test1());
+  test2();
+  return 0;
+}
@@ -0,0 +1,67 @@
+    1250:	53                   	push   %rbx
+    1251:	48 89 fb             	mov    %rdi,%rbx
+    1254:	48 83 ec 60          	sub    $0x60,%rsp
+    1258:	48 89 e7             	mov    %rsp,%rdi
+    125b:	e8 10 fe ff ff       	call   1070 <unknown1()@plt>
+    1260:	f6 44 24 04 01       	testb  $0x1,0x4(%rsp)
+    1265:	75 59                	jne    12c0 <test1()+0x70>
+    1267:	48 8b 7c 24 10       	mov    0x10(%rsp),%rdi
+    126c:	8b 44 24 08          	mov    0x8(%rsp),%eax
+    1270:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    1277:	89 43 08             	mov    %eax,0x8(%rbx)
+    127a:	48 8b 05 df 2d 00 00 	mov    0x2ddf(%rip),%rax        # 4060 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    1281:	48 89 7b 10          	mov    %rdi,0x10(%rbx)
+    1285:	48 39 c7             	cmp    %rax,%rdi
+    1288:	74 1e                	je     12a8 <test1()+0x58>
+    128a:	48 3b 3d d7 2d 00 00 	cmp    0x2dd7(%rip),%rdi        # 4068 <outcome_v2_xxx::detail::errno_categories<void>::addresses+0x8>
+    1291:	74 15                	je     12a8 <test1()+0x58>
+    1293:	48 85 c0             	test   %rax,%rax
+    1296:	0f 84 34 fe ff ff    	je     10d0 <test1() [clone .cold]>
+    129c:	48 83 c4 60          	add    $0x60,%rsp
+    12a0:	48 89 d8             	mov    %rbx,%rax
+    12a3:	5b                   	pop    %rbx
+    12a4:	c3                   	ret
+    12a5:	0f 1f 00             	nopl   (%rax)
+    12a8:	c7 43 04 12 00 00 00 	movl   $0x12,0x4(%rbx)
+    12af:	48 83 c4 60          	add    $0x60,%rsp
+    12b3:	48 89 d8             	mov    %rbx,%rax
+    12b6:	5b                   	pop    %rbx
+    12b7:	c3                   	ret
+    12b8:	0f 1f 84 00 00 00 00 	nopl   0x0(%rax,%rax,1)
+    12bf:	00 
+    12c0:	8b 04 24             	mov    (%rsp),%eax
+    12c3:	48 8d 7c 24 20       	lea    0x20(%rsp),%rdi
+    12c8:	8d 34 00             	lea    (%rax,%rax,1),%esi
+    12cb:	e8 80 fd ff ff       	call   1050 <unknown2(int)@plt>
+    12d0:	f6 44 24 24 01       	testb  $0x1,0x24(%rsp)
+    12d5:	75 19                	jne    12f0 <test1()+0xa0>
+    12d7:	48 8b 7c 24 30       	mov    0x30(%rsp),%rdi
+    12dc:	8b 44 24 28          	mov    0x28(%rsp),%eax
+    12e0:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    12e7:	eb 8e                	jmp    1277 <test1()+0x27>
+    12e9:	0f 1f 80 00 00 00 00 	nopl   0x0(%rax)
+    12f0:	8b 44 24 20          	mov    0x20(%rsp),%eax
+    12f4:	48 8d 7c 24 40       	lea    0x40(%rsp),%rdi
+    12f9:	8d 70 01             	lea    0x1(%rax),%esi
+    12fc:	e8 8f fd ff ff       	call   1090 <unknown3(int)@plt>
+    1301:	f6 44 24 44 01       	testb  $0x1,0x44(%rsp)
+    1306:	75 18                	jne    1320 <test1()+0xd0>
+    1308:	48 8b 7c 24 50       	mov    0x50(%rsp),%rdi
+    130d:	8b 44 24 48          	mov    0x48(%rsp),%eax
+    1311:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    1318:	e9 5a ff ff ff       	jmp    1277 <test1()+0x27>
+    131d:	0f 1f 00             	nopl   (%rax)
+    1320:	8b 44 24 40          	mov    0x40(%rsp),%eax
+    1324:	48 c7 43 04 01 00 00 	movq   $0x1,0x4(%rbx)
+    132b:	00 
+    132c:	8d 04 40             	lea    (%rax,%rax,2),%eax
+    132f:	89 03                	mov    %eax,(%rbx)
+    1331:	e8 0a fd ff ff       	call   1040 <std::_V2::system_category()@plt>
+    1336:	48 89 43 10          	mov    %rax,0x10(%rbx)
+    133a:	48 83 c4 60          	add    $0x60,%rsp
+    133e:	48 89 d8             	mov    %rbx,%rax
+    1341:	5b                   	pop    %rbx
+    1342:	c3                   	ret
+    1343:	66 66 2e 0f 1f 84 00 	data16 cs nopw 0x0(%rax,%rax,1)
+    134a:	00 00 00 00 
+    134e:	66 90                	xchg   %ax,%ax
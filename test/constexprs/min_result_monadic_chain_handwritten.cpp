@@ -0,0 +1,42 @@
+#include "../../include/outcome.hpp"
+
+#ifdef __GNUC__
+#define WEAK __attribute__((weak))
+#else
+#define WEAK
+#endif
+
+using namespace OUTCOME_V2_NAMESPACE;
+extern result<int> unknown1() WEAK;
+extern result<int> unknown2(int) WEAK;
+extern result<int> unknown3(int) WEAK;
+extern QUICKCPPLIB_NOINLINE result<int> test1()
+{
+  // Must generate the same code as min_result_monadic_chain.cpp
+  result<int> a = unknown1();
+  if(!a.has_value())
+  {
+    return failure(std::move(a).assume_error());
+  }
+  result<int> b = unknown2(a.assume_value() * 2);
+  if(!b.has_value())
+  {
+    return failure(std::move(b).assume_error());
+  }
+  result<int> c = unknown3(b.assume_value() + 1);
+  if(!c.has_value())
+  {
+    return failure(std::move(c).assume_error());
+  }
+  return c.assume_value() * 3;
+}
+extern QUICKCPPLIB_NOINLINE void test2()
+{
+}
+
+int main(void)
+{
+  result<int> m(test1());
+  test2();
+  return 0;
+}
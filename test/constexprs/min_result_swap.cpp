@@ -0,0 +1,25 @@
+#include "../../include/outcome.hpp"
+
+#ifdef __GNUC__
+#define WEAK __attribute__((weak))
+#else
+#define WEAK
+#endif
+
+using namespace OUTCOME_V2_NAMESPACE;
+// Swapping two trivially copyable results
+extern QUICKCPPLIB_NOINLINE void test1(result<int> &a, result<int> &b)
+{
+  a.swap(b);
+}
+extern QUICKCPPLIB_NOINLINE void test2()
+{
+}
+
+int main(void)
+{
+  result<int> a(5), b(std::error_code(5, std::generic_category()));
+  test1(a, b);
+  test2();
+  return a.has_value() ? 1 : 0;
+}
@@ -0,0 +1,14 @@
+    1200:	48 8b 07             	mov    (%rdi),%rax
+    1203:	48 8b 16             	mov    (%rsi),%rdx
+    1206:	f3 0f 6f 46 08       	movdqu 0x8(%rsi),%xmm0
+    120b:	48 89 17             	mov    %rdx,(%rdi)
+    120e:	8b 57 08             	mov    0x8(%rdi),%edx
+    1211:	48 89 06             	mov    %rax,(%rsi)
+    1214:	48 8b 47 10          	mov    0x10(%rdi),%rax
+    1218:	0f 11 47 08          	movups %xmm0,0x8(%rdi)
+    121c:	89 56 08             	mov    %edx,0x8(%rsi)
+    121f:	48 89 46 10          	mov    %rax,0x10(%rsi)
+    1223:	c3                   	ret
+    1224:	66 66 2e 0f 1f 84 00 	data16 cs nopw 0x0(%rax,%rax,1)
+    122b:	00 00 00 00 
+    122f:	90                   	nop
@@ -0,0 +1,23 @@
+    11f0:	53                   	push   %rbx
+    11f1:	48 83 ec 60          	sub    $0x60,%rsp
+    11f5:	48 89 e7             	mov    %rsp,%rdi
+    11f8:	e8 63 fe ff ff       	call   1060 <unknown1()@plt>
+    11fd:	f6 44 24 04 01       	testb  $0x1,0x4(%rsp)
+    1202:	0f 84 9e fe ff ff    	je     10a6 <test1() [clone .cold]>
+    1208:	48 8d 7c 24 20       	lea    0x20(%rsp),%rdi
+    120d:	8b 1c 24             	mov    (%rsp),%ebx
+    1210:	e8 5b fe ff ff       	call   1070 <unknown2()@plt>
+    1215:	f6 44 24 24 01       	testb  $0x1,0x24(%rsp)
+    121a:	0f 84 86 fe ff ff    	je     10a6 <test1() [clone .cold]>
+    1220:	48 8d 7c 24 40       	lea    0x40(%rsp),%rdi
+    1225:	03 5c 24 20          	add    0x20(%rsp),%ebx
+    1229:	e8 12 fe ff ff       	call   1040 <unknown3()@plt>
+    122e:	f6 44 24 44 01       	testb  $0x1,0x44(%rsp)
+    1233:	0f 84 6d fe ff ff    	je     10a6 <test1() [clone .cold]>
+    1239:	8b 44 24 40          	mov    0x40(%rsp),%eax
+    123d:	48 83 c4 60          	add    $0x60,%rsp
+    1241:	01 d8                	add    %ebx,%eax
+    1243:	5b                   	pop    %rbx
+    1244:	c3                   	ret
+    1245:	66 66 2e 0f 1f 84 00 	data16 cs nopw 0x0(%rax,%rax,1)
+    124c:	00 00 00 00 
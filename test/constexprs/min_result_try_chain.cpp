@@ -0,0 +1,29 @@
+#include "../../include/outcome.hpp"
+
+#ifdef __GNUC__
+#define WEAK __attribute__((weak))
+#else
+#define WEAK
+#endif
+
+using namespace OUTCOME_V2_NAMESPACE;
+extern result<int> unknown1() WEAK;
+extern result<int> unknown2() WEAK;
+extern result<int> unknown3() WEAK;
+extern QUICKCPPLIB_NOINLINE result<int> test1()
+{
+  OUTCOME_TRY(a, unknown1());
+  OUTCOME_TRY(b, unknown2());
+  OUTCOME_TRY(c, unknown3());
+  return a + b + c;
+}
+extern QUICKCPPLIB_NOINLINE void test2()
+{
+}
+
+int main(void)
+{
+  result<int> m(test1());
+  test2();
+  return 0;
+}
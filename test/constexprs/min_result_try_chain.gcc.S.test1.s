@@ -0,0 +1,67 @@
+    1250:	53                   	push   %rbx
+    1251:	48 89 fb             	mov    %rdi,%rbx
+    1254:	48 83 ec 60          	sub    $0x60,%rsp
+    1258:	48 89 e7             	mov    %rsp,%rdi
+    125b:	e8 10 fe ff ff       	call   1070 <unknown1()@plt>
+    1260:	f6 44 24 04 01       	testb  $0x1,0x4(%rsp)
+    1265:	74 59                	je     12c0 <test1()+0x70>
+    1267:	48 8d 7c 24 20       	lea    0x20(%rsp),%rdi
+    126c:	e8 0f fe ff ff       	call   1080 <unknown2()@plt>
+    1271:	f6 44 24 24 01       	testb  $0x1,0x24(%rsp)
+    1276:	0f 84 84 00 00 00    	je     1300 <test1()+0xb0>
+    127c:	48 8d 7c 24 40       	lea    0x40(%rsp),%rdi
+    1281:	e8 ca fd ff ff       	call   1050 <unknown3()@plt>
+    1286:	f6 44 24 44 01       	testb  $0x1,0x44(%rsp)
+    128b:	0f 84 a7 00 00 00    	je     1338 <test1()+0xe8>
+    1291:	8b 44 24 20          	mov    0x20(%rsp),%eax
+    1295:	03 04 24             	add    (%rsp),%eax
+    1298:	48 c7 43 04 01 00 00 	movq   $0x1,0x4(%rbx)
+    129f:	00 
+    12a0:	03 44 24 40          	add    0x40(%rsp),%eax
+    12a4:	89 03                	mov    %eax,(%rbx)
+    12a6:	e8 95 fd ff ff       	call   1040 <std::_V2::system_category()@plt>
+    12ab:	48 89 43 10          	mov    %rax,0x10(%rbx)
+    12af:	48 83 c4 60          	add    $0x60,%rsp
+    12b3:	48 89 d8             	mov    %rbx,%rax
+    12b6:	5b                   	pop    %rbx
+    12b7:	c3                   	ret
+    12b8:	0f 1f 84 00 00 00 00 	nopl   0x0(%rax,%rax,1)
+    12bf:	00 
+    12c0:	f3 0f 6f 44 24 08    	movdqu 0x8(%rsp),%xmm0
+    12c6:	48 8b 05 93 2d 00 00 	mov    0x2d93(%rip),%rax        # 4060 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    12cd:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    12d4:	0f 11 43 08          	movups %xmm0,0x8(%rbx)
+    12d8:	48 8b 7b 10          	mov    0x10(%rbx),%rdi
+    12dc:	48 39 c7             	cmp    %rax,%rdi
+    12df:	74 40                	je     1321 <test1()+0xd1>
+    12e1:	48 3b 3d 80 2d 00 00 	cmp    0x2d80(%rip),%rdi        # 4068 <outcome_v2_xxx::detail::errno_categories<void>::addresses+0x8>
+    12e8:	74 37                	je     1321 <test1()+0xd1>
+    12ea:	48 85 c0             	test   %rax,%rax
+    12ed:	0f 84 dd fd ff ff    	je     10d0 <test1() [clone .cold]>
+    12f3:	48 83 c4 60          	add    $0x60,%rsp
+    12f7:	48 89 d8             	mov    %rbx,%rax
+    12fa:	5b                   	pop    %rbx
+    12fb:	c3                   	ret
+    12fc:	0f 1f 40 00          	nopl   0x0(%rax)
+    1300:	f3 0f 6f 4c 24 28    	movdqu 0x28(%rsp),%xmm1
+    1306:	48 8b 05 53 2d 00 00 	mov    0x2d53(%rip),%rax        # 4060 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    130d:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    1314:	0f 11 4b 08          	movups %xmm1,0x8(%rbx)
+    1318:	48 8b 7b 10          	mov    0x10(%rbx),%rdi
+    131c:	48 39 c7             	cmp    %rax,%rdi
+    131f:	75 c0                	jne    12e1 <test1()+0x91>
+    1321:	c7 43 04 12 00 00 00 	movl   $0x12,0x4(%rbx)
+    1328:	48 83 c4 60          	add    $0x60,%rsp
+    132c:	48 89 d8             	mov    %rbx,%rax
+    132f:	5b                   	pop    %rbx
+    1330:	c3                   	ret
+    1331:	0f 1f 80 00 00 00 00 	nopl   0x0(%rax)
+    1338:	f3 0f 6f 54 24 48    	movdqu 0x48(%rsp),%xmm2
+    133e:	48 8b 05 1b 2d 00 00 	mov    0x2d1b(%rip),%rax        # 4060 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    1345:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    134c:	0f 11 53 08          	movups %xmm2,0x8(%rbx)
+    1350:	48 8b 7b 10          	mov    0x10(%rbx),%rdi
+    1354:	48 39 c7             	cmp    %rax,%rdi
+    1357:	75 88                	jne    12e1 <test1()+0x91>
+    1359:	eb c6                	jmp    1321 <test1()+0xd1>
+    135b:	0f 1f 44 00 00       	nopl   0x0(%rax,%rax,1)
@@ -0,0 +1,42 @@
+#include "../../include/outcome.hpp"
+
+#ifdef __GNUC__
+#define WEAK __attribute__((weak))
+#else
+#define WEAK
+#endif
+
+using namespace OUTCOME_V2_NAMESPACE;
+extern result<int> unknown1() WEAK;
+extern result<int> unknown2() WEAK;
+extern result<int> unknown3() WEAK;
+extern QUICKCPPLIB_NOINLINE result<int> test1()
+{
+  // Must generate the same code as min_result_try_chain.cpp
+  result<int> a = unknown1();
+  if(OUTCOME_UNLIKELY(!a.has_value()))
+  {
+    return result<int>(in_place_type<std::error_code>, std::move(a).assume_error());
+  }
+  result<int> b = unknown2();
+  if(OUTCOME_UNLIKELY(!b.has_value()))
+  {
+    return result<int>(in_place_type<std::error_code>, std::move(b).assume_error());
+  }
+  result<int> c = unknown3();
+  if(OUTCOME_UNLIKELY(!c.has_value()))
+  {
+    return result<int>(in_place_type<std::error_code>, std::move(c).assume_error());
+  }
+  return a.assume_value() + b.assume_value() + c.assume_value();
+}
+extern QUICKCPPLIB_NOINLINE void test2()
+{
+}
+
+int main(void)
+{
+  result<int> m(test1());
+  test2();
+  return 0;
+}
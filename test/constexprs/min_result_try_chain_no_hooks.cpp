@@ -0,0 +1,31 @@
+#include "../../include/outcome.hpp"
+
+#ifdef __GNUC__
+#define WEAK __attribute__((weak))
+#else
+#define WEAK
+#endif
+
+using namespace OUTCOME_V2_NAMESPACE;
+// The hook policy which does nothing must cost nothing
+template <class T> using hooked = result<T, std::error_code, policy::with_hooks<policy::default_policy<T, std::error_code, void>, policy::no_hooks>>;
+extern hooked<int> unknown1() WEAK;
+extern hooked<int> unknown2() WEAK;
+extern hooked<int> unknown3() WEAK;
+extern QUICKCPPLIB_NOINLINE hooked<int> test1()
+{
+  OUTCOME_TRY(a, unknown1());
+  OUTCOME_TRY(b, unknown2());
+  OUTCOME_TRY(c, unknown3());
+  return a + b + c;
+}
+extern QUICKCPPLIB_NOINLINE void test2()
+{
+}
+
+int main(void)
+{
+  hooked<int> m(test1());
+  test2();
+  return 0;
+}
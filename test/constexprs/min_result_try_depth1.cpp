@@ -0,0 +1,26 @@
+#include "../../include/outcome.hpp"
+
+#ifdef __GNUC__
+#define WEAK __attribute__((weak))
+#else
+#define WEAK
+#endif
+
+using namespace OUTCOME_V2_NAMESPACE;
+// A chain of 1 OUTCOME_TRY, whose ops should grow linearly with depth
+extern result<int> unknown1() WEAK;
+extern QUICKCPPLIB_NOINLINE result<int> test1()
+{
+  OUTCOME_TRY(v1, unknown1());
+  return v1;
+}
+extern QUICKCPPLIB_NOINLINE void test2()
+{
+}
+
+int main(void)
+{
+  result<int> m(test1());
+  test2();
+  return 0;
+}
@@ -0,0 +1,37 @@
+    1230:	53                   	push   %rbx
+    1231:	48 89 fb             	mov    %rdi,%rbx
+    1234:	48 83 ec 20          	sub    $0x20,%rsp
+    1238:	48 89 e7             	mov    %rsp,%rdi
+    123b:	e8 20 fe ff ff       	call   1060 <unknown1()@plt>
+    1240:	f6 44 24 04 01       	testb  $0x1,0x4(%rsp)
+    1245:	74 29                	je     1270 <test1()+0x40>
+    1247:	8b 04 24             	mov    (%rsp),%eax
+    124a:	48 c7 43 04 01 00 00 	movq   $0x1,0x4(%rbx)
+    1251:	00 
+    1252:	89 03                	mov    %eax,(%rbx)
+    1254:	e8 e7 fd ff ff       	call   1040 <std::_V2::system_category()@plt>
+    1259:	48 89 43 10          	mov    %rax,0x10(%rbx)
+    125d:	48 83 c4 20          	add    $0x20,%rsp
+    1261:	48 89 d8             	mov    %rbx,%rax
+    1264:	5b                   	pop    %rbx
+    1265:	c3                   	ret
+    1266:	66 2e 0f 1f 84 00 00 	cs nopw 0x0(%rax,%rax,1)
+    126d:	00 00 00 
+    1270:	f3 0f 6f 44 24 08    	movdqu 0x8(%rsp),%xmm0
+    1276:	48 8b 05 d3 2d 00 00 	mov    0x2dd3(%rip),%rax        # 4050 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    127d:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    1284:	0f 11 43 08          	movups %xmm0,0x8(%rbx)
+    1288:	48 8b 7b 10          	mov    0x10(%rbx),%rdi
+    128c:	48 39 c7             	cmp    %rax,%rdi
+    128f:	74 17                	je     12a8 <test1()+0x78>
+    1291:	48 3b 3d c0 2d 00 00 	cmp    0x2dc0(%rip),%rdi        # 4058 <outcome_v2_xxx::detail::errno_categories<void>::addresses+0x8>
+    1298:	74 0e                	je     12a8 <test1()+0x78>
+    129a:	48 85 c0             	test   %rax,%rax
+    129d:	75 be                	jne    125d <test1()+0x2d>
+    129f:	e9 0c fe ff ff       	jmp    10b0 <test1() [clone .cold]>
+    12a4:	0f 1f 40 00          	nopl   0x0(%rax)
+    12a8:	c7 43 04 12 00 00 00 	movl   $0x12,0x4(%rbx)
+    12af:	eb ac                	jmp    125d <test1()+0x2d>
+    12b1:	66 66 2e 0f 1f 84 00 	data16 cs nopw 0x0(%rax,%rax,1)
+    12b8:	00 00 00 00 
+    12bc:	0f 1f 40 00          	nopl   0x0(%rax)
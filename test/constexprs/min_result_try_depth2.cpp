@@ -0,0 +1,28 @@
+#include "../../include/outcome.hpp"
+
+#ifdef __GNUC__
+#define WEAK __attribute__((weak))
+#else
+#define WEAK
+#endif
+
+using namespace OUTCOME_V2_NAMESPACE;
+// A chain of 2 OUTCOME_TRY, whose ops should grow linearly with depth
+extern result<int> unknown1() WEAK;
+extern result<int> unknown2() WEAK;
+extern QUICKCPPLIB_NOINLINE result<int> test1()
+{
+  OUTCOME_TRY(v1, unknown1());
+  OUTCOME_TRY(v2, unknown2());
+  return v1 + v2;
+}
+extern QUICKCPPLIB_NOINLINE void test2()
+{
+}
+
+int main(void)
+{
+  result<int> m(test1());
+  test2();
+  return 0;
+}
@@ -0,0 +1,49 @@
+    1240:	53                   	push   %rbx
+    1241:	48 89 fb             	mov    %rdi,%rbx
+    1244:	48 83 ec 40          	sub    $0x40,%rsp
+    1248:	48 89 e7             	mov    %rsp,%rdi
+    124b:	e8 10 fe ff ff       	call   1060 <unknown1()@plt>
+    1250:	f6 44 24 04 01       	testb  $0x1,0x4(%rsp)
+    1255:	74 39                	je     1290 <test1()+0x50>
+    1257:	48 8d 7c 24 20       	lea    0x20(%rsp),%rdi
+    125c:	e8 0f fe ff ff       	call   1070 <unknown2()@plt>
+    1261:	f6 44 24 24 01       	testb  $0x1,0x24(%rsp)
+    1266:	74 68                	je     12d0 <test1()+0x90>
+    1268:	8b 44 24 20          	mov    0x20(%rsp),%eax
+    126c:	03 04 24             	add    (%rsp),%eax
+    126f:	48 c7 43 04 01 00 00 	movq   $0x1,0x4(%rbx)
+    1276:	00 
+    1277:	89 03                	mov    %eax,(%rbx)
+    1279:	e8 c2 fd ff ff       	call   1040 <std::_V2::system_category()@plt>
+    127e:	48 89 43 10          	mov    %rax,0x10(%rbx)
+    1282:	48 83 c4 40          	add    $0x40,%rsp
+    1286:	48 89 d8             	mov    %rbx,%rax
+    1289:	5b                   	pop    %rbx
+    128a:	c3                   	ret
+    128b:	0f 1f 44 00 00       	nopl   0x0(%rax,%rax,1)
+    1290:	f3 0f 6f 44 24 08    	movdqu 0x8(%rsp),%xmm0
+    1296:	48 8b 05 b3 2d 00 00 	mov    0x2db3(%rip),%rax        # 4050 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    129d:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    12a4:	0f 11 43 08          	movups %xmm0,0x8(%rbx)
+    12a8:	48 8b 7b 10          	mov    0x10(%rbx),%rdi
+    12ac:	48 39 c7             	cmp    %rax,%rdi
+    12af:	74 40                	je     12f1 <test1()+0xb1>
+    12b1:	48 3b 3d a0 2d 00 00 	cmp    0x2da0(%rip),%rdi        # 4058 <outcome_v2_xxx::detail::errno_categories<void>::addresses+0x8>
+    12b8:	74 37                	je     12f1 <test1()+0xb1>
+    12ba:	48 85 c0             	test   %rax,%rax
+    12bd:	0f 84 fd fd ff ff    	je     10c0 <test1() [clone .cold]>
+    12c3:	48 83 c4 40          	add    $0x40,%rsp
+    12c7:	48 89 d8             	mov    %rbx,%rax
+    12ca:	5b                   	pop    %rbx
+    12cb:	c3                   	ret
+    12cc:	0f 1f 40 00          	nopl   0x0(%rax)
+    12d0:	f3 0f 6f 4c 24 28    	movdqu 0x28(%rsp),%xmm1
+    12d6:	48 8b 05 73 2d 00 00 	mov    0x2d73(%rip),%rax        # 4050 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    12dd:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    12e4:	0f 11 4b 08          	movups %xmm1,0x8(%rbx)
+    12e8:	48 8b 7b 10          	mov    0x10(%rbx),%rdi
+    12ec:	48 39 c7             	cmp    %rax,%rdi
+    12ef:	75 c0                	jne    12b1 <test1()+0x71>
+    12f1:	c7 43 04 12 00 00 00 	movl   $0x12,0x4(%rbx)
+    12f8:	eb 88                	jmp    1282 <test1()+0x42>
+    12fa:	66 0f 1f 44 00 00    	nopw   0x0(%rax,%rax,1)
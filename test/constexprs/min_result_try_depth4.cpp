@@ -0,0 +1,32 @@
+#include "../../include/outcome.hpp"
+
+#ifdef __GNUC__
+#define WEAK __attribute__((weak))
+#else
+#define WEAK
+#endif
+
+using namespace OUTCOME_V2_NAMESPACE;
+// A chain of 4 OUTCOME_TRY, whose ops should grow linearly with depth
+extern result<int> unknown1() WEAK;
+extern result<int> unknown2() WEAK;
+extern result<int> unknown3() WEAK;
+extern result<int> unknown4() WEAK;
+extern QUICKCPPLIB_NOINLINE result<int> test1()
+{
+  OUTCOME_TRY(v1, unknown1());
+  OUTCOME_TRY(v2, unknown2());
+  OUTCOME_TRY(v3, unknown3());
+  OUTCOME_TRY(v4, unknown4());
+  return v1 + v2 + v3 + v4;
+}
+extern QUICKCPPLIB_NOINLINE void test2()
+{
+}
+
+int main(void)
+{
+  result<int> m(test1());
+  test2();
+  return 0;
+}
@@ -0,0 +1,80 @@
+    1260:	53                   	push   %rbx
+    1261:	48 89 fb             	mov    %rdi,%rbx
+    1264:	48 83 c4 80          	add    $0xffffffffffffff80,%rsp
+    1268:	48 89 e7             	mov    %rsp,%rdi
+    126b:	e8 10 fe ff ff       	call   1080 <unknown1()@plt>
+    1270:	f6 44 24 04 01       	testb  $0x1,0x4(%rsp)
+    1275:	74 71                	je     12e8 <test1()+0x88>
+    1277:	48 8d 7c 24 20       	lea    0x20(%rsp),%rdi
+    127c:	e8 0f fe ff ff       	call   1090 <unknown2()@plt>
+    1281:	f6 44 24 24 01       	testb  $0x1,0x24(%rsp)
+    1286:	0f 84 9c 00 00 00    	je     1328 <test1()+0xc8>
+    128c:	48 8d 7c 24 40       	lea    0x40(%rsp),%rdi
+    1291:	e8 ba fd ff ff       	call   1050 <unknown3()@plt>
+    1296:	f6 44 24 44 01       	testb  $0x1,0x44(%rsp)
+    129b:	0f 84 bf 00 00 00    	je     1360 <test1()+0x100>
+    12a1:	48 8d 7c 24 60       	lea    0x60(%rsp),%rdi
+    12a6:	e8 c5 fd ff ff       	call   1070 <unknown4()@plt>
+    12ab:	f6 44 24 64 01       	testb  $0x1,0x64(%rsp)
+    12b0:	0f 84 d2 00 00 00    	je     1388 <test1()+0x128>
+    12b6:	8b 44 24 20          	mov    0x20(%rsp),%eax
+    12ba:	03 04 24             	add    (%rsp),%eax
+    12bd:	48 c7 43 04 01 00 00 	movq   $0x1,0x4(%rbx)
+    12c4:	00 
+    12c5:	03 44 24 40          	add    0x40(%rsp),%eax
+    12c9:	03 44 24 60          	add    0x60(%rsp),%eax
+    12cd:	89 03                	mov    %eax,(%rbx)
+    12cf:	e8 6c fd ff ff       	call   1040 <std::_V2::system_category()@plt>
+    12d4:	48 89 43 10          	mov    %rax,0x10(%rbx)
+    12d8:	48 83 ec 80          	sub    $0xffffffffffffff80,%rsp
+    12dc:	48 89 d8             	mov    %rbx,%rax
+    12df:	5b                   	pop    %rbx
+    12e0:	c3                   	ret
+    12e1:	0f 1f 80 00 00 00 00 	nopl   0x0(%rax)
+    12e8:	f3 0f 6f 44 24 08    	movdqu 0x8(%rsp),%xmm0
+    12ee:	48 8b 05 6b 2d 00 00 	mov    0x2d6b(%rip),%rax        # 4060 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    12f5:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    12fc:	0f 11 43 08          	movups %xmm0,0x8(%rbx)
+    1300:	48 8b 7b 10          	mov    0x10(%rbx),%rdi
+    1304:	48 39 c7             	cmp    %rax,%rdi
+    1307:	74 40                	je     1349 <test1()+0xe9>
+    1309:	48 3b 3d 58 2d 00 00 	cmp    0x2d58(%rip),%rdi        # 4068 <outcome_v2_xxx::detail::errno_categories<void>::addresses+0x8>
+    1310:	74 37                	je     1349 <test1()+0xe9>
+    1312:	48 85 c0             	test   %rax,%rax
+    1315:	0f 84 c5 fd ff ff    	je     10e0 <test1() [clone .cold]>
+    131b:	48 83 ec 80          	sub    $0xffffffffffffff80,%rsp
+    131f:	48 89 d8             	mov    %rbx,%rax
+    1322:	5b                   	pop    %rbx
+    1323:	c3                   	ret
+    1324:	0f 1f 40 00          	nopl   0x0(%rax)
+    1328:	f3 0f 6f 4c 24 28    	movdqu 0x28(%rsp),%xmm1
+    132e:	48 8b 05 2b 2d 00 00 	mov    0x2d2b(%rip),%rax        # 4060 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    1335:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    133c:	0f 11 4b 08          	movups %xmm1,0x8(%rbx)
+    1340:	48 8b 7b 10          	mov    0x10(%rbx),%rdi
+    1344:	48 39 c7             	cmp    %rax,%rdi
+    1347:	75 c0                	jne    1309 <test1()+0xa9>
+    1349:	c7 43 04 12 00 00 00 	movl   $0x12,0x4(%rbx)
+    1350:	48 83 ec 80          	sub    $0xffffffffffffff80,%rsp
+    1354:	48 89 d8             	mov    %rbx,%rax
+    1357:	5b                   	pop    %rbx
+    1358:	c3                   	ret
+    1359:	0f 1f 80 00 00 00 00 	nopl   0x0(%rax)
+    1360:	f3 0f 6f 54 24 48    	movdqu 0x48(%rsp),%xmm2
+    1366:	48 8b 05 f3 2c 00 00 	mov    0x2cf3(%rip),%rax        # 4060 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    136d:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    1374:	0f 11 53 08          	movups %xmm2,0x8(%rbx)
+    1378:	48 8b 7b 10          	mov    0x10(%rbx),%rdi
+    137c:	48 39 c7             	cmp    %rax,%rdi
+    137f:	75 88                	jne    1309 <test1()+0xa9>
+    1381:	eb c6                	jmp    1349 <test1()+0xe9>
+    1383:	0f 1f 44 00 00       	nopl   0x0(%rax,%rax,1)
+    1388:	f3 0f 6f 5c 24 68    	movdqu 0x68(%rsp),%xmm3
+    138e:	48 8b 05 cb 2c 00 00 	mov    0x2ccb(%rip),%rax        # 4060 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    1395:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    139c:	0f 11 5b 08          	movups %xmm3,0x8(%rbx)
+    13a0:	48 8b 7b 10          	mov    0x10(%rbx),%rdi
+    13a4:	48 39 c7             	cmp    %rax,%rdi
+    13a7:	0f 85 5c ff ff ff    	jne    1309 <test1()+0xa9>
+    13ad:	eb 9a                	jmp    1349 <test1()+0xe9>
+    13af:	90                   	nop
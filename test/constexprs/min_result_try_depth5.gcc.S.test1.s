@@ -0,0 +1,98 @@
+    1270:	53                   	push   %rbx
+    1271:	48 89 fb             	mov    %rdi,%rbx
+    1274:	48 81 ec a0 00 00 00 	sub    $0xa0,%rsp
+    127b:	48 89 e7             	mov    %rsp,%rdi
+    127e:	e8 0d fe ff ff       	call   1090 <unknown1()@plt>
+    1283:	f6 44 24 04 01       	testb  $0x1,0x4(%rsp)
+    1288:	0f 84 92 00 00 00    	je     1320 <test1()+0xb0>
+    128e:	48 8d 7c 24 20       	lea    0x20(%rsp),%rdi
+    1293:	e8 08 fe ff ff       	call   10a0 <unknown2()@plt>
+    1298:	f6 44 24 24 01       	testb  $0x1,0x24(%rsp)
+    129d:	0f 84 bd 00 00 00    	je     1360 <test1()+0xf0>
+    12a3:	48 8d 7c 24 40       	lea    0x40(%rsp),%rdi
+    12a8:	e8 b3 fd ff ff       	call   1060 <unknown3()@plt>
+    12ad:	f6 44 24 44 01       	testb  $0x1,0x44(%rsp)
+    12b2:	0f 84 e0 00 00 00    	je     1398 <test1()+0x128>
+    12b8:	48 8d 7c 24 60       	lea    0x60(%rsp),%rdi
+    12bd:	e8 be fd ff ff       	call   1080 <unknown4()@plt>
+    12c2:	f6 44 24 64 01       	testb  $0x1,0x64(%rsp)
+    12c7:	0f 84 f3 00 00 00    	je     13c0 <test1()+0x150>
+    12cd:	48 8d bc 24 80 00 00 	lea    0x80(%rsp),%rdi
+    12d4:	00 
+    12d5:	e8 56 fd ff ff       	call   1030 <unknown5()@plt>
+    12da:	f6 84 24 84 00 00 00 	testb  $0x1,0x84(%rsp)
+    12e1:	01 
+    12e2:	0f 84 08 01 00 00    	je     13f0 <test1()+0x180>
+    12e8:	8b 44 24 20          	mov    0x20(%rsp),%eax
+    12ec:	03 04 24             	add    (%rsp),%eax
+    12ef:	48 c7 43 04 01 00 00 	movq   $0x1,0x4(%rbx)
+    12f6:	00 
+    12f7:	03 44 24 40          	add    0x40(%rsp),%eax
+    12fb:	03 44 24 60          	add    0x60(%rsp),%eax
+    12ff:	03 84 24 80 00 00 00 	add    0x80(%rsp),%eax
+    1306:	89 03                	mov    %eax,(%rbx)
+    1308:	e8 43 fd ff ff       	call   1050 <std::_V2::system_category()@plt>
+    130d:	48 89 43 10          	mov    %rax,0x10(%rbx)
+    1311:	48 81 c4 a0 00 00 00 	add    $0xa0,%rsp
+    1318:	48 89 d8             	mov    %rbx,%rax
+    131b:	5b                   	pop    %rbx
+    131c:	c3                   	ret
+    131d:	0f 1f 00             	nopl   (%rax)
+    1320:	f3 0f 6f 44 24 08    	movdqu 0x8(%rsp),%xmm0
+    1326:	48 8b 05 43 2d 00 00 	mov    0x2d43(%rip),%rax        # 4070 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    132d:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    1334:	0f 11 43 08          	movups %xmm0,0x8(%rbx)
+    1338:	48 8b 7b 10          	mov    0x10(%rbx),%rdi
+    133c:	48 39 c7             	cmp    %rax,%rdi
+    133f:	74 40                	je     1381 <test1()+0x111>
+    1341:	48 3b 3d 30 2d 00 00 	cmp    0x2d30(%rip),%rdi        # 4078 <outcome_v2_xxx::detail::errno_categories<void>::addresses+0x8>
+    1348:	74 37                	je     1381 <test1()+0x111>
+    134a:	48 85 c0             	test   %rax,%rax
+    134d:	0f 84 9d fd ff ff    	je     10f0 <test1() [clone .cold]>
+    1353:	48 81 c4 a0 00 00 00 	add    $0xa0,%rsp
+    135a:	48 89 d8             	mov    %rbx,%rax
+    135d:	5b                   	pop    %rbx
+    135e:	c3                   	ret
+    135f:	90                   	nop
+    1360:	f3 0f 6f 4c 24 28    	movdqu 0x28(%rsp),%xmm1
+    1366:	48 8b 05 03 2d 00 00 	mov    0x2d03(%rip),%rax        # 4070 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    136d:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    1374:	0f 11 4b 08          	movups %xmm1,0x8(%rbx)
+    1378:	48 8b 7b 10          	mov    0x10(%rbx),%rdi
+    137c:	48 39 c7             	cmp    %rax,%rdi
+    137f:	75 c0                	jne    1341 <test1()+0xd1>
+    1381:	c7 43 04 12 00 00 00 	movl   $0x12,0x4(%rbx)
+    1388:	48 81 c4 a0 00 00 00 	add    $0xa0,%rsp
+    138f:	48 89 d8             	mov    %rbx,%rax
+    1392:	5b                   	pop    %rbx
+    1393:	c3                   	ret
+    1394:	0f 1f 40 00          	nopl   0x0(%rax)
+    1398:	f3 0f 6f 54 24 48    	movdqu 0x48(%rsp),%xmm2
+    139e:	48 8b 05 cb 2c 00 00 	mov    0x2ccb(%rip),%rax        # 4070 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    13a5:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    13ac:	0f 11 53 08          	movups %xmm2,0x8(%rbx)
+    13b0:	48 8b 7b 10          	mov    0x10(%rbx),%rdi
+    13b4:	48 39 c7             	cmp    %rax,%rdi
+    13b7:	75 88                	jne    1341 <test1()+0xd1>
+    13b9:	eb c6                	jmp    1381 <test1()+0x111>
+    13bb:	0f 1f 44 00 00       	nopl   0x0(%rax,%rax,1)
+    13c0:	f3 0f 6f 5c 24 68    	movdqu 0x68(%rsp),%xmm3
+    13c6:	48 8b 05 a3 2c 00 00 	mov    0x2ca3(%rip),%rax        # 4070 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    13cd:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    13d4:	0f 11 5b 08          	movups %xmm3,0x8(%rbx)
+    13d8:	48 8b 7b 10          	mov    0x10(%rbx),%rdi
+    13dc:	48 39 c7             	cmp    %rax,%rdi
+    13df:	0f 85 5c ff ff ff    	jne    1341 <test1()+0xd1>
+    13e5:	eb 9a                	jmp    1381 <test1()+0x111>
+    13e7:	66 0f 1f 84 00 00 00 	nopw   0x0(%rax,%rax,1)
+    13ee:	00 00 
+    13f0:	f3 0f 6f a4 24 88 00 	movdqu 0x88(%rsp),%xmm4
+    13f7:	00 00 
+    13f9:	48 8b 05 70 2c 00 00 	mov    0x2c70(%rip),%rax        # 4070 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    1400:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    1407:	0f 11 63 08          	movups %xmm4,0x8(%rbx)
+    140b:	48 8b 7b 10          	mov    0x10(%rbx),%rdi
+    140f:	48 39 c7             	cmp    %rax,%rdi
+    1412:	0f 85 29 ff ff ff    	jne    1341 <test1()+0xd1>
+    1418:	e9 64 ff ff ff       	jmp    1381 <test1()+0x111>
+    141d:	0f 1f 00             	nopl   (%rax)
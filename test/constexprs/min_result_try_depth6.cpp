@@ -0,0 +1,36 @@
+#include "../../include/outcome.hpp"
+
+#ifdef __GNUC__
+#define WEAK __attribute__((weak))
+#else
+#define WEAK
+#endif
+
+using namespace OUTCOME_V2_NAMESPACE;
+// A chain of 6 OUTCOME_TRY, whose ops should grow linearly with depth
+extern result<int> unknown1() WEAK;
+extern result<int> unknown2() WEAK;
+extern result<int> unknown3() WEAK;
+extern result<int> unknown4() WEAK;
+extern result<int> unknown5() WEAK;
+extern result<int> unknown6() WEAK;
+extern QUICKCPPLIB_NOINLINE result<int> test1()
+{
+  OUTCOME_TRY(v1, unknown1());
+  OUTCOME_TRY(v2, unknown2());
+  OUTCOME_TRY(v3, unknown3());
+  OUTCOME_TRY(v4, unknown4());
+  OUTCOME_TRY(v5, unknown5());
+  OUTCOME_TRY(v6, unknown6());
+  return v1 + v2 + v3 + v4 + v5 + v6;
+}
+extern QUICKCPPLIB_NOINLINE void test2()
+{
+}
+
+int main(void)
+{
+  result<int> m(test1());
+  test2();
+  return 0;
+}
@@ -0,0 +1,115 @@
+    1280:	53                   	push   %rbx
+    1281:	48 89 fb             	mov    %rdi,%rbx
+    1284:	48 81 ec c0 00 00 00 	sub    $0xc0,%rsp
+    128b:	48 89 e7             	mov    %rsp,%rdi
+    128e:	e8 0d fe ff ff       	call   10a0 <unknown1()@plt>
+    1293:	f6 44 24 04 01       	testb  $0x1,0x4(%rsp)
+    1298:	0f 84 b2 00 00 00    	je     1350 <test1()+0xd0>
+    129e:	48 8d 7c 24 20       	lea    0x20(%rsp),%rdi
+    12a3:	e8 08 fe ff ff       	call   10b0 <unknown2()@plt>
+    12a8:	f6 44 24 24 01       	testb  $0x1,0x24(%rsp)
+    12ad:	0f 84 dd 00 00 00    	je     1390 <test1()+0x110>
+    12b3:	48 8d 7c 24 40       	lea    0x40(%rsp),%rdi
+    12b8:	e8 b3 fd ff ff       	call   1070 <unknown3()@plt>
+    12bd:	f6 44 24 44 01       	testb  $0x1,0x44(%rsp)
+    12c2:	0f 84 00 01 00 00    	je     13c8 <test1()+0x148>
+    12c8:	48 8d 7c 24 60       	lea    0x60(%rsp),%rdi
+    12cd:	e8 be fd ff ff       	call   1090 <unknown4()@plt>
+    12d2:	f6 44 24 64 01       	testb  $0x1,0x64(%rsp)
+    12d7:	0f 84 13 01 00 00    	je     13f0 <test1()+0x170>
+    12dd:	48 8d bc 24 80 00 00 	lea    0x80(%rsp),%rdi
+    12e4:	00 
+    12e5:	e8 56 fd ff ff       	call   1040 <unknown5()@plt>
+    12ea:	f6 84 24 84 00 00 00 	testb  $0x1,0x84(%rsp)
+    12f1:	01 
+    12f2:	0f 84 28 01 00 00    	je     1420 <test1()+0x1a0>
+    12f8:	48 8d bc 24 a0 00 00 	lea    0xa0(%rsp),%rdi
+    12ff:	00 
+    1300:	e8 2b fd ff ff       	call   1030 <unknown6()@plt>
+    1305:	f6 84 24 a4 00 00 00 	testb  $0x1,0xa4(%rsp)
+    130c:	01 
+    130d:	0f 84 3d 01 00 00    	je     1450 <test1()+0x1d0>
+    1313:	8b 44 24 20          	mov    0x20(%rsp),%eax
+    1317:	03 04 24             	add    (%rsp),%eax
+    131a:	48 c7 43 04 01 00 00 	movq   $0x1,0x4(%rbx)
+    1321:	00 
+    1322:	03 44 24 40          	add    0x40(%rsp),%eax
+    1326:	03 44 24 60          	add    0x60(%rsp),%eax
+    132a:	03 84 24 80 00 00 00 	add    0x80(%rsp),%eax
+    1331:	03 84 24 a0 00 00 00 	add    0xa0(%rsp),%eax
+    1338:	89 03                	mov    %eax,(%rbx)
+    133a:	e8 21 fd ff ff       	call   1060 <std::_V2::system_category()@plt>
+    133f:	48 89 43 10          	mov    %rax,0x10(%rbx)
+    1343:	48 81 c4 c0 00 00 00 	add    $0xc0,%rsp
+    134a:	48 89 d8             	mov    %rbx,%rax
+    134d:	5b                   	pop    %rbx
+    134e:	c3                   	ret
+    134f:	90                   	nop
+    1350:	f3 0f 6f 44 24 08    	movdqu 0x8(%rsp),%xmm0
+    1356:	48 8b 05 13 2d 00 00 	mov    0x2d13(%rip),%rax        # 4070 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    135d:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    1364:	0f 11 43 08          	movups %xmm0,0x8(%rbx)
+    1368:	48 8b 7b 10          	mov    0x10(%rbx),%rdi
+    136c:	48 39 c7             	cmp    %rax,%rdi
+    136f:	74 40                	je     13b1 <test1()+0x131>
+    1371:	48 3b 3d 00 2d 00 00 	cmp    0x2d00(%rip),%rdi        # 4078 <outcome_v2_xxx::detail::errno_categories<void>::addresses+0x8>
+    1378:	74 37                	je     13b1 <test1()+0x131>
+    137a:	48 85 c0             	test   %rax,%rax
+    137d:	0f 84 7d fd ff ff    	je     1100 <test1() [clone .cold]>
+    1383:	48 81 c4 c0 00 00 00 	add    $0xc0,%rsp
+    138a:	48 89 d8             	mov    %rbx,%rax
+    138d:	5b                   	pop    %rbx
+    138e:	c3                   	ret
+    138f:	90                   	nop
+    1390:	f3 0f 6f 4c 24 28    	movdqu 0x28(%rsp),%xmm1
+    1396:	48 8b 05 d3 2c 00 00 	mov    0x2cd3(%rip),%rax        # 4070 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    139d:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    13a4:	0f 11 4b 08          	movups %xmm1,0x8(%rbx)
+    13a8:	48 8b 7b 10          	mov    0x10(%rbx),%rdi
+    13ac:	48 39 c7             	cmp    %rax,%rdi
+    13af:	75 c0                	jne    1371 <test1()+0xf1>
+    13b1:	c7 43 04 12 00 00 00 	movl   $0x12,0x4(%rbx)
+    13b8:	48 81 c4 c0 00 00 00 	add    $0xc0,%rsp
+    13bf:	48 89 d8             	mov    %rbx,%rax
+    13c2:	5b                   	pop    %rbx
+    13c3:	c3                   	ret
+    13c4:	0f 1f 40 00          	nopl   0x0(%rax)
+    13c8:	f3 0f 6f 54 24 48    	movdqu 0x48(%rsp),%xmm2
+    13ce:	48 8b 05 9b 2c 00 00 	mov    0x2c9b(%rip),%rax        # 4070 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    13d5:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    13dc:	0f 11 53 08          	movups %xmm2,0x8(%rbx)
+    13e0:	48 8b 7b 10          	mov    0x10(%rbx),%rdi
+    13e4:	48 39 c7             	cmp    %rax,%rdi
+    13e7:	75 88                	jne    1371 <test1()+0xf1>
+    13e9:	eb c6                	jmp    13b1 <test1()+0x131>
+    13eb:	0f 1f 44 00 00       	nopl   0x0(%rax,%rax,1)
+    13f0:	f3 0f 6f 5c 24 68    	movdqu 0x68(%rsp),%xmm3
+    13f6:	48 8b 05 73 2c 00 00 	mov    0x2c73(%rip),%rax        # 4070 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    13fd:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    1404:	0f 11 5b 08          	movups %xmm3,0x8(%rbx)
+    1408:	48 8b 7b 10          	mov    0x10(%rbx),%rdi
+    140c:	48 39 c7             	cmp    %rax,%rdi
+    140f:	0f 85 5c ff ff ff    	jne    1371 <test1()+0xf1>
+    1415:	eb 9a                	jmp    13b1 <test1()+0x131>
+    1417:	66 0f 1f 84 00 00 00 	nopw   0x0(%rax,%rax,1)
+    141e:	00 00 
+    1420:	f3 0f 6f a4 24 88 00 	movdqu 0x88(%rsp),%xmm4
+    1427:	00 00 
+    1429:	48 8b 05 40 2c 00 00 	mov    0x2c40(%rip),%rax        # 4070 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    1430:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    1437:	0f 11 63 08          	movups %xmm4,0x8(%rbx)
+    143b:	48 8b 7b 10          	mov    0x10(%rbx),%rdi
+    143f:	48 39 c7             	cmp    %rax,%rdi
+    1442:	0f 85 29 ff ff ff    	jne    1371 <test1()+0xf1>
+    1448:	e9 64 ff ff ff       	jmp    13b1 <test1()+0x131>
+    144d:	0f 1f 00             	nopl   (%rax)
+    1450:	f3 0f 6f ac 24 a8 00 	movdqu 0xa8(%rsp),%xmm5
+    1457:	00 00 
+    1459:	48 8b 05 10 2c 00 00 	mov    0x2c10(%rip),%rax        # 4070 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    1460:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    1467:	0f 11 6b 08          	movups %xmm5,0x8(%rbx)
+    146b:	48 8b 7b 10          	mov    0x10(%rbx),%rdi
+    146f:	48 39 c7             	cmp    %rax,%rdi
+    1472:	0f 85 f9 fe ff ff    	jne    1371 <test1()+0xf1>
+    1478:	e9 34 ff ff ff       	jmp    13b1 <test1()+0x131>
+    147d:	0f 1f 00             	nopl   (%rax)
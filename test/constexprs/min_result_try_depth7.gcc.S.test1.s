@@ -0,0 +1,134 @@
+    1290:	53                   	push   %rbx
+    1291:	48 89 fb             	mov    %rdi,%rbx
+    1294:	48 81 ec e0 00 00 00 	sub    $0xe0,%rsp
+    129b:	48 89 e7             	mov    %rsp,%rdi
+    129e:	e8 0d fe ff ff       	call   10b0 <unknown1()@plt>
+    12a3:	f6 44 24 04 01       	testb  $0x1,0x4(%rsp)
+    12a8:	0f 84 22 01 00 00    	je     13d0 <test1()+0x140>
+    12ae:	48 8d 7c 24 20       	lea    0x20(%rsp),%rdi
+    12b3:	e8 08 fe ff ff       	call   10c0 <unknown2()@plt>
+    12b8:	f6 44 24 24 01       	testb  $0x1,0x24(%rsp)
+    12bd:	0f 84 45 01 00 00    	je     1408 <test1()+0x178>
+    12c3:	48 8d 7c 24 40       	lea    0x40(%rsp),%rdi
+    12c8:	e8 a3 fd ff ff       	call   1070 <unknown3()@plt>
+    12cd:	f6 44 24 44 01       	testb  $0x1,0x44(%rsp)
+    12d2:	0f 84 58 01 00 00    	je     1430 <test1()+0x1a0>
+    12d8:	48 8d 7c 24 60       	lea    0x60(%rsp),%rdi
+    12dd:	e8 be fd ff ff       	call   10a0 <unknown4()@plt>
+    12e2:	f6 44 24 64 01       	testb  $0x1,0x64(%rsp)
+    12e7:	0f 84 73 01 00 00    	je     1460 <test1()+0x1d0>
+    12ed:	48 8d bc 24 80 00 00 	lea    0x80(%rsp),%rdi
+    12f4:	00 
+    12f5:	e8 46 fd ff ff       	call   1040 <unknown5()@plt>
+    12fa:	f6 84 24 84 00 00 00 	testb  $0x1,0x84(%rsp)
+    1301:	01 
+    1302:	0f 84 88 01 00 00    	je     1490 <test1()+0x200>
+    1308:	48 8d bc 24 a0 00 00 	lea    0xa0(%rsp),%rdi
+    130f:	00 
+    1310:	e8 1b fd ff ff       	call   1030 <unknown6()@plt>
+    1315:	f6 84 24 a4 00 00 00 	testb  $0x1,0xa4(%rsp)
+    131c:	01 
+    131d:	0f 84 9d 01 00 00    	je     14c0 <test1()+0x230>
+    1323:	48 8d bc 24 c0 00 00 	lea    0xc0(%rsp),%rdi
+    132a:	00 
+    132b:	e8 60 fd ff ff       	call   1090 <unknown7()@plt>
+    1330:	f6 84 24 c4 00 00 00 	testb  $0x1,0xc4(%rsp)
+    1337:	01 
+    1338:	74 46                	je     1380 <test1()+0xf0>
+    133a:	8b 44 24 20          	mov    0x20(%rsp),%eax
+    133e:	03 04 24             	add    (%rsp),%eax
+    1341:	48 c7 43 04 01 00 00 	movq   $0x1,0x4(%rbx)
+    1348:	00 
+    1349:	03 44 24 40          	add    0x40(%rsp),%eax
+    134d:	03 44 24 60          	add    0x60(%rsp),%eax
+    1351:	03 84 24 80 00 00 00 	add    0x80(%rsp),%eax
+    1358:	03 84 24 a0 00 00 00 	add    0xa0(%rsp),%eax
+    135f:	03 84 24 c0 00 00 00 	add    0xc0(%rsp),%eax
+    1366:	89 03                	mov    %eax,(%rbx)
+    1368:	e8 f3 fc ff ff       	call   1060 <std::_V2::system_category()@plt>
+    136d:	48 89 43 10          	mov    %rax,0x10(%rbx)
+    1371:	48 81 c4 e0 00 00 00 	add    $0xe0,%rsp
+    1378:	48 89 d8             	mov    %rbx,%rax
+    137b:	5b                   	pop    %rbx
+    137c:	c3                   	ret
+    137d:	0f 1f 00             	nopl   (%rax)
+    1380:	f3 0f 6f b4 24 c8 00 	movdqu 0xc8(%rsp),%xmm6
+    1387:	00 00 
+    1389:	48 8b 05 f0 2c 00 00 	mov    0x2cf0(%rip),%rax        # 4080 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    1390:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    1397:	0f 11 73 08          	movups %xmm6,0x8(%rbx)
+    139b:	48 8b 7b 10          	mov    0x10(%rbx),%rdi
+    139f:	48 39 c7             	cmp    %rax,%rdi
+    13a2:	74 4d                	je     13f1 <test1()+0x161>
+    13a4:	0f 1f 40 00          	nopl   0x0(%rax)
+    13a8:	48 3b 3d d9 2c 00 00 	cmp    0x2cd9(%rip),%rdi        # 4088 <outcome_v2_xxx::detail::errno_categories<void>::addresses+0x8>
+    13af:	74 40                	je     13f1 <test1()+0x161>
+    13b1:	48 85 c0             	test   %rax,%rax
+    13b4:	0f 84 56 fd ff ff    	je     1110 <test1() [clone .cold]>
+    13ba:	48 81 c4 e0 00 00 00 	add    $0xe0,%rsp
+    13c1:	48 89 d8             	mov    %rbx,%rax
+    13c4:	5b                   	pop    %rbx
+    13c5:	c3                   	ret
+    13c6:	66 2e 0f 1f 84 00 00 	cs nopw 0x0(%rax,%rax,1)
+    13cd:	00 00 00 
+    13d0:	f3 0f 6f 44 24 08    	movdqu 0x8(%rsp),%xmm0
+    13d6:	48 8b 05 a3 2c 00 00 	mov    0x2ca3(%rip),%rax        # 4080 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    13dd:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    13e4:	0f 11 43 08          	movups %xmm0,0x8(%rbx)
+    13e8:	48 8b 7b 10          	mov    0x10(%rbx),%rdi
+    13ec:	48 39 c7             	cmp    %rax,%rdi
+    13ef:	75 b7                	jne    13a8 <test1()+0x118>
+    13f1:	c7 43 04 12 00 00 00 	movl   $0x12,0x4(%rbx)
+    13f8:	48 81 c4 e0 00 00 00 	add    $0xe0,%rsp
+    13ff:	48 89 d8             	mov    %rbx,%rax
+    1402:	5b                   	pop    %rbx
+    1403:	c3                   	ret
+    1404:	0f 1f 40 00          	nopl   0x0(%rax)
+    1408:	f3 0f 6f 4c 24 28    	movdqu 0x28(%rsp),%xmm1
+    140e:	48 8b 05 6b 2c 00 00 	mov    0x2c6b(%rip),%rax        # 4080 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    1415:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    141c:	0f 11 4b 08          	movups %xmm1,0x8(%rbx)
+    1420:	48 8b 7b 10          	mov    0x10(%rbx),%rdi
+    1424:	48 39 c7             	cmp    %rax,%rdi
+    1427:	0f 85 7b ff ff ff    	jne    13a8 <test1()+0x118>
+    142d:	eb c2                	jmp    13f1 <test1()+0x161>
+    142f:	90                   	nop
+    1430:	f3 0f 6f 54 24 48    	movdqu 0x48(%rsp),%xmm2
+    1436:	48 8b 05 43 2c 00 00 	mov    0x2c43(%rip),%rax        # 4080 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    143d:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    1444:	0f 11 53 08          	movups %xmm2,0x8(%rbx)
+    1448:	48 8b 7b 10          	mov    0x10(%rbx),%rdi
+    144c:	48 39 c7             	cmp    %rax,%rdi
+    144f:	0f 85 53 ff ff ff    	jne    13a8 <test1()+0x118>
+    1455:	eb 9a                	jmp    13f1 <test1()+0x161>
+    1457:	66 0f 1f 84 00 00 00 	nopw   0x0(%rax,%rax,1)
+    145e:	00 00 
+    1460:	f3 0f 6f 5c 24 68    	movdqu 0x68(%rsp),%xmm3
+    1466:	48 8b 05 13 2c 00 00 	mov    0x2c13(%rip),%rax        # 4080 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    146d:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    1474:	0f 11 5b 08          	movups %xmm3,0x8(%rbx)
+    1478:	48 8b 7b 10          	mov    0x10(%rbx),%rdi
+    147c:	48 39 c7             	cmp    %rax,%rdi
+    147f:	0f 85 23 ff ff ff    	jne    13a8 <test1()+0x118>
+    1485:	e9 67 ff ff ff       	jmp    13f1 <test1()+0x161>
+    148a:	66 0f 1f 44 00 00    	nopw   0x0(%rax,%rax,1)
+    1490:	f3 0f 6f a4 24 88 00 	movdqu 0x88(%rsp),%xmm4
+    1497:	00 00 
+    1499:	48 8b 05 e0 2b 00 00 	mov    0x2be0(%rip),%rax        # 4080 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    14a0:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    14a7:	0f 11 63 08          	movups %xmm4,0x8(%rbx)
+    14ab:	48 8b 7b 10          	mov    0x10(%rbx),%rdi
+    14af:	48 39 c7             	cmp    %rax,%rdi
+    14b2:	0f 85 f0 fe ff ff    	jne    13a8 <test1()+0x118>
+    14b8:	e9 34 ff ff ff       	jmp    13f1 <test1()+0x161>
+    14bd:	0f 1f 00             	nopl   (%rax)
+    14c0:	f3 0f 6f ac 24 a8 00 	movdqu 0xa8(%rsp),%xmm5
+    14c7:	00 00 
+    14c9:	48 8b 05 b0 2b 00 00 	mov    0x2bb0(%rip),%rax        # 4080 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    14d0:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    14d7:	0f 11 6b 08          	movups %xmm5,0x8(%rbx)
+    14db:	48 8b 7b 10          	mov    0x10(%rbx),%rdi
+    14df:	48 39 c7             	cmp    %rax,%rdi
+    14e2:	0f 85 c0 fe ff ff    	jne    13a8 <test1()+0x118>
+    14e8:	e9 04 ff ff ff       	jmp    13f1 <test1()+0x161>
+    14ed:	0f 1f 00             	nopl   (%rax)
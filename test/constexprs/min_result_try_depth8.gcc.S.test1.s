@@ -0,0 +1,151 @@
+    12a0:	53                   	push   %rbx
+    12a1:	48 89 fb             	mov    %rdi,%rbx
+    12a4:	48 81 ec 00 01 00 00 	sub    $0x100,%rsp
+    12ab:	48 89 e7             	mov    %rsp,%rdi
+    12ae:	e8 0d fe ff ff       	call   10c0 <unknown1()@plt>
+    12b3:	f6 44 24 04 01       	testb  $0x1,0x4(%rsp)
+    12b8:	0f 84 42 01 00 00    	je     1400 <test1()+0x160>
+    12be:	48 8d 7c 24 20       	lea    0x20(%rsp),%rdi
+    12c3:	e8 08 fe ff ff       	call   10d0 <unknown2()@plt>
+    12c8:	f6 44 24 24 01       	testb  $0x1,0x24(%rsp)
+    12cd:	0f 84 65 01 00 00    	je     1438 <test1()+0x198>
+    12d3:	48 8d 7c 24 40       	lea    0x40(%rsp),%rdi
+    12d8:	e8 93 fd ff ff       	call   1070 <unknown3()@plt>
+    12dd:	f6 44 24 44 01       	testb  $0x1,0x44(%rsp)
+    12e2:	0f 84 78 01 00 00    	je     1460 <test1()+0x1c0>
+    12e8:	48 8d 7c 24 60       	lea    0x60(%rsp),%rdi
+    12ed:	e8 be fd ff ff       	call   10b0 <unknown4()@plt>
+    12f2:	f6 44 24 64 01       	testb  $0x1,0x64(%rsp)
+    12f7:	0f 84 93 01 00 00    	je     1490 <test1()+0x1f0>
+    12fd:	48 8d bc 24 80 00 00 	lea    0x80(%rsp),%rdi
+    1304:	00 
+    1305:	e8 36 fd ff ff       	call   1040 <unknown5()@plt>
+    130a:	f6 84 24 84 00 00 00 	testb  $0x1,0x84(%rsp)
+    1311:	01 
+    1312:	0f 84 a8 01 00 00    	je     14c0 <test1()+0x220>
+    1318:	48 8d bc 24 a0 00 00 	lea    0xa0(%rsp),%rdi
+    131f:	00 
+    1320:	e8 0b fd ff ff       	call   1030 <unknown6()@plt>
+    1325:	f6 84 24 a4 00 00 00 	testb  $0x1,0xa4(%rsp)
+    132c:	01 
+    132d:	0f 84 bd 01 00 00    	je     14f0 <test1()+0x250>
+    1333:	48 8d bc 24 c0 00 00 	lea    0xc0(%rsp),%rdi
+    133a:	00 
+    133b:	e8 60 fd ff ff       	call   10a0 <unknown7()@plt>
+    1340:	f6 84 24 c4 00 00 00 	testb  $0x1,0xc4(%rsp)
+    1347:	01 
+    1348:	74 66                	je     13b0 <test1()+0x110>
+    134a:	48 8d bc 24 e0 00 00 	lea    0xe0(%rsp),%rdi
+    1351:	00 
+    1352:	e8 29 fd ff ff       	call   1080 <unknown8()@plt>
+    1357:	f6 84 24 e4 00 00 00 	testb  $0x1,0xe4(%rsp)
+    135e:	01 
+    135f:	0f 84 bb 01 00 00    	je     1520 <test1()+0x280>
+    1365:	8b 44 24 20          	mov    0x20(%rsp),%eax
+    1369:	03 04 24             	add    (%rsp),%eax
+    136c:	48 c7 43 04 01 00 00 	movq   $0x1,0x4(%rbx)
+    1373:	00 
+    1374:	03 44 24 40          	add    0x40(%rsp),%eax
+    1378:	03 44 24 60          	add    0x60(%rsp),%eax
+    137c:	03 84 24 80 00 00 00 	add    0x80(%rsp),%eax
+    1383:	03 84 24 a0 00 00 00 	add    0xa0(%rsp),%eax
+    138a:	03 84 24 c0 00 00 00 	add    0xc0(%rsp),%eax
+    1391:	03 84 24 e0 00 00 00 	add    0xe0(%rsp),%eax
+    1398:	89 03                	mov    %eax,(%rbx)
+    139a:	e8 c1 fc ff ff       	call   1060 <std::_V2::system_category()@plt>
+    139f:	48 89 43 10          	mov    %rax,0x10(%rbx)
+    13a3:	48 81 c4 00 01 00 00 	add    $0x100,%rsp
+    13aa:	48 89 d8             	mov    %rbx,%rax
+    13ad:	5b                   	pop    %rbx
+    13ae:	c3                   	ret
+    13af:	90                   	nop
+    13b0:	f3 0f 6f b4 24 c8 00 	movdqu 0xc8(%rsp),%xmm6
+    13b7:	00 00 
+    13b9:	48 8b 05 c0 2c 00 00 	mov    0x2cc0(%rip),%rax        # 4080 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    13c0:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    13c7:	0f 11 73 08          	movups %xmm6,0x8(%rbx)
+    13cb:	48 8b 7b 10          	mov    0x10(%rbx),%rdi
+    13cf:	48 39 c7             	cmp    %rax,%rdi
+    13d2:	74 4d                	je     1421 <test1()+0x181>
+    13d4:	0f 1f 40 00          	nopl   0x0(%rax)
+    13d8:	48 3b 3d a9 2c 00 00 	cmp    0x2ca9(%rip),%rdi        # 4088 <outcome_v2_xxx::detail::errno_categories<void>::addresses+0x8>
+    13df:	74 40                	je     1421 <test1()+0x181>
+    13e1:	48 85 c0             	test   %rax,%rax
+    13e4:	0f 84 36 fd ff ff    	je     1120 <test1() [clone .cold]>
+    13ea:	48 81 c4 00 01 00 00 	add    $0x100,%rsp
+    13f1:	48 89 d8             	mov    %rbx,%rax
+    13f4:	5b                   	pop    %rbx
+    13f5:	c3                   	ret
+    13f6:	66 2e 0f 1f 84 00 00 	cs nopw 0x0(%rax,%rax,1)
+    13fd:	00 00 00 
+    1400:	f3 0f 6f 44 24 08    	movdqu 0x8(%rsp),%xmm0
+    1406:	48 8b 05 73 2c 00 00 	mov    0x2c73(%rip),%rax        # 4080 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    140d:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    1414:	0f 11 43 08          	movups %xmm0,0x8(%rbx)
+    1418:	48 8b 7b 10          	mov    0x10(%rbx),%rdi
+    141c:	48 39 c7             	cmp    %rax,%rdi
+    141f:	75 b7                	jne    13d8 <test1()+0x138>
+    1421:	c7 43 04 12 00 00 00 	movl   $0x12,0x4(%rbx)
+    1428:	48 81 c4 00 01 00 00 	add    $0x100,%rsp
+    142f:	48 89 d8             	mov    %rbx,%rax
+    1432:	5b                   	pop    %rbx
+    1433:	c3                   	ret
+    1434:	0f 1f 40 00          	nopl   0x0(%rax)
+    1438:	f3 0f 6f 4c 24 28    	movdqu 0x28(%rsp),%xmm1
+    143e:	48 8b 05 3b 2c 00 00 	mov    0x2c3b(%rip),%rax        # 4080 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    1445:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    144c:	0f 11 4b 08          	movups %xmm1,0x8(%rbx)
+    1450:	48 8b 7b 10          	mov    0x10(%rbx),%rdi
+    1454:	48 39 c7             	cmp    %rax,%rdi
+    1457:	0f 85 7b ff ff ff    	jne    13d8 <test1()+0x138>
+    145d:	eb c2                	jmp    1421 <test1()+0x181>
+    145f:	90                   	nop
+    1460:	f3 0f 6f 54 24 48    	movdqu 0x48(%rsp),%xmm2
+    1466:	48 8b 05 13 2c 00 00 	mov    0x2c13(%rip),%rax        # 4080 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    146d:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    1474:	0f 11 53 08          	movups %xmm2,0x8(%rbx)
+    1478:	48 8b 7b 10          	mov    0x10(%rbx),%rdi
+    147c:	48 39 c7             	cmp    %rax,%rdi
+    147f:	0f 85 53 ff ff ff    	jne    13d8 <test1()+0x138>
+    1485:	eb 9a                	jmp    1421 <test1()+0x181>
+    1487:	66 0f 1f 84 00 00 00 	nopw   0x0(%rax,%rax,1)
+    148e:	00 00 
+    1490:	f3 0f 6f 5c 24 68    	movdqu 0x68(%rsp),%xmm3
+    1496:	48 8b 05 e3 2b 00 00 	mov    0x2be3(%rip),%rax        # 4080 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    149d:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    14a4:	0f 11 5b 08          	movups %xmm3,0x8(%rbx)
+    14a8:	48 8b 7b 10          	mov    0x10(%rbx),%rdi
+    14ac:	48 39 c7             	cmp    %rax,%rdi
+    14af:	0f 85 23 ff ff ff    	jne    13d8 <test1()+0x138>
+    14b5:	e9 67 ff ff ff       	jmp    1421 <test1()+0x181>
+    14ba:	66 0f 1f 44 00 00    	nopw   0x0(%rax,%rax,1)
+    14c0:	f3 0f 6f a4 24 88 00 	movdqu 0x88(%rsp),%xmm4
+    14c7:	00 00 
+    14c9:	48 8b 05 b0 2b 00 00 	mov    0x2bb0(%rip),%rax        # 4080 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    14d0:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    14d7:	0f 11 63 08          	movups %xmm4,0x8(%rbx)
+    14db:	48 8b 7b 10          	mov    0x10(%rbx),%rdi
+    14df:	48 39 c7             	cmp    %rax,%rdi
+    14e2:	0f 85 f0 fe ff ff    	jne    13d8 <test1()+0x138>
+    14e8:	e9 34 ff ff ff       	jmp    1421 <test1()+0x181>
+    14ed:	0f 1f 00             	nopl   (%rax)
+    14f0:	f3 0f 6f ac 24 a8 00 	movdqu 0xa8(%rsp),%xmm5
+    14f7:	00 00 
+    14f9:	48 8b 05 80 2b 00 00 	mov    0x2b80(%rip),%rax        # 4080 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    1500:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    1507:	0f 11 6b 08          	movups %xmm5,0x8(%rbx)
+    150b:	48 8b 7b 10          	mov    0x10(%rbx),%rdi
+    150f:	48 39 c7             	cmp    %rax,%rdi
+    1512:	0f 85 c0 fe ff ff    	jne    13d8 <test1()+0x138>
+    1518:	e9 04 ff ff ff       	jmp    1421 <test1()+0x181>
+    151d:	0f 1f 00             	nopl   (%rax)
+    1520:	f3 0f 6f bc 24 e8 00 	movdqu 0xe8(%rsp),%xmm7
+    1527:	00 00 
+    1529:	48 8b 05 50 2b 00 00 	mov    0x2b50(%rip),%rax        # 4080 <outcome_v2_xxx::detail::errno_categories<void>::addresses>
+    1530:	c7 43 04 02 00 00 00 	movl   $0x2,0x4(%rbx)
+    1537:	0f 11 7b 08          	movups %xmm7,0x8(%rbx)
+    153b:	48 8b 7b 10          	mov    0x10(%rbx),%rdi
+    153f:	48 39 c7             	cmp    %rax,%rdi
+    1542:	0f 85 90 fe ff ff    	jne    13d8 <test1()+0x138>
+    1548:	e9 d4 fe ff ff       	jmp    1421 <test1()+0x181>
+    154d:	0f 1f 00             	nopl   (%rax)
@@ -0,0 +1,26 @@
+#include "../../include/outcome.hpp"
+
+#ifdef __GNUC__
+#define WEAK __attribute__((weak))
+#else
+#define WEAK
+#endif
+
+using namespace OUTCOME_V2_NAMESPACE;
+// Reading the value or calling a function for a fallback, which is one branch
+extern result<int> unknown1() WEAK;
+extern QUICKCPPLIB_NOINLINE int test1(int fallback)
+{
+  result<int> r(unknown1());
+  return r.value_or_else([&] { return fallback * 2; });
+}
+extern QUICKCPPLIB_NOINLINE void test2()
+{
+}
+
+int main(void)
+{
+  int ret = test1(0);
+  test2();
+  return ret;
+}
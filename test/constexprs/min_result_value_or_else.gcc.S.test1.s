@@ -0,0 +1,15 @@
+    11a0:	53                   	push   %rbx
+    11a1:	89 fb                	mov    %edi,%ebx
+    11a3:	48 83 ec 20          	sub    $0x20,%rsp
+    11a7:	48 89 e7             	mov    %rsp,%rdi
+    11aa:	e8 91 fe ff ff       	call   1040 <unknown1()@plt>
+    11af:	8b 04 24             	mov    (%rsp),%eax
+    11b2:	f6 44 24 04 01       	testb  $0x1,0x4(%rsp)
+    11b7:	75 03                	jne    11bc <test1(int)+0x1c>
+    11b9:	8d 04 1b             	lea    (%rbx,%rbx,1),%eax
+    11bc:	48 83 c4 20          	add    $0x20,%rsp
+    11c0:	5b                   	pop    %rbx
+    11c1:	c3                   	ret
+    11c2:	66 66 2e 0f 1f 84 00 	data16 cs nopw 0x0(%rax,%rax,1)
+    11c9:	00 00 00 00 
+    11cd:	0f 1f 00             	nopl   (%rax)
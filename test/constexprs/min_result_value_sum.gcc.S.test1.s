@@ -0,0 +1,26 @@
+    13a0:	53                   	push   %rbx
+    13a1:	48 83 ec 60          	sub    $0x60,%rsp
+    13a5:	48 89 e7             	mov    %rsp,%rdi
+    13a8:	e8 d3 fc ff ff       	call   1080 <unknown1()@plt>
+    13ad:	8b 44 24 04          	mov    0x4(%rsp),%eax
+    13b1:	a8 01                	test   $0x1,%al
+    13b3:	0f 84 5c fe ff ff    	je     1215 <test1() [clone .cold]>
+    13b9:	48 8d 7c 24 20       	lea    0x20(%rsp),%rdi
+    13be:	8b 1c 24             	mov    (%rsp),%ebx
+    13c1:	e8 ea fc ff ff       	call   10b0 <unknown2()@plt>
+    13c6:	8b 44 24 24          	mov    0x24(%rsp),%eax
+    13ca:	a8 01                	test   $0x1,%al
+    13cc:	0f 84 5f fe ff ff    	je     1231 <test1() [clone .cold]+0x1c>
+    13d2:	48 8d 7c 24 40       	lea    0x40(%rsp),%rdi
+    13d7:	03 5c 24 20          	add    0x20(%rsp),%ebx
+    13db:	e8 70 fc ff ff       	call   1050 <unknown3()@plt>
+    13e0:	8b 44 24 44          	mov    0x44(%rsp),%eax
+    13e4:	a8 01                	test   $0x1,%al
+    13e6:	0f 84 37 fe ff ff    	je     1223 <test1() [clone .cold]+0xe>
+    13ec:	8b 44 24 40          	mov    0x40(%rsp),%eax
+    13f0:	48 83 c4 60          	add    $0x60,%rsp
+    13f4:	01 d8                	add    %ebx,%eax
+    13f6:	5b                   	pop    %rbx
+    13f7:	c3                   	ret
+    13f8:	0f 1f 84 00 00 00 00 	nopl   0x0(%rax,%rax,1)
+    13ff:	00 
@@ -0,0 +1,190 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/outcome.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <stdexcept>
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#include <vector>
+#define OUTCOME_TEST_HAVE_PMR 1
+#endif
+#endif
+
+namespace allocator_aware_test
+{
+  // Not a real allocator, only identifies which arena a value was constructed in
+  struct arena_allocator
+  {
+    int id;
+  };
+  // Takes its allocator after a leading std::allocator_arg
+  struct leading
+  {
+    using allocator_type = arena_allocator;
+    int arena{0}, v{0};
+    explicit leading(int _v)
+        : v(_v)
+    {
+    }
+    leading(std::allocator_arg_t /*unused*/, const arena_allocator &a, int _v)
+        : arena(a.id)
+        , v(_v)
+    {
+    }
+    leading(const leading &o)
+        : v(o.v)
+    {
+    }
+    leading(leading &&o) noexcept
+        : arena(o.arena)
+        , v(o.v)
+    {
+    }
+    leading(std::allocator_arg_t /*unused*/, const arena_allocator &a, const leading &o)
+        : arena(a.id)
+        , v(o.v)
+    {
+    }
+    leading(std::allocator_arg_t /*unused*/, const arena_allocator &a, leading &&o)
+        : arena(a.id)
+        , v(o.v)
+    {
+    }
+  };
+  // Takes its allocator last
+  struct trailing
+  {
+    using allocator_type = arena_allocator;
+    int arena{0}, v{0};
+    explicit trailing(int _v)
+        : v(_v)
+    {
+    }
+    trailing(int _v, const arena_allocator &a)
+        : arena(a.id)
+        , v(_v)
+    {
+    }
+    trailing(const trailing &o)
+        : v(o.v)
+    {
+    }
+    trailing(const trailing &o, const arena_allocator &a)
+        : arena(a.id)
+        , v(o.v)
+    {
+    }
+  };
+}  // namespace allocator_aware_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / allocator, "Tests that result passes allocators on to its value")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using allocator_aware_test::arena_allocator;
+  using allocator_aware_test::leading;
+  using allocator_aware_test::trailing;
+  static_assert(std::uses_allocator<result<leading>, arena_allocator>::value, "result<leading> does not use arena_allocator");
+  static_assert(!std::uses_allocator<result<int>, arena_allocator>::value, "result<int> uses arena_allocator");
+  static_assert(!std::uses_allocator<result<void>, arena_allocator>::value, "result<void> uses arena_allocator");
+
+  // In place, with either convention
+  result<leading> a(std::allocator_arg, arena_allocator{7}, in_place_type<leading>, 5);
+  BOOST_CHECK(a.value().arena == 7 && a.value().v == 5);
+  result<trailing> b(std::allocator_arg, arena_allocator{8}, in_place_type<trailing>, 6);
+  BOOST_CHECK(b.value().arena == 8 && b.value().v == 6);
+
+  // Copies and moves take the allocator they are given
+  result<leading> c(std::allocator_arg, arena_allocator{9}, a);
+  BOOST_CHECK(c.value().arena == 9 && c.value().v == 5);
+  result<leading> d(a);
+  BOOST_CHECK(d.value().arena == 0);
+  result<leading> e(std::allocator_arg, arena_allocator{10}, std::move(a));
+  BOOST_CHECK(e.value().arena == 10);
+  result<trailing> f(std::allocator_arg, arena_allocator{11}, b);
+  BOOST_CHECK(f.value().arena == 11 && f.value().v == 6);
+
+  // Converting from a value
+  result<leading> g(std::allocator_arg, arena_allocator{12}, leading(3));
+  BOOST_CHECK(g.value().arena == 12 && g.value().v == 3);
+
+  // Anything else ignores the allocator
+  result<leading> h(std::allocator_arg, arena_allocator{13}, std::make_error_code(std::errc::invalid_argument));
+  BOOST_CHECK(h.error() == std::errc::invalid_argument);
+  result<leading> i(std::allocator_arg, arena_allocator{14}, h);
+  BOOST_CHECK(i.error() == std::errc::invalid_argument);
+  result<leading> j(std::allocator_arg, arena_allocator{15}, failure(std::make_error_code(std::errc::not_enough_memory)));
+  BOOST_CHECK(j.error() == std::errc::not_enough_memory);
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / outcome / allocator, "Tests that outcome passes allocators on to its value")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using allocator_aware_test::arena_allocator;
+  using allocator_aware_test::leading;
+  static_assert(std::uses_allocator<outcome<leading>, arena_allocator>::value, "outcome<leading> does not use arena_allocator");
+  static_assert(!std::uses_allocator<outcome<int>, arena_allocator>::value, "outcome<int> uses arena_allocator");
+
+  outcome<leading> a(std::allocator_arg, arena_allocator{7}, in_place_type<leading>, 5);
+  BOOST_CHECK(a.value().arena == 7 && a.value().v == 5);
+  outcome<leading> b(std::allocator_arg, arena_allocator{8}, a);
+  BOOST_CHECK(b.value().arena == 8);
+  outcome<leading> c(std::allocator_arg, arena_allocator{9}, std::move(b));
+  BOOST_CHECK(c.value().arena == 9);
+  outcome<leading> d(std::allocator_arg, arena_allocator{10}, leading(3));
+  BOOST_CHECK(d.value().arena == 10 && d.value().v == 3);
+  outcome<leading> e(std::allocator_arg, arena_allocator{11}, std::make_exception_ptr(std::runtime_error("x")));
+  BOOST_CHECK(e.has_exception());
+  outcome<leading> f(std::allocator_arg, arena_allocator{12}, e);
+  BOOST_CHECK(f.has_exception() && f.exception() == e.exception());
+}
+
+#ifdef OUTCOME_TEST_HAVE_PMR
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / allocator / pmr, "Tests that pmr containers of results keep their values in the container's resource")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using value_type = std::pmr::vector<int>;
+  char buffer[4096];
+  std::pmr::monotonic_buffer_resource mr(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+  std::pmr::vector<result<value_type>> v(&mr);
+  v.emplace_back(value_type{1, 2, 3});
+  v.emplace_back(std::make_error_code(std::errc::invalid_argument));
+  const result<value_type> elsewhere(value_type{4, 5});
+  v.push_back(elsewhere);
+  v.emplace_back(in_place_type<value_type>, 2, 6);
+  // Growing moved the earlier items with the container's resource too
+  BOOST_CHECK(v.size() == 4);
+  BOOST_CHECK(v[0].value().get_allocator().resource() == &mr);
+  BOOST_CHECK(v[0].value().size() == 3);
+  BOOST_CHECK(v[1].error() == std::errc::invalid_argument);
+  BOOST_CHECK(v[2].value().get_allocator().resource() == &mr);
+  BOOST_CHECK(v[2].value()[1] == 5);
+  BOOST_CHECK(v[3].value().get_allocator().resource() == &mr);
+  BOOST_CHECK(v[3].value()[1] == 6);
+  BOOST_CHECK(elsewhere.value().get_allocator().resource() == std::pmr::get_default_resource());
+}
+#endif
@@ -0,0 +1,194 @@
+/* Unit testing for any_error, a type erased error with inline storage
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/any_error.hpp"
+#include "count-allocations.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <memory>
+
+namespace any_error_test
+{
+  enum class db_code
+  {
+    deadlock = 1
+  };
+  struct db_category_impl : std::error_category
+  {
+    const char *name() const noexcept override { return "db"; }
+    std::string message(int /*unused*/) const override { return "deadlock"; }
+  };
+  inline std::error_code make_error_code(db_code e) noexcept
+  {
+    static db_category_impl c;
+    return {static_cast<int>(e), c};
+  }
+}  // namespace any_error_test
+namespace std
+{
+  template <> struct is_error_code_enum<any_error_test::db_code> : true_type
+  {
+  };
+}  // namespace std
+
+namespace any_error_test
+{
+  // A rich error which fits inline
+  struct db_error
+  {
+    db_code code;
+    int table;
+    long row;
+    std::string message() const { return "deadlock on table " + std::to_string(table); }
+    friend std::error_code make_error_code(const db_error &e) noexcept { return make_error_code(e.code); }
+  };
+  // A rich error which does not
+  struct big_error
+  {
+    char context[200];
+  };
+  // A rich error which cannot be copied
+  struct unique_error
+  {
+    std::unique_ptr<int> p;
+  };
+  // Counts the instances alive
+  struct counted_error
+  {
+    static int alive;
+    counted_error() { ++alive; }
+    counted_error(const counted_error & /*unused*/) { ++alive; }
+    counted_error(counted_error && /*unused*/) noexcept { ++alive; }
+    ~counted_error() { --alive; }
+  };
+  int counted_error::alive;
+}  // namespace any_error_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / any_error / storage, "Tests that any_error keeps small errors inline and larger errors on the heap")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using namespace any_error_test;
+  static_assert(sizeof(any_error) <= 64, "");
+  static_assert(!std::is_copy_constructible<any_error>::value, "");
+  static_assert(std::is_nothrow_move_constructible<any_error>::value, "");
+
+  any_error empty;
+  BOOST_CHECK(!empty);
+  BOOST_CHECK(empty.is_inline());
+  BOOST_CHECK(empty.message().empty());
+  BOOST_CHECK(!empty.to_error_code());
+
+  size_t count = allocations;
+  {
+    any_error a = make_any_error<db_error>(db_error{db_code::deadlock, 5, 1234});
+    any_error b(std::move(a));
+    any_error c;
+    c = std::move(b);
+    BOOST_CHECK(!a);  // NOLINT
+    BOOST_CHECK(!b);  // NOLINT
+    BOOST_CHECK(c.is_inline());
+    BOOST_CHECK(c.holds<db_error>());
+    BOOST_CHECK(!c.holds<big_error>());
+    BOOST_CHECK(c.get_if<big_error>() == nullptr);
+    BOOST_REQUIRE(c.get_if<db_error>() != nullptr);
+    BOOST_CHECK(c.get_if<db_error>()->row == 1234);
+    BOOST_CHECK(c.to_error_code() == db_code::deadlock);
+  }
+  BOOST_CHECK(allocations == count);
+
+  any_error big(big_error{"context"});
+  BOOST_CHECK(!big.is_inline());
+  BOOST_CHECK(std::string(big.get_if<big_error>()->context) == "context");
+  any_error big2(big.clone());
+  BOOST_CHECK(big2.get_if<big_error>() != big.get_if<big_error>());
+  BOOST_CHECK(std::string(big2.get_if<big_error>()->context) == "context");
+  any_error moved(std::move(big2));
+  BOOST_CHECK(std::string(moved.get_if<big_error>()->context) == "context");
+
+  any_error u(unique_error{std::make_unique<int>(5)});
+  BOOST_CHECK(*u.get_if<unique_error>()->p == 5);
+  any_error u2(std::move(u));
+  BOOST_CHECK(*u2.get_if<unique_error>()->p == 5);
+
+  {
+    any_error x(counted_error{}), y(counted_error{});
+    BOOST_CHECK(counted_error::alive == 2);
+    x.swap(y);
+    any_error z(x.clone());
+    BOOST_CHECK(counted_error::alive == 3);
+    x = std::move(z);
+    BOOST_CHECK(counted_error::alive == 2);
+  }
+  BOOST_CHECK(counted_error::alive == 0);
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / any_error / describe, "Tests the messages and codes of the errors any_error holds")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using namespace any_error_test;
+  BOOST_CHECK(any_error(db_error{db_code::deadlock, 5, 0}).message() == "deadlock on table 5");
+  BOOST_CHECK(any_error(std::runtime_error("boo")).message() == "boo");
+  BOOST_CHECK(any_error(std::runtime_error("boo")).to_error_code() == std::errc::resource_unavailable_try_again);
+  BOOST_CHECK(any_error(std::system_error(std::make_error_code(std::errc::timed_out))).to_error_code() == std::errc::timed_out);
+  BOOST_CHECK(any_error(std::make_error_code(std::errc::invalid_argument)).to_error_code() == std::errc::invalid_argument);
+  BOOST_CHECK(any_error(db_code::deadlock).message() == "deadlock");
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / any_error / result, "Tests that any_error can be the error type of result and the exception type of outcome")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using namespace any_error_test;
+  static_assert(trait::has_error_code_v<any_error>, "");
+  static_assert(trait::has_exception_ptr_v<any_error>, "");
+
+  size_t count = allocations;
+  result<int, any_error> r(make_any_error<db_error>(db_error{db_code::deadlock, 7, 0}));
+  result<long, any_error> r2(std::move(r));
+  BOOST_CHECK(allocations == count);
+  BOOST_REQUIRE(r2.has_error());
+  BOOST_CHECK(r2.error().get_if<db_error>()->table == 7);
+
+  using rich_outcome = outcome<int, std::error_code, any_error>;
+  rich_outcome o(any_error(std::logic_error("bad"))), p(5);
+  BOOST_CHECK(o.has_exception());
+  BOOST_CHECK(p.value() == 5);
+#ifdef __cpp_exceptions
+  BOOST_CHECK_THROW((void) o.value(), std::logic_error);
+  try
+  {
+    (void) r2.value();
+    BOOST_CHECK(false);
+  }
+  catch(const std::system_error &e)
+  {
+    BOOST_CHECK(e.code() == db_code::deadlock);
+    BOOST_CHECK(std::string(e.what()).find("deadlock on table 7") != std::string::npos);
+  }
+  try
+  {
+    std::rethrow_exception(o.failure());
+  }
+  catch(const std::logic_error &e)
+  {
+    BOOST_CHECK(std::string(e.what()) == "bad");
+  }
+#endif
+}
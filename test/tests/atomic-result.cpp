@@ -0,0 +1,82 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/atomic_result.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / atomic_result, "Tests that atomic_result publishes a result once to many readers")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  {
+    // Only the first publication wins
+    atomic_result<std::string> a;
+    BOOST_CHECK(!a.is_ready());
+    BOOST_CHECK(!a.has_value());
+    BOOST_CHECK(a.try_get() == nullptr);
+    BOOST_CHECK(a.emplace(in_place_type<std::string>, "hello"));
+    BOOST_CHECK(!a.publish(result<std::string>(std::errc::invalid_argument)));
+    BOOST_CHECK(a.is_ready());
+    BOOST_CHECK(a.has_value());
+    BOOST_REQUIRE(a.try_get() != nullptr);
+    BOOST_CHECK(a.try_get()->value() == "hello");
+    BOOST_CHECK(&a.wait() == a.try_get());
+  }
+  {
+    // Errors are published too
+    atomic_result<int> a;
+    BOOST_CHECK(a.publish(result<int>(std::errc::invalid_argument)));
+    BOOST_CHECK(a.is_ready());
+    BOOST_CHECK(!a.has_value());
+    BOOST_CHECK(a.wait().error() == std::errc::invalid_argument);
+  }
+  {
+    // Many readers waiting on one writer all see the same result
+    atomic_result<std::vector<int>> a;
+    std::vector<std::thread> readers;
+    std::vector<int> sums(8, 0);
+    for(size_t n = 0; n < sums.size(); n++)
+    {
+      readers.emplace_back([&, n] {
+        const auto &r = a.wait();
+        for(int i : r.value())
+        {
+          sums[n] += i;
+        }
+      });
+    }
+    std::thread writer([&] { a.emplace(in_place_type<std::vector<int>>, std::vector<int>{1, 2, 3, 4}); });
+    writer.join();
+    for(auto &t : readers)
+    {
+      t.join();
+    }
+    for(int sum : sums)
+    {
+      BOOST_CHECK(sum == 10);
+    }
+  }
+}
@@ -0,0 +1,83 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/backtrace.hpp"
+#include "../../include/outcome/iostream_support.hpp"
+#include "count-allocations.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+namespace backtrace_test
+{
+  // The ADL bridge for the hooks
+  struct error_code : public std::error_code
+  {
+    using std::error_code::error_code;
+    error_code() = default;
+    error_code(std::error_code ec)  // NOLINT
+    : std::error_code(ec)
+    {
+    }
+  };
+  template <class R> using result = OUTCOME_V2_NAMESPACE::result<R, error_code>;
+  template <class T, class U> inline void hook_result_construction(result<T> *res, U && /*unused*/) noexcept
+  {
+    if(res->has_error())
+    {
+      OUTCOME_V2_NAMESPACE::capture_backtrace(res);
+    }
+  }
+  template <class T, class P> inline void hook_result_print(std::ostream &s, const OUTCOME_V2_NAMESPACE::detail::result_final<T, error_code, P> *res) { OUTCOME_V2_NAMESPACE::print_backtrace(s, *res); }
+
+  extern result<int> fail()
+  {
+    return error_code(make_error_code(std::errc::invalid_argument));
+  }
+}  // namespace backtrace_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / backtrace, "Tests that backtraces are captured cheaply and symbolised when printed")
+{
+#ifndef OUTCOME_ENABLE_COMPACT_STATUS
+  using namespace backtrace_test;
+  using OUTCOME_V2_NAMESPACE::find_backtrace;
+  result<int> ok(5);
+  BOOST_CHECK(find_backtrace(ok) == nullptr);
+  BOOST_CHECK(print(ok) == "5");
+
+  (void) fail();  // first use of the unwinder may allocate
+  const size_t before = allocations;
+  result<int> a = fail();
+  // Capture allocates nothing, symbolisation is deferred
+  BOOST_CHECK(allocations == before);
+  BOOST_REQUIRE(find_backtrace(a) != nullptr);
+#ifdef OUTCOME_HAVE_BACKTRACE
+  BOOST_CHECK(!find_backtrace(a)->empty());
+  BOOST_CHECK(find_backtrace(a)->symbols().size() == find_backtrace(a)->size());
+#endif
+  std::string printed = print(a);
+  BOOST_CHECK(printed.find("Invalid argument") != std::string::npos);
+  BOOST_CHECK(printed.find(" [") != std::string::npos);
+
+  OUTCOME_V2_NAMESPACE::stack_backtrace empty;
+  std::ostringstream s;
+  s << empty;
+  BOOST_CHECK(s.str() == "[]");
+#endif
+}
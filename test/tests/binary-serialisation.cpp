@@ -0,0 +1,256 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/binary_serialisation.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <cstring>
+#include <sstream>
+
+namespace binary_serialisation_test
+{
+  struct person
+  {
+    std::string name;
+    int age{0};
+  };
+  class my_category_impl : public std::error_category
+  {
+  public:
+    const char *name() const noexcept override { return "binary_serialisation_test"; }
+    std::string message(int c) const override { return "code " + std::to_string(c); }
+  };
+  inline const std::error_category &my_category()
+  {
+    static my_category_impl v;
+    return v;
+  }
+}  // namespace binary_serialisation_test
+
+// A user codec for a type which is not trivially copyable
+OUTCOME_V2_NAMESPACE_BEGIN
+namespace binary
+{
+  template <> struct codec<binary_serialisation_test::person>
+  {
+    template <class Sink> static void encode(Sink &sink, const binary_serialisation_test::person &v)
+    {
+      codec<std::string>::encode(sink, v.name);
+      codec<int>::encode(sink, v.age);
+    }
+    template <class Source> static bool decode(Source &source, binary_serialisation_test::person &v) { return codec<std::string>::decode(source, v.name) && codec<int>::decode(source, v.age); }
+  };
+}  // namespace binary
+OUTCOME_V2_NAMESPACE_END
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / binary / serialisation, "Tests that result and outcome round trip through the binary serialisation")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using binary::as_binary;
+  std::stringstream ss;
+  auto roundtrip = [&](const auto &in, auto &out) {
+    ss.str("");
+    ss.clear();
+    ss << as_binary(in);
+    return static_cast<bool>(ss >> as_binary(out));
+  };
+
+  // Trivially copyable values and error codes, whose category survives
+  result<double> a(3.5), b(std::make_error_code(std::errc::invalid_argument)), c(0.0);
+  BOOST_CHECK(roundtrip(a, c) && c == a);
+  BOOST_CHECK(roundtrip(b, c) && c == b);
+  BOOST_CHECK(c.error().category() == std::generic_category());
+  ss.str("");
+  ss << as_binary(a);
+  BOOST_CHECK(ss.str().size() == 1 + sizeof(double));
+  ss.str("");
+  ss << as_binary(b);
+  BOOST_CHECK(ss.str().size() == 9);
+  BOOST_CHECK(ss.str()[0] == binary::status_error);
+
+  // Categories unknown to the reader cannot be decoded, user categories are registered by use or explicitly
+  result<void> d(std::error_code(5, binary_serialisation_test::my_category())), e(success());
+  ss.str(std::string("\x02\x05\x00\x00\x00\x78\x56\x34\x12", 9));
+  ss.clear();
+  BOOST_CHECK(!(ss >> as_binary(e)));
+  BOOST_CHECK(binary::register_category(binary_serialisation_test::my_category()));
+  BOOST_CHECK(binary::register_category(binary_serialisation_test::my_category()));
+  BOOST_CHECK(roundtrip(d, e) && e == d);
+  BOOST_CHECK(e.error().category() == binary_serialisation_test::my_category());
+  result<void> f(std::make_error_code(std::errc::invalid_argument));
+  BOOST_CHECK(roundtrip(result<void>(success()), f) && f);
+
+  // Strings and user codecs
+  result<std::string> g("hello"), h(std::make_error_code(std::errc::invalid_argument));
+  BOOST_CHECK(roundtrip(g, h) && h.value() == "hello");
+  result<binary_serialisation_test::person> i(binary_serialisation_test::person{"niall", 40}), j(std::make_error_code(std::errc::invalid_argument));
+  BOOST_CHECK(roundtrip(i, j) && j.value().name == "niall" && j.value().age == 40);
+
+  // Spare storage is preserved
+  result<int> k(5), l(0);
+  hooks::set_spare_storage(&k, 0x1234);
+  BOOST_CHECK(roundtrip(k, l) && l.value() == 5 && hooks::spare_storage(&l) == 0x1234);
+
+  // Malformed input fails and leaves the result alone
+  ss.str(std::string("\x01\x02", 2));
+  ss.clear();
+  l = 78;
+  BOOST_CHECK(!(ss >> as_binary(l)));
+  BOOST_CHECK(l.value() == 78);
+  ss.str(std::string("\x00", 1));
+  ss.clear();
+  BOOST_CHECK(!(ss >> as_binary(l)));
+
+  // Outcomes, including with both error and exception
+  outcome<int> m(5), n(std::make_error_code(std::errc::invalid_argument)), o(0);
+  BOOST_CHECK(roundtrip(m, o) && o.value() == 5);
+  BOOST_CHECK(roundtrip(n, o) && o.error() == std::errc::invalid_argument && !o.has_exception());
+#ifdef __cpp_exceptions
+  outcome<int> p(std::make_exception_ptr(std::bad_alloc())), q(failure(std::make_error_code(std::errc::invalid_argument), std::make_exception_ptr(std::invalid_argument("x"))));
+  BOOST_CHECK(roundtrip(p, o) && o.has_exception() && !o.has_error());
+  BOOST_CHECK_THROW(o.value(), std::system_error);
+  BOOST_CHECK(roundtrip(q, o) && o.has_exception() && o.error() == std::errc::invalid_argument);
+  try
+  {
+    std::rethrow_exception(o.exception());
+  }
+  catch(const std::system_error &ex)
+  {
+    BOOST_CHECK(ex.code() == std::errc::invalid_argument);
+  }
+#endif
+}
+
+#if defined(__cpp_lib_bit_cast) && defined(__cpp_lib_is_constant_evaluated)
+// Round trips a trivially copyable result through a buffer at compile time
+constexpr int binary_serialisation_constexpr_roundtrip()
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  unsigned char buffer[16]{};
+  result<int, long> in(success(42));
+  auto written = binary::encode(in, buffer, sizeof(buffer));
+  auto out = binary::decode<result<int, long>>(buffer, written.value());
+  result<int, long> errored(failure(5L));
+  written = binary::encode(errored, buffer, sizeof(buffer));
+  auto out2 = binary::decode<result<int, long>>(buffer, written.value());
+  return out.value().value() + static_cast<int>(out2.value().error());
+}
+static_assert(binary_serialisation_constexpr_roundtrip() == 47, "constexpr round trip failed");
+#endif
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / binary / buffer, "Tests that result and outcome round trip through caller owned buffers")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  unsigned char buffer[64]{};
+
+  result<double> a(3.5), b(std::make_error_code(std::errc::invalid_argument));
+  auto written = binary::encode(a, buffer, sizeof(buffer));
+  BOOST_CHECK(written && written.value() == 1 + sizeof(double));
+  auto c = binary::decode<result<double>>(buffer, written.value());
+  BOOST_CHECK(c && c.value() == a);
+  written = binary::encode(b, buffer, sizeof(buffer));
+  BOOST_CHECK(written && written.value() == 9);
+  c = binary::decode<result<double>>(buffer, written.value());
+  BOOST_CHECK(c && c.value() == b);
+
+  // Too small a buffer, too few bytes, and bytes which are not an object of the type
+  written = binary::encode(a, buffer, sizeof(double));
+  BOOST_CHECK(!written && written.error() == binary::decode_error::buffer_too_small);
+  BOOST_CHECK(binary::encode(a, buffer, sizeof(buffer)));
+  c = binary::decode<result<double>>(buffer, sizeof(double));
+  BOOST_CHECK(!c && c.error() == binary::decode_error::truncated);
+  buffer[0] = 0;
+  c = binary::decode<result<double>>(buffer, sizeof(buffer));
+  BOOST_CHECK(!c && c.error() == binary::decode_error::malformed);
+
+  // Outcomes
+  outcome<std::string> d("hello");
+  written = binary::encode(d, buffer, sizeof(buffer));
+  auto e = binary::decode<outcome<std::string>>(buffer, written.value());
+  BOOST_CHECK(e && e.value().value() == "hello");
+
+  // A string length of more than the buffer holds fails as truncated, without allocating that length
+  result<std::string> h("hello");
+  written = binary::encode(h, buffer, sizeof(buffer));
+  BOOST_REQUIRE(written && written.value() == 1 + 4 + 5);
+  memset(buffer + 1, 0xff, 4);
+  auto i = binary::decode<result<std::string>>(buffer, written.value());
+  BOOST_CHECK(!i && i.error() == binary::decode_error::truncated);
+
+#ifdef __cpp_lib_span
+  std::byte bytes[16]{};
+  result<int> f(5);
+  written = binary::encode(f, std::span<std::byte>(bytes));
+  BOOST_CHECK(written && written.value() == 1 + sizeof(int));
+  auto g = binary::decode<result<int>>(std::span<const std::byte>(bytes, written.value()));
+  BOOST_CHECK(g && g.value().value() == 5);
+#endif
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / binary / batch, "Tests that batches of results round trip through the batch serialisation")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  std::vector<result<uint64_t>> in;
+  for(uint64_t n = 0; n < 1000; n++)
+  {
+    if(n % 100 == 7)
+    {
+      in.emplace_back(std::make_error_code(std::errc::invalid_argument));
+    }
+    else
+    {
+      in.emplace_back(n);
+    }
+  }
+  std::stringstream ss;
+  binary::streambuf_sink sink(ss.rdbuf());
+  binary::encode_batch(sink, in);
+  // The count, a bit per item, 990 values and 10 errors
+  BOOST_CHECK(ss.str().size() == 4 + 125 + 990 * 8 + 10 * 8);
+
+  std::vector<result<uint64_t>> out;
+  binary::streambuf_source source(ss.rdbuf());
+  BOOST_CHECK(binary::decode_batch(source, out));
+  BOOST_CHECK(out == in);
+
+  // Into a result_vector
+  result_vector<uint64_t> soa;
+  ss.seekg(0);
+  BOOST_CHECK(binary::decode_batch(source, soa));
+  BOOST_REQUIRE(soa.size() == in.size());
+  BOOST_CHECK(soa.count_failures() == 10 && soa.first_failure() == 7);
+  BOOST_CHECK(soa[8].value() == 8 && soa[107].error() == std::errc::invalid_argument);
+  ss.str("");
+  binary::encode_batch(sink, soa);
+  ss.seekg(0);
+  BOOST_CHECK(binary::decode_batch(source, out) && out == in);
+
+  // Truncated batches leave the destination alone
+  std::string bytes = ss.str();
+  bytes.resize(bytes.size() - 1);
+  ss.str(bytes);
+  BOOST_CHECK(!binary::decode_batch(source, out));
+  BOOST_CHECK(out == in);
+  ss.str(std::string("\xff\xff\xff\xff\x00", 5));
+  BOOST_CHECK(!binary::decode_batch(source, out));
+}
@@ -0,0 +1,91 @@
+/* Unit testing for native Boost.System support
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#if defined(__has_include)
+#if __has_include(<boost/system/system_error.hpp>) && !defined(OUTCOME_ENABLE_BOOST_SYSTEM)
+#define OUTCOME_ENABLE_BOOST_SYSTEM 1
+#endif
+#endif
+
+#include "../../include/outcome.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#ifdef OUTCOME_ENABLE_BOOST_SYSTEM
+namespace boost_system_test
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using boost_error_code = boost::system::error_code;
+  template <class R> inline bool is_errno(const R &r) { return (r.__state().status() & detail::status_error_is_errno) != 0; }
+
+  class other_category : public boost::system::error_category
+  {
+  public:
+    const char *name() const noexcept override { return "other"; }
+    std::string message(int /*unused*/) const override { return "other"; }
+  };
+  inline const other_category &other() noexcept
+  {
+    static other_category c;
+    return c;
+  }
+}  // namespace boost_system_test
+#endif
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_boost_system, "Tests that boost::system::error_code is handled without converting it to std::error_code")
+{
+#ifdef OUTCOME_ENABLE_BOOST_SYSTEM
+  using namespace boost_system_test;
+  // The errno flag is detected from the Boost categories
+  BOOST_CHECK(is_errno(result<int, boost_error_code>(boost_error_code(ENOENT, boost::system::generic_category()))));
+#ifndef _WIN32
+  BOOST_CHECK(is_errno(result<int, boost_error_code>(boost_error_code(ENOENT, boost::system::system_category()))));
+#endif
+  BOOST_CHECK(!is_errno(result<int, boost_error_code>(boost_error_code(ENOENT, other()))));
+  BOOST_CHECK(is_errno(result<double, boost::system::errc::errc_t>(failure(boost::system::errc::invalid_argument))));
+
+  // The policy throws the Boost exception type with the original code
+  result<int, boost_error_code> r(boost_error_code(ENOENT, other()));
+  try
+  {
+    r.value();
+    BOOST_CHECK(false);
+  }
+  catch(const boost::system::system_error &e)
+  {
+    BOOST_CHECK(e.code() == boost_error_code(ENOENT, other()));
+  }
+  outcome<int, boost_error_code> o(boost_error_code(EINVAL, boost::system::generic_category()));
+  BOOST_CHECK_THROW(o.value(), boost::system::system_error);
+
+  // Boost system errors map onto the equivalent std::error_code
+  BOOST_CHECK(error_from_exception(std::make_exception_ptr(boost::system::system_error(boost_error_code(ENOENT, boost::system::generic_category())))) == std::errc::no_such_file_or_directory);
+  std::error_code ec = error_from_exception(std::make_exception_ptr(boost::system::system_error(boost_error_code(5, other()))));
+  BOOST_CHECK(ec.value() == 5);
+  BOOST_CHECK(ec != std::errc::resource_unavailable_try_again);
+
+  // As do the errno domained codes to the STL exception types
+  BOOST_CHECK_THROW(try_throw_std_exception_from_error(boost_error_code(EINVAL, boost::system::generic_category())), std::invalid_argument);
+  try_throw_std_exception_from_error(boost_error_code(EINVAL, other()));
+#endif
+}
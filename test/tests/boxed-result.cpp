@@ -0,0 +1,100 @@
+/* Unit testing for results boxing large values
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/boxed_result.hpp"
+#include "../../include/outcome/try.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <array>
+#include <string>
+
+namespace boxed_result_test
+{
+  struct large
+  {
+    std::array<int, 64> a{};
+    std::string s;
+
+    large() = default;
+    large(int v, std::string _s)
+        : s(std::move(_s))
+    {
+      a.fill(v);
+    }
+    friend bool operator==(const large &x, const large &y) noexcept { return x.a == y.a && x.s == y.s; }
+  };
+}  // namespace boxed_result_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / boxed_result, "Tests that boxed results keep large values out of line")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using boxed_result_test::large;
+  static_assert(boxed_result<large>::is_boxed, "a large value is not boxed");
+  static_assert(!boxed_result<int>::is_boxed, "an int is boxed");
+  static_assert(sizeof(boxed_result<large>) == sizeof(result<void *>), "a boxed result is not the size of a pointer result");
+  static_assert(sizeof(boxed_result<int>) == sizeof(result<int>), "an unboxed boxed result is not the size of a result");
+  static_assert(std::is_same<decltype(std::declval<boxed_result<large> &>().value()), large &>::value, "value() does not return the value");
+  static_assert(trait::is_move_bitcopying<boxed_result<large>>::value, "a boxed result is not move bitcopying");
+  {
+    boxed_result<large> a(large(5, "hello"));
+    BOOST_CHECK(a.has_value());
+    BOOST_CHECK(a.value().a[63] == 5);
+    BOOST_CHECK(a.value().s == "hello");
+    // Copies box a copy, moves take the box
+    boxed_result<large> b(a);
+    BOOST_CHECK(&b.value() != &a.value());
+    BOOST_CHECK(b.value() == a.value());
+    const large *p = &a.value();
+    boxed_result<large> c(std::move(a));
+    BOOST_CHECK(&c.value() == p);
+    b.value().s = "world";
+    c = b;
+    BOOST_CHECK(c.value().s == "world");
+    BOOST_CHECK(&c.value() == p);  // copy assignment reuses the box
+    large d = std::move(c).value();
+    BOOST_CHECK(d.s == "world");
+  }
+  {
+    boxed_result<large> a(std::errc::invalid_argument);
+    BOOST_CHECK(a.has_error());
+    BOOST_CHECK(a.error() == std::errc::invalid_argument);
+    BOOST_CHECK_THROW(a.value(), std::system_error);
+    BOOST_CHECK(a.value_or(large(1, "fallback")).s == "fallback");
+    boxed_result<large> b(in_place_type<large>, 7, "in place");
+    BOOST_CHECK(b.value().a[0] == 7);
+    a = std::move(b);
+    BOOST_CHECK(a.value().s == "in place");
+  }
+  {
+    // Small values are kept inline, and the TRY macros work across boxed and unboxed results
+    boxed_result<int> a(5);
+    BOOST_CHECK(a.value() == 5);
+    auto f = [](boxed_result<large> v) -> boxed_result<int> {
+      OUTCOME_TRY(i, std::move(v));
+      return i.a[0];
+    };
+    BOOST_CHECK(f(large(3, "")).value() == 3);
+    BOOST_CHECK(f(std::errc::io_error).error() == std::errc::io_error);
+  }
+}
@@ -0,0 +1,115 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/outcome.hpp"
+#include "../../include/outcome/bulk.hpp"
+#include "../../include/outcome/outcome.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <string>
+#include <vector>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / bulk, "Tests that the bulk status scanning kernels work as intended")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  std::vector<result<int>> v;
+  for(int n = 0; n < 150; n++)
+  {
+    v.emplace_back(n);
+  }
+  BOOST_CHECK(!bulk::any_failed(v.data(), v.size()));
+  BOOST_CHECK(bulk::find_first_failure(v.data(), v.size()) == 150);
+  BOOST_CHECK(bulk::count_failures(v.data(), v.size()) == 0);
+  BOOST_CHECK(bulk::partition_by_status(v.data(), v.size()) == 150);
+
+  v[70] = std::errc::invalid_argument;
+  v[3] = std::errc::no_such_file_or_directory;
+  v[149] = std::errc::invalid_argument;
+  BOOST_CHECK(bulk::any_failed(v.data(), v.size()));
+  BOOST_CHECK(!bulk::any_failed(v.data(), 3));
+  BOOST_CHECK(bulk::find_first_failure(v.data(), v.size()) == 3);
+  BOOST_CHECK(bulk::find_first_failure(v.data() + 4, v.size() - 4) == 66);
+  BOOST_CHECK(bulk::count_failures(v.data(), v.size()) == 3);
+
+  std::vector<int> values;
+  bulk::compress_values(v.data(), v.size(), std::back_inserter(values));
+  BOOST_CHECK(values.size() == 147);
+  BOOST_CHECK(values[2] == 2);
+  BOOST_CHECK(values[3] == 4);
+  BOOST_CHECK(values.back() == 148);
+
+  BOOST_CHECK(bulk::partition_by_status(v.data(), v.size()) == 147);
+  BOOST_CHECK(bulk::find_first_failure(v.data(), v.size()) == 147);
+  BOOST_CHECK(v[3].value() == 4);
+  BOOST_CHECK(v[147].error() == std::errc::no_such_file_or_directory);
+  BOOST_CHECK(v[148].error() == std::errc::invalid_argument);
+
+  // Works for outcome too
+  outcome<int> o[3] = {5, std::make_exception_ptr(5), 6};
+  BOOST_CHECK(bulk::find_first_failure(o, 3) == 1);
+  BOOST_CHECK(bulk::count_failures(o, 3) == 1);
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / bulk / unwrap_all, "Tests that unwrap_all writes the values contiguously and stops at the first failure")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  std::vector<result<int>> v;
+  for(int n = 0; n < 200; n++)
+  {
+    v.emplace_back(n);
+  }
+  std::vector<int> out(200, -1);
+  auto r = bulk::unwrap_all(v.data(), v.size(), out.data());
+  BOOST_REQUIRE(r);
+  BOOST_CHECK(r.value() == 200);
+  for(int n = 0; n < 200; n++)
+  {
+    BOOST_CHECK(out[n] == n);
+  }
+
+  // Stops at the first failure, in a later block, having written the values before it
+  v[130] = std::errc::invalid_argument;
+  v[150] = std::errc::no_such_file_or_directory;
+  std::vector<int> values;
+  r = bulk::unwrap_all(v.data(), v.size(), std::back_inserter(values));
+  BOOST_REQUIRE(!r);
+  BOOST_CHECK(r.error() == std::errc::invalid_argument);
+  BOOST_CHECK(values.size() == 130);
+  BOOST_CHECK(values.back() == 129);
+  BOOST_CHECK(bulk::unwrap_all(v.data(), 130, out.data()).value() == 130);
+  BOOST_CHECK(bulk::unwrap_all(v.data(), 0, out.data()).value() == 0);
+
+  // Moves values out if asked
+  std::vector<result<std::string>> s{std::string(100, 'a'), std::string(100, 'b')};
+  std::vector<std::string> strings;
+  BOOST_CHECK(bulk::unwrap_all_move(s.data(), s.size(), std::back_inserter(strings)).value() == 2);
+  BOOST_CHECK(strings[1] == std::string(100, 'b'));
+  BOOST_CHECK(s[1].value().empty());
+  BOOST_CHECK(bulk::unwrap_all(static_cast<const result<std::string> *>(s.data()), s.size(), std::back_inserter(strings)).value() == 2);
+
+#ifdef __cpp_lib_span
+  std::span<const result<int>> span(v.data(), 100);
+  BOOST_CHECK(bulk::unwrap_all(span, out.data()).value() == 100);
+  BOOST_CHECK(out[99] == 99);
+#endif
+}
@@ -0,0 +1,76 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/result.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <cstring>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / comparison / bytewise, "Tests that results of bytewise comparable types compare their bytes correctly")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using result_type = result<uint64_t, uint32_t>;
+  static_assert(detail::is_bytewise_comparable<uint64_t>::value, "");
+  static_assert(!detail::is_bytewise_comparable<double>::value, "");
+  static_assert(!detail::is_bytewise_comparable<std::error_code>::value, "");
+
+  BOOST_CHECK(result_type(in_place_type<uint64_t>, 5) == result_type(in_place_type<uint64_t>, 5));
+  BOOST_CHECK(result_type(in_place_type<uint64_t>, 5) != result_type(in_place_type<uint64_t>, 6));
+  BOOST_CHECK(result_type(in_place_type<uint32_t>, 5) == result_type(in_place_type<uint32_t>, 5));
+  BOOST_CHECK(result_type(in_place_type<uint32_t>, 5) != result_type(in_place_type<uint32_t>, 6));
+  BOOST_CHECK(result_type(in_place_type<uint64_t>, 5) != result_type(in_place_type<uint32_t>, 5));
+  BOOST_CHECK(!(result_type(in_place_type<uint64_t>, 5) == result_type(in_place_type<uint32_t>, 5)));
+
+  // The bytes of an absent value are ignored, whatever they are
+  result_type a(in_place_type<uint32_t>, 5), b(in_place_type<uint32_t>, 5);
+  memset(static_cast<void *>(&a), 0xaa, sizeof(uint64_t));
+  memset(static_cast<void *>(&b), 0x55, sizeof(uint64_t));
+  BOOST_CHECK(a == b);
+  BOOST_CHECK(!(a != b));
+
+  // As before, the spare storage is part of the status compared
+  result_type c(in_place_type<uint64_t>, 5), d(in_place_type<uint64_t>, 5);
+  hooks::set_spare_storage(&c, 1);
+#ifndef OUTCOME_ENABLE_COMPACT_STATUS
+  BOOST_CHECK(c != d);
+#endif
+
+  // Agrees with the member by member comparison of results which cannot be compared bytewise
+  const uint64_t values[] = {0, 1, 0xffffffffffffffffULL};
+  for(uint64_t x : values)
+  {
+    for(uint64_t y : values)
+    {
+      for(int n = 0; n < 4; n++)
+      {
+        const result_type l = (n & 1) ? result_type(in_place_type<uint32_t>, static_cast<uint32_t>(x)) : result_type(in_place_type<uint64_t>, x);
+        const result_type r = (n & 2) ? result_type(in_place_type<uint32_t>, static_cast<uint32_t>(y)) : result_type(in_place_type<uint64_t>, y);
+        const result<uint64_t, long> lm = (n & 1) ? result<uint64_t, long>(in_place_type<long>, static_cast<uint32_t>(x)) : result<uint64_t, long>(in_place_type<uint64_t>, x);
+        const result<uint64_t, long> rm = (n & 2) ? result<uint64_t, long>(in_place_type<long>, static_cast<uint32_t>(y)) : result<uint64_t, long>(in_place_type<uint64_t>, y);
+        BOOST_CHECK((l == r) == (lm == rm));
+        BOOST_CHECK((l != r) == (lm != rm));
+      }
+    }
+  }
+}
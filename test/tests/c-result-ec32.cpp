@@ -0,0 +1,99 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/c_result.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+// As a C consumer would declare them
+CXX_DECLARE_RESULT_EC32(int, int);
+CXX_DECLARE_RESULT_EC32(u64, unsigned long long);
+
+extern "C" CXX_RESULT_EC32(int) c_result_ec32_test_call(int v);
+extern "C" CXX_RESULT_EC32(int) c_result_ec32_test_call(int v)
+{
+  CXX_RESULT_EC32(int) ret = {v, 0, 1};
+  return ret;
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / c_result_ec32, "Tests that the compact C representation of results round trips")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  static_assert(sizeof(CXX_RESULT_EC32(u64)) == 16, "compact result does not fit in two registers");
+  static_assert(sizeof(CXX_RESULT_EC32(int)) == sizeof(c_result_ec32<int>), "C and C++ compact results differ in size");
+
+  BOOST_CHECK(CXX_RESULT_HAS_VALUE(c_result_ec32_test_call(5)) && c_result_ec32_test_call(5).value == 5);
+
+  result<int> a(5);
+  c_result_ec32<int> c = to_c_result32(a);
+  BOOST_CHECK(CXX_RESULT_HAS_VALUE(c) && !CXX_RESULT_HAS_ERROR(c) && c.value == 5);
+  result<int> b(std::error_code(ENOENT, std::generic_category()));
+  BOOST_CHECK(from_c_result32(b, c));
+  BOOST_CHECK(b.value() == 5);
+
+  // Errors keep their code, category and errno flag
+  a = std::error_code(-EINVAL, std::system_category());
+  c = to_c_result32(a);
+  BOOST_CHECK(CXX_RESULT_HAS_ERROR(c) && !CXX_RESULT_HAS_VALUE(c));
+  BOOST_CHECK(CXX_RESULT_EC32_ERROR(c) == -EINVAL);
+  BOOST_CHECK(c.category == error_category_id(std::system_category()));
+  BOOST_CHECK((c.flags & CXX_RESULT_EC32_CODE_TRUNCATED) == 0);
+  BOOST_CHECK(from_c_result32(b, c));
+  BOOST_CHECK(b.error() == std::error_code(-EINVAL, std::system_category()));
+  a = std::error_code(ENOENT, std::generic_category());
+  c = to_c_result32(a);
+  BOOST_CHECK(CXX_RESULT_ERROR_IS_ERRNO(c));
+  errno = 0;
+  CXX_RESULT_EC32_SET_ERRNO(c);
+  BOOST_CHECK(errno == ENOENT);
+
+  // Codes too large for 24 bits are flagged
+  a = std::error_code(0x12345678, std::system_category());
+  c = to_c_result32(a);
+  BOOST_CHECK((c.flags & CXX_RESULT_EC32_CODE_TRUNCATED) != 0);
+  BOOST_CHECK(CXX_RESULT_EC32_ERROR(c) == 0x345678);
+
+  // Unregistered categories are refused
+  c.category = 1;
+  b = 5;
+  BOOST_CHECK(!from_c_result32(b, c));
+  BOOST_CHECK(b.value() == 5);
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / c_result_ec32 / results_to_errno, "Tests that arrays of C results convert to errno in one call")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  const c_result_ec32<int> results[3] = {to_c_result32(result<int>(5)), to_c_result32(result<int>(std::error_code(ENOENT, std::generic_category()))), to_c_result32(result<int>(std::error_code(42, std::system_category())))};
+  int errnos[3]{}, values[3]{-1, -1, -1};
+  BOOST_CHECK(results_to_values_and_errno(results, 3, values, errnos) == 2);
+  BOOST_CHECK(values[0] == 5 && values[1] == 0 && values[2] == 0);
+  BOOST_CHECK(errnos[0] == 0 && errnos[1] == ENOENT);
+#ifdef _WIN32
+  BOOST_CHECK(errnos[2] == EAGAIN);
+#else
+  BOOST_CHECK(errnos[2] == 42);
+#endif
+
+  const c_result<int, std::error_code> full[2] = {to_c_result(result<int>(5)), to_c_result(result<int>(std::error_code(EINVAL, std::generic_category())))};
+  BOOST_CHECK(results_to_errno(full, 2, errnos) == 1);
+  BOOST_CHECK(errnos[0] == 0 && errnos[1] == EINVAL);
+}
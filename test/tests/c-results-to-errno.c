@@ -0,0 +1,80 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+/* This test is C, so has no unit test framework */
+#include <errno.h>
+#include <stdio.h>
+
+#include "../../include/outcome/result.h"
+
+CXX_DECLARE_RESULT_EC(int, int);
+CXX_DECLARE_RESULT_EC_TO_ERRNO(int, int)
+CXX_DECLARE_RESULT_EC32(long, long);
+CXX_DECLARE_RESULT_EC32_TO_ERRNO(long, long)
+
+static int failures;
+
+#define CHECK(expr)                                                                                                                                                                                                                                                                                                            \
+  if(!(expr))                                                                                                                                                                                                                                                                                                                  \
+  {                                                                                                                                                                                                                                                                                                                            \
+    fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #expr);                                                                                                                                                                                                                                                   \
+    ++failures;                                                                                                                                                                                                                                                                                                                \
+  }
+
+int main(void)
+{
+  /* valued, errored with an errno code, errored with a code of another domain */
+  CXX_RESULT_EC(int) results[3] = {{5, 1U, {0, 0}}, {0, 2U | (1U << 4U), {ENOENT, 0}}, {0, 2U, {42, 0}}};
+  CXX_RESULT_EC32(long) results32[3] = {{6, 0, 1U}, {0, 78, 2U | (1U << 4U) | ((unsigned) -EINVAL << 8U)}, {0, 78, 2U | (42U << 8U)}};
+  int errnos[3] = {-1, -1, -1};
+  int values[3] = {-1, -1, -1};
+  long values32[3] = {-1, -1, -1};
+  size_t n;
+
+  CHECK(cxx_results_int_errorcode_to_errno(results, 3, errnos) == 2);
+  CHECK(errnos[0] == 0 && errnos[1] == ENOENT && errnos[2] == EAGAIN);
+  CHECK(cxx_results_int_errorcode_to_values_and_errno(results, 3, values, errnos) == 2);
+  CHECK(values[0] == 5 && values[1] == 0 && values[2] == 0);
+
+  CHECK(cxx_results_long_errorcode32_to_values_and_errno(results32, 3, values32, errnos) == 2);
+  CHECK(values32[0] == 6 && values32[1] == 0 && values32[2] == 0);
+  CHECK(errnos[0] == 0 && errnos[1] == -EINVAL && errnos[2] == EAGAIN);
+
+  /* The batch agrees with CXX_RESULT_SET_ERRNO() one at a time */
+  cxx_results_int_errorcode_to_errno(results, 3, errnos);
+  for(n = 0; n < 3; n++)
+  {
+    errno = -1;
+    CXX_RESULT_SET_ERRNO(results[n]);
+    CHECK(errno == errnos[n]);
+  }
+
+  /* Empty batches write nothing */
+  CHECK(cxx_results_int_errorcode_to_errno(results, 0, NULL) == 0);
+
+  if(failures == 0)
+  {
+    printf("All tests passed\n");
+  }
+  return failures != 0;
+}
@@ -0,0 +1,85 @@
+/* Unit testing for catch_to_result
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/catch_to_result.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <string>
+
+namespace catch_to_result_test
+{
+  int parse(const std::string &s) { return std::stoi(s); }
+  void check_positive(int v)
+  {
+    if(v <= 0)
+    {
+      throw std::domain_error("not positive");
+    }
+  }
+  OUTCOME_V2_NAMESPACE::result<int> half(int v)
+  {
+    if(v % 2 != 0)
+    {
+      return std::make_error_code(std::errc::invalid_argument);
+    }
+    if(v > 1000)
+    {
+      throw std::overflow_error("too big");
+    }
+    return v / 2;
+  }
+  struct unknown_error
+  {
+  };
+}  // namespace catch_to_result_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / catch_to_result, "Tests that catch_to_result() turns thrown exceptions into results")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using namespace catch_to_result_test;
+  static_assert(noexcept(catch_to_result(parse, std::string())), "catch_to_result() is not noexcept!");
+  static_assert(std::is_same<decltype(catch_to_result(parse, std::string())), result<int>>::value, "a value is not returned as result<int>!");
+  static_assert(std::is_same<decltype(catch_to_result(check_positive, 1)), result<void>>::value, "void is not returned as result<void>!");
+  static_assert(std::is_same<decltype(catch_to_result(half, 1)), result<int>>::value, "a result is not returned as it is!");
+
+  BOOST_CHECK(catch_to_result(parse, std::string("42")).value() == 42);
+  BOOST_CHECK(catch_to_result(check_positive, 1).has_value());
+  BOOST_CHECK(catch_to_result(half, 8).value() == 4);
+#ifdef __cpp_exceptions
+  BOOST_CHECK(catch_to_result(parse, std::string("x")).error() == std::errc::invalid_argument);
+  BOOST_CHECK(catch_to_result(parse, std::string("99999999999999999999")).error() == std::errc::result_out_of_range);
+  BOOST_CHECK(catch_to_result(check_positive, -1).error() == std::errc::argument_out_of_domain);
+  BOOST_CHECK(catch_to_result(half, 7).error() == std::errc::invalid_argument);
+  BOOST_CHECK(catch_to_result(half, 2000).error() == std::errc::value_too_large);
+  BOOST_CHECK(catch_to_result([] { throw std::system_error(std::make_error_code(std::errc::timed_out)); }).error() == std::errc::timed_out);
+  BOOST_CHECK(catch_to_result([]() -> int { throw unknown_error(); }).error() == std::errc::resource_unavailable_try_again);
+
+  // The macro form
+  std::string s("17");
+  result<int> r = OUTCOME_CATCH_TO_RESULT(parse(s) + 1);
+  BOOST_CHECK(r.value() == 18);
+  s = "y";
+  r = OUTCOME_CATCH_TO_RESULT(parse(s) + 1);
+  BOOST_CHECK(r.error() == std::errc::invalid_argument);
+#endif
+}
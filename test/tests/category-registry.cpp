@@ -0,0 +1,120 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/category_registry.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace category_registry_test
+{
+  class named_category : public std::error_category
+  {
+    const char *_name;
+
+  public:
+    explicit named_category(const char *name)
+        : _name(name)
+    {
+    }
+    const char *name() const noexcept override { return _name; }
+    std::string message(int c) const override { return "code " + std::to_string(c); }
+  };
+}  // namespace category_registry_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / category_registry, "Tests that error categories have stable identifiers found in both directions")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using category_registry_test::named_category;
+
+  // Standard categories are registered with the hash of their names
+  BOOST_CHECK(error_category_id(std::generic_category()) == error_category_name_id(std::generic_category().name()));
+  BOOST_CHECK(find_error_category(error_category_id(std::system_category())) == &std::system_category());
+  BOOST_CHECK(find_error_category(0) == nullptr);
+  static_assert(error_category_name_id("") != 0, "identifiers are never zero");
+
+  // Unregistered categories are registered on first use
+  static named_category a("category_registry_test.a");
+  BOOST_CHECK(find_error_category(error_category_name_id(a.name())) == nullptr);
+  const uint32_t id = error_category_id(a);
+  BOOST_CHECK(id == error_category_name_id(a.name()));
+  BOOST_CHECK(find_error_category(id) == &a);
+  BOOST_CHECK(error_category_id(a) == id);
+
+  // Explicit identifiers, which cannot be changed once given
+  static named_category b("category_registry_test.b"), c("category_registry_test.c");
+  BOOST_CHECK(register_error_category(b, 78));
+  BOOST_CHECK(register_error_category(b, 78));
+  BOOST_CHECK(!register_error_category(b, 79));
+  BOOST_CHECK(!register_error_category(c, 78));
+  BOOST_CHECK(!register_error_category(c, 0));
+  BOOST_CHECK(error_category_id(b) == 78 && find_error_category(78) == &b);
+
+  // Another instance of a category of the same name shares its identifier
+  static named_category a2("category_registry_test.a");
+  BOOST_CHECK(error_category_id(a2) == id);
+  BOOST_CHECK(find_error_category(id) == &a);
+
+  // The C representation
+  cxx_portable_error_code p = to_portable_error_code(std::error_code(5, b));
+  BOOST_CHECK(p.code == 5 && p.category == 78);
+  std::error_code ec;
+  BOOST_CHECK(from_portable_error_code(ec, p) && ec == std::error_code(5, b));
+  p.category = 79;
+  BOOST_CHECK(!from_portable_error_code(ec, p) && ec == std::error_code(5, b));
+
+  // Concurrent first use and lookup agree
+  static std::vector<std::unique_ptr<named_category>> many;
+  static std::vector<std::string> names;
+  for(int n = 0; n < 64; n++)
+  {
+    names.push_back("category_registry_test.many." + std::to_string(n));
+  }
+  for(auto &name : names)
+  {
+    many.push_back(std::make_unique<named_category>(name.c_str()));
+  }
+  std::vector<std::thread> threads;
+  std::atomic<int> failures{0};
+  for(int t = 0; t < 4; t++)
+  {
+    threads.emplace_back([&] {
+      for(auto &cat : many)
+      {
+        const uint32_t v = error_category_id(*cat);
+        if(v == 0 || find_error_category(v) != cat.get())
+        {
+          ++failures;
+        }
+      }
+    });
+  }
+  for(auto &t : threads)
+  {
+    t.join();
+  }
+  BOOST_CHECK(failures == 0);
+}
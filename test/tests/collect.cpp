@@ -0,0 +1,79 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/collect.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <string>
+#include <vector>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / collect, "Tests that collecting many results into one works as intended")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  std::vector<result<std::string>> v;
+  for(int n = 0; n < 10; n++)
+  {
+    v.emplace_back(std::string(40, static_cast<char>('a' + n)));
+  }
+  // An all success batch gives every value, in order
+  auto a = collect(v);
+  BOOST_REQUIRE(a);
+  BOOST_CHECK(a.value().size() == 10);
+  BOOST_CHECK(a.value().capacity() == 10);
+  BOOST_CHECK(a.value()[9] == std::string(40, 'j'));
+  BOOST_CHECK(v[9].value() == std::string(40, 'j'));  // copied from an lvalue
+
+  v[2] = std::errc::invalid_argument;
+  v[7] = std::errc::no_such_file_or_directory;
+  auto b = collect(v);
+  BOOST_REQUIRE(!b);
+  BOOST_CHECK(b.error().size() == 2);
+  BOOST_CHECK(b.error().is_inline());
+  BOOST_CHECK(b.error()[0] == std::errc::invalid_argument);
+  BOOST_CHECK(b.error()[1] == std::errc::no_such_file_or_directory);
+
+  auto c = collect_all(std::move(v));
+  BOOST_CHECK(c.values.size() == 8);
+  BOOST_CHECK(c.values[2] == std::string(40, 'd'));
+  BOOST_CHECK(c.errors.size() == 2);
+  BOOST_CHECK(v[0].value().empty());  // moved from an rvalue
+
+  // error_list spills to the heap beyond its inline capacity
+  error_list<std::error_code, 2> e;
+  for(int n = 1; n <= 5; n++)
+  {
+    e.push_back(std::error_code(n, std::generic_category()));
+  }
+  BOOST_CHECK(!e.is_inline());
+  BOOST_CHECK(e.size() == 5);
+  BOOST_CHECK(e[4].value() == 5);
+  auto f(e);
+  BOOST_CHECK(f == e);
+  auto g(std::move(f));
+  BOOST_CHECK(g == e);
+  BOOST_CHECK(f.empty());
+  error_list<std::error_code, 2> h;
+  h.push_back(std::error_code(1, std::generic_category()));
+  h = e;
+  BOOST_CHECK(h == e);
+}
@@ -0,0 +1,79 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/outcome.hpp"
+#include "../../include/outcome/compact_error_code.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <future>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / compact_error_code, "Tests that compact_error_code works as intended")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  static_assert(sizeof(compact_error_code) == 4, "compact_error_code is not four bytes!");
+  static_assert(sizeof(result<int, compact_error_code>) == 8, "result<int, compact_error_code> does not fit into eight bytes!");
+  static_assert(trait::has_error_code_v<compact_error_code>, "compact_error_code does not have an error code!");
+  static_assert(std::is_trivially_copyable<result<int, compact_error_code>>::value, "result<int, compact_error_code> is not trivially copyable!");
+
+  // Round trips to and from std::error_code
+  compact_error_code a, b(make_error_code(std::errc::invalid_argument)), c(std::future_errc::broken_promise);
+  BOOST_CHECK(!a);
+  BOOST_CHECK(a == std::error_code());
+  BOOST_CHECK(b);
+  BOOST_CHECK(b.value() == EINVAL);
+  BOOST_CHECK(b.category() == std::generic_category());
+  BOOST_CHECK(b == std::errc::invalid_argument);
+  BOOST_CHECK(b != std::errc::no_such_file_or_directory);
+  BOOST_CHECK(c == std::error_code(std::future_errc::broken_promise));
+  BOOST_CHECK(c.category() == std::future_category());
+  BOOST_CHECK(c.message() == std::error_code(std::future_errc::broken_promise).message());
+  std::error_code ec = c;
+  BOOST_CHECK(ec == std::future_errc::broken_promise);
+  BOOST_CHECK(compact_error_code(std::error_code(-5, std::system_category())).value() == -5);
+
+  // Values which do not fit are reported as too large
+  compact_error_code d(std::error_code(1 << 24, std::system_category()));
+  BOOST_CHECK(d == std::errc::value_too_large);
+
+  // Works inside result
+  result<int, compact_error_code> e(5), f(std::errc::invalid_argument), g(c);
+  BOOST_CHECK(e.value() == 5);
+  BOOST_CHECK(f.error() == std::errc::invalid_argument);
+  BOOST_CHECK((f.__state().status() & detail::status_error_is_errno) != 0);
+  BOOST_CHECK(g.error() == std::future_errc::broken_promise);
+  BOOST_CHECK((g.__state().status() & detail::status_error_is_errno) == 0);
+#ifdef __cpp_exceptions
+  try
+  {
+    f.value();
+    BOOST_CHECK(false);
+  }
+  catch(const std::system_error &ex)
+  {
+    BOOST_CHECK(ex.code() == std::errc::invalid_argument);
+  }
+#endif
+  // Converts from a result with a std::error_code
+  result<int, compact_error_code> h(result<int>(std::errc::no_such_file_or_directory));
+  BOOST_CHECK(h.error() == std::errc::no_such_file_or_directory);
+}
@@ -0,0 +1,106 @@
+/* Unit testing for compact outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/compact_outcome.hpp"
+#include "../../include/outcome/try.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <memory>
+#include <string>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / compact_outcome, "Tests that compact outcomes share storage between the value, error and exception")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  static_assert(sizeof(compact_outcome<int>) < sizeof(outcome<int>), "compact_outcome<int> is not smaller than outcome<int>");
+  static_assert(sizeof(compact_outcome<int>) <= sizeof(std::error_code) + sizeof(void *), "compact_outcome<int> is larger than an error code and a word");
+  static_assert(sizeof(compact_outcome<std::string>) <= sizeof(std::string) + sizeof(void *), "compact_outcome<std::string> is larger than a string and a word");
+  static_assert(!std::is_default_constructible<compact_outcome<int>>::value, "compact_outcome is default constructible");
+  {
+    compact_outcome<std::string> a("hello");
+    BOOST_CHECK(a);
+    BOOST_CHECK(a.has_value());
+    BOOST_CHECK(!a.has_failure());
+    BOOST_CHECK(a.value() == "hello");
+    compact_outcome<std::string> b(std::errc::invalid_argument);
+    BOOST_CHECK(b.has_error());
+    BOOST_CHECK(!b.has_exception());
+    BOOST_CHECK(b.error() == std::errc::invalid_argument);
+    BOOST_CHECK_THROW(b.value(), std::system_error);
+    BOOST_CHECK_THROW(b.exception(), bad_outcome_access);
+    compact_outcome<std::string> c(std::make_exception_ptr(std::runtime_error("boom")));
+    BOOST_CHECK(c.has_exception());
+    BOOST_CHECK(!c.has_error());
+    BOOST_CHECK_THROW(c.value(), std::runtime_error);
+    BOOST_CHECK_THROW(c.error(), bad_outcome_access);
+
+    // Copying, moving and assigning between states
+    compact_outcome<std::string> d(a);
+    BOOST_CHECK(d == a);
+    d = c;
+    BOOST_CHECK(d.has_exception() && d == c);
+    d = std::move(b);
+    BOOST_CHECK(d.error() == std::errc::invalid_argument);
+    swap(a, d);
+    BOOST_CHECK(a.has_error());
+    BOOST_CHECK(d.value() == "hello");
+    BOOST_CHECK(a != d);
+  }
+  {
+    // Round trips through outcome
+    outcome<int> a(5), b(std::errc::not_enough_memory), c(std::make_exception_ptr(std::runtime_error("boom")));
+    compact_outcome<int> x(a), y(b), z(std::move(c));
+    BOOST_CHECK(x.value() == 5);
+    BOOST_CHECK(y.error() == std::errc::not_enough_memory);
+    BOOST_CHECK(z.has_exception());
+    BOOST_CHECK(x.as_outcome() == a);
+    BOOST_CHECK(y.as_outcome() == b);
+    BOOST_CHECK(std::move(z).as_outcome().has_exception());
+    // An outcome with both an error and an exception keeps the exception
+    outcome<int> both(failure(std::make_error_code(std::errc::io_error), std::make_exception_ptr(std::runtime_error("boom"))));
+    BOOST_REQUIRE(both.has_error() && both.has_exception());
+    compact_outcome<int> w(both);
+    BOOST_CHECK(w.has_exception());
+    BOOST_CHECK(!w.has_error());
+    BOOST_CHECK(w.exception() == both.exception());
+  }
+  {
+    // void values, move only values, type sugar and TRY
+    compact_outcome<void> a(success());
+    BOOST_CHECK(a.has_value());
+    a.value();
+    compact_outcome<void> b(failure(std::make_error_code(std::errc::io_error)));
+    BOOST_CHECK_THROW(b.value(), std::system_error);
+    BOOST_CHECK(b.as_outcome().error() == std::errc::io_error);
+    compact_outcome<std::unique_ptr<int>> c(std::make_unique<int>(5));
+    compact_outcome<std::unique_ptr<int>> d(std::move(c));
+    BOOST_CHECK(*d.value() == 5);
+    auto f = [](compact_outcome<int> v) -> compact_outcome<int> {
+      OUTCOME_TRY(i, v);
+      return i + 1;
+    };
+    BOOST_CHECK(f(5).value() == 6);
+    BOOST_CHECK(f(std::errc::io_error).error() == std::errc::io_error);
+    BOOST_CHECK(f(std::make_exception_ptr(std::runtime_error("boom"))).has_exception());
+  }
+}
@@ -0,0 +1,61 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_ENABLE_COMPACT_STATUS
+#define OUTCOME_ENABLE_COMPACT_STATUS
+#endif
+#include "../../include/outcome/iostream_support.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / compact - status, "Tests that result with an eight bit status works as intended")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  static_assert(sizeof(detail::status_bitfield_type) == 1, "status is not eight bits!");
+  static_assert(sizeof(result<uint32_t, uint16_t>) == 8, "result<uint32_t, uint16_t> does not fit into eight bytes!");
+  static_assert(sizeof(result<uint16_t, uint16_t, policy::all_narrow>) <= 6, "result<uint16_t, uint16_t> is bigger than six bytes!");
+  static_assert(sizeof(result<void, int>) == 8, "result<void, int> does not fit into eight bytes!");
+
+  result<uint32_t, uint16_t> a(in_place_type<uint32_t>, 5U), b(in_place_type<uint16_t>, uint16_t(6));
+  BOOST_CHECK(a.has_value());
+  BOOST_CHECK(a.value() == 5U);
+  BOOST_CHECK(b.has_error());
+  BOOST_CHECK(b.error() == 6);
+  BOOST_CHECK(hooks::spare_storage(&a) == 0);
+
+  result<int> c(std::errc::invalid_argument);
+  BOOST_CHECK(c.has_error());
+  BOOST_CHECK((c.__state().status() & detail::status_error_is_errno) != 0);
+
+  outcome<int> d(std::make_exception_ptr(5));
+  BOOST_CHECK(d.has_exception());
+  BOOST_CHECK(!d.has_error());
+
+  // The status still serialises as a number, not a character
+  std::stringstream s;
+  s << a;
+  BOOST_CHECK(s.str() == "1 5");
+  result<uint32_t, uint16_t> e(in_place_type<uint32_t>, 0U);
+  s.seekg(0);
+  s >> e;
+  BOOST_CHECK(e == a);
+}
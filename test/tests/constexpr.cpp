@@ -24,6 +24,70 @@ Distributed under the Boost Software License, Version 1.0.
 #include "../../include/outcome/outcome.hpp"
 #include "quickcpplib/include/boost/test/unit_test.hpp"
 
+#ifdef OUTCOME_HAVE_CONSTEXPR20_STORAGE
+namespace constexpr_test
+{
+  // Not trivially copyable nor destructible, so stored in the non-trivial storage
+  struct nontrivial
+  {
+    int v;
+    constexpr explicit nontrivial(int x)
+        : v(x)
+    {
+    }
+    constexpr nontrivial(const nontrivial &o)
+        : v(o.v)
+    {
+    }
+    constexpr nontrivial &operator=(const nontrivial &o)
+    {
+      v = o.v;
+      return *this;
+    }
+    constexpr ~nontrivial() {}  // NOLINT
+  };
+  using result_type = OUTCOME_V2_NAMESPACE::result<nontrivial, int, OUTCOME_V2_NAMESPACE::policy::all_narrow>;
+  using outcome_type = OUTCOME_V2_NAMESPACE::outcome<nontrivial, int, void, OUTCOME_V2_NAMESPACE::policy::all_narrow>;
+
+  // A lookup table of results built during constant evaluation
+  struct table
+  {
+    int values[8]{};
+  };
+  constexpr result_type lookup(int n)
+  {
+    if(n % 3 == 0)
+    {
+      return OUTCOME_V2_NAMESPACE::failure(n);
+    }
+    return nontrivial(n * n);
+  }
+  constexpr table make_table()
+  {
+    table ret;
+    result_type prev = lookup(1);
+    for(int n = 0; n < 8; n++)
+    {
+      result_type r = lookup(n);
+      result_type copy(r);
+      copy.swap(prev);
+      prev = r;
+      ret.values[n] = r.has_value() ? r.value().v : -r.error();
+    }
+    return ret;
+  }
+  constexpr int outcome_roundtrip()
+  {
+    outcome_type a(OUTCOME_V2_NAMESPACE::in_place_type<nontrivial>, 5);
+    outcome_type b(a);
+    outcome_type c(OUTCOME_V2_NAMESPACE::in_place_type<int>, 2);
+    c = b;
+    b = outcome_type(OUTCOME_V2_NAMESPACE::in_place_type<int>, 3);
+    return a.value().v + c.value().v + b.error();
+  }
+}  // namespace constexpr_test
+#endif
+
 BOOST_OUTCOME_AUTO_TEST_CASE(works / outcome / constexpr, "Tests that outcome works as intended in a constexpr evaluation context")
 {
   using namespace OUTCOME_V2_NAMESPACE;
@@ -86,4 +150,15 @@ BOOST_OUTCOME_AUTO_TEST_CASE(works / outcome / constexpr, "Tests that outcome wo
     constexpr outcome<int, void, char *> g5(in_place_type<void>);
     constexpr outcome<long, int, const char *> g6(g5);
   }
+#ifdef OUTCOME_HAVE_CONSTEXPR20_STORAGE
+  {
+    // Test results and outcomes of non-trivial types work in constant evaluation on C++ 20
+    constexpr constexpr_test::table t = constexpr_test::make_table();
+    static_assert(t.values[0] == 0, "");
+    static_assert(t.values[2] == 4, "");
+    static_assert(t.values[3] == -3, "");
+    static_assert(t.values[7] == 49, "");
+    static_assert(constexpr_test::outcome_roundtrip() == 13, "");
+  }
+#endif
 }
@@ -0,0 +1,68 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/copy_accounting.hpp"
+#include "../../include/outcome/result.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <cstring>
+#include <string>
+
+namespace copy_accounting_test
+{
+  namespace outcome = OUTCOME_V2_NAMESPACE;
+  template <class T> using result = outcome::result<T, std::error_code, outcome::policy::with_hooks<outcome::policy::default_policy<T, std::error_code, void>, outcome::policy::copy_accounting>>;
+  struct big
+  {
+    std::string text;
+  };
+}  // namespace copy_accounting_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / copy_accounting, "Tests that the copy accounting hook policy counts copies per type")
+{
+  using namespace copy_accounting_test;
+  {
+    result<big> a(big{"hello"});
+    result<big> b(a), c(a);
+    result<big> d(std::move(b));
+    c = d;
+    d = std::move(c);
+    result<int> e(5), f(e);
+    (void) f;
+  }
+  const outcome::copy_account &big_account = outcome::copy_account_of<big>();
+  BOOST_CHECK(big_account.copy_constructions == 2);
+  BOOST_CHECK(big_account.move_constructions == 1);
+  BOOST_CHECK(big_account.copy_assignments == 1);
+  BOOST_CHECK(big_account.move_assignments == 1);
+  BOOST_CHECK(big_account.destructions == 4);
+  BOOST_CHECK(strstr(big_account.type, "big") != nullptr);
+
+  // The most copied type comes first
+  auto accounts = outcome::copy_accounts();
+  BOOST_REQUIRE(accounts.size() == 2);
+  BOOST_CHECK(accounts[0].type == big_account.type);
+  BOOST_CHECK(accounts[0].copies() == 3);
+  BOOST_CHECK(accounts[1].copies() == 1);
+  BOOST_CHECK(accounts[1].destructions == 2);
+}
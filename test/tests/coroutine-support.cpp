@@ -0,0 +1,197 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/coroutine_support.hpp"
+#include "../../include/outcome/outcome.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <string>
+#include <vector>
+
+#ifdef OUTCOME_HAVE_COROUTINE_SUPPORT
+namespace coroutine_support_test
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  static int steps;
+  inline result<int> checked(int x)
+  {
+    if(x < 0)
+    {
+      return std::errc::invalid_argument;
+    }
+    return x;
+  }
+  inline awaitables::lazy<result<int>> leaf(int x)
+  {
+    ++steps;
+    int v = co_await checked(x);
+    ++steps;
+    co_return v * 2;
+  }
+  // Awaiting a task gives its result, awaiting that result unwraps it
+  inline awaitables::lazy<result<long>> chain(int depth, int x)
+  {
+    if(depth == 0)
+    {
+      co_return co_await co_await leaf(x);
+    }
+    long v = co_await co_await chain(depth - 1, x);
+    co_return v + 1;
+  }
+  inline awaitables::eager<outcome<int>> eager_leaf(int x)
+  {
+    ++steps;
+    int v = co_await checked(x);
+    co_return v;
+  }
+  inline result<std::string> parse(int n)
+  {
+    if(n == 3)
+    {
+      return std::errc::bad_message;
+    }
+    return std::string(40, static_cast<char>('a' + n));
+  }
+  inline awaitables::generator<result<std::string>> records(int count)
+  {
+    for(int n = 0; n < count; n++)
+    {
+      co_yield parse(n);
+    }
+  }
+  inline awaitables::generator<result<int>> lengths(int count)
+  {
+    for(int n = 0; n < count; n++)
+    {
+      std::string s = co_await parse(n);
+      co_yield static_cast<int>(s.size());
+    }
+  }
+    struct counting_allocator final : awaitables::frame_allocator
+  {
+    int allocations{0}, deallocations{0};
+    void *allocate(size_t bytes) override
+    {
+      ++allocations;
+      return ::operator new(bytes);
+    }
+    void deallocate(void *p, size_t /*unused*/) noexcept override
+    {
+      ++deallocations;
+      ::operator delete(p);
+    }
+  };
+}  // namespace coroutine_support_test
+#endif
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / coroutine_support, "Tests that co_await on results within the coroutine task types works as intended")
+{
+#ifdef OUTCOME_HAVE_COROUTINE_SUPPORT
+  using namespace coroutine_support_test;
+  // Lazy tasks do not run until awaited
+  steps = 0;
+  auto t = leaf(5);
+  BOOST_CHECK(steps == 0);
+  BOOST_CHECK(!t.ready());
+  BOOST_CHECK(std::move(t).get().value() == 10);
+  BOOST_CHECK(steps == 2);
+
+  // A failure short circuits the coroutine without throwing
+  steps = 0;
+  auto f = leaf(-1).get();
+  BOOST_CHECK(steps == 1);
+  BOOST_REQUIRE(f.has_error());
+  BOOST_CHECK(f.error() == std::errc::invalid_argument);
+
+  // Deep chains resume each other by symmetric transfer
+  BOOST_CHECK(chain(10000, 5).get().value() == 10010);
+  auto g = chain(10000, -1).get();
+  BOOST_REQUIRE(g.has_error());
+  BOOST_CHECK(g.error() == std::errc::invalid_argument);
+
+  // Eager tasks run immediately
+  steps = 0;
+  auto e = eager_leaf(-1);
+  BOOST_CHECK(steps == 1);
+  BOOST_CHECK(e.ready());
+  BOOST_CHECK(std::move(e).get().error() == std::errc::invalid_argument);
+  BOOST_CHECK(eager_leaf(3).get().value() == 3);
+
+  // Generators yield values until the first failure, which ends them
+  {
+    std::vector<std::string> got;
+    auto g = records(3);
+    for(auto &&s : g)
+    {
+      got.push_back(std::move(s));
+    }
+    BOOST_CHECK(got.size() == 3);
+    BOOST_CHECK(got[2] == std::string(40, 'c'));
+    BOOST_REQUIRE(g.finished());
+    BOOST_CHECK(g.terminal().has_value());
+  }
+  {
+    std::vector<std::string> got;
+    auto g = records(10);
+    for(auto it = g.begin(); it != g.end(); ++it)
+    {
+      got.push_back(*it);
+    }
+    BOOST_CHECK(got.size() == 3);
+    BOOST_CHECK(g.terminal().has_error());
+    BOOST_CHECK(g.terminal().error() == std::errc::bad_message);
+  }
+  {
+    int total = 0;
+    auto g = lengths(10);
+    for(int l : g)
+    {
+      total += l;
+    }
+    BOOST_CHECK(total == 120);
+    BOOST_CHECK(g.terminal().error() == std::errc::bad_message);
+  }
+
+  // Frames come from the allocator current when they are created, and go back to it
+  counting_allocator counter;
+  {
+    auto x = [&] {
+      awaitables::frame_allocator_scope scope(counter);
+      BOOST_CHECK(awaitables::current_frame_allocator() == &counter);
+      return chain(3, 5);
+    }();
+    BOOST_CHECK(awaitables::current_frame_allocator() == nullptr);
+    BOOST_CHECK(counter.allocations == 1);
+    BOOST_CHECK(std::move(x).get().value() == 13);
+  }
+  BOOST_CHECK(counter.deallocations == 1);
+  {
+    awaitables::frame_pool pool;
+    awaitables::frame_allocator_scope scope(pool);
+    for(int n = 0; n < 100; n++)
+    {
+      BOOST_CHECK(chain(10, n).get().value() == n * 2 + 10);
+    }
+  }
+#endif
+}
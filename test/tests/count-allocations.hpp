@@ -0,0 +1,120 @@
+/* Counts every heap allocation made by a unit test program
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_TEST_COUNT_ALLOCATIONS_HPP
+#define OUTCOME_TEST_COUNT_ALLOCATIONS_HPP
+
+#include "quickcpplib/include/config.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+/* Replaces every global allocation and deallocation function, so include this into only one source
+of a program. Each allocation adds one to `allocations`. They are kept out of line, so that the
+compiler never sees malloc() pairing with a deallocation function it has not inlined. Built both
+with and without C++ exceptions, so failing to allocate aborts.
+*/
+static size_t allocations;
+
+namespace count_allocations
+{
+  inline void *allocate(size_t bytes)
+  {
+    ++allocations;
+    if(void *ret = malloc(bytes != 0 ? bytes : 1))
+    {
+      return ret;
+    }
+    abort();
+  }
+  // The address malloc() returned is kept in the word before the aligned block
+  inline void *allocate_aligned(size_t bytes, size_t align)
+  {
+    void *p = allocate(bytes + align + sizeof(void *));
+    const uintptr_t ret = (reinterpret_cast<uintptr_t>(p) + sizeof(void *) + align - 1) & ~(static_cast<uintptr_t>(align) - 1);
+    reinterpret_cast<void **>(ret)[-1] = p;
+    return reinterpret_cast<void *>(ret);
+  }
+  inline void deallocate_aligned(void *p) noexcept
+  {
+    if(p != nullptr)
+    {
+      free(reinterpret_cast<void **>(p)[-1]);
+    }
+  }
+}  // namespace count_allocations
+
+QUICKCPPLIB_NOINLINE void *operator new(size_t bytes)
+{
+  return count_allocations::allocate(bytes);
+}
+QUICKCPPLIB_NOINLINE void *operator new[](size_t bytes)
+{
+  return count_allocations::allocate(bytes);
+}
+QUICKCPPLIB_NOINLINE void operator delete(void *p) noexcept
+{
+  free(p);
+}
+QUICKCPPLIB_NOINLINE void operator delete[](void *p) noexcept
+{
+  free(p);
+}
+QUICKCPPLIB_NOINLINE void operator delete(void *p, size_t /*unused*/) noexcept
+{
+  free(p);
+}
+QUICKCPPLIB_NOINLINE void operator delete[](void *p, size_t /*unused*/) noexcept
+{
+  free(p);
+}
+#ifdef __cpp_aligned_new
+QUICKCPPLIB_NOINLINE void *operator new(size_t bytes, std::align_val_t align)
+{
+  return count_allocations::allocate_aligned(bytes, static_cast<size_t>(align));
+}
+QUICKCPPLIB_NOINLINE void *operator new[](size_t bytes, std::align_val_t align)
+{
+  return count_allocations::allocate_aligned(bytes, static_cast<size_t>(align));
+}
+QUICKCPPLIB_NOINLINE void operator delete(void *p, std::align_val_t /*unused*/) noexcept
+{
+  count_allocations::deallocate_aligned(p);
+}
+QUICKCPPLIB_NOINLINE void operator delete[](void *p, std::align_val_t /*unused*/) noexcept
+{
+  count_allocations::deallocate_aligned(p);
+}
+QUICKCPPLIB_NOINLINE void operator delete(void *p, size_t /*unused*/, std::align_val_t /*unused*/) noexcept
+{
+  count_allocations::deallocate_aligned(p);
+}
+QUICKCPPLIB_NOINLINE void operator delete[](void *p, size_t /*unused*/, std::align_val_t /*unused*/) noexcept
+{
+  count_allocations::deallocate_aligned(p);
+}
+#endif
+
+#endif
@@ -0,0 +1,179 @@
+/* Unit testing for copy on write error payloads
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/cow_error.hpp"
+#include "../../include/outcome/payload_error.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <thread>
+#include <vector>
+
+namespace cow_error_test
+{
+  static int copies;
+  struct big_payload
+  {
+    std::error_code ec;
+    char detail[1024]{};
+
+    big_payload(std::error_code _ec)  // NOLINT
+        : ec(_ec)
+    {
+    }
+    big_payload(const big_payload &o)
+        : ec(o.ec)
+    {
+      ++copies;
+      memcpy(detail, o.detail, sizeof(detail));
+    }
+    big_payload(big_payload &&) = default;
+    big_payload &operator=(const big_payload &) = default;
+    big_payload &operator=(big_payload &&) = default;
+    ~big_payload() = default;
+    friend bool operator==(const big_payload &a, const big_payload &b) noexcept { return a.ec == b.ec && memcmp(a.detail, b.detail, sizeof(a.detail)) == 0; }
+  };
+  inline std::error_code make_error_code(const big_payload &p) noexcept { return p.ec; }
+}  // namespace cow_error_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / cow_error, "Tests that copy on write error payloads are shared until mutated")
+{
+  using namespace cow_error_test;
+  using OUTCOME_V2_NAMESPACE::cow_error;
+  using OUTCOME_V2_NAMESPACE::outcome;
+  using OUTCOME_V2_NAMESPACE::result;
+  using OUTCOME_V2_NAMESPACE::shared_cow_error;
+  static_assert(OUTCOME_V2_NAMESPACE::trait::has_error_code_v<cow_error<big_payload>>, "");
+  static_assert(OUTCOME_V2_NAMESPACE::trait::has_error_code_v<cow_error<std::error_code>>, "");
+  static_assert(OUTCOME_V2_NAMESPACE::trait::has_exception_ptr_v<cow_error<std::exception_ptr>>, "");
+  static_assert(OUTCOME_V2_NAMESPACE::trait::is_move_bitcopying<cow_error<big_payload>>::value, "");
+  static_assert(sizeof(cow_error<big_payload>) == sizeof(void *), "");
+
+  // Fan out shares the one payload
+  {
+    copies = 0;
+    outcome<int, cow_error<big_payload>> failed(big_payload(make_error_code(std::errc::timed_out)));
+    std::vector<outcome<int, cow_error<big_payload>>> subscribers(100, failed);
+    BOOST_CHECK(copies == 0);
+    BOOST_CHECK(failed.error().use_count() == 101);
+    for(auto &s : subscribers)
+    {
+      BOOST_CHECK(s.error().get() == failed.error().get());
+      BOOST_CHECK(s.error() == failed.error());
+    }
+    BOOST_CHECK(make_error_code(subscribers[7].error()) == std::errc::timed_out);
+    // The default policy is the same as for the payload
+    try
+    {
+      (void) subscribers[3].value();
+      BOOST_CHECK(false);
+    }
+    catch(const std::system_error &e)
+    {
+      BOOST_CHECK(e.code() == std::errc::timed_out);
+    }
+
+    // Mutation detaches only the holder mutated
+    auto &mine = subscribers[0].error();
+    mine.mutate().detail[0] = 'x';
+    BOOST_CHECK(copies == 1);
+    BOOST_CHECK(mine.use_count() == 1);
+    BOOST_CHECK(failed.error().use_count() == 100);
+    BOOST_CHECK(failed.error()->detail[0] == 0);
+    BOOST_CHECK(mine != failed.error());
+    // Mutating a payload held only once does not copy it
+    mine.mutate().detail[1] = 'y';
+    BOOST_CHECK(copies == 1);
+    subscribers.clear();
+    BOOST_CHECK(failed.error().use_count() == 1);
+  }
+
+  // Holders of plain error codes and of payload errors work as those do
+  {
+    result<int, cow_error<std::error_code>> r(make_error_code(std::errc::invalid_argument));
+    BOOST_CHECK(r.has_error());
+    BOOST_CHECK(*r.error() == std::errc::invalid_argument);
+    try
+    {
+      (void) r.value();
+      BOOST_CHECK(false);
+    }
+    catch(const std::system_error &e)
+    {
+      BOOST_CHECK(e.code() == std::errc::invalid_argument);
+    }
+    using payload = OUTCOME_V2_NAMESPACE::payload_error<>;
+    result<int, cow_error<payload>> p(payload(make_error_code(std::errc::permission_denied), "/etc/shadow"));
+    try
+    {
+      (void) p.value();
+      BOOST_CHECK(false);
+    }
+    catch(const std::system_error &e)
+    {
+      BOOST_CHECK(e.code() == std::errc::permission_denied);
+      BOOST_CHECK(strstr(e.what(), "/etc/shadow") != nullptr);
+    }
+    cow_error<std::error_code> empty;
+    BOOST_CHECK(!empty);
+    BOOST_CHECK(empty.use_count() == 0);
+    BOOST_CHECK(!make_error_code(empty));
+  }
+
+  // As the exception type of an outcome
+  {
+    outcome<int, std::error_code, cow_error<std::exception_ptr>> o(cow_error<std::exception_ptr>(std::make_exception_ptr(std::runtime_error("boom"))));
+    auto o2 = o;
+    BOOST_CHECK(o2.exception().use_count() == 2);
+    try
+    {
+      (void) o2.value();
+      BOOST_CHECK(false);
+    }
+    catch(const std::runtime_error &e)
+    {
+      BOOST_CHECK(strcmp(e.what(), "boom") == 0);
+    }
+  }
+
+  // The thread safe flavour can be copied and destroyed concurrently
+  {
+    shared_cow_error<big_payload> shared(big_payload(make_error_code(std::errc::io_error)));
+    std::vector<std::thread> threads;
+    for(int n = 0; n < 4; n++)
+    {
+      threads.emplace_back([shared] {
+        for(int i = 0; i < 10000; i++)
+        {
+          shared_cow_error<big_payload> copy(shared);
+          (void) copy;
+        }
+      });
+    }
+    for(auto &t : threads)
+    {
+      t.join();
+    }
+    BOOST_CHECK(shared.use_count() == 1);
+  }
+}
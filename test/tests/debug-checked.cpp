@@ -0,0 +1,61 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <csignal>
+
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / debug_checked, "Tests that the debug checked policy aborts on bad wide accesses when checking")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  result<int, std::error_code, policy::debug_checked> a(5), b(std::make_error_code(std::errc::invalid_argument));
+  BOOST_CHECK(a.value() == 5);
+  BOOST_CHECK(b.error() == std::errc::invalid_argument);
+  outcome<int, std::error_code, std::exception_ptr, policy::debug_checked> c(5);
+  BOOST_CHECK(c.value() == 5);
+#if OUTCOME_DEBUG_CHECKED && (defined(__unix__) || defined(__APPLE__))
+  // Each bad access must abort the process
+  auto aborts = [](auto &&f) {
+    pid_t pid = fork();
+    if(pid == 0)
+    {
+      fclose(stderr);
+      f();
+      _exit(0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT;
+  };
+  BOOST_CHECK(aborts([&] { (void) b.value(); }));
+  BOOST_CHECK(aborts([&] { (void) a.error(); }));
+  BOOST_CHECK(aborts([&] { (void) c.exception(); }));
+  BOOST_CHECK(!aborts([&] { (void) a.value(); }));
+#endif
+}
@@ -0,0 +1,82 @@
+/* Unit testing for device_result
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/result_lite.hpp"
+#include "../../include/outcome/device_result.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <cstring>
+
+namespace device_result_test
+{
+  enum class kernel_error : int
+  {
+    negative = 1,
+    overflow
+  };
+  // Written as a kernel would call it, so built for the device when compiled by nvcc or hipcc
+  OUTCOME_HOST_DEVICE inline OUTCOME_V2_NAMESPACE::device_result<int, kernel_error> checked_square(int x)
+  {
+    if(x < 0)
+    {
+      return kernel_error::negative;
+    }
+    if(x > 46340)
+    {
+      return kernel_error::overflow;
+    }
+    return x * x;
+  }
+  OUTCOME_HOST_DEVICE inline OUTCOME_V2_NAMESPACE::device_result<int, kernel_error> sum_of_squares(int x, int y)
+  {
+    OUTCOME_TRY(a, checked_square(x));
+    OUTCOME_TRY(b, checked_square(y));
+    return a + b;
+  }
+}  // namespace device_result_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / device_result, "Tests that device_result is trivially copyable and usable through host device functions")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using namespace device_result_test;
+  using dr = device_result<int, kernel_error>;
+  static_assert(std::is_same<dr, result<int, kernel_error, policy::terminate>>::value, "device_result is not a result!");
+  static_assert(std::is_trivially_copyable<dr>::value, "device_result is not trivially copyable!");
+  static_assert(std::is_trivially_copyable<device_result<void, unsigned>>::value, "device_result<void> is not trivially copyable!");
+  static_assert(trait::is_device_error<unsigned char>::value && !trait::is_device_error<float>::value, "is_device_error is wrong!");
+
+  BOOST_CHECK(sum_of_squares(3, 4).value() == 25);
+  BOOST_CHECK(sum_of_squares(-3, 4).error() == kernel_error::negative);
+  BOOST_CHECK(sum_of_squares(3, 50000).error() == kernel_error::overflow);
+
+  // As if copied back from device memory, the bytes are the results
+  dr device[3] = {checked_square(2), checked_square(-2), checked_square(100000)};
+  alignas(dr) unsigned char bytes[sizeof(device)];
+  memcpy(bytes, device, sizeof(device));
+  dr host[3] = {dr(0), dr(0), dr(0)};
+  memcpy(host, bytes, sizeof(host));
+  BOOST_CHECK(host[0].value() == 4);
+  BOOST_CHECK(host[1].error() == kernel_error::negative);
+  BOOST_CHECK(host[2].error() == kernel_error::overflow);
+  BOOST_CHECK(host[0] == device[0]);
+}
@@ -0,0 +1,145 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/outcome.hpp"
+#include "../../include/outcome/outcome.hpp"
+#include "../../include/outcome/iostream_support.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <array>
+
+namespace disjoint_storage_test
+{
+  using buffer = std::array<char, 64>;
+  struct error_info
+  {
+    int code;
+    const char *message;
+  };
+  inline bool operator==(const error_info &a, const error_info &b) noexcept { return a.code == b.code; }
+  inline bool operator!=(const error_info &a, const error_info &b) noexcept { return a.code != b.code; }
+}  // namespace disjoint_storage_test
+
+OUTCOME_V2_NAMESPACE_BEGIN
+namespace trait
+{
+  template <> struct disjoint_storage<disjoint_storage_test::buffer, std::error_code>
+  {
+    static constexpr bool value = true;
+  };
+  template <> struct disjoint_storage<uint64_t, disjoint_storage_test::error_info>
+  {
+    static constexpr bool value = true;
+  };
+  template <> struct disjoint_storage<uint64_t, uint32_t>
+  {
+    static constexpr bool value = true;
+  };
+}  // namespace trait
+OUTCOME_V2_NAMESPACE_END
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / disjoint, "Tests that result with the disjoint storage layout works as intended")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using disjoint_storage_test::buffer;
+  using disjoint_storage_test::error_info;
+
+  // The value and the error overlap
+  static_assert(sizeof(result<buffer, std::error_code>) == sizeof(buffer) + 8, "result<buffer, error_code> is not disjoint!");
+  static_assert(sizeof(result<uint64_t, error_info>) == sizeof(error_info) + 8, "result<uint64_t, error_info> is not disjoint!");
+  static_assert(sizeof(result<uint64_t, std::error_code>) == 8 + sizeof(std::error_code) + 8, "result<uint64_t, error_code> should not be disjoint!");
+  static_assert(std::is_trivially_copyable<result<uint64_t, error_info>>::value, "result<uint64_t, error_info> is not trivially copyable!");
+
+  buffer buf{};
+  buf[0] = 'x';
+  result<buffer, std::error_code> a(buf), b(std::errc::invalid_argument);
+  BOOST_CHECK(a.has_value());
+  BOOST_CHECK(!a.has_error());
+  BOOST_CHECK(a.value()[0] == 'x');
+  BOOST_CHECK(!b.has_value());
+  BOOST_CHECK(b.has_error());
+  BOOST_CHECK(b.error() == std::errc::invalid_argument);
+  // errno detection is preserved
+  BOOST_CHECK((b.__state().status() & detail::status_error_is_errno) != 0);
+#ifdef __cpp_exceptions
+  try
+  {
+    b.value();
+    BOOST_CHECK(false);
+  }
+  catch(const std::system_error &e)
+  {
+    BOOST_CHECK(e.code() == std::errc::invalid_argument);
+  }
+#endif
+
+  // Comparison, copy, assignment and swap
+  using buffer_result = result<buffer, std::error_code>;
+  BOOST_CHECK(a != b);
+  BOOST_CHECK(a == buffer_result(buf));
+  BOOST_CHECK(b == buffer_result(std::errc::invalid_argument));
+  BOOST_CHECK(b == failure(make_error_code(std::errc::invalid_argument)));
+  BOOST_CHECK(a != failure(make_error_code(std::errc::invalid_argument)));
+  auto c(a);
+  BOOST_CHECK(c.value()[0] == 'x');
+  c = b;
+  BOOST_CHECK(c.error() == std::errc::invalid_argument);
+  c = a;
+  BOOST_CHECK(c.value()[0] == 'x');
+
+  // Custom error types
+  result<uint64_t, error_info> d(5U), e(error_info{3, "three"});
+  BOOST_CHECK(d.value() == 5U);
+  BOOST_CHECK(e.error().code == 3);
+  BOOST_CHECK(e == failure(error_info{3, nullptr}));
+  using std::swap;
+  swap(d, e);
+  BOOST_CHECK(d.error().code == 3);
+  BOOST_CHECK(e.value() == 5U);
+  swap(d, e);
+
+  // Conversion between disjoint and separate layouts
+  result<uint64_t, error_info> f(d);
+  auto g = result<int64_t, error_info>(e);
+  BOOST_CHECK(g.error().code == 3);
+  result<uint64_t, error_info> h(g);
+  BOOST_CHECK(h.error().code == 3);
+  result<uint64_t, error_info> i(result<uint32_t, error_info>(7U));
+  BOOST_CHECK(i.value() == 7U);
+  BOOST_CHECK(f == d);
+
+  // Serialisation
+  std::stringstream ss;
+  ss << result<uint64_t, uint32_t>(in_place_type<uint64_t>, 5U) << " " << result<uint64_t, uint32_t>(in_place_type<uint32_t>, 6U);
+  result<uint64_t, uint32_t> j(in_place_type<uint64_t>), j2(in_place_type<uint64_t>);
+  ss >> j >> j2;
+  BOOST_CHECK(j.value() == 5U);
+  BOOST_CHECK(j2.error() == 6U);
+
+  // outcome can additionally store exceptions
+  outcome<buffer> k(std::make_exception_ptr(5)), l(buf), m(std::errc::invalid_argument);
+  BOOST_CHECK(k.has_exception());
+  BOOST_CHECK(!k.has_error());
+  BOOST_CHECK(l.value()[0] == 'x');
+  BOOST_CHECK(m.error() == std::errc::invalid_argument);
+}
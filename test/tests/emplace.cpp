@@ -0,0 +1,134 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/outcome.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <string>
+#include <vector>
+
+namespace emplace_test
+{
+  struct throws_on_construction
+  {
+    explicit throws_on_construction(bool fail)
+    {
+      if(fail)
+      {
+        throw std::runtime_error("failed");
+      }
+    }
+  };
+}  // namespace emplace_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / emplace, "Tests that result can emplace a value or an error in place")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  {
+    // A value reused between iterations keeps its capacity
+    result<std::vector<int>> a(std::make_error_code(std::errc::invalid_argument));
+    std::vector<int> &v = a.value_mut_or_emplace();
+    BOOST_CHECK(a.has_value());
+    BOOST_CHECK(v.empty());
+    v.reserve(100);
+    const int *data = v.data();
+    for(int n = 0; n < 10; n++)
+    {
+      auto &w = a.value_mut_or_emplace(5, 5);
+      w.clear();
+      w.push_back(n);
+      BOOST_CHECK(w.data() == data);
+    }
+    BOOST_CHECK(a.value().size() == 1);
+    BOOST_CHECK(a.value().capacity() >= 100);
+
+    // emplace() replaces the value
+    std::vector<int> &x = a.emplace(3, 7);
+    BOOST_CHECK(x.size() == 3);
+    BOOST_CHECK(a.value()[2] == 7);
+
+    // emplace_error() replaces the value with an error
+    a.emplace_error(std::make_error_code(std::errc::invalid_argument));
+    BOOST_CHECK(a.has_error());
+    BOOST_CHECK(a.error() == std::errc::invalid_argument);
+
+    a.emplace(1, 1);
+    BOOST_CHECK(a.has_value());
+    BOOST_CHECK(!a.has_error());
+
+    a.reset();
+    BOOST_CHECK(a.has_value());
+    BOOST_CHECK(a.value().empty());
+  }
+  {
+    // Trivially copyable values, void values and void errors
+    result<int> b(5);
+    BOOST_CHECK(b.emplace(6) == 6);
+    b.emplace_error(std::make_error_code(std::errc::invalid_argument));
+    BOOST_CHECK(b.error() == std::errc::invalid_argument);
+    BOOST_CHECK((b.__state().status() & detail::status_error_is_errno) != 0);
+    BOOST_CHECK(b.value_mut_or_emplace(7) == 7);
+    BOOST_CHECK(b.value_mut_or_emplace(8) == 7);
+
+    result<void, std::string> c(success());
+    c.emplace_error(3, 'x');
+    BOOST_CHECK(c.error() == "xxx");
+    c.emplace();
+    BOOST_CHECK(c.has_value());
+    BOOST_CHECK(!c.has_error());
+
+    result<std::string, void> d("hello");
+    d.emplace_error();
+    BOOST_CHECK(d.has_error());
+    BOOST_CHECK(d.value_mut_or_emplace("world") == "world");
+  }
+  {
+    // Reference values rebind
+    int x = 5, y = 6;
+    result<int &> e(x);
+    e.emplace(y);
+    BOOST_CHECK(&e.value() == &y);
+  }
+#ifndef OUTCOME_ENABLE_COMPACT_STATUS
+  {
+    // The spare storage is cleared, as it would be by assigning a new result
+    result<int> f(std::errc::invalid_argument);
+    hooks::set_spare_storage(&f, 78);
+    f.emplace(5);
+    BOOST_CHECK(hooks::spare_storage(&f) == 0);
+  }
+#endif
+#ifdef __cpp_exceptions
+  {
+    // A throwing value leaves behind any previous error, but no value
+    using emplace_test::throws_on_construction;
+    result<throws_on_construction> g(std::errc::invalid_argument);
+    BOOST_CHECK_THROW(g.emplace(true), std::runtime_error);
+    BOOST_CHECK(!g.has_value());
+    BOOST_CHECK(g.error() == std::errc::invalid_argument);
+    g.emplace(false);
+    BOOST_CHECK(g.has_value());
+  }
+#endif
+}
@@ -0,0 +1,83 @@
+/* Unit testing for detecting errors whose codes are errno values
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+namespace errno_detection_test
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  template <class R> inline bool is_errno(const R &r) { return (r.__state().status() & detail::status_error_is_errno) != 0; }
+
+  class other_category : public std::error_category
+  {
+  public:
+    const char *name() const noexcept override { return "other"; }
+    std::string message(int /*unused*/) const override { return "other"; }
+  };
+  inline const other_category &other() noexcept
+  {
+    static other_category c;
+    return c;
+  }
+
+  // Opaque to the optimiser, so the category is only known at run time
+  extern std::error_code opaque(int which);
+  std::error_code opaque(int which)
+  {
+    switch(which)
+    {
+    case 0:
+      return {ENOENT, std::generic_category()};
+    case 1:
+      return {ENOENT, std::system_category()};
+    default:
+      return {ENOENT, other()};
+    }
+  }
+
+  // Constructed during static initialisation, possibly before the category addresses are cached
+  static const result<int> during_static_init(opaque(0));
+  static const result<int> system_during_static_init(opaque(1));
+}  // namespace errno_detection_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_errno_detection, "Tests that results know whether their error codes are errno values")
+{
+  using namespace errno_detection_test;
+  BOOST_CHECK(is_errno(during_static_init));
+  BOOST_CHECK(is_errno(result<int>(opaque(0))));
+#ifndef _WIN32
+  BOOST_CHECK(is_errno(system_during_static_init));
+  BOOST_CHECK(is_errno(result<int>(opaque(1))));
+#endif
+  BOOST_CHECK(!is_errno(result<int>(opaque(2))));
+  BOOST_CHECK(is_errno(result<int>(make_error_code(std::errc::invalid_argument))));
+  BOOST_CHECK(is_errno(result<int>(std::errc::invalid_argument)));
+  BOOST_CHECK(!is_errno(result<int>(std::error_code(1, other()))));
+  result<int> r(5);
+  r.emplace_error(opaque(0));
+  BOOST_CHECK(is_errno(r));
+  r.emplace_error(opaque(2));
+  BOOST_CHECK(!is_errno(r));
+}
@@ -0,0 +1,132 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/error_chain.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <cstring>
+
+namespace error_chain_test
+{
+  using OUTCOME_V2_NAMESPACE::result;
+  using chain = OUTCOME_V2_NAMESPACE::error_chain<std::error_code, 2>;
+
+  inline result<int> parse(bool ok)
+  {
+    if(ok)
+    {
+      return 5;
+    }
+    return std::make_error_code(std::errc::invalid_argument);
+  }
+  inline result<int, chain> read_header(bool ok)
+  {
+    OUTCOME_TRY_CONTEXT("while parsing header", v, parse(ok));
+    return v;
+  }
+  inline result<long, chain> read_file(bool ok)
+  {
+    OUTCOME_TRY_CONTEXT("while reading file", v, read_header(ok));
+    return v;
+  }
+  inline result<void, chain> open_project(bool ok)
+  {
+    OUTCOME_TRYV_CONTEXT("while opening project", read_file(ok));
+    return OUTCOME_V2_NAMESPACE::success();
+  }
+  // Without an error_chain to add to, the context is ignored
+  inline result<void> plain(bool ok)
+  {
+    OUTCOME_TRYV_CONTEXT("while doing something", parse(ok));
+    return OUTCOME_V2_NAMESPACE::success();
+  }
+}  // namespace error_chain_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / error_chain, "Tests that error_chain keeps its frames inline until it overflows")
+{
+  using namespace error_chain_test;
+  chain c(std::make_error_code(std::errc::invalid_argument));
+  BOOST_CHECK(c.empty());
+  BOOST_CHECK(c.message() == std::make_error_code(std::errc::invalid_argument).message());
+  c.push("a", 1).push("b", 2);
+  BOOST_CHECK(c.size() == 2);
+  BOOST_CHECK(strcmp(c[0].context, "a") == 0);
+  BOOST_CHECK(c[1].site == 2);
+  // Past N frames go on the heap
+  c.push("c", 3).push("d", 4).push("e", 5);
+  BOOST_REQUIRE(c.size() == 5);
+  BOOST_CHECK(!c.truncated());
+  BOOST_CHECK(strcmp(c[4].context, "e") == 0);
+  BOOST_CHECK(c.message() == "e: d: c: b: a: " + std::make_error_code(std::errc::invalid_argument).message());
+  unsigned sites = 0;
+  c.for_each_frame([&](const OUTCOME_V2_NAMESPACE::error_chain_frame &f) { sites = sites * 10 + f.site; });
+  BOOST_CHECK(sites == 12345);
+
+  // Copies are deep, moves take the heap frames
+  chain d(c);
+  c.push("f");
+  BOOST_CHECK(d.size() == 5);
+  BOOST_CHECK(c.size() == 6);
+  BOOST_CHECK(strcmp(d[4].context, "e") == 0);
+  chain e(std::move(c));
+  BOOST_CHECK(e.size() == 6);
+  BOOST_CHECK(strcmp(e[5].context, "f") == 0);
+  d = e;
+  BOOST_CHECK(d.size() == 6);
+  // Errors compare by code alone
+  BOOST_CHECK(d == chain(std::make_error_code(std::errc::invalid_argument)));
+  BOOST_CHECK(d != chain(std::make_error_code(std::errc::not_enough_memory)));
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / error_chain / try, "Tests that OUTCOME_TRY_CONTEXT adds frames to an error_chain as it propagates")
+{
+  using namespace error_chain_test;
+  BOOST_CHECK(read_file(true).value() == 5);
+  BOOST_CHECK(open_project(true));
+  BOOST_CHECK(plain(false).error() == std::errc::invalid_argument);
+
+  auto r = open_project(false);
+  BOOST_REQUIRE(r.has_error());
+  BOOST_REQUIRE(r.error().size() == 3);
+  BOOST_CHECK(r.error().code() == std::errc::invalid_argument);
+  BOOST_CHECK(strcmp(r.error()[0].context, "while parsing header") == 0);
+  BOOST_CHECK(strcmp(r.error()[2].context, "while opening project") == 0);
+  // Each frame records where it was added
+  BOOST_CHECK(r.error()[0].site != 0);
+  BOOST_CHECK(r.error()[0].site != r.error()[1].site);
+  BOOST_CHECK(r.error()[0].site == open_project(false).error()[0].site);
+
+  // The default policy throws the code, describing the chain
+  auto s = read_file(false);
+  try
+  {
+    s.value();
+    BOOST_CHECK(false);
+  }
+  catch(const std::system_error &e)
+  {
+    BOOST_CHECK(e.code() == std::errc::invalid_argument);
+    BOOST_CHECK(strstr(e.what(), "while reading file: while parsing header") != nullptr);
+  }
+}
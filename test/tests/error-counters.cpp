@@ -0,0 +1,103 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/error_counters.hpp"
+#include "../../include/outcome/outcome.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <thread>
+
+namespace error_counters_test
+{
+  // The ADL bridge for the hooks
+  struct error_code : public std::error_code
+  {
+    using std::error_code::error_code;
+    error_code() = default;
+    error_code(std::error_code ec)  // NOLINT
+    : std::error_code(ec)
+    {
+    }
+  };
+  template <class R> using result = OUTCOME_V2_NAMESPACE::result<R, error_code>;
+  template <class R> using outcome = OUTCOME_V2_NAMESPACE::outcome<R, error_code>;
+  using OUTCOME_V2_NAMESPACE::error_counters;
+  template <class T, class U> inline void hook_result_construction(result<T> *res, U && /*unused*/) noexcept { error_counters::count_failure(res); }
+  template <class T, class U> inline void hook_outcome_construction(outcome<T> *res, U && /*unused*/) noexcept { error_counters::count_failure(res); }
+}  // namespace error_counters_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / error_counters, "Tests that failures are counted per thread by category and code")
+{
+  using namespace error_counters_test;
+  const error_code inval(make_error_code(std::errc::invalid_argument)), perm(make_error_code(std::errc::operation_not_permitted));
+  result<int> ok(5);
+  result<int> a(inval), b(inval);
+  outcome<int> c(perm);
+  auto snap = error_counters::snapshot();
+  BOOST_CHECK(snap.count(std::generic_category(), static_cast<int>(std::errc::invalid_argument)) == 2);
+  BOOST_CHECK(snap.count(std::generic_category(), static_cast<int>(std::errc::operation_not_permitted)) == 1);
+  BOOST_CHECK(snap.count(std::system_category(), static_cast<int>(std::errc::invalid_argument)) == 0);
+  BOOST_CHECK(snap.total() == 3);
+
+  // Other threads count into their own shards, which can be snapshotted while they run
+  std::atomic<bool> done{false};
+  std::thread snapshotter([&] {
+    uint64_t last = 0;
+    while(!done.load())
+    {
+      const uint64_t total = error_counters::snapshot().total();
+      BOOST_CHECK(total >= last);
+      last = total;
+    }
+  });
+  std::vector<std::thread> threads;
+  for(int n = 0; n < 4; n++)
+  {
+    threads.emplace_back([&] {
+      for(int i = 0; i < 10000; i++)
+      {
+        result<int> r(error_code(static_cast<int>(i % 8), std::system_category()));
+        (void) r;
+      }
+    });
+  }
+  for(auto &t : threads)
+  {
+    t.join();
+  }
+  done = true;
+  snapshotter.join();
+  // The counts of exited threads are kept
+  snap = error_counters::snapshot();
+  BOOST_CHECK(snap.count(std::system_category(), 3) == 5000);
+  BOOST_CHECK(snap.total() == 40003);
+
+  // Once a shard is full, further keys are counted as overflow
+  for(int n = 0; n < 200; n++)
+  {
+    error_counters::count(std::system_category(), 1000 + n);
+  }
+  snap = error_counters::snapshot();
+  BOOST_CHECK(snap.overflow == 200 + 2 - OUTCOME_V2_NAMESPACE::detail::error_counter_shard::slots);
+  BOOST_CHECK(snap.total() == 40203);
+}
@@ -0,0 +1,98 @@
+/* Unit testing for cached_equivalent()
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/error_equivalence.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <string>
+
+namespace error_equivalence_test
+{
+  // Error codes 1 to 9 are equivalent to std::errc::timed_out, counting the queries
+  class counting_category : public std::error_category
+  {
+  public:
+    mutable int queries{0};
+    const char *name() const noexcept override { return "counting"; }
+    std::string message(int c) const override { return "counting " + std::to_string(c); }
+    bool equivalent(int code, const std::error_condition &cond) const noexcept override
+    {
+      ++queries;
+      return code >= 1 && code <= 9 && cond == std::errc::timed_out;
+    }
+  };
+  inline const counting_category &counting() noexcept
+  {
+    static counting_category c;
+    return c;
+  }
+}  // namespace error_equivalence_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_error_equivalence, "Tests that cached_equivalent() answers as == does, querying each category once")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using error_equivalence_test::counting;
+  clear_equivalence_cache();
+  const std::error_code five(5, counting()), ten(10, counting());
+  counting().queries = 0;
+  BOOST_CHECK(cached_equivalent(five, std::errc::timed_out));
+  BOOST_CHECK(!cached_equivalent(ten, std::errc::timed_out));
+  BOOST_CHECK(!cached_equivalent(five, std::errc::invalid_argument));
+  const int queries = counting().queries;
+  BOOST_CHECK(queries >= 3);
+  for(int n = 0; n < 100; n++)
+  {
+    BOOST_CHECK(cached_equivalent(five, std::errc::timed_out));
+    BOOST_CHECK(!cached_equivalent(ten, std::errc::timed_out));
+    BOOST_CHECK(!cached_equivalent(five, std::errc::invalid_argument));
+  }
+  BOOST_CHECK(counting().queries == queries);
+
+  // Agrees with == for the system categories
+  const auto timed_out = make_error_code(std::errc::timed_out);
+  BOOST_CHECK(cached_equivalent(timed_out, std::errc::timed_out));
+  BOOST_CHECK(!cached_equivalent(timed_out, std::errc::invalid_argument));
+  BOOST_CHECK(cached_equivalent(std::error_code(ETIMEDOUT, std::system_category()), std::errc::timed_out));
+  BOOST_CHECK(cached_equivalent(std::error_code(ETIMEDOUT, std::system_category()), std::error_condition(std::errc::timed_out)));
+
+  // Many more queries than entries evict, and still answer correctly
+  for(int n = 0; n < 1000; n++)
+  {
+    BOOST_CHECK(cached_equivalent(std::error_code(n, counting()), std::errc::timed_out) == (n >= 1 && n <= 9));
+  }
+
+  // Results
+  result<int> r(five), s(1);
+  BOOST_CHECK(error_equivalent(r, std::errc::timed_out));
+  BOOST_CHECK(!error_equivalent(r, std::errc::invalid_argument));
+  BOOST_CHECK(!error_equivalent(s, std::errc::timed_out));
+
+  // Clearing forgets
+  counting().queries = 0;
+  BOOST_CHECK(cached_equivalent(five, std::errc::timed_out));
+  BOOST_CHECK(counting().queries == 0);
+  clear_equivalence_cache();
+  BOOST_CHECK(cached_equivalent(five, std::errc::timed_out));
+  BOOST_CHECK(counting().queries > 0);
+}
@@ -0,0 +1,135 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <ios>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / error_from_exception, "Tests that exceptions convert to their equivalent error codes")
+{
+#ifdef __cpp_exceptions
+  using OUTCOME_V2_NAMESPACE::error_from_exception;
+  struct derived_error : std::out_of_range
+  {
+    derived_error()
+        : std::out_of_range("derived")
+    {
+    }
+  };
+  struct unknown_error
+  {
+  };
+  auto convert = [](std::exception_ptr ep, bool reset) {
+    std::error_code ec = error_from_exception(std::move(ep));
+    BOOST_CHECK(!ep == reset);
+    return ec;
+  };
+  BOOST_CHECK(!error_from_exception(std::exception_ptr()));
+  // Exact STL types, which the table finds where the ABI allows
+  BOOST_CHECK(convert(std::make_exception_ptr(std::invalid_argument("x")), true) == std::errc::invalid_argument);
+  BOOST_CHECK(convert(std::make_exception_ptr(std::domain_error("x")), true) == std::errc::argument_out_of_domain);
+  BOOST_CHECK(convert(std::make_exception_ptr(std::length_error("x")), true) == std::errc::argument_list_too_long);
+  BOOST_CHECK(convert(std::make_exception_ptr(std::out_of_range("x")), true) == std::errc::result_out_of_range);
+  BOOST_CHECK(convert(std::make_exception_ptr(std::logic_error("x")), true) == std::errc::invalid_argument);
+  BOOST_CHECK(convert(std::make_exception_ptr(std::system_error(std::make_error_code(std::errc::timed_out))), true) == std::errc::timed_out);
+  BOOST_CHECK(convert(std::make_exception_ptr(std::overflow_error("x")), true) == std::errc::value_too_large);
+  BOOST_CHECK(convert(std::make_exception_ptr(std::range_error("x")), true) == std::errc::result_out_of_range);
+  BOOST_CHECK(convert(std::make_exception_ptr(std::runtime_error("x")), true) == std::errc::resource_unavailable_try_again);
+  BOOST_CHECK(convert(std::make_exception_ptr(std::bad_alloc()), true) == std::errc::not_enough_memory);
+  // Derived types, which are rethrown
+  BOOST_CHECK(convert(std::make_exception_ptr(derived_error()), true) == std::errc::result_out_of_range);
+  BOOST_CHECK(convert(std::make_exception_ptr(std::ios_base::failure("x", std::make_error_code(std::errc::io_error))), true) == std::errc::io_error);
+  // Exceptions caught and captured rather than made
+  try
+  {
+    throw std::system_error(std::make_error_code(std::errc::permission_denied));
+  }
+  catch(...)
+  {
+    BOOST_CHECK(error_from_exception() == std::errc::permission_denied);
+  }
+  // Unknown types are left in the pointer
+  std::exception_ptr ep = std::make_exception_ptr(unknown_error());
+  BOOST_CHECK(error_from_exception(std::move(ep), std::make_error_code(std::errc::not_supported)) == std::errc::not_supported);
+  BOOST_CHECK(ep);
+#endif
+}
+
+#ifdef OUTCOME_HAVE_EXCEPTION_REGISTRY
+namespace error_from_exception_test
+{
+  struct parse_error : std::runtime_error
+  {
+    int line;
+    explicit parse_error(int _line)
+        : std::runtime_error("parse error")
+        , line(_line)
+    {
+    }
+  };
+  struct eof_error : parse_error
+  {
+    eof_error()
+        : parse_error(0)
+    {
+    }
+  };
+  inline std::error_code make_parse_error_code(const parse_error &e) { return {e.line, std::generic_category()}; }
+  inline std::error_code make_eof_error_code(const eof_error & /*unused*/) { return std::make_error_code(std::errc::no_message_available); }
+}  // namespace error_from_exception_test
+#endif
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / error_from_exception / registry, "Tests that applications can register their own exception to error code mappings")
+{
+#ifdef OUTCOME_HAVE_EXCEPTION_REGISTRY
+  using namespace error_from_exception_test;
+  using OUTCOME_V2_NAMESPACE::error_from_exception;
+  struct unknown_parse_error : parse_error
+  {
+    unknown_parse_error()
+        : parse_error(EILSEQ)
+    {
+    }
+  };
+  // Before registration the STL base is matched
+  BOOST_CHECK(error_from_exception(std::make_exception_ptr(parse_error(EBADMSG))) == std::errc::resource_unavailable_try_again);
+  OUTCOME_V2_NAMESPACE::register_exception_error<parse_error>(&make_parse_error_code);
+  BOOST_CHECK(error_from_exception(std::make_exception_ptr(parse_error(EBADMSG))) == std::errc::bad_message);
+  // Types derived from registered types are matched by rethrowing
+  BOOST_CHECK(error_from_exception(std::make_exception_ptr(unknown_parse_error())) == std::errc::illegal_byte_sequence);
+  // The most derived registration wins
+  OUTCOME_V2_NAMESPACE::register_exception_error<eof_error>(&make_eof_error_code);
+  BOOST_CHECK(error_from_exception(std::make_exception_ptr(eof_error())) == std::errc::no_message_available);
+  // STL mappings can be replaced
+  OUTCOME_V2_NAMESPACE::register_exception_error<std::bad_alloc>([](const std::bad_alloc & /*unused*/) { return std::make_error_code(std::errc::no_buffer_space); });
+  BOOST_CHECK(error_from_exception(std::make_exception_ptr(std::bad_alloc())) == std::errc::no_buffer_space);
+  BOOST_CHECK(error_from_exception(std::make_exception_ptr(std::bad_array_new_length())) == std::errc::no_buffer_space);
+
+  // Outcomes convert their exceptions without rethrowing out of value()
+  OUTCOME_V2_NAMESPACE::outcome<int> a(5), b(std::make_exception_ptr(parse_error(EPROTO)));
+  BOOST_CHECK(!error_from_exception(a));
+  BOOST_CHECK(error_from_exception(b) == std::errc::protocol_error);
+  BOOST_CHECK(b.has_exception());
+#endif
+}
@@ -0,0 +1,95 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/error_info_ring.hpp"
+#include "count-allocations.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+namespace error_info_ring_test
+{
+  struct info
+  {
+    int line{0};
+  };
+  using ring = OUTCOME_V2_NAMESPACE::error_info_ring<info, 4>;
+
+  // The ADL bridge for the hooks
+  struct error_code : public std::error_code
+  {
+    using std::error_code::error_code;
+    error_code() = default;
+    error_code(std::error_code ec)  // NOLINT
+    : std::error_code(ec)
+    {
+    }
+  };
+  template <class R> using result = OUTCOME_V2_NAMESPACE::result<R, error_code>;
+  static int current_line;
+  template <class T, class U> inline void hook_result_construction(result<T> *res, U && /*unused*/) noexcept
+  {
+    if(res->has_error())
+    {
+      ring::capture(res).line = current_line;
+    }
+  }
+  inline result<int> fail(int line)
+  {
+    current_line = line;
+    return error_code(make_error_code(std::errc::invalid_argument));
+  }
+}  // namespace error_info_ring_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / error_info_ring, "Tests that the thread local ring of extended error info works as intended")
+{
+#ifndef OUTCOME_ENABLE_COMPACT_STATUS
+  using namespace error_info_ring_test;
+  result<int> ok(5);
+  BOOST_CHECK(ring::lookup(ok) == nullptr);
+
+  (void) ring::this_thread();
+  const size_t before = allocations;
+  result<int> a = fail(1);
+  result<int> b = fail(2);
+  // The failure path allocates nothing
+  BOOST_CHECK(allocations == before);
+  BOOST_REQUIRE(ring::lookup(a) != nullptr);
+  BOOST_CHECK(ring::lookup(a)->line == 1);
+  BOOST_CHECK(ring::lookup(b)->line == 2);
+  BOOST_CHECK(OUTCOME_V2_NAMESPACE::hooks::spare_storage(&a) != OUTCOME_V2_NAMESPACE::hooks::spare_storage(&b));
+
+  // Once the ring wraps around, the slot of a is reused and its tag is stale
+  for(int n = 0; n < 3; n++)
+  {
+    (void) fail(10 + n);
+  }
+  BOOST_CHECK(ring::lookup(a) == nullptr);
+  BOOST_REQUIRE(ring::lookup(b) != nullptr);
+  BOOST_CHECK(ring::lookup(b)->line == 2);
+
+  // Tags are never zero, even when the counter wraps
+  ring r;
+  for(int n = 0; n < 70000; n++)
+  {
+    BOOST_CHECK(r.claim() != 0);
+  }
+  BOOST_CHECK(r.find(0) == nullptr);
+#endif
+}
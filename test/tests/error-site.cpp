@@ -0,0 +1,83 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/error_site.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <cstring>
+
+namespace error_site_test
+{
+  using OUTCOME_V2_NAMESPACE::result;
+  static unsigned fail_line, propagate_line;
+  inline result<int> fail(bool ok)
+  {
+    if(ok)
+    {
+      return OUTCOME_AT_ERROR_SITE(result<int>(5));
+    }
+    fail_line = __LINE__ + 1;
+    return OUTCOME_AT_ERROR_SITE(result<int>(std::make_error_code(std::errc::invalid_argument)));
+  }
+  inline result<long> propagate(bool ok)
+  {
+    propagate_line = __LINE__ + 1;
+    OUTCOME_TRY_SITE(v, fail(ok));
+    return v;
+  }
+  inline result<void> propagatev()
+  {
+    OUTCOME_TRYV_SITE(fail(false));
+    return OUTCOME_V2_NAMESPACE::success();
+  }
+}  // namespace error_site_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / error_site, "Tests that failures can record the source location where they arose")
+{
+#ifndef OUTCOME_ENABLE_COMPACT_STATUS
+  using namespace error_site_test;
+  using OUTCOME_V2_NAMESPACE::error_site_of;
+  BOOST_CHECK(error_site_of(fail(true)) == nullptr);
+  BOOST_CHECK(error_site_of(result<int>(std::make_error_code(std::errc::invalid_argument))) == nullptr);
+
+  auto a = fail(false);
+  BOOST_REQUIRE(error_site_of(a) != nullptr);
+  BOOST_CHECK(error_site_of(a)->line == fail_line);
+  BOOST_CHECK(strstr(error_site_of(a)->file, "error-site.cpp") != nullptr);
+  // The id is the same every time the site fails
+  BOOST_CHECK(OUTCOME_V2_NAMESPACE::hooks::spare_storage(&a) == OUTCOME_V2_NAMESPACE::hooks::spare_storage(&static_cast<const result<int> &>(fail(false))));
+
+  BOOST_CHECK(propagate(true).value() == 5);
+  auto b = propagate(false);
+  BOOST_REQUIRE(error_site_of(b) != nullptr);
+  BOOST_CHECK(error_site_of(b)->line == propagate_line);
+  BOOST_CHECK(b.error() == std::errc::invalid_argument);
+  BOOST_CHECK(error_site_of(propagatev()) != nullptr);
+
+  // All sites can be listed for decoding elsewhere
+  auto sites = OUTCOME_V2_NAMESPACE::error_sites();
+  BOOST_CHECK(sites.size() == 4);
+  BOOST_CHECK(sites[OUTCOME_V2_NAMESPACE::hooks::spare_storage(&b) - 1] == error_site_of(b));
+  BOOST_CHECK(OUTCOME_V2_NAMESPACE::find_error_site(0) == nullptr);
+#endif
+}
@@ -0,0 +1,223 @@
+/* Unit testing for errors<E...>, a multi error type
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/errors.hpp"
+#include "../../include/outcome/try.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+namespace errors_test
+{
+  enum class disk_error
+  {
+    full = 1,
+    read_only
+  };
+  enum class net_error
+  {
+    unreachable = 1,
+    refused
+  };
+  enum class parse_error : uint8_t
+  {
+    bad_token = 1
+  };
+  struct disk_category_impl : std::error_category
+  {
+    const char *name() const noexcept override { return "disk"; }
+    std::string message(int c) const override { return c == 1 ? "full" : "read only"; }
+  };
+  struct net_category_impl : std::error_category
+  {
+    const char *name() const noexcept override { return "net"; }
+    std::string message(int c) const override { return c == 1 ? "unreachable" : "refused"; }
+  };
+  // Keeps only which type of an errors<> was active
+  struct error_kind
+  {
+    size_t index{0};
+    error_kind() = default;
+    template <class... Es>
+    error_kind(const OUTCOME_V2_NAMESPACE::errors<Es...> &e)  // NOLINT
+        : index(e.index())
+    {
+    }
+  };
+  inline std::error_code make_error_code(disk_error e) noexcept
+  {
+    static disk_category_impl c;
+    return {static_cast<int>(e), c};
+  }
+  inline std::error_code make_error_code(net_error e) noexcept
+  {
+    static net_category_impl c;
+    return {static_cast<int>(e), c};
+  }
+}  // namespace errors_test
+namespace std
+{
+  template <> struct is_error_code_enum<errors_test::disk_error> : true_type
+  {
+  };
+  template <> struct is_error_code_enum<errors_test::net_error> : true_type
+  {
+  };
+}  // namespace std
+
+namespace errors_test
+{
+  namespace outcome = OUTCOME_V2_NAMESPACE;
+  using io_errors = outcome::errors<disk_error, net_error>;
+  using all_errors = outcome::errors<disk_error, net_error, parse_error>;
+
+  outcome::result<int, outcome::errors<disk_error>> read(int x)
+  {
+    if(x < 0)
+    {
+      return disk_error::read_only;
+    }
+    return x;
+  }
+  outcome::result<int, io_errors> fetch(int x)
+  {
+    if(x > 100)
+    {
+      return net_error::refused;
+    }
+    OUTCOME_TRY(v, read(x));
+    return v + 1;
+  }
+  outcome::result<int, all_errors> parse(int x)
+  {
+    if(x == 0)
+    {
+      return parse_error::bad_token;
+    }
+    OUTCOME_TRY(v, fetch(x));
+    return v * 2;
+  }
+  // Which visitor overload was called
+  struct which
+  {
+    int operator()(disk_error /*unused*/) const { return 0; }
+    int operator()(net_error /*unused*/) const { return 1; }
+    int operator()(parse_error /*unused*/) const { return 2; }
+  };
+}  // namespace errors_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / errors / type, "Tests that errors<> holds exactly one of its types")
+{
+  using namespace errors_test;
+  static_assert(std::is_trivially_copyable<all_errors>::value, "errors<> of trivially copyable types is trivially copyable");
+  static_assert(sizeof(all_errors) == 2 * sizeof(int), "errors<> is the size of its largest type and an index");
+  static_assert(all_errors::types == 3, "");
+  static_assert(all_errors::index_of<parse_error>() == 2, "");
+  constexpr all_errors c(net_error::refused);
+  static_assert(c.index() == 1 && c.holds<net_error>() && c.get<net_error>() == net_error::refused, "errors<> is usable in constant expressions");
+
+  all_errors a, b(net_error::unreachable);
+  BOOST_CHECK(a.index() == 0);
+  BOOST_CHECK(a == disk_error());
+  BOOST_CHECK(b.holds<net_error>());
+  BOOST_CHECK(b.get_if<disk_error>() == nullptr);
+  BOOST_CHECK(*b.get_if<net_error>() == net_error::unreachable);
+  BOOST_CHECK(b == net_error::unreachable);
+  BOOST_CHECK(b != net_error::refused);
+  BOOST_CHECK(b != disk_error::full);
+  BOOST_CHECK(b == all_errors(net_error::unreachable));
+  BOOST_CHECK(b != all_errors(net_error::refused));
+  BOOST_CHECK(b != all_errors(parse_error::bad_token));
+  BOOST_CHECK(visit_error(b, which()) == 1);
+
+  // From the errors of a subset of the types
+  const io_errors io(net_error::refused);
+  const all_errors d(io);
+  BOOST_CHECK(d.holds<net_error>());
+  BOOST_CHECK(d == net_error::refused);
+  BOOST_CHECK(all_errors(outcome::errors<parse_error>(parse_error::bad_token)) == parse_error::bad_token);
+  static_assert(!std::is_constructible<io_errors, all_errors>::value, "errors<> is not constructible from a superset");
+  static_assert(!std::is_constructible<io_errors, parse_error>::value, "errors<> is not constructible from types not its own");
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / errors / result, "Tests that a result visits its errors<> by the index the error keeps")
+{
+  using namespace errors_test;
+  for(int x : {-1, 0, 5, 500})
+  {
+    auto r = parse(x);
+    if(x == 5)
+    {
+      BOOST_REQUIRE(r.has_value());
+      BOOST_CHECK(r.value() == 12);
+      continue;
+    }
+    BOOST_REQUIRE(r.has_error());
+    const int expected = (x < 0) ? 0 : (x == 0 ? 2 : 1);
+    BOOST_CHECK(visit_error(r, which()) == expected);
+    BOOST_CHECK(static_cast<int>(r.error().index()) == expected);
+  }
+  // Writing through the error reference changes what is visited
+  auto f = parse(-1);
+  f.assume_error() = all_errors(parse_error::bad_token);
+  BOOST_CHECK(visit_error(f, which()) == 2);
+  f.assume_error() = all_errors(net_error::refused);
+  BOOST_CHECK(visit_error(f, which()) == 1);
+
+  // Conversions and assignments leave no index behind in the status
+  outcome::result<int, io_errors> a(net_error::refused);
+  outcome::result<int, all_errors> b(a);
+  BOOST_CHECK(visit_error(b, which()) == 1);
+  outcome::result<int, all_errors> c(parse_error::bad_token);
+  c = outcome::result<int, all_errors>(disk_error::full);
+  BOOST_CHECK(visit_error(c, which()) == 0);
+  c = 5;
+  BOOST_CHECK(c.__state().status() == outcome::detail::status_have_value);
+  outcome::result<long, error_kind> e(a);
+  BOOST_CHECK(e.error().index == 1);
+  BOOST_CHECK(e.__state().status() == outcome::detail::status_have_error);
+
+  outcome::result<void, all_errors> d(parse_error::bad_token);
+  BOOST_CHECK(visit_error(d, which()) == 2);
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / errors / error_code, "Tests that errors<> maps to std::error_code on demand")
+{
+  using namespace errors_test;
+  static_assert(outcome::trait::has_error_code_v<io_errors>, "errors<> of error code enums is an error code type");
+  static_assert(!outcome::trait::has_error_code_v<all_errors>, "errors<> of other types is not an error code type");
+  const std::error_code ec = make_error_code(io_errors(net_error::refused));
+  BOOST_CHECK(ec == net_error::refused);
+  BOOST_CHECK(std::string(ec.category().name()) == "net");
+#ifdef __cpp_exceptions
+  outcome::result<int, io_errors> r(disk_error::full);
+  try
+  {
+    (void) r.value();
+    BOOST_CHECK(false);
+  }
+  catch(const std::system_error &e)
+  {
+    BOOST_CHECK(e.code() == disk_error::full);
+  }
+#endif
+}
@@ -0,0 +1,141 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome.hpp"
+#include "../../include/outcome/exception_box.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <thread>
+#include <vector>
+
+namespace exception_box_test
+{
+  // Too big for a box's block
+  struct big_error : std::runtime_error
+  {
+    char padding[256]{};
+    big_error()
+        : std::runtime_error("big")
+    {
+    }
+  };
+}  // namespace exception_box_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / exception_box, "Tests that exception_box can be used as the exception type of outcome")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  static_assert(trait::has_exception_ptr_v<exception_box>, "");
+  static_assert(trait::has_exception_ptr_v<shared_exception_box>, "");
+  static_assert(trait::is_move_bitcopying<exception_box>::value, "");
+  static_assert(sizeof(exception_box) == sizeof(void *), "");
+
+  exception_box empty;
+  BOOST_CHECK(!empty);
+  BOOST_CHECK(empty.use_count() == 0);
+  BOOST_CHECK(empty.get() == nullptr);
+  BOOST_CHECK(!empty.to_exception_ptr());
+  BOOST_CHECK(!exception_box(std::exception_ptr()));
+
+  // Copies share, moves steal
+  auto a = make_exception_box<std::runtime_error>("hello");
+  BOOST_CHECK(a);
+  BOOST_CHECK(a.use_count() == 1);
+  BOOST_REQUIRE(a.get() != nullptr);
+  BOOST_CHECK(std::string(a.get()->what()) == "hello");
+  {
+    exception_box b(a), c;
+    c = b;
+    BOOST_CHECK(a.use_count() == 3);
+    BOOST_CHECK(a == b);
+    BOOST_CHECK(a == c);
+    exception_box d(std::move(c));
+    BOOST_CHECK(!c);  // NOLINT
+    BOOST_CHECK(a.use_count() == 3);
+  }
+  BOOST_CHECK(a.use_count() == 1);
+  BOOST_CHECK(a != make_exception_box<std::runtime_error>("hello"));
+
+  // Big exceptions and exceptions not derived from std::exception
+  exception_box big(exception_box_test::big_error{}), i = exception_box::make<int>(5);
+  BOOST_CHECK(std::string(big.get()->what()) == "big");
+  BOOST_CHECK(i);
+  BOOST_CHECK(i.get() == nullptr);
+
+  // As the exception type of outcome
+  using box_outcome = outcome<int, std::error_code, exception_box>;
+  box_outcome o(a), p(5), q(std::make_error_code(std::errc::invalid_argument));
+  BOOST_CHECK(o.has_exception());
+  BOOST_CHECK(o.exception() == a);
+  BOOST_CHECK(a.use_count() == 2);
+  box_outcome o2(o);
+  BOOST_CHECK(a.use_count() == 3);
+  BOOST_CHECK(p.value() == 5);
+  BOOST_CHECK(!p.failure());
+  BOOST_CHECK(o.lazy_failure().exception() == a);
+  BOOST_CHECK(o.lazy_failure() == o2.lazy_failure());
+#ifdef __cpp_exceptions
+  BOOST_CHECK(o.failure());
+  BOOST_CHECK(q.failure());
+  BOOST_CHECK_THROW(o.value(), std::runtime_error);
+  BOOST_CHECK_THROW(q.value(), std::system_error);
+  BOOST_CHECK_THROW(exception_box(std::make_exception_ptr(std::logic_error("boo"))).rethrow(), std::logic_error);
+  BOOST_CHECK_THROW(big.rethrow(), exception_box_test::big_error);
+  try
+  {
+    i.rethrow();
+  }
+  catch(int v)
+  {
+    BOOST_CHECK(v == 5);
+  }
+  try
+  {
+    std::rethrow_exception(o.failure());
+  }
+  catch(const std::runtime_error &e)
+  {
+    BOOST_CHECK(std::string(e.what()) == "hello");
+  }
+  BOOST_CHECK_THROW(o.lazy_failure().rethrow(), std::runtime_error);
+  BOOST_CHECK(error_from_exception(box_outcome(make_exception_box<std::bad_alloc>())) == std::errc::not_enough_memory);
+#endif
+
+  // Shared boxes may be copied on many threads
+  auto s = shared_exception_box::make<std::runtime_error>("shared");
+  std::vector<std::thread> threads;
+  for(int t = 0; t < 4; t++)
+  {
+    threads.emplace_back([s] {
+      for(int n = 0; n < 10000; n++)
+      {
+        shared_exception_box copy(s);
+        (void) copy;
+      }
+    });
+  }
+  for(auto &t : threads)
+  {
+    t.join();
+  }
+  BOOST_CHECK(s.use_count() == 1);
+}
@@ -0,0 +1,148 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/executor.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+namespace executor_test
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+
+  // Naive recursive Fibonacci, spawning both halves from within the executor
+  inline result<long> fib(executor &ex, int n)
+  {
+    if(n < 2)
+    {
+      return n;
+    }
+    auto a = ex.submit([&ex, n] { return fib(ex, n - 1); });
+    auto b = ex.submit([&ex, n] { return fib(ex, n - 2); });
+    return a.get().value() + b.get().value();
+  }
+}  // namespace executor_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / executor, "Tests that the work stealing executor works as intended")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  executor ex(4);
+  BOOST_CHECK(ex.size() == 4);
+  {
+    // Tasks spawning and waiting on tasks do not deadlock
+    auto h = ex.submit([&ex] { return executor_test::fib(ex, 18); });
+    BOOST_CHECK(h.get().value() == 2584);
+  }
+  {
+    // A group where every task succeeds
+    task_group<result<int>> group(ex);
+    std::vector<task_handle<result<int>>> handles;
+    for(int n = 0; n < 100; n++)
+    {
+      handles.push_back(group.spawn([n] { return result<int>(n); }));
+    }
+    BOOST_CHECK(group.wait().has_value());
+    BOOST_CHECK(!group.cancelled());
+    int sum = 0;
+    for(auto &h : handles)
+    {
+      sum += h.wait().value();
+    }
+    BOOST_CHECK(sum == 4950);
+  }
+  {
+    // The first failure cancels the group, and siblings not yet started are dropped
+    std::atomic<int> ran{0};
+    task_group<result<int>> group(ex);
+    group.spawn([] { return result<int>(std::errc::invalid_argument); });
+    while(!group.cancelled())
+    {
+      std::this_thread::yield();
+    }
+    std::vector<task_handle<result<int>>> handles;
+    for(int n = 0; n < 100; n++)
+    {
+      handles.push_back(group.spawn([&ran, n] {
+        ++ran;
+        return result<int>(n);
+      }));
+    }
+    auto r = group.wait();
+    BOOST_CHECK(!r.has_value());
+    BOOST_CHECK(r.error() == std::errc::invalid_argument);
+    BOOST_CHECK(ran == 0);
+    for(auto &h : handles)
+    {
+      BOOST_CHECK(h.wait().error() == std::errc::invalid_argument);
+    }
+  }
+  {
+    // Outcomes carry their exceptions through the group
+    task_group<outcome<int>> group(ex);
+    auto e = std::make_exception_ptr(std::runtime_error("failed"));
+    group.spawn([e] { return outcome<int>(e); });
+    auto r = group.wait();
+    BOOST_CHECK(r.has_exception());
+  }
+#ifdef __cpp_exceptions
+  {
+    // A thrown exception cancels the group and is rethrown by the join, which so returns nothing to check
+    task_group<result<int>> group(ex);
+    auto h = group.spawn([]() -> result<int> { throw std::runtime_error("failed"); });
+    BOOST_CHECK_THROW((void) group.wait(), std::runtime_error);
+    BOOST_CHECK_THROW(h.wait(), std::runtime_error);
+  }
+#endif
+  {
+    // Many tasks submitted from many threads, with handles dropped before completion
+    std::atomic<int> sum{0};
+    {
+      executor ex2(3);
+      std::vector<std::thread> threads;
+      for(int t = 0; t < 4; t++)
+      {
+        threads.emplace_back([&ex2, &sum] {
+          for(int n = 0; n < 1000; n++)
+          {
+            auto h = ex2.submit([&sum] {
+              ++sum;
+              return result<int>(1);
+            });
+            if(n % 2 == 0)
+            {
+              h.wait();
+            }
+          }
+        });
+      }
+      for(auto &t : threads)
+      {
+        t.join();
+      }
+      // The destructor of the executor runs any left
+    }
+    BOOST_CHECK(sum == 4000);
+  }
+}
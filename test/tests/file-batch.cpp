@@ -0,0 +1,106 @@
+/* Unit testing for file_batch
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/file_batch.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / file_batch, "Tests that file_batch opens, reads and closes batches of files into results")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  char dir[] = "/tmp/outcome-file-batch-XXXXXX";
+  BOOST_REQUIRE(mkdtemp(dir) != nullptr);
+  // More files than the ring has entries, so batches are submitted a ring full at a time
+  static constexpr size_t files = 100;
+  std::vector<std::string> names;
+  for(size_t n = 0; n < files; n++)
+  {
+    names.push_back(std::string(dir) + "/" + std::to_string(n));
+    FILE *f = fopen(names.back().c_str(), "wb");
+    BOOST_REQUIRE(f != nullptr);
+    fprintf(f, "file %u", (unsigned) n);
+    fclose(f);
+  }
+  names.push_back(std::string(dir) + "/missing");
+
+  file_batch batch(16);
+  BOOST_TEST_MESSAGE("Uses io_uring: " << batch.uses_io_uring());
+  std::vector<const char *> paths;
+  for(const auto &name : names)
+  {
+    paths.push_back(name.c_str());
+  }
+  auto opened = batch.open(paths);
+  BOOST_REQUIRE(opened.size() == files + 1);
+  for(size_t n = 0; n < files; n++)
+  {
+    BOOST_REQUIRE(opened[n].has_value());
+  }
+  BOOST_CHECK(opened[files].error() == std::errc::no_such_file_or_directory);
+  BOOST_CHECK((opened[files].__state().status() & detail::status_error_is_errno) != 0);
+
+  std::vector<file_read> reads;
+  std::vector<std::string> buffers(files, std::string(16, '\0'));
+  for(size_t n = 0; n < files; n++)
+  {
+    reads.push_back(file_read{opened[n].value(), &buffers[n][0], buffers[n].size(), 0});
+  }
+  // A read of a descriptor which is not open fails alone
+  reads.push_back(file_read{-1, &buffers[0][0], 1, 0});
+  auto read = batch.read(reads);
+  BOOST_REQUIRE(read.size() == files + 1);
+  for(size_t n = 0; n < files; n++)
+  {
+    const std::string expected = "file " + std::to_string(n);
+    BOOST_REQUIRE(read[n].has_value());
+    BOOST_CHECK(read[n].value() == (int) expected.size());
+    BOOST_CHECK(buffers[n].compare(0, expected.size(), expected) == 0);
+  }
+  BOOST_CHECK(read[files].error() == std::errc::bad_file_descriptor);
+
+  std::vector<int> fds;
+  for(size_t n = 0; n < files; n++)
+  {
+    fds.push_back(opened[n].value());
+  }
+  auto closed = batch.close(fds);
+  for(size_t n = 0; n < files; n++)
+  {
+    BOOST_CHECK(closed[n].value() == 0);
+  }
+  // Closed already
+  result<int> again(0);
+  batch.close(fds.data(), 1, &again);
+  BOOST_CHECK(again.error() == std::errc::bad_file_descriptor);
+
+  for(const auto &name : names)
+  {
+    remove(name.c_str());
+  }
+  remove(dir);
+}
+#endif
@@ -0,0 +1,94 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/flight_recorder.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <thread>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / flight_recorder, "Tests that the flight recorder records failures to a file which can be read back")
+{
+#ifdef OUTCOME_HAVE_FLIGHT_RECORDER
+  using namespace OUTCOME_V2_NAMESPACE;
+  std::string path = "/tmp/outcome-flight-recorder-" + std::to_string(::getpid());
+  // Recording when closed does nothing
+  flight_recorder::record(std::generic_category(), EINVAL);
+
+  BOOST_REQUIRE(flight_recorder::open(path.c_str(), 4, 8));
+  flight_recorder::record(std::generic_category(), EINVAL, 7);
+  result<int> ok(5), failed(std::make_error_code(std::errc::no_such_file_or_directory));
+  flight_recorder::record_failure(&ok);
+  flight_recorder::record_failure(&failed);
+  {
+    std::vector<std::thread> threads;
+    for(int n = 0; n < 3; n++)
+    {
+      threads.emplace_back([n] {
+        // Wraps the ring, so only the newest eight are kept
+        for(int i = 0; i < 20; i++)
+        {
+          flight_recorder::record(std::system_category(), 100 * n + i);
+        }
+      });
+    }
+    for(auto &t : threads)
+    {
+      t.join();
+    }
+  }
+  // A fifth thread has no ring left
+  std::thread([] { flight_recorder::record(std::system_category(), 1); }).join();
+
+  auto records = flight_recorder::read(path.c_str());
+  BOOST_REQUIRE(records);
+  BOOST_CHECK(records.value().size() == 2 + 3 * 8);
+  BOOST_CHECK(std::is_sorted(records.value().begin(), records.value().end(), [](const flight_record &a, const flight_record &b) { return a.timestamp < b.timestamp; }));
+  const flight_record &first = records.value().front();
+  BOOST_CHECK(first.category == std::generic_category().name());
+  BOOST_CHECK(first.code == EINVAL);
+  BOOST_CHECK(first.site == 7);
+  size_t kept = 0;
+  for(const flight_record &r : records.value())
+  {
+    if(r.ring != 0)
+    {
+      BOOST_CHECK(r.category == std::system_category().name());
+      BOOST_CHECK(r.code % 100 >= 12);
+      ++kept;
+    }
+    else if(r.code == ENOENT)
+    {
+      BOOST_CHECK(r.category == std::generic_category().name());
+      ++kept;
+    }
+  }
+  BOOST_CHECK(kept == 3 * 8 + 1);
+
+  // The file outlives being closed
+  flight_recorder::close();
+  flight_recorder::record(std::generic_category(), EINVAL);
+  BOOST_CHECK(flight_recorder::read(path.c_str()).value().size() == 2 + 3 * 8);
+  ::unlink(path.c_str());
+  BOOST_CHECK(flight_recorder::read(path.c_str()).error() == std::errc::no_such_file_or_directory);
+#endif
+}
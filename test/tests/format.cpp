@@ -0,0 +1,95 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/format.hpp"
+#include "../../include/outcome/iostream_support.hpp"
+#include "count-allocations.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+namespace format_test
+{
+  struct point
+  {
+    int x, y;
+  };
+  inline std::ostream &operator<<(std::ostream &s, const point &p) { return s << p.x << "," << p.y; }
+}  // namespace format_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / format, "Tests that results and outcomes format as print() does, into caller owned buffers")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  auto formatted = [](const auto &v) {
+    std::string ret;
+    format_to(std::back_inserter(ret), v);
+    return ret;
+  };
+
+  // The same as print()
+  result<int> a(-78), b(std::make_error_code(std::errc::invalid_argument));
+  result<void> c(success());
+  result<std::string> d("hello");
+  result<double> e(3.25);
+  result<format_test::point> f(format_test::point{1, 2});
+  result<unsigned long long> g(18446744073709551615ULL);
+  BOOST_CHECK(formatted(a) == print(a));
+  BOOST_CHECK(formatted(b) == print(b));
+  BOOST_CHECK(formatted(c) == print(c));
+  BOOST_CHECK(formatted(d) == print(d));
+  BOOST_CHECK(formatted(e) == print(e));
+  BOOST_CHECK(formatted(f) == print(f));
+  BOOST_CHECK(formatted(g) == print(g));
+  outcome<int> h(5), i(std::make_error_code(std::errc::invalid_argument));
+  BOOST_CHECK(formatted(h) == print(h));
+  BOOST_CHECK(formatted(i) == print(i));
+#ifdef __cpp_exceptions
+  outcome<int> j(std::make_exception_ptr(std::invalid_argument("bad"))), k(failure(std::make_error_code(std::errc::invalid_argument), std::make_exception_ptr(std::system_error(std::make_error_code(std::errc::io_error), "io"))));
+  BOOST_CHECK(formatted(j) == print(j));
+  BOOST_CHECK(formatted(k) == print(k));
+#endif
+
+  // Into a buffer, which is not overrun
+  char buffer[64];
+  auto r = to_chars(buffer, buffer + sizeof(buffer), a);
+  BOOST_CHECK(r.ec == std::errc() && std::string(buffer, r.ptr) == "-78");
+  r = to_chars(buffer, buffer + 2, a);
+  BOOST_CHECK(r.ec == std::errc::value_too_large && r.ptr == buffer + 2 && std::string(buffer, r.ptr) == "-7");
+
+  // Without allocating, once the message cache holds the message
+  size_t before = allocations;
+  r = to_chars(buffer, buffer + sizeof(buffer), e);
+  r = to_chars(buffer, buffer + sizeof(buffer), d);
+  BOOST_CHECK(allocations == before);
+  before = allocations;
+  r = to_chars(buffer, buffer + sizeof(buffer), b);
+  BOOST_CHECK(allocations > before);
+  enable_error_message_cache();
+  r = to_chars(buffer, buffer + sizeof(buffer), b);
+  before = allocations;
+  r = to_chars(buffer, buffer + sizeof(buffer), b);
+  BOOST_CHECK(allocations == before);
+  BOOST_CHECK(r.ec == std::errc() && std::string(buffer, r.ptr) == print(b));
+  enable_error_message_cache(false);
+
+#ifdef __cpp_lib_format
+  BOOST_CHECK(std::format("{}", a) == print(a));
+  BOOST_CHECK(std::format("{}", i) == print(i));
+#endif
+}
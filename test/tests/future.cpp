@@ -0,0 +1,114 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/future.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / future, "Tests that the allocation free promise and future work as intended")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  {
+    // A caller provided state, with the continuation attached before completion
+    shared_state<int> state;
+    promise<int> p(state);
+    future<int> f = p.get_future();
+    BOOST_CHECK(!f.is_ready());
+    BOOST_CHECK(f.try_get() == nullptr);
+    int seen = 0;
+    f.then([&seen](const result<int> &r) noexcept { seen = r.value(); });
+    BOOST_CHECK(seen == 0);
+    BOOST_CHECK(p.set_value(5));
+    BOOST_CHECK(seen == 5);
+    BOOST_CHECK(!p.set_value(6));
+    BOOST_CHECK(f.wait().value() == 5);
+  }
+  {
+    // The continuation is attached after completion, so runs inline
+    shared_state<int> state;
+    promise<int> p(state);
+    future<int> f = p.get_future();
+    BOOST_CHECK(p.set_error(std::make_error_code(std::errc::invalid_argument)));
+    bool failed = false;
+    f.then([&failed](const result<int> &r) noexcept { failed = r.has_error(); });
+    BOOST_CHECK(failed);
+  }
+  {
+    // A promise destroyed without completing cancels its future
+    shared_state<int> state;
+    future<int> f;
+    {
+      promise<int> p(state);
+      f = p.get_future();
+    }
+    BOOST_CHECK(f.wait().error() == std::errc::operation_canceled);
+  }
+  {
+    // States from a pool are returned to it once the promise and future are gone
+    shared_state_pool<int, std::error_code, 2> pool;
+    {
+      promise<int> p1 = pool.make_promise(), p2 = pool.make_promise(), p3 = pool.make_promise();
+      BOOST_CHECK(p1.valid());
+      BOOST_CHECK(p2.valid());
+      BOOST_CHECK(!p3.valid());
+      p1.set_value(1);
+      p2.set_value(2);
+    }
+    for(int n = 0; n < 100; n++)
+    {
+      promise<int> p = pool.make_promise();
+      BOOST_REQUIRE(p.valid());
+      future<int> f = p.get_future();
+      std::thread t([&p, n] { p.set_value(n); });
+      BOOST_CHECK(f.wait().value() == n);
+      t.join();
+    }
+  }
+  {
+    // Many completions and continuations racing on many threads
+    shared_state_pool<int, std::error_code, 16> pool;
+    std::atomic<int> sum{0};
+    std::vector<std::thread> threads;
+    for(int n = 0; n < 8; n++)
+    {
+      threads.emplace_back([&pool, &sum, n] {
+        for(int i = 0; i < 200; i++)
+        {
+          promise<int> p = pool.make_promise();
+          future<int> f = p.get_future();
+          std::thread writer([&p, n] { p.set_value(n); });
+          f.then([&sum](const result<int> &r) noexcept { sum += r.value(); });
+          writer.join();
+        }
+      });
+    }
+    for(auto &t : threads)
+    {
+      t.join();
+    }
+    BOOST_CHECK(sum == 200 * (0 + 1 + 2 + 3 + 4 + 5 + 6 + 7));
+  }
+}
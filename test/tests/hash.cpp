@@ -0,0 +1,89 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/hash.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace hash_test
+{
+  struct unhashable
+  {
+  };
+  // Differs from the generic category only in its address
+  class generic_twin : public std::error_category
+  {
+  public:
+    const char *name() const noexcept override { return "generic"; }
+    std::string message(int c) const override { return std::generic_category().message(c); }
+  };
+}  // namespace hash_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / hash, "Tests that results and outcomes hash by their status and what they have")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using namespace hash_test;
+  static_assert(std::is_default_constructible<std::hash<result<int>>>::value, "");
+  static_assert(std::is_default_constructible<std::hash<result<void, int>>>::value, "");
+  static_assert(std::is_default_constructible<std::hash<outcome<std::string>>>::value, "");
+  static_assert(!std::is_default_constructible<std::hash<result<unhashable>>>::value, "");
+
+  std::hash<result<int>> h;
+  BOOST_CHECK(h(result<int>(5)) == h(result<int>(5)));
+  BOOST_CHECK(h(result<int>(5)) != h(result<int>(6)));
+  // The value and error of the same number are told apart by the status
+  using int_long_result = result<int, long>;
+  BOOST_CHECK(std::hash<int_long_result>()(int_long_result(in_place_type<int>, 5)) != std::hash<int_long_result>()(int_long_result(in_place_type<long>, 5)));
+  BOOST_CHECK(h(std::make_error_code(std::errc::invalid_argument)) == h(std::make_error_code(std::errc::invalid_argument)));
+  BOOST_CHECK(h(std::make_error_code(std::errc::invalid_argument)) != h(std::make_error_code(std::errc::not_enough_memory)));
+  BOOST_CHECK(h(std::make_error_code(std::errc::invalid_argument)) != h(std::error_code(EINVAL, std::system_category())));
+
+  // Error codes hash by the stable id of their category rather than its address
+  static const generic_twin twin;
+  BOOST_CHECK(h(std::make_error_code(std::errc::invalid_argument)) == h(std::error_code(EINVAL, twin)));
+
+  // Inactive storage does not count
+  result<int> a(5), b(6);
+  a = std::make_error_code(std::errc::invalid_argument);
+  b = std::make_error_code(std::errc::invalid_argument);
+  BOOST_CHECK(h(a) == h(b));
+
+  std::hash<outcome<int>> ho;
+  BOOST_CHECK(ho(outcome<int>(5)) == h(result<int>(5)));
+  BOOST_CHECK(ho(outcome<int>(std::make_exception_ptr(5))) == ho(outcome<int>(std::make_exception_ptr(6))));
+  BOOST_CHECK(ho(outcome<int>(std::make_exception_ptr(5))) != ho(outcome<int>(5)));
+
+  // Usable as keys, memoising results and grouping failures by error
+  std::unordered_map<result<int>, int> memo;
+  memo[result<int>(5)] = 1;
+  memo[std::make_error_code(std::errc::invalid_argument)] = 2;
+  ++memo[std::make_error_code(std::errc::invalid_argument)];
+  BOOST_CHECK(memo.size() == 2);
+  BOOST_CHECK(memo[std::make_error_code(std::errc::invalid_argument)] == 3);
+  std::unordered_set<outcome<std::string>> seen{outcome<std::string>("a"), outcome<std::string>("a"), outcome<std::string>("b")};
+  BOOST_CHECK(seen.size() == 2);
+}
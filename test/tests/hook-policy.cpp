@@ -0,0 +1,99 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+namespace hook_policy_test
+{
+  namespace outcome = OUTCOME_V2_NAMESPACE;
+  struct events
+  {
+    int constructions, copies, moves, in_places, destructions, copy_assignments, move_assignments;
+  };
+  static events counted;
+  struct counting_hooks : outcome::policy::no_hooks
+  {
+    static constexpr bool has_lifetime_hooks = true;
+    template <class T, class U> static void on_construction(T * /*unused*/, U && /*unused*/) noexcept { ++counted.constructions; }
+    template <class T, class U> static void on_copy_construction(T * /*unused*/, U && /*unused*/) noexcept { ++counted.copies; }
+    template <class T, class U> static void on_move_construction(T * /*unused*/, U && /*unused*/) noexcept { ++counted.moves; }
+    template <class T, class... Args> static void on_in_place_construction(T * /*unused*/, Args &&... /*unused*/) noexcept { ++counted.in_places; }
+    template <class T> static void on_destruction(T * /*unused*/) noexcept { ++counted.destructions; }
+    template <class T, class U> static void on_copy_assignment(T * /*unused*/, U && /*unused*/) noexcept { ++counted.copy_assignments; }
+    template <class T, class U> static void on_move_assignment(T * /*unused*/, U && /*unused*/) noexcept { ++counted.move_assignments; }
+  };
+  template <class T> using policy = outcome::policy::with_hooks<outcome::policy::default_policy<T, std::error_code, void>, counting_hooks>;
+  template <class T> using result = outcome::result<T, std::error_code, policy<T>>;
+  template <class T> using plain_result = outcome::result<T, std::error_code>;
+}  // namespace hook_policy_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / hook_policy, "Tests that the hooks of a hook policy are called")
+{
+  using namespace hook_policy_test;
+  static_assert(std::is_trivially_destructible<plain_result<int>>::value, "");
+  static_assert(!std::is_trivially_destructible<result<int>>::value, "");
+  {
+    result<int> a(5);
+    BOOST_CHECK(counted.constructions == 1);
+    result<long> b(a);
+    BOOST_CHECK(counted.copies == 1);
+    result<long> c(std::move(a));
+    BOOST_CHECK(counted.moves == 1);
+    result<int> d(outcome::in_place_type<int>, 6);
+    BOOST_CHECK(counted.in_places == 1);
+    result<int> e(std::make_error_code(std::errc::invalid_argument));
+    BOOST_CHECK(counted.constructions == 2);
+    // The wrapped policy still works
+    BOOST_CHECK(d.value() == 6);
+#ifdef __cpp_exceptions
+    BOOST_CHECK_THROW(e.value(), std::system_error);
+#endif
+    // Same type copies and assignments are hooked too
+    result<int> f(d);
+    BOOST_CHECK(counted.copies == 2);
+    f = e;
+    f = std::move(d);
+    BOOST_CHECK(counted.copy_assignments == 1);
+    BOOST_CHECK(counted.move_assignments == 1);
+    BOOST_CHECK(counted.destructions == 0);
+    // Results without the hook policy see nothing
+    plain_result<int> g(5), h(outcome::in_place_type<int>, 6);
+    (void) g;
+    (void) h;
+  }
+  BOOST_CHECK(counted.constructions == 2);
+  BOOST_CHECK(counted.in_places == 1);
+  BOOST_CHECK(counted.destructions == 6);
+
+  counted = events{};
+  {
+    using outcome_type = outcome::outcome<int, std::error_code, std::exception_ptr, outcome::policy::with_hooks<outcome::policy::default_policy<int, std::error_code, std::exception_ptr>, counting_hooks>>;
+    outcome_type a(5), b(std::make_error_code(std::errc::invalid_argument));
+    BOOST_CHECK(counted.constructions == 2);
+    outcome_type c(result<int>(6));
+    BOOST_CHECK(counted.moves == 1);
+    BOOST_CHECK(c.value() == 6);
+  }
+  BOOST_CHECK(counted.destructions == 4);
+}
@@ -0,0 +1,103 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/hook_sampler.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <thread>
+
+namespace hook_sampler_test
+{
+  // The ADL bridge for the hooks
+  struct error_code : public std::error_code
+  {
+    using std::error_code::error_code;
+    error_code() = default;
+    error_code(std::error_code ec)  // NOLINT
+    : std::error_code(ec)
+    {
+    }
+  };
+  template <class R> using result = OUTCOME_V2_NAMESPACE::result<R, error_code>;
+  using sampler = OUTCOME_V2_NAMESPACE::hook_sampler<error_code>;
+  static thread_local int failures, successes, copies;
+  template <class T, class U> inline void hook_result_construction(result<T> *res, U && /*unused*/) noexcept
+  {
+    sampler::sample_construction(res, [](result<T> *r) { ++(r->has_error() ? failures : successes); });
+  }
+  template <class T, class U> inline void hook_result_copy_construction(result<T> *res, U && /*unused*/) noexcept
+  {
+    sampler::sample_copy_move(res, [](result<T> * /*unused*/) { ++copies; });
+  }
+  template <class T, class U> inline void hook_result_move_construction(result<T> *res, U && /*unused*/) noexcept
+  {
+    sampler::sample_copy_move(res, [](result<T> * /*unused*/) { ++copies; });
+  }
+}  // namespace hook_sampler_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / hook_sampler, "Tests that the hook sampler samples each kind of event at its own rate")
+{
+  using namespace hook_sampler_test;
+  using OUTCOME_V2_NAMESPACE::sample_rates;
+  // By default every failure is sampled and nothing else
+  for(int n = 0; n < 10; n++)
+  {
+    result<int> a(n), b(error_code(make_error_code(std::errc::invalid_argument)));
+    result<long> c(a);
+    (void) c;
+  }
+  BOOST_CHECK(failures == 10);
+  BOOST_CHECK(successes == 0);
+  BOOST_CHECK(copies == 0);
+
+  failures = 0;
+  sample_rates rates;
+  rates.failure = 4;
+  rates.success = 5;
+  rates.copy_move = 2;
+  sampler::this_thread().set_rates(rates);
+  for(int n = 0; n < 100; n++)
+  {
+    result<int> a(n), b(error_code(make_error_code(std::errc::invalid_argument)));
+    result<long> c(a), d(std::move(b));
+    (void) c;
+    (void) d;
+  }
+  BOOST_CHECK(failures == 25);
+  BOOST_CHECK(successes == 20);
+  BOOST_CHECK(copies == 100);
+
+  // Other threads keep their own countdowns and rates
+  std::thread([] {
+    BOOST_CHECK(sampler::this_thread().rates().copy_move == 0);
+    result<int> a(error_code(make_error_code(std::errc::invalid_argument)));
+    BOOST_CHECK(failures == 1);
+  }).join();
+  BOOST_CHECK(failures == 25);
+
+  // A rate of zero samples nothing
+  sampler::this_thread().set_rates(sample_rates{0, 0, 0});
+  result<int> e(error_code(make_error_code(std::errc::invalid_argument)));
+  BOOST_CHECK(failures == 25);
+  sampler::this_thread().set_rates(sample_rates{});
+}
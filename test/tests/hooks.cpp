@@ -105,3 +105,39 @@ BOOST_OUTCOME_AUTO_TEST_CASE(works / outcome / hooks, "Tests that you can hook o
   outcome<int> e(OUTCOME_V2_NAMESPACE::result<int>(5));
   BOOST_CHECK(!e.has_exception());
 }
+
+namespace lifetime_hook_test
+{
+  struct error_code : public std::error_code
+  {
+    using std::error_code::error_code;
+    error_code() = default;
+    error_code(std::error_code ec)  // NOLINT
+    : std::error_code(ec)
+    {
+    }
+  };
+  static int destructions, copy_assignments, move_assignments;
+  // The lifetime hooks must be declared before the results they hook are instantiated
+  template <class T, class P> inline void hook_result_destruction(OUTCOME_V2_NAMESPACE::detail::result_final<T, error_code, P> * /*unused*/) noexcept { ++destructions; }
+  template <class T, class P, class U> inline void hook_result_copy_assignment(OUTCOME_V2_NAMESPACE::detail::result_final<T, error_code, P> * /*unused*/, U && /*unused*/) noexcept { ++copy_assignments; }
+  template <class T, class P, class U> inline void hook_result_move_assignment(OUTCOME_V2_NAMESPACE::detail::result_final<T, error_code, P> * /*unused*/, U && /*unused*/) noexcept { ++move_assignments; }
+  template <class R> using result = OUTCOME_V2_NAMESPACE::result<R, error_code>;
+}  // namespace lifetime_hook_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / lifetime_hooks, "Tests that you can hook result's destruction and assignment")
+{
+  using namespace lifetime_hook_test;
+  static_assert(!std::is_trivially_destructible<result<int>>::value, "hooked result should not be trivially destructible");
+  static_assert(std::is_trivially_destructible<hook_test::result<int>>::value, "unhooked result should be trivially destructible");
+  static_assert(std::is_trivially_copyable<OUTCOME_V2_NAMESPACE::result<int>>::value, "unhooked result should be trivially copyable");
+  {
+    result<int> a(5), b(6);
+    a = b;
+    BOOST_CHECK(copy_assignments == 1);
+    a = std::move(b);
+    BOOST_CHECK(move_assignments == 1);
+    BOOST_CHECK(destructions == 0);
+  }
+  BOOST_CHECK(destructions == 2);
+}
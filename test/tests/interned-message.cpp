@@ -0,0 +1,104 @@
+/* Unit testing for interned_message()
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/interned_message.hpp"
+#include "../../include/outcome/iostream_support.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace interned_message_test
+{
+  // Every code has a distinct message, and the calls to message() are counted
+  class counting_category : public std::error_category
+  {
+  public:
+    mutable std::atomic<int> calls{0};
+    const char *name() const noexcept override { return "interned"; }
+    std::string message(int c) const override
+    {
+      ++calls;
+      return "message " + std::to_string(c);
+    }
+  };
+  inline const counting_category &counting() noexcept
+  {
+    static counting_category c;
+    return c;
+  }
+}  // namespace interned_message_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_interned_message, "Tests that interned_message() calls each category once per code and returns stable text")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using interned_message_test::counting;
+
+  const auto einval = make_error_code(std::errc::invalid_argument);
+  const interned_text a = interned_message(einval), b = interned_message(einval);
+  BOOST_CHECK(a == einval.message().c_str());
+  BOOST_CHECK(a.data() == b.data());
+  BOOST_CHECK(a.data()[a.size()] == 0);
+
+  // Concurrent first use publishes one message per code
+  std::vector<std::thread> threads;
+  std::vector<const char *> seen(8 * 16);
+  for(size_t t = 0; t < 8; t++)
+  {
+    threads.emplace_back([&seen, t] {
+      for(int c = 0; c < 16; c++)
+      {
+        seen[t * 16 + static_cast<size_t>(c)] = interned_message(counting(), c).data();
+      }
+    });
+  }
+  for(auto &t : threads)
+  {
+    t.join();
+  }
+  for(size_t t = 1; t < 8; t++)
+  {
+    for(size_t c = 0; c < 16; c++)
+    {
+      BOOST_CHECK(seen[t * 16 + c] == seen[c]);
+    }
+  }
+  counting().calls = 0;
+  for(int c = 0; c < 16; c++)
+  {
+    BOOST_CHECK(interned_message(counting(), c) == ("message " + std::to_string(c)).c_str());
+  }
+  BOOST_CHECK(counting().calls == 0);
+
+  // More codes than the table holds are still returned correctly
+  for(int c = 0; c < 3000; c++)
+  {
+    BOOST_CHECK(interned_message(counting(), c) == ("message " + std::to_string(c)).c_str());
+  }
+
+  // print() appends the interned message
+  result<int> r(std::error_code(7, counting()));
+  BOOST_CHECK(print(r).find("(message 7)") != std::string::npos);
+}
@@ -0,0 +1,66 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / outcome / lazy_failure, "Tests that the lazy failure of outcome defers synthesising an exception")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  outcome<int> a(5), b(std::make_error_code(std::errc::invalid_argument)), c(std::make_error_code(std::errc::invalid_argument)), d(std::make_error_code(std::errc::not_enough_memory));
+  BOOST_CHECK(!a.lazy_failure());
+  BOOST_CHECK(a.lazy_failure() == lazy_failure_handle<std::error_code>());
+
+  auto fb = b.lazy_failure();
+  BOOST_CHECK(fb);
+  BOOST_CHECK(fb.has_error());
+  BOOST_CHECK(!fb.has_exception());
+  BOOST_CHECK(fb.error() == std::errc::invalid_argument);
+  BOOST_CHECK(fb == c.lazy_failure());
+  BOOST_CHECK(fb != d.lazy_failure());
+  BOOST_CHECK(fb != a.lazy_failure());
+#ifdef __cpp_exceptions
+  BOOST_CHECK_THROW(fb.rethrow(), std::system_error);
+  BOOST_CHECK_THROW(a.lazy_failure().rethrow(), bad_outcome_access);
+  try
+  {
+    std::rethrow_exception(fb.to_exception_ptr());
+  }
+  catch(const std::system_error &e)
+  {
+    BOOST_CHECK(e.code() == std::errc::invalid_argument);
+  }
+
+  auto ep = std::make_exception_ptr(std::runtime_error("hi"));
+  outcome<int> e(ep), f(ep);
+  auto fe = e.lazy_failure();
+  BOOST_CHECK(fe);
+  BOOST_CHECK(fe.has_exception());
+  BOOST_CHECK(!fe.has_error());
+  BOOST_CHECK(fe.to_exception_ptr() == ep);
+  BOOST_CHECK(fe.to_exception_ptr() == e.failure());
+  BOOST_CHECK(fe == f.lazy_failure());
+  BOOST_CHECK(fe != fb);
+  BOOST_CHECK_THROW(fe.rethrow(), std::runtime_error);
+#endif
+}
@@ -0,0 +1,185 @@
+/* Unit testing for lazy_result
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/lazy_result.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / lazy_result, "Tests that lazy_result computes a result once on first use")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  {
+    // Computed on first use only, and served by reference thereafter
+    int calls = 0;
+    lazy_result<std::string> a([&]() -> result<std::string> {
+      ++calls;
+      return std::string("hello");
+    });
+    BOOST_CHECK(!a.is_ready());
+    BOOST_CHECK(a.try_get() == nullptr);
+    BOOST_CHECK(calls == 0);
+    auto r = a.get();
+    BOOST_REQUIRE(r.has_value());
+    BOOST_CHECK(r.value() == "hello");
+    BOOST_CHECK(&a.get().value() == &r.value());
+    BOOST_CHECK(calls == 1);
+    BOOST_CHECK(a.is_ready());
+    BOOST_CHECK(a.has_value());
+    BOOST_CHECK(&a.try_get()->value() == &r.value());
+  }
+  {
+    // Failures are kept by default
+    int calls = 0;
+    lazy_result<int> a([&]() -> result<int> {
+      ++calls;
+      return std::errc::invalid_argument;
+    });
+    BOOST_CHECK(a.get().error() == std::errc::invalid_argument);
+    BOOST_CHECK(a.get().error() == std::errc::invalid_argument);
+    BOOST_CHECK(calls == 1);
+    BOOST_CHECK(a.is_ready());
+    BOOST_CHECK(!a.has_value());
+  }
+  {
+    // Or computed again until one succeeds
+    int calls = 0;
+    lazy_result<int> a(
+    [&]() -> result<int> {
+      if(++calls < 3)
+      {
+        return std::errc::resource_unavailable_try_again;
+      }
+      return calls;
+    },
+    lazy_result_failure::recompute);
+    BOOST_CHECK(a.get().error() == std::errc::resource_unavailable_try_again);
+    BOOST_CHECK(!a.is_ready());
+    BOOST_CHECK(a.get().error() == std::errc::resource_unavailable_try_again);
+    BOOST_CHECK(a.get().value() == 3);
+    BOOST_CHECK(a.get().value() == 3);
+    BOOST_CHECK(calls == 3);
+  }
+  {
+    // Void results
+    int calls = 0;
+    lazy_result<void> a([&]() -> result<void> {
+      ++calls;
+      return success();
+    });
+    BOOST_CHECK(a.get().has_value());
+    BOOST_CHECK(a.get().has_value());
+    BOOST_CHECK(calls == 1);
+  }
+#ifdef __cpp_exceptions
+  {
+    // A factory which throws leaves the cell to be computed again
+    int calls = 0;
+    lazy_result<int> a([&]() -> result<int> {
+      if(++calls == 1)
+      {
+        throw std::runtime_error("boom");
+      }
+      return 5;
+    });
+    BOOST_CHECK_THROW((void) a.get(), std::runtime_error);
+    BOOST_CHECK(!a.is_ready());
+    BOOST_CHECK(a.get().value() == 5);
+    BOOST_CHECK(calls == 2);
+  }
+#endif
+  {
+    // Many threads racing to first use compute once, and all see the same value
+    std::atomic<int> calls{0};
+    lazy_result<std::vector<int>> a([&]() -> result<std::vector<int>> {
+      ++calls;
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      return std::vector<int>{1, 2, 3};
+    });
+    std::atomic<bool> go{false};
+    std::vector<const std::vector<int> *> seen(8, nullptr);
+    std::vector<std::thread> threads;
+    for(size_t n = 0; n < seen.size(); n++)
+    {
+      threads.emplace_back([&, n] {
+        while(!go.load(std::memory_order_acquire))
+        {
+          std::this_thread::yield();
+        }
+        seen[n] = &a.get().value();
+      });
+    }
+    go.store(true, std::memory_order_release);
+    for(auto &t : threads)
+    {
+      t.join();
+    }
+    BOOST_CHECK(calls == 1);
+    for(const auto *p : seen)
+    {
+      BOOST_CHECK(p == &a.try_get()->value());
+    }
+  }
+  {
+    // With recompute, the callers waiting on a failed computation each compute in turn
+    std::atomic<int> calls{0};
+    lazy_result<int> a(
+    [&]() -> result<int> {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      if(++calls < 3)
+      {
+        return std::errc::resource_unavailable_try_again;
+      }
+      return 7;
+    },
+    lazy_result_failure::recompute);
+    std::atomic<int> failures{0}, successes{0};
+    std::vector<std::thread> threads;
+    for(int n = 0; n < 6; n++)
+    {
+      threads.emplace_back([&] {
+        if(a.get())
+        {
+          ++successes;
+        }
+        else
+        {
+          ++failures;
+        }
+      });
+    }
+    for(auto &t : threads)
+    {
+      t.join();
+    }
+    BOOST_CHECK(calls == 3);
+    BOOST_CHECK(failures == 2);
+    BOOST_CHECK(successes == 4);
+    BOOST_CHECK(a.get().value() == 7);
+  }
+}
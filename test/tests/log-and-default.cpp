@@ -0,0 +1,122 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome.hpp"
+#include "../../include/outcome/policy/log_and_default.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / log_and_default, "Tests that the log and default policy logs bad wide accesses and returns defaults")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  bad_access_log &log = bad_access_log::global();
+  log.drain([](const bad_access_record & /*unused*/) {});
+  std::vector<bad_access_record> records;
+  auto collect = [&] {
+    records.clear();
+    log.drain([&](const bad_access_record &r) { records.push_back(r); });
+  };
+
+  result<int, std::error_code, policy::log_and_default> a(5), b(std::make_error_code(std::errc::invalid_argument));
+  BOOST_CHECK(a.value() == 5);
+  BOOST_CHECK(b.error() == std::errc::invalid_argument);
+  collect();
+  BOOST_CHECK(records.empty());
+
+  // A bad value access logs the error held and returns a default value
+  BOOST_CHECK(b.value() == 0);
+  b.value() = 78;
+  BOOST_CHECK(b.value() == 0);
+  BOOST_CHECK(!a.error());
+  collect();
+  BOOST_REQUIRE(records.size() == 4);
+  BOOST_CHECK(0 == strcmp(records[0].what, "no value"));
+  BOOST_CHECK(records[0].category == &std::generic_category());
+  BOOST_CHECK(records[0].code == EINVAL);
+  BOOST_CHECK(records[0].timestamp != 0);
+  BOOST_CHECK(0 == strcmp(records[3].what, "no error"));
+  BOOST_CHECK(records[3].category == nullptr);
+  BOOST_CHECK(b.has_error());
+
+  // Also in outcome, and for rvalues
+  outcome<std::string, std::error_code, std::exception_ptr, policy::log_and_default> c("hello"), d(std::make_error_code(std::errc::not_enough_memory));
+  BOOST_CHECK(!c.exception());
+  BOOST_CHECK(std::move(d).value().empty());
+  BOOST_CHECK(!d.exception());
+  collect();
+  BOOST_REQUIRE(records.size() == 3);
+  BOOST_CHECK(0 == strcmp(records[0].what, "no exception"));
+  BOOST_CHECK(records[0].category == nullptr);
+  BOOST_CHECK(records[1].code == ENOMEM);
+  BOOST_CHECK(records[2].code == ENOMEM);
+  std::stringstream ss;
+  bad_access_log::write(ss, records[1]);
+  BOOST_CHECK(ss.str().find("no value") != std::string::npos);
+  BOOST_CHECK(ss.str().find(std::generic_category().name()) != std::string::npos);
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / log_and_default / queue, "Tests that the bad access log drops rather than blocks when full, and loses nothing under contention")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  static bad_access_log log;
+  bad_access_record r;
+  r.what = "test";
+  for(size_t n = 0; n < bad_access_log::slots + 5; n++)
+  {
+    r.code = static_cast<int>(n);
+    BOOST_CHECK(log.push(r) == (n < bad_access_log::slots));
+  }
+  BOOST_CHECK(log.dropped() == 5);
+  int next = 0;
+  bool ordered = true;
+  BOOST_CHECK(log.drain([&](const bad_access_record &i) { ordered = ordered && i.code == next++; }) == bad_access_log::slots);
+  BOOST_CHECK(ordered);
+  BOOST_CHECK(!log.pop(r));
+
+  // Many pushers and a draining thread
+  std::atomic<size_t> drained{0};
+  {
+    bad_access_drainer drainer([&](const bad_access_record & /*unused*/) { drained.fetch_add(1, std::memory_order_relaxed); }, std::chrono::milliseconds(1), log);
+    std::vector<std::thread> threads;
+    for(int t = 0; t < 4; t++)
+    {
+      threads.emplace_back([&] {
+        for(int n = 0; n < 10000; n++)
+        {
+          log.push(r);
+        }
+      });
+    }
+    for(auto &t : threads)
+    {
+      t.join();
+    }
+  }
+  BOOST_CHECK(drained + log.dropped() == 40000 + 5);
+  BOOST_CHECK(!log.pop(r));
+}
@@ -0,0 +1,91 @@
+/* Unit testing for mapped_file
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/binary_serialisation.hpp"
+#include "../../include/outcome/mapped_file.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / mapped_file, "Tests that map_file maps files read only, and reports errno errors")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  char path[] = "/tmp/outcome-mapped-file-XXXXXX";
+  const int fd = mkstemp(path);
+  BOOST_REQUIRE(fd != -1);
+  ::close(fd);
+  {
+    // An empty file maps nothing
+    auto r = map_file(path);
+    BOOST_REQUIRE(r.has_value());
+    BOOST_CHECK(r.value().empty());
+    BOOST_CHECK(r.value().data() == nullptr);
+  }
+  {
+    // A serialised result decodes straight from the mapping
+    unsigned char buffer[64];
+    auto written = binary::encode(result<int, long>(in_place_type<int>, 78), buffer, sizeof(buffer));
+    BOOST_REQUIRE(written.has_value());
+    FILE *f = fopen(path, "wb");
+    BOOST_REQUIRE(f != nullptr);
+    BOOST_REQUIRE(fwrite(buffer, 1, written.value(), f) == written.value());
+    fclose(f);
+
+    for(map_access access : {map_access::normal, map_access::sequential, map_access::random})
+    {
+      auto r = map_file(path, access, true);
+      BOOST_REQUIRE(r.has_value());
+      mapped_file m = std::move(r).value();
+      BOOST_REQUIRE(m.size() == written.value());
+      BOOST_CHECK(memcmp(m.data(), buffer, m.size()) == 0);
+      BOOST_CHECK(m.advise(map_access::normal).has_value());
+      auto decoded = binary::decode<result<int, long>>(m.data(), m.size());
+      BOOST_REQUIRE(decoded.has_value());
+      BOOST_CHECK(decoded.value().value() == 78);
+#ifdef __cpp_lib_span
+      BOOST_CHECK(m.bytes().size() == m.size());
+      BOOST_CHECK((binary::decode<result<int, long>>(m.bytes()).value().value() == 78));
+#endif
+      // Moving hands over the mapping
+      mapped_file n(std::move(m));
+      BOOST_CHECK(m.empty());
+      BOOST_CHECK(n.size() == written.value());
+      m = std::move(n);
+      BOOST_CHECK(n.empty());
+      BOOST_CHECK(m.size() == written.value());
+    }
+  }
+  remove(path);
+  {
+    // Failures are errno codes, flagged as such
+    auto r = map_file(path);
+    BOOST_REQUIRE(r.has_error());
+    BOOST_CHECK(r.error() == std::errc::no_such_file_or_directory);
+    BOOST_CHECK((r.__state().status() & detail::status_error_is_errno) != 0);
+  }
+}
+#endif
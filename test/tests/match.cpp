@@ -0,0 +1,84 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/match.hpp"
+#include "../../include/outcome/outcome.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <string>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / status, "Tests that status() reports which of value, error and exception are present")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  static_assert(sizeof(result_status) == 1, "result_status is not a byte");
+  BOOST_CHECK(result<int>(5).status() == result_status::value);
+  BOOST_CHECK(result<int>(std::make_error_code(std::errc::invalid_argument)).status() == result_status::error);
+  BOOST_CHECK(result<void>(success()).status() == result_status::value);
+  BOOST_CHECK(outcome<int>(5).status() == result_status::value);
+  BOOST_CHECK(outcome<int>(std::make_exception_ptr(std::runtime_error("x"))).status() == result_status::exception);
+  BOOST_CHECK(outcome<int>(failure(std::make_error_code(std::errc::invalid_argument), std::make_exception_ptr(std::runtime_error("x")))).status() == result_status::error_and_exception);
+
+  // The status of many results combines without branching
+  result<int> rs[] = {1, std::make_error_code(std::errc::invalid_argument), 3};
+  unsigned any = 0, all = 0xff;
+  for(const auto &r : rs)
+  {
+    any |= static_cast<unsigned>(r.status());
+    all &= static_cast<unsigned>(r.status());
+  }
+  BOOST_CHECK(any == (static_cast<unsigned>(result_status::value) | static_cast<unsigned>(result_status::error)));
+  BOOST_CHECK(all == 0);
+
+  // Errors in the spare storage do not show
+  result<int> tagged(std::make_error_code(std::errc::invalid_argument));
+  hooks::set_spare_storage(&tagged, 78);
+  BOOST_CHECK(tagged.status() == result_status::error);
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / match, "Tests that match() calls the handler for the status")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  auto on_value = [](int v) { return std::to_string(v); };
+  auto on_error = [](const std::error_code &ec) { return ec.message(); };
+  BOOST_CHECK(match(result<int>(5), on_value, on_error) == "5");
+  const result<int> e(std::make_error_code(std::errc::invalid_argument));
+  BOOST_CHECK(match(e, on_value, on_error) == std::make_error_code(std::errc::invalid_argument).message());
+
+  // Void values and errors are passed as nothing, and rvalues are passed on as rvalues
+  BOOST_CHECK(match(result<void>(success()), [] { return 1; }, [](std::error_code) { return 2; }) == 1);
+  BOOST_CHECK(match(result<int, void>(5), [](int v) { return v; }, [] { return 0; }) == 5);
+  result<std::string> s(std::string("hello"));
+  std::string taken = match(std::move(s), [](std::string &&v) { return std::move(v); }, [](std::error_code) { return std::string(); });
+  BOOST_CHECK(taken == "hello");
+  // Handlers may have state, and return void
+  int calls = 0;
+  match(result<int>(5), [&](int) { ++calls; }, [&](std::error_code) { calls += 10; });
+  BOOST_CHECK(calls == 1);
+
+  auto on_exception = [](const std::exception_ptr &) { return std::string("exception"); };
+  BOOST_CHECK(match(outcome<int>(5), on_value, on_error, on_exception) == "5");
+  BOOST_CHECK(match(outcome<int>(std::make_error_code(std::errc::invalid_argument)), on_value, on_error, on_exception) == std::make_error_code(std::errc::invalid_argument).message());
+  BOOST_CHECK(match(outcome<int>(std::make_exception_ptr(std::runtime_error("x"))), on_value, on_error, on_exception) == "exception");
+  BOOST_CHECK(match(outcome<int>(failure(std::make_error_code(std::errc::invalid_argument), std::make_exception_ptr(std::runtime_error("x")))), on_value, on_error, on_exception) == "exception");
+}
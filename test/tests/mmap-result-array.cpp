@@ -0,0 +1,88 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/mmap_result_array.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <cstdio>
+
+// As a C consumer would declare it
+CXX_DECLARE_RESULT(int, int, portable, struct cxx_portable_error_code);
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / mmap_result_array, "Tests that arrays of results are shared through mapped memory with C")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using result_type = result<int, cxx_portable_error_code>;
+
+  // The C and C++ representations agree
+  result_type a(success(5));
+  c_result<int, cxx_portable_error_code> c = to_c_result(a);
+  BOOST_CHECK(CXX_RESULT_HAS_VALUE(c) && c.value == 5);
+  result_type b(failure(cxx_portable_error_code{22, 78}));
+  c = to_c_result(b);
+  BOOST_CHECK(CXX_RESULT_HAS_ERROR(c) && c.error.code == 22 && c.error.category == 78);
+  BOOST_CHECK(from_c_result(c).error().code == 22);
+  static_assert(sizeof(result_type) == sizeof(CXX_RESULT(int, portable)), "C and C++ results differ in size");
+  static_assert(!trait::is_c_layout_compatible_v<std::string, int>, "std::string is not C layout compatible");
+
+  // A view of memory the caller owns
+  alignas(result_type) unsigned char buffer[sizeof(result_type) * 4 + 1]{};
+  mmap_result_array<int, cxx_portable_error_code> view(buffer, sizeof(buffer));
+  BOOST_CHECK(view.size() == 4);
+  BOOST_CHECK(!view[0].has_value() && !view[0].has_error());
+  view[1] = a;
+  view[2] = b;
+  auto *cs = reinterpret_cast<const CXX_RESULT(int, portable) *>(view.c_data());  // NOLINT
+  BOOST_CHECK(CXX_RESULT_HAS_VALUE(cs[1]) && cs[1].value == 5);
+  BOOST_CHECK(CXX_RESULT_HAS_ERROR(cs[2]) && cs[2].error.code == 22);
+
+#if defined(__unix__) || defined(__APPLE__)
+  // Two mappings of one file, as producer and consumer processes would have
+  char path[] = "/tmp/outcome_mmap_result_array_XXXXXX";
+  const int fd = mkstemp(path);
+  BOOST_REQUIRE(fd != -1);
+  ::close(fd);
+  {
+    auto producer = map_result_array_file<int, cxx_portable_error_code>(path, 1024);
+    BOOST_REQUIRE(producer);
+    auto consumer = map_result_array_file<int, cxx_portable_error_code>(path, 1024);
+    BOOST_REQUIRE(consumer);
+    BOOST_CHECK(producer.value().size() == 1024 && producer.value().data() != consumer.value().data());
+    for(int n = 0; n < 1024; n++)
+    {
+      producer.value()[n] = (n % 2 == 0) ? result_type(success(n)) : result_type(failure(cxx_portable_error_code{n, 78}));
+    }
+    int valued = 0;
+    for(const auto &r : consumer.value())
+    {
+      valued += r.has_value() ? 1 : 0;
+    }
+    BOOST_CHECK(valued == 512);
+    BOOST_CHECK(consumer.value()[6].value() == 6 && consumer.value()[7].error().code == 7);
+    BOOST_CHECK(consumer.value().c_data()[7].error.category == 78);
+  }
+  ::unlink(path);
+  auto missing = map_result_array_file<int, cxx_portable_error_code>("/nonexistent/directory/file", 1);
+  BOOST_CHECK(!missing);
+#endif
+}
@@ -0,0 +1,144 @@
+/* Unit testing for the monadic operations
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <memory>
+#include <string>
+
+namespace monadic_test
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  inline result<int> parse(const std::string &s)
+  {
+    if(s.empty() || s[0] < '0' || s[0] > '9')
+    {
+      return std::errc::invalid_argument;
+    }
+    return std::stoi(s);
+  }
+  inline result<int> halve(int v)
+  {
+    if(v % 2 != 0)
+    {
+      return std::errc::result_out_of_range;
+    }
+    return v / 2;
+  }
+}  // namespace monadic_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / monadic / members, "Tests that the map, and_then and or_else members of result and outcome work as intended")
+{
+  using namespace monadic_test;
+  // map
+  {
+    result<int> a(5);
+    result<std::string> b = a.map([](int v) { return std::to_string(v); });
+    BOOST_CHECK(b.value() == "5");
+    result<int> c(std::errc::invalid_argument);
+    BOOST_CHECK(c.map([](int v) { return v + 1; }).error() == std::errc::invalid_argument);
+    result<void> d = a.map([](int /*unused*/) {});
+    BOOST_CHECK(d);
+    result<void> e = success();
+    BOOST_CHECK(e.map([] { return 7; }).value() == 7);
+    // An rvalue result moves its value into f
+    result<std::unique_ptr<int>> f(std::make_unique<int>(3));
+    result<int> g = std::move(f).map([](std::unique_ptr<int> p) { return *p; });
+    BOOST_CHECK(g.value() == 3);
+  }
+  // and_then
+  {
+    BOOST_CHECK(parse("8").and_then(halve).value() == 4);
+    BOOST_CHECK(parse("7").and_then(halve).error() == std::errc::result_out_of_range);
+    BOOST_CHECK(parse("x").and_then(halve).error() == std::errc::invalid_argument);
+    BOOST_CHECK(parse("8").and_then(halve).and_then(halve).and_then(halve).value() == 1);
+  }
+  // or_else
+  {
+    auto recover = [](std::error_code ec) -> result<int> {
+      if(ec == std::errc::invalid_argument)
+      {
+        return 0;
+      }
+      return ec;
+    };
+    BOOST_CHECK(parse("x").or_else(recover).value() == 0);
+    BOOST_CHECK(parse("3").or_else(recover).value() == 3);
+    BOOST_CHECK(parse("7").and_then(halve).or_else(recover).error() == std::errc::result_out_of_range);
+  }
+  // outcome, whose failures include any exception
+  {
+    outcome<int> a(5);
+    BOOST_CHECK(a.map([](int v) { return v * 2; }).value() == 10);
+    outcome<int> b(std::make_exception_ptr(std::runtime_error("boo")));
+    outcome<double> c = b.map([](int v) { return v * 2.0; });
+    BOOST_CHECK(c.has_exception());
+    BOOST_CHECK(!c.has_error());
+    outcome<int> d = b.and_then([](int v) -> outcome<int> { return v; });
+    BOOST_CHECK(d.has_exception());
+    outcome<int> e = b.or_else([](failure_type<std::error_code, std::exception_ptr> f) -> outcome<int> { return f.exception() ? 1 : 2; });
+    BOOST_CHECK(e.value() == 1);
+  }
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / monadic / pipe, "Tests that piped chains of monadic operations evaluate as intended")
+{
+  using namespace monadic_test;
+  using namespace OUTCOME_V2_NAMESPACE::monadic;
+  int calls = 0;
+  auto twice = [&](int v) {
+    ++calls;
+    return v * 2;
+  };
+  auto recover = [&](std::error_code /*unused*/) -> result<int> {
+    ++calls;
+    return 100;
+  };
+  {
+    result<int> r = parse("8") | map(twice) | and_then(halve) | map(twice) | and_then(halve) | map(twice);
+    BOOST_CHECK(r.value() == 16);
+    BOOST_CHECK(calls == 3);
+  }
+  {
+    // A failure skips the remaining stages up to the next or_else
+    calls = 0;
+    result<int> r = parse("x") | map(twice) | and_then(halve) | map(twice) | or_else(recover) | map(twice);
+    BOOST_CHECK(r.value() == 200);
+    BOOST_CHECK(calls == 2);
+    result<int> s = parse("3") | and_then(halve) | map(twice);
+    BOOST_CHECK(s.error() == std::errc::result_out_of_range);
+    BOOST_CHECK(calls == 2);
+  }
+  {
+    // Chains on lvalues, with changes of type
+    const result<int> a(21);
+    result<std::string> r = a | map(twice) | map([](int v) { return std::to_string(v); });
+    BOOST_CHECK(r.value() == "42");
+    BOOST_CHECK(a.value() == 21);
+    auto chain = a | map([](int /*unused*/) {}) | map([] { return 'x'; });
+    result<char> s = std::move(chain).get();
+    BOOST_CHECK(s.value() == 'x');
+  }
+}
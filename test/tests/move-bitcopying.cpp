@@ -0,0 +1,126 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/outcome.hpp"
+#include "../../include/outcome/outcome.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <cstdlib>
+
+namespace move_bitcopying
+{
+  // An owning pointer which has no self references, and so can be relocated by memcpy()
+  struct handle
+  {
+    int *p{nullptr};
+    explicit handle(int v)
+        : p(new int(v))
+    {
+    }
+    handle(handle &&o) noexcept : p(o.p) { o.p = nullptr; }
+    handle(const handle &) = delete;
+    handle &operator=(handle &&o) noexcept
+    {
+      delete p;
+      p = o.p;
+      o.p = nullptr;
+      return *this;
+    }
+    handle &operator=(const handle &) = delete;
+    ~handle() { delete p; }
+  };
+  struct not_bitcopying
+  {
+    not_bitcopying *self{this};
+    not_bitcopying() = default;
+    not_bitcopying(const not_bitcopying & /*unused*/)
+        : self(this)
+    {
+    }
+    ~not_bitcopying() {}  // NOLINT
+  };
+}  // namespace move_bitcopying
+
+OUTCOME_V2_NAMESPACE_BEGIN
+namespace trait
+{
+  template <> struct is_move_bitcopying<move_bitcopying::handle>
+  {
+    static constexpr bool value = true;
+  };
+}  // namespace trait
+OUTCOME_V2_NAMESPACE_END
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / move_bitcopying, "Tests that bitcopying result and outcome can be relocated by memcpy")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using move_bitcopying::handle;
+  using move_bitcopying::not_bitcopying;
+
+  // The trait propagates through result and outcome
+  static_assert(trait::is_move_bitcopying_v<result<int>>, "result<int> is not bitcopying!");
+  static_assert(trait::is_move_bitcopying_v<result<void>>, "result<void> is not bitcopying!");
+  static_assert(trait::is_move_bitcopying_v<result<handle>>, "result<handle> is not bitcopying!");
+  static_assert(trait::is_move_bitcopying_v<outcome<handle>>, "outcome<handle> is not bitcopying!");
+  static_assert(!trait::is_move_bitcopying_v<result<not_bitcopying>>, "result<not_bitcopying> is bitcopying!");
+  static_assert(!trait::is_move_bitcopying_v<outcome<int, std::error_code, not_bitcopying>>, "outcome<int, error_code, not_bitcopying> is bitcopying!");
+
+  // Swap exchanges bytes, so works across all combinations of state
+  result<handle> a(handle(5)), b(handle(6)), c(std::errc::invalid_argument);
+  a.swap(b);
+  BOOST_CHECK(*a.value().p == 6);
+  BOOST_CHECK(*b.value().p == 5);
+  a.swap(c);
+  BOOST_CHECK(a.error() == std::errc::invalid_argument);
+  BOOST_CHECK(*c.value().p == 6);
+  c.swap(a);
+  BOOST_CHECK(*a.value().p == 6);
+  BOOST_CHECK(c.has_error());
+
+  // Relocate a block of results by memcpy, then destroy them at their new address
+  using R = result<handle>;
+  auto *from = static_cast<R *>(malloc(4 * sizeof(R)));  // NOLINT
+  auto *to = static_cast<R *>(malloc(4 * sizeof(R)));    // NOLINT
+  for(int n = 0; n < 4; n++)
+  {
+    if(n == 2)
+    {
+      new(from + n) R(std::errc::no_such_file_or_directory);
+    }
+    else
+    {
+      new(from + n) R(handle(n));
+    }
+  }
+  memcpy(static_cast<void *>(to), static_cast<void *>(from), 4 * sizeof(R));  // NOLINT
+  free(from);                                                                // NOLINT
+  BOOST_CHECK(*to[0].value().p == 0);
+  BOOST_CHECK(*to[1].value().p == 1);
+  BOOST_CHECK(to[2].error() == std::errc::no_such_file_or_directory);
+  BOOST_CHECK(*to[3].value().p == 3);
+  for(int n = 0; n < 4; n++)
+  {
+    to[n].~R();
+  }
+  free(to);  // NOLINT
+}
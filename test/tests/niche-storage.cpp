@@ -0,0 +1,134 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/outcome.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <vector>
+
+namespace niche_storage
+{
+  struct node
+  {
+    int x;
+  };
+  enum class colour : uint8_t
+  {
+    red,
+    green,
+    blue
+  };
+}  // namespace niche_storage
+
+OUTCOME_V2_NAMESPACE_BEGIN
+namespace trait
+{
+  template <> struct niche<niche_storage::node *> : niche_pointer<niche_storage::node *>
+  {
+  };
+  template <> struct niche<niche_storage::colour> : niche_enum<niche_storage::colour, 128>
+  {
+  };
+  template <> struct niche<double> : niche_nan<double>
+  {
+  };
+}  // namespace trait
+OUTCOME_V2_NAMESPACE_END
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / niche, "Tests that result with a niche packed value type works as intended")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using niche_storage::node;
+  using niche_storage::colour;
+
+  // No status word is stored next to the value
+  static_assert(sizeof(result<node *, int>) == sizeof(node *) + sizeof(int) + 4, "result<node *, int> is not niche packed!");
+  static_assert(sizeof(result<node *, std::error_code>) == sizeof(node *) + sizeof(std::error_code), "result<node *, error_code> is not niche packed!");
+  static_assert(sizeof(result<colour, uint8_t>) == 2, "result<colour, uint8_t> is not niche packed!");
+  static_assert(sizeof(result<double, int>) == 16, "result<double, int> is not niche packed!");
+  static_assert(std::is_trivially_copyable<result<node *, int>>::value, "result<node *, int> is not trivially copyable!");
+
+  node n{5};
+  result<node *, int> a(&n), b(5), c(nullptr);
+  BOOST_CHECK(a.has_value());
+  BOOST_CHECK(!a.has_error());
+  BOOST_CHECK(a.value() == &n);
+  BOOST_CHECK(a.value()->x == 5);
+  BOOST_CHECK(!b.has_value());
+  BOOST_CHECK(b.has_error());
+  BOOST_CHECK(b.error() == 5);
+  BOOST_CHECK(c.has_value());
+  BOOST_CHECK(c.value() == nullptr);
+  BOOST_CHECK(a != b);
+  using node_result = result<node *, int>;
+  BOOST_CHECK(a == node_result(&n));
+
+  // Spare storage survives in the niche whilst not valued
+  hooks::set_spare_storage(&b, 78);
+  BOOST_CHECK(hooks::spare_storage(&b) == 78);
+  BOOST_CHECK(b.has_error());
+  BOOST_CHECK(b.error() == 5);
+
+  // Copy, assignment and swap
+  auto d(a);
+  BOOST_CHECK(d.value() == &n);
+  d = b;
+  BOOST_CHECK(d.error() == 5);
+  using std::swap;
+  swap(a, d);
+  BOOST_CHECK(a.error() == 5);
+  BOOST_CHECK(d.value() == &n);
+
+  // errno detection is preserved
+  result<node *> e(std::errc::invalid_argument);
+  BOOST_CHECK(e.has_error());
+  BOOST_CHECK(e.error() == std::errc::invalid_argument);
+  BOOST_CHECK((e.__state().status() & detail::status_error_is_errno) != 0);
+
+  // Enum niche
+  result<colour, uint8_t> f(colour::blue), g(uint8_t(3));
+  BOOST_CHECK(f.value() == colour::blue);
+  BOOST_CHECK(g.has_error());
+  BOOST_CHECK(g.error() == 3);
+
+  // NaN niche
+  result<double, int> h(in_place_type<double>, 1.5), i(in_place_type<int>, 3), j(in_place_type<double>, std::numeric_limits<double>::quiet_NaN());
+  BOOST_CHECK(h.value() == 1.5);
+  BOOST_CHECK(i.error() == 3);
+  BOOST_CHECK(j.has_value());
+
+  // Conversion between packed and unpacked layouts
+  result<const node *, int> k(a), l(d);
+  BOOST_CHECK(k.error() == 5);
+  BOOST_CHECK(l.value() == &n);
+
+  // outcome can additionally store exceptions
+  outcome<node *> m(std::make_exception_ptr(5)), o(&n);
+  BOOST_CHECK(m.has_exception());
+  BOOST_CHECK(!m.has_error());
+  BOOST_CHECK(o.value() == &n);
+
+  std::vector<result<node *, int>> vect{&n, 5, &n};
+  BOOST_CHECK(vect[0].value() == &n);
+  BOOST_CHECK(vect[1].error() == 5);
+}
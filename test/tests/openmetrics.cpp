@@ -0,0 +1,110 @@
+/* Unit testing for the OpenMetrics exporter
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#define OUTCOME_ENABLE_TRY_COUNTERS 1
+
+#include "../../include/outcome/openmetrics.hpp"
+#include "../../include/outcome/try.hpp"
+#include "count-allocations.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <cstring>
+#include <string>
+
+namespace openmetrics_test
+{
+  using OUTCOME_V2_NAMESPACE::result;
+  inline result<int> parse(int x)
+  {
+    if(x % 4 == 0)
+    {
+      return std::errc::invalid_argument;
+    }
+    return x;
+  }
+  inline result<int> parse_twice(int x)
+  {
+    OUTCOME_TRY(v, parse(x));
+    return v * 2;
+  }
+  // A category whose name needs escaping as a label value
+  class awkward_category : public std::error_category
+  {
+  public:
+    const char *name() const noexcept override { return "awk\"ward\\"; }
+    std::string message(int /*unused*/) const override { return "awkward"; }
+  };
+  inline const awkward_category &awkward() noexcept
+  {
+    static awkward_category v;
+    return v;
+  }
+}  // namespace openmetrics_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / openmetrics, "Tests that the failure and TRY counters render as OpenMetrics text without allocating once warm")
+{
+  using namespace openmetrics_test;
+  using OUTCOME_V2_NAMESPACE::error_counters;
+  using OUTCOME_V2_NAMESPACE::openmetrics_exporter;
+  for(int n = 0; n < 16; n++)
+  {
+    result<int> r = parse_twice(n);
+    if(!r)
+    {
+      error_counters::count(r.error());
+    }
+  }
+  error_counters::count(awkward(), 7);
+
+  openmetrics_exporter exporter;
+  static char buffer[16384];
+  auto written = exporter.render(buffer, buffer + sizeof(buffer));
+  BOOST_REQUIRE(written.ec == std::errc());
+  const std::string text(buffer, written.ptr);
+  BOOST_CHECK(text.find("# TYPE outcome_failures counter\n") == 0);
+  BOOST_CHECK(text.find("outcome_failures_total{category=\"generic\",code=\"22\"} 4\n") != std::string::npos);
+  BOOST_CHECK(text.find("outcome_failures_total{category=\"awk\\\"ward\\\\\",code=\"7\"} 1\n") != std::string::npos);
+  BOOST_CHECK(text.find("outcome_failures_uncounted_total 0\n") != std::string::npos);
+  const size_t attempts = text.find("outcome_try_attempts_total{function=\""), failures = text.find("outcome_try_failures_total{function=\"");
+  BOOST_REQUIRE(attempts != std::string::npos && failures != std::string::npos);
+  BOOST_CHECK(text.find("parse_twice", attempts) < text.find('\n', attempts));
+  BOOST_CHECK(text.find("openmetrics.cpp\",line=\"", attempts) < text.find('\n', attempts));
+  BOOST_CHECK(text.compare(text.find("} ", attempts), 5, "} 16\n") == 0);
+  BOOST_CHECK(text.compare(text.find("} ", failures), 4, "} 4\n") == 0);
+  BOOST_CHECK(text.size() >= 6 && text.compare(text.size() - 6, 6, "# EOF\n") == 0);
+
+  // A buffer too small holds what fitted, and says so
+  char small[64];
+  written = exporter.render(small, small + sizeof(small));
+  BOOST_CHECK(written.ec == std::errc::value_too_large);
+  BOOST_CHECK(written.ptr == small + sizeof(small));
+
+  // Once warm, further counting and scraping allocates nothing
+  const size_t before = allocations;
+  for(int n = 0; n < 8; n++)
+  {
+    (void) parse_twice(n);
+    error_counters::count(awkward(), 7);
+    written = exporter.render(buffer, buffer + sizeof(buffer));
+  }
+  BOOST_CHECK(allocations == before);
+  BOOST_CHECK(std::string(buffer, written.ptr).find("category=\"awk\\\"ward\\\\\",code=\"7\"} 9\n") != std::string::npos);
+}
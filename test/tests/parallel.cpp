@@ -0,0 +1,157 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/parallel.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <vector>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / parallel, "Tests that the parallel algorithms work as intended")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  std::vector<int> v(10000);
+  std::iota(v.begin(), v.end(), 0);
+
+  // Values come back in the order of the input
+  auto r = parallel::transform(v, [](int i) -> result<long> { return i * 2L; }, 4);
+  BOOST_REQUIRE(r);
+  BOOST_CHECK(r.value().size() == v.size());
+  BOOST_CHECK(r.value()[0] == 0);
+  BOOST_CHECK(r.value()[9999] == 19998);
+  auto s = parallel::transform_reduce(v.begin(), v.end(), 0L, [](long a, long b) { return a + b; }, [](int i) -> result<long> { return i; }, 4);
+  BOOST_REQUIRE(s);
+  BOOST_CHECK(s.value() == 49995000L);
+
+  // Each bool is written apart from its neighbours, unlike in a std::vector<bool>
+  auto b = parallel::transform(v, [](int i) -> result<bool> { return i % 3 == 0; }, 4);
+  BOOST_REQUIRE(b);
+  BOOST_CHECK(std::count(b.value().begin(), b.value().end(), true) == 3334);
+  BOOST_CHECK(parallel::transform_reduce(v, false, [](bool a, bool c) { return a || c; }, [](int i) -> result<bool> { return i == 9999; }, 4).value());
+
+  // Empty ranges and a single thread
+  std::vector<int> empty;
+  BOOST_CHECK(parallel::transform(empty, [](int i) -> result<int> { return i; }).value().empty());
+  BOOST_CHECK(parallel::transform_reduce(empty, 5, [](int a, int b) { return a + b; }, [](int i) -> result<int> { return i; }).value() == 5);
+  BOOST_CHECK(parallel::transform_reduce(v, 0L, [](long a, long b) { return a + b; }, [](int i) -> result<long> { return i; }, 1).value() == 49995000L);
+
+  // The first failure cancels sibling work
+  std::atomic<size_t> calls{0};
+  auto f = parallel::transform(v,
+                               [&](int i) -> result<int> {
+                                 ++calls;
+                                 if(i == 0)
+                                 {
+                                   return std::errc::invalid_argument;
+                                 }
+                                 return i;
+                               },
+                               1);
+  BOOST_REQUIRE(!f);
+  BOOST_CHECK(f.error() == std::errc::invalid_argument);
+  BOOST_CHECK(calls == 1);
+  auto g = parallel::transform_reduce(v, 0, [](int a, int b) { return a + b; },
+                                      [](int i) -> result<int> {
+                                        if(i % 1000 == 999)
+                                        {
+                                          return std::errc::result_out_of_range;
+                                        }
+                                        return i;
+                                      },
+                                      4);
+  BOOST_REQUIRE(!g);
+  BOOST_CHECK(g.error() == std::errc::result_out_of_range);
+
+#ifdef __cpp_exceptions
+  // Exceptions are rethrown on the calling thread
+  BOOST_CHECK_THROW(parallel::transform(v,
+                                        [](int i) -> result<int> {
+                                          if(i == 5000)
+                                          {
+                                            throw std::runtime_error("boom");
+                                          }
+                                          return i;
+                                        },
+                                        4),
+                    std::runtime_error);
+#endif
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / parallel / for_each_collect, "Tests that for_each_collect gathers every failure with the index of its item")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  std::vector<int> v(100000);
+  std::iota(v.begin(), v.end(), 0);
+
+  std::atomic<size_t> calls{0};
+  auto ok = parallel::for_each_collect(v,
+                                       [&](int /*unused*/) -> result<void> {
+                                         ++calls;
+                                         return success();
+                                       },
+                                       4);
+  BOOST_CHECK(ok);
+  BOOST_CHECK(calls == v.size());
+
+  // Every failure is kept, in the order of the input, and no sibling work is cancelled
+  calls = 0;
+  auto r = parallel::for_each_collect(v.begin(), v.end(),
+                                      [&](int i) -> result<void> {
+                                        ++calls;
+                                        if(i % 7 == 3)
+                                        {
+                                          return std::errc::invalid_argument;
+                                        }
+                                        return success();
+                                      },
+                                      4);
+  BOOST_REQUIRE(!r);
+  BOOST_CHECK(calls == v.size());
+  const auto &errors = r.error();
+  BOOST_CHECK(errors.items == v.size());
+  BOOST_REQUIRE(errors.errors.size() == (v.size() + 3) / 7);
+  bool ordered = true;
+  for(size_t n = 0; n < errors.errors.size(); n++)
+  {
+    ordered &= errors.errors[n].index == n * 7 + 3 && errors.errors[n].error == std::errc::invalid_argument;
+  }
+  BOOST_CHECK(ordered);
+
+  std::vector<int> empty;
+  BOOST_CHECK(parallel::for_each_collect(empty, [](int /*unused*/) -> result<void> { return std::errc::invalid_argument; }));
+
+#ifdef __cpp_exceptions
+  BOOST_CHECK_THROW((void) parallel::for_each_collect(v,
+                                                      [](int i) -> result<void> {
+                                                        if(i == 5000)
+                                                        {
+                                                          throw std::runtime_error("boom");
+                                                        }
+                                                        return success();
+                                                      },
+                                                      4),
+                    std::runtime_error);
+#endif
+}
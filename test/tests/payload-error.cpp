@@ -0,0 +1,105 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/payload_error.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <string>
+#include <vector>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / payload_error / arena, "Tests that payload_error keeps its payload in the current arena")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  alignas(std::max_align_t) char buffer[1024];
+  payload_arena arena(buffer, sizeof(buffer));
+  {
+    payload_arena_scope scope(arena);
+    BOOST_CHECK(&payload_arena::current() == &arena);
+    result<int, payload_error<>> r = payload_error<>(make_error_code(std::errc::no_such_file_or_directory), "copy failed").with("from", "a.txt").with("to", std::string("b.txt")).with("attempt", 3);
+    BOOST_CHECK(r.has_error());
+    BOOST_CHECK(arena.used() > 0);
+    const payload_error<> &e = r.error();
+    BOOST_CHECK(e.has_payload());
+    BOOST_CHECK(e.code() == std::errc::no_such_file_or_directory);
+    BOOST_CHECK(e.message() == "copy failed");
+    BOOST_CHECK(e.context_size() == 3);
+    BOOST_CHECK(e.context("from") == "a.txt");
+    BOOST_CHECK(e.context("to") == "b.txt");
+    BOOST_CHECK(e.context("attempt") == "3");
+    BOOST_CHECK(e.context("missing").empty());
+    std::vector<std::string> keys;
+    e.for_each_context([&](payload_error_text key, payload_error_text value) { keys.push_back(key.str() + "=" + value.str()); });
+    BOOST_CHECK(keys.size() == 3 && keys[0] == "from=a.txt" && keys[2] == "attempt=3");
+    // Copies share the payload
+    payload_error<> copy(e);
+    BOOST_CHECK(copy.message().data() == e.message().data());
+    BOOST_CHECK(copy == e);
+
+    // Converts to std::error_code, so the default policy throws a system_error with the message
+    BOOST_CHECK(make_error_code(e) == std::errc::no_such_file_or_directory);
+#ifdef __cpp_exceptions
+    try
+    {
+      (void) r.value();
+      BOOST_CHECK(false);
+    }
+    catch(const std::system_error &ex)
+    {
+      BOOST_CHECK(ex.code() == std::errc::no_such_file_or_directory);
+      BOOST_CHECK(std::string(ex.what()).find("copy failed") != std::string::npos);
+    }
+#endif
+
+    // Leaving the scope resets the arena, after which the payload reads as empty
+    payload_error<> stale(std::error_code(), "gone");
+    BOOST_CHECK(stale.message() == "gone");
+    arena.reset();
+    BOOST_CHECK(!stale.has_payload());
+    BOOST_CHECK(stale.message().empty());
+    BOOST_CHECK(stale.context_size() == 0);
+  }
+  BOOST_CHECK(arena.used() == 0);
+  BOOST_CHECK(&payload_arena::current() == &payload_arena::this_thread());
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / payload_error / exhausted, "Tests that payloads which do not fit are dropped")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  alignas(std::max_align_t) char buffer[128];
+  payload_arena arena(buffer, sizeof(buffer));
+  payload_arena_scope scope(arena);
+  const std::string big(200, 'x');
+  payload_error<std::errc> e(std::errc::invalid_argument, big);
+  BOOST_CHECK(e.message().empty());
+  BOOST_CHECK(arena.dropped() == 1);
+  BOOST_CHECK(arena.used() <= arena.capacity());
+  // The code is kept, and converts through std::make_error_code()
+  BOOST_CHECK(make_error_code(e) == std::errc::invalid_argument);
+  e.with("key", "value");
+  BOOST_CHECK(e.context("key") == "value");
+  // Without a payload the code alone is kept
+  payload_error<std::errc> plain(std::errc::invalid_argument);
+  BOOST_CHECK(!plain.has_payload());
+  BOOST_CHECK(plain.message().empty());
+}
@@ -0,0 +1,139 @@
+/* Unit testing for counters kept per CPU
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#define OUTCOME_ENABLE_TRY_COUNTERS 1
+#define OUTCOME_ENABLE_PERCPU_COUNTERS 1
+
+#include "../../include/outcome/error_counters.hpp"
+#include "../../include/outcome/percpu_counters.hpp"
+#include "../../include/outcome/result.hpp"
+#include "../../include/outcome/try.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <cstring>
+#include <thread>
+
+namespace percpu_counters_test
+{
+  using OUTCOME_V2_NAMESPACE::result;
+  inline result<int> parse(int x)
+  {
+    if(x % 4 == 0)
+    {
+      return std::errc::invalid_argument;
+    }
+    return x;
+  }
+  inline result<int> parse_twice(int x)
+  {
+    OUTCOME_TRY(v, parse(x));
+    return v * 2;
+  }
+  template <class F> inline void on_threads(int count, F f)
+  {
+    std::vector<std::thread> threads;
+    for(int n = 0; n < count; n++)
+    {
+      threads.emplace_back(f);
+    }
+    for(auto &t : threads)
+    {
+      t.join();
+    }
+  }
+}  // namespace percpu_counters_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / percpu_counters, "Tests that counters kept per CPU count every add from every thread")
+{
+  using namespace percpu_counters_test;
+  OUTCOME_V2_NAMESPACE::percpu_counters<3> counters;
+  BOOST_CHECK(counters.size() == 3);
+#ifdef OUTCOME_HAVE_RSEQ
+  if(counters.cpus() == 0)
+  {
+    std::cout << "NOTE: restartable sequences are not registered by the C library, so are not tested" << std::endl;
+  }
+#else
+  BOOST_CHECK(counters.cpus() == 0);
+#endif
+  if(counters.cpus() == 0)
+  {
+    BOOST_CHECK(!counters.add(0));
+    return;
+  }
+  // More threads than CPUs, so that adds are preempted part way through and restarted
+  std::atomic<bool> ok{true};
+  on_threads(8, [&] {
+    for(int n = 0; n < 100000; n++)
+    {
+      if(!counters.add(n % 3, 1 + n % 2))
+      {
+        ok = false;
+      }
+    }
+  });
+  BOOST_CHECK(ok);
+  uint64_t expected[3] = {0, 0, 0};
+  for(int n = 0; n < 100000; n++)
+  {
+    expected[n % 3] += 8 * (1 + n % 2);
+  }
+  BOOST_CHECK(counters.sum(0) == expected[0]);
+  BOOST_CHECK(counters.sum(1) == expected[1]);
+  BOOST_CHECK(counters.sum(2) == expected[2]);
+  uint64_t total = 0;
+  for(size_t cpu = 0; cpu < counters.cpus(); cpu++)
+  {
+    total += counters.read(cpu, 0) + counters.read(cpu, 1) + counters.read(cpu, 2);
+  }
+  BOOST_CHECK(total == expected[0] + expected[1] + expected[2]);
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / percpu_counters / telemetry, "Tests that error and TRY counters kept per CPU count as those kept per thread do")
+{
+  using namespace percpu_counters_test;
+  using OUTCOME_V2_NAMESPACE::error_counters;
+  using OUTCOME_V2_NAMESPACE::try_counters;
+  on_threads(4, [] {
+    for(int n = 0; n < 1000; n++)
+    {
+      error_counters::count(std::system_category(), n % 8);
+      (void) parse_twice(n);
+    }
+  });
+  const auto errors = error_counters::snapshot();
+  BOOST_CHECK(errors.count(std::system_category(), 3) == 500);
+  BOOST_CHECK(errors.total() == 4000);
+  const auto sites = try_counters::snapshot();
+  BOOST_REQUIRE(sites.size() == 1);
+  BOOST_CHECK(strstr(sites[0].site->function, "parse_twice") != nullptr);
+  BOOST_CHECK(sites[0].attempts == 4000);
+  BOOST_CHECK(sites[0].failures == 1000);
+  // Threads which counted per CPU have no tables of their own
+  if(OUTCOME_V2_NAMESPACE::detail::error_counter_keys::get().counts.cpus() > 0)
+  {
+    BOOST_CHECK(OUTCOME_V2_NAMESPACE::detail::error_counter_registry::get().shards.empty());
+    BOOST_CHECK(OUTCOME_V2_NAMESPACE::detail::try_counter_registry::get().shards.empty());
+  }
+}
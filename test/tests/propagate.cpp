@@ -80,4 +80,50 @@ BOOST_OUTCOME_AUTO_TEST_CASE(works / outcome / propagate, "Tests that the outcom
     };
     (void) t1(5);
   }
+  {
+    // A failing TRY moves the error once, straight into the caller's return type
+    struct payload
+    {
+      int *moves{nullptr};
+      payload() = default;
+      explicit payload(int *m)
+          : moves(m)
+      {
+      }
+      payload(const payload &) = default;
+      payload(payload &&o) noexcept : moves(o.moves)
+      {
+        if(moves != nullptr)
+        {
+          ++*moves;
+        }
+      }
+      payload &operator=(const payload &) = default;
+      payload &operator=(payload &&) = default;
+      ~payload() = default;
+      bool operator==(const payload &o) const noexcept { return moves == o.moves; }
+    };
+    int moves = 0;
+    auto t0 = [&]() -> result<int, payload> { return result<int, payload>(in_place_type<payload>, &moves); };
+    auto t1 = [&]() -> result<long, payload> {
+      OUTCOME_TRY(f, t0());
+      return f;
+    };
+    auto t2 = [&]() -> outcome<long, payload> {
+      OUTCOME_TRYV(t0());
+      return 0L;
+    };
+    moves = 0;
+    BOOST_CHECK(!t1().has_value());
+    BOOST_CHECK(moves == 1);
+    moves = 0;
+    BOOST_CHECK(!t2().has_value());
+    BOOST_CHECK(moves == 1);
+#ifdef OUTCOME_TRYX
+    auto t3 = [&]() -> result<long, payload> { return OUTCOME_TRYX(t0()); };
+    moves = 0;
+    BOOST_CHECK(!t3().has_value());
+    BOOST_CHECK(moves == 1);
+#endif
+  }
 }
@@ -0,0 +1,61 @@
+/* Unit testing for zero copy policy rebinding views
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <string>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / rebind_policy, "Tests that rebind_policy() and as_narrow() view the same storage without copying")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  {
+    checked<std::string> a(std::string("hello"));
+    unchecked<std::string, std::error_code> &b = as_narrow(a);
+    static_assert(std::is_same<decltype(as_narrow(a)), unchecked<std::string, std::error_code> &>::value, "");
+    BOOST_CHECK(static_cast<void *>(&b) == static_cast<void *>(&a));
+    BOOST_CHECK(b.has_value());
+    BOOST_CHECK(b.value() == "hello");
+    // Writes through the view are visible in the original
+    b.value() = "world";
+    BOOST_CHECK(a.value() == "world");
+    // Moving through the view moves out of the original
+    std::string s = as_narrow(std::move(a)).value();
+    BOOST_CHECK(s == "world");
+  }
+  {
+    const checked<int> a(std::errc::invalid_argument);
+    const auto &b = rebind_policy<policy::terminate>(a);
+    static_assert(std::is_same<decltype(b), const result<int, std::error_code, policy::terminate> &>::value, "");
+    BOOST_CHECK(static_cast<const void *>(&b) == static_cast<const void *>(&a));
+    BOOST_CHECK(b.has_error());
+    BOOST_CHECK(b.error() == std::errc::invalid_argument);
+  }
+  {
+    // Rebinding to the same policy is the identity
+    using default_policy = policy::default_policy<int, std::error_code, void>;
+    result<int> a(5);
+    BOOST_CHECK(&rebind_policy<default_policy>(a) == &a);
+  }
+}
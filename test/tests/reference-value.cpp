@@ -0,0 +1,120 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/result.hpp"
+#include "../../include/outcome/try.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <map>
+#include <string>
+
+namespace reference_value_test
+{
+  using OUTCOME_V2_NAMESPACE::result;
+  // Counts its copies, so tests can check nothing is copied
+  struct big
+  {
+    static int copies;
+    int data[64]{};
+    big() = default;
+    big(const big &o)
+        : big()
+    {
+      ++copies;
+      data[0] = o.data[0];
+    }
+    big &operator=(const big &) = delete;
+    ~big() = default;
+  };
+  int big::copies;
+
+  inline result<const big &> lookup(const std::map<std::string, big> &table, const std::string &key)
+  {
+    auto it = table.find(key);
+    if(it == table.end())
+    {
+      return std::make_error_code(std::errc::no_such_file_or_directory);
+    }
+    return it->second;
+  }
+  inline result<int> first(const std::map<std::string, big> &table, const std::string &key)
+  {
+    OUTCOME_TRY(v, lookup(table, key));
+    // Binds the reference, without copying
+    static_assert(std::is_same<decltype(v), const big &>::value, "");
+    return v.data[0];
+  }
+}  // namespace reference_value_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / reference, "Tests that results of lvalue references work as intended")
+{
+  using namespace reference_value_test;
+  static_assert(sizeof(result<big &>) == sizeof(result<big *>), "");
+  static_assert(sizeof(result<const int &, int, OUTCOME_V2_NAMESPACE::policy::all_narrow>) == sizeof(result<const int *, int, OUTCOME_V2_NAMESPACE::policy::all_narrow>), "");
+  static_assert(std::is_trivially_copyable<result<big &>>::value == std::is_trivially_copyable<result<big *>>::value, "");
+  // A reference may only be bound to an lvalue
+  static_assert(std::is_constructible<result<const big &>, const big &>::value, "");
+  static_assert(!std::is_convertible<result<int>, result<const int &>>::value, "");
+  static_assert(!std::is_constructible<result<const int &>, OUTCOME_V2_NAMESPACE::success_type<int>>::value, "");
+
+  std::map<std::string, big> table;
+  table["a"].data[0] = 5;
+  big::copies = 0;
+  {
+    auto r = lookup(table, "a");
+    BOOST_CHECK(r.has_value());
+    BOOST_CHECK(&r.value() == &table["a"]);
+    BOOST_CHECK(&r.assume_value() == &table["a"]);
+    BOOST_CHECK(lookup(table, "b").error() == std::errc::no_such_file_or_directory);
+    BOOST_CHECK(first(table, "a").value() == 5);
+    BOOST_CHECK(first(table, "b").error() == std::errc::no_such_file_or_directory);
+    BOOST_CHECK(big::copies == 0);
+  }
+  {
+    // Writes go through to the object referred to, and assignment rebinds
+    int x = 1, y = 2;
+    result<int &> r(x);
+    r.value() = 3;
+    BOOST_CHECK(x == 3);
+    r = result<int &>(y);
+    r.value() = 4;
+    BOOST_CHECK(x == 3 && y == 4);
+    // Converts to a reference to const, and compares as the value referred to
+    result<const int &> c(r);
+    BOOST_CHECK(&c.value() == &y);
+    int z = 4;
+    BOOST_CHECK(c == result<const int &>(z));
+    BOOST_CHECK(c != result<const int &>(x));
+    BOOST_CHECK(c == OUTCOME_V2_NAMESPACE::success(4));
+    // Copies the value out into a result of the value
+    result<long> l(c);
+    BOOST_CHECK(l.value() == 4);
+  }
+#ifdef __cpp_exceptions
+  {
+    result<int &> r(std::make_error_code(std::errc::invalid_argument));
+    BOOST_CHECK_THROW(r.value(), std::system_error);
+  }
+#endif
+}
@@ -0,0 +1,137 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/result_cache.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace result_cache_test
+{
+  // A clock which only moves when told to
+  struct manual_clock
+  {
+    using duration = std::chrono::milliseconds;
+    using rep = duration::rep;
+    using period = duration::period;
+    using time_point = std::chrono::time_point<manual_clock>;
+    static constexpr bool is_steady = true;
+    static time_point &current()
+    {
+      static time_point v;
+      return v;
+    }
+    static time_point now() noexcept { return current(); }
+    static void advance(duration d) { current() += d; }
+  };
+  using cache_type = OUTCOME_V2_NAMESPACE::result_cache<int, int, std::error_code, 4, std::hash<int>, std::equal_to<int>, manual_clock>;
+}  // namespace result_cache_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result_cache, "Tests that result_cache keeps failures for less time than successes")
+{
+  using namespace result_cache_test;
+  using OUTCOME_V2_NAMESPACE::result;
+  cache_type cache(std::chrono::milliseconds(1000), std::chrono::milliseconds(10));
+  int calls = 0;
+  auto succeed = [&]() -> result<int> { ++calls; return 5; };
+  auto fail = [&]() -> result<int> { ++calls; return std::make_error_code(std::errc::connection_refused); };
+
+  BOOST_CHECK(cache.get_or_compute(1, succeed).value() == 5);
+  BOOST_CHECK(cache.get_or_compute(1, succeed).value() == 5);
+  BOOST_CHECK(calls == 1);
+  BOOST_CHECK(cache.get_or_compute(2, fail).error() == std::errc::connection_refused);
+  BOOST_CHECK(cache.get_or_compute(2, fail).error() == std::errc::connection_refused);
+  BOOST_CHECK(calls == 2);
+  BOOST_CHECK(cache.size() == 2);
+
+  // The failure expires first
+  manual_clock::advance(std::chrono::milliseconds(10));
+  result<int> r(0);
+  BOOST_CHECK(!cache.find(2, r));
+  BOOST_CHECK(cache.find(1, r));
+  BOOST_CHECK(r.value() == 5);
+  BOOST_CHECK(cache.get_or_compute(2, succeed).value() == 5);
+  BOOST_CHECK(calls == 3);
+  manual_clock::advance(std::chrono::milliseconds(1000));
+  cache.purge();
+  BOOST_CHECK(cache.size() == 0);
+
+  cache.insert(3, result<int>(7));
+  BOOST_CHECK(cache.find(3, r) && r.value() == 7);
+  cache.erase(3);
+  BOOST_CHECK(!cache.find(3, r));
+
+#ifdef __cpp_exceptions
+  // A computation which throws caches nothing
+  BOOST_CHECK_THROW(BOOST_CHECK(!cache.get_or_compute(4, []() -> result<int> { throw std::runtime_error("x"); })), std::runtime_error);
+  BOOST_CHECK(cache.get_or_compute(4, succeed).value() == 5);
+#endif
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result_cache / coalescing, "Tests that result_cache computes a key missed by many threads at once only once")
+{
+  using namespace result_cache_test;
+  using OUTCOME_V2_NAMESPACE::result;
+  // Failures are not cached, but concurrent misses still share the one computation
+  cache_type cache(std::chrono::milliseconds(1000), std::chrono::milliseconds(0));
+  std::atomic<int> calls{0}, failures{0}, arrived{0};
+  std::atomic<bool> go{false};
+  std::vector<std::thread> threads;
+  for(int n = 0; n < 8; n++)
+  {
+    threads.emplace_back([&] {
+      while(!go)
+      {
+        std::this_thread::yield();
+      }
+      ++arrived;
+      auto r = cache.get_or_compute(9, [&]() -> result<int> {
+        ++calls;
+        // Until every thread is surely waiting
+        while(arrived < 8)
+        {
+          std::this_thread::yield();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        return std::make_error_code(std::errc::connection_refused);
+      });
+      if(r.has_error())
+      {
+        ++failures;
+      }
+    });
+  }
+  go = true;
+  for(auto &t : threads)
+  {
+    t.join();
+  }
+  BOOST_CHECK(calls == 1);
+  BOOST_CHECK(failures == 8);
+  // Once done, the failure is forgotten
+  result<int> r(0);
+  BOOST_CHECK(!cache.find(9, r));
+}
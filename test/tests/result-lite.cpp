@@ -0,0 +1,77 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/result_lite.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+namespace result_lite_test
+{
+  enum class parse_error
+  {
+    empty = 1,
+    bad_digit
+  };
+  OUTCOME_V2_NAMESPACE::result<int, parse_error> parse(const char *s)
+  {
+    if(*s == 0)
+    {
+      return parse_error::empty;
+    }
+    int ret = 0;
+    for(; *s != 0; ++s)
+    {
+      if(*s < '0' || *s > '9')
+      {
+        return parse_error::bad_digit;
+      }
+      ret = ret * 10 + (*s - '0');
+    }
+    return ret;
+  }
+  OUTCOME_V2_NAMESPACE::result<int, parse_error> twice(const char *s)
+  {
+    OUTCOME_TRY(v, parse(s));
+    return v * 2;
+  }
+}  // namespace result_lite_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / lite, "Tests that the result lite edition works with a custom error type")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using namespace result_lite_test;
+  static_assert(!trait::has_error_code_v<parse_error>, "a custom error type has an error code!");
+  static_assert(std::is_same<policy::default_policy<int, parse_error, void>, policy::all_narrow>::value, "the default policy is not all_narrow!");
+  static_assert(std::is_same<policy::default_policy<void, void, void>, policy::terminate>::value, "the default policy of result<void, void> is not terminate!");
+
+  BOOST_CHECK(parse("42").value() == 42);
+  BOOST_CHECK(parse("").error() == parse_error::empty);
+  BOOST_CHECK(parse("4x").error() == parse_error::bad_digit);
+  BOOST_CHECK(twice("21").value() == 42);
+  BOOST_CHECK(twice("x").error() == parse_error::bad_digit);
+
+  result<int, parse_error> a(success(5)), b(failure(parse_error::empty));
+  BOOST_CHECK(a.has_value());
+  BOOST_CHECK(b.has_error());
+  unchecked<long, parse_error> c(a);
+  BOOST_CHECK(c.value() == 5);
+}
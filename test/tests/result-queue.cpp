@@ -0,0 +1,160 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/result_queue.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result_queue, "Tests that the result queues work as intended")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  {
+    // Trivially copyable results, errors keep their codes
+    spsc_result_queue<int, std::errc, 4> q;
+    BOOST_CHECK(q.empty());
+    BOOST_CHECK(q.try_push(result<int, std::errc>(1)));
+    BOOST_CHECK(q.try_push(result<int, std::errc>(std::errc::invalid_argument)));
+    std::vector<result<int, std::errc>> in{result<int, std::errc>(3), result<int, std::errc>(4), result<int, std::errc>(5)};
+    BOOST_CHECK(q.try_push_n(in.begin(), in.size()) == 2);
+    std::vector<result<int, std::errc>> out(5, result<int, std::errc>(0));
+    BOOST_CHECK(q.try_pop_n(out.begin(), 5) == 4);
+    BOOST_CHECK(q.empty());
+    BOOST_CHECK(out[0].value() == 1);
+    BOOST_CHECK(out[1].error() == std::errc::invalid_argument);
+    BOOST_CHECK(out[3].value() == 4);
+    BOOST_CHECK(!q.try_pop(out[4]));
+  }
+  {
+    // Non trivial results are moved in and destroyed if left queued
+    auto counter = std::make_shared<int>(0);
+    {
+      mpmc_result_queue<std::shared_ptr<int>, std::error_code, 4> q;
+      result<std::shared_ptr<int>> r(counter);
+      BOOST_CHECK(q.try_push(std::move(r)));
+      BOOST_CHECK(q.try_push(result<std::shared_ptr<int>>(counter)));
+      BOOST_CHECK(q.try_push(result<std::shared_ptr<int>>(std::errc::no_such_file_or_directory)));
+      BOOST_CHECK(counter.use_count() == 3);
+      result<std::shared_ptr<int>> out(nullptr);
+      BOOST_CHECK(q.try_pop(out));
+      BOOST_CHECK(out.value() == counter);
+    }
+    BOOST_CHECK(counter.use_count() == 1);
+  }
+  {
+    // The smallest queue reports full and empty at exactly its edges, over several laps
+    mpmc_result_queue<int, std::error_code, 2> q;
+    result<int> out(0);
+    for(int lap = 0; lap < 3; lap++)
+    {
+      BOOST_CHECK(!q.try_pop(out));
+      BOOST_CHECK(q.try_push(result<int>(lap)));
+      BOOST_CHECK(q.try_push(result<int>(lap + 10)));
+      BOOST_CHECK(!q.try_push(result<int>(lap + 20)));
+      BOOST_CHECK(q.try_pop(out) && out.value() == lap);
+      BOOST_CHECK(q.try_push(result<int>(lap + 30)));
+      BOOST_CHECK(!q.try_push(result<int>(lap + 40)));
+      BOOST_CHECK(q.try_pop(out) && out.value() == lap + 10);
+      BOOST_CHECK(q.try_pop(out) && out.value() == lap + 30);
+    }
+    BOOST_CHECK(!q.try_pop(out));
+  }
+  {
+    // Many pushers and poppers lose and duplicate nothing
+    mpmc_result_queue<int, std::error_code, 64> q;
+    constexpr int per_thread = 20000;
+    std::atomic<long long> sum{0};
+    std::atomic<int> popped{0}, errors{0};
+    std::vector<std::thread> threads;
+    for(int t = 0; t < 4; t++)
+    {
+      threads.emplace_back([&q] {
+        result<int> batch[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+        for(int n = 0; n < per_thread;)
+        {
+          const int count = std::min(8, per_thread - n);
+          for(int i = 0; i < count; i++)
+          {
+            batch[i] = ((n + i) % 100 == 99) ? result<int>(std::errc::invalid_argument) : result<int>(n + i);
+          }
+          n += static_cast<int>(q.try_push_n(batch, count));
+        }
+      });
+      threads.emplace_back([&] {
+        result<int> batch[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+        while(popped < 4 * per_thread)
+        {
+          const size_t count = q.try_pop_n(batch, 8);
+          for(size_t i = 0; i < count; i++)
+          {
+            if(batch[i])
+            {
+              sum += batch[i].value();
+            }
+            else if(batch[i].error() == std::errc::invalid_argument)
+            {
+              ++errors;
+            }
+          }
+          popped += static_cast<int>(count);
+        }
+      });
+    }
+    for(auto &t : threads)
+    {
+      t.join();
+    }
+    long long expected = 0;
+    for(int n = 0; n < per_thread; n++)
+    {
+      expected += (n % 100 == 99) ? 0 : n;
+    }
+    BOOST_CHECK(popped == 4 * per_thread);
+    BOOST_CHECK(errors == 4 * per_thread / 100);
+    BOOST_CHECK(sum == 4 * expected);
+  }
+  {
+    // One pusher and one popper
+    spsc_result_queue<std::string, std::error_code, 16> q;
+    std::thread pusher([&q] {
+      for(int n = 0; n < 10000;)
+      {
+        n += q.try_push(result<std::string>(std::to_string(n))) ? 1 : 0;
+      }
+    });
+    result<std::string> r(std::string{});
+    for(int n = 0; n < 10000;)
+    {
+      if(q.try_pop(r))
+      {
+        BOOST_CHECK(r.value() == std::to_string(n));
+        n++;
+      }
+    }
+    pusher.join();
+  }
+}
@@ -0,0 +1,160 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/outcome.hpp"
+#include "../../include/outcome/result_vector.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <iterator>
+#include <string>
+#include <vector>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result_vector, "Tests that result_vector works as intended")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  result_vector<int> v;
+  BOOST_CHECK(v.empty());
+  BOOST_CHECK(v.all_succeeded());
+  BOOST_CHECK(v.first_failure() == 0);
+  BOOST_CHECK(v.count_failures() == 0);
+
+  // Cross several bitmap words
+  v.reserve(200);
+  for(int n = 0; n < 200; n++)
+  {
+    v.push_back(n);
+  }
+  BOOST_CHECK(v.size() == 200);
+  BOOST_CHECK(v.all_succeeded());
+  BOOST_CHECK(v.first_failure() == 200);
+  v[130] = result<int>(std::errc::invalid_argument);
+  v.push_back(std::errc::no_such_file_or_directory);
+  BOOST_CHECK(!v.all_succeeded());
+  BOOST_CHECK(v.first_failure() == 130);
+  BOOST_CHECK(v.count_failures() == 2);
+  BOOST_CHECK(v[129].has_value());
+  BOOST_CHECK(v[129].value() == 129);
+  BOOST_CHECK(v[130].has_error());
+  BOOST_CHECK(v[130].error() == std::errc::invalid_argument);
+  BOOST_CHECK(v[200].error() == std::errc::no_such_file_or_directory);
+  result<int> r = v[130];
+  BOOST_CHECK(r.error() == std::errc::invalid_argument);
+  v[130] = result<int>(5);
+  BOOST_CHECK(v[130].value() == 5);
+  BOOST_CHECK(v.first_failure() == 200);
+  BOOST_CHECK(v.count_failures() == 1);
+#ifdef __cpp_exceptions
+  try
+  {
+    v[200].value();
+    BOOST_CHECK(false);
+  }
+  catch(const std::system_error &e)
+  {
+    BOOST_CHECK(e.code() == std::errc::no_such_file_or_directory);
+  }
+#endif
+
+  // Proxies can be read only, and hold non-trivial types
+  const auto &cv = v;
+  BOOST_CHECK(cv[5].value() == 5);
+  result_vector<std::string, int> s;
+  s.push_back(std::string("hello"));
+  s.push_back(5);
+  BOOST_CHECK(s[0].value() == "hello");
+  BOOST_CHECK(s[1].error() == 5);
+  s[0].value() += " world";
+  BOOST_CHECK(s[0].assume_value() == "hello world");
+  v.clear();
+  BOOST_CHECK(v.empty());
+  BOOST_CHECK(v.all_succeeded());
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result_vector / for_each, "Tests that the prefetching iteration of result_vector visits the right items")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  // Large values span several cache lines, and the last bitmap word is partly in use
+  struct big
+  {
+    int v[40];
+  };
+  result_vector<int> v;
+  result_vector<big, int> b;
+  for(int n = 0; n < 1000; n++)
+  {
+    if(n % 7 == 3)
+    {
+      v.push_back(std::errc::invalid_argument);
+      b.push_back(result<big, int>(in_place_type<int>, n));
+    }
+    else
+    {
+      v.push_back(n);
+      b.push_back(big{{n}});
+    }
+  }
+  for(size_t distance : {size_t(0), size_t(1), size_t(64), size_t(512), size_t(100000)})
+  {
+    size_t values = 0, errors = 0, next = 0;
+    bool ok = true;
+    v.for_each_value(
+    [&](size_t idx, const int &x) {
+      ok &= idx >= next && idx % 7 != 3 && x == static_cast<int>(idx);
+      next = idx + 1;
+      values++;
+    },
+    distance);
+    v.for_each_error(
+    [&](size_t idx, const std::error_code &ec) {
+      ok &= idx % 7 == 3 && ec == std::errc::invalid_argument;
+      errors++;
+    },
+    distance);
+    b.for_each_value([&](size_t idx, const big &x) { ok &= x.v[0] == static_cast<int>(idx) && x.v[39] == 0; }, distance);
+    b.for_each_error([&](size_t idx, int e) { ok &= e == static_cast<int>(idx); }, distance);
+    BOOST_CHECK(ok);
+    BOOST_CHECK(values + errors == 1000);
+    BOOST_CHECK(errors == v.count_failures());
+  }
+  // Values can be changed in place
+  v.for_each_value([](size_t /*unused*/, int &x) { x = -x; });
+  BOOST_CHECK(v[999].value() == -999);
+
+  std::vector<int> out;
+  auto r = v.unwrap_all(std::back_inserter(out));
+  BOOST_CHECK(r.error() == std::errc::invalid_argument);
+  BOOST_CHECK(out.size() == 3);
+  result_vector<int> all;
+  for(int n = 0; n < 130; n++)
+  {
+    all.push_back(n);
+  }
+  out.clear();
+  BOOST_CHECK(all.unwrap_all(std::back_inserter(out), 0).value() == 130);
+  BOOST_CHECK(out.size() == 130 && out[129] == 129);
+  all[64] = result<int>(std::errc::timed_out);
+  out.clear();
+  BOOST_CHECK(all.unwrap_all(std::back_inserter(out)).error() == std::errc::timed_out);
+  BOOST_CHECK(out.size() == 64);
+  BOOST_CHECK(result_vector<int>().unwrap_all(std::back_inserter(out)).value() == 0);
+}
@@ -0,0 +1,162 @@
+/* Unit testing for retry()
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/outcome.hpp"
+#include "../../include/outcome/retry.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+namespace retry_test
+{
+  struct recorded_sleep
+  {
+    std::vector<std::chrono::nanoseconds> *delays;
+    void operator()(std::chrono::nanoseconds d) const { delays->push_back(d); }
+  };
+}  // namespace retry_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_retry, "Tests that retry() retries retryable failures with bounded, growing backoff")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using retry_test::recorded_sleep;
+  const auto timed_out = make_error_code(std::errc::timed_out);
+  const auto refused = make_error_code(std::errc::connection_refused);
+  const auto invalid = make_error_code(std::errc::invalid_argument);
+
+  {
+    // Succeeding after two retryable failures
+    std::vector<std::chrono::nanoseconds> delays;
+    int calls = 0;
+    auto policy = make_retry_policy(retry_on(std::errc::timed_out, std::errc::connection_refused), 5, std::chrono::microseconds(100), std::chrono::microseconds(150));
+    result<int> r = retry(
+    policy,
+    [&]() -> result<int> {
+      switch(++calls)
+      {
+      case 1:
+        return timed_out;
+      case 2:
+        return refused;
+      default:
+        return 42;
+      }
+    },
+    recorded_sleep{&delays});
+    BOOST_CHECK(r.has_value());
+    BOOST_CHECK(r.value() == 42);
+    BOOST_CHECK(calls == 3);
+    BOOST_REQUIRE(delays.size() == 2U);
+    BOOST_CHECK(delays[0] <= std::chrono::microseconds(100));
+    BOOST_CHECK(delays[1] <= std::chrono::microseconds(150));
+#ifndef OUTCOME_ENABLE_COMPACT_STATUS
+    BOOST_CHECK(retry_attempts(r) == 3);
+#endif
+  }
+  {
+    // Not retrying errors the policy does not classify as retryable
+    std::vector<std::chrono::nanoseconds> delays;
+    int calls = 0;
+    auto policy = make_retry_policy(retry_on(std::errc::timed_out), 5);
+    result<int> r = retry(
+    policy,
+    [&]() -> result<int> {
+      ++calls;
+      return invalid;
+    },
+    recorded_sleep{&delays});
+    BOOST_CHECK(r.has_error());
+    BOOST_CHECK(r.error() == invalid);
+    BOOST_CHECK(calls == 1);
+    BOOST_CHECK(delays.empty());
+#ifndef OUTCOME_ENABLE_COMPACT_STATUS
+    BOOST_CHECK(retry_attempts(r) == 1);
+#endif
+  }
+  {
+    // Giving up after max_attempts, returning the last failure
+    std::vector<std::chrono::nanoseconds> delays;
+    int calls = 0;
+    retry_policy<> policy;
+    policy.max_attempts = 4;
+    policy.initial_backoff = std::chrono::microseconds(10);
+    policy.max_backoff = std::chrono::microseconds(1000);
+    result<int> r = retry(
+    policy,
+    [&]() -> result<int> {
+      ++calls;
+      return timed_out;
+    },
+    recorded_sleep{&delays});
+    BOOST_CHECK(r.error() == timed_out);
+    BOOST_CHECK(calls == 4);
+    BOOST_REQUIRE(delays.size() == 3U);
+    for(size_t n = 0; n < delays.size(); n++)
+    {
+      BOOST_CHECK(delays[n] <= std::chrono::microseconds(10 << n));
+    }
+#ifndef OUTCOME_ENABLE_COMPACT_STATUS
+    BOOST_CHECK(retry_attempts(r) == 4);
+#endif
+  }
+  {
+    // The backoff doubles to the cap, never exceeding it
+    retry_policy<> policy;
+    policy.initial_backoff = std::chrono::microseconds(1);
+    policy.max_backoff = std::chrono::microseconds(64);
+    for(unsigned attempt = 1; attempt < 100; attempt++)
+    {
+      const auto d = policy.backoff(attempt);
+      BOOST_CHECK(d >= std::chrono::nanoseconds(0));
+      BOOST_CHECK(d <= std::chrono::microseconds((attempt <= 7) ? (1 << (attempt - 1)) : 64));
+    }
+    policy.initial_backoff = std::chrono::nanoseconds(0);
+    BOOST_CHECK(policy.backoff(5) == std::chrono::nanoseconds(0));
+  }
+  {
+    // Outcomes failing with an exception are not retried
+    int calls = 0;
+    outcome<int> o = retry(retry_policy<>{}, [&]() -> outcome<int> {
+      ++calls;
+      return std::make_exception_ptr(std::runtime_error("boom"));
+    });
+    BOOST_CHECK(o.has_exception());
+    BOOST_CHECK(calls == 1);
+  }
+  {
+    // Sleeping for real between attempts by default
+    int calls = 0;
+    auto policy = make_retry_policy(retry_always(), 2, std::chrono::microseconds(1), std::chrono::microseconds(1));
+    result<int> r = retry(policy, [&]() -> result<int> {
+      if(++calls == 1)
+      {
+        return timed_out;
+      }
+      return 5;
+    });
+    BOOST_CHECK(r.value() == 5);
+    BOOST_CHECK(calls == 2);
+  }
+}
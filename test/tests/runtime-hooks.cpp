@@ -0,0 +1,78 @@
+/* Unit testing for runtime hooks
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/runtime_hooks.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+namespace runtime_hooks_test
+{
+  static int events[4];
+  static long last_code;
+  static void count(const OUTCOME_V2_NAMESPACE::runtime_hook_event &e)
+  {
+    ++events[static_cast<int>(e.kind)];
+    last_code = e.code;
+  }
+}  // namespace runtime_hooks_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / runtime_hooks, "Tests that runtime hooks can be switched on and off")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using namespace runtime_hooks_test;
+  BOOST_CHECK(current_runtime_hook() == nullptr);
+  {
+    // Nothing is reported whilst no hook is set
+    runtime_hooked_result<int> a(5), b(std::make_error_code(std::errc::timed_out));
+    (void) a;
+    (void) b;
+  }
+  BOOST_CHECK(events[0] + events[1] + events[2] + events[3] == 0);
+
+  BOOST_CHECK(set_runtime_hook(count) == nullptr);
+  BOOST_CHECK(current_runtime_hook() == &count);
+  {
+    runtime_hooked_result<int> a(5);
+    BOOST_CHECK(events[static_cast<int>(runtime_hook_kind::success)] == 1);
+    runtime_hooked_result<int> b(std::make_error_code(std::errc::timed_out));
+    BOOST_CHECK(events[static_cast<int>(runtime_hook_kind::failure)] == 1);
+    BOOST_CHECK(last_code == static_cast<long>(std::errc::timed_out));
+    runtime_hooked_result<long> c(b);
+    BOOST_CHECK(events[static_cast<int>(runtime_hook_kind::copy)] == 1);
+    runtime_hooked_result<long> d(std::move(a));
+    BOOST_CHECK(events[static_cast<int>(runtime_hook_kind::move)] == 1);
+    runtime_hooked_result<int> e(in_place_type<std::error_code>, std::make_error_code(std::errc::io_error));
+    BOOST_CHECK(events[static_cast<int>(runtime_hook_kind::failure)] == 2);
+    BOOST_CHECK(last_code == static_cast<long>(std::errc::io_error));
+    // Results without the hook policy are unaffected
+    result<int> f(std::make_error_code(std::errc::io_error));
+    (void) f;
+    BOOST_CHECK(events[static_cast<int>(runtime_hook_kind::failure)] == 2);
+  }
+
+  BOOST_CHECK(set_runtime_hook(nullptr) == &count);
+  {
+    runtime_hooked_result<int> a(std::make_error_code(std::errc::timed_out));
+    (void) a;
+  }
+  BOOST_CHECK(events[static_cast<int>(runtime_hook_kind::failure)] == 2);
+}
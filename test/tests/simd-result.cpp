@@ -0,0 +1,89 @@
+/* Unit testing for lane masked batches of results
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/simd_result.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / simd_result, "Tests that lane masked batches of results propagate failures through their masks")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using batch = simd_result<int, 8>;
+  static_assert(sizeof(batch::mask_type) == 1, "an eight lane mask is not a byte");
+  static_assert(sizeof(simd_result<float, 16>::mask_type) == 2, "a sixteen lane mask is not two bytes");
+  static_assert(batch::all_lanes == 0xff, "all_lanes is wrong");
+  static_assert(simd_result<int, 64>::all_lanes == ~uint64_t(0), "all_lanes is wrong for 64 lanes");
+
+  batch a(std::array<int, 8>{{1, 2, 3, 4, 5, 6, 7, 8}});
+  BOOST_CHECK(a.all_succeeded());
+  BOOST_CHECK(a.first_failure() == 8);
+  a.set_error(2, make_error_code(std::errc::invalid_argument));
+  BOOST_CHECK(a.failure_mask() == 0x04);
+  BOOST_CHECK(a.success_mask() == 0xfb);
+  BOOST_CHECK(a.count_failures() == 1);
+  BOOST_CHECK(a.first_failure() == 2);
+  BOOST_CHECK(a.value(1) == 2);
+  BOOST_CHECK(a.error(2) == std::errc::invalid_argument);
+  BOOST_CHECK_THROW(a.value(2), std::system_error);
+  BOOST_CHECK_THROW(a.error(1), bad_result_access);
+
+  // map() keeps the mask and errors
+  auto b = a.map([](int v) { return v * 2.0; });
+  static_assert(std::is_same<decltype(b), simd_result<double, 8>>::value, "map() has the wrong type");
+  BOOST_CHECK(b.failure_mask() == 0x04);
+  BOOST_CHECK(b.value(7) == 16.0);
+  BOOST_CHECK(b.error(2) == std::errc::invalid_argument);
+
+  // and_then() adds the failures f returns, keeping the first error of each lane
+  auto c = a.and_then([](int v) -> result<int> {
+    if(v % 3 == 0)
+    {
+      return std::errc::result_out_of_range;
+    }
+    return v + 1;
+  });
+  BOOST_CHECK(c.failure_mask() == 0x24);
+  BOOST_CHECK(c.error(2) == std::errc::invalid_argument);
+  BOOST_CHECK(c.error(5) == std::errc::result_out_of_range);
+  BOOST_CHECK(c.value(0) == 2);
+
+  // combine() merges the masks of two batches
+  batch d;
+  d.set_error(0, make_error_code(std::errc::io_error));
+  d.set_error(2, make_error_code(std::errc::io_error));
+  auto e = c.combine(d, [](int x, int y) { return x + y; });
+  BOOST_CHECK(e.failure_mask() == 0x25);
+  BOOST_CHECK(e.error(0) == std::errc::io_error);
+  BOOST_CHECK(e.error(2) == std::errc::invalid_argument);
+
+  // Scattering to and gathering from scalar results
+  std::array<result<int>, 8> s = e.to_array();
+  BOOST_CHECK(s[1].value() == 3);
+  BOOST_CHECK(s[5].error() == std::errc::result_out_of_range);
+  batch f(s);
+  BOOST_CHECK(f.failure_mask() == e.failure_mask());
+  BOOST_CHECK(f.values()[1] == 3);
+  f.set_value(0, 9);
+  BOOST_CHECK(f.failure_mask() == 0x24);
+  BOOST_CHECK(f[0].value() == 9);
+}
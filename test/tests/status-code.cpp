@@ -0,0 +1,140 @@
+/* Unit testing for status_code
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/status_code.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <cstring>
+
+namespace status_code_test
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+
+  constexpr const char *http_message(int c) noexcept
+  {
+    switch(c)
+    {
+    case 404:
+      return "Not Found";
+    case 503:
+      return "Service Unavailable";
+    default:
+      return "Unknown";
+    }
+  }
+  template <class T = void> struct domains
+  {
+    static constexpr status_domain http{0x5d4c8bd4a1e2f307ULL, "http", http_message, nullptr};
+  };
+  template <class T> constexpr status_domain domains<T>::http;
+  // A copy, as a domain duplicated into another shared library would be
+  constexpr status_domain http_copy{0x5d4c8bd4a1e2f307ULL, "http", http_message, nullptr};
+
+  constexpr bool same_text(const char *a, const char *b)
+  {
+    for(; *a != 0 && *a == *b; ++a, ++b)
+    {
+    }
+    return *a == *b;
+  }
+
+  constexpr result<int, status_code> fetch(int n)
+  {
+    if(n < 0)
+    {
+      return status_code(404, domains<>::http);
+    }
+    if(n == 0)
+    {
+      return std::errc::invalid_argument;
+    }
+    return n * 2;
+  }
+  constexpr int sum_fetched(int a, int b)
+  {
+    const auto x = fetch(a), y = fetch(b);
+    return (x ? x.value() : 0) + (y ? y.value() : 0);
+  }
+
+  // Everything up to the message of a failed result is evaluated at compile time
+  static_assert(fetch(3).value() == 6, "");
+  static_assert(fetch(-1).has_error(), "");
+  static_assert(fetch(-1).error() == status_code(404, domains<>::http), "");
+  static_assert(fetch(-1).error() == status_code(404, http_copy), "");
+  static_assert(fetch(-1).error() != status_code(503, domains<>::http), "");
+  static_assert(fetch(0).error() == std::errc::invalid_argument, "");
+  static_assert(fetch(0).error().is_errno(), "");
+  static_assert(!fetch(-1).error().is_errno(), "");
+  static_assert(same_text(fetch(-1).error().message(), "Not Found"), "");
+  static_assert(same_text(fetch(0).error().message(), "Invalid argument"), "");
+  static_assert(sum_fetched(1, -1) == 2, "");
+  static_assert(!status_code(), "");
+  static_assert(status_code() != status_code(0, generic_status_domain()), "");
+}  // namespace status_code_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_status_code, "Tests that status_code works as a constexpr error type interoperating with std::error_code")
+{
+  using namespace status_code_test;
+  static_assert(sizeof(status_code) <= 16, "status_code is larger than sixteen bytes");
+  static_assert(std::is_trivially_copyable<result<int, status_code>>::value, "result<int, status_code> is not trivially copyable");
+  static_assert(trait::has_error_code_v<status_code>, "status_code does not convert to error_code");
+
+  // The generic domain converts to the generic category
+  const status_code einval(std::errc::invalid_argument);
+  BOOST_CHECK(einval.to_error_code() == std::errc::invalid_argument);
+  BOOST_CHECK(einval == make_error_code(std::errc::invalid_argument));
+  BOOST_CHECK(&einval.to_error_code().category() == &std::generic_category());
+  BOOST_CHECK(strcmp(status_code(ENOENT, generic_status_domain()).message(), "No such file or directory") == 0);
+  BOOST_CHECK(strcmp(status_code(123456, generic_status_domain()).message(), "Unknown error") == 0);
+  BOOST_CHECK(!status_code().to_error_code());
+
+  // A domain without a category has one synthesised, the same for copies of the domain
+  const status_code nf(404, domains<>::http);
+  const std::error_code ec = nf.to_error_code();
+  BOOST_CHECK(ec.value() == 404);
+  BOOST_CHECK(strcmp(ec.category().name(), "http") == 0);
+  BOOST_CHECK(ec.message() == "Not Found");
+  BOOST_CHECK(&status_code(503, http_copy).to_error_code().category() == &ec.category());
+  BOOST_CHECK(nf == ec);
+  BOOST_CHECK(nf != std::error_code(404, std::generic_category()));
+
+  // Results know errno values, and throw as system_error
+  result<int, status_code> r(std::errc::invalid_argument), s(nf);
+  BOOST_CHECK((r.__state().status() & detail::status_error_is_errno) != 0);
+  BOOST_CHECK((s.__state().status() & detail::status_error_is_errno) == 0);
+#ifdef __cpp_exceptions
+  try
+  {
+    s.value();
+    BOOST_CHECK(false);
+  }
+  catch(const std::system_error &e)
+  {
+    BOOST_CHECK(e.code() == ec);
+  }
+#endif
+#ifdef __cpp_lib_string_view
+  BOOST_CHECK(nf.message_view() == "Not Found");
+#endif
+}
@@ -0,0 +1,98 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/outcome.hpp"
+#include "../../include/outcome/stop_token.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+namespace stop_token_test
+{
+  using OUTCOME_V2_NAMESPACE::outcome;
+  using OUTCOME_V2_NAMESPACE::result;
+  using OUTCOME_V2_NAMESPACE::stop_token;
+  static int steps;
+  inline result<int> step(int v)
+  {
+    ++steps;
+    return v + 1;
+  }
+  inline result<int> pipeline(stop_token token)
+  {
+    OUTCOME_TRY_CANCELLABLE(token, a, step(0));
+    OUTCOME_TRY_CANCELLABLE(token, b, step(a));
+    OUTCOME_TRYV_CANCELLABLE(token, step(b));
+    return b;
+  }
+  inline outcome<void> pipelinev(stop_token token)
+  {
+    OUTCOME_TRYV_CANCELLABLE(token, step(0));
+    return OUTCOME_V2_NAMESPACE::success();
+  }
+}  // namespace stop_token_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / stop_token, "Tests that chains of TRY operations can be cancelled")
+{
+  using namespace stop_token_test;
+  using OUTCOME_V2_NAMESPACE::cancellation_errc;
+  using OUTCOME_V2_NAMESPACE::stop_source;
+  {
+    // A default constructed token never stops
+    stop_token token;
+    BOOST_CHECK(!token.stop_possible());
+    steps = 0;
+    BOOST_CHECK(pipeline(token).value() == 2);
+    BOOST_CHECK(steps == 3);
+  }
+  {
+    stop_source source;
+    stop_token token = source.get_token();
+    BOOST_CHECK(token.stop_possible());
+    BOOST_CHECK(!token.stop_requested());
+    BOOST_CHECK(source.request_stop());
+    BOOST_CHECK(!source.request_stop());
+    BOOST_CHECK(token.stop_requested());
+    // No step runs once stopped
+    steps = 0;
+    auto r = pipeline(token);
+    BOOST_CHECK(steps == 0);
+    BOOST_CHECK(r.error() == cancellation_errc::cancelled);
+    BOOST_CHECK(r.error() == std::errc::operation_canceled);
+    BOOST_CHECK(r.error().category() == OUTCOME_V2_NAMESPACE::cancellation_category());
+    BOOST_CHECK(pipelinev(token).error() == cancellation_errc::cancelled);
+    BOOST_CHECK(steps == 0);
+  }
+  {
+    // A stop requested part way through skips the remaining steps
+    stop_source source;
+    steps = 0;
+    auto r = [&source]() -> result<int> {
+      OUTCOME_TRY_CANCELLABLE(source.get_token(), a, step(0));
+      source.request_stop();
+      OUTCOME_TRY_CANCELLABLE(source.get_token(), b, step(a));
+      return b;
+    }();
+    BOOST_CHECK(steps == 1);
+    BOOST_CHECK(r.error() == cancellation_errc::cancelled);
+  }
+}
@@ -21,10 +21,12 @@ Distributed under the Boost Software License, Version 1.0.
           http://www.boost.org/LICENSE_1_0.txt)
 */
 
+#include "../../include/outcome/outcome.hpp"
 #include "../../include/outcome/success_failure.hpp"
 #include "quickcpplib/include/boost/test/unit_test.hpp"
 
 #include <iostream>
+#include <string>
 
 BOOST_OUTCOME_AUTO_TEST_CASE(works / success - failure, "Tests that the success and failure type sugars work as intended")
 {
@@ -58,3 +60,67 @@ BOOST_OUTCOME_AUTO_TEST_CASE(works / success - failure, "Tests that the success
     static_assert(std::is_same<decltype(c)::exception_type, int>::value, "");
   }
 }
+
+namespace success_failure_test
+{
+  // Neither copyable nor movable, so only constructible in place
+  struct pinned
+  {
+    std::string name;
+    int value;
+    pinned(std::string n, int v)
+        : name(std::move(n))
+        , value(v)
+    {
+    }
+    pinned(const pinned &) = delete;
+    pinned(pinned &&) = delete;
+    pinned &operator=(const pinned &) = delete;
+    pinned &operator=(pinned &&) = delete;
+  };
+#if __cplusplus >= 201700L || _HAS_CXX17
+  inline OUTCOME_V2_NAMESPACE::result<pinned> make_pinned(int v)
+  {
+    using namespace OUTCOME_V2_NAMESPACE;
+    if(v < 0)
+    {
+      return failure_in_place(EINVAL, std::generic_category());
+    }
+    std::string name("pinned");
+    return success_in_place(name, v);
+  }
+#endif
+}  // namespace success_failure_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / success - failure / in - place, "Tests that the in place success and failure type sugars construct directly inside the result")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using namespace success_failure_test;
+  {
+    std::string name("hello");
+    result<std::string> a = success_in_place(name, 1, 3);
+    BOOST_CHECK(a.value() == "ell");
+    BOOST_CHECK(name == "hello");
+    result<std::string> b = success_in_place(std::move(name));
+    BOOST_CHECK(b.value() == "hello");
+    result<void> c = success_in_place();
+    BOOST_CHECK(c);
+    result<std::string> d = failure_in_place(ENOENT, std::generic_category());
+    BOOST_CHECK(d.error() == std::errc::no_such_file_or_directory);
+    outcome<std::string> e = success_in_place(3, 'x');
+    BOOST_CHECK(e.value() == "xxx");
+    outcome<std::string> f = failure_in_place(ENOENT, std::generic_category());
+    BOOST_CHECK(f.error() == std::errc::no_such_file_or_directory);
+    BOOST_CHECK(!f.has_exception());
+  }
+#if __cplusplus >= 201700L || _HAS_CXX17
+  {
+    // Guaranteed copy elision lets a type which cannot be moved be returned
+    auto r = make_pinned(5);
+    BOOST_CHECK(r.value().name == "pinned");
+    BOOST_CHECK(r.value().value == 5);
+    auto s = make_pinned(-1);
+    BOOST_CHECK(s.error() == std::errc::invalid_argument);
+  }
+#endif
+}
@@ -39,3 +39,104 @@ BOOST_OUTCOME_AUTO_TEST_CASE(works / outcome / swap, "Tests that the outcome swa
   BOOST_CHECK(a.value() == "niall");
   BOOST_CHECK(b.error() == std::errc::not_enough_memory);
 }
+
+namespace swap_test
+{
+  // Counts how often it is swapped, and can be made to throw when swapped
+  struct counted
+  {
+    int v{0};
+    static int swaps;
+    static bool throw_on_swap;
+    counted() = default;
+    explicit counted(int _v)
+        : v(_v)
+    {
+    }
+    friend void swap(counted &a, counted &b)
+    {
+      if(throw_on_swap)
+      {
+        throw std::runtime_error("swap");
+      }
+      ++swaps;
+      std::swap(a.v, b.v);
+    }
+  };
+  int counted::swaps;
+  bool counted::throw_on_swap;
+  // A distinct type for the exception, swapped in the same way
+  struct counted_exception : counted
+  {
+    using counted::counted;
+    friend void swap(counted_exception &a, counted_exception &b) { swap(static_cast<counted &>(a), static_cast<counted &>(b)); }
+  };
+}  // namespace swap_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / outcome / swap / live, "Tests that swap only touches the live members")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using swap_test::counted;
+  using swap_test::counted_exception;
+  {
+    // Neither errored, so the unused errors are not swapped
+    result<std::string, counted> a("niall"), b("douglas");
+    counted::swaps = 0;
+    swap(a, b);
+    BOOST_CHECK(a.value() == "douglas");
+    BOOST_CHECK(b.value() == "niall");
+    BOOST_CHECK(counted::swaps == 0);
+    // One errored, so the errors are swapped once
+    b = counted(5);
+    swap(a, b);
+    BOOST_CHECK(a.error().v == 5);
+    BOOST_CHECK(b.value() == "douglas");
+    BOOST_CHECK(counted::swaps == 1);
+    swap(a, b);
+    BOOST_CHECK(a.value() == "douglas");
+    BOOST_CHECK(b.error().v == 5);
+    BOOST_CHECK(counted::swaps == 2);
+  }
+  {
+    outcome<int, counted, counted_exception> a(in_place_type<int>, 1), b(in_place_type<int>, 2);
+    counted::swaps = 0;
+    swap(a, b);
+    BOOST_CHECK(a.value() == 2);
+    BOOST_CHECK(b.value() == 1);
+    BOOST_CHECK(counted::swaps == 0);
+    // Only an exception, so the errors are not swapped
+    b = outcome<int, counted, counted_exception>(in_place_type<counted_exception>, 7);
+    BOOST_CHECK(b.has_exception());
+    swap(a, b);
+    BOOST_CHECK(a.exception().v == 7);
+    BOOST_CHECK(b.value() == 2);
+    BOOST_CHECK(counted::swaps == 1);
+  }
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / outcome / swap / strong, "Tests that a throwing swap leaves both results unchanged")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using swap_test::counted;
+  using swap_test::counted_exception;
+#ifdef __cpp_exceptions
+  {
+    // The value cannot throw when swapped, so the error is swapped first
+    result<std::string, counted> a("niall"), b(counted(5));
+    counted::throw_on_swap = true;
+    BOOST_CHECK_THROW(swap(a, b), std::runtime_error);
+    counted::throw_on_swap = false;
+    BOOST_CHECK(a.value() == "niall");
+    BOOST_CHECK(b.error().v == 5);
+  }
+  {
+    // The exception is swapped before the state and error
+    outcome<std::string, int, counted_exception> a("niall"), b(in_place_type<counted_exception>, 5);
+    counted::throw_on_swap = true;
+    BOOST_CHECK_THROW(swap(a, b), std::runtime_error);
+    counted::throw_on_swap = false;
+    BOOST_CHECK(a.value() == "niall");
+    BOOST_CHECK(b.exception().v == 5);
+  }
+#endif
+}
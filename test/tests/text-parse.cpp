@@ -0,0 +1,81 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/iostream_support.hpp"
+#include "../../include/outcome/text_parse.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / text_parse, "Tests that the from_chars parser reads what the text serialisation writes")
+{
+#if __cplusplus >= 201700 || _HAS_CXX17
+  using namespace OUTCOME_V2_NAMESPACE;
+  auto text = [](const auto &v) {
+    std::stringstream s;
+    s << v;
+    return s.str();
+  };
+
+  result<int, long> a(success(-78)), b(failure(5L)), c(success(0));
+  std::string t = text(a);
+  auto r = from_chars(t, c);
+  BOOST_CHECK(r.ec == std::errc() && r.ptr == t.data() + t.size() && c == a);
+  t = text(b);
+  r = from_chars(t, c);
+  BOOST_CHECK(r.ec == std::errc() && c == b);
+
+  result<double, int> d(success(3.25)), e(success(0.0));
+  t = text(d);
+  BOOST_CHECK(from_chars(t, e).ec == std::errc() && e == d);
+  result<std::string, int> f(success(std::string("hello"))), g(success(std::string()));
+  t = text(f);
+  BOOST_CHECK(from_chars(t, g).ec == std::errc() && g == f);
+  result<void, int> h(success()), i(failure(5));
+  BOOST_CHECK(from_chars("1 ", i).ec == std::errc() && i == h);
+
+  // Spare storage is preserved
+  hooks::set_spare_storage(&a, 0x1234);
+  t = text(a);
+  BOOST_CHECK(from_chars(t, c).ec == std::errc() && c.value() == -78 && hooks::spare_storage(&c) == 0x1234);
+
+  // Many records in one buffer, as the stream path reads them
+  std::string dump;
+  for(int n = 0; n < 100; n++)
+  {
+    dump += text(result<int, long>(success(n))) + "\n";
+  }
+  const char *p = dump.data(), *end = dump.data() + dump.size();
+  int n = 0;
+  for(; (r = from_chars(p, end, c)).ec == std::errc(); p = r.ptr, n++)
+  {
+    BOOST_CHECK(c.value() == n);
+  }
+  BOOST_CHECK(n == 100);
+
+  // Bad input fails and leaves the result alone
+  c = success(78);
+  BOOST_CHECK(from_chars("0 5", c).ec == std::errc::invalid_argument && c.value() == 78);
+  BOOST_CHECK(from_chars("1 x", c).ec == std::errc::invalid_argument && c.value() == 78);
+  BOOST_CHECK(from_chars("1 99999999999", c).ec == std::errc::result_out_of_range && c.value() == 78);
+  BOOST_CHECK(from_chars("", c).ec == std::errc::invalid_argument && c.value() == 78);
+#endif
+}
@@ -0,0 +1,111 @@
+/* Unit testing for static tracepoints
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#define OUTCOME_ENABLE_TRACEPOINTS 1
+
+#include "../../include/outcome/category_registry.hpp"
+#include "../../include/outcome/error_site.hpp"
+#include "../../include/outcome/outcome.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+namespace tracepoints_test
+{
+  // The ADL bridge for the hooks
+  struct error_code : public std::error_code
+  {
+    using std::error_code::error_code;
+    error_code() = default;
+    error_code(std::error_code ec)  // NOLINT
+    : std::error_code(ec)
+    {
+    }
+  };
+  template <class R> using result = OUTCOME_V2_NAMESPACE::result<R, error_code>;
+  template <class R> using outcome = OUTCOME_V2_NAMESPACE::outcome<R, error_code>;
+  static int traced;
+  template <class T, class U> inline void hook_result_construction(result<T> *res, U && /*unused*/) noexcept
+  {
+    traced += res->has_error() ? 1 : 0;
+    OUTCOME_V2_NAMESPACE::trace_failure(res, OUTCOME_ERROR_SITE_ID());
+  }
+  template <class T, class U> inline void hook_outcome_construction(outcome<T> *res, U && /*unused*/) noexcept { OUTCOME_V2_NAMESPACE::trace_failure(res); }
+
+  inline result<int> fail() { return error_code(make_error_code(std::errc::invalid_argument)); }
+  inline result<int> forward()
+  {
+    OUTCOME_TRY(v, fail());
+    return v + 1;
+  }
+  inline result<int> forward_at_site()
+  {
+    OUTCOME_TRY_SITE(v, fail());
+    return v + 1;
+  }
+  inline outcome<int> forward_outcome()
+  {
+    OUTCOME_TRY(v, outcome<int>(std::make_exception_ptr(std::runtime_error("boo"))));
+    return v + 1;
+  }
+  enum class plain_error
+  {
+    bad = 7
+  };
+  struct opaque_error
+  {
+    int x;
+  };
+}  // namespace tracepoints_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / tracepoints, "Tests that static tracepoints carry the category and code, and do not disturb propagation")
+{
+  using namespace tracepoints_test;
+  using OUTCOME_V2_NAMESPACE::detail::tracepoint_failure_of;
+  using OUTCOME_V2_NAMESPACE::detail::tracepoint_error_of;
+  // Where <sys/sdt.h> is not available, the probes are compiled out but the rest works the same
+  // The arguments carried for each kind of error
+  auto e = tracepoint_failure_of(fail(), 0);
+  BOOST_CHECK(e.category == &std::generic_category());
+  BOOST_CHECK(e.code == static_cast<long>(std::errc::invalid_argument));
+  e = tracepoint_failure_of(result<int>(5), 0);
+  BOOST_CHECK(e.category == nullptr && e.code == 0);
+  e = tracepoint_failure_of(outcome<int>(std::make_exception_ptr(std::runtime_error("boo"))), 0);
+  BOOST_CHECK(e.category == nullptr && e.code == 0);
+  e = tracepoint_error_of(plain_error::bad, 0);
+  BOOST_CHECK(e.category == nullptr && e.code == 7);
+  e = tracepoint_error_of(opaque_error{5}, 0);
+  BOOST_CHECK(e.category == nullptr && e.code == 0);
+  e = tracepoint_failure_of(OUTCOME_V2_NAMESPACE::result<double, int>(OUTCOME_V2_NAMESPACE::failure(3)), 0);
+  BOOST_CHECK(e.category == nullptr && e.code == 3);
+
+  // Failures still propagate as before
+  traced = 0;
+  BOOST_CHECK(forward().error() == std::errc::invalid_argument);
+  BOOST_CHECK(forward_at_site().error() == std::errc::invalid_argument);
+  BOOST_CHECK(traced >= 2);
+  BOOST_CHECK(forward_outcome().has_exception());
+  BOOST_CHECK(forward_outcome().has_error() == false);
+
+  // Registering categories fires a probe too
+  BOOST_CHECK(OUTCOME_V2_NAMESPACE::error_category_id(std::generic_category()) != 0);
+}
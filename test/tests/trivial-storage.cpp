@@ -0,0 +1,63 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_ENABLE_TRIVIAL_STORAGE
+#define OUTCOME_ENABLE_TRIVIAL_STORAGE
+#endif
+#include "../../include/outcome/outcome.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <cstdlib>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / trivial - storage, "Tests that result with trivial storage treats all bits zero as empty")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  static_assert(std::is_trivially_default_constructible<detail::value_storage_select_impl<int>>::value, "storage is not trivially default constructible!");
+  static_assert(std::is_trivially_copyable<result<int>>::value, "result<int> is not trivially copyable!");
+
+  // A zero filled block of results needs no construction, and every element is empty
+  auto *block = static_cast<result<int> *>(calloc(1024, sizeof(result<int>)));  // NOLINT
+  BOOST_REQUIRE(block != nullptr);
+  for(size_t n = 0; n < 1024; n++)
+  {
+    BOOST_CHECK(!block[n].has_value());
+    BOOST_CHECK(!block[n].has_error());
+    BOOST_CHECK(!block[n].has_exception());
+  }
+  // Elements can be overwritten in place
+  block[5] = result<int>(5);
+  block[6] = result<int>(std::errc::invalid_argument);
+  BOOST_CHECK(block[5].value() == 5);
+  BOOST_CHECK(block[6].error() == std::errc::invalid_argument);
+  BOOST_CHECK(!block[7].has_value());
+  free(block);  // NOLINT
+
+  // Construction and conversion still initialise everything
+  result<int> a(5), b(std::errc::invalid_argument);
+  result<long> c(a), d(b);
+  BOOST_CHECK(c.value() == 5);
+  BOOST_CHECK(d.error() == std::errc::invalid_argument);
+  result<void> e(success());
+  result<int> f(e);
+  BOOST_CHECK(f.has_value());
+}
@@ -0,0 +1,107 @@
+/* Unit testing for OUTCOME_TRY_ALL
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <string>
+
+namespace try_all_test
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+
+  struct calls
+  {
+    int f{0}, g{0}, h{0};
+  };
+  static result<int> f(calls &c, bool fail)
+  {
+    c.f++;
+    return fail ? result<int>(std::make_error_code(std::errc::invalid_argument)) : result<int>(1);
+  }
+  static result<std::string> g(calls &c, bool fail)
+  {
+    c.g++;
+    return fail ? result<std::string>(std::make_error_code(std::errc::timed_out)) : result<std::string>("two");
+  }
+  static result<double> h(calls &c, bool fail)
+  {
+    c.h++;
+    return fail ? result<double>(std::make_error_code(std::errc::permission_denied)) : result<double>(3.0);
+  }
+
+  static result<std::string> all(calls &c, bool ff, bool gf, bool hf)
+  {
+    OUTCOME_TRY_ALL((a, f(c, ff)), (b, g(c, gf)), (x, h(c, hf)));
+    return std::to_string(a) + b + std::to_string(static_cast<int>(x));
+  }
+
+  static result<int> one(calls &c, bool ff)
+  {
+    OUTCOME_TRY_ALL((a, f(c, ff)));
+    return a + 1;
+  }
+
+  static outcome<int> mixed(calls &c, bool ff)
+  {
+    // Twice in the same scope, and propagating results into an outcome
+    OUTCOME_TRY_ALL((a, f(c, false)), (b, g(c, false)));
+    OUTCOME_TRY_ALL((d, f(c, ff)), (e, f(c, false)));
+    return a + d + e + static_cast<int>(b.size());
+  }
+}  // namespace try_all_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_try_all, "Tests that OUTCOME_TRY_ALL evaluates every expression, then propagates the first failure")
+{
+  using namespace try_all_test;
+  {
+    calls c;
+    auto r = all(c, false, false, false);
+    BOOST_CHECK(r.value() == "1two3");
+    BOOST_CHECK(c.f == 1 && c.g == 1 && c.h == 1);
+  }
+  {
+    // Every expression is evaluated, even after a failure, and the first failure propagated
+    calls c;
+    auto r = all(c, false, true, true);
+    BOOST_CHECK(r.error() == std::errc::timed_out);
+    BOOST_CHECK(c.f == 1 && c.g == 1 && c.h == 1);
+    r = all(c, true, true, true);
+    BOOST_CHECK(r.error() == std::errc::invalid_argument);
+    r = all(c, false, false, true);
+    BOOST_CHECK(r.error() == std::errc::permission_denied);
+    BOOST_CHECK(c.f == 3 && c.g == 3 && c.h == 3);
+  }
+  {
+    calls c;
+    BOOST_CHECK(one(c, false).value() == 2);
+    BOOST_CHECK(one(c, true).error() == std::errc::invalid_argument);
+  }
+  {
+    calls c;
+    BOOST_CHECK(mixed(c, false).value() == 6);
+    BOOST_CHECK(mixed(c, true).error() == std::errc::invalid_argument);
+    BOOST_CHECK(c.f == 6 && c.g == 2);
+  }
+}
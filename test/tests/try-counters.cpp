@@ -0,0 +1,120 @@
+/* Unit testing for per call site TRY counters
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#define OUTCOME_ENABLE_TRY_COUNTERS 1
+
+#include "../../include/outcome/result.hpp"
+#include "../../include/outcome/try.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <cstring>
+#include <sstream>
+#include <thread>
+
+namespace try_counters_test
+{
+  using OUTCOME_V2_NAMESPACE::result;
+  inline result<int> parse(int x)
+  {
+    if(x % 4 == 0)
+    {
+      return std::errc::invalid_argument;
+    }
+    return x;
+  }
+  inline result<int> rarely_failing(int x)
+  {
+    OUTCOME_TRY(v, parse(x % 8 == 0 ? 0 : 1));
+    return v;
+  }
+  inline result<int> often_failing(int x)
+  {
+    OUTCOME_TRY(v, parse(x));
+    return v;
+  }
+  inline result<int> both(int x)
+  {
+    OUTCOME_TRY_ALL((a, parse(1)), (b, parse(x)));
+    return a + b;
+  }
+}  // namespace try_counters_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / try_counters, "Tests that TRY operations count attempts and failures per call site")
+{
+  using namespace try_counters_test;
+  using OUTCOME_V2_NAMESPACE::try_counters;
+  using OUTCOME_V2_NAMESPACE::try_site_count;
+  auto find = [](const std::vector<try_site_count> &counts, const char *function) -> const try_site_count * {
+    for(const try_site_count &c : counts)
+    {
+      if(strstr(c.site->function, function) != nullptr)
+      {
+        return &c;
+      }
+    }
+    return nullptr;
+  };
+
+  for(int n = 0; n < 64; n++)
+  {
+    (void) rarely_failing(n);
+    (void) often_failing(n);
+  }
+  // Threads count into their own tables, which are kept when they exit
+  std::thread([] {
+    for(int n = 0; n < 16; n++)
+    {
+      (void) often_failing(n);
+      (void) both(n);
+    }
+  }).join();
+
+  auto counts = try_counters::snapshot();
+  BOOST_REQUIRE(counts.size() == 3);
+  const try_site_count *rarely = find(counts, "rarely_failing"), *often = find(counts, "often_failing"), *all = find(counts, "both");
+  BOOST_REQUIRE(rarely != nullptr && often != nullptr && all != nullptr);
+  BOOST_CHECK(rarely->attempts == 64);
+  BOOST_CHECK(rarely->failures == 8);
+  BOOST_CHECK(often->attempts == 80);
+  BOOST_CHECK(often->failures == 20);
+  BOOST_CHECK(often->failure_rate() == 0.25);
+  BOOST_CHECK(all->attempts == 16);
+  BOOST_CHECK(all->failures == 4);
+  // The most failing site ranks first
+  BOOST_CHECK(&counts[0] == often);
+  BOOST_CHECK(&counts[1] == rarely);
+  BOOST_CHECK(strstr(often->site->file, "try-counters.cpp") != nullptr);
+
+  std::stringstream s;
+  try_counters::dump(s, 2);
+  std::string line;
+  std::getline(s, line);
+  BOOST_CHECK(line == "failures attempts rate function location");
+  std::getline(s, line);
+  BOOST_CHECK(line.compare(0, 10, "20 80 25% ") == 0);
+  BOOST_CHECK(line.find("often_failing") != std::string::npos);
+  std::getline(s, line);
+  BOOST_CHECK(line.compare(0, 11, "8 64 12.5% ") == 0);
+  BOOST_CHECK(!std::getline(s, line));
+}
@@ -0,0 +1,95 @@
+/* Unit testing for timed TRY operations
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/result.hpp"
+#include "../../include/outcome/try_timing.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <cstring>
+#include <sstream>
+
+namespace try_timing_test
+{
+  using OUTCOME_V2_NAMESPACE::result;
+  inline result<int> slow(int x)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    if(x % 2 == 0)
+    {
+      return std::errc::invalid_argument;
+    }
+    return x;
+  }
+  inline result<int> fast(int x) { return x; }
+  inline result<int> handler(int x)
+  {
+    OUTCOME_TRY_TIMED(a, fast(x));
+    OUTCOME_TRYV_TIMED(slow(x));
+    return a;
+  }
+}  // namespace try_timing_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / try_timing, "Tests that timed TRY operations record how long each step took")
+{
+  using namespace try_timing_test;
+  using OUTCOME_V2_NAMESPACE::try_site_timing;
+  using OUTCOME_V2_NAMESPACE::try_timings;
+  for(int n = 0; n < 6; n++)
+  {
+    BOOST_CHECK(handler(n).has_value() == (n % 2 == 1));
+  }
+  std::thread([] { (void) handler(1); }).join();
+
+  auto timings = try_timings::snapshot();
+  BOOST_REQUIRE(timings.size() == 2);
+  // The slow step took the longest in total, so ranks first
+  const try_site_timing &s = timings[0], &f = timings[1];
+  BOOST_CHECK(strstr(s.site->function, "handler") != nullptr);
+  BOOST_CHECK(s.site->line == f.site->line + 1);
+  BOOST_CHECK(s.attempts == 7);
+  BOOST_CHECK(s.failures == 3);
+  BOOST_CHECK(f.attempts == 7);
+  BOOST_CHECK(f.failures == 0);
+  BOOST_CHECK(s.mean() >= 0.0015);
+  BOOST_CHECK(s.mean() < 1.0);
+  BOOST_CHECK(f.mean() < s.mean());
+  // Percentiles are accurate to a power of two
+  BOOST_CHECK(s.percentile(0.5) >= 0.002 && s.percentile(0.5) < 0.1);
+  BOOST_CHECK(s.percentile(0.99) >= s.percentile(0.5));
+  uint64_t total = 0;
+  for(uint64_t c : s.histogram)
+  {
+    total += c;
+  }
+  BOOST_CHECK(total == 7);
+
+  std::stringstream out;
+  try_timings::dump(out, 1);
+  std::string line;
+  std::getline(out, line);
+  BOOST_CHECK(line == "attempts failures mean_us p50_us p99_us function location");
+  std::getline(out, line);
+  BOOST_CHECK(line.compare(0, 4, "7 3 ") == 0);
+  BOOST_CHECK(!std::getline(out, line));
+}
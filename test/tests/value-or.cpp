@@ -0,0 +1,76 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/outcome.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <string>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / value_or, "Tests that value_or, value_or_else, error_or and assume_value_or never call the policy")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  const result<int> v(5), e(std::make_error_code(std::errc::invalid_argument));
+  BOOST_CHECK(v.value_or(7) == 5);
+  BOOST_CHECK(e.value_or(7) == 7);
+  BOOST_CHECK(e.value_or(7L) == 7);
+  BOOST_CHECK(v.error_or(std::make_error_code(std::errc::not_enough_memory)) == std::errc::not_enough_memory);
+  BOOST_CHECK(e.error_or(std::make_error_code(std::errc::not_enough_memory)) == std::errc::invalid_argument);
+
+  // The fallback of value_or_else is only made if needed
+  int calls = 0;
+  BOOST_CHECK(v.value_or_else([&] { return ++calls; }) == 5);
+  BOOST_CHECK(e.value_or_else([&] { return ++calls; }) == 1);
+  BOOST_CHECK(calls == 1);
+
+  // assume_value_or refers to the value or the fallback without copying
+  int fallback = 9;
+  BOOST_CHECK(&v.assume_value_or(fallback) == &v.assume_value());
+  BOOST_CHECK(&e.assume_value_or(fallback) == &fallback);
+  result<int> m(5);
+  m.assume_value_or(fallback) = 6;
+  BOOST_CHECK(m.value() == 6);
+
+  // Non trivially copyable values are moved out of rvalues
+  result<std::string> s(std::string("hello"));
+  BOOST_CHECK(s.value_or("fallback") == "hello");
+  BOOST_CHECK(std::move(s).value_or("fallback") == "hello");
+  BOOST_CHECK(result<std::string>(std::make_error_code(std::errc::invalid_argument)).value_or("fallback") == "fallback");
+  BOOST_CHECK(result<std::string>(std::make_error_code(std::errc::invalid_argument)).value_or_else([] { return "else"; }) == "else");
+
+  // A result of reference returns the object referred to
+  int a = 1, b = 2;
+  BOOST_CHECK(&result<int &>(a).value_or(b) == &a);
+  BOOST_CHECK(&result<int &>(std::make_error_code(std::errc::invalid_argument)).value_or(b) == &b);
+
+  // An outcome with only an exception has no error
+  const outcome<int> x(std::make_exception_ptr(std::runtime_error("x")));
+  BOOST_CHECK(x.value_or(3) == 3);
+  BOOST_CHECK(x.error_or(std::make_error_code(std::errc::not_enough_memory)) == std::errc::not_enough_memory);
+
+  // The selection is usable in constant evaluation
+  constexpr result<int, long> cv(in_place_type<int>, 5), ce(in_place_type<long>, 3);
+  static_assert(cv.value_or(7) == 5, "");
+  static_assert(ce.value_or(7) == 7, "");
+  static_assert(ce.error_or(7) == 3, "");
+}
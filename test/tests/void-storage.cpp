@@ -0,0 +1,92 @@
+/* Unit testing for outcomes
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/outcome.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+#include <string>
+#if __cplusplus >= 201700 || _HAS_CXX17
+#include <optional>
+#endif
+
+namespace void_storage_test
+{
+  enum small_errc : unsigned char
+  {
+    ok,
+    bad
+  };
+}  // namespace void_storage_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / void - storage, "Tests that results with a void value or error are no larger than an optional")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using void_storage_test::small_errc;
+#if __cplusplus >= 201700 || _HAS_CXX17
+  static_assert(sizeof(result<char, void>) == sizeof(std::optional<char>), "result<char, void> is bigger than optional<char>!");
+  static_assert(sizeof(result<uint16_t, void>) == sizeof(std::optional<uint16_t>), "result<uint16_t, void> is bigger than optional<uint16_t>!");
+  static_assert(sizeof(result<double, void>) == sizeof(std::optional<double>), "result<double, void> is bigger than optional<double>!");
+  static_assert(sizeof(result<std::string, void>) == sizeof(std::optional<std::string>), "result<std::string, void> is bigger than optional<std::string>!");
+  static_assert(sizeof(result<void, small_errc>) == sizeof(std::optional<small_errc>), "result<void, small_errc> is bigger than optional<small_errc>!");
+  static_assert(sizeof(result<void, int>) == sizeof(std::optional<int>), "result<void, int> is bigger than optional<int>!");
+  static_assert(sizeof(result<void>) == sizeof(std::optional<std::error_code>), "result<void> is bigger than optional<error_code>!");
+#endif
+  static_assert(sizeof(result<char, void>) == 2, "result<char, void> is not two bytes!");
+  static_assert(sizeof(result<void, small_errc>) == 2, "result<void, small_errc> is not two bytes!");
+
+  result<char, void> a('x'), b(in_place_type<void>);
+  BOOST_CHECK(a.has_value());
+  BOOST_CHECK(a.value() == 'x');
+  BOOST_CHECK(b.has_error());
+  BOOST_CHECK(!b.has_value());
+  BOOST_CHECK(a != b);
+  b = a;
+  BOOST_CHECK(b == a);
+
+  result<void, small_errc> c(success()), d(failure(small_errc::bad));
+  BOOST_CHECK(c.has_value());
+  BOOST_CHECK(d.has_error());
+  BOOST_CHECK(d.error() == small_errc::bad);
+  BOOST_CHECK(c != d);
+
+  // Conversions to results with the full status keep the state
+  result<char, std::error_code> e(a), f(b);
+  BOOST_CHECK(e.value() == 'x');
+  BOOST_CHECK(f.value() == 'x');
+  result<void, int> g(d), h(c);
+  BOOST_CHECK(g.error() == small_errc::bad);
+  BOOST_CHECK(h.has_value());
+  result<long, int> i(g);
+  BOOST_CHECK(i.error() == small_errc::bad);
+
+#ifndef OUTCOME_ENABLE_COMPACT_STATUS
+  // Spare storage is kept where the status is full width, and dropped where it is not
+  result<void> j(std::make_error_code(std::errc::invalid_argument));
+  hooks::set_spare_storage(&j, 78);
+  BOOST_CHECK(hooks::spare_storage(&j) == 78);
+  hooks::set_spare_storage(&d, 78);
+  BOOST_CHECK(hooks::spare_storage(&d) == 0);
+  BOOST_CHECK(d.error() == small_errc::bad);
+#endif
+}
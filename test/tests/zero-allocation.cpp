@@ -0,0 +1,168 @@
+/* Unit testing that the hot paths do not allocate
+(C) 2013-2017 Niall Douglas <http://www.nedproductions.biz/> (149 commits)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/error_info_ring.hpp"
+#include "../../include/outcome/format.hpp"
+#include "../../include/outcome/outcome.hpp"
+#include "../../include/outcome/try.hpp"
+#include "count-allocations.hpp"
+#include "quickcpplib/include/boost/test/unit_test.hpp"
+
+namespace zero_allocation_test
+{
+  namespace outcome = OUTCOME_V2_NAMESPACE;
+  // The allocations made since construction
+  class allocation_scope
+  {
+    size_t _begin{allocations};
+
+  public:
+    size_t count() const noexcept { return allocations - _begin; }
+  };
+
+  // Not inlined, so that the failures really are returned through each frame
+  QUICKCPPLIB_NOINLINE outcome::result<int> leaf(int x)
+  {
+    if(x < 0)
+    {
+      return std::make_error_code(std::errc::invalid_argument);
+    }
+    return x;
+  }
+  QUICKCPPLIB_NOINLINE outcome::result<long> middle(int x)
+  {
+    OUTCOME_TRY(v, leaf(x));
+    return v * 2L;
+  }
+  QUICKCPPLIB_NOINLINE outcome::result<long> top(int x)
+  {
+    OUTCOME_TRY(a, middle(x));
+    OUTCOME_TRY(b, middle(x + 1));
+    return a + b;
+  }
+  QUICKCPPLIB_NOINLINE outcome::outcome<long> top_outcome(int x)
+  {
+    OUTCOME_TRY(v, top(x));
+    return v;
+  }
+
+  struct info
+  {
+    const char *function{nullptr};
+    int line{0};
+  };
+  using ring = outcome::error_info_ring<info, 8>;
+  QUICKCPPLIB_NOINLINE outcome::result<int> fail_with_info(int line)
+  {
+    outcome::result<int> ret(std::make_error_code(std::errc::timed_out));
+    info &i = ring::capture(&ret);
+    i.function = __func__;
+    i.line = line;
+    return ret;
+  }
+}  // namespace zero_allocation_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / zero_allocation / failure, "Tests that constructing and propagating result failures allocates nothing")
+{
+  using namespace zero_allocation_test;
+  size_t count;
+  bool ok;
+  {
+    allocation_scope scope;
+    outcome::result<int> a(std::make_error_code(std::errc::invalid_argument));
+    outcome::result<int> b(a);
+    outcome::result<long> c(std::move(b));
+    outcome::result<long> d(a.as_failure());
+    outcome::outcome<int> e(a);
+    ok = c.error() == std::errc::invalid_argument && d.error() == std::errc::invalid_argument && e.error() == std::errc::invalid_argument;
+    count = scope.count();
+  }
+  BOOST_CHECK(ok);
+  BOOST_CHECK(count == 0);
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / zero_allocation / try, "Tests that chains of TRY operations allocate nothing")
+{
+  using namespace zero_allocation_test;
+  size_t count;
+  long sum = 0;
+  bool ok = true;
+  {
+    allocation_scope scope;
+    for(int n = -3; n < 3; n++)
+    {
+      auto r = top(n);
+      auto o = top_outcome(n);
+      sum += r ? r.value() : 0;
+      ok &= (r.has_value() == o.has_value()) && (n >= 0 || r.error() == std::errc::invalid_argument);
+    }
+    count = scope.count();
+  }
+  BOOST_CHECK(ok);
+  BOOST_CHECK(sum == 2 + 6 + 10);
+  BOOST_CHECK(count == 0);
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / zero_allocation / print, "Tests that printing into a caller's buffer allocates nothing")
+{
+  using namespace zero_allocation_test;
+  const outcome::result<int> a(42), b(std::make_error_code(std::errc::invalid_argument));
+  char buffer[256];
+  outcome::enable_error_message_cache();
+  // Fetches the message into the cache
+  (void) outcome::to_chars(buffer, buffer + sizeof(buffer), b);
+  size_t count;
+  outcome::to_chars_result r1, r2, r3;
+  {
+    allocation_scope scope;
+    r1 = outcome::to_chars(buffer, buffer + sizeof(buffer), a);
+    r2 = outcome::to_chars(buffer, buffer + sizeof(buffer), b);
+    r3 = outcome::to_chars(buffer, buffer + 4, b);
+    count = scope.count();
+  }
+  outcome::enable_error_message_cache(false);
+  BOOST_CHECK(r1.ec == std::errc());
+  BOOST_CHECK(r2.ec == std::errc());
+  BOOST_CHECK(r3.ec == std::errc::value_too_large);
+  BOOST_CHECK(count == 0);
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / zero_allocation / error_info, "Tests that capturing extended error information allocates nothing")
+{
+#ifndef OUTCOME_ENABLE_COMPACT_STATUS
+  using namespace zero_allocation_test;
+  (void) ring::this_thread();
+  size_t count;
+  bool ok = true;
+  {
+    allocation_scope scope;
+    for(int n = 0; n < 20; n++)
+    {
+      outcome::result<int> r = fail_with_info(n);
+      const info *i = ring::lookup(r);
+      ok &= i != nullptr && i->line == n;
+    }
+    count = scope.count();
+  }
+  BOOST_CHECK(ok);
+  BOOST_CHECK(count == 0);
+#endif
+}